@@ -1523,6 +1523,7 @@ void Somas::Solve(const session::KernelGraph &graph) {
   }
 
   somas_solver_ = std::make_shared<SomasSolverPre>();
+  somas_solver_->EnableSolverCache(enable_cache_);
   auto status =
     somas_solver_->Solving(graph, &solver_tensor_desc_map_, &reuse_matrix_, processed_contiguous_tensors_list_, false);
   MS_LOG(INFO) << "End Solving";
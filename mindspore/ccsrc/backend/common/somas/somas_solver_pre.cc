@@ -14,11 +14,16 @@
  * limitations under the License.
 */
 
+#include <algorithm>
 #include <cstdio>
 #include <fstream>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
+#include "nlohmann/json.hpp"
+#include "utils/hashing.h"
 #include "include/common/thread_pool.h"
 
 #include "backend/common/somas/somas_solver_core.h"
@@ -29,6 +34,124 @@ namespace mindspore {
 namespace somas {
 constexpr auto kSolBytesThreshold = 100 * 1024 * 1024;
 constexpr auto kSolNumThresholdMultiThread = 8;
+constexpr size_t kSolverCacheMaxEntries = 16;
+constexpr auto kSolverHashId = "hash_id";
+constexpr auto kSolverTensorSize = "tensor_size";
+constexpr auto kSolverMaxOffset = "max_offset";
+constexpr auto kSolverOffsets = "offsets";
+
+namespace {
+struct SolverCacheEntry {
+  size_t max_offset{0};
+  // pairs of (tensor index, offset)
+  std::vector<std::pair<size_t, size_t>> offsets;
+};
+
+// Solutions found in this process, so that recompiling an unchanged graph skips the heuristic sweep.
+std::mutex solver_cache_mutex;
+std::map<std::string, SolverCacheEntry> solver_cache;
+
+std::string GetSolverCacheFileName(const std::string &hash_id) {
+  return Common::GetCompilerCachePath() + "/somas_meta/somas_solver_" + hash_id + ".json";
+}
+
+bool LoadSolverCacheFile(const std::string &hash_id, SolverCacheEntry *entry) {
+  auto filename = GetSolverCacheFileName(hash_id);
+  std::ifstream ifs(filename);
+  if (!ifs.is_open()) {
+    MS_LOG(INFO) << "Open somas solver cache file " << filename << " failed, solver cache missed.";
+    return false;
+  }
+  try {
+    nlohmann::json solver_json;
+    ifs >> solver_json;
+    if (solver_json[kSolverHashId] != hash_id) {
+      MS_LOG(WARNING) << "Mismatch hash id in somas solver cache file " << filename;
+      return false;
+    }
+    entry->max_offset = solver_json[kSolverMaxOffset];
+    entry->offsets = solver_json[kSolverOffsets].get<std::vector<std::pair<size_t, size_t>>>();
+    if (entry->offsets.size() != solver_json[kSolverTensorSize]) {
+      MS_LOG(WARNING) << "Mismatch tensor size in somas solver cache file " << filename;
+      return false;
+    }
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Parse somas solver cache file " << filename << " failed: " << e.what();
+    return false;
+  }
+  return true;
+}
+
+// The cached offsets are applied only if every current tensor has one and no conflict or contiguous constraint of
+// the current graph is broken, a stale or corrupted cache falls back to solving.
+bool CheckSolverCacheEntry(const TensorsDescMap &tensors, const std::vector<DynamicBitSet> *pConstraints,
+                           const vector<vector<size_t>> &continuous_v, const SolverCacheEntry &entry) {
+  if (entry.offsets.size() != tensors.size()) {
+    MS_LOG(WARNING) << "Mismatch tensor size in somas solver cache " << entry.offsets.size() << " vs "
+                    << tensors.size();
+    return false;
+  }
+  std::map<size_t, size_t> offsets;
+  for (auto &offset : entry.offsets) {
+    auto iter = tensors.find(offset.first);
+    if (iter == tensors.end() || offset.first >= pConstraints->size() ||
+        iter->second->size_ + offset.second > entry.max_offset ||
+        !offsets.emplace(offset.first, offset.second).second) {
+      MS_LOG(WARNING) << "Invalid tensor " << offset.first << " in somas solver cache";
+      return false;
+    }
+  }
+  for (auto &continuous : continuous_v) {
+    for (size_t i = 1; i < continuous.size(); ++i) {
+      auto prev = offsets.find(continuous[i - 1]);
+      auto cur = offsets.find(continuous[i]);
+      if (prev == offsets.end() || cur == offsets.end() ||
+          prev->second + tensors.at(prev->first)->size_ != cur->second) {
+        MS_LOG(WARNING) << "Continuous constraint violation of tensor " << continuous[i] << " in somas solver cache";
+        return false;
+      }
+    }
+  }
+  // Sweep the tensors by offset, only the ones still alive at the current offset may overlap with it.
+  std::vector<SomasSolverTensorDescPtr> sorted_tensors;
+  for (auto &offset : offsets) {
+    auto &tensor = tensors.at(offset.first);
+    if (tensor->size_ > 0) {
+      sorted_tensors.push_back(tensor);
+    }
+  }
+  std::sort(sorted_tensors.begin(), sorted_tensors.end(),
+            [&offsets](const SomasSolverTensorDescPtr &t1, const SomasSolverTensorDescPtr &t2) {
+              return offsets[t1->index_] < offsets[t2->index_];
+            });
+  std::vector<SomasSolverTensorDescPtr> alive_tensors;
+  for (auto &t1 : sorted_tensors) {
+    auto t1_offset = offsets[t1->index_];
+    (void)alive_tensors.erase(std::remove_if(alive_tensors.begin(), alive_tensors.end(),
+                                             [&offsets, t1_offset](const SomasSolverTensorDescPtr &t2) {
+                                               return offsets[t2->index_] + t2->size_ <= t1_offset;
+                                             }),
+                              alive_tensors.end());
+    for (auto &t2 : alive_tensors) {
+      bool can_reuse = !t1->lifelong_ && !t2->lifelong_ && (*pConstraints)[t1->index_].IsBitTrue(t2->index_) &&
+                       (*pConstraints)[t2->index_].IsBitTrue(t1->index_);
+      if (!can_reuse) {
+        MS_LOG(WARNING) << "Non-overlap constraint violation in tensors " << t1->index_ << " and " << t2->index_
+                        << " in somas solver cache";
+        return false;
+      }
+    }
+    alive_tensors.push_back(t1);
+  }
+  return true;
+}
+}  // namespace
+
+void SomasSolverPre::ClearSolverCache() {
+  std::lock_guard<std::mutex> lock(solver_cache_mutex);
+  solver_cache.clear();
+}
+
 Status SomasSolverPre::CheckTensors(const TensorsDescMap *pTensors, uint32_t index1, uint32_t index2) const {
   auto tensors = *pTensors;
   if (tensors[index1] == nullptr) {
@@ -92,15 +215,96 @@ Status SomasSolverPre::AddContiguousInfoInMultiMaps(const vector<vector<size_t>>
 vector<TensorsDescMap> SomasSolverPre::CreateTensorsMaps(const TensorsDescMap &tensors, size_t total_sol) const {
   vector<TensorsDescMap> vecTensorsMap(total_sol);
   vecTensorsMap[0] = tensors;
-  for (auto &pairT : tensors) {
-    for (size_t sol = 1; sol < total_sol; sol++) {
-      SomasSolverTensorDesc newDesc = *(pairT.second.get());
-      SomasSolverTensorDescPtr newDescPtr = std::make_shared<SomasSolverTensorDesc>(newDesc);
-      (void)vecTensorsMap[sol].emplace(pairT.first, newDescPtr);
-    }
+  // Each solution owns a private copy of the tensors, build them concurrently.
+  std::vector<common::Task> tasks;
+  for (size_t sol = 1; sol < total_sol; sol++) {
+    auto &tensors_sol = vecTensorsMap[sol];
+    auto task = [&tensors, &tensors_sol]() {
+      for (auto &pairT : tensors) {
+        SomasSolverTensorDescPtr newDescPtr = std::make_shared<SomasSolverTensorDesc>(*(pairT.second.get()));
+        (void)tensors_sol.emplace(pairT.first, newDescPtr);
+      }
+      return common::SUCCESS;
+    };
+    tasks.emplace_back(task);
   }
+  (void)common::ThreadPool::GetInstance().SyncRun(tasks);
   return vecTensorsMap;
 }
+
+std::string SomasSolverPre::CalcSolverHash(const TensorsDescMap &tensors,
+                                           const std::vector<DynamicBitSet> *pConstraints,
+                                           const vector<vector<size_t>> &continuous_v) const {
+  // The strategy set is part of the key, the best solution differs when SOMAS_DEBUG enables more heuristics.
+  size_t hash_sum = hash_combine({static_cast<size_t>(kNumSortingTypes), static_cast<size_t>(kNumFittingTypes),
+                                  static_cast<size_t>(kNumAlgorithmTypes), tensors.size()});
+  std::map<size_t, SomasSolverTensorDescPtr> ordered_tensors(tensors.begin(), tensors.end());
+  for (auto &pairT : ordered_tensors) {
+    hash_sum = hash_combine(hash_sum, hash_combine({pairT.first, pairT.second->size_,
+                                                    static_cast<size_t>(pairT.second->lifelong_)}));
+  }
+  for (auto &constraint : *pConstraints) {
+    for (auto bits : constraint.bit_) {
+      hash_sum = hash_combine(hash_sum, static_cast<size_t>(bits));
+    }
+  }
+  for (auto &continuous : continuous_v) {
+    hash_sum = hash_combine(hash_sum, continuous.size());
+    for (auto index : continuous) {
+      hash_sum = hash_combine(hash_sum, index);
+    }
+  }
+  return std::to_string(hash_sum);
+}
+
+bool SomasSolverPre::LoadSolverCache(TensorsDescMap *pTensors, const std::vector<DynamicBitSet> *pConstraints,
+                                     const vector<vector<size_t>> &continuous_v) {
+  MS_EXCEPTION_IF_NULL(pTensors);
+  auto &tensors = *pTensors;
+  SolverCacheEntry entry;
+  bool found = false;
+  {
+    std::lock_guard<std::mutex> lock(solver_cache_mutex);
+    auto iter = solver_cache.find(hash_id_);
+    if (iter != solver_cache.end()) {
+      entry = iter->second;
+      found = true;
+    }
+  }
+  if (!found) {
+    found = LoadSolverCacheFile(hash_id_, &entry);
+  }
+  if (!found || !CheckSolverCacheEntry(tensors, pConstraints, continuous_v, entry)) {
+    return false;
+  }
+  for (auto &offset : entry.offsets) {
+    tensors[offset.first]->offset_ = offset.second;
+  }
+  max_offset_ = entry.max_offset;
+  return true;
+}
+
+void SomasSolverPre::SaveSolverCache(const TensorsDescMap &tensors) const {
+  SolverCacheEntry entry;
+  entry.max_offset = max_offset_;
+  entry.offsets.reserve(tensors.size());
+  for (auto &pairT : tensors) {
+    entry.offsets.emplace_back(pairT.first, pairT.second->offset_);
+  }
+
+  nlohmann::json solver_json;
+  solver_json[kSolverHashId] = hash_id_;
+  solver_json[kSolverTensorSize] = entry.offsets.size();
+  solver_json[kSolverMaxOffset] = entry.max_offset;
+  solver_json[kSolverOffsets] = entry.offsets;
+  (void)Common::SaveStringToFile(GetSolverCacheFileName(hash_id_), solver_json.dump());
+
+  std::lock_guard<std::mutex> lock(solver_cache_mutex);
+  if (solver_cache.size() >= kSolverCacheMaxEntries && solver_cache.count(hash_id_) == 0) {
+    (void)solver_cache.erase(solver_cache.begin());
+  }
+  solver_cache[hash_id_] = std::move(entry);
+}
 void FindBest(size_t total_sol, const vector<std::shared_ptr<SomasSolverCore>> &solvers, BestInfo *best_info) {
   for (size_t sol = 0; sol < total_sol; sol++) {
     auto &solver = solvers[sol];
@@ -134,6 +338,18 @@ Status SomasSolverPre::Solving(const session::KernelGraph &graph, TensorsDescMap
     constexpr size_t total_sol = numSortingTypes * numFittingTypes * numAlgorithmTypes;
     const double giga = 1024. * 1024. * 1024.;
 
+    if (enable_cache_) {
+      // The hash goes over all the tensors and constraints, so it is only calculated when the cache is used.
+      hash_id_ = CalcSolverHash(tensors, pConstraints, continuous_v);
+      if (LoadSolverCache(ptensors, pConstraints, continuous_v)) {
+        MS_LOG(INFO) << "SOMAS SOLVER RESUME:";
+        MS_LOG(INFO) << "Load solution from solver cache, hash id " << hash_id_ << ", skip solving.";
+        MS_LOG(INFO) << "Best result:" << max_offset_ << " Bytes " << max_offset_ / giga << " GB";
+        Log(graph, tensors, pConstraints, continuous_v);
+        return ret;
+      }
+    }
+
     vector<std::shared_ptr<SomasSolverCore>> solvers;
     std::vector<common::Task> tasks;
     vector<TensorsDescMap> vecTensorsMap = CreateTensorsMaps(tensors, total_sol);
@@ -169,6 +385,9 @@ Status SomasSolverPre::Solving(const session::KernelGraph &graph, TensorsDescMap
       *(tensor.second.get()) = *(vecTensorsMap[best_info.best_sol][tensor.first]);
     }
     max_offset_ = best_solver->GetUpperbound();
+    if (enable_cache_) {
+      SaveSolverCache(tensors);
+    }
     constexpr float kFloatPresent = 100.0;
     MS_LOG(INFO) << "SOMAS SOLVER RESUME:";
     MS_LOG(INFO) << "Best Solution:[" << 1 + best_info.best_sol << "/" << total_sol << "] ";
@@ -24,6 +24,7 @@
 #include <map>
 #include <memory>
 #include <stack>
+#include <string>
 #include <vector>
 #include <climits>
 #include "utils/hash_map.h"
@@ -190,6 +191,11 @@ class SomasSolverPre {
   SomasSolverPre &operator=(const SomasSolverPre &) = delete;
 
   size_t GetMaxOffset() const { return max_offset_; }
+  // The solution is restored from and saved to the solver cache only if enabled, as the somas result cache.
+  void EnableSolverCache(bool enable_cache) { enable_cache_ = enable_cache; }
+  // The hash of the inputs of the last Solving, it is empty if the cache is not enabled.
+  const std::string &hash_id() const { return hash_id_; }
+  static void ClearSolverCache();
 
   Status Solving(const session::KernelGraph &graph, TensorsDescMap *ptensors,
                  const std::vector<DynamicBitSet> *pConstraints, const vector<vector<size_t>> &continuous_v,
@@ -208,6 +214,14 @@ class SomasSolverPre {
 
  private:
   size_t max_offset_;
+  // Hash of the solver inputs (tensor sizes, conflict bitsets and contiguous lists), used as solution cache key.
+  std::string hash_id_;
+  bool enable_cache_{false};
+  std::string CalcSolverHash(const TensorsDescMap &tensors, const std::vector<DynamicBitSet> *pConstraints,
+                             const vector<vector<size_t>> &continuous_v) const;
+  bool LoadSolverCache(TensorsDescMap *pTensors, const std::vector<DynamicBitSet> *pConstraints,
+                       const vector<vector<size_t>> &continuous_v);
+  void SaveSolverCache(const TensorsDescMap &tensors) const;
   void SolverInputLog(const session::KernelGraph &graph, const TensorsDescMap &tensors,
                       const vector<vector<size_t>> &continuous_v) const;
   void SolverOutputLog(const session::KernelGraph &graph, const TensorsDescMap &tensors) const;
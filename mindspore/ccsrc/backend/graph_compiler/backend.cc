@@ -1239,20 +1239,20 @@ void MindRTBackend::DispatchOpTask(bool single_op_cache_hit, VectorRef *outputs,
   auto ms_context = MsContext::GetInstance();
   MS_EXCEPTION_IF_NULL(ms_context);
   auto infer_flag = ms_context->get_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER);
-  auto run_op_context = std::make_shared<pynative::OpTaskContext>(graph->graph_id(), graph, output_nodes, op_run_info,
-                                                                  op_compiler_info->device_context_, infer_flag);
+  auto &op_executor = runtime::OpExecutor::GetInstance();
+  auto run_op_context = op_executor.MakeTask<pynative::OpTaskContext>(
+    graph->graph_id(), graph, output_nodes, op_run_info, op_compiler_info->device_context_, infer_flag);
 
   // Save build task and run task.
   std::promise<bool> promise;
   auto future = promise.get_future();
 
-  auto &op_executor = runtime::OpExecutor::GetInstance();
   if (!single_op_cache_hit) {
-    op_executor.PushOpBuildTask(std::make_shared<pynative::BackendOpBuildTask>(run_op_context, std::move(promise)));
+    op_executor.PushOpBuildTask(op_executor.MakeTask<pynative::BackendOpBuildTask>(run_op_context, std::move(promise)));
   } else {
     promise.set_value(true);
   }
-  op_executor.PushOpRunTask(std::make_shared<pynative::BackendOpRunTask>(
+  op_executor.PushOpRunTask(op_executor.MakeTask<pynative::BackendOpRunTask>(
     run_op_context, [this](const std::shared_ptr<pynative::OpTaskContext> &ctx) { OpRunCallback(ctx); },
     std::move(future)));
 
@@ -43,18 +43,84 @@ static const std::map<AllocatorType, std::string> kAllocatorTypeString = {
   {AllocatorType::kOther, "other"},
 };
 
+namespace {
+inline size_t HighestBitIndex(uint64_t value) {
+  size_t index = 0;
+  while (value >>= 1) {
+    ++index;
+  }
+  return index;
+}
+
+inline size_t LowestBitIndex(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<size_t>(__builtin_ctzll(value));
+#else
+  size_t index = 0;
+  while ((value & 1) == 0) {
+    value >>= 1;
+    ++index;
+  }
+  return index;
+#endif
+}
+}  // namespace
+
+DynamicMemPoolBestFit::DynamicMemPoolBestFit()
+    : persistent_mem_(std::make_shared<MemStatusManager>()), common_mem_(std::make_shared<MemStatusManager>()) {
+  static std::atomic<size_t> pool_count{0};
+  pool_id_ = ++pool_count;
+  static const bool enable_size_class = (common::GetEnv("MS_DEV_MEM_POOL_SIZE_CLASS") == "1");
+  if (enable_size_class) {
+    pool_mode_ = DynamicMemPoolMode::kSizeClass;
+  }
+}
+
 DynamicMemPoolBestFit::~DynamicMemPoolBestFit() {
+  for (auto &cache : thread_caches_) {
+    std::lock_guard<std::mutex> cache_locker(cache->mutex_);
+    cache->used_mem_bufs_.clear();
+    for (auto &cached_mem_bufs : cache->cached_mem_bufs_) {
+      cached_mem_bufs.clear();
+    }
+    cache->cached_size_ = 0;
+  }
+  thread_caches_.clear();
   persistent_mem_->clear();
   common_mem_->clear();
 }
 
+void DynamicMemPoolBestFit::set_pool_mode(DynamicMemPoolMode pool_mode) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  if (!common_mem_->mem_block_list_.empty() || !persistent_mem_->mem_block_list_.empty()) {
+    MS_LOG(WARNING) << "The pool mode can't be changed after memory is allocated.";
+    return;
+  }
+  pool_mode_ = pool_mode;
+}
+
 DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, bool from_persistent_mem) {
   size_t align_size = AlignMemorySize(size);
+  // The small memory buf is reused from the thread cache without the lock of memory pool.
+  ThreadMemBufCache *cache = nullptr;
+  if (pool_mode_ == DynamicMemPoolMode::kSizeClass && !from_persistent_mem &&
+      align_size <= THREAD_CACHE_MAX_BUF_SIZE) {
+    cache = GetThreadMemBufCache();
+    auto device_addr = AllocFromThreadCache(align_size, cache);
+    if (device_addr != nullptr) {
+      return device_addr;
+    }
+  }
+
   std::lock_guard<std::mutex> locker(mutex_);
-  // Find the idle memory buf by tensor size, if not find, then add new memory block and memory buf.
-  DeviceMemPtr device_addr = FindIdleMemBuf(align_size, from_persistent_mem);
-  if (!device_addr) {
-    device_addr = AddMemBlockAndMemBuf(align_size, from_persistent_mem);
+  DeviceMemPtr device_addr = AllocTensorMemInner(align_size, from_persistent_mem);
+  if (device_addr != nullptr && cache != nullptr) {
+    MemStatusManagerPtr mem_mng = nullptr;
+    auto mem_buf = FindMemBufBySizeClass(device_addr, &mem_mng);
+    MS_EXCEPTION_IF_NULL(mem_buf);
+    std::lock_guard<std::mutex> cache_locker(cache->mutex_);
+    mem_buf->owner_cache_ = cache;
+    cache->used_mem_bufs_[device_addr] = mem_buf.get();
   }
 
   // Alloc memory failed and dump the info.
@@ -70,9 +136,37 @@ DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, bool from_persis
   return device_addr;
 }
 
+DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMemInner(size_t size, bool from_persistent_mem) {
+  // Find the idle memory buf by tensor size, if not find, then add new memory block and memory buf.
+  DeviceMemPtr device_addr = FindIdleMemBuf(size, from_persistent_mem);
+  if (!device_addr) {
+    device_addr = AddMemBlockAndMemBuf(size, from_persistent_mem);
+  }
+  // The memory cached by the threads may be combined to satisfy the request.
+  if (!device_addr && pool_mode_ == DynamicMemPoolMode::kSizeClass && thread_cached_mem_size_ > 0) {
+    ReclaimThreadCaches();
+    device_addr = FindIdleMemBuf(size, from_persistent_mem);
+    if (!device_addr) {
+      device_addr = FindIdleMemBuf(size, !from_persistent_mem);
+    }
+  }
+  return device_addr;
+}
+
 std::vector<DeviceMemPtr> DynamicMemPoolBestFit::AllocContinuousTensorMem(const std::vector<size_t> &size_list) {
   std::vector<DeviceMemPtr> device_addr_list;
   size_t total_size = std::accumulate(size_list.begin(), size_list.end(), IntToSize(0));
+  if (pool_mode_ == DynamicMemPoolMode::kSizeClass) {
+    // Bypass the thread cache, because the pre-alloc memory buf will be split.
+    std::lock_guard<std::mutex> locker(mutex_);
+    auto device_addr = AllocTensorMemInner(AlignMemorySize(total_size), false);
+    if (!device_addr) {
+      DumpDynamicMemPoolDebugInfo();
+      DumpDynamicMemPoolStateInfo();
+      return device_addr_list;
+    }
+    return SplitContinuousMemBufBySizeClass(device_addr, size_list);
+  }
   // Pre-alloc the one whole piece memory.
   auto device_addr = AllocTensorMem(total_size, false);
   if (!device_addr) {
@@ -128,10 +222,22 @@ DeviceMemPtr DynamicMemPoolBestFit::FindIdleMemBuf(size_t size, bool from_persis
     mem_mng = persistent_mem_;
   }
   MS_EXCEPTION_IF_NULL(mem_mng);
-  const auto &iter = mem_mng->idle_mem_buf_map_.lower_bound(size);
-  if (iter != mem_mng->idle_mem_buf_map_.end()) {
-    auto mem_buf = iter->second;
-    MS_EXCEPTION_IF_NULL(mem_buf);
+  DynamicMemBufPtr mem_buf = nullptr;
+  if (pool_mode_ == DynamicMemPoolMode::kSizeClass) {
+    auto idle_mem_buf = FindIdleMemBufInBins(size, mem_mng);
+    if (idle_mem_buf != nullptr) {
+      RemoveIdleMemBufFromBin(idle_mem_buf, mem_mng);
+      mem_buf = mem_mng->mem_buf_map_.at(idle_mem_buf->device_addr_);
+    }
+  } else {
+    const auto &iter = mem_mng->idle_mem_buf_map_.lower_bound(size);
+    if (iter != mem_mng->idle_mem_buf_map_.end()) {
+      mem_buf = iter->second;
+      // Remove map of old idle memory buf
+      (void)mem_mng->idle_mem_buf_map_.erase(iter);
+    }
+  }
+  if (mem_buf != nullptr) {
     if (mem_buf->status_ != DynamicMemBufStatus::kMemBufIdle) {
       DumpDynamicMemPoolDebugInfo();
       MS_LOG(EXCEPTION) << "Find the mem_buf is not idle, alloc_size[" << size << "] mem_buf_size[" << mem_buf->size_
@@ -140,8 +246,6 @@ DeviceMemPtr DynamicMemPoolBestFit::FindIdleMemBuf(size_t size, bool from_persis
     mem_buf->status_ = DynamicMemBufStatus::kMemBufUsed;
     mem_buf->allocator_name_ = DynamicMemAllocatorDebugInfo::GetDebugInfo().name_;
     mem_buf->allocator_type_ = DynamicMemAllocatorDebugInfo::GetDebugInfo().type_;
-    // Remove map of old idle memory buf
-    (void)mem_mng->idle_mem_buf_map_.erase(iter);
     // Divide memory buf
     if (IsSplit(size, mem_buf->size_)) {
       SplitMemBuf(size, mem_buf, mem_mng);
@@ -235,7 +339,7 @@ DeviceMemPtr DynamicMemPoolBestFit::AddMemBlockAndMemBuf(size_t size, bool from_
                                                  DynamicMemAllocatorDebugInfo::GetDebugInfo().type_);
   MS_EXCEPTION_IF_NULL(mem_buf);
   // Add map of new memory buf in the block
-  (void)mem_block->block_all_mem_buf_map_.emplace(device_addr, mem_buf);
+  AddMemBufToBlock(mem_block, mem_buf, mem_mng);
   // Split memory buf
   if (IsSplit(size, mem_buf->size_)) {
     SplitMemBuf(size, mem_buf, mem_mng);
@@ -280,8 +384,12 @@ void DynamicMemPoolBestFit::SplitMemBuf(size_t size, const DynamicMemBufPtr &mem
                                         const MemStatusManagerPtr &mem_mng) {
   MS_EXCEPTION_IF_NULL(mem_buf);
   MS_EXCEPTION_IF_NULL(mem_mng);
-  const auto &mem_block = FindMemBlock(mem_buf->device_addr_, mem_mng);
-  MS_EXCEPTION_IF_NULL(mem_block);
+  // The memory block is not needed to split memory buf in the size class mode.
+  DynamicMemBlockPtr mem_block = nullptr;
+  if (pool_mode_ != DynamicMemPoolMode::kSizeClass) {
+    mem_block = FindMemBlock(mem_buf->device_addr_, mem_mng);
+    MS_EXCEPTION_IF_NULL(mem_block);
+  }
   // Divide new memory buf
   if (mem_buf->size_ < size) {
     DumpDynamicMemPoolDebugInfo();
@@ -291,10 +399,19 @@ void DynamicMemPoolBestFit::SplitMemBuf(size_t size, const DynamicMemBufPtr &mem
   mem_buf->size_ = size;
   DeviceMemPtr newbuf_addr = AddressOffset(mem_buf->device_addr_, size);
   auto new_mem_buf = std::make_shared<DynamicMemBuf>(newbuf_addr, DynamicMemBufStatus::kMemBufIdle, newbuf_size);
+  if (pool_mode_ == DynamicMemPoolMode::kSizeClass) {
+    // Insert the new memory buf after the memory buf in the boundary tags.
+    new_mem_buf->prev_buf_ = mem_buf.get();
+    new_mem_buf->next_buf_ = mem_buf->next_buf_;
+    if (mem_buf->next_buf_ != nullptr) {
+      mem_buf->next_buf_->prev_buf_ = new_mem_buf.get();
+    }
+    mem_buf->next_buf_ = new_mem_buf.get();
+  }
   // Add map of new memory buf in the block
-  (void)mem_block->block_all_mem_buf_map_.emplace(newbuf_addr, new_mem_buf);
+  AddMemBufToBlock(mem_block, new_mem_buf, mem_mng);
   // Add map of new idle memory buf
-  (void)mem_mng->idle_mem_buf_map_.emplace(newbuf_size, new_mem_buf);
+  AddIdleMemBuf(new_mem_buf, mem_mng);
 }
 
 bool DynamicMemPoolBestFit::CmpMemBlock(const DeviceMemPtr &device_addr, const DynamicMemBlockPtr &mem_block) {
@@ -317,7 +434,37 @@ DynamicMemBlockPtr DynamicMemPoolBestFit::FindMemBlock(const DeviceMemPtr &devic
 
 void DynamicMemPoolBestFit::FreeTensorMem(const DeviceMemPtr &device_addr) {
   MS_EXCEPTION_IF_NULL(device_addr);
+  if (pool_mode_ == DynamicMemPoolMode::kSizeClass && FreeToThreadCache(device_addr, GetThreadMemBufCache())) {
+    return;
+  }
   std::lock_guard<std::mutex> locker(mutex_);
+  FreeTensorMemInner(device_addr);
+  MS_LOG(DEBUG) << "Free memory details, name:" << DynamicMemAllocatorDebugInfo::GetDebugInfo().name_
+                << ", address:" << device_addr << ", total allocated mem:" << TotalMemStatistics()
+                << "B, peak used mem:" << UsedMemPeakStatistics() << "B, in used mem:" << TotalUsedMemStatistics()
+                << "B, total idle mem:" << (TotalMemStatistics() - TotalUsedMemStatistics()) << "B.";
+}
+
+void DynamicMemPoolBestFit::FreeTensorMemInner(const DeviceMemPtr &device_addr) {
+  if (pool_mode_ == DynamicMemPoolMode::kSizeClass) {
+    MemStatusManagerPtr mem_mng = nullptr;
+    auto mem_buf = FindMemBufBySizeClass(device_addr, &mem_mng);
+    if (mem_buf == nullptr) {
+      // Maybe destroy the memory pool first, then destroy the address, so this is normal case.
+      MS_LOG(DEBUG) << "Can't find the mem_buf of the device address[" << device_addr << "].";
+      return;
+    }
+    // The memory buf is allocated by another thread or the thread cache is full.
+    auto owner_cache = mem_buf->owner_cache_;
+    if (owner_cache != nullptr) {
+      std::lock_guard<std::mutex> cache_locker(owner_cache->mutex_);
+      (void)owner_cache->used_mem_bufs_.erase(device_addr);
+      mem_buf->owner_cache_ = nullptr;
+    }
+    CombineMemBufBySizeClass(mem_buf, mem_mng);
+    return;
+  }
+
   auto fn = [this](const MemStatusManagerPtr &mem_mng, const DeviceMemPtr &device_addr) -> DynamicMemBlockPtr {
     auto mem_block = FindMemBlock(device_addr, mem_mng);
     if (mem_block != nullptr) {
@@ -340,11 +487,6 @@ void DynamicMemPoolBestFit::FreeTensorMem(const DeviceMemPtr &device_addr) {
   } else {
     CombineMemBuf(mem_block, device_addr, common_mem_);
   }
-
-  MS_LOG(DEBUG) << "Free memory details, name:" << DynamicMemAllocatorDebugInfo::GetDebugInfo().name_
-                << ", address:" << device_addr << ", total allocated mem:" << TotalMemStatistics()
-                << "B, peak used mem:" << UsedMemPeakStatistics() << "B, in used mem:" << TotalUsedMemStatistics()
-                << "B, total idle mem:" << (TotalMemStatistics() - TotalUsedMemStatistics()) << "B.";
 }
 
 void DynamicMemPoolBestFit::CombineMemBuf(const DynamicMemBlockPtr &mem_block, const DeviceMemPtr &device_addr,
@@ -420,9 +562,351 @@ void DynamicMemPoolBestFit::EraseIdleMemBuf(size_t size, const DeviceMemPtr &dev
   MS_LOG(ERROR) << "Can't find the size[" << size << "] and device address[" << device_addr << "] in the idle mem_buf.";
 }
 
+void DynamicMemPoolBestFit::AddIdleMemBuf(const DynamicMemBufPtr &mem_buf, const MemStatusManagerPtr &mem_mng) const {
+  MS_EXCEPTION_IF_NULL(mem_buf);
+  MS_EXCEPTION_IF_NULL(mem_mng);
+  if (pool_mode_ == DynamicMemPoolMode::kSizeClass) {
+    PushIdleMemBufToBin(mem_buf.get(), mem_mng);
+  } else {
+    (void)mem_mng->idle_mem_buf_map_.emplace(mem_buf->size_, mem_buf);
+  }
+}
+
+void DynamicMemPoolBestFit::AddMemBufToBlock(const DynamicMemBlockPtr &mem_block, const DynamicMemBufPtr &mem_buf,
+                                             const MemStatusManagerPtr &mem_mng) const {
+  MS_EXCEPTION_IF_NULL(mem_buf);
+  MS_EXCEPTION_IF_NULL(mem_mng);
+  if (pool_mode_ == DynamicMemPoolMode::kSizeClass) {
+    (void)mem_mng->mem_buf_map_.emplace(mem_buf->device_addr_, mem_buf);
+  } else {
+    MS_EXCEPTION_IF_NULL(mem_block);
+    (void)mem_block->block_all_mem_buf_map_.emplace(mem_buf->device_addr_, mem_buf);
+  }
+}
+
+void DynamicMemPoolBestFit::ForEachBlockMemBuf(const DynamicMemBlockPtr &mem_block, const MemStatusManagerPtr &mem_mng,
+                                               const std::function<void(const DynamicMemBuf &mem_buf)> &visitor) const {
+  MS_EXCEPTION_IF_NULL(mem_block);
+  MS_EXCEPTION_IF_NULL(mem_mng);
+  if (pool_mode_ == DynamicMemPoolMode::kSizeClass) {
+    // The first memory buf is always at the base address of memory block, then follow the boundary tags.
+    const auto &iter = mem_mng->mem_buf_map_.find(mem_block->device_addr());
+    if (iter == mem_mng->mem_buf_map_.end()) {
+      return;
+    }
+    for (const DynamicMemBuf *mem_buf = iter->second.get(); mem_buf != nullptr; mem_buf = mem_buf->next_buf_) {
+      visitor(*mem_buf);
+    }
+    return;
+  }
+  for (const auto &iter : mem_block->block_all_mem_buf_map_) {
+    MS_EXCEPTION_IF_NULL(iter.second);
+    visitor(*iter.second);
+  }
+}
+
+void DynamicMemPoolBestFit::ForEachIdleMemBuf(const MemStatusManagerPtr &mem_mng,
+                                              const std::function<void(const DynamicMemBuf &mem_buf)> &visitor) const {
+  MS_EXCEPTION_IF_NULL(mem_mng);
+  if (pool_mode_ == DynamicMemPoolMode::kSizeClass) {
+    for (const DynamicMemBuf *head : mem_mng->idle_mem_buf_bins_) {
+      for (const DynamicMemBuf *mem_buf = head; mem_buf != nullptr; mem_buf = mem_buf->next_idle_) {
+        visitor(*mem_buf);
+      }
+    }
+    return;
+  }
+  for (const auto &iter : mem_mng->idle_mem_buf_map_) {
+    MS_EXCEPTION_IF_NULL(iter.second);
+    visitor(*iter.second);
+  }
+}
+
+size_t DynamicMemPoolBestFit::SizeClassOfIdleMemBuf(size_t size) {
+  // The memory buf in the size class is not smaller than the lower bound of the size class.
+  size_t units = size / DYNAMIC_MEM_ALIGN_SIZE;
+  if (units < SIZE_CLASS_SUB_BIN_NUM) {
+    return units;
+  }
+  size_t first_level = HighestBitIndex(units);
+  size_t second_level = (units >> (first_level - SIZE_CLASS_SUB_BIN_BITS)) & (SIZE_CLASS_SUB_BIN_NUM - 1);
+  return first_level * SIZE_CLASS_SUB_BIN_NUM + second_level;
+}
+
+size_t DynamicMemPoolBestFit::SizeClassOfAllocSize(size_t size) {
+  // Round up to the next size class, so that any memory buf in the size class can hold the size.
+  size_t units = (size + DYNAMIC_MEM_ALIGN_SIZE - 1) / DYNAMIC_MEM_ALIGN_SIZE;
+  if (units < SIZE_CLASS_SUB_BIN_NUM) {
+    return units;
+  }
+  size_t first_level = HighestBitIndex(units);
+  units += (static_cast<size_t>(1) << (first_level - SIZE_CLASS_SUB_BIN_BITS)) - 1;
+  return SizeClassOfIdleMemBuf(units * DYNAMIC_MEM_ALIGN_SIZE);
+}
+
+void DynamicMemPoolBestFit::PushIdleMemBufToBin(DynamicMemBuf *mem_buf, const MemStatusManagerPtr &mem_mng) const {
+  size_t size_class = SizeClassOfIdleMemBuf(mem_buf->size_);
+  auto &head = mem_mng->idle_mem_buf_bins_[size_class];
+  mem_buf->prev_idle_ = nullptr;
+  mem_buf->next_idle_ = head;
+  if (head != nullptr) {
+    head->prev_idle_ = mem_buf;
+  }
+  head = mem_buf;
+  ++mem_mng->idle_mem_buf_count_[size_class];
+  mem_mng->idle_mem_buf_bitmap_[size_class / 64] |= (static_cast<uint64_t>(1) << (size_class % 64));
+}
+
+void DynamicMemPoolBestFit::RemoveIdleMemBufFromBin(DynamicMemBuf *mem_buf, const MemStatusManagerPtr &mem_mng) const {
+  size_t size_class = SizeClassOfIdleMemBuf(mem_buf->size_);
+  if (mem_buf->prev_idle_ != nullptr) {
+    mem_buf->prev_idle_->next_idle_ = mem_buf->next_idle_;
+  } else {
+    mem_mng->idle_mem_buf_bins_[size_class] = mem_buf->next_idle_;
+  }
+  if (mem_buf->next_idle_ != nullptr) {
+    mem_buf->next_idle_->prev_idle_ = mem_buf->prev_idle_;
+  }
+  mem_buf->prev_idle_ = nullptr;
+  mem_buf->next_idle_ = nullptr;
+  --mem_mng->idle_mem_buf_count_[size_class];
+  if (mem_mng->idle_mem_buf_bins_[size_class] == nullptr) {
+    mem_mng->idle_mem_buf_bitmap_[size_class / 64] &= ~(static_cast<uint64_t>(1) << (size_class % 64));
+  }
+}
+
+DynamicMemBuf *DynamicMemPoolBestFit::FindIdleMemBufInBins(size_t size, const MemStatusManagerPtr &mem_mng) const {
+  // Try a few memory bufs in the size class of the size first, which may fit exactly for the repeated sizes.
+  constexpr size_t kMaxProbeCount = 8;
+  size_t probe_count = 0;
+  for (auto mem_buf = mem_mng->idle_mem_buf_bins_[SizeClassOfIdleMemBuf(size)];
+       mem_buf != nullptr && probe_count < kMaxProbeCount; mem_buf = mem_buf->next_idle_, ++probe_count) {
+    if (mem_buf->size_ >= size) {
+      return mem_buf;
+    }
+  }
+  // Then take the first memory buf of the first non-empty size class which can hold the size.
+  size_t size_class = SizeClassOfAllocSize(size);
+  if (size_class >= SIZE_CLASS_BIN_NUM) {
+    return nullptr;
+  }
+  size_t word_index = size_class / 64;
+  uint64_t bitmap = mem_mng->idle_mem_buf_bitmap_[word_index] & (~static_cast<uint64_t>(0) << (size_class % 64));
+  while (bitmap == 0) {
+    if (++word_index >= SIZE_CLASS_BIN_NUM / 64) {
+      return nullptr;
+    }
+    bitmap = mem_mng->idle_mem_buf_bitmap_[word_index];
+  }
+  return mem_mng->idle_mem_buf_bins_[word_index * 64 + LowestBitIndex(bitmap)];
+}
+
+DynamicMemBufPtr DynamicMemPoolBestFit::FindMemBufBySizeClass(const DeviceMemPtr &device_addr,
+                                                              MemStatusManagerPtr *mem_mng) const {
+  MS_EXCEPTION_IF_NULL(mem_mng);
+  auto iter = common_mem_->mem_buf_map_.find(device_addr);
+  if (iter != common_mem_->mem_buf_map_.end()) {
+    *mem_mng = common_mem_;
+    return iter->second;
+  }
+  iter = persistent_mem_->mem_buf_map_.find(device_addr);
+  if (iter != persistent_mem_->mem_buf_map_.end()) {
+    *mem_mng = persistent_mem_;
+    return iter->second;
+  }
+  return nullptr;
+}
+
+void DynamicMemPoolBestFit::CombineMemBufBySizeClass(DynamicMemBufPtr mem_buf, const MemStatusManagerPtr &mem_mng) {
+  MS_EXCEPTION_IF_NULL(mem_buf);
+  MS_EXCEPTION_IF_NULL(mem_mng);
+  if (mem_buf->status_ != DynamicMemBufStatus::kMemBufUsed) {
+    DumpDynamicMemPoolDebugInfo();
+    MS_LOG(EXCEPTION) << "Find the mem_buf is not used, mem_buf_address[" << mem_buf->device_addr_ << "].";
+  }
+  mem_buf->status_ = DynamicMemBufStatus::kMemBufIdle;
+  if (mem_mng->mps_.total_used_mem_size_ < mem_buf->size_) {
+    DumpDynamicMemPoolDebugInfo();
+    MS_LOG(EXCEPTION) << "The total used mem size is less than the size of membuf.";
+  }
+  mem_mng->mps_.total_used_mem_size_ -= mem_buf->size_;
+  // Combine backward(combine the next_mem_buf to mem_buf) by the boundary tags
+  auto next_mem_buf = mem_buf->next_buf_;
+  if (next_mem_buf != nullptr && next_mem_buf->status_ == DynamicMemBufStatus::kMemBufIdle) {
+    RemoveIdleMemBufFromBin(next_mem_buf, mem_mng);
+    mem_buf->size_ += next_mem_buf->size_;
+    mem_buf->next_buf_ = next_mem_buf->next_buf_;
+    if (mem_buf->next_buf_ != nullptr) {
+      mem_buf->next_buf_->prev_buf_ = mem_buf.get();
+    }
+    (void)mem_mng->mem_buf_map_.erase(next_mem_buf->device_addr_);
+  }
+  // Combine forward(combine the mem_buf to prev_mem_buf)
+  auto prev_mem_buf = mem_buf->prev_buf_;
+  if (prev_mem_buf != nullptr && prev_mem_buf->status_ == DynamicMemBufStatus::kMemBufIdle) {
+    RemoveIdleMemBufFromBin(prev_mem_buf, mem_mng);
+    prev_mem_buf->size_ += mem_buf->size_;
+    prev_mem_buf->next_buf_ = mem_buf->next_buf_;
+    if (prev_mem_buf->next_buf_ != nullptr) {
+      prev_mem_buf->next_buf_->prev_buf_ = prev_mem_buf;
+    }
+    (void)mem_mng->mem_buf_map_.erase(mem_buf->device_addr_);
+    PushIdleMemBufToBin(prev_mem_buf, mem_mng);
+    return;
+  }
+  PushIdleMemBufToBin(mem_buf.get(), mem_mng);
+}
+
+std::vector<DeviceMemPtr> DynamicMemPoolBestFit::SplitContinuousMemBufBySizeClass(
+  const DeviceMemPtr &device_addr, const std::vector<size_t> &size_list) {
+  std::vector<DeviceMemPtr> device_addr_list;
+  MemStatusManagerPtr mem_mng = nullptr;
+  auto mem_buf = FindMemBufBySizeClass(device_addr, &mem_mng);
+  if (mem_buf == nullptr) {
+    DumpDynamicMemPoolDebugInfo();
+    MS_LOG(EXCEPTION) << "Can't find the device address[" << device_addr << "].";
+  }
+  size_t total_size = std::accumulate(size_list.begin(), size_list.end(), IntToSize(0));
+  if (mem_buf->size_ < total_size) {
+    DumpDynamicMemPoolDebugInfo();
+    MS_LOG(EXCEPTION) << "The size of membuf is less than total_size.";
+  }
+  auto rest_size = mem_buf->size_ - total_size;
+  // The pre-alloc memory buf is reused as the first continuous memory buf.
+  DynamicMemBuf *continuous_mem_buf = mem_buf.get();
+  auto buf_addr = device_addr;
+  for (size_t i = 0; i < size_list.size(); ++i) {
+    if (i > 0) {
+      auto new_mem_buf = std::make_shared<DynamicMemBuf>(buf_addr, DynamicMemBufStatus::kMemBufUsed, size_list[i],
+                                                         DynamicMemAllocatorDebugInfo::GetDebugInfo().name_,
+                                                         DynamicMemAllocatorDebugInfo::GetDebugInfo().type_);
+      new_mem_buf->prev_buf_ = continuous_mem_buf;
+      new_mem_buf->next_buf_ = continuous_mem_buf->next_buf_;
+      if (continuous_mem_buf->next_buf_ != nullptr) {
+        continuous_mem_buf->next_buf_->prev_buf_ = new_mem_buf.get();
+      }
+      continuous_mem_buf->next_buf_ = new_mem_buf.get();
+      continuous_mem_buf = new_mem_buf.get();
+      (void)mem_mng->mem_buf_map_.emplace(buf_addr, new_mem_buf);
+    } else {
+      continuous_mem_buf->size_ = size_list[i];
+    }
+    device_addr_list.emplace_back(buf_addr);
+    buf_addr = AddressOffset(buf_addr, size_list[i]);
+  }
+  // Update the size of the last memory buf.
+  continuous_mem_buf->size_ += rest_size;
+  return device_addr_list;
+}
+
+ThreadMemBufCache *DynamicMemPoolBestFit::GetThreadMemBufCache() {
+  // The key is the unique id of memory pool, so the cache of a destroyed memory pool is never used again.
+  static thread_local std::unordered_map<size_t, ThreadMemBufCachePtr> thread_caches;
+  const auto &iter = thread_caches.find(pool_id_);
+  if (iter != thread_caches.end()) {
+    return iter->second.get();
+  }
+  auto cache = std::make_shared<ThreadMemBufCache>();
+  {
+    std::lock_guard<std::mutex> locker(mutex_);
+    thread_caches_.emplace_back(cache);
+  }
+  (void)thread_caches.emplace(pool_id_, cache);
+  return cache.get();
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocFromThreadCache(size_t size, ThreadMemBufCache *cache) {
+  MS_EXCEPTION_IF_NULL(cache);
+  std::lock_guard<std::mutex> cache_locker(cache->mutex_);
+  auto &cached_mem_bufs = cache->cached_mem_bufs_[SizeClassOfIdleMemBuf(size)];
+  // Take the most recently freed memory buf which can hold the size.
+  for (auto iter = cached_mem_bufs.rbegin(); iter != cached_mem_bufs.rend(); ++iter) {
+    auto mem_buf = *iter;
+    if (mem_buf->size_ < size) {
+      continue;
+    }
+    (void)cached_mem_bufs.erase(std::next(iter).base());
+    cache->cached_size_ -= mem_buf->size_;
+    thread_cached_mem_size_ -= mem_buf->size_;
+    mem_buf->allocator_name_ = DynamicMemAllocatorDebugInfo::GetDebugInfo().name_;
+    mem_buf->allocator_type_ = DynamicMemAllocatorDebugInfo::GetDebugInfo().type_;
+    cache->used_mem_bufs_[mem_buf->device_addr_] = mem_buf;
+    ++thread_cache_hit_count_;
+    return mem_buf->device_addr_;
+  }
+  ++thread_cache_miss_count_;
+  return nullptr;
+}
+
+bool DynamicMemPoolBestFit::FreeToThreadCache(const DeviceMemPtr &device_addr, ThreadMemBufCache *cache) {
+  MS_EXCEPTION_IF_NULL(cache);
+  std::lock_guard<std::mutex> cache_locker(cache->mutex_);
+  const auto &iter = cache->used_mem_bufs_.find(device_addr);
+  if (iter == cache->used_mem_bufs_.end()) {
+    return false;
+  }
+  auto mem_buf = iter->second;
+  MS_EXCEPTION_IF_NULL(mem_buf);
+  auto &cached_mem_bufs = cache->cached_mem_bufs_[SizeClassOfIdleMemBuf(mem_buf->size_)];
+  if (cached_mem_bufs.size() >= THREAD_CACHE_MAX_BUF_NUM_PER_BIN ||
+      cache->cached_size_ + mem_buf->size_ > THREAD_CACHE_MAX_SIZE) {
+    return false;
+  }
+  (void)cache->used_mem_bufs_.erase(iter);
+  cached_mem_bufs.emplace_back(mem_buf);
+  cache->cached_size_ += mem_buf->size_;
+  thread_cached_mem_size_ += mem_buf->size_;
+  return true;
+}
+
+void DynamicMemPoolBestFit::ReclaimThreadCaches() {
+  for (auto &cache : thread_caches_) {
+    MS_EXCEPTION_IF_NULL(cache);
+    std::lock_guard<std::mutex> cache_locker(cache->mutex_);
+    for (auto &cached_mem_bufs : cache->cached_mem_bufs_) {
+      for (auto mem_buf : cached_mem_bufs) {
+        MemStatusManagerPtr mem_mng = nullptr;
+        auto mem_buf_ptr = FindMemBufBySizeClass(mem_buf->device_addr_, &mem_mng);
+        MS_EXCEPTION_IF_NULL(mem_buf_ptr);
+        mem_buf_ptr->owner_cache_ = nullptr;
+        CombineMemBufBySizeClass(mem_buf_ptr, mem_mng);
+      }
+      cached_mem_bufs.clear();
+    }
+    thread_cached_mem_size_ -= cache->cached_size_;
+    cache->cached_size_ = 0;
+  }
+  MS_LOG(DEBUG) << "Reclaim the memory cached by threads, total idle mem:"
+                << (TotalMemStatistics() - TotalUsedMemStatistics()) << "B.";
+}
+
+float DynamicMemPoolBestFit::IdleMemFragmentation(const MemStatusManagerPtr &mem_mng) const {
+  size_t total_idle_size = 0;
+  size_t max_idle_size = 0;
+  ForEachIdleMemBuf(mem_mng, [&total_idle_size, &max_idle_size](const DynamicMemBuf &mem_buf) {
+    total_idle_size += mem_buf.size_;
+    max_idle_size = std::max(max_idle_size, mem_buf.size_);
+  });
+  if (total_idle_size == 0) {
+    return 0;
+  }
+  return 1.0f - static_cast<float>(max_idle_size) / static_cast<float>(total_idle_size);
+}
+
 void DynamicMemPoolBestFit::ReleaseDeviceRes() {
   std::lock_guard<std::mutex> locker(mutex_);
   DumpDynamicMemPoolStateInfo();
+  // The memory bufs held by the thread caches are invalid after the device memory is released.
+  for (auto &cache : thread_caches_) {
+    MS_EXCEPTION_IF_NULL(cache);
+    std::lock_guard<std::mutex> cache_locker(cache->mutex_);
+    cache->used_mem_bufs_.clear();
+    for (auto &cached_mem_bufs : cache->cached_mem_bufs_) {
+      cached_mem_bufs.clear();
+    }
+    cache->cached_size_ = 0;
+  }
+  thread_cached_mem_size_ = 0;
 
   auto fn = [this](const MemStatusManagerPtr &mem_mng) {
     MS_EXCEPTION_IF_NULL(mem_mng);
@@ -436,8 +920,7 @@ void DynamicMemPoolBestFit::ReleaseDeviceRes() {
         device_addr = nullptr;
       }
     }
-    mem_mng->mem_block_list_.clear();
-    mem_mng->idle_mem_buf_map_.clear();
+    mem_mng->clear();
   };
   fn(common_mem_);
   fn(persistent_mem_);
@@ -455,15 +938,14 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolStateInfo() {
     for (size_t i = 0; i < mem_mng->mem_block_list_.size(); ++i) {
       size_t mem_block_used_size = 0;
       MS_EXCEPTION_IF_NULL(mem_mng->mem_block_list_[i]);
-      for (auto mb = mem_mng->mem_block_list_[i]->block_all_mem_buf_map_.begin();
-           mb != mem_mng->mem_block_list_[i]->block_all_mem_buf_map_.end(); ++mb) {
-        if (mb->second->status_ == DynamicMemBufStatus::kMemBufUsed) {
-          mem_block_used_size += mb->second->size_;
-          MS_EXCEPTION_IF_CHECK_FAIL((static_cast<int>(mb->second->allocator_type_) < ALLOCATOR_TYPE_NUM),
+      ForEachBlockMemBuf(mem_mng->mem_block_list_[i], mem_mng, [&](const DynamicMemBuf &mem_buf) {
+        if (mem_buf.status_ == DynamicMemBufStatus::kMemBufUsed) {
+          mem_block_used_size += mem_buf.size_;
+          MS_EXCEPTION_IF_CHECK_FAIL((static_cast<int>(mem_buf.allocator_type_) < ALLOCATOR_TYPE_NUM),
                                      "Allocator type is out of range.");
-          total_used_size_list[static_cast<int>(mb->second->allocator_type_)] += mb->second->size_;
+          total_used_size_list[static_cast<int>(mem_buf.allocator_type_)] += mem_buf.size_;
         }
-      }
+      });
       buf << ", block[" << i << "] block size:" << mem_mng->mem_block_list_[i]->mem_block_size_ / kMBToByte
           << "M idle size:" << (mem_mng->mem_block_list_[i]->mem_block_size_ - mem_block_used_size) / kMBToByte << "M";
     }
@@ -474,7 +956,17 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolStateInfo() {
                  << "M, in used mem:" << mem_mng->mps_.total_used_mem_size_ / kMBToByte << "M, total idle mem:"
                  << (mem_mng->mps_.total_mem_size_ - mem_mng->mps_.total_used_mem_size_) / kMBToByte
                  << "M. Block unit size:" << mem_mng->unit_size_ / kMBToByte
-                 << "M, block counts:" << mem_mng->mem_block_list_.size() << buf.str();
+                 << "M, block counts:" << mem_mng->mem_block_list_.size()
+                 << ", idle mem fragmentation:" << IdleMemFragmentation(mem_mng) << buf.str();
+    if (pool_mode_ == DynamicMemPoolMode::kSizeClass) {
+      std::ostringstream bins;
+      for (size_t i = 0; i < SIZE_CLASS_BIN_NUM; ++i) {
+        if (mem_mng->idle_mem_buf_count_[i] != 0) {
+          bins << " [" << i << "]:" << mem_mng->idle_mem_buf_count_[i];
+        }
+      }
+      MS_LOG(INFO) << mem_type << " idle mem_buf counts by size class:" << bins.str();
+    }
   };
 
   fn(common_mem_, std::string(kCommonMem));
@@ -490,10 +982,15 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolStateInfo() {
                << total_used_size_list[static_cast<int>(AllocatorType::kKernelOutput)] / kMBToByte
                << "M, other used size:" << total_used_size_list[static_cast<int>(AllocatorType::kOther)] / kMBToByte
                << "M.";
+  if (pool_mode_ == DynamicMemPoolMode::kSizeClass) {
+    MS_LOG(INFO) << "The dynamic memory pool size class mode, thread cached mem:"
+                 << ThreadCachedMemStatistics() / kMBToByte << "M, thread cache counts:" << thread_caches_.size()
+                 << ", thread cache hit:" << thread_cache_hit_count_ << ", miss:" << thread_cache_miss_count_ << ".";
+  }
 }
 
 void DynamicMemPoolBestFit::DumpDynamicMemPoolDebugInfo() {
-  auto fn = [](const MemStatusManagerPtr &mem_mng, const std::string &mem_type) {
+  auto fn = [this](const MemStatusManagerPtr &mem_mng, const std::string &mem_type) {
     MS_EXCEPTION_IF_NULL(mem_mng);
     size_t total_mem = 0;
     size_t total_used_mem = 0;
@@ -503,33 +1000,31 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolDebugInfo() {
     MS_LOG(WARNING) << mem_type << " all mem_block info: counts[" << mem_mng->mem_block_list_.size() << "].";
     for (auto iter = mem_mng->mem_block_list_.begin(); iter != mem_mng->mem_block_list_.end(); ++iter) {
       total_mem += (*iter)->size();
-      auto mem_buf_map = (*iter)->block_all_mem_buf_map_;
+      size_t mem_buf_count = 0;
+      ForEachBlockMemBuf(*iter, mem_mng, [&mem_buf_count](const DynamicMemBuf &) { ++mem_buf_count; });
       MS_LOG(WARNING) << " MemBlock info: number[" << iter - mem_mng->mem_block_list_.begin() << "] mem_buf_counts["
-                      << mem_buf_map.size() << "] base_address[" << (*iter)->device_addr() << "] block_size["
+                      << mem_buf_count << "] base_address[" << (*iter)->device_addr() << "] block_size["
                       << (*iter)->size() << "].";
-      for (auto iter_mem_buf = mem_buf_map.begin(); iter_mem_buf != mem_buf_map.end(); ++iter_mem_buf) {
-        auto mem_buf = iter_mem_buf->second;
-        MS_EXCEPTION_IF_NULL(mem_buf);
-        if (mem_buf->status_ == DynamicMemBufStatus::kMemBufIdle) {
-          total_idle_mem1 += mem_buf->size_;
+      ForEachBlockMemBuf(*iter, mem_mng, [&](const DynamicMemBuf &mem_buf) {
+        if (mem_buf.status_ == DynamicMemBufStatus::kMemBufIdle) {
+          total_idle_mem1 += mem_buf.size_;
         } else {
-          total_used_mem += mem_buf->size_;
+          total_used_mem += mem_buf.size_;
         }
-        MS_LOG(INFO) << "  MemBuf info: address[" << mem_buf->device_addr_ << "] size[" << mem_buf->size_ << "] status["
-                     << kBufStatusString.at(mem_buf->status_) << "] name[" << mem_buf->allocator_name_ << "] type["
-                     << kAllocatorTypeString.at(mem_buf->allocator_type_) << "].";
-      }
+        MS_LOG(INFO) << "  MemBuf info: address[" << mem_buf.device_addr_ << "] size[" << mem_buf.size_ << "] status["
+                     << kBufStatusString.at(mem_buf.status_) << "] name[" << mem_buf.allocator_name_ << "] type["
+                     << kAllocatorTypeString.at(mem_buf.allocator_type_) << "].";
+      });
     }
     // Dump all the idle memory buf info.
-    MS_LOG(WARNING) << mem_type << " all idle mem_buf info: counts[" << mem_mng->idle_mem_buf_map_.size() << "].";
-    for (auto iter_idle = mem_mng->idle_mem_buf_map_.begin(); iter_idle != mem_mng->idle_mem_buf_map_.end();
-         ++iter_idle) {
-      auto mem_buf = iter_idle->second;
-      MS_EXCEPTION_IF_NULL(mem_buf);
-      total_idle_mem2 += mem_buf->size_;
-      MS_LOG(INFO) << " Idle mem_buf info: size[" << mem_buf->size_ << "] address[" << mem_buf->device_addr_
-                   << "] status[" << kBufStatusString.at(mem_buf->status_) << "].";
-    }
+    size_t idle_mem_buf_count = 0;
+    ForEachIdleMemBuf(mem_mng, [&idle_mem_buf_count](const DynamicMemBuf &) { ++idle_mem_buf_count; });
+    MS_LOG(WARNING) << mem_type << " all idle mem_buf info: counts[" << idle_mem_buf_count << "].";
+    ForEachIdleMemBuf(mem_mng, [&total_idle_mem2](const DynamicMemBuf &mem_buf) {
+      total_idle_mem2 += mem_buf.size_;
+      MS_LOG(INFO) << " Idle mem_buf info: size[" << mem_buf.size_ << "] address[" << mem_buf.device_addr_
+                   << "] status[" << kBufStatusString.at(mem_buf.status_) << "].";
+    });
     // Dump the memory statistical info.
     MS_LOG(WARNING) << mem_type << " total allocated memory[" << total_mem << "], used memory[" << total_used_mem
                     << "], idle memory[" << total_idle_mem1 << "].";
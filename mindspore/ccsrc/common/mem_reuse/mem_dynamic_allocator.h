@@ -17,10 +17,14 @@
 #ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_MEM_REUSE_MEM_DYNAMIC_ALLOCATOR_H_
 #define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_MEM_REUSE_MEM_DYNAMIC_ALLOCATOR_H_
 
+#include <atomic>
 #include <memory>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <algorithm>
+#include <functional>
+#include <iterator>
 #include <utility>
 #include <thread>
 #include <mutex>
@@ -35,6 +39,10 @@ using DeviceMemPtr = void(*);
 // The status of memory buf.
 enum class DynamicMemBufStatus : int { kMemBufIdle, kMemBufUsed };
 
+// The mode of dynamic memory pool, the size class mode finds idle memory buf in the segregated lists by size class and
+// caches the small memory buf in each thread.
+enum class DynamicMemPoolMode : int { kBestFit, kSizeClass };
+
 // Memory allocator type is used to record the memory classification statistics information.
 enum class AllocatorType : int { kWeight, kConstantValue, kKernelOutput, kOther };
 static const int ALLOCATOR_TYPE_NUM = 4;
@@ -45,6 +53,16 @@ static const size_t DYNAMIC_MEM_ALIGN_SIZE = 512;
 // The minimum unit size (1G) of memory block used for dynamic extend.
 static const size_t DYNAMIC_MEM_ALLOC_UNIT_SIZE = 1024 << 20;
 
+// Each power of two size range is divided into 4 linear size classes.
+static const size_t SIZE_CLASS_SUB_BIN_BITS = 2;
+static const size_t SIZE_CLASS_SUB_BIN_NUM = 1 << SIZE_CLASS_SUB_BIN_BITS;
+static const size_t SIZE_CLASS_BIN_NUM = 64 * SIZE_CLASS_SUB_BIN_NUM;
+// The memory buf not larger than this size (1M) is cached in the thread which frees it.
+static const size_t THREAD_CACHE_MAX_BUF_SIZE = 1 << 20;
+// The upper limit of the memory cached by each thread (64M) and the memory buf count of each size class in it.
+static const size_t THREAD_CACHE_MAX_SIZE = 64 << 20;
+static const size_t THREAD_CACHE_MAX_BUF_NUM_PER_BIN = 32;
+
 // The Comparator of device address from small to large.
 struct DeviceAddrCmp {
   bool operator()(const DeviceMemPtr &addr1, const DeviceMemPtr &addr2) const { return addr1 < addr2; }
@@ -79,6 +97,8 @@ class DynamicMemAllocatorDebugInfo {
   static thread_local AllocatorDebugInfo debug_info_;
 };
 
+class ThreadMemBufCache;
+
 // Memory buf is the smallest operation object of dynamic memory pool.
 struct DynamicMemBuf {
   DynamicMemBuf(DeviceMemPtr addr, DynamicMemBufStatus status, size_t size,
@@ -92,6 +112,15 @@ struct DynamicMemBuf {
   DynamicMemBufStatus status_;
   size_t size_;
 
+  // Boundary tags of the size class mode: the adjacent memory bufs in the same memory block.
+  DynamicMemBuf *prev_buf_{nullptr};
+  DynamicMemBuf *next_buf_{nullptr};
+  // The links in the idle memory buf list of the size class.
+  DynamicMemBuf *prev_idle_{nullptr};
+  DynamicMemBuf *next_idle_{nullptr};
+  // The thread cache which holds the used memory buf in the size class mode.
+  ThreadMemBufCache *owner_cache_{nullptr};
+
   // Debug info.
   std::string allocator_name_;
   AllocatorType allocator_type_;
@@ -138,18 +167,48 @@ struct MemStatusManager {
   std::vector<DynamicMemBlockPtr> mem_block_list_;
   // The map of all idle memory buf by size.
   SizeMapMemBuf idle_mem_buf_map_;
+  // The map of all memory buf by device address, used in the size class mode instead of the map in memory block.
+  std::unordered_map<DeviceMemPtr, DynamicMemBufPtr> mem_buf_map_;
+  // The segregated idle memory buf lists by size class and the bitmap of the non-empty lists, used in the size class
+  // mode instead of idle_mem_buf_map_.
+  DynamicMemBuf *idle_mem_buf_bins_[SIZE_CLASS_BIN_NUM]{nullptr};
+  uint64_t idle_mem_buf_bitmap_[SIZE_CLASS_BIN_NUM / 64]{0};
+  size_t idle_mem_buf_count_[SIZE_CLASS_BIN_NUM]{0};
   void clear() noexcept {
     mem_block_list_.clear();
     idle_mem_buf_map_.clear();
+    mem_buf_map_.clear();
+    std::fill(std::begin(idle_mem_buf_bins_), std::end(idle_mem_buf_bins_), nullptr);
+    std::fill(std::begin(idle_mem_buf_bitmap_), std::end(idle_mem_buf_bitmap_), 0);
+    std::fill(std::begin(idle_mem_buf_count_), std::end(idle_mem_buf_count_), 0);
   }
 };
 using MemStatusManagerPtr = std::shared_ptr<MemStatusManager>;
 
+// The used and cached small memory bufs of one thread in the size class mode. The cached memory buf is still used in
+// the view of the memory pool, so the thread can reuse it without the lock of the memory pool. The mutex is only
+// contended when the memory pool reclaims the cached memory buf.
+class ThreadMemBufCache {
+ public:
+  ThreadMemBufCache() = default;
+  ~ThreadMemBufCache() = default;
+
+ private:
+  friend class DynamicMemPoolBestFit;
+
+  std::mutex mutex_;
+  // The used memory bufs which are allocated by this thread.
+  std::unordered_map<DeviceMemPtr, DynamicMemBuf *> used_mem_bufs_;
+  // The cached memory bufs by size class.
+  std::vector<DynamicMemBuf *> cached_mem_bufs_[SIZE_CLASS_BIN_NUM];
+  size_t cached_size_{0};
+};
+using ThreadMemBufCachePtr = std::shared_ptr<ThreadMemBufCache>;
+
 // The main class of dynamic memory pool.
 class BACKEND_EXPORT DynamicMemPoolBestFit {
  public:
-  DynamicMemPoolBestFit()
-      : persistent_mem_(std::make_shared<MemStatusManager>()), common_mem_(std::make_shared<MemStatusManager>()) {}
+  DynamicMemPoolBestFit();
   virtual ~DynamicMemPoolBestFit();
 
   // The main program entry of memory alloc.
@@ -177,6 +236,10 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
   size_t UsedMemPeakStatistics() const {
     return common_mem_->mps_.used_mem_peak_size_ + persistent_mem_->mps_.used_mem_peak_size_;
   }
+  // The memory cached by the threads is counted in the used memory.
+  size_t ThreadCachedMemStatistics() const { return thread_cached_mem_size_; }
+
+  DynamicMemPoolMode pool_mode() const { return pool_mode_; }
 
   // Display the brief state information of memory block and memory buf.
   void DumpDynamicMemPoolStateInfo();
@@ -197,8 +260,17 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
   virtual size_t AlignMemorySize(size_t size) const;
   // Calculate memory block required alloc size when adding the memory block.
   virtual size_t CalMemBlockAllocSize(size_t size, bool from_persistent_mem);
+  // Set the pool mode, which is only allowed before any memory is allocated.
+  void set_pool_mode(DynamicMemPoolMode pool_mode);
+  // Visit all the idle memory bufs of the memory manager in any pool mode.
+  void ForEachIdleMemBuf(const MemStatusManagerPtr &mem_mng,
+                         const std::function<void(const DynamicMemBuf &mem_buf)> &visitor) const;
 
  private:
+  // The alloc and free without the lock of memory pool.
+  DeviceMemPtr AllocTensorMemInner(size_t size, bool from_persistent_mem);
+  void FreeTensorMemInner(const DeviceMemPtr &device_addr);
+
   // Find the idle memory buf by aligned size when memory alloc.
   DeviceMemPtr FindIdleMemBuf(size_t size, bool from_persistent_mem);
   // Add the memory block and memory buf when memory alloc not find the idle memory buf.
@@ -216,9 +288,46 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
                      const MemStatusManagerPtr &mem_mng);
   // Erase the idle memory buf by size and device address when idle memory buf is combined.
   void EraseIdleMemBuf(size_t size, const DeviceMemPtr &device_addr, const MemStatusManagerPtr &mem_mng) const;
-
+  // Add the idle memory buf in any pool mode.
+  void AddIdleMemBuf(const DynamicMemBufPtr &mem_buf, const MemStatusManagerPtr &mem_mng) const;
+  // Add the memory buf into the memory block in any pool mode.
+  void AddMemBufToBlock(const DynamicMemBlockPtr &mem_block, const DynamicMemBufPtr &mem_buf,
+                        const MemStatusManagerPtr &mem_mng) const;
+  // Visit the memory bufs of the memory block by device address in any pool mode.
+  void ForEachBlockMemBuf(const DynamicMemBlockPtr &mem_block, const MemStatusManagerPtr &mem_mng,
+                          const std::function<void(const DynamicMemBuf &mem_buf)> &visitor) const;
+
+  // The related functions of the size class mode.
+  static size_t SizeClassOfIdleMemBuf(size_t size);
+  static size_t SizeClassOfAllocSize(size_t size);
+  void PushIdleMemBufToBin(DynamicMemBuf *mem_buf, const MemStatusManagerPtr &mem_mng) const;
+  void RemoveIdleMemBufFromBin(DynamicMemBuf *mem_buf, const MemStatusManagerPtr &mem_mng) const;
+  DynamicMemBuf *FindIdleMemBufInBins(size_t size, const MemStatusManagerPtr &mem_mng) const;
+  void CombineMemBufBySizeClass(DynamicMemBufPtr mem_buf, const MemStatusManagerPtr &mem_mng);
+  std::vector<DeviceMemPtr> SplitContinuousMemBufBySizeClass(const DeviceMemPtr &device_addr,
+                                                             const std::vector<size_t> &size_list);
+  // Find the memory manager and the memory buf by device address in the size class mode.
+  DynamicMemBufPtr FindMemBufBySizeClass(const DeviceMemPtr &device_addr, MemStatusManagerPtr *mem_mng) const;
+
+  // The related functions of the thread cache in the size class mode.
+  ThreadMemBufCache *GetThreadMemBufCache();
+  DeviceMemPtr AllocFromThreadCache(size_t size, ThreadMemBufCache *cache);
+  bool FreeToThreadCache(const DeviceMemPtr &device_addr, ThreadMemBufCache *cache);
+  // Return all the cached memory bufs of the threads to the memory pool, must be called with the lock of memory pool.
+  void ReclaimThreadCaches();
+  // Compute the fragmentation of the idle memory: 1 - largest idle memory buf size / total idle memory size.
+  float IdleMemFragmentation(const MemStatusManagerPtr &mem_mng) const;
+
+  DynamicMemPoolMode pool_mode_{DynamicMemPoolMode::kBestFit};
   // Support multi-thread.
   std::mutex mutex_;
+  // The unique id of the memory pool which is used to find the thread cache.
+  size_t pool_id_{0};
+  // All the thread caches created by this memory pool.
+  std::vector<ThreadMemBufCachePtr> thread_caches_;
+  std::atomic<size_t> thread_cached_mem_size_{0};
+  std::atomic<size_t> thread_cache_hit_count_{0};
+  std::atomic<size_t> thread_cache_miss_count_{0};
   MemStatusManagerPtr persistent_mem_{nullptr};
   MemStatusManagerPtr common_mem_{nullptr};
   // In the graph mode, the unit size set in the context will be modified through the FetchMemUnitSize function, so it
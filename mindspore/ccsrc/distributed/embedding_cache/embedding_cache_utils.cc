@@ -209,5 +209,25 @@ void EmbeddingCacheTableManager::DumpHashTables() const {
                  << ", host cache address:" << reinterpret_cast<void *>(item.second.host_address.get());
   }
 }
+
+void EmbeddingStoreManager::Add(const std::string &name, std::shared_ptr<EmbeddingStore<int32_t, float>> emb_store) {
+  MS_EXCEPTION_IF_NULL(emb_store);
+  std::lock_guard<std::mutex> lock(mutex_);
+  embedding_stores_[name] = emb_store;
+}
+
+std::shared_ptr<EmbeddingStore<int32_t, float>> EmbeddingStoreManager::Get(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = embedding_stores_.find(name);
+  if (iter == embedding_stores_.end()) {
+    return nullptr;
+  }
+  return iter->second;
+}
+
+bool EmbeddingStoreManager::IsExists(const std::string &name) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return embedding_stores_.find(name) != embedding_stores_.end();
+}
 }  // namespace distributed
 }  // namespace mindspore
@@ -20,6 +20,7 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include "kernel/kernel.h"
 #include "distributed/embedding_cache/embedding_hash_map.h"
@@ -78,7 +79,7 @@ struct EmbeddingDeviceCache {
     device_to_host_ids = std::make_unique<int[]>(batch_ids_num);
     host_to_device_index = std::make_unique<int[]>(batch_ids_num);
     host_to_device_ids = std::make_unique<int[]>(batch_ids_num);
-    device_hash_map_ = std::make_shared<EmbeddingHashMap>(0, cache_vocab_size);
+    device_hash_map_ = std::make_shared<EmbeddingHashMap<int>>(0, cache_vocab_size);
   }
 
   std::unique_ptr<int[]> device_to_host_index;
@@ -87,7 +88,7 @@ struct EmbeddingDeviceCache {
   std::unique_ptr<int[]> host_to_device_ids;
   int *hash_swap_index_addr_;
   float *hash_swap_value_addr_;
-  std::shared_ptr<EmbeddingHashMap> device_hash_map_;
+  std::shared_ptr<EmbeddingHashMap<int>> device_hash_map_;
 };
 
 // Record the hash mapping relationship of all embedding tables with cache enabled on the local host side, and the
@@ -103,7 +104,7 @@ struct EmbeddingHostCache {
     new_id_index = std::make_unique<int[]>(batch_ids_num);
     host_to_device_index = std::make_unique<int[]>(batch_ids_num);
     device_to_host_index = std::make_unique<int[]>(batch_ids_num);
-    host_hash_map_ = std::make_shared<EmbeddingHashMap>(0, host_cache_vocab_size);
+    host_hash_map_ = std::make_shared<EmbeddingHashMap<int>>(0, host_cache_vocab_size);
   }
 
   std::unique_ptr<int[]> host_to_server_index;
@@ -113,7 +114,7 @@ struct EmbeddingHostCache {
   std::unique_ptr<int[]> new_id_index;
   std::unique_ptr<int[]> host_to_device_index;
   std::unique_ptr<int[]> device_to_host_index;
-  std::shared_ptr<EmbeddingHashMap> host_hash_map_;
+  std::shared_ptr<EmbeddingHashMap<int>> host_hash_map_;
 };
 
 struct EmbeddingCacheStatisticsInfo {
@@ -269,15 +270,20 @@ class BACKEND_EXPORT EmbeddingStoreManager {
     static EmbeddingStoreManager instance{};
     return instance;
   }
-  void Add(const std::string &name, std::shared_ptr<EmbeddingStore<int32_t, float>> emb_store) {}
-  std::shared_ptr<EmbeddingStore<int32_t, float>> Get(const std::string &name) { return nullptr; }
+  void Add(const std::string &name, std::shared_ptr<EmbeddingStore<int32_t, float>> emb_store);
+  std::shared_ptr<EmbeddingStore<int32_t, float>> Get(const std::string &name);
 
-  bool IsExists(const std::string &name) const { return false; }
+  bool IsExists(const std::string &name) const;
 
  private:
   EmbeddingStoreManager() = default;
   ~EmbeddingStoreManager() = default;
   DISABLE_COPY_AND_ASSIGN(EmbeddingStoreManager);
+
+  // The embedding stores by name, the name is the parameter key of embedding table.
+  mindspore::HashMap<std::string, std::shared_ptr<EmbeddingStore<int32_t, float>>> embedding_stores_;
+  // Embedding stores are added in graph compiling and accessed by the prefetch actor and python tensors.
+  mutable std::mutex mutex_;
 };
 }  // namespace distributed
 static distributed::EmbeddingCacheTableManager &embedding_cache_table_manager =
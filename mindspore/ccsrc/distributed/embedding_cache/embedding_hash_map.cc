@@ -15,12 +15,117 @@
  */
 
 #include "distributed/embedding_cache/embedding_hash_map.h"
+#include <algorithm>
 
 namespace mindspore {
 namespace distributed {
-int EmbeddingHashMap::ParseData(const int id, int *const swap_out_index, int *const swap_out_ids,
-                                const size_t data_step, const size_t graph_running_step, size_t *const swap_out_size,
-                                bool *const need_wait_graph) {
+namespace {
+// The batch of ids whose slots are prefetched before probing.
+constexpr size_t kPrefetchBatchSize = 16;
+// Keep the load factor of IdIndexMap no more than 0.5, so the probe sequences are short.
+constexpr size_t kIdIndexMapLoadFactorInverse = 2;
+constexpr size_t kMinIdIndexMapSlotNum = 8;
+constexpr size_t kBitsOfUint64 = 64;
+}  // namespace
+
+template <typename IdType>
+IdIndexMap<IdType>::IdIndexMap(size_t max_size) {
+  slot_num_ = kMinIdIndexMapSlotNum;
+  size_t slot_bits = 3;
+  while (slot_num_ < max_size * kIdIndexMapLoadFactorInverse) {
+    slot_num_ <<= 1;
+    ++slot_bits;
+  }
+  slot_mask_ = slot_num_ - 1;
+  hash_shift_ = kBitsOfUint64 - slot_bits;
+  ids_ = std::make_unique<IdType[]>(slot_num_);
+  indices_ = std::make_unique<int[]>(slot_num_);
+  std::fill(indices_.get(), indices_.get() + slot_num_, INVALID_INDEX_VALUE);
+}
+
+template <typename IdType>
+int IdIndexMap<IdType>::Find(IdType id) const {
+  for (size_t slot = HomeSlot(id);; slot = (slot + 1) & slot_mask_) {
+    int index = indices_[slot];
+    if (index == INVALID_INDEX_VALUE || ids_[slot] == id) {
+      return index;
+    }
+  }
+}
+
+template <typename IdType>
+void IdIndexMap<IdType>::FindBatch(const IdType *ids, size_t ids_num, int *indices) const {
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(indices);
+  size_t home_slots[kPrefetchBatchSize];
+  for (size_t begin = 0; begin < ids_num; begin += kPrefetchBatchSize) {
+    size_t end = std::min(begin + kPrefetchBatchSize, ids_num);
+    // Issue the memory accesses of the whole batch first, the probing below then mostly hits the cache.
+    for (size_t i = begin; i < end; ++i) {
+      size_t slot = HomeSlot(ids[i]);
+      home_slots[i - begin] = slot;
+#if defined(__GNUC__) || defined(__clang__)
+      __builtin_prefetch(&ids_[slot]);
+      __builtin_prefetch(&indices_[slot]);
+#endif
+    }
+    for (size_t i = begin; i < end; ++i) {
+      const IdType id = ids[i];
+      for (size_t slot = home_slots[i - begin];; slot = (slot + 1) & slot_mask_) {
+        int index = indices_[slot];
+        if (index == INVALID_INDEX_VALUE || ids_[slot] == id) {
+          indices[i] = index;
+          break;
+        }
+      }
+    }
+  }
+}
+
+template <typename IdType>
+void IdIndexMap<IdType>::Insert(IdType id, int index) {
+  size_t slot = HomeSlot(id);
+  while (indices_[slot] != INVALID_INDEX_VALUE) {
+    slot = (slot + 1) & slot_mask_;
+  }
+  ids_[slot] = id;
+  indices_[slot] = index;
+  ++size_;
+}
+
+template <typename IdType>
+void IdIndexMap<IdType>::Erase(IdType id) {
+  size_t hole = HomeSlot(id);
+  while (indices_[hole] != INVALID_INDEX_VALUE && ids_[hole] != id) {
+    hole = (hole + 1) & slot_mask_;
+  }
+  if (indices_[hole] == INVALID_INDEX_VALUE) {
+    return;
+  }
+  // Shift the following ids of the probe sequence backward instead of leaving a tombstone, an id can fill the hole
+  // only if its home slot is not between the hole and its current slot.
+  for (size_t slot = (hole + 1) & slot_mask_; indices_[slot] != INVALID_INDEX_VALUE; slot = (slot + 1) & slot_mask_) {
+    size_t home = HomeSlot(ids_[slot]);
+    if (((slot - home) & slot_mask_) >= ((slot - hole) & slot_mask_)) {
+      ids_[hole] = ids_[slot];
+      indices_[hole] = indices_[slot];
+      hole = slot;
+    }
+  }
+  indices_[hole] = INVALID_INDEX_VALUE;
+  --size_;
+}
+
+template <typename IdType>
+void IdIndexMap<IdType>::Clear() {
+  std::fill(indices_.get(), indices_.get() + slot_num_, INVALID_INDEX_VALUE);
+  size_ = 0;
+}
+
+template <typename IdType>
+int EmbeddingHashMap<IdType>::ParseData(const IdType id, int *const swap_out_index, IdType *const swap_out_ids,
+                                        const size_t data_step, const size_t graph_running_step,
+                                        size_t *const swap_out_size, bool *const need_wait_graph) {
   MS_EXCEPTION_IF_NULL(swap_out_index);
   MS_EXCEPTION_IF_NULL(swap_out_ids);
   MS_EXCEPTION_IF_NULL(swap_out_size);
@@ -32,7 +137,7 @@ int EmbeddingHashMap::ParseData(const int id, int *const swap_out_index, int *co
 
   if (!need_swap) {
     hash_count_++;
-    (void)hash_id_to_index_.emplace(id, hash_index);
+    hash_id_to_index_.Insert(id, hash_index);
     hash_map_elements_[hash_index].set_id(id);
     hash_map_elements_[hash_index].set_step(data_step);
     return hash_index;
@@ -41,15 +146,55 @@ int EmbeddingHashMap::ParseData(const int id, int *const swap_out_index, int *co
   swap_out_index[*swap_out_size] = hash_index;
   swap_out_ids[*swap_out_size] = hash_map_elements_[hash_index].id_;
   (*swap_out_size)++;
-  (void)hash_id_to_index_.erase(hash_map_elements_[hash_index].id_);
-  (void)hash_id_to_index_.emplace(id, hash_index);
+  hash_id_to_index_.Erase(hash_map_elements_[hash_index].id_);
+  hash_id_to_index_.Insert(id, hash_index);
   hash_map_elements_[hash_index].set_id(id);
   hash_map_elements_[hash_index].set_step(data_step);
   return hash_index;
 }
 
-int EmbeddingHashMap::FindInsertionPos(const size_t, const size_t graph_running_step, bool *const need_swap,
-                                       bool *const need_wait_graph) {
+template <typename IdType>
+size_t EmbeddingHashMap<IdType>::ParseBatch(const IdType *ids, size_t ids_num, const size_t data_step,
+                                            const size_t graph_running_step, int *const indices,
+                                            const HashMapSwapInfo<IdType> &swap_info, bool *const need_wait_graph) {
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(indices);
+  MS_EXCEPTION_IF_NULL(swap_info.swap_in_index);
+  MS_EXCEPTION_IF_NULL(swap_info.swap_in_ids);
+  MS_EXCEPTION_IF_NULL(swap_info.swap_in_size);
+  // Refresh the step of the ids hit first, so that they are not swapped out by the ids inserted below.
+  hash_id_to_index_.FindBatch(ids, ids_num, indices);
+  for (size_t i = 0; i < ids_num; ++i) {
+    if (indices[i] != INVALID_INDEX_VALUE) {
+      hash_map_elements_[IntToSize(indices[i])].set_step(data_step);
+    }
+  }
+
+  for (size_t i = 0; i < ids_num; ++i) {
+    if (indices[i] != INVALID_INDEX_VALUE) {
+      continue;
+    }
+    // The id may have been inserted for a duplicate id in front of it.
+    indices[i] = hash_id_to_index_.Find(ids[i]);
+    if (indices[i] != INVALID_INDEX_VALUE) {
+      continue;
+    }
+    auto index = ParseData(ids[i], swap_info.swap_out_index, swap_info.swap_out_ids, data_step, graph_running_step,
+                           swap_info.swap_out_size, need_wait_graph);
+    if (index == INVALID_INDEX_VALUE) {
+      return i;
+    }
+    indices[i] = index;
+    swap_info.swap_in_index[*swap_info.swap_in_size] = index;
+    swap_info.swap_in_ids[*swap_info.swap_in_size] = ids[i];
+    (*swap_info.swap_in_size)++;
+  }
+  return ids_num;
+}
+
+template <typename IdType>
+int EmbeddingHashMap<IdType>::FindInsertionPos(const size_t, const size_t graph_running_step, bool *const need_swap,
+                                               bool *const need_wait_graph) {
   MS_EXCEPTION_IF_NULL(need_swap);
   MS_EXCEPTION_IF_NULL(need_wait_graph);
   int hash_index = INVALID_INDEX_VALUE;
@@ -81,11 +226,12 @@ int EmbeddingHashMap::FindInsertionPos(const size_t, const size_t graph_running_
   return INVALID_INDEX_VALUE;
 }
 
-void EmbeddingHashMap::DumpHashMap() {
+template <typename IdType>
+void EmbeddingHashMap<IdType>::DumpHashMap() {
   MS_LOG(INFO) << "Dump hash map info begin, hash_capacity: " << hash_capacity_ << " hash_count: " << hash_count_;
   MS_LOG(INFO) << "Dump hash_id_to_index: ";
-  for (auto iter = hash_id_to_index_.begin(); iter != hash_id_to_index_.end(); ++iter) {
-    MS_LOG(INFO) << "  id: " << iter->first << " index: " << iter->second;
+  for (const auto &item : hash_id_to_index_) {
+    MS_LOG(INFO) << "  id: " << item.first << " index: " << item.second;
   }
   MS_LOG(INFO) << "Dump hash_map_unit: ";
   for (size_t i = 0; i < hash_map_elements_.size(); i++) {
@@ -97,11 +243,17 @@ void EmbeddingHashMap::DumpHashMap() {
   MS_LOG(INFO) << "Dump hash map info end.";
 }
 
-void EmbeddingHashMap::Reset() {
+template <typename IdType>
+void EmbeddingHashMap<IdType>::Reset() {
   current_batch_start_pos_ = current_pos_;
   graph_running_index_num_ = 0;
   graph_running_index_pos_ = 0;
   expired_element_full_ = false;
 }
+
+template class IdIndexMap<int32_t>;
+template class IdIndexMap<int64_t>;
+template class EmbeddingHashMap<int32_t>;
+template class EmbeddingHashMap<int64_t>;
 }  // namespace distributed
 }  // namespace mindspore
@@ -18,10 +18,11 @@
 #define MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_EMBEDDING_HASH_MAP_H_
 
 #include <cmath>
+#include <cstdint>
 #include <utility>
 #include <memory>
 #include <vector>
-#include "utils/hash_map.h"
+#include "utils/log_adapter.h"
 #include "utils/convert_utils_base.h"
 
 namespace mindspore {
@@ -31,25 +32,101 @@ static constexpr size_t INVALID_STEP_VALUE = 0;
 // Define the value of an invalid index.
 static constexpr int INVALID_INDEX_VALUE = -1;
 
+template <typename IdType>
 struct HashMapElement {
-  int id_{INVALID_INDEX_VALUE};
+  IdType id_{INVALID_INDEX_VALUE};
   // The current global step of cache prefetching operation.
   size_t step_{INVALID_STEP_VALUE};
 
   bool IsEmpty() const { return step_ == INVALID_STEP_VALUE; }
   bool IsExpired(size_t graph_running_step) const { return graph_running_step > step_; }
   bool StepEqual(size_t step) const { return step_ == step; }
-  void set_id(int id) { id_ = id; }
+  void set_id(IdType id) { id_ = id; }
   void set_step(size_t step) { step_ = step; }
 };
 
+// IdIndexMap is an open-addressing hash table for the id -> index mapping with linear probing. The ids and indices are
+// kept in two flat arrays instead of nodes, so that the probing of an id only touches one or two cache lines and a
+// batch of ids can be looked up with their slots prefetched in advance. The number of ids never exceeds the capacity
+// of EmbeddingHashMap, so the table is allocated once and never rehashed.
+template <typename IdType>
+class IdIndexMap {
+ public:
+  class ConstIterator {
+   public:
+    ConstIterator(const IdIndexMap *map, size_t slot) : map_(map), slot_(slot) { SkipEmptySlots(); }
+    std::pair<IdType, int> operator*() const { return {map_->ids_[slot_], map_->indices_[slot_]}; }
+    ConstIterator &operator++() {
+      ++slot_;
+      SkipEmptySlots();
+      return *this;
+    }
+    bool operator!=(const ConstIterator &other) const { return slot_ != other.slot_; }
+
+   private:
+    void SkipEmptySlots() {
+      while (slot_ < map_->slot_num_ && map_->indices_[slot_] == INVALID_INDEX_VALUE) {
+        ++slot_;
+      }
+    }
+    const IdIndexMap *map_;
+    size_t slot_;
+  };
+
+  explicit IdIndexMap(size_t max_size);
+  ~IdIndexMap() = default;
+
+  // Return the index of the id, or INVALID_INDEX_VALUE if the id does not exist.
+  int Find(IdType id) const;
+  // Look up a batch of ids, the index of an id which does not exist is INVALID_INDEX_VALUE.
+  void FindBatch(const IdType *ids, size_t ids_num, int *indices) const;
+  // Insert an id which does not exist.
+  void Insert(IdType id, int index);
+  // Erase an id if it exists.
+  void Erase(IdType id);
+  void Clear();
+
+  size_t size() const { return size_; }
+  ConstIterator begin() const { return ConstIterator(this, 0); }
+  ConstIterator end() const { return ConstIterator(this, slot_num_); }
+
+ private:
+  size_t HomeSlot(IdType id) const {
+    // Fibonacci hashing spreads the consecutive feature ids over the whole table.
+    constexpr uint64_t kGoldenRatio = 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>((static_cast<uint64_t>(id) * kGoldenRatio) >> hash_shift_);
+  }
+
+  size_t slot_num_;
+  size_t slot_mask_;
+  size_t hash_shift_;
+  size_t size_{0};
+  std::unique_ptr<IdType[]> ids_;
+  // INVALID_INDEX_VALUE marks an empty slot.
+  std::unique_ptr<int[]> indices_;
+};
+
+// The ids to swap in or out of an EmbeddingHashMap, the ids and their indices are appended to the arrays and the sizes
+// are increased accordingly.
+template <typename IdType>
+struct HashMapSwapInfo {
+  int *swap_in_index{nullptr};
+  IdType *swap_in_ids{nullptr};
+  size_t *swap_in_size{nullptr};
+  int *swap_out_index{nullptr};
+  IdType *swap_out_ids{nullptr};
+  size_t *swap_out_size{nullptr};
+};
+
 // EmbeddingHashMap is used to manage the id -> index mapping of the embedding cache table on the host
-// side. The cache content can be stored on the device or host side.
+// side. The cache content can be stored on the device or host side. The feature id could be int32 or int64.
+template <typename IdType>
 class EmbeddingHashMap {
  public:
   EmbeddingHashMap(size_t hash_count, size_t hash_capacity)
       : hash_count_(hash_count),
         hash_capacity_(hash_capacity),
+        hash_id_to_index_(hash_capacity),
         current_pos_(0),
         current_batch_start_pos_(0),
         graph_running_index_num_(0),
@@ -68,9 +145,16 @@ class EmbeddingHashMap {
 
   // Find the insertion position (index) in the hash map for an id.
   // If the hash map capacity is insufficient, return the information of ids and indices that need to be swapped.
-  int ParseData(const int id, int *const swap_out_index, int *const swap_out_ids, const size_t data_step,
+  int ParseData(const IdType id, int *const swap_out_index, IdType *const swap_out_ids, const size_t data_step,
                 const size_t graph_running_step, size_t *const swap_out_size, bool *const need_wait_graph);
 
+  // Find the indices of a batch of ids and insert the ids which do not exist, duplicate ids are inserted only once.
+  // The ids inserted are appended to the swap in arrays of 'swap_info', and the ids evicted for them are appended to
+  // the swap out arrays. Return the number of ids parsed, which is less than 'ids_num' if the hash map is full of the
+  // ids used by the running graph, then the caller should wait for the graph and parse the remaining ids again.
+  size_t ParseBatch(const IdType *ids, size_t ids_num, const size_t data_step, const size_t graph_running_step,
+                    int *const indices, const HashMapSwapInfo<IdType> &swap_info, bool *const need_wait_graph);
+
   // Get the global step of a element in hash map.
   size_t hash_step(const int hash_index) const { return hash_map_elements_[IntToSize(hash_index)].step_; }
   // Set the global step of a element in hash map.
@@ -79,7 +163,7 @@ class EmbeddingHashMap {
   }
 
   // Get the id -> index mapping.
-  const mindspore::HashMap<int, int> &hash_id_to_index() const { return hash_id_to_index_; }
+  const IdIndexMap<IdType> &hash_id_to_index() const { return hash_id_to_index_; }
 
   // Get capacity of hash map.
   size_t hash_capacity() const { return hash_capacity_; }
@@ -101,10 +185,10 @@ class EmbeddingHashMap {
   size_t hash_capacity_;
 
   // Record all elements in this hash map.
-  std::vector<HashMapElement> hash_map_elements_;
+  std::vector<HashMapElement<IdType>> hash_map_elements_;
 
   // The id -> index mapping.
-  mindspore::HashMap<int, int> hash_id_to_index_;
+  IdIndexMap<IdType> hash_id_to_index_;
 
   // The cursor that records the current slot.
   size_t current_pos_;
@@ -17,28 +17,471 @@
 #ifndef MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_EMBEDDING_STORE_H_
 #define MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_EMBEDDING_STORE_H_
 
+#include <algorithm>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
+#include "utils/hash_map.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+#include "utils/os.h"
+#include "distributed/persistent/storage/log_structured_file.h"
 #include "include/backend/visible.h"
 
 namespace mindspore {
 namespace distributed {
+// The environment variable which specifies the folder of the embedding store files.
+constexpr char kEnvEmbeddingStorePath[] = "MS_EMBEDDING_STORE_PATH";
+constexpr char kDefaultEmbeddingStorePath[] = "./embedding_store";
+// The environment variable which makes the workers spill the embeddings evicted from their host cache to local
+// embedding stores, instead of pushing them to the remote servers. Only "1" enables it.
+constexpr char kEnvEmbeddingStoreSpill[] = "MS_EMBEDDING_STORE_SPILL";
+// Compact the disk tier once the garbage takes up this ratio of a sealed segment.
+constexpr float kEmbeddingStoreCompactRatio = 0.5;
+
+// EmbeddingStore saves embedding tables which may be larger than the host memory. It is made of two tiers:
+// 1. An in-memory hot tier holding at most 'capacity' rows, which are replaced with the clock algorithm.
+// 2. A log structured cold tier on disk (storage::LogStructuredFile), dirty rows evicted from the hot tier are appended
+//    to it, and the space of overwritten rows is reclaimed by compaction.
+// Each key of type K corresponds to a row of 'emb_dim' elements of type V.
 template <typename K, typename V>
 class EmbeddingStore {
  public:
-  EmbeddingStore(std::string, size_t, size_t) {}
-  ~EmbeddingStore() = default;
+  EmbeddingStore(std::string name, size_t capacity, size_t emb_dim)
+      : name_(std::move(name)), capacity_(capacity), emb_dim_(emb_dim), value_size_(emb_dim * sizeof(V)) {}
+  ~EmbeddingStore() { (void)Finalize(); }
+
+  bool Initialize();
+  bool Finalize();
+
+  // Get the rows of 'key_num' keys into 'values'. The rows of keys that have never been put are left untouched, so the
+  // caller can fill them with initial values in advance. The parameter 'input' is reserved for the caller context.
+  bool Get(const void *input, size_t key_num, const void *keys, void *values) { return Get(key_num, keys, values); }
+  bool Get(size_t key_num, const void *keys, void *values);
+
+  // Put the rows of 'key_num' keys, rows evicted from the hot tier are spilled to the cold tier in one batch.
+  bool Put(void *input, size_t key_num, const void *keys, const void *values) { return Put(key_num, keys, values); }
+  bool Put(size_t key_num, const void *keys, const void *values);
+
+  // Write all dirty rows of the hot tier to the cold tier asynchronously. The flush is waited by the next operation
+  // which depends on the cold tier.
+  bool Flush(void *input) { return Flush(); }
+  bool Flush();
+
+  // Reclaim the disk space of rows which have been overwritten.
+  bool Compact();
 
-  bool Initialize() { return true; }
-  bool Finalize() { return true; }
+  // The number of keys saved in the store.
+  size_t size() const;
 
-  bool Get(const void *input, size_t key_num, const void *keys, void *values) { return true; }
+ private:
+  // Flags of a slot in the hot tier.
+  static constexpr uint8_t kSlotValid = 0x1;
+  static constexpr uint8_t kSlotDirty = 0x2;
+  static constexpr uint8_t kSlotReferenced = 0x4;
 
-  bool Get(size_t key_num, const void *keys, void *values) { return true; }
+  V *SlotValue(size_t slot) const { return cache_values_.get() + slot * emb_dim_; }
 
-  bool Put(void *input, size_t key_num, const void *keys, const void *values) { return true; }
+  // Find a free slot for a new row, evict a row with the clock algorithm if the hot tier is full. The dirty row evicted
+  // is copied into the spill buffer.
+  size_t AllocateSlot();
+  // Append the rows in the spill buffer to the cold tier.
+  bool Spill();
+  // Update the cold tier index with new locations and discard the old ones.
+  void UpdateStorageIndex(const std::vector<K> &keys, const std::vector<storage::RecordLocation> &locations);
+  // Wait for the flush in progress to finish.
+  bool WaitFlush();
+  // Compact the cold tier if there is enough garbage.
+  bool MaybeCompact();
+  bool CompactUnlocked();
 
-  bool Flush(void *input) { return true; }
+  std::string name_;
+  size_t capacity_;
+  size_t emb_dim_;
+  size_t value_size_;
+
+  // The hot tier.
+  std::unique_ptr<V[]> cache_values_;
+  std::vector<K> slot_keys_;
+  std::vector<uint8_t> slot_flags_;
+  mindspore::HashMap<K, size_t> cache_index_;
+  size_t used_slots_{0};
+  size_t clock_hand_{0};
+
+  // Dirty rows evicted from the hot tier but not written to the cold tier yet.
+  std::vector<K> spill_keys_;
+  std::vector<V> spill_values_;
+
+  // The cold tier.
+  std::unique_ptr<storage::LogStructuredFile> storage_;
+  mindspore::HashMap<K, storage::RecordLocation> storage_index_;
+
+  // The flush in progress, the snapshot of dirty rows is kept until the flush is waited.
+  std::future<bool> flush_future_;
+  std::vector<K> flush_keys_;
+  std::vector<V> flush_values_;
+  std::vector<storage::RecordLocation> flush_locations_;
+
+  bool initialized_{false};
+  mutable std::mutex mutex_;
 };
+
+template <typename K, typename V>
+bool EmbeddingStore<K, V>::Initialize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (initialized_) {
+    return true;
+  }
+  if (capacity_ == 0 || emb_dim_ == 0) {
+    MS_LOG(ERROR) << "Invalid embedding store " << name_ << ", capacity: " << capacity_ << ", emb_dim: " << emb_dim_;
+    return false;
+  }
+
+  cache_values_ = std::make_unique<V[]>(capacity_ * emb_dim_);
+  slot_keys_.resize(capacity_);
+  slot_flags_.resize(capacity_, 0);
+  cache_index_.reserve(capacity_);
+
+  std::string base_path = common::GetEnv(kEnvEmbeddingStorePath);
+  if (base_path.empty()) {
+    base_path = kDefaultEmbeddingStorePath;
+  }
+  // Different processes on the same host may have embedding stores with the same name.
+  std::string file_path = base_path + "/" + name_ + "_" + std::to_string(getpid());
+  std::map<std::string, std::string> storage_config = {{storage::kFileStoragePath, file_path}};
+  storage_ = std::make_unique<storage::LogStructuredFile>(storage_config);
+  if (!storage_->Initialize()) {
+    MS_LOG(ERROR) << "Initialize the disk storage of embedding store " << name_ << " failed, path: " << file_path;
+    return false;
+  }
+  initialized_ = true;
+  MS_LOG(INFO) << "Initialize embedding store " << name_ << ", capacity: " << capacity_ << ", emb_dim: " << emb_dim_
+               << ", disk storage path: " << file_path;
+  return true;
+}
+
+template <typename K, typename V>
+bool EmbeddingStore<K, V>::Finalize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!initialized_) {
+    return true;
+  }
+  (void)WaitFlush();
+  bool ret = storage_->Finalize();
+  storage_ = nullptr;
+  storage_index_.clear();
+  cache_index_.clear();
+  cache_values_ = nullptr;
+  slot_keys_.clear();
+  slot_flags_.clear();
+  used_slots_ = 0;
+  clock_hand_ = 0;
+  initialized_ = false;
+  return ret;
+}
+
+template <typename K, typename V>
+size_t EmbeddingStore<K, V>::AllocateSlot() {
+  if (used_slots_ < capacity_) {
+    return used_slots_++;
+  }
+  // The hot tier is full, find a row which has not been referenced since the clock hand passed it last time.
+  while ((slot_flags_[clock_hand_] & kSlotReferenced) != 0) {
+    slot_flags_[clock_hand_] &= static_cast<uint8_t>(~kSlotReferenced);
+    clock_hand_ = (clock_hand_ + 1) % capacity_;
+  }
+  size_t slot = clock_hand_;
+  clock_hand_ = (clock_hand_ + 1) % capacity_;
+
+  const K &key = slot_keys_[slot];
+  if ((slot_flags_[slot] & kSlotDirty) != 0) {
+    spill_keys_.push_back(key);
+    const V *value = SlotValue(slot);
+    spill_values_.insert(spill_values_.end(), value, value + emb_dim_);
+  }
+  (void)cache_index_.erase(key);
+  slot_flags_[slot] = 0;
+  return slot;
+}
+
+template <typename K, typename V>
+bool EmbeddingStore<K, V>::Spill() {
+  if (spill_keys_.empty()) {
+    return true;
+  }
+  // A clean row evicted during the flush may only have its latest copy in the flush snapshot, so the cold tier index
+  // must be up to date before the spilled rows are looked up again.
+  RETURN_IF_FALSE_WITH_LOG(WaitFlush(), "Wait for the flush of embedding store failed.");
+
+  std::vector<storage::RecordInput> inputs;
+  inputs.reserve(spill_keys_.size());
+  for (size_t i = 0; i < spill_keys_.size(); ++i) {
+    (void)inputs.emplace_back(spill_values_.data() + i * emb_dim_, value_size_);
+  }
+  std::vector<storage::RecordLocation> locations;
+  RETURN_IF_FALSE_WITH_LOG(storage_->Append(inputs, &locations), "Spill embeddings to disk failed.");
+  UpdateStorageIndex(spill_keys_, locations);
+  spill_keys_.clear();
+  spill_values_.clear();
+  return MaybeCompact();
+}
+
+template <typename K, typename V>
+void EmbeddingStore<K, V>::UpdateStorageIndex(const std::vector<K> &keys,
+                                              const std::vector<storage::RecordLocation> &locations) {
+  for (size_t i = 0; i < keys.size(); ++i) {
+    auto iter = storage_index_.find(keys[i]);
+    if (iter != storage_index_.end()) {
+      storage_->Discard(iter->second, value_size_);
+      iter->second = locations[i];
+    } else {
+      (void)storage_index_.emplace(keys[i], locations[i]);
+    }
+  }
+}
+
+template <typename K, typename V>
+bool EmbeddingStore<K, V>::Get(size_t key_num, const void *keys, void *values) {
+  MS_ERROR_IF_NULL(keys);
+  MS_ERROR_IF_NULL(values);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!initialized_) {
+    MS_LOG(ERROR) << "The embedding store " << name_ << " is not initialized.";
+    return false;
+  }
+  auto keys_addr = reinterpret_cast<const K *>(keys);
+  auto values_addr = reinterpret_cast<V *>(values);
+
+  // 1. Copy the rows hit in the hot tier and collect the positions of rows to load from the cold tier.
+  std::vector<size_t> miss_positions;
+  for (size_t i = 0; i < key_num; ++i) {
+    auto iter = cache_index_.find(keys_addr[i]);
+    if (iter != cache_index_.end()) {
+      size_t slot = iter->second;
+      slot_flags_[slot] |= kSlotReferenced;
+      auto ret = memcpy_s(values_addr + i * emb_dim_, value_size_, SlotValue(slot), value_size_);
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "Memcpy failed, errno[" << ret << "]";
+        return false;
+      }
+    } else if (storage_index_.count(keys_addr[i]) != 0 || flush_future_.valid()) {
+      miss_positions.push_back(i);
+    }
+  }
+  if (miss_positions.empty()) {
+    return true;
+  }
+  RETURN_IF_FALSE_WITH_LOG(WaitFlush(), "Wait for the flush of embedding store failed.");
+
+  // 2. Read the missing rows from the cold tier into the output directly, the rows of duplicate keys are read only
+  // once and copied afterwards.
+  mindspore::HashMap<K, size_t> first_positions;
+  std::vector<std::pair<size_t, size_t>> duplicates;
+  std::vector<storage::RecordOutput> outputs;
+  for (size_t pos : miss_positions) {
+    const K &key = keys_addr[pos];
+    auto storage_iter = storage_index_.find(key);
+    if (storage_iter == storage_index_.end()) {
+      continue;
+    }
+    auto first_iter = first_positions.find(key);
+    if (first_iter != first_positions.end()) {
+      (void)duplicates.emplace_back(pos, first_iter->second);
+      continue;
+    }
+    (void)first_positions.emplace(key, pos);
+    (void)outputs.emplace_back(storage_iter->second, values_addr + pos * emb_dim_, value_size_);
+  }
+  RETURN_IF_FALSE_WITH_LOG(storage_->Read(outputs), "Load embeddings from disk failed.");
+  for (const auto &item : duplicates) {
+    auto ret = memcpy_s(values_addr + item.first * emb_dim_, value_size_, values_addr + item.second * emb_dim_,
+                        value_size_);
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "Memcpy failed, errno[" << ret << "]";
+      return false;
+    }
+  }
+
+  // 3. Install the loaded rows into the hot tier. A row installed may be evicted again by a later one of the same
+  // batch, which is harmless since the loaded rows are clean and have been copied out.
+  for (const auto &item : first_positions) {
+    size_t slot = AllocateSlot();
+    slot_keys_[slot] = item.first;
+    slot_flags_[slot] = kSlotValid | kSlotReferenced;
+    cache_index_[item.first] = slot;
+    auto ret = memcpy_s(SlotValue(slot), value_size_, values_addr + item.second * emb_dim_, value_size_);
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "Memcpy failed, errno[" << ret << "]";
+      return false;
+    }
+  }
+  return Spill();
+}
+
+template <typename K, typename V>
+bool EmbeddingStore<K, V>::Put(size_t key_num, const void *keys, const void *values) {
+  MS_ERROR_IF_NULL(keys);
+  MS_ERROR_IF_NULL(values);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!initialized_) {
+    MS_LOG(ERROR) << "The embedding store " << name_ << " is not initialized.";
+    return false;
+  }
+  auto keys_addr = reinterpret_cast<const K *>(keys);
+  auto values_addr = reinterpret_cast<const V *>(values);
+  for (size_t i = 0; i < key_num; ++i) {
+    const K &key = keys_addr[i];
+    size_t slot;
+    auto iter = cache_index_.find(key);
+    if (iter != cache_index_.end()) {
+      slot = iter->second;
+    } else {
+      slot = AllocateSlot();
+      slot_keys_[slot] = key;
+      cache_index_[key] = slot;
+    }
+    slot_flags_[slot] = kSlotValid | kSlotDirty | kSlotReferenced;
+    auto ret = memcpy_s(SlotValue(slot), value_size_, values_addr + i * emb_dim_, value_size_);
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "Memcpy failed, errno[" << ret << "]";
+      return false;
+    }
+  }
+  return Spill();
+}
+
+template <typename K, typename V>
+bool EmbeddingStore<K, V>::Flush() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!initialized_) {
+    MS_LOG(ERROR) << "The embedding store " << name_ << " is not initialized.";
+    return false;
+  }
+  RETURN_IF_FALSE_WITH_LOG(WaitFlush(), "Wait for the previous flush of embedding store failed.");
+
+  for (size_t slot = 0; slot < used_slots_; ++slot) {
+    if ((slot_flags_[slot] & kSlotDirty) == 0) {
+      continue;
+    }
+    flush_keys_.push_back(slot_keys_[slot]);
+    const V *value = SlotValue(slot);
+    flush_values_.insert(flush_values_.end(), value, value + emb_dim_);
+    slot_flags_[slot] &= static_cast<uint8_t>(~kSlotDirty);
+  }
+  if (flush_keys_.empty()) {
+    return true;
+  }
+
+  // The snapshot is only touched by the flush task until it is waited, and the storage serializes disk access itself.
+  flush_future_ = std::async(std::launch::async, [this]() {
+    std::vector<storage::RecordInput> inputs;
+    inputs.reserve(flush_keys_.size());
+    for (size_t i = 0; i < flush_keys_.size(); ++i) {
+      (void)inputs.emplace_back(flush_values_.data() + i * emb_dim_, value_size_);
+    }
+    return storage_->Append(inputs, &flush_locations_);
+  });
+  return true;
+}
+
+template <typename K, typename V>
+bool EmbeddingStore<K, V>::WaitFlush() {
+  if (!flush_future_.valid()) {
+    return true;
+  }
+  bool ret = flush_future_.get();
+  if (ret) {
+    UpdateStorageIndex(flush_keys_, flush_locations_);
+  } else {
+    MS_LOG(ERROR) << "Flush embedding store " << name_ << " failed.";
+    // Mark the rows still in the hot tier dirty again, so that they are written by the next flush or eviction.
+    for (const auto &key : flush_keys_) {
+      auto iter = cache_index_.find(key);
+      if (iter != cache_index_.end()) {
+        slot_flags_[iter->second] |= kSlotDirty;
+      }
+    }
+  }
+  flush_keys_.clear();
+  flush_values_.clear();
+  flush_locations_.clear();
+  return ret;
+}
+
+template <typename K, typename V>
+bool EmbeddingStore<K, V>::Compact() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!initialized_) {
+    MS_LOG(ERROR) << "The embedding store " << name_ << " is not initialized.";
+    return false;
+  }
+  RETURN_IF_FALSE_WITH_LOG(WaitFlush(), "Wait for the flush of embedding store failed.");
+  return CompactUnlocked();
+}
+
+template <typename K, typename V>
+bool EmbeddingStore<K, V>::MaybeCompact() {
+  // Avoid scanning the index for little garbage.
+  if (static_cast<float>(storage_->garbage_size()) < kEmbeddingStoreCompactRatio * storage_->total_size()) {
+    return true;
+  }
+  return CompactUnlocked();
+}
+
+template <typename K, typename V>
+bool EmbeddingStore<K, V>::CompactUnlocked() {
+  auto segment_ids = storage_->GetGarbageSegments(kEmbeddingStoreCompactRatio);
+  if (segment_ids.empty()) {
+    return true;
+  }
+  std::set<size_t> victims(segment_ids.begin(), segment_ids.end());
+
+  // Move the live rows of victim segments to the active segment.
+  std::vector<K> live_keys;
+  for (const auto &item : storage_index_) {
+    if (victims.count(item.second.segment_id) != 0) {
+      live_keys.push_back(item.first);
+    }
+  }
+  std::vector<V> live_values(live_keys.size() * emb_dim_);
+  std::vector<storage::RecordOutput> outputs;
+  std::vector<storage::RecordInput> inputs;
+  outputs.reserve(live_keys.size());
+  inputs.reserve(live_keys.size());
+  for (size_t i = 0; i < live_keys.size(); ++i) {
+    (void)outputs.emplace_back(storage_index_[live_keys[i]], live_values.data() + i * emb_dim_, value_size_);
+    (void)inputs.emplace_back(live_values.data() + i * emb_dim_, value_size_);
+  }
+  RETURN_IF_FALSE_WITH_LOG(storage_->Read(outputs), "Read embeddings to compact failed.");
+  std::vector<storage::RecordLocation> locations;
+  RETURN_IF_FALSE_WITH_LOG(storage_->Append(inputs, &locations), "Write compacted embeddings failed.");
+  for (size_t i = 0; i < live_keys.size(); ++i) {
+    storage_index_[live_keys[i]] = locations[i];
+  }
+  for (auto segment_id : segment_ids) {
+    RETURN_IF_FALSE_WITH_LOG(storage_->RemoveSegment(segment_id), "Remove compacted segment failed.");
+  }
+  MS_LOG(DEBUG) << "Compact embedding store " << name_ << ", remove " << segment_ids.size() << " segments, move "
+                << live_keys.size() << " rows.";
+  return true;
+}
+
+template <typename K, typename V>
+size_t EmbeddingStore<K, V>::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t count = storage_index_.size();
+  for (size_t slot = 0; slot < used_slots_; ++slot) {
+    if ((slot_flags_[slot] & kSlotValid) != 0 && storage_index_.count(slot_keys_[slot]) == 0) {
+      ++count;
+    }
+  }
+  return count;
+}
 }  // namespace distributed
 }  // namespace mindspore
 #endif  // MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_EMBEDDING_STORE_H_
@@ -0,0 +1,213 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed/persistent/storage/log_structured_file.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "utils/convert_utils_base.h"
+#include "utils/log_adapter.h"
+#include "distributed/persistent/storage/file_io_utils.h"
+
+namespace mindspore {
+namespace distributed {
+namespace storage {
+LogStructuredFile::LogStructuredFile(const std::map<std::string, std::string> &storage_config) {
+  auto file_path_iter = storage_config.find(kFileStoragePath);
+  if (file_path_iter != storage_config.end()) {
+    file_path_ = file_path_iter->second;
+  }
+
+  auto block_length_iter = storage_config.find(kMaxBlockLength);
+  if (block_length_iter != storage_config.end() && !(block_length_iter->second).empty()) {
+    max_segment_length_ = std::stoul(block_length_iter->second);
+  } else {
+    max_segment_length_ = DEFAULT_MAX_SEGMENT_LENGTH;
+  }
+}
+
+LogStructuredFile::~LogStructuredFile() { (void)Finalize(); }
+
+bool LogStructuredFile::Initialize() {
+  if (file_path_.empty()) {
+    MS_LOG(ERROR) << "The file storage path is empty.";
+    return false;
+  }
+  FileIOUtils::CreateDirRecursive(file_path_);
+  std::lock_guard<std::mutex> lock(mutex_);
+  return OpenSegment();
+}
+
+bool LogStructuredFile::Finalize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  bool ret = true;
+  for (auto &item : segments_) {
+    auto &segment = item.second;
+    segment->fs.close();
+    if (std::remove(segment->file_name.c_str()) != 0) {
+      MS_LOG(WARNING) << "Remove segment file failed, file name: " << segment->file_name;
+      ret = false;
+    }
+  }
+  segments_.clear();
+  total_size_ = 0;
+  garbage_size_ = 0;
+  return ret;
+}
+
+bool LogStructuredFile::OpenSegment() {
+  auto segment = std::make_unique<Segment>();
+  segment->file_name = file_path_ + "/" + kBlockFilePrefix + std::to_string(next_segment_id_);
+  segment->fs.open(segment->file_name, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!segment->fs.is_open() || !segment->fs.good()) {
+    MS_LOG(ERROR) << "Open segment file failed, file name: " << segment->file_name;
+    return false;
+  }
+  active_segment_id_ = next_segment_id_++;
+  segments_[active_segment_id_] = std::move(segment);
+  return true;
+}
+
+bool LogStructuredFile::Append(const std::vector<RecordInput> &inputs, std::vector<RecordLocation> *locations) {
+  MS_ERROR_IF_NULL(locations);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (segments_.empty()) {
+    MS_LOG(ERROR) << "The log structured file in " << file_path_ << " is not initialized.";
+    return false;
+  }
+  locations->clear();
+  locations->reserve(inputs.size());
+  for (const auto &input : inputs) {
+    MS_ERROR_IF_NULL(input.first);
+    if (segments_[active_segment_id_]->size + input.second > max_segment_length_ &&
+        segments_[active_segment_id_]->size > 0) {
+      (void)segments_[active_segment_id_]->fs.flush();
+      RETURN_IF_FALSE_WITH_LOG(OpenSegment(), "Open a new segment failed.");
+    }
+    auto &segment = segments_[active_segment_id_];
+    (void)segment->fs.seekp(SizeToLong(segment->size));
+    (void)segment->fs.write(reinterpret_cast<const char *>(input.first), SizeToLong(input.second));
+    if (!segment->fs.good()) {
+      MS_LOG(ERROR) << "Write segment file failed, file name: " << segment->file_name;
+      return false;
+    }
+    (void)locations->emplace_back(RecordLocation{active_segment_id_, segment->size});
+    segment->size += input.second;
+    total_size_ += input.second;
+  }
+  return true;
+}
+
+bool LogStructuredFile::Read(const std::vector<RecordOutput> &outputs) {
+  std::vector<const RecordOutput *> sorted_outputs;
+  sorted_outputs.reserve(outputs.size());
+  for (const auto &output : outputs) {
+    sorted_outputs.push_back(&output);
+  }
+  std::sort(sorted_outputs.begin(), sorted_outputs.end(), [](const RecordOutput *lhs, const RecordOutput *rhs) {
+    const auto &lhs_location = std::get<0>(*lhs);
+    const auto &rhs_location = std::get<0>(*rhs);
+    return lhs_location.segment_id < rhs_location.segment_id ||
+           (lhs_location.segment_id == rhs_location.segment_id && lhs_location.offset < rhs_location.offset);
+  });
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // The write position of the active segment may not be flushed yet.
+  if (!segments_.empty()) {
+    (void)segments_[active_segment_id_]->fs.flush();
+  }
+  for (const auto *output : sorted_outputs) {
+    const auto &location = std::get<0>(*output);
+    void *data = std::get<1>(*output);
+    size_t size = std::get<2>(*output);
+    MS_ERROR_IF_NULL(data);
+    auto iter = segments_.find(location.segment_id);
+    if (iter == segments_.end() || location.offset + size > iter->second->size) {
+      MS_LOG(ERROR) << "Invalid record location, segment id: " << location.segment_id
+                    << ", offset: " << location.offset << ", size: " << size;
+      return false;
+    }
+    auto &segment = iter->second;
+    (void)segment->fs.seekg(SizeToLong(location.offset));
+    (void)segment->fs.read(reinterpret_cast<char *>(data), SizeToLong(size));
+    if (!segment->fs.good()) {
+      MS_LOG(ERROR) << "Read segment file failed, file name: " << segment->file_name;
+      return false;
+    }
+  }
+  return true;
+}
+
+void LogStructuredFile::Discard(const RecordLocation &location, size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = segments_.find(location.segment_id);
+  if (iter == segments_.end()) {
+    return;
+  }
+  iter->second->garbage_size += size;
+  garbage_size_ += size;
+}
+
+std::vector<size_t> LogStructuredFile::GetGarbageSegments(float garbage_ratio) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<size_t> segment_ids;
+  for (const auto &item : segments_) {
+    const auto &segment = item.second;
+    if (item.first == active_segment_id_ || segment->size == 0) {
+      continue;
+    }
+    if (static_cast<float>(segment->garbage_size) >= garbage_ratio * static_cast<float>(segment->size)) {
+      segment_ids.push_back(item.first);
+    }
+  }
+  return segment_ids;
+}
+
+bool LogStructuredFile::RemoveSegment(size_t segment_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (segment_id == active_segment_id_) {
+    MS_LOG(ERROR) << "Can not remove the active segment " << segment_id;
+    return false;
+  }
+  auto iter = segments_.find(segment_id);
+  if (iter == segments_.end()) {
+    return true;
+  }
+  auto &segment = iter->second;
+  segment->fs.close();
+  if (std::remove(segment->file_name.c_str()) != 0) {
+    MS_LOG(ERROR) << "Remove segment file failed, file name: " << segment->file_name;
+    return false;
+  }
+  total_size_ -= segment->size;
+  garbage_size_ -= segment->garbage_size;
+  (void)segments_.erase(iter);
+  return true;
+}
+
+size_t LogStructuredFile::total_size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return total_size_;
+}
+
+size_t LogStructuredFile::garbage_size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return garbage_size_;
+}
+}  // namespace storage
+}  // namespace distributed
+}  // namespace mindspore
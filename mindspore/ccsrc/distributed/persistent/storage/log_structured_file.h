@@ -0,0 +1,116 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_LOG_STRUCTURED_FILE_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_LOG_STRUCTURED_FILE_H_
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "distributed/persistent/storage/constants.h"
+
+namespace mindspore {
+namespace distributed {
+namespace storage {
+// The default maximum segment length : 64MB.
+constexpr size_t DEFAULT_MAX_SEGMENT_LENGTH = 64 << 20;
+
+// The location of a record in the LogStructuredFile.
+struct RecordLocation {
+  size_t segment_id{0};
+  size_t offset{0};
+};
+
+// Record to append: buffer pointer and size.
+using RecordInput = std::pair<const void *, size_t>;
+// Record to read: location, buffer pointer and size.
+using RecordOutput = std::tuple<RecordLocation, void *, size_t>;
+
+// Append-only file storage which is composed of many segment files in the folder 'file_path_'.
+// Unlike LocalFile, records are never rewritten in place: updating a record appends a new copy and the old copy becomes
+// garbage. The space of garbage is reclaimed by moving the live records of a segment elsewhere and removing the
+// segment, which is driven by the owner of the records because only the owner knows which records are live.
+class LogStructuredFile {
+ public:
+  // The storage config supports kFileStoragePath and kMaxBlockLength(the maximum length of a segment file).
+  explicit LogStructuredFile(const std::map<std::string, std::string> &storage_config);
+  ~LogStructuredFile();
+
+  // Create the folder and the first segment file.
+  bool Initialize();
+
+  // Close and remove all segment files.
+  bool Finalize();
+
+  // Append records to the active segment, and return their locations. A new segment is opened when the active one
+  // exceeds the maximum length.
+  bool Append(const std::vector<RecordInput> &inputs, std::vector<RecordLocation> *locations);
+
+  // Read records, the reading is done in order of location so that the disk access is as sequential as possible.
+  bool Read(const std::vector<RecordOutput> &outputs);
+
+  // Mark a record of 'size' bytes at 'location' as garbage.
+  void Discard(const RecordLocation &location, size_t size);
+
+  // Get the sealed segments in which garbage size accounts for at least 'garbage_ratio' of the segment size.
+  std::vector<size_t> GetGarbageSegments(float garbage_ratio) const;
+
+  // Remove a segment whose live records have been moved to other segments.
+  bool RemoveSegment(size_t segment_id);
+
+  // Total size of all segments and garbage in them.
+  size_t total_size() const;
+  size_t garbage_size() const;
+
+ private:
+  struct Segment {
+    std::string file_name;
+    std::fstream fs;
+    size_t size{0};
+    size_t garbage_size{0};
+  };
+
+  // Open a new segment file and make it the active segment.
+  bool OpenSegment();
+
+  // Folder path to save all segment files.
+  std::string file_path_;
+
+  // Maximum size of each segment file.
+  size_t max_segment_length_;
+
+  // All segments by segment id, the active segment is the last one.
+  std::map<size_t, std::unique_ptr<Segment>> segments_;
+  size_t active_segment_id_{0};
+  size_t next_segment_id_{0};
+
+  size_t total_size_{0};
+  size_t garbage_size_{0};
+
+  // Appending and reading may come from different threads, for example an asynchronous flush.
+  mutable std::mutex mutex_;
+};
+}  // namespace storage
+}  // namespace distributed
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_LOG_STRUCTURED_FILE_H_
@@ -81,6 +81,12 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("get_debug_mode", &ConfigManager::get_debug_mode)
                     .def("set_error_samples_mode", &ConfigManager::set_error_samples_mode)
                     .def("get_error_samples_mode", &ConfigManager::get_error_samples_mode)
+                    .def("set_map_preserve_order", &ConfigManager::set_map_preserve_order)
+                    .def("get_map_preserve_order", &ConfigManager::map_preserve_order)
+                    .def("set_mindrecord_io_depth", &ConfigManager::set_mindrecord_io_depth)
+                    .def("get_mindrecord_io_depth", &ConfigManager::mindrecord_io_depth)
+                    .def("set_jpeg_scaled_decode", &ConfigManager::set_jpeg_scaled_decode)
+                    .def("get_jpeg_scaled_decode", &ConfigManager::jpeg_scaled_decode)
                     .def("load", [](ConfigManager &c, const std::string &s) { THROW_IF_ERROR(c.LoadFile(s)); });
                 }));
 
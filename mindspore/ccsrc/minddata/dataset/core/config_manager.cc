@@ -91,6 +91,9 @@ Status ConfigManager::FromJson(const nlohmann::json &j) {
   set_monitor_sampling_interval(j.value("monitorSamplingInterval", monitor_sampling_interval_));
   set_fast_recovery(j.value("fast_recovery", fast_recovery_));
   set_error_samples_mode(j.value("error_samples_mode", error_samples_mode_));
+  set_map_preserve_order(j.value("map_preserve_order", map_preserve_order_));
+  set_mindrecord_io_depth(j.value("mindrecord_io_depth", mindrecord_io_depth_));
+  set_jpeg_scaled_decode(j.value("jpeg_scaled_decode", jpeg_scaled_decode_));
   set_cache_host(j.value("cacheHost", cache_host_));
   set_cache_port(j.value("cachePort", cache_port_));
   set_num_connections(j.value("numConnections", num_connections_));
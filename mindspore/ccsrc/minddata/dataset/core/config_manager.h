@@ -319,6 +319,39 @@ class ConfigManager {
   // @notes This method is used for internal processing, using enum type
   ErrorSamplesMode error_samples_mode() const { return error_samples_mode_; }
 
+  // setter function
+  // @param preserve_order - Set whether the Map operation keeps the order of rows from its input
+  //     (System default = true)
+  // @notes When the order is not kept, each row goes to the least loaded worker and the results are passed on
+  //     as soon as any worker finishes, so a slow row no longer stalls the others.
+  void set_map_preserve_order(const bool preserve_order) { map_preserve_order_ = preserve_order; }
+
+  // getter function
+  // @return - Flag to indicate whether the Map operation keeps the order of rows
+  bool map_preserve_order() const { return map_preserve_order_; }
+
+  // setter function
+  // @param io_depth - Set the number of reads in flight when MindRecord files are read asynchronously
+  //     (System default = 0)
+  // @notes 0 reads every blob synchronously through a file stream of the worker. A positive depth reads the blobs
+  //     through a pool of I/O threads which merges adjacent reads and prefetches the blobs of the upcoming samples.
+  void set_mindrecord_io_depth(const int32_t io_depth) { mindrecord_io_depth_ = io_depth; }
+
+  // getter function
+  // @return - The number of reads in flight when MindRecord files are read asynchronously
+  int32_t mindrecord_io_depth() const { return mindrecord_io_depth_; }
+
+  // setter function
+  // @param scaled_decode - Set whether RandomCropDecodeResize decodes JPEG images at a reduced DCT scale
+  //     (System default = false)
+  // @notes The scaled decode filters the image in the DCT domain, so the output differs slightly from a full decode
+  //     followed by a resize.
+  void set_jpeg_scaled_decode(const bool scaled_decode) { jpeg_scaled_decode_ = scaled_decode; }
+
+  // getter function
+  // @return - Flag to indicate whether RandomCropDecodeResize decodes JPEG images at a reduced DCT scale
+  bool jpeg_scaled_decode() const { return jpeg_scaled_decode_; }
+
  private:
   // Private helper function that takes a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
@@ -356,6 +389,9 @@ class ConfigManager {
   bool fast_recovery_{true};     // Used for failover scenario to recover quickly or produce same augmentations
   bool debug_mode_flag_{false};  // Indicator for debug mode
   ErrorSamplesMode error_samples_mode_{ErrorSamplesMode::kReturn};  // The method to process erroneous samples
+  bool map_preserve_order_{true};  // Whether the Map operation keeps the order of rows
+  int32_t mindrecord_io_depth_{0};  // Number of reads in flight of the MindRecord read engine, 0 to disable it
+  bool jpeg_scaled_decode_{false};  // Whether RandomCropDecodeResize decodes JPEG images at a reduced DCT scale
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -171,6 +171,27 @@ Status Tensor::CreateFromMemory(const TensorShape &shape, const DataType &type,
   return Status::OK();
 }
 
+Status Tensor::CreateFromPoolMemory(const TensorShape &shape, const DataType &type,
+                                    const std::shared_ptr<MemoryPool> &pool, uchar *src, const dsize_t &length,
+                                    TensorPtr *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  RETURN_UNEXPECTED_IF_NULL(pool);
+  RETURN_UNEXPECTED_IF_NULL(src);
+  const TensorAlloc *alloc = GlobalContext::Instance()->tensor_allocator();
+  *out = std::allocate_shared<Tensor>(*alloc, shape, type);
+  CHECK_FAIL_RETURN_UNEXPECTED(*out != nullptr, "Allocate memory failed.");
+  if (type.IsNumeric()) {
+    CHECK_FAIL_RETURN_UNEXPECTED((*out)->SizeInBytes() == length, "Length of source data does not match the shape.");
+  } else {
+    dsize_t min_length = (shape.NumOfElements() + 1) * kOffsetSize + shape.NumOfElements();
+    CHECK_FAIL_RETURN_UNEXPECTED(min_length <= length, "Length of source data does not match the shape.");
+  }
+  (*out)->data_allocator_ = std::make_unique<Allocator<unsigned char>>(pool);
+  (*out)->data_ = src;
+  (*out)->data_end_ = src + length;
+  return Status::OK();
+}
+
 #ifdef ENABLE_PYTHON
 Status Tensor::CreateFromNpString(py::array arr, std::shared_ptr<Tensor> *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
@@ -332,6 +353,74 @@ Status Tensor::CreateFromByteList(const dataengine::BytesList &bytes_list, const
 
   return Status::OK();
 }
+
+Status Tensor::CreateFromByteList(const std::vector<std::string_view> &bytes_list, const TensorShape &shape,
+                                  TensorPtr *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  const TensorAlloc *alloc = GlobalContext::Instance()->tensor_allocator();
+  *out = std::allocate_shared<Tensor>(*alloc, TensorShape({static_cast<dsize_t>(bytes_list.size())}),
+                                      DataType(DataType::DE_STRING));
+  CHECK_FAIL_RETURN_UNEXPECTED(out != nullptr, "Allocate memory failed.");
+  // total bytes needed = offset array + strings
+  // offset array needs to store one offset var per element + 1 extra to get the length of the last string.
+  // strings will be null-terminated --> need 1 extra byte per element
+  dsize_t num_bytes = (kOffsetSize + 1) * (*out)->shape_.NumOfElements() + kOffsetSize;
+  for (const auto &str : bytes_list) {
+    num_bytes += static_cast<dsize_t>(str.size());
+  }
+  RETURN_IF_NOT_OK((*out)->AllocateBuffer(num_bytes));
+  auto offset_arr = reinterpret_cast<offset_t *>((*out)->data_);
+  uchar *buf = (*out)->GetStringsBuffer();
+
+  offset_t offset = buf - (*out)->data_;  // the first string will start here
+  size_t i = 0;
+  for (; i < bytes_list.size(); i++) {
+    const std::string_view &str = bytes_list[i];
+    //  insert the start index of the string.
+    offset_arr[i] = offset;
+    // insert actual string, the views are not null-terminated
+    if (!str.empty()) {
+      int ret_code = memcpy_s((*out)->data_ + offset, num_bytes - offset, str.data(), str.size());
+      CHECK_FAIL_RETURN_UNEXPECTED(ret_code == EOK, "Cannot copy string into Tensor");
+    }
+    (*out)->data_[offset + str.size()] = '\0';
+    //  next string will be stored right after the current one.
+    offset = offset + str.size() + 1;
+  }
+  // store one more offset value so we can get the length of the last string
+  offset_arr[i] = offset;
+
+  (*out)->data_end_ = (*out)->data_ + offset_arr[i];
+  RETURN_IF_NOT_OK((*out)->Reshape(shape));
+  return Status::OK();
+}
+
+Status Tensor::CreateFromByteList(const std::vector<std::string_view> &bytes_list, const TensorShape &shape,
+                                  const DataType &type, dsize_t pad_size, TensorPtr *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, type, out));
+
+  unsigned char *current_tensor_addr = (*out)->GetMutableBuffer();
+  int64_t tensor_bytes_remaining = static_cast<int64_t>(bytes_list.size()) * pad_size;
+  for (const auto &current_element : bytes_list) {
+    // read string data into tensor
+    if (!current_element.empty()) {
+      int return_code =
+        memcpy_s(current_tensor_addr, tensor_bytes_remaining, current_element.data(), current_element.size());
+      CHECK_FAIL_RETURN_UNEXPECTED(return_code == EOK, "memcpy_s failed when reading bytesList element into Tensor");
+    }
+    current_tensor_addr += current_element.size();
+    tensor_bytes_remaining -= static_cast<int64_t>(current_element.size());
+
+    // pad
+    int64_t chars_to_pad = pad_size - static_cast<int64_t>(current_element.size());
+    int return_code = memset_s(current_tensor_addr, tensor_bytes_remaining, static_cast<int>(' '), chars_to_pad);
+    CHECK_FAIL_RETURN_UNEXPECTED(return_code == EOK, "memcpy_s failed when padding Tensor");
+    current_tensor_addr += chars_to_pad;
+    tensor_bytes_remaining -= chars_to_pad;
+  }
+  return Status::OK();
+}
 #endif
 
 // Memcpy the given strided array's used part to consecutive memory
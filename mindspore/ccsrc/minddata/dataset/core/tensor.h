@@ -20,6 +20,7 @@
 #include <deque>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #if defined(_WIN32) || defined(_WIN64)
 #undef HAVE_STDDEF_H
@@ -52,6 +53,7 @@ namespace py = pybind11;
 namespace mindspore {
 namespace dataset {
 class Tensor;
+class MemoryPool;
 template <typename T>
 class Allocator;
 
@@ -107,6 +109,19 @@ class DATASET_API Tensor {
   static Status CreateFromMemory(const TensorShape &shape, const DataType &type, const uchar *src,
                                  const dsize_t &length, TensorPtr *out);
 
+  /// Create a tensor on a block of memory owned by a memory pool. No data is copied, the tensor keeps the pool alive
+  /// and hands the block back to it with Deallocate when the tensor is destroyed.
+  /// \param[in] shape shape of the output tensor
+  /// \param[in] type type of the output tensor
+  /// \param[in] pool the memory pool owning the block
+  /// \param[in] src pointer to the block
+  /// \param[in] length length of the block
+  /// \param[out] out Generated tensor
+  /// \return Status code
+  static Status CreateFromPoolMemory(const TensorShape &shape, const DataType &type,
+                                     const std::shared_ptr<MemoryPool> &pool, uchar *src, const dsize_t &length,
+                                     TensorPtr *out);
+
   /// Create a copy of the input tensor
   /// \param[in] in original tensor to be copied
   /// \param[out] out output tensor to be generated
@@ -146,6 +161,25 @@ class DATASET_API Tensor {
   /// \return Status Code
   static Status CreateFromByteList(const dataengine::BytesList &bytes_list, const TensorShape &shape,
                                    const DataType &type, dsize_t pad_size, TensorPtr *out);
+
+  /// Create a tensor of type DE_STRING from the values of a BytesList, viewed in the serialized record.
+  /// \param[in] bytes_list values of the BytesList
+  /// \param[in] shape shape of the output tensor
+  /// \param[out] out created Tensor
+  /// \return Status Code
+  static Status CreateFromByteList(const std::vector<std::string_view> &bytes_list, const TensorShape &shape,
+                                   TensorPtr *out);
+
+  /// Create a tensor of type UINT8 or INT8 from the values of a BytesList, viewed in the serialized record.
+  /// The tensor will be padded with ' ' to reach the required pad_size.
+  /// \param[in] bytes_list values of the BytesList
+  /// \param[in] shape shape of the output tensor
+  /// \param[in] type type of created tensor. Should be DE_UINT8 or INT8
+  /// \param[in] pad_size The size of the tensor after padding
+  /// \param[out] out created Tensor
+  /// \return Status Code
+  static Status CreateFromByteList(const std::vector<std::string_view> &bytes_list, const TensorShape &shape,
+                                   const DataType &type, dsize_t pad_size, TensorPtr *out);
 #endif
 
   /// Create a Tensor from a given list of values.
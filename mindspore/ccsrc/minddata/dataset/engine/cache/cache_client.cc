@@ -132,18 +132,46 @@ Status CacheClient::GetRows(const std::vector<row_id_type> &row_id, TensorTable
   auto rq = std::make_shared<BatchFetchRequest>(this, row_id);
   RETURN_IF_NOT_OK(PushRequest(rq));
   RETURN_IF_NOT_OK(rq->Wait());
-  int64_t mem_addr;
-  Status rc = rq->RestoreRows(out, comm_->SharedMemoryBaseAddr(), &mem_addr);
-  // Free the memory by sending a request back to the server.
+  int64_t mem_addr = rq->GetSharedMemoryAddr();
+  std::shared_ptr<MemoryPool> shared_block;
   if (mem_addr != -1) {
-    auto mfree_req = std::make_shared<FreeSharedBlockRequest>(server_connection_id_, client_id_, mem_addr);
-    Status rc2 = PushRequest(mfree_req);
-    // But we won't wait for the result for the sake of performance.
-    if (rc.IsOk() && rc2.IsError()) {
-      rc = rc2;
+    // The memory is freed by sending a request back to the server when the last tensor using it goes away.
+    // The lease keeps the comm layer, and so the shared memory, attached until then.
+    auto comm = comm_;
+    auto connection_id = server_connection_id_;
+    auto client_id = client_id_;
+    shared_block = std::make_shared<SharedBlockLease>([comm, connection_id, client_id, mem_addr]() -> Status {
+      // The comm layer can't take any request once it is stopped. The block is then left to the server.
+      if (comm->ServiceState() != Service::STATE::kRunning) {
+        MS_LOG(WARNING) << "Shared memory block at " << mem_addr << " outlives the cache client and is not freed.";
+        return Status::OK();
+      }
+      auto mfree_req = std::make_shared<FreeSharedBlockRequest>(connection_id, client_id, mem_addr);
+      // We won't wait for the result for the sake of performance.
+      return comm->HandleRequest(mfree_req);
+    });
+  }
+  return rq->RestoreRows(out, comm_->SharedMemoryBaseAddr(), shared_block);
+}
+
+CacheClient::SharedBlockLease::~SharedBlockLease() {
+  try {
+    Status rc = release_();
+    if (rc.IsError()) {
+      MS_LOG(ERROR) << rc;
     }
+  } catch (const std::exception &e) {
+    // Can't do anything in destructor. So just log the error.
+    MS_LOG(ERROR) << e.what();
   }
-  return rc;
+}
+
+Status CacheClient::SharedBlockLease::Allocate(size_t, void **) {
+  RETURN_STATUS_UNEXPECTED("Can't allocate from a shared memory block of fetched rows.");
+}
+
+Status CacheClient::SharedBlockLease::Reallocate(void **, size_t, size_t) {
+  RETURN_STATUS_UNEXPECTED("Can't reallocate from a shared memory block of fetched rows.");
 }
 
 Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
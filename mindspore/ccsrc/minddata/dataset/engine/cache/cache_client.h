@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_CLIENT_H_
 
 #include <atomic>
+#include <functional>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -36,6 +37,7 @@
 #endif
 
 #include "minddata/dataset/util/lock.h"
+#include "minddata/dataset/util/memory_pool.h"
 #include "minddata/dataset/util/cond_var.h"
 #include "minddata/dataset/util/queue_map.h"
 #include "minddata/dataset/util/task_manager.h"
@@ -269,6 +271,28 @@ class CacheClient {
     return Status::OK();
   }
 
+  /// \brief A block of shared memory holding the rows of a batch fetch. The tensors restored from the block use it in
+  /// place instead of copying it out, and the block is returned to the server once the last of them is gone.
+  class SharedBlockLease : public MemoryPool {
+   public:
+    /// \param release Function returning the block to the server, called once by the destructor
+    explicit SharedBlockLease(std::function<Status()> release) : release_(std::move(release)) {}
+    ~SharedBlockLease() override;
+
+    /// The block is handed out as a whole. Nothing can be allocated from it.
+    Status Allocate(size_t, void **) override;
+    Status Reallocate(void **, size_t, size_t) override;
+
+    /// A tensor using the block is gone. The block itself is freed by the destructor.
+    void Deallocate(void *) override {}
+
+    uint64_t get_max_size() const override { return 0; }
+    int PercentFree() const override { return 0; }
+
+   private:
+    std::function<Status()> release_;
+  };
+
  private:
   mutable RWLock mux_;
   uint64_t cache_mem_sz_;
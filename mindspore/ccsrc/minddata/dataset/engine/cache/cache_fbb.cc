@@ -103,7 +103,8 @@ Status SerializeTensorRowHeader(const TensorRow &row, std::shared_ptr<flatbuffer
   }
 }
 
-Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, std::shared_ptr<Tensor> *out) {
+Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, const std::shared_ptr<MemoryPool> &pool,
+                        std::shared_ptr<Tensor> *out) {
   RETURN_UNEXPECTED_IF_NULL(col_ts);
   auto shape_in = col_ts->dims();
   auto type_in = col_ts->type();
@@ -137,8 +138,15 @@ Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data,
 
   DataType type(dest);
   std::shared_ptr<Tensor> ts;
-  RETURN_IF_NOT_OK(
-    Tensor::CreateFromMemory(shape, type, static_cast<const unsigned char *>(data.GetPointer()), data.GetSize(), &ts));
+  auto *src = static_cast<const unsigned char *>(data.GetPointer());
+  // Elements of a string tensor start with their offsets.
+  auto alignment = static_cast<uintptr_t>(type.IsString() ? sizeof(offset_t) : type.SizeInBytes());
+  if (pool != nullptr && data.GetSize() > 0 && alignment > 0 && reinterpret_cast<uintptr_t>(src) % alignment == 0) {
+    RETURN_IF_NOT_OK(
+      Tensor::CreateFromPoolMemory(shape, type, pool, const_cast<unsigned char *>(src), data.GetSize(), &ts));
+  } else {
+    RETURN_IF_NOT_OK(Tensor::CreateFromMemory(shape, type, src, data.GetSize(), &ts));
+  }
   // Next we restore the real data which can be embedded or stored separately.
   if (ts->SizeInBytes() != data.GetSize()) {
     MS_LOG(ERROR) << "Unexpected length. Read " << data.GetSize() << ". Expected " << ts->SizeInBytes() << ".\n"
@@ -24,6 +24,7 @@
 #include <vector>
 #include "minddata/dataset/engine/cache/de_tensor_generated.h"
 #include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/util/memory_pool.h"
 #include "minddata/dataset/util/slice.h"
 #include "minddata/dataset/util/status.h"
 
@@ -38,9 +39,12 @@ Status SerializeTensorRowHeader(const TensorRow &row, std::shared_ptr<flatbuffer
 /// \brief A function used by BatchFetchRequest to deserialize a flat buffer back to a tensor row.
 /// \param col_ts A serialized version of Tensor meta data
 /// \param data Tensor data wrapped in a slice
+/// \param pool Optional owner of the memory of data. If given, the tensor uses the data in place whenever it is
+///     suitably aligned instead of copying it.
 /// \param out Tensor
 /// \return Status object
-Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, std::shared_ptr<Tensor> *out);
+Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, const std::shared_ptr<MemoryPool> &pool,
+                        std::shared_ptr<Tensor> *out);
 }  // namespace dataset
 }  // namespace mindspore
 #endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_FBB_H_
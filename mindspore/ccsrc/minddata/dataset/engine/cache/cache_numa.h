@@ -66,6 +66,9 @@ class NumaMemoryPool : public MemoryPool {
   /// \brief Return the configured or computed memory cap ratio
   float GetMemoryCapRatio() const { return memory_cap_ratio_; }
 
+  /// \brief Return the numa node the current thread is running on
+  numa_id_t GetMyNode() const { return hw_->GetMyNode(); }
+
  private:
   std::shared_ptr<CacheServerHW> hw_;
   float memory_cap_ratio_;
@@ -16,13 +16,23 @@
 #include <algorithm>
 #include "utils/ms_utils.h"
 #include "minddata/dataset/engine/cache/cache_pool.h"
-#include "minddata/dataset/engine/cache/cache_server.h"
 #include "minddata/dataset/util/services.h"
 
 namespace mindspore {
 namespace dataset {
-CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root)
-    : mp_(std::move(mp)), root_(root), subfolder_(Services::GetUniqueID()), sm_(nullptr), tree_(nullptr) {
+CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root, uint64_t hot_limit)
+    : mp_(std::move(mp)),
+      root_(root),
+      subfolder_(Services::GetUniqueID()),
+      log_(nullptr),
+      tree_(nullptr),
+      clock_hand_(0),
+      hot_bytes_(0),
+      hot_limit_(hot_limit),
+      stop_tier_worker_(false),
+      num_reads_(0),
+      num_promoted_(0),
+      num_demoted_(0) {
   // Initialize soft memory cap to the current available memory on the machine.
   soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
   temp_mem_usage_ = 0;
@@ -31,13 +41,14 @@ CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root
 
 Status CachePool::DoServiceStart() {
   tree_ = std::make_shared<data_index>();
-  // If we are given a disk path, set up the StorageManager
+  // If we are given a disk path, set up the segment log as the cold tier
   if (!root_.ToString().empty()) {
     Path spill = GetSpillPath();
     RETURN_IF_NOT_OK(spill.CreateDirectories());
-    auto &cs = CacheServer::GetInstance();
-    sm_ = std::make_shared<StorageManager>(spill, cs.GetNumWorkers());
-    RETURN_IF_NOT_OK(sm_->ServiceStart());
+    log_ = std::make_unique<CacheSegmentLog>(spill);
+    RETURN_IF_NOT_OK(log_->Open());
+    stop_tier_worker_ = false;
+    tier_worker_ = std::thread(&CachePool::TierWorker, this);
     MS_LOG(INFO) << "CachePool will use disk folder: " << spill.ToString();
   }
   return Status::OK();
@@ -46,13 +57,25 @@ Status CachePool::DoServiceStart() {
 Status CachePool::DoServiceStop() {
   Status rc;
   Status rc2;
-  if (sm_ != nullptr) {
-    rc = sm_->ServiceStop();
+  {
+    std::lock_guard<std::mutex> lck(queue_mutex_);
+    stop_tier_worker_ = true;
+    promote_queue_.clear();
+  }
+  queue_cv_.notify_all();
+  if (tier_worker_.joinable()) {
+    tier_worker_.join();
+  }
+  if (log_ != nullptr) {
+    MS_LOG(INFO) << "CachePool promoted " << num_promoted_ << " rows and demoted " << num_demoted_ << " rows. "
+                 << log_->BytesAppended() << " bytes written to the segment log.";
+    rc = log_->Close();
     if (rc.IsError()) {
       rc2 = rc;
     }
   }
-  sm_.reset();
+  log_.reset();
+  clock_.clear();
 
   // We used to free the memory allocated from each DataLocator but
   // since all of them are coming from NumaMemoryPool and we will
@@ -95,6 +118,8 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     MS_LOG(WARNING) << "Memory usage will exceed the upper bound limit of: " << min_avail_mem_
                     << ". The cache server will not cache any more data.";
     rc = STATUS_ERROR(StatusCode::kMDOutOfMemory, "Out of memory.");
+  } else if (TieringEnabled() && HotTierFull(sz)) {
+    rc = STATUS_ERROR(StatusCode::kMDOutOfMemory, "Memory tier is full.");
   } else {
     rc = mp_->Allocate(sz, reinterpret_cast<void **>(&bl.ptr));
     // Adjust the soft limit and usage counting when every 100M memory are used.
@@ -107,8 +132,7 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     temp_mem_usage_ += sz;
     // Write down which numa node where we allocate from. It only make sense if the policy is kOnNode.
     if (CacheServerHW::numa_enabled()) {
-      auto &cs = CacheServer::GetInstance();
-      auto node_id = cs.GetHWControl()->GetMyNode();
+      auto node_id = mp_->GetMyNode();
       bl.node_id = mp_->FindNode(bl.ptr);
       CHECK_FAIL_RETURN_UNEXPECTED(bl.node_id != -1, "Allocator is not from numa memory pool");
       bl.node_hit = (bl.node_id == node_id);
@@ -131,9 +155,15 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     }
   } else if (rc == StatusCode::kMDOutOfMemory) {
     // If no memory, write to disk.
-    if (sm_ != nullptr) {
+    if (TieringEnabled()) {
       MS_LOG(DEBUG) << "Spill to disk directly ... " << bl.sz << " bytes.";
-      RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, buf));
+      RETURN_IF_NOT_OK(log_->Append(buf, &bl.log_entry));
+      bl.in_log = true;
+      std::lock_guard<std::mutex> lck(tier_mutex_);
+      // The memory in use when we first run out is what the hot tier can hold.
+      if (hot_limit_ == 0) {
+        hot_limit_ = hot_bytes_;
+      }
     } else {
       // If asked to spill to disk instead but there is no storage set up, simply return no memory
       // instead.
@@ -154,6 +184,18 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     bl.ptr = nullptr;
     return rc;
   }
+  if (rc.IsOk() && TieringEnabled() && bl.ptr != nullptr) {
+    DataLocator *inserted = nullptr;
+    {
+      auto r = tree_->Search(key);
+      CHECK_FAIL_RETURN_UNEXPECTED(r.second, "Key not found after insert");
+      inserted = &(*r.first);
+    }
+    std::lock_guard<std::mutex> lck(tier_mutex_);
+    clock_.push_back({key, inserted});
+    hot_bytes_ += bl.sz;
+    hot_limit_ = hot_limit_ > 0 ? std::max(hot_limit_, hot_bytes_) : 0;
+  }
   return rc;
 }
 
@@ -162,16 +204,37 @@ Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *byt
   auto r = tree_->Search(key);
   if (r.second) {
     auto &it = r.first;
-    if (it->ptr != nullptr) {
+    if (!TieringEnabled()) {
       ReadableSlice src(it->ptr, it->sz);
       RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
-    } else if (sm_ != nullptr) {
-      size_t expectedLength = 0;
-      RETURN_IF_NOT_OK(sm_->Read(it->storage_key, dest, &expectedLength));
-      if (expectedLength != it->sz) {
-        MS_LOG(ERROR) << "Unexpected length. Read " << expectedLength << ". Expected " << it->sz << "."
-                      << " Internal key: " << key << "\n";
-        RETURN_STATUS_UNEXPECTED("Length mismatch. See log file for details.");
+    } else {
+      // The tier worker may move the row between memory and disk at any time, so look at it under its lock.
+      bool on_disk = false;
+      CacheSegmentLog::Entry entry;
+      {
+        std::lock_guard<std::mutex> lck(LocatorLock(key));
+        if (it->ptr != nullptr) {
+          ReadableSlice src(it->ptr, it->sz);
+          RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
+          it->referenced = true;
+        } else {
+          on_disk = true;
+          entry = it->log_entry;
+        }
+        if (it->read_count < kMaxReadCount) {
+          ++it->read_count;
+        }
+      }
+      ++num_reads_;
+      if (on_disk) {
+        if (dest->GetSize() < it->sz) {
+          MS_LOG(ERROR) << "Unexpected length. Buffer size " << dest->GetSize() << ". Expected " << it->sz << "."
+                        << " Internal key: " << key << "\n";
+          RETURN_STATUS_UNEXPECTED("Length mismatch. See log file for details.");
+        }
+        WritableSlice out(*dest, 0, it->sz);
+        RETURN_IF_NOT_OK(log_->Read(entry, &out));
+        SchedulePromotion(key);
       }
     }
     if (bytesRead != nullptr) {
@@ -190,7 +253,7 @@ Path CachePool::GetSpillPath() const {
 
 CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
   tree_->LockShared();  // Prevent any node split while we search.
-  CacheStat cs{-1, -1, 0, 0, 0, 0};
+  CacheStat cs{-1, -1, 0, 0, 0, 0, num_promoted_, num_demoted_};
   int64_t total_sz = 0;
   if (tree_->begin() != tree_->end()) {
     cs.min_key = tree_->begin().key();
@@ -198,7 +261,14 @@ CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
     for (auto it = tree_->begin(); it != tree_->end(); ++it) {
       it.LockShared();
       total_sz += it.value().sz;
-      if (it.value().ptr != nullptr) {
+      bool in_memory = false;
+      if (TieringEnabled()) {
+        std::lock_guard<std::mutex> lck(LocatorLock(it.key()));
+        in_memory = it.value().ptr != nullptr;
+      } else {
+        in_memory = it.value().ptr != nullptr;
+      }
+      if (in_memory) {
         ++cs.num_mem_cached;
       } else {
         ++cs.num_disk_cached;
@@ -237,7 +307,9 @@ Status CachePool::GetDataLocator(key_type key, const std::shared_ptr<flatbuffers
     bld.add_key(key);
     bld.add_size(it->sz);
     bld.add_node_id(it->node_id);
-    bld.add_addr(reinterpret_cast<int64_t>(it->ptr));
+    // With tiering the row can be demoted before the client fetches it. Send no address so the fetch goes
+    // through Read.
+    bld.add_addr(TieringEnabled() ? 0 : reinterpret_cast<int64_t>(it->ptr));
     auto offset = bld.Finish();
     *out = offset;
   } else {
@@ -247,5 +319,154 @@ Status CachePool::GetDataLocator(key_type key, const std::shared_ptr<flatbuffers
   }
   return Status::OK();
 }
+
+bool CachePool::HotTierFull(size_t sz) {
+  std::lock_guard<std::mutex> lck(tier_mutex_);
+  return hot_limit_ > 0 && hot_bytes_ + sz > hot_limit_;
+}
+
+void CachePool::SchedulePromotion(key_type key) const {
+  {
+    std::lock_guard<std::mutex> lck(queue_mutex_);
+    // Promotion is best effort. Never block a reader on it.
+    if (stop_tier_worker_ || promote_queue_.size() >= kMaxPendingPromotions) {
+      return;
+    }
+    promote_queue_.push_back(key);
+  }
+  queue_cv_.notify_one();
+}
+
+void CachePool::TierWorker() {
+  while (true) {
+    key_type key;
+    {
+      std::unique_lock<std::mutex> lck(queue_mutex_);
+      queue_cv_.wait(lck, [this] { return stop_tier_worker_ || !promote_queue_.empty(); });
+      if (stop_tier_worker_) {
+        return;
+      }
+      key = promote_queue_.front();
+      promote_queue_.pop_front();
+    }
+    if (num_reads_ >= kReadCountAgingFactor * std::max<uint64_t>(tree_->size(), 1)) {
+      AgeReadCounts();
+    }
+    Status rc = Promote(key);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Fail to promote key " << key << " to memory. " << rc;
+    }
+  }
+}
+
+void CachePool::AgeReadCounts() {
+  tree_->LockShared();  // Prevent any node split while we go through the rows.
+  for (auto it = tree_->begin(); it != tree_->end(); ++it) {
+    it.LockShared();
+    {
+      std::lock_guard<std::mutex> lck(LocatorLock(it.key()));
+      it.value().read_count >>= 1;
+    }
+    it.Unlock();
+  }
+  tree_->Unlock();
+  num_reads_ = 0;
+}
+
+Status CachePool::Promote(key_type key) {
+  DataLocator *bl = nullptr;
+  {
+    auto r = tree_->Search(key);
+    RETURN_OK_IF_TRUE(!r.second);
+    bl = &(*r.first);
+  }
+  size_t sz = 0;
+  CacheSegmentLog::Entry entry;
+  uint8_t read_count = 0;
+  {
+    std::lock_guard<std::mutex> lck(LocatorLock(key));
+    RETURN_OK_IF_TRUE(bl->ptr != nullptr);
+    sz = bl->sz;
+    entry = bl->log_entry;
+    read_count = bl->read_count;
+  }
+  std::lock_guard<std::mutex> tier_lck(tier_mutex_);
+  RETURN_OK_IF_TRUE(hot_limit_ == 0 || sz > hot_limit_);
+  // Make room with a CLOCK sweep. A resident row read since the last pass gets a second chance, the first one without
+  // is the victim. The promotion is given up if the victim is read about as often as the row to promote.
+  size_t steps = 2 * clock_.size() + 1;
+  while (hot_bytes_ + sz > hot_limit_) {
+    RETURN_OK_IF_TRUE(clock_.empty() || steps-- == 0);
+    clock_hand_ %= clock_.size();
+    const ClockEntry &candidate = clock_[clock_hand_];
+    {
+      std::lock_guard<std::mutex> lck(LocatorLock(candidate.key));
+      if (candidate.bl->referenced) {
+        candidate.bl->referenced = false;
+        ++clock_hand_;
+        continue;
+      }
+      RETURN_OK_IF_TRUE(static_cast<int>(read_count) <= static_cast<int>(candidate.bl->read_count) + 1);
+    }
+    RETURN_IF_NOT_OK(Demote(clock_hand_));
+  }
+  pointer buf = nullptr;
+  Status rc = mp_->Allocate(sz, reinterpret_cast<void **>(&buf));
+  if (rc == StatusCode::kMDOutOfMemory) {
+    // The memory pool is fragmented. The row stays on disk.
+    return Status::OK();
+  }
+  RETURN_IF_NOT_OK(rc);
+  WritableSlice dest(buf, sz);
+  rc = log_->Read(entry, &dest);
+  if (rc.IsError()) {
+    mp_->Deallocate(buf);
+    return rc;
+  }
+  {
+    std::lock_guard<std::mutex> lck(LocatorLock(key));
+    bl->ptr = buf;
+    bl->referenced = true;
+    if (CacheServerHW::numa_enabled()) {
+      bl->node_id = mp_->FindNode(buf);
+    }
+  }
+  clock_.push_back({key, bl});
+  hot_bytes_ += sz;
+  ++num_promoted_;
+  return Status::OK();
+}
+
+Status CachePool::Demote(size_t pos) {
+  ClockEntry victim = clock_[pos];
+  pointer ptr = nullptr;
+  size_t sz = 0;
+  bool in_log = false;
+  {
+    std::lock_guard<std::mutex> lck(LocatorLock(victim.key));
+    ptr = victim.bl->ptr;
+    sz = victim.bl->sz;
+    in_log = victim.bl->in_log;
+  }
+  // Only this thread releases the memory of a row, so it is safe to write it back without holding its lock.
+  CacheSegmentLog::Entry entry;
+  if (!in_log) {
+    RETURN_IF_NOT_OK(log_->Append({ReadableSlice(ptr, sz)}, &entry));
+  }
+  {
+    std::lock_guard<std::mutex> lck(LocatorLock(victim.key));
+    if (!in_log) {
+      victim.bl->log_entry = entry;
+      victim.bl->in_log = true;
+    }
+    victim.bl->ptr = nullptr;
+  }
+  mp_->Deallocate(ptr);
+  clock_[pos] = clock_.back();
+  clock_.pop_back();
+  hot_bytes_ -= sz;
+  ++num_demoted_;
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
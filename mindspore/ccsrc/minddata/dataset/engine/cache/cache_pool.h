@@ -16,14 +16,18 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 
+#include <array>
+#include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include "minddata/dataset/engine/cache/cache_common.h"
 #include "minddata/dataset/engine/cache/cache_numa.h"
-#include "minddata/dataset/engine/cache/storage_manager.h"
+#include "minddata/dataset/engine/cache/cache_segment_log.h"
 #include "minddata/dataset/util/allocator.h"
 #include "minddata/dataset/util/service.h"
 #include "minddata/dataset/util/slice.h"
@@ -35,6 +39,11 @@ namespace dataset {
 /// \brief A CachePool provides service for backup/restore a buffer. A buffer can be represented in a form of vector of
 /// ReadableSlice where all memory blocks will be copied to one contiguous block which can be in memory or spilled to
 /// disk (if a disk directory is provided). User must provide a key to insert the buffer.
+/// With a disk directory, memory is the hot tier of a two-tier store. Rows not fitting in memory are appended to a
+/// segment log on disk. Rows read from disk are promoted back to memory in the background, taking the memory of the
+/// resident rows picked by a CLOCK sweep, which are written back to the log first if they are not in it yet. A row is
+/// only promoted if it is read clearly more often than the row it replaces, so a sequential or a shuffled scan of a
+/// dataset larger than memory does not churn the hot tier.
 /// \see ReadableSlice
 class CachePool : public Service {
  public:
@@ -45,10 +54,11 @@ class CachePool : public Service {
   using const_reference = const base_type &;
   using value_allocator = Allocator<base_type>;
 
-  // An internal class to locate the whereabouts of a backed up buffer which can be either in
+  // An internal class to locate the whereabouts of a backed up buffer which can be either in memory or on disk
   class DataLocator {
    public:
-    DataLocator() : ptr(nullptr), sz(0), node_id(0), node_hit(false), storage_key(0) {}
+    DataLocator()
+        : ptr(nullptr), sz(0), node_id(0), node_hit(false), in_log(false), referenced(false), read_count(0) {}
     ~DataLocator() = default;
     DataLocator(const DataLocator &other) = default;
     DataLocator &operator=(const DataLocator &other) = default;
@@ -57,10 +67,13 @@ class CachePool : public Service {
       sz = other.sz;
       node_id = other.node_id;
       node_hit = other.node_hit;
-      storage_key = other.storage_key;
+      log_entry = other.log_entry;
+      in_log = other.in_log;
+      referenced = other.referenced;
+      read_count = other.read_count;
       other.ptr = nullptr;
       other.sz = 0;
-      other.storage_key = 0;
+      other.in_log = false;
     }
     DataLocator &operator=(DataLocator &&other) noexcept {
       if (&other != this) {
@@ -68,10 +81,13 @@ class CachePool : public Service {
         sz = other.sz;
         node_id = other.node_id;
         node_hit = other.node_hit;
-        storage_key = other.storage_key;
+        log_entry = other.log_entry;
+        in_log = other.in_log;
+        referenced = other.referenced;
+        read_count = other.read_count;
         other.ptr = nullptr;
         other.sz = 0;
-        other.storage_key = 0;
+        other.in_log = false;
       }
       return *this;
     }
@@ -79,7 +95,10 @@ class CachePool : public Service {
     size_t sz;
     numa_id_t node_id;  // where the numa node the memory is allocated to
     bool node_hit;      // we can allocate to the preferred node
-    StorageManager::key_type storage_key;
+    CacheSegmentLog::Entry log_entry;
+    bool in_log;         // a copy of the buffer is in the segment log
+    bool referenced;     // read since the last CLOCK sweep
+    uint8_t read_count;  // saturating read count, halved by the CLOCK sweep
   };
 
   using data_index = BPlusTree<int64_t, DataLocator>;
@@ -95,13 +114,17 @@ class CachePool : public Service {
     int64_t num_disk_cached;
     int64_t average_cache_sz;
     int64_t num_numa_hit;
+    int64_t num_promoted;  // rows moved from disk to memory
+    int64_t num_demoted;   // rows moved from memory to disk
     std::vector<key_type> gap;
   };
 
   /// \brief Constructor
   /// \param alloc Allocator to allocate memory from
   /// \param root Optional disk folder to spill
-  explicit CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root = "");
+  /// \param hot_limit Optional number of bytes the memory tier holds when spilling to disk. 0 to use the memory in use
+  /// when the pool first runs out.
+  explicit CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root = "", uint64_t hot_limit = 0);
 
   CachePool(const CachePool &) = delete;
   CachePool(CachePool &&) = delete;
@@ -144,11 +167,62 @@ class CachePool : public Service {
   void SetLocking(bool on_off) { tree_->SetLocking(on_off); }
 
  private:
+  constexpr static size_t kNumLocatorLocks = 64;
+  constexpr static size_t kMaxPendingPromotions = 4096;
+  constexpr static uint8_t kMaxReadCount = 255;
+  constexpr static uint64_t kReadCountAgingFactor = 8;  // halve the read counts every 8 reads per row
+
+  /// \brief A row resident in memory, as seen by the CLOCK sweep
+  struct ClockEntry {
+    key_type key;
+    DataLocator *bl;
+  };
+
+  /// \brief The lock protecting where a row is. Rows are never removed from the tree, so the DataLocator of a key
+  /// stays at the same address and the lock can be picked by key.
+  std::mutex &LocatorLock(key_type key) const { return locator_locks_[static_cast<uint64_t>(key) % kNumLocatorLocks]; }
+
+  bool TieringEnabled() const { return log_ != nullptr; }
+
+  /// \brief Whether a new row of the given size would push the memory tier over its limit
+  bool HotTierFull(size_t sz);
+
+  /// \brief Queue a row read from disk for promotion. The request is dropped if the queue is full.
+  void SchedulePromotion(key_type key) const;
+
+  /// \brief Background thread promoting the queued rows
+  void TierWorker();
+
+  /// \brief Bring a row back to memory, demoting colder rows to make room
+  Status Promote(key_type key);
+
+  /// \brief Move the resident row at a position of the CLOCK to the segment log and release its memory
+  Status Demote(size_t pos);
+
+  /// \brief Halve the read counts of all the rows, so that the rows read a lot in the past lose their advantage
+  void AgeReadCounts();
+
   std::shared_ptr<NumaMemoryPool> mp_;
   Path root_;
   const std::string subfolder_;
-  std::shared_ptr<StorageManager> sm_;
+  std::unique_ptr<CacheSegmentLog> log_;
   std::shared_ptr<data_index> tree_;
+  mutable std::array<std::mutex, kNumLocatorLocks> locator_locks_;
+  // The hot tier. Guarded by tier_mutex_ and only used if tiering is enabled.
+  std::mutex tier_mutex_;
+  std::vector<ClockEntry> clock_;
+  size_t clock_hand_;
+  uint64_t hot_bytes_;  // bytes of the rows in clock_
+  uint64_t hot_limit_;  // the given limit, or hot_bytes_ when memory first ran out. 0 until then.
+  // Pending promotions, the only state shared with the readers
+  mutable std::mutex queue_mutex_;
+  mutable std::condition_variable queue_cv_;
+  mutable std::deque<key_type> promote_queue_;
+  bool stop_tier_worker_;
+  std::thread tier_worker_;
+  mutable std::atomic<uint64_t> num_reads_;
+  std::atomic<int64_t> num_promoted_;
+  std::atomic<int64_t> num_demoted_;
   std::atomic<uint64_t> soft_mem_limit_;  // the available memory in the machine
   std::atomic<uint64_t> temp_mem_usage_;  // temporary count on the amount of memory usage by cache every 100Mb (because
                                           // we will adjust soft_mem_limit_ every 100Mb based on this parameter)
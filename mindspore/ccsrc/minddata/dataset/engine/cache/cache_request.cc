@@ -153,23 +153,25 @@ BatchFetchRequest::BatchFetchRequest(const CacheClient *cc, const std::vector<ro
   rq_.add_buf_data(fbb.GetBufferPointer(), fbb.GetSize());
 }
 
-Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, int64_t *out_addr) {
-  RETURN_UNEXPECTED_IF_NULL(out);
-  auto num_elements = row_id_.size();
-  const char *ptr = nullptr;
-  int64_t sz = 0;
+int64_t BatchFetchRequest::GetSharedMemoryAddr() const {
   // Tap into the reply flag to see where we can find the data. Server may decide the amount is
   // so small that it doesn't use shared memory method.
   auto flag = reply_.flag();
   bool dataOnSharedMemory = support_local_bypass_ ? (BitTest(flag, kDataIsInSharedMemory)) : false;
-  if (dataOnSharedMemory) {
-    auto addr = strtoll(reply_.result().data(), nullptr, kDecimal);
+  return dataOnSharedMemory ? strtoll(reply_.result().data(), nullptr, kDecimal) : -1;
+}
+
+Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr,
+                                      const std::shared_ptr<MemoryPool> &shared_block) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  auto num_elements = row_id_.size();
+  const char *ptr = nullptr;
+  int64_t sz = 0;
+  auto addr = GetSharedMemoryAddr();
+  if (addr != -1) {
     ptr = reinterpret_cast<const char *>(reinterpret_cast<int64_t>(baseAddr) + addr);
-    RETURN_UNEXPECTED_IF_NULL(out);
-    *out_addr = addr;
   } else {
     ptr = reply_.result().data();
-    *out_addr = -1;
   }
   auto *offset_array = reinterpret_cast<const int64_t *>(ptr);
   sz = offset_array[num_elements];
@@ -193,7 +195,7 @@ Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, in
         auto col_ts = msg->column()->Get(k);
         std::shared_ptr<Tensor> ts;
         ReadableSlice data(row_data, ts_offset, msg->data_sz()->Get(k));
-        RETURN_IF_NOT_OK(mindspore::dataset::RestoreOneTensor(col_ts, data, &ts));
+        RETURN_IF_NOT_OK(mindspore::dataset::RestoreOneTensor(col_ts, data, addr != -1 ? shared_block : nullptr, &ts));
         row.push_back(ts);
         ts_offset += data.GetSize();
       }
@@ -30,6 +30,7 @@
 #include "proto/cache_grpc.pb.h"
 #include "minddata/dataset/core/tensor_row.h"
 #include "minddata/dataset/engine/cache/de_tensor_generated.h"
+#include "minddata/dataset/util/memory_pool.h"
 #include "minddata/dataset/util/slice.h"
 #include "minddata/dataset/util/wait_post.h"
 
@@ -233,7 +234,18 @@ class BatchFetchRequest : public BaseRequest {
   friend class CacheService;
   BatchFetchRequest(const CacheClient *cc, const std::vector<row_id_type> &row_id);
   ~BatchFetchRequest() override = default;
-  Status RestoreRows(TensorTable *out, const void *baseAddr, int64_t *out_addr);
+
+  /// \brief Offset of the fetched rows in the shared memory
+  /// \return -1 if the server sent the rows back in the reply instead
+  int64_t GetSharedMemoryAddr() const;
+
+  /// \brief Deserialize the fetched rows
+  /// \param[out] out The rows
+  /// \param[in] baseAddr Where the shared memory is attached
+  /// \param[in] shared_block Owner of the block of shared memory holding the rows, null if the rows are in the reply.
+  ///     The tensors restored from the block use it in place and keep it alive.
+  /// \return Status object
+  Status RestoreRows(TensorTable *out, const void *baseAddr, const std::shared_ptr<MemoryPool> &shared_block);
 
  private:
   bool support_local_bypass_;
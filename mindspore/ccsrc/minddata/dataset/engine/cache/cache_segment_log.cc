@@ -0,0 +1,148 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/cache/cache_segment_log.h"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include "minddata/dataset/util/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+CacheSegmentLog::CacheSegmentLog(const Path &root, uint64_t segment_size)
+    : root_(root),
+      segment_size_(segment_size),
+      fds_(kMaxNumSegments, -1),
+      num_segments_(0),
+      tail_(0),
+      bytes_appended_(0) {}
+
+CacheSegmentLog::~CacheSegmentLog() { (void)Close(); }
+
+Status CacheSegmentLog::AddSegment() {
+  auto id = num_segments_.load();
+  if (id >= kMaxNumSegments) {
+    RETURN_STATUS_ERROR(StatusCode::kMDNoSpace, "Too many segments in the spill folder " + root_.ToString());
+  }
+  std::ostringstream oss;
+  oss << "SEG" << std::setfill('0') << std::setw(5) << id << ".LOG";
+  Path segment = root_ / oss.str();
+  RETURN_IF_NOT_OK(segment.CreateFile(&fds_[id]));
+  tail_ = 0;
+  // publish the new segment to the readers only after its file is opened
+  num_segments_ = id + 1;
+  MS_LOG(INFO) << "Segment " << segment << " created";
+  return Status::OK();
+}
+
+Status CacheSegmentLog::Open() {
+  std::lock_guard<std::mutex> lck(mutex_);
+  if (num_segments_ == 0) {
+    RETURN_IF_NOT_OK(AddSegment());
+  }
+  return Status::OK();
+}
+
+Status CacheSegmentLog::Close() noexcept {
+  std::lock_guard<std::mutex> lck(mutex_);
+  Status rc;
+  auto num_segments = num_segments_.load();
+  for (uint32_t i = 0; i < num_segments; ++i) {
+    if (fds_[i] < 0) {
+      continue;
+    }
+    if (ftruncate(fds_[i], 0) != 0 || close(fds_[i]) != 0) {
+      rc = STATUS_ERROR(StatusCode::kMDUnexpectedError, strerror(errno));
+    }
+    fds_[i] = -1;
+  }
+  num_segments_ = 0;
+  tail_ = 0;
+  return rc;
+}
+
+Status CacheSegmentLog::Append(const std::vector<ReadableSlice> &buf, Entry *entry) {
+  RETURN_UNEXPECTED_IF_NULL(entry);
+  uint64_t sz = 0;
+  for (auto &v : buf) {
+    sz += v.GetSize();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(sz > 0, "Unexpected 0 length");
+  int fd = -1;
+  {
+    // Only the space is reserved under the lock. The rows are written concurrently to disjoint ranges.
+    std::lock_guard<std::mutex> lck(mutex_);
+    CHECK_FAIL_RETURN_UNEXPECTED(num_segments_ > 0, "The segment log is not open.");
+    if (tail_ > 0 && tail_ + sz > segment_size_) {
+      RETURN_IF_NOT_OK(AddSegment());
+    }
+    entry->segment_id = num_segments_ - 1;
+    entry->offset = tail_;
+    fd = fds_[entry->segment_id];
+    tail_ += sz;
+  }
+  uint64_t pos = entry->offset;
+  for (auto &v : buf) {
+    auto *p = static_cast<const uint8_t *>(v.GetPointer());
+    size_t remaining = v.GetSize();
+    while (remaining > 0) {
+      auto n = pwrite(fd, p, remaining, static_cast<off_t>(pos));
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        if (errno == ENOSPC) {
+          RETURN_STATUS_ERROR(StatusCode::kMDNoSpace, "no space left.");
+        }
+        RETURN_STATUS_UNEXPECTED(strerror(errno));
+      }
+      p += n;
+      pos += static_cast<uint64_t>(n);
+      remaining -= static_cast<size_t>(n);
+    }
+  }
+  bytes_appended_ += sz;
+  return Status::OK();
+}
+
+Status CacheSegmentLog::Read(const Entry &entry, WritableSlice *dest) const {
+  RETURN_UNEXPECTED_IF_NULL(dest);
+  CHECK_FAIL_RETURN_UNEXPECTED(entry.segment_id < num_segments_.load(),
+                               "Segment " + std::to_string(entry.segment_id) + " not found");
+  int fd = fds_[entry.segment_id];
+  auto *p = static_cast<uint8_t *>(dest->GetMutablePointer());
+  size_t remaining = dest->GetSize();
+  uint64_t pos = entry.offset;
+  while (remaining > 0) {
+    auto n = pread(fd, p, remaining, static_cast<off_t>(pos));
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      RETURN_STATUS_UNEXPECTED(n == 0 ? std::string("Unexpected end of segment") : std::string(strerror(errno)));
+    }
+    p += n;
+    pos += static_cast<uint64_t>(n);
+    remaining -= static_cast<size_t>(n);
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
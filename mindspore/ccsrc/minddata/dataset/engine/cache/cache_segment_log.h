@@ -0,0 +1,91 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_SEGMENT_LOG_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_SEGMENT_LOG_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/util/path.h"
+#include "minddata/dataset/util/slice.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief An append-only log of cached rows on local disk, made of segment files.
+/// A row is written once at the tail of the current segment and never moved, so its location is just the segment
+/// and the offset in it. The caller keeps that location in its own index, no index is kept on disk or in here.
+/// Rows are appended and read concurrently, each with positional I/O on the segment file.
+class CacheSegmentLog {
+ public:
+  /// \brief Location of a row in the log
+  struct Entry {
+    uint32_t segment_id = 0;
+    uint64_t offset = 0;
+  };
+
+  constexpr static uint64_t kDefaultSegmentSize = 1ULL << 30;
+  constexpr static int32_t kMaxNumSegments = 8192;
+
+  /// \brief Constructor
+  /// \param root The folder holding the segment files
+  /// \param segment_size The size after which a new segment file is started
+  explicit CacheSegmentLog(const Path &root, uint64_t segment_size = kDefaultSegmentSize);
+
+  ~CacheSegmentLog();
+
+  CacheSegmentLog(const CacheSegmentLog &) = delete;
+  CacheSegmentLog &operator=(const CacheSegmentLog &) = delete;
+
+  /// \brief Create the first segment
+  Status Open();
+
+  /// \brief Close and truncate all the segments
+  Status Close() noexcept;
+
+  /// \brief Append a row made of a sequence of slices to the tail of the log
+  /// \param[in] buf The slices of the row
+  /// \param[out] entry The location of the row
+  /// \return Status object. kMDNoSpace if the disk is full
+  Status Append(const std::vector<ReadableSlice> &buf, Entry *entry);
+
+  /// \brief Read a row back
+  /// \param[in] entry The location returned by Append
+  /// \param[out] dest The destination, the number of bytes read is the size of the destination
+  /// \return Status object
+  Status Read(const Entry &entry, WritableSlice *dest) const;
+
+  /// \brief Number of bytes appended so far
+  uint64_t BytesAppended() const { return bytes_appended_; }
+
+ private:
+  /// \brief Start a new segment file. Must hold mutex_.
+  Status AddSegment();
+
+  Path root_;
+  uint64_t segment_size_;
+  std::mutex mutex_;
+  std::vector<int> fds_;  // sized to kMaxNumSegments up front so readers never see it reallocated
+  std::atomic<uint32_t> num_segments_;
+  uint64_t tail_;  // append position in the last segment
+  std::atomic<uint64_t> bytes_appended_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_SEGMENT_LOG_H_
@@ -523,12 +523,23 @@ Status CacheServer::BatchFetchRows(CacheRequest *rq, CacheReply *reply) {
     // For large amount data to be sent back, we will use shared memory provided it is a local
     // client that has local bypass support
     bool local_bypass = local_client ? (mem_sz >= kLocalByPassThreshold) : false;
+    void *q = nullptr;
+    if (local_bypass) {
+      Status rc = AllocateSharedMemory(client_id, mem_sz, &q);
+      // The client keeps the blocks of the previous fetches until it is done with their tensors. If that uses up
+      // the shared memory, send the rows in the reply instead.
+      if (rc == StatusCode::kMDOutOfMemory) {
+        MS_LOG(WARNING) << "Shared memory is full. Send " << mem_sz << " bytes to client " << client_id
+                        << " by rpc instead. The client may hold too many fetched rows in use.";
+        local_bypass = false;
+      } else {
+        RETURN_IF_NOT_OK(rc);
+      }
+    }
     reply->set_flag(local_bypass ? kDataIsInSharedMemory : 0);
     if (local_bypass) {
       // We will use shared memory
       auto *base = SharedMemoryBaseAddr();
-      void *q = nullptr;
-      RETURN_IF_NOT_OK(AllocateSharedMemory(client_id, mem_sz, &q));
       WritableSlice dest(q, mem_sz);
       Status rc = BatchFetch(fbb, &dest);
       if (rc.IsError()) {
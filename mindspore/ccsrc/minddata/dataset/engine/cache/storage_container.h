@@ -30,12 +30,8 @@
 
 namespace mindspore {
 namespace dataset {
-class StorageManager;
-
 class StorageContainer {
  public:
-  friend class StorageManager;
-
   ~StorageContainer() noexcept;
 
   StorageContainer(const StorageContainer &) = delete;
@@ -72,8 +72,7 @@ Status CacheBase::FetchSamplesToWorkers() {
   RETURN_UNEXPECTED_IF_NULL(tree_);
   RETURN_IF_NOT_OK(
     tree_->LaunchWorkers(num_prefetchers_, std::bind(&CacheBase::Prefetcher, this, std::placeholders::_1), Name()));
-  auto send_to_que = [](QueueList<std::unique_ptr<IOBlock>> &qList, int32_t worker_id,
-                        std::vector<row_id_type> &keys) -> Status {
+  auto send_to_que = [](auto &qList, int32_t worker_id, std::vector<row_id_type> &keys) -> Status {
     auto blk = std::make_unique<IOBlock>(IOBlock(keys, IOBlock::kDeIoBlockNone));
     RETURN_IF_NOT_OK(qList[worker_id]->Add(std::move(blk)));
     return Status::OK();
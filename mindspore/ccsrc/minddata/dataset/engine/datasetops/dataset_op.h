@@ -359,6 +359,12 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
 
   virtual bool IsPython() const { return false; }
 
+  // \brief Getter of the I/O counters of a leaf op which reads from storage
+  // \param[out] bytes_read number of bytes read so far
+  // \param[out] num_reads number of read requests issued so far
+  // \return true if the op reports I/O counters
+  virtual bool GetIoCounters(uint64_t *bytes_read, uint64_t *num_reads) const { return false; }
+
   virtual std::vector<int32_t> GetMPWorkerPIDs() const;
 
  protected:
@@ -55,6 +55,8 @@ MapOp::MapOp(const std::vector<std::string> &in_col_names, const std::vector<std
       [](std::shared_ptr<TensorOperation> operation) -> std::shared_ptr<TensorOp> { return operation->Build(); });
   }
 
+  preserve_order_ = GlobalContext::config_manager()->map_preserve_order();
+
   if (out_columns_.empty() || out_columns_[0].empty()) {
     out_columns_ = in_columns_;
   }
@@ -156,7 +158,7 @@ Status MapOp::operator()() {
       RETURN_IF_NOT_OK(callback_manager_.StepBegin(CallbackParam(op_current_epochs_ + 1, ep_step, total_step)));
 
       std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(new_row));
-      int32_t cur_worker_id = NextWorkerID();
+      int32_t cur_worker_id = preserve_order_ ? NextWorkerID() : LeastLoadedWorkerID();
 
       // Populate map worker job for a worker to execute
       RETURN_IF_NOT_OK(GenerateWorkerJob(&worker_job, cur_worker_id));
@@ -168,15 +170,13 @@ Status MapOp::operator()() {
     }
 
     // Propagate the eoe row to worker
-    std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(new_row));
-    RETURN_IF_NOT_OK(worker_in_queues_[NextWorkerID()]->Add(std::move(worker_job)));
+    RETURN_IF_NOT_OK(SendFlagToWorkers(std::move(new_row)));
     UpdateRepeatAndEpochCounter();
     RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
   }
   // End() is commented out because it might never be called due to the lack of EOF when EpochCtrl is -1
   // Handle eof logic, this code might never be reached if epoch_ctrl = -1.
-  std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(new_row));
-  RETURN_IF_NOT_OK(worker_in_queues_[NextWorkerID()]->Add(std::move(worker_job)));
+  RETURN_IF_NOT_OK(SendFlagToWorkers(std::move(new_row)));
 
   // Quit all workers, this code might never be reached if EpochCtrl is -1.
   for (int32_t wkr_id = 0; wkr_id < num_workers_; wkr_id++) {
@@ -414,6 +414,18 @@ void MapOp::CreateFinalColMap(std::unordered_map<std::string, int32_t> *col_name
   }
 }
 
+Status MapOp::SendFlagToWorkers(TensorRow &&flag_row) {
+  if (preserve_order_) {
+    return worker_in_queues_[NextWorkerID()]->Add(std::make_unique<MapWorkerJob>(std::move(flag_row)));
+  }
+  // Rows of one worker may be collected after those of another, so every worker has to flush its rows
+  // before the collector can pass the flag on.
+  for (int32_t wkr_id = 0; wkr_id < num_workers_; wkr_id++) {
+    RETURN_IF_NOT_OK(worker_in_queues_[wkr_id]->Add(std::make_unique<MapWorkerJob>(TensorRow(flag_row.Flags()))));
+  }
+  return Status::OK();
+}
+
 Status MapOp::SendWaitFlagToWorker(int32_t worker_id) {
   TensorRow wait_row(TensorRow::kFlagWait);
   RETURN_IF_NOT_OK(worker_in_queues_[worker_id]->Add(std::make_unique<MapWorkerJob>(wait_row)));
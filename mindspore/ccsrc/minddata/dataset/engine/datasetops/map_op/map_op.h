@@ -123,6 +123,11 @@ class MapOp : public ParallelOp<std::unique_ptr<MapWorkerJob>, TensorRow> {
   /// \return Status code
   Status SendQuitFlagToWorker(int32_t worker_id) override;
 
+  /// Send an eoe/eof row to the next worker, or to all workers when the order of rows is not kept
+  /// \param flag_row the row carrying the flag
+  /// \return Status code
+  Status SendFlagToWorkers(TensorRow &&flag_row);
+
   // List of tensor ops getter/setter
   // @Return the vector of tensor ops by non-const reference
 
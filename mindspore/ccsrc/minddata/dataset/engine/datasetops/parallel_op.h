@@ -27,6 +27,7 @@
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/datasetops/source/io_block.h"
+#include "minddata/dataset/util/spsc_queue.h"
 #include "minddata/dataset/util/status.h"
 
 namespace mindspore {
@@ -50,7 +51,8 @@ class ParallelOp : public DatasetOp {
         num_workers_(num_workers),
         next_worker_id_(0),
         strategy_{nullptr},
-        worker_connector_size_(op_connector_size) {
+        worker_connector_size_(op_connector_size),
+        collector_waiter_(std::make_shared<SpscWaiter>()) {
     // reduce excessive memory usage with high parallelism
     constexpr int32_t worker_limit = 4;
     if (num_workers_ > worker_limit) {
@@ -107,6 +109,9 @@ class ParallelOp : public DatasetOp {
     for (int32_t i = 0; i < num_new_workers; i++) {
       RETURN_IF_NOT_OK(worker_in_queues_.AddQueue(tree_->AllTasks()));
       RETURN_IF_NOT_OK(worker_out_queues_.AddQueue(tree_->AllTasks()));
+      if (!preserve_order_) {
+        worker_out_queues_[worker_out_queues_.size() - 1]->SetConsumerWaiter(collector_waiter_);
+      }
       Task *new_task;
       RETURN_IF_NOT_OK(tree_->AllTasks()->CreateAsyncTask(
         Name() + "::WorkerEntry", std::bind(&ParallelOp::WorkerEntry, this, num_workers_), &new_task, id()));
@@ -151,6 +156,12 @@ class ParallelOp : public DatasetOp {
     RETURN_UNEXPECTED_IF_NULL(tree_);
     worker_in_queues_.Init(num_workers_, worker_connector_size_);
     worker_out_queues_.Init(num_workers_, worker_connector_size_);
+    if (!preserve_order_) {
+      // the collector takes rows from whichever worker is ready, so it parks on one waiter shared by all workers.
+      for (size_t i = 0; i < worker_out_queues_.size(); ++i) {
+        worker_out_queues_[i]->SetConsumerWaiter(collector_waiter_);
+      }
+    }
 
     // Registers QueueList and individual Queues for interrupt services
     RETURN_IF_NOT_OK(worker_in_queues_.Register(tree_->AllTasks()));
@@ -314,9 +325,25 @@ class ParallelOp : public DatasetOp {
     SetStrategy();
     // num_step of current epoch and the total
     ep_step_ = 0, total_step_ = 0;
+    int32_t num_eoe = 0;
+    int32_t num_eof = 0;
     do {
       TensorRow row;
-      RETURN_IF_NOT_OK(worker_out_queues_[static_cast<const int>(num_rows++ % num_workers_)]->PopFront(&row));
+      if (preserve_order_) {
+        RETURN_IF_NOT_OK(worker_out_queues_[static_cast<const int>(num_rows++ % num_workers_)]->PopFront(&row));
+      } else {
+        RETURN_IF_NOT_OK(PopFromAnyWorker(&row));
+        if (row.eoe() || row.eof()) {
+          // every worker forwards its own eoe/eof in unordered mode, only the last one is passed on
+          int32_t *count = row.eoe() ? &num_eoe : &num_eof;
+          if (++(*count) < num_workers_) {
+            continue;
+          }
+          *count = 0;
+          // all the workers are at the boundary, the rows after it can be taken now
+          std::fill(worker_at_boundary_.begin(), worker_at_boundary_.end(), false);
+        }
+      }
       if (row.wait()) {
         // When collector receives the signal from worker thread, it increments an atomic int
         // If num_worker signals are received, wakes up the main thread
@@ -341,6 +368,54 @@ class ParallelOp : public DatasetOp {
     return Status::OK();
   }
 
+  /// Take the next row from whichever worker has one ready, parking on the shared waiter when none of them has.
+  /// A worker which has sent its eoe/eof is skipped until the Collector clears worker_at_boundary_, so that the rows
+  /// of the next epoch are not taken before the other workers finish the current one.
+  /// \param[out] row - the row popped
+  /// \return Status The status code returned
+  Status PopFromAnyWorker(S *row) {
+    if (worker_at_boundary_.size() < worker_out_queues_.size()) {
+      worker_at_boundary_.resize(worker_out_queues_.size(), false);
+    }
+    auto has_row = [this]() -> bool {
+      for (size_t i = 0; i < worker_out_queues_.size(); ++i) {
+        if (!worker_at_boundary_[i] && !worker_out_queues_[i]->empty()) {
+          return true;
+        }
+      }
+      return false;
+    };
+    while (true) {
+      size_t num_queues = worker_out_queues_.size();
+      for (size_t i = 0; i < num_queues; ++i) {
+        size_t queue_id = (next_pop_queue_ + i) % num_queues;
+        if (!worker_at_boundary_[queue_id] && worker_out_queues_[queue_id]->TryPopFront(row)) {
+          next_pop_queue_ = queue_id + 1;
+          worker_at_boundary_[queue_id] = row->eoe() || row->eof();
+          return Status::OK();
+        }
+      }
+      RETURN_IF_NOT_OK(collector_waiter_->Wait(has_row));
+    }
+  }
+
+  /// Pick the worker with the fewest pending jobs, used instead of round robin when the order of rows need not be
+  /// kept, so that a slow worker does not hold back the others.
+  /// \return int32_t The id of the worker
+  int32_t LeastLoadedWorkerID() {
+    int32_t worker_id = NextWorkerID();
+    size_t min_pending = worker_in_queues_[worker_id]->size();
+    for (int32_t i = 1; i < num_workers_ && min_pending > 0; i++) {
+      int32_t candidate = (worker_id + i) % num_workers_;
+      size_t pending = worker_in_queues_[candidate]->size();
+      if (pending < min_pending) {
+        min_pending = pending;
+        worker_id = candidate;
+      }
+    }
+    return worker_id;
+  }
+
   // Wait post used to perform the pausing logic
   WaitPost wait_for_workers_post_;
 
@@ -386,10 +461,18 @@ class ParallelOp : public DatasetOp {
 
   /// The size of input/output worker queeus
   int32_t worker_connector_size_;
-  /// queues to hold the input rows to workers
-  QueueList<T> worker_in_queues_;
-  /// queues to hold the output from workers
-  QueueList<S> worker_out_queues_;
+  /// queues to hold the input rows to workers, fed by the master thread only
+  QueueList<T, SpscQueue<T>> worker_in_queues_;
+  /// queues to hold the output from workers, each one drained by the collector only
+  QueueList<S, SpscQueue<S>> worker_out_queues_;
+  /// Whether the collector keeps the round robin order of workers. If false, the master thread must dispatch with
+  /// LeastLoadedWorkerID() and send eoe/eof to every worker.
+  bool preserve_order_{true};
+  /// Shared by all worker output queues when the order is not kept
+  std::shared_ptr<SpscWaiter> collector_waiter_;
+  size_t next_pop_queue_{0};
+  /// Whether the worker has sent its eoe/eof and waits for the others, used by the collector only
+  std::vector<bool> worker_at_boundary_;
 
  private:
   std::unique_ptr<RowHandlingStrategy> strategy_;
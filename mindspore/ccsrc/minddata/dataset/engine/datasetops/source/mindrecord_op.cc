@@ -64,6 +64,14 @@ MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, std::vector<std::str
 Status MindRecordOp::Init() {
   RETURN_IF_NOT_OK(shard_reader_->Open(dataset_file_, load_dataset_, num_mind_record_workers_, columns_to_load_,
                                        operators_, num_padded_));
+  int32_t io_depth = GlobalContext::config_manager()->mindrecord_io_depth();
+  if (io_depth > 0) {
+    Status rc = shard_reader_->EnableIoEngine(io_depth);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Failed to start the asynchronous read engine, the files are read synchronously. "
+                      << rc.GetErrDescription();
+    }
+  }
 
   data_schema_ = std::make_unique<DataSchema>();
 
@@ -117,6 +117,15 @@ class MindRecordOp : public MappableLeafOp {
   /// @return Name of the current Op
   std::string Name() const override { return "MindRecordOp"; }
 
+  /// Getter of the I/O counters of the ShardReader
+  /// @param bytes_read - number of bytes read from the mindrecord files
+  /// @param num_reads - number of read requests issued to the mindrecord files
+  /// @return true, MindRecordOp always reports its I/O counters
+  bool GetIoCounters(uint64_t *bytes_read, uint64_t *num_reads) const override {
+    shard_reader_->GetIoCounters(bytes_read, num_reads);
+    return true;
+  }
+
  private:
   Status GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, int32_t worker_id);
 
@@ -0,0 +1,496 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/source/tf_example_parser.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Wire types of the protobuf encoding
+constexpr uint32_t kWireVarint = 0;
+constexpr uint32_t kWireFixed64 = 1;
+constexpr uint32_t kWireLengthDelimited = 2;
+constexpr uint32_t kWireFixed32 = 5;
+constexpr uint32_t kWireTypeBits = 3;
+constexpr uint32_t kWireTypeMask = (1U << kWireTypeBits) - 1;
+
+// Field numbers in example.proto and feature.proto
+constexpr uint32_t kExampleFeaturesField = 1;  // Example.features
+constexpr uint32_t kFeaturesMapField = 1;      // Features.feature
+constexpr uint32_t kMapKeyField = 1;           // map entry key
+constexpr uint32_t kMapValueField = 2;         // map entry value
+constexpr uint32_t kListValueField = 1;        // BytesList.value, FloatList.value and Int64List.value
+
+constexpr int kMaxVarintBytes = 10;
+constexpr uint8_t kVarintMoreBit = 0x80;
+constexpr uint8_t kVarintPayloadMask = 0x7f;
+constexpr int kVarintPayloadBits = 7;
+
+const char kMalformedRecord[] = "Invalid data, failed to decode the tf.Example in place, the record is malformed.";
+
+// Reads the fields of a serialized message one after the other. The reads return false if the message is malformed.
+// They are on the path of every value, so they do not build a Status.
+class WireReader {
+ public:
+  explicit WireReader(std::string_view buf)
+      : p_(reinterpret_cast<const uint8_t *>(buf.data())), end_(p_ + buf.size()) {}
+
+  bool Done() const { return p_ >= end_; }
+
+  bool ReadVarint(uint64_t *value) {
+    uint64_t result = 0;
+    for (int i = 0; i < kMaxVarintBytes && p_ < end_; ++i) {
+      uint8_t byte = *p_++;
+      result |= static_cast<uint64_t>(byte & kVarintPayloadMask) << (kVarintPayloadBits * i);
+      if ((byte & kVarintMoreBit) == 0) {
+        *value = result;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ReadTag(uint32_t *field, uint32_t *wire_type) {
+    uint64_t tag = 0;
+    if (!ReadVarint(&tag)) {
+      return false;
+    }
+    *field = static_cast<uint32_t>(tag >> kWireTypeBits);
+    *wire_type = static_cast<uint32_t>(tag & kWireTypeMask);
+    return *field != 0;
+  }
+
+  bool ReadLengthDelimited(std::string_view *value) {
+    uint64_t len = 0;
+    if (!ReadVarint(&len) || len > static_cast<uint64_t>(end_ - p_)) {
+      return false;
+    }
+    *value = std::string_view(reinterpret_cast<const char *>(p_), static_cast<size_t>(len));
+    p_ += len;
+    return true;
+  }
+
+  bool ReadFixed32(uint32_t *value) {
+    if (end_ - p_ < static_cast<ptrdiff_t>(sizeof(uint32_t))) {
+      return false;
+    }
+    (void)std::copy(p_, p_ + sizeof(uint32_t), reinterpret_cast<uint8_t *>(value));
+    p_ += sizeof(uint32_t);
+    return true;
+  }
+
+  // Skip a field this parser does not need. Groups are deprecated and not expected in an Example.
+  bool SkipField(uint32_t wire_type) {
+    switch (wire_type) {
+      case kWireVarint: {
+        uint64_t unused = 0;
+        return ReadVarint(&unused);
+      }
+      case kWireFixed64:
+        return Skip(sizeof(uint64_t));
+      case kWireLengthDelimited: {
+        std::string_view unused;
+        return ReadLengthDelimited(&unused);
+      }
+      case kWireFixed32:
+        return Skip(sizeof(uint32_t));
+      default:
+        return false;
+    }
+  }
+
+ private:
+  bool Skip(size_t n) {
+    if (static_cast<size_t>(end_ - p_) < n) {
+      return false;
+    }
+    p_ += n;
+    return true;
+  }
+
+  const uint8_t *p_;
+  const uint8_t *end_;
+};
+
+// Number of varints in a packed repeated field. Every varint ends with the only one of its bytes without the more bit.
+bool CountPackedVarints(std::string_view packed, int64_t *count) {
+  if (!packed.empty() && (static_cast<uint8_t>(packed.back()) & kVarintMoreBit) != 0) {
+    return false;
+  }
+  *count += std::count_if(packed.begin(), packed.end(),
+                          [](char c) { return (static_cast<uint8_t>(c) & kVarintMoreBit) == 0; });
+  return true;
+}
+}  // namespace
+
+TFExampleParser::TFExampleParser(const DataSchema *data_schema) : data_schema_(data_schema) {
+  int32_t num_columns = static_cast<int32_t>(data_schema_->NumColumns());
+  column_names_.reserve(num_columns);
+  for (int32_t col = 0; col < num_columns; ++col) {
+    column_names_.push_back(data_schema_->Column(col).Name());
+  }
+  // the names are all in place, the views below will not move
+  for (int32_t col = 0; col < num_columns; ++col) {
+    column_index_[column_names_[col]] = col;
+  }
+}
+
+Status TFExampleParser::Parse(const unsigned char *data, size_t size, TensorRow *out_row) const {
+  RETURN_UNEXPECTED_IF_NULL(data);
+  RETURN_UNEXPECTED_IF_NULL(out_row);
+  std::vector<FeatureView> features;
+  RETURN_IF_NOT_OK(FindFeatures(std::string_view(reinterpret_cast<const char *>(data), size), &features));
+
+  int32_t num_columns = static_cast<int32_t>(column_names_.size());
+  for (int32_t col = 0; col < num_columns; ++col) {
+    const ColDescriptor &current_col = data_schema_->Column(col);
+    const FeatureView &feature = features[col];
+    if (!feature.found) {
+      RETURN_STATUS_UNEXPECTED("Invalid columns_list, column name: " + column_names_[col] +
+                               " does not exist in tfrecord file, check tfrecord files.");
+    }
+    std::shared_ptr<Tensor> ts;
+    switch (feature.kind) {
+      case Kind::kBytesList:
+        RETURN_IF_NOT_OK(LoadBytesList(current_col, feature.list, &ts));
+        break;
+      case Kind::kFloatList:
+        RETURN_IF_NOT_OK(LoadFloatList(current_col, feature.list, &ts));
+        break;
+      case Kind::kInt64List:
+        RETURN_IF_NOT_OK(LoadIntListSwitch(current_col, feature.list, &ts));
+        break;
+      default:
+        RETURN_STATUS_UNEXPECTED(
+          "Unrecognized datatype, column type in tfrecord file must be uint8, int64 or float32, check tfrecord file.");
+    }
+    (*out_row)[col] = std::move(ts);
+  }
+  return Status::OK();
+}
+
+Status TFExampleParser::FindFeatures(std::string_view example, std::vector<FeatureView> *features) const {
+  features->assign(column_names_.size(), FeatureView());
+  uint32_t field = 0;
+  uint32_t wire_type = 0;
+  WireReader example_reader(example);
+  while (!example_reader.Done()) {
+    CHECK_FAIL_RETURN_UNEXPECTED(example_reader.ReadTag(&field, &wire_type), kMalformedRecord);
+    if (field != kExampleFeaturesField || wire_type != kWireLengthDelimited) {
+      CHECK_FAIL_RETURN_UNEXPECTED(example_reader.SkipField(wire_type), kMalformedRecord);
+      continue;
+    }
+    // Example.features may be split in several fields, which protobuf merges into one. Merging the maps is taking
+    // their entries in order, the last one of a key replacing the others.
+    std::string_view features_msg;
+    CHECK_FAIL_RETURN_UNEXPECTED(example_reader.ReadLengthDelimited(&features_msg), kMalformedRecord);
+    WireReader features_reader(features_msg);
+    while (!features_reader.Done()) {
+      CHECK_FAIL_RETURN_UNEXPECTED(features_reader.ReadTag(&field, &wire_type), kMalformedRecord);
+      if (field != kFeaturesMapField || wire_type != kWireLengthDelimited) {
+        CHECK_FAIL_RETURN_UNEXPECTED(features_reader.SkipField(wire_type), kMalformedRecord);
+        continue;
+      }
+      std::string_view entry;
+      CHECK_FAIL_RETURN_UNEXPECTED(features_reader.ReadLengthDelimited(&entry), kMalformedRecord);
+      std::string_view key;
+      std::string_view value;
+      bool has_value = false;
+      WireReader entry_reader(entry);
+      while (!entry_reader.Done()) {
+        CHECK_FAIL_RETURN_UNEXPECTED(entry_reader.ReadTag(&field, &wire_type), kMalformedRecord);
+        if (field == kMapKeyField && wire_type == kWireLengthDelimited) {
+          CHECK_FAIL_RETURN_UNEXPECTED(entry_reader.ReadLengthDelimited(&key), kMalformedRecord);
+        } else if (field == kMapValueField && wire_type == kWireLengthDelimited) {
+          // a value split in several fields would have to be merged
+          CHECK_FAIL_RETURN_UNEXPECTED(!has_value, kMalformedRecord);
+          CHECK_FAIL_RETURN_UNEXPECTED(entry_reader.ReadLengthDelimited(&value), kMalformedRecord);
+          has_value = true;
+        } else {
+          CHECK_FAIL_RETURN_UNEXPECTED(entry_reader.SkipField(wire_type), kMalformedRecord);
+        }
+      }
+      auto it = column_index_.find(key);
+      if (it == column_index_.end()) {
+        continue;
+      }
+      FeatureView feature;
+      feature.found = true;
+      if (has_value) {
+        CHECK_FAIL_RETURN_UNEXPECTED(ParseFeature(value, &feature), kMalformedRecord);
+      }
+      (*features)[it->second] = feature;
+    }
+  }
+  return Status::OK();
+}
+
+bool TFExampleParser::ParseFeature(std::string_view feature, FeatureView *out) {
+  uint32_t field = 0;
+  uint32_t wire_type = 0;
+  WireReader reader(feature);
+  while (!reader.Done()) {
+    if (!reader.ReadTag(&field, &wire_type)) {
+      return false;
+    }
+    if (field >= static_cast<uint32_t>(Kind::kBytesList) && field <= static_cast<uint32_t>(Kind::kInt64List) &&
+        wire_type == kWireLengthDelimited) {
+      // a list split in several fields would have to be merged, and a second kind would replace the first one
+      if (out->kind != Kind::kNotSet) {
+        return false;
+      }
+      out->kind = static_cast<Kind>(field);
+      if (!reader.ReadLengthDelimited(&out->list)) {
+        return false;
+      }
+    } else if (!reader.SkipField(wire_type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Status TFExampleParser::LoadBytesList(const ColDescriptor &current_col, std::string_view list,
+                                      std::shared_ptr<Tensor> *tensor) {
+  // kBytesList can map to the following DE types ONLY!
+  // DE_UINT8, DE_INT8
+  // Must be single byte type for each element!
+  if (current_col.Type() != DataType::DE_UINT8 && current_col.Type() != DataType::DE_INT8 &&
+      current_col.Type() != DataType::DE_STRING) {
+    std::string err_msg = "Invalid column type, the column type of " + current_col.Name() +
+                          " should be int8, uint8 or string, but got " + current_col.Type().ToString();
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+
+  std::vector<std::string_view> bytes_list;
+  uint32_t field = 0;
+  uint32_t wire_type = 0;
+  WireReader reader(list);
+  while (!reader.Done()) {
+    CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadTag(&field, &wire_type), kMalformedRecord);
+    if (field == kListValueField && wire_type == kWireLengthDelimited) {
+      std::string_view value;
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadLengthDelimited(&value), kMalformedRecord);
+      bytes_list.push_back(value);
+    } else {
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.SkipField(wire_type), kMalformedRecord);
+    }
+  }
+  int32_t num_elements = static_cast<int32_t>(bytes_list.size());
+
+  if (current_col.Type() == DataType::DE_STRING) {
+    TensorShape shape = TensorShape::CreateScalar();
+    RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(num_elements, &shape));
+    RETURN_IF_NOT_OK(Tensor::CreateFromByteList(bytes_list, shape, tensor));
+    return Status::OK();
+  }
+
+  uint64_t max_size = 0;
+  for (const auto &value : bytes_list) {
+    max_size = std::max<uint64_t>(max_size, value.size());
+  }
+
+  int64_t pad_size = max_size;
+
+  // if user provides a shape in the form of [-1, d1, 2d, ... , dn], we need to pad to d1 * d2 * ... * dn
+  if (current_col.HasShape()) {
+    TensorShape cur_shape = current_col.Shape();
+    if (cur_shape.Size() >= 2 && cur_shape[0] == TensorShape::kDimUnknown) {
+      int64_t new_pad_size = 1;
+      for (int i = 1; i < cur_shape.Size(); ++i) {
+        if (cur_shape[i] == TensorShape::kDimUnknown) {
+          std::string err_msg =
+            "Invalid data dimension, only one dimension shape supported is -1, but the 0th and the" +
+            std::to_string(i) + "th dimension shape of " + current_col.Name() + " are both -1.";
+          RETURN_STATUS_UNEXPECTED(err_msg);
+        }
+        new_pad_size *= cur_shape[i];
+      }
+      pad_size = new_pad_size;
+    } else {
+      if (cur_shape.known() && static_cast<uint64_t>(cur_shape.NumOfElements()) != max_size) {
+        std::string err_msg = "Data dimensions of '" + current_col.Name() +
+                              "' do not match, the expected total elements of shape " + cur_shape.ToString() +
+                              " should be " + std::to_string(max_size) + ", but got " +
+                              std::to_string(cur_shape.NumOfElements());
+        RETURN_STATUS_UNEXPECTED(err_msg);
+      }
+    }
+  }
+
+  // know how many elements there are and the total bytes, create tensor here:
+  TensorShape current_shape = TensorShape::CreateScalar();
+  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(num_elements * pad_size, &current_shape));
+  RETURN_IF_NOT_OK(Tensor::CreateFromByteList(bytes_list, current_shape, current_col.Type(), pad_size, tensor));
+  return Status::OK();
+}
+
+Status TFExampleParser::LoadFloatList(const ColDescriptor &current_col, std::string_view list,
+                                      std::shared_ptr<Tensor> *tensor) {
+  // KFloatList can only map to DE types:
+  // DE_FLOAT32
+  if (current_col.Type() != DataType::DE_FLOAT32) {
+    std::string err_msg = "Invalid column type, the column type of " + current_col.Name() +
+                          " should be string, but got " + current_col.Type().ToString();
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+
+  // FloatList.value is packed, but protobuf also accepts its values one by one
+  int64_t num_elements = 0;
+  int32_t num_fields = 0;
+  std::string_view packed;
+  uint32_t field = 0;
+  uint32_t wire_type = 0;
+  WireReader count_reader(list);
+  while (!count_reader.Done()) {
+    CHECK_FAIL_RETURN_UNEXPECTED(count_reader.ReadTag(&field, &wire_type), kMalformedRecord);
+    if (field == kListValueField && wire_type == kWireLengthDelimited) {
+      CHECK_FAIL_RETURN_UNEXPECTED(count_reader.ReadLengthDelimited(&packed), kMalformedRecord);
+      CHECK_FAIL_RETURN_UNEXPECTED(packed.size() % sizeof(float) == 0, kMalformedRecord);
+      num_elements += static_cast<int64_t>(packed.size() / sizeof(float));
+      num_fields++;
+    } else if (field == kListValueField && wire_type == kWireFixed32) {
+      uint32_t unused = 0;
+      CHECK_FAIL_RETURN_UNEXPECTED(count_reader.ReadFixed32(&unused), kMalformedRecord);
+      num_elements++;
+      num_fields++;
+    } else {
+      CHECK_FAIL_RETURN_UNEXPECTED(count_reader.SkipField(wire_type), kMalformedRecord);
+    }
+  }
+
+  TensorShape current_shape = TensorShape::CreateUnknownRankShape();
+  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(static_cast<int32_t>(num_elements), &current_shape));
+  // The wire format is little endian like the hosts we run on, so the floats are copied as they are. The shape may
+  // hold less values than the list.
+  if (num_fields == 1 && !packed.empty()) {
+    // the usual case, all the values are packed together
+    RETURN_IF_NOT_OK(Tensor::CreateFromMemory(current_shape, current_col.Type(),
+                                              reinterpret_cast<const unsigned char *>(packed.data()), tensor));
+    return Status::OK();
+  }
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(current_shape, current_col.Type(), tensor));
+  auto it = (*tensor)->begin<float>();
+  auto end = (*tensor)->end<float>();
+  float value = 0;
+  WireReader reader(list);
+  while (!reader.Done() && it != end) {
+    CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadTag(&field, &wire_type), kMalformedRecord);
+    if (field == kListValueField && wire_type == kWireLengthDelimited) {
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadLengthDelimited(&packed), kMalformedRecord);
+      for (size_t pos = 0; pos < packed.size() && it != end; pos += sizeof(float), ++it) {
+        (void)std::copy_n(packed.data() + pos, sizeof(float), reinterpret_cast<char *>(&value));
+        *it = value;
+      }
+    } else if (field == kListValueField && wire_type == kWireFixed32) {
+      uint32_t bits = 0;
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadFixed32(&bits), kMalformedRecord);
+      (void)std::copy_n(reinterpret_cast<const char *>(&bits), sizeof(float), reinterpret_cast<char *>(&value));
+      *it = value;
+      ++it;
+    } else {
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.SkipField(wire_type), kMalformedRecord);
+    }
+  }
+  return Status::OK();
+}
+
+// Determines which template type to use and calls LoadIntList
+Status TFExampleParser::LoadIntListSwitch(const ColDescriptor &current_col, std::string_view list,
+                                          std::shared_ptr<Tensor> *tensor) {
+  if (current_col.Type() == DataType::DE_UINT64) {
+    RETURN_IF_NOT_OK(LoadIntList<uint64_t>(current_col, list, tensor));
+  } else if (current_col.Type() == DataType::DE_INT64) {
+    RETURN_IF_NOT_OK(LoadIntList<int64_t>(current_col, list, tensor));
+  } else if (current_col.Type() == DataType::DE_UINT32) {
+    RETURN_IF_NOT_OK(LoadIntList<uint32_t>(current_col, list, tensor));
+  } else if (current_col.Type() == DataType::DE_INT32) {
+    RETURN_IF_NOT_OK(LoadIntList<int32_t>(current_col, list, tensor));
+  } else if (current_col.Type() == DataType::DE_UINT16) {
+    RETURN_IF_NOT_OK(LoadIntList<uint16_t>(current_col, list, tensor));
+  } else if (current_col.Type() == DataType::DE_INT16) {
+    RETURN_IF_NOT_OK(LoadIntList<int16_t>(current_col, list, tensor));
+  } else if (current_col.Type() == DataType::DE_UINT8) {
+    RETURN_IF_NOT_OK(LoadIntList<uint8_t>(current_col, list, tensor));
+  } else if (current_col.Type() == DataType::DE_INT8) {
+    RETURN_IF_NOT_OK(LoadIntList<int8_t>(current_col, list, tensor));
+  } else {
+    std::string err_msg = "Invalid column type, the column type of " + current_col.Name() +
+                          " should be uint64, int64, uint32, int32, uint16, int16, uint8 or int8, but got " +
+                          current_col.Type().ToString();
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  return Status::OK();
+}
+
+// Reads the values of an int64 list and casts them to type T, must be an integral type compatible with int64_t
+template <typename T>
+Status TFExampleParser::LoadIntList(const ColDescriptor &current_col, std::string_view list,
+                                    std::shared_ptr<Tensor> *tensor) {
+  // Int64List.value is packed, but protobuf also accepts its values one by one
+  int64_t num_elements = 0;
+  uint32_t field = 0;
+  uint32_t wire_type = 0;
+  WireReader count_reader(list);
+  while (!count_reader.Done()) {
+    CHECK_FAIL_RETURN_UNEXPECTED(count_reader.ReadTag(&field, &wire_type), kMalformedRecord);
+    if (field == kListValueField && wire_type == kWireLengthDelimited) {
+      std::string_view packed;
+      CHECK_FAIL_RETURN_UNEXPECTED(count_reader.ReadLengthDelimited(&packed), kMalformedRecord);
+      CHECK_FAIL_RETURN_UNEXPECTED(CountPackedVarints(packed, &num_elements), kMalformedRecord);
+    } else if (field == kListValueField && wire_type == kWireVarint) {
+      uint64_t unused = 0;
+      CHECK_FAIL_RETURN_UNEXPECTED(count_reader.ReadVarint(&unused), kMalformedRecord);
+      num_elements++;
+    } else {
+      CHECK_FAIL_RETURN_UNEXPECTED(count_reader.SkipField(wire_type), kMalformedRecord);
+    }
+  }
+
+  // know how many elements there are, create tensor here:
+  TensorShape current_shape = TensorShape::CreateUnknownRankShape();
+  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(static_cast<int32_t>(num_elements), &current_shape));
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(current_shape, current_col.Type(), tensor));
+
+  // The shape may hold less values than the list
+  auto it = (*tensor)->begin<T>();
+  auto end = (*tensor)->end<T>();
+  uint64_t value = 0;
+  WireReader reader(list);
+  while (!reader.Done() && it != end) {
+    CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadTag(&field, &wire_type), kMalformedRecord);
+    if (field == kListValueField && wire_type == kWireLengthDelimited) {
+      std::string_view packed;
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadLengthDelimited(&packed), kMalformedRecord);
+      WireReader packed_reader(packed);
+      for (; !packed_reader.Done() && it != end; ++it) {
+        CHECK_FAIL_RETURN_UNEXPECTED(packed_reader.ReadVarint(&value), kMalformedRecord);
+        *it = static_cast<T>(static_cast<int64_t>(value));
+      }
+    } else if (field == kListValueField && wire_type == kWireVarint) {
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadVarint(&value), kMalformedRecord);
+      *it = static_cast<T>(static_cast<int64_t>(value));
+      ++it;
+    } else {
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.SkipField(wire_type), kMalformedRecord);
+    }
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,91 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_EXAMPLE_PARSER_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_EXAMPLE_PARSER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/engine/data_schema.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Decodes serialized tf.train.Example records into the columns of a schema.
+/// The protobuf wire format is walked in place: the features of the schema columns are located in the record, their
+/// values are counted, and each column is decoded straight into a Tensor of the right size. The other features are
+/// skipped without being looked at, and no protobuf message is built.
+/// Records that need protobuf merge semantics to be read (a field repeated where it is not expected) are reported as
+/// errors, the caller is expected to fall back to protobuf for them.
+class TFExampleParser {
+ public:
+  /// \brief Constructor
+  /// \param data_schema The columns to decode. Must outlive the parser.
+  explicit TFExampleParser(const DataSchema *data_schema);
+
+  ~TFExampleParser() = default;
+
+  /// \brief Decode one record. Safe to call from several threads.
+  /// \param[in] data The serialized Example
+  /// \param[in] size The size of the serialized Example
+  /// \param[out] out_row The row to fill, one tensor per column of the schema
+  /// \return Status object
+  Status Parse(const unsigned char *data, size_t size, TensorRow *out_row) const;
+
+ private:
+  /// \brief The oneof cases of a Feature, numbered as its fields
+  enum class Kind { kNotSet = 0, kBytesList = 1, kFloatList = 2, kInt64List = 3 };
+
+  /// \brief A feature located in the record
+  struct FeatureView {
+    bool found = false;
+    Kind kind = Kind::kNotSet;
+    std::string_view list;  // the serialized BytesList, FloatList or Int64List
+  };
+
+  /// \brief Locate the feature of every column
+  Status FindFeatures(std::string_view example, std::vector<FeatureView> *features) const;
+
+  /// \brief Find which list a serialized Feature holds
+  /// \return False if the Feature is malformed or needs to be merged
+  static bool ParseFeature(std::string_view feature, FeatureView *out);
+
+  static Status LoadBytesList(const ColDescriptor &current_col, std::string_view list,
+                              std::shared_ptr<Tensor> *tensor);
+
+  static Status LoadFloatList(const ColDescriptor &current_col, std::string_view list,
+                              std::shared_ptr<Tensor> *tensor);
+
+  static Status LoadIntListSwitch(const ColDescriptor &current_col, std::string_view list,
+                                  std::shared_ptr<Tensor> *tensor);
+
+  template <typename T>
+  static Status LoadIntList(const ColDescriptor &current_col, std::string_view list,
+                            std::shared_ptr<Tensor> *tensor);
+
+  const DataSchema *data_schema_;
+  std::vector<std::string> column_names_;
+  std::unordered_map<std::string_view, int32_t> column_index_;  // views of column_names_
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_EXAMPLE_PARSER_H_
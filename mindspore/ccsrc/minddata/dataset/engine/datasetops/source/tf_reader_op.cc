@@ -84,6 +84,8 @@ Status TFReaderOp::Init() {
     RETURN_IF_NOT_OK(CreateSchema(dataset_files_list_[0], columns_to_load_));
   }
 
+  example_parser_ = std::make_unique<TFExampleParser>(data_schema_.get());
+
   if (compression_type_ == CompressionType::NONE && total_rows_ == 0) {
     total_rows_ = data_schema_->NumRows();
   }
@@ -161,12 +163,16 @@ Status TFReaderOp::LoadFile(const std::string &filename, int64_t start_offset, i
 Status TFReaderOp::HelperLoadNonCompFile(const std::string &filename, int64_t start_offset, int64_t end_offset,
                                          int32_t worker_id, const std::string &realpath_value) {
   std::ifstream reader;
-  reader.open(realpath_value);
+  reader.open(realpath_value, std::ios::binary);
   if (!reader) {
     RETURN_STATUS_UNEXPECTED("Invalid file, " + filename + " open failed: permission denied!");
   }
 
   int64_t rows_total = 0;
+  int32_t num_columns = static_cast<int32_t>(data_schema_->NumColumns());
+  const std::vector<std::string> file_path(num_columns, filename);
+  // every record is read into the same buffer, followed by its crc footer
+  std::string record;
 
   while (reader.peek() != EOF) {
     if (!load_jagged_connector_) {
@@ -174,37 +180,43 @@ Status TFReaderOp::HelperLoadNonCompFile(const std::string &filename, int64_t st
     }
     RETURN_IF_INTERRUPTED();
 
-    // read length
+    // the rows after the shard are left to the other workers
+    if (start_offset != kInvalidOffset && rows_total >= end_offset) {
+      break;
+    }
+
+    // read length and its crc
     int64_t record_length = 0;
+    uint32_t masked_crc = 0;
     (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(kTFRecordRecLenSize));
+    (void)reader.read(reinterpret_cast<char *>(&masked_crc), static_cast<std::streamsize>(kTFRecordHeadFootSize));
+    if (!reader) {
+      RETURN_STATUS_UNEXPECTED("Invalid TFRecord file: " + filename + ", the last record is truncated.");
+    }
+    RETURN_IF_NOT_OK(
+      HelperCheckCrc(reinterpret_cast<const char *>(&record_length), kTFRecordRecLenSize, masked_crc, filename));
 
-    // ignore crc header
-    (void)reader.ignore(static_cast<std::streamsize>(kTFRecordHeadFootSize));
-
-    // read serialized Example
-    std::string serialized_example;
-    serialized_example.resize(static_cast<size_t>(record_length));
-    (void)reader.read(&serialized_example[0], static_cast<std::streamsize>(record_length));
-
-    int32_t num_columns = static_cast<int32_t>(data_schema_->NumColumns());
-    TensorRow newRow(num_columns, nullptr);
-
-    if (start_offset == kInvalidOffset || (rows_total >= start_offset && rows_total < end_offset)) {
-      dataengine::Example tf_record_file;
-      if (!tf_record_file.ParseFromString(serialized_example)) {
-        std::string errMsg = "Failed to parse tfrecord file: " + filename + ", make sure protobuf version is suitable.";
-        MS_LOG(DEBUG) << errMsg + ", details of string: " << serialized_example;
-        RETURN_STATUS_UNEXPECTED(errMsg);
-      }
+    if (start_offset != kInvalidOffset && rows_total < start_offset) {
+      // skip the serialized Example and the crc footer without reading them
+      (void)reader.seekg(record_length + kTFRecordHeadFootSize, std::ios::cur);
+      rows_total++;
+      continue;
+    }
 
-      std::vector<std::string> file_path(num_columns, filename);
-      newRow.setPath(file_path);
-      RETURN_IF_NOT_OK(LoadExample(&tf_record_file, &newRow));
-      RETURN_IF_NOT_OK(jagged_rows_connector_->Add(worker_id, std::move(newRow)));
+    // read serialized Example and crc footer
+    record.resize(static_cast<size_t>(record_length + kTFRecordHeadFootSize));
+    (void)reader.read(&record[0], static_cast<std::streamsize>(record.size()));
+    if (!reader) {
+      RETURN_STATUS_UNEXPECTED("Invalid TFRecord file: " + filename + ", the last record is truncated.");
     }
+    (void)std::copy_n(record.data() + record_length, kTFRecordHeadFootSize, reinterpret_cast<char *>(&masked_crc));
+    RETURN_IF_NOT_OK(HelperCheckCrc(record.data(), static_cast<size_t>(record_length), masked_crc, filename));
 
-    // ignore crc footer
-    (void)reader.ignore(static_cast<std::streamsize>(kTFRecordHeadFootSize));
+    TensorRow newRow(num_columns, nullptr);
+    newRow.setPath(file_path);
+    RETURN_IF_NOT_OK(
+      ParseExample(filename, reinterpret_cast<const unsigned char *>(record.data()), record_length, &newRow));
+    RETURN_IF_NOT_OK(jagged_rows_connector_->Add(worker_id, std::move(newRow)));
     rows_total++;
   }
   return Status::OK();
@@ -218,8 +230,15 @@ Status TFReaderOp::HelperLoadCompGZIPFile(const std::string &filename, int64_t s
     RETURN_STATUS_UNEXPECTED("Invalid file, " + filename + " open failed: permission denied!");
   }
 
+  // a larger buffer than the default 8KB to inflate bigger chunks at once
+  (void)gzbuffer(file, kGZIPBufferSize);
+
   int64_t rows_read = 0;
   int64_t rows_total = 0;
+  int32_t num_columns = static_cast<int32_t>(data_schema_->NumColumns());
+  const std::vector<std::string> file_path(num_columns, filename);
+  // every record is read into the same buffer, followed by its crc footer
+  std::string record;
 
   while (gzeof(file) != 1) {
     if (compression_type_ == CompressionType::GZIP && rows_read >= end_offset) {
@@ -238,47 +257,33 @@ Status TFReaderOp::HelperLoadCompGZIPFile(const std::string &filename, int64_t s
       continue;
     }
 
-    if (rows_total == 0) {
-      // do the delayed checking; read crc from file
-      uint32_t masked_crc = 0;
-      (void)gzread(file, reinterpret_cast<char *>(&masked_crc), sizeof(uint32_t));
-
-      // generate crc from data
-      uint32_t generated_crc =
-        system::Crc32c::GetMaskCrc32cValue(reinterpret_cast<char *>(&record_length), kTFRecordRecLenSize);
+    // read crc from file and check it against the length
+    uint32_t masked_crc = 0;
+    (void)gzread(file, reinterpret_cast<char *>(&masked_crc), sizeof(uint32_t));
+    RETURN_IF_NOT_OK(
+      HelperCheckCrc(reinterpret_cast<const char *>(&record_length), kTFRecordRecLenSize, masked_crc, filename));
 
-      // invalid tfrecord file
-      if (masked_crc != generated_crc) {
-        RETURN_STATUS_UNEXPECTED("Invalid TFRecord file: " + filename);
-      }
-    } else {
-      // ignore crc header
-      (void)gzseek(file, kTFRecordHeadFootSize, SEEK_CUR);
+    if (start_offset != kInvalidOffset && (rows_total < start_offset || rows_total >= end_offset)) {
+      // skip the serialized Example and the crc footer, they are inflated but not copied
+      (void)gzseek(file, record_length + kTFRecordHeadFootSize, SEEK_CUR);
+      rows_total++;
+      continue;
     }
 
-    // read serialized Example
-    std::string serialized_example;
-    serialized_example.resize(static_cast<size_t>(record_length));
-    (void)gzread(file, &serialized_example[0], static_cast<unsigned int>(record_length));
+    // read serialized Example and crc footer
+    record.resize(static_cast<size_t>(record_length + kTFRecordHeadFootSize));
+    if (gzread(file, &record[0], static_cast<unsigned int>(record.size())) != static_cast<int>(record.size())) {
+      RETURN_STATUS_UNEXPECTED("Invalid TFRecord file: " + filename + ", the last record is truncated.");
+    }
+    (void)std::copy_n(record.data() + record_length, kTFRecordHeadFootSize, reinterpret_cast<char *>(&masked_crc));
+    RETURN_IF_NOT_OK(HelperCheckCrc(record.data(), static_cast<size_t>(record_length), masked_crc, filename));
 
-    int32_t num_columns = static_cast<int32_t>(data_schema_->NumColumns());
     TensorRow newRow(num_columns, nullptr);
-
-    if (start_offset == kInvalidOffset || (rows_total >= start_offset && rows_total < end_offset)) {
-      dataengine::Example tf_record_file;
-      if (!tf_record_file.ParseFromString(serialized_example)) {
-        std::string errMsg = "Failed to parse tfrecord file: " + filename + ", make sure protobuf version is suitable.";
-        MS_LOG(DEBUG) << errMsg + ", details of string: " << serialized_example;
-        RETURN_STATUS_UNEXPECTED(errMsg);
-      }
-      std::vector<std::string> file_path(num_columns, filename);
-      newRow.setPath(file_path);
-      RETURN_IF_NOT_OK(LoadExample(&tf_record_file, &newRow));
-      rows_read++;
-      RETURN_IF_NOT_OK(jagged_rows_connector_->Add(worker_id, std::move(newRow)));
-    }
-    // ignore crc footer
-    (void)gzseek(file, kTFRecordHeadFootSize, SEEK_CUR);
+    newRow.setPath(file_path);
+    RETURN_IF_NOT_OK(
+      ParseExample(filename, reinterpret_cast<const unsigned char *>(record.data()), record_length, &newRow));
+    rows_read++;
+    RETURN_IF_NOT_OK(jagged_rows_connector_->Add(worker_id, std::move(newRow)));
     rows_total++;
   }
 
@@ -410,7 +415,11 @@ Status TFReaderOp::HelperInflateZLIB(ZLIBStreamInf *zlib_stream, const std::stri
         break;
       default:  // record example
         zlib_stream->strm.avail_out = static_cast<unsigned int>(zlib_stream->record_length);
-        zlib_stream->content = std::make_unique<unsigned char[]>(static_cast<size_t>(zlib_stream->record_length));
+        // the buffer of the previous record is reused if it is large enough
+        if (zlib_stream->record_length > zlib_stream->content_capacity) {
+          zlib_stream->content = std::make_unique<unsigned char[]>(static_cast<size_t>(zlib_stream->record_length));
+          zlib_stream->content_capacity = zlib_stream->record_length;
+        }
         zlib_stream->strm.next_out = zlib_stream->content.get();
     }
   }
@@ -451,21 +460,13 @@ Status TFReaderOp::HelperProcessZLIBData(ZLIBStreamInf *zlib_stream, int64_t *ro
       RETURN_STATUS_UNEXPECTED("Invalid TFRecord file: " + filename);
     }
   } else if (zlib_stream->read_flag == static_cast<int>(ZLIBReadFlag::Content)) {  // read serialized example
-    std::string serialized_example(reinterpret_cast<char *>(zlib_stream->content.get()), zlib_stream->record_length);
     int32_t num_columns = static_cast<int32_t>(data_schema_->NumColumns());
     TensorRow newRow(num_columns, nullptr);
 
     if (start_offset == kInvalidOffset || (*rows_total >= start_offset && *rows_total < end_offset)) {
-      dataengine::Example tf_record_file;
-      if (!tf_record_file.ParseFromString(serialized_example)) {
-        std::string errMsg = "Failed to parse tfrecord file: " + filename + ", make sure protobuf version is suitable.";
-        MS_LOG(DEBUG) << errMsg + ", details of string: " << serialized_example;
-        RETURN_STATUS_UNEXPECTED(errMsg);
-      }
-
       std::vector<std::string> file_path(num_columns, filename);
       newRow.setPath(file_path);
-      RETURN_IF_NOT_OK(LoadExample(&tf_record_file, &newRow));
+      RETURN_IF_NOT_OK(ParseExample(filename, zlib_stream->content.get(), zlib_stream->record_length, &newRow));
       (*rows_read)++;
       RETURN_IF_NOT_OK(jagged_rows_connector_->Add(worker_id, std::move(newRow)));
     }
@@ -477,232 +478,31 @@ Status TFReaderOp::HelperProcessZLIBData(ZLIBStreamInf *zlib_stream, int64_t *ro
 }
 #endif
 
-// Parses a single row and puts the data into a tensor table.
-Status TFReaderOp::LoadExample(const dataengine::Example *tf_record_file, TensorRow *out_row) {
-  int32_t num_columns = static_cast<int32_t>(data_schema_->NumColumns());
-  for (int32_t col = 0; col < num_columns; ++col) {
-    const ColDescriptor current_col = data_schema_->Column(col);
-    const dataengine::Features &example_features = tf_record_file->features();
-    const google::protobuf::Map<std::string, dataengine::Feature> &feature_map = example_features.feature();
-    auto iter_column = feature_map.find(current_col.Name());
-    if (iter_column == feature_map.end()) {
-      RETURN_STATUS_UNEXPECTED("Invalid columns_list, column name: " + current_col.Name() +
-                               " does not exist in tfrecord file, check tfrecord files.");
-    }
-    const dataengine::Feature &column_values_list = iter_column->second;
-    RETURN_IF_NOT_OK(LoadFeature(out_row, column_values_list, current_col, col));
+Status TFReaderOp::HelperCheckCrc(const char *data, size_t size, uint32_t masked_crc, const std::string &filename) {
+  if (masked_crc != system::Crc32c::GetMaskCrc32cValue(data, size)) {
+    RETURN_STATUS_UNEXPECTED("Invalid TFRecord file: " + filename);
   }
-
   return Status::OK();
 }
 
-// Parses a single cell and puts the data into a tensor table.
-Status TFReaderOp::LoadFeature(TensorRow *tensor_row, const dataengine::Feature &column_values_list,
-                               const ColDescriptor &current_col, int32_t col) {
-  const dataengine::Feature::KindCase column_list_type = column_values_list.kind_case();
-  std::unique_ptr<float[]> float_array;     // For staging data from protobuf deserialization
-  const unsigned char *data_ptr = nullptr;  // Generic pointer used for populating the Tensor
-
-  // This variable will point into the above staging variables.
-  // Also used for creating shape attributes.
-  int32_t num_elements = 0;
-
-  // we build a tensor first a read directly into it if we need to cast
-  std::shared_ptr<Tensor> ts;
-
-  // Depending on the type of data from the tf_record_file, we want to extract 2 things:
-  // 1) A pointer to the data as a const unsigned char *
-  // 2) The number of elements of the data
-  // After those are determined, we can then build the tensor to represent this data.
-  switch (column_list_type) {
-    case dataengine::Feature::KindCase::kBytesList: {
-      RETURN_IF_NOT_OK(LoadBytesList(current_col, column_values_list, &num_elements, &ts));
-
-      break;
-    }
-    case dataengine::Feature::KindCase::kFloatList: {
-      RETURN_IF_NOT_OK(LoadFloatList(current_col, column_values_list, &num_elements, &float_array));
-
-      data_ptr = reinterpret_cast<const unsigned char *>(float_array.get());
-
-      // only floatList needs to create the tensor here, other two lists read directly
-      // into the tensor
-      TensorShape current_shape = TensorShape::CreateUnknownRankShape();
-      RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(num_elements, &current_shape));
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(current_shape, current_col.Type(), data_ptr, &ts));
-      break;
-    }
-    case dataengine::Feature::KindCase::kInt64List: {
-      RETURN_IF_NOT_OK(LoadIntListSwitch(current_col, column_values_list, &num_elements, &ts));
-      break;
-    }
-    case dataengine::Feature::KindCase::KIND_NOT_SET: {
-      std::string err_msg =
-        "Unrecognized datatype, column type in tfrecord file must be uint8, int64 or float32, check tfrecord file.";
-      RETURN_STATUS_UNEXPECTED(err_msg);
-    }
-    default: {
-      std::string err_msg =
-        "Unrecognized datatype, column type in tfrecord file must be uint8, int64 or float32, check tfrecord file.";
-      RETURN_STATUS_UNEXPECTED(err_msg);
-    }
-  }
-
-  (*tensor_row)[col] = std::move(ts);
-
-  return Status::OK();
-}
-
-Status TFReaderOp::LoadBytesList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                                 int32_t *num_elements, std::shared_ptr<Tensor> *tensor) {
-  // kBytesList can map to the following DE types ONLY!
-  // DE_UINT8, DE_INT8
-  // Must be single byte type for each element!
-  if (current_col.Type() != DataType::DE_UINT8 && current_col.Type() != DataType::DE_INT8 &&
-      current_col.Type() != DataType::DE_STRING) {
-    std::string err_msg = "Invalid column type, the column type of " + current_col.Name() +
-                          " should be int8, uint8 or string, but got " + current_col.Type().ToString();
-    RETURN_STATUS_UNEXPECTED(err_msg);
-  }
-
-  const dataengine::BytesList &bytes_list = column_values_list.bytes_list();
-
-  *num_elements = bytes_list.value_size();
-
-  if (current_col.Type() == DataType::DE_STRING) {
-    TensorShape shape = TensorShape::CreateScalar();
-    RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(*num_elements, &shape));
-    RETURN_IF_NOT_OK(Tensor::CreateFromByteList(bytes_list, shape, tensor));
-    return Status::OK();
-  }
-
-  uint64_t max_size = 0;
-  for (uint32_t i = 0; i < bytes_list.value_size(); ++i) {
-#if defined(__APPLE__)
-    max_size = fmax(max_size, bytes_list.value(i).size());
-#else
-    max_size = std::max(max_size, bytes_list.value(i).size());
-#endif
-  }
-
-  int64_t pad_size = max_size;
-
-  // if user provides a shape in the form of [-1, d1, 2d, ... , dn], we need to pad to d1 * d2 * ... * dn
-  if (current_col.HasShape()) {
-    TensorShape cur_shape = current_col.Shape();
-    if (cur_shape.Size() >= 2 && cur_shape[0] == TensorShape::kDimUnknown) {
-      int64_t new_pad_size = 1;
-      for (int i = 1; i < cur_shape.Size(); ++i) {
-        if (cur_shape[i] == TensorShape::kDimUnknown) {
-          std::string err_msg =
-            "Invalid data dimension, only one dimension shape supported is -1, but the 0th and the" +
-            std::to_string(i) + "th dimension shape of " + current_col.Name() + " are both -1.";
-          RETURN_STATUS_UNEXPECTED(err_msg);
-        }
-        new_pad_size *= cur_shape[i];
-      }
-      pad_size = new_pad_size;
-    } else {
-      if (cur_shape.known() && cur_shape.NumOfElements() != max_size) {
-        std::string err_msg = "Data dimensions of '" + current_col.Name() +
-                              "' do not match, the expected total elements of shape " + cur_shape.ToString() +
-                              " should be " + std::to_string(max_size) + ", but got " +
-                              std::to_string(cur_shape.NumOfElements());
-        RETURN_STATUS_UNEXPECTED(err_msg);
-      }
-    }
-  }
-
-  // know how many elements there are and the total bytes, create tensor here:
-  TensorShape current_shape = TensorShape::CreateScalar();
-  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape((*num_elements) * pad_size, &current_shape));
-  RETURN_IF_NOT_OK(Tensor::CreateFromByteList(bytes_list, current_shape, current_col.Type(), pad_size, tensor));
-
-  return Status::OK();
-}
-
-Status TFReaderOp::LoadFloatList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                                 int32_t *num_elements, std::unique_ptr<float[]> *float_array) {
-  // KFloatList can only map to DE types:
-  // DE_FLOAT32
-  if (current_col.Type() != DataType::DE_FLOAT32) {
-    std::string err_msg = "Invalid column type, the column type of " + current_col.Name() +
-                          " should be string, but got " + current_col.Type().ToString();
-    RETURN_STATUS_UNEXPECTED(err_msg);
-  }
-
-  const dataengine::FloatList &float_list = column_values_list.float_list();
-
-  // Identify how many values we have and then create a local array of these
-  // to deserialize into
-  *num_elements = float_list.value_size();
-  *float_array = std::make_unique<float[]>(*num_elements);
-  for (int i = 0; i < float_list.value_size(); ++i) {
-    (*float_array)[i] = float_list.value(i);
-  }
-
-  return Status::OK();
-}
-
-// Determines which template type to use and calls LoadIntList
-Status TFReaderOp::LoadIntListSwitch(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                                     int32_t *num_elements, std::shared_ptr<Tensor> *tensor) {
-  if (current_col.Type() == DataType::DE_UINT64) {
-    RETURN_IF_NOT_OK(LoadIntList<uint64_t>(current_col, column_values_list, num_elements, tensor));
-  } else if (current_col.Type() == DataType::DE_INT64) {
-    RETURN_IF_NOT_OK(LoadIntList<int64_t>(current_col, column_values_list, num_elements, tensor));
-  } else if (current_col.Type() == DataType::DE_UINT32) {
-    RETURN_IF_NOT_OK(LoadIntList<uint32_t>(current_col, column_values_list, num_elements, tensor));
-  } else if (current_col.Type() == DataType::DE_INT32) {
-    RETURN_IF_NOT_OK(LoadIntList<int32_t>(current_col, column_values_list, num_elements, tensor));
-  } else if (current_col.Type() == DataType::DE_UINT16) {
-    RETURN_IF_NOT_OK(LoadIntList<uint16_t>(current_col, column_values_list, num_elements, tensor));
-  } else if (current_col.Type() == DataType::DE_INT16) {
-    RETURN_IF_NOT_OK(LoadIntList<int16_t>(current_col, column_values_list, num_elements, tensor));
-  } else if (current_col.Type() == DataType::DE_UINT8) {
-    RETURN_IF_NOT_OK(LoadIntList<uint8_t>(current_col, column_values_list, num_elements, tensor));
-  } else if (current_col.Type() == DataType::DE_INT8) {
-    RETURN_IF_NOT_OK(LoadIntList<int8_t>(current_col, column_values_list, num_elements, tensor));
-  } else {
-    std::string err_msg = "Invalid column type, the column type of " + current_col.Name() +
-                          " should be uint64, int64, uint32, int32, uint16, int16, uint8 or int8, but got " +
-                          current_col.Type().ToString();
-    RETURN_STATUS_UNEXPECTED(err_msg);
-  }
-
-  return Status::OK();
-}
-
-// Reads values from a bytes list and casts the value to type T, must be an integral type
-// compatible with int64_t
-template <typename T>
-Status TFReaderOp::LoadIntList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                               int32_t *num_elements, std::shared_ptr<Tensor> *tensor) {
-  if (!(current_col.Type().IsInt())) {
-    std::string err_msg = "Invalid column type, the column type of " + current_col.Name() + " should be int, but got " +
-                          current_col.Type().ToString();
-    RETURN_STATUS_UNEXPECTED(err_msg);
-  }
-
-  const dataengine::Int64List &int64_list = column_values_list.int64_list();
-
-  // Identify how many values we have and then create a local array of these
-  // to deserialize into
-  *num_elements = int64_list.value_size();
-
-  // know how many elements there are, create tensor here:
-  TensorShape current_shape = TensorShape::CreateUnknownRankShape();
-  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(*num_elements, &current_shape));
-  RETURN_IF_NOT_OK(Tensor::CreateEmpty(current_shape, current_col.Type(), tensor));
-
-  int64_t i = 0;
-  auto it = (*tensor)->begin<T>();
-  for (; it != (*tensor)->end<T>(); i++, ++it) {
-    T element = static_cast<T>(int64_list.value(i));
-    *it = element;
+// Parses a single row and puts the data into a tensor table.
+Status TFReaderOp::ParseExample(const std::string &filename, const unsigned char *data, int64_t size,
+                                TensorRow *out_row) {
+  Status rc = example_parser_->Parse(data, static_cast<size_t>(size), out_row);
+  if (rc.IsOk()) {
+    return rc;
+  }
+  // Let protobuf decide whether the record is valid. If it is, it is written back in the canonical form, with every
+  // field once, which the parser reads. An invalid column is reported again by the parser.
+  dataengine::Example tf_record_file;
+  if (!tf_record_file.ParseFromArray(data, static_cast<int>(size))) {
+    std::string errMsg = "Failed to parse tfrecord file: " + filename + ", make sure protobuf version is suitable.";
+    MS_LOG(DEBUG) << errMsg + ", details of string: " << std::string(reinterpret_cast<const char *>(data), size);
+    RETURN_STATUS_UNEXPECTED(errMsg);
   }
-
-  return Status::OK();
+  std::string serialized_example = tf_record_file.SerializeAsString();
+  return example_parser_->Parse(reinterpret_cast<const unsigned char *>(serialized_example.data()),
+                                serialized_example.size(), out_row);
 }
 
 Status TFReaderOp::CreateSchema(const std::string tf_record_file, std::vector<std::string> columns_to_load) {
@@ -37,19 +37,15 @@
 #include "minddata/dataset/engine/data_schema.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/engine/datasetops/source/nonmappable_leaf_op.h"
+#include "minddata/dataset/engine/datasetops/source/tf_example_parser.h"
 #include "minddata/dataset/engine/jagged_connector.h"
 
-namespace dataengine {
-class Example;
-class Feature;
-class BytesList;
-}  // namespace dataengine
-
 namespace mindspore {
 namespace dataset {
 const int kTFRecordRecLenSize = sizeof(int64_t);
 const int kTFRecordHeadFootSize = sizeof(int32_t);  // header has same size with footer
 const int kZLIBChunkSize = 16384;
+const int kGZIPBufferSize = 131072;
 
 template <typename T>
 class Queue;
@@ -142,13 +138,15 @@ class TFReaderOp : public NonMappableLeafOp {
     unsigned char record_size[kTFRecordRecLenSize];  // in order to get record_length
     unsigned char garbage[kTFRecordHeadFootSize];    // header and footer are ignored
     std::unique_ptr<unsigned char[]> content;        // for serialized example
+    int64_t content_capacity;                        // the size of content, reused while records fit in
     int64_t record_length;                           // the content's length
     int read_flag;                                   // flag to keep track what is currently being read
     int64_t left_to_read;                            // number of bytes left to read for particular read_flag
     int inflate_status;                              // in order to keep track of inflate status
 
     ZLIBStreamInf()
-        : record_length(0),
+        : content_capacity(0),
+          record_length(0),
           read_flag(static_cast<int>(ZLIBReadFlag::RecordLength)),
           left_to_read(0),
           inflate_status(static_cast<int>(Z_OK)) {
@@ -237,57 +235,22 @@ class TFReaderOp : public NonMappableLeafOp {
   Status HelperGetExampleSchema(std::string *serialized_example, const std::string &realpath_value,
                                 const std::string &filename);
 
-  // Parses a single row and puts the data into a tensor table.
-  // @param tf_record_file - the row to be parsed.
-  // @param tensor_table - the tensor table to put the parsed data in.
-  // @param row - the id of the row filled in the tensor table.
+  // Helper function to check the crc of a record, or of its length.
+  // @param data - the data the crc is computed on.
+  // @param size - the size of the data.
+  // @param masked_crc - the crc stored in the file.
+  // @param filename - TFRecord file name (for throwing error purposes)
   // @return Status - the error code returned.
-  Status LoadExample(const dataengine::Example *tf_record_file, TensorRow *out_row);
+  static Status HelperCheckCrc(const char *data, size_t size, uint32_t masked_crc, const std::string &filename);
 
-  // Parses a single cell and puts the data into a tensor table.
-  // @param tensor_table - the tensor table to put the parsed data in.
-  // @param column_values_list - the cell to parse.
-  // @param current_col - the column descriptor containing the expected shape and type of the data.
+  // Parses a single row and puts the data into a tensor table.
+  // The Example is decoded in place, protobuf is only used for the records the in place parser does not decode.
+  // @param filename - TFRecord file name (for throwing error purposes)
+  // @param data - the serialized Example.
+  // @param size - the size of the serialized Example.
+  // @param out_row - the row to put the parsed data in.
   // @return Status - the error code returned.
-  Status LoadFeature(TensorRow *tensor_row, const dataengine::Feature &column_values_list,
-                     const ColDescriptor &current_col, int32_t col);
-
-  /// Reads values from a bytes list
-  /// @param current_col - the column descriptor containing the expected shape and type of the data.
-  /// @param column_values_list - the cell that contains the bytes list to read from.
-  /// @param elementStr - the string we read the value into.
-  /// @return Status - the error code returned.
-  static Status LoadBytesList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                              int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
-
-  /// Reads values from a float list
-  /// @param current_col - the column descriptor containing the expected shape and type of the data.
-  /// @param column_values_list - the cell that contains the float list to read from.
-  /// @Param numElements - number of values in the float list.
-  /// @param float_array - the array we read the values into.
-  /// @return Status - the error code returned.
-  Status LoadFloatList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                       int32_t *num_elements, std::unique_ptr<float[]> *float_array);
-
-  /// Reads values from a bytes list and casts the value to type T, must be an integral
-  /// type compatible with int64_t
-  /// @param current_col - the column descriptor containing the expected shape and type of the data.
-  /// @param column_values_list - the cell that contains the int list to read from.
-  /// @Param num_elements - number of values in the int list.
-  /// @param tensor - the tensor we read the values into.
-  /// @return Status - the error code returned.
-  template <typename T>
-  Status LoadIntList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                     int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
-
-  /// Determines which template type to use and calls LoadIntList
-  /// @param current_col - the column descriptor containing the expected shape and type of the data.
-  /// @param column_values_list - the cell that contains the int list to read from.
-  /// @Param numElements - number of values in the int list.
-  /// @param tensor - the tensor we read the values into.
-  /// @return Status - the error code returned.
-  Status LoadIntListSwitch(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                           int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
+  Status ParseExample(const std::string &filename, const unsigned char *data, int64_t size, TensorRow *out_row);
 
   /// Reads one row of data from a tf file and creates a schema based on that row
   /// @return Status - the error code returned.
@@ -332,6 +295,7 @@ class TFReaderOp : public NonMappableLeafOp {
   std::vector<std::string> dataset_files_list_;
   std::vector<std::string> columns_to_load_;
   std::unique_ptr<DataSchema> data_schema_;
+  std::unique_ptr<TFExampleParser> example_parser_;
   bool equal_rows_per_shard_;
 };
 }  // namespace dataset
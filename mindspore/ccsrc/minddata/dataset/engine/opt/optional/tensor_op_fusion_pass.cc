@@ -16,7 +16,10 @@
 
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 
+#include <algorithm>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "minddata/dataset/engine/ir/datasetops/map_node.h"
@@ -24,47 +27,109 @@
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/fused_pixel_ir.h"
+#include "minddata/dataset/kernels/ir/vision/hwc_to_chw_ir.h"
+#include "minddata/dataset/kernels/ir/vision/normalize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_resized_crop_ir.h"
+#include "minddata/dataset/kernels/ir/vision/rescale_ir.h"
+#include "minddata/dataset/kernels/ir/vision/to_tensor_ir.h"
 
 namespace mindspore {
 namespace dataset {
+namespace {
+constexpr size_t kMinFusedPixelOps = 2;
+
+// ops changing the layout from HWC to CHW, a fused chain holds at most one of them
+bool IsPixelLayoutOp(const std::string &name) {
+  return name == vision::kHwcToChwOperation || name == vision::kToTensorOperation || name == kHwcToChwOp ||
+         name == kToTensorOp;
+}
+
+// ops whose output element only depends on the value and the channel of one input element
+bool IsPixelOp(const std::string &name) {
+  return IsPixelLayoutOp(name) || name == vision::kRescaleOperation || name == vision::kNormalizeOperation ||
+         name == transforms::kTypeCastOperation || name == kRescaleOp || name == kNormalizeOp || name == kTypeCastOp;
+}
+}  // namespace
 
 Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modified) {
   RETURN_UNEXPECTED_IF_NULL(node);
   RETURN_UNEXPECTED_IF_NULL(modified);
   std::vector<std::shared_ptr<TensorOperation>> ops = node->operations();
+  bool fused = false;
+  RETURN_IF_NOT_OK(FuseDecodeRandomCropResize(&ops, &fused));
+  RETURN_IF_NOT_OK(FusePixelOps(&ops, &fused));
+  if (fused) {
+    node->setOperations(ops);
+    *modified = true;
+  }
+  return Status::OK();
+}
 
+Status TensorOpFusionPass::FuseDecodeRandomCropResize(std::vector<std::shared_ptr<TensorOperation>> *ops,
+                                                      bool *const modified) {
+  RETURN_UNEXPECTED_IF_NULL(ops);
   // start temporary code, to deal with pre-built TensorOperation
   std::vector<std::string> pattern = {kDecodeOp, kRandomCropAndResizeOp};
-  auto itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
+  auto itr = std::search(ops->begin(), ops->end(), pattern.begin(), pattern.end(),
                          [](auto op, const std::string &nm) { return op != nullptr ? op->Name() == nm : false; });
-  if (itr != ops.end()) {
+  if (itr != ops->end()) {
     MS_LOG(WARNING) << "Fusing pre-build Decode and RandomCropResize into one pre-build.";
     auto fused_op = dynamic_cast<RandomCropAndResizeOp *>((*(itr + 1))->Build().get());
     RETURN_UNEXPECTED_IF_NULL(fused_op);
     (*itr) = std::make_shared<transforms::PreBuiltOperation>(std::make_shared<RandomCropDecodeResizeOp>(*fused_op));
-    ops.erase(itr + 1);
-    node->setOperations(ops);
+    (void)ops->erase(itr + 1);
     *modified = true;
     return Status::OK();
   }  // end of temporary code, needs to be deleted when tensorOperation's pybind completes
 
   // logic below is for non-prebuilt TensorOperation
   pattern = {vision::kDecodeOperation, vision::kRandomResizedCropOperation};
-  itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
+  itr = std::search(ops->begin(), ops->end(), pattern.begin(), pattern.end(),
                     [](auto op, const std::string &nm) { return op != nullptr ? op->Name() == nm : false; });
 
   // return here if no pattern is found
-  RETURN_OK_IF_TRUE(itr == ops.end());
+  RETURN_OK_IF_TRUE(itr == ops->end());
   auto *fused_ir = dynamic_cast<vision::RandomResizedCropOperation *>((itr + 1)->get());
   RETURN_UNEXPECTED_IF_NULL(fused_ir);
   // fuse the two ops
   (*itr) = std::make_shared<vision::RandomCropDecodeResizeOperation>(*fused_ir);
-  ops.erase(itr + 1);
-  node->setOperations(ops);
+  (void)ops->erase(itr + 1);
   *modified = true;
   return Status::OK();
 }
+
+Status TensorOpFusionPass::FusePixelOps(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *const modified) {
+  RETURN_UNEXPECTED_IF_NULL(ops);
+  std::vector<std::shared_ptr<TensorOperation>> fused_ops;
+  size_t begin = 0;
+  while (begin < ops->size()) {
+    size_t end = begin;
+    bool has_layout_op = false;
+    while (end < ops->size() && (*ops)[end] != nullptr && IsPixelOp((*ops)[end]->Name())) {
+      bool is_layout_op = IsPixelLayoutOp((*ops)[end]->Name());
+      if (has_layout_op && is_layout_op) {
+        break;
+      }
+      has_layout_op = has_layout_op || is_layout_op;
+      ++end;
+    }
+    if (end - begin < kMinFusedPixelOps) {
+      fused_ops.push_back((*ops)[begin]);
+      ++begin;
+      continue;
+    }
+    std::vector<std::shared_ptr<TensorOperation>> chain(ops->begin() + static_cast<std::ptrdiff_t>(begin),
+                                                        ops->begin() + static_cast<std::ptrdiff_t>(end));
+    MS_LOG(INFO) << "Fusing " << chain.size() << " per-pixel operations starting with " << chain.front()->Name()
+                 << " into one FusedPixel.";
+    fused_ops.push_back(std::make_shared<vision::FusedPixelOperation>(chain));
+    begin = end;
+    *modified = true;
+  }
+  *ops = std::move(fused_ops);
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -17,10 +17,13 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_TENSOR_OP_FUSION_PASS_H_
 
 #include <memory>
+#include <vector>
+
 #include "minddata/dataset/engine/opt/pass.h"
 
 namespace mindspore {
 namespace dataset {
+class TensorOperation;
 
 /// \class TensorOpFusionPass tensor_op_fusion_pass.h
 /// \brief And optional optimization pass identifying and fusing
@@ -31,6 +34,19 @@ class TensorOpFusionPass : public IRNodePass {
   /// \param[in, out] *modified indicates whether the node has been visited
   /// \return Status The status code returned
   Status Visit(std::shared_ptr<MapNode> node, bool *const modified) override;
+
+  /// \brief Fuses Decode followed by RandomResizedCrop into RandomCropDecodeResize
+  /// \param[in, out] ops The operations of the MapOp
+  /// \param[in, out] *modified set to true if the operations have been fused
+  /// \return Status The status code returned
+  Status FuseDecodeRandomCropResize(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *const modified);
+
+  /// \brief Fuses every chain of consecutive per-pixel operations (Rescale, Normalize, TypeCast, HWC2CHW and
+  ///     ToTensor) into one FusedPixel operation, which converts an image with one pass over its memory
+  /// \param[in, out] ops The operations of the MapOp
+  /// \param[in, out] *modified set to true if the operations have been fused
+  /// \return Status The status code returned
+  Status FusePixelOps(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *const modified);
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -40,9 +40,17 @@ Status ConnectorSize::Sample() {
   // Tree Iterator is in PostOrder (leaf first, e.g., 3,2,1)
   // reverse the order of the vector to get the root first.
   std::reverse(cur_row.begin(), cur_row.end());
+  IoCounterSample cur_io_row;
+  (void)std::transform(tree_->begin(), tree_->end(), std::back_inserter(cur_io_row), [](const DatasetOp &op) {
+    std::pair<uint64_t, uint64_t> counters = {0, 0};
+    (void)op.GetIoCounters(&counters.first, &counters.second);
+    return counters;
+  });
+  std::reverse(cur_io_row.begin(), cur_io_row.end());
   std::lock_guard<std::mutex> guard(lock_);
   // Push new row of sample
   sample_table_.push_back(cur_row);
+  io_sample_table_.push_back(cur_io_row);
   (void)ts_.emplace_back(ProfilingTime::GetCurMilliSecond());
   return Status::OK();
 }
@@ -59,6 +67,11 @@ json ConnectorSize::ParseOpInfo(const DatasetOp &node) const {
   if (!node.inlined() && node.Name() != "DataQueueOp") {
     metrics["output_queue"] = {{"length", node.ConnectorCapacity()}};
   }
+  uint64_t bytes_read = 0;
+  uint64_t num_reads = 0;
+  if (node.GetIoCounters(&bytes_read, &num_reads)) {
+    metrics["io"] = json::object();
+  }
   json_node["metrics"] = metrics;
 
   auto children = node.Children();
@@ -93,6 +106,13 @@ Status ConnectorSize::SaveToFile(const std::string &dir_path, const std::string
     if (ops_data[idx]["metrics"].contains("output_queue") && ops_data[idx]["op_type"] != "DataQueueOp") {
       ops_data[idx]["metrics"]["output_queue"]["size"] = cur_queue_size;
     }
+    if (ops_data[idx]["metrics"].contains("io")) {
+      std::vector<uint64_t> bytes_per_second;
+      std::vector<uint64_t> iops;
+      GetOpIoRate(idx, &bytes_per_second, &iops);
+      ops_data[idx]["metrics"]["io"]["bytes_per_second"] = bytes_per_second;
+      ops_data[idx]["metrics"]["io"]["iops"] = iops;
+    }
   }
 
   // Discard the content of the file when opening.
@@ -115,9 +135,30 @@ Status ConnectorSize::Init() {
   return Status::OK();
 }
 
+void ConnectorSize::GetOpIoRate(size_t idx, std::vector<uint64_t> *bytes_per_second, std::vector<uint64_t> *iops) {
+  // The rate of a sample is computed over the interval since the previous sample, the first sample has no rate
+  for (size_t i = 0; i < io_sample_table_.size() && i < ts_.size(); i++) {
+    if (i == 0 || ts_[i] <= ts_[i - 1]) {
+      bytes_per_second->push_back(0);
+      iops->push_back(0);
+      continue;
+    }
+    const uint64_t ms_per_second = 1000;
+    uint64_t interval = ts_[i] - ts_[i - 1];
+    const auto &cur = io_sample_table_[i][idx];
+    const auto &prev = io_sample_table_[i - 1][idx];
+    // The counters restart when the reader is rebuilt
+    uint64_t bytes = cur.first >= prev.first ? cur.first - prev.first : cur.first;
+    uint64_t reads = cur.second >= prev.second ? cur.second - prev.second : cur.second;
+    bytes_per_second->push_back(bytes * ms_per_second / interval);
+    iops->push_back(reads * ms_per_second / interval);
+  }
+}
+
 void ConnectorSize::Clear() {
   ts_.clear();
   sample_table_.clear();
+  io_sample_table_.clear();
   initial_nodes_data.clear();
 }
 
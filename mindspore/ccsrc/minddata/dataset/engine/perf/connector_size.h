@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_CONNECTOR_SIZE_H
 
 #include <string>
+#include <utility>
 #include <vector>
 #include <nlohmann/json.hpp>
 #include "minddata/dataset/engine/perf/profiling.h"
@@ -40,6 +41,10 @@ class ConnectorSize : public Sampling {
   // A circular buffer will be implemented in the future to make this table more flexible.
   using ConnectorSizeSample = std::vector<int>;
   using ConnectorSizeSampleTable = std::vector<ConnectorSizeSample>;
+  // The I/O counters (bytes read, number of reads) of each op are sampled along with the connector sizes,
+  // and turned into bytes/s and IOPS of the ops which read from storage when the data is saved.
+  using IoCounterSample = std::vector<std::pair<uint64_t, uint64_t>>;
+  using IoCounterSampleTable = std::vector<IoCounterSample>;
   using Timestamps = std::vector<uint64_t>;
 
  public:
@@ -68,6 +73,9 @@ class ConnectorSize : public Sampling {
   // Get the vector of connector sizes of given op for samples taken between start and end time
   Status GetOpConnectorSize(int32_t op_id, uint64_t start_time, uint64_t end_time, std::vector<int32_t> *result);
 
+  // Get the bytes/s and IOPS of the op at the given index, one value per sample
+  void GetOpIoRate(size_t idx, std::vector<uint64_t> *bytes_per_second, std::vector<uint64_t> *iops);
+
   // Clear all collected data
   void Clear() override;
 
@@ -78,6 +86,7 @@ class ConnectorSize : public Sampling {
   json initial_nodes_data;  // store data when execution tree is running. (all information for ops except sampled data)
   ExecutionTree *tree_ = nullptr;          // ExecutionTree pointer
   ConnectorSizeSampleTable sample_table_;  // Dataset structure to store all samples of connector size sampling
+  IoCounterSampleTable io_sample_table_;   // Dataset structure to store all samples of the I/O counters
   Timestamps ts_;                          // time of sample
 };
 
@@ -310,6 +310,7 @@ Serdes::InitializeFuncPtr() {
   }
 #endif
   ops_ptr[vision::kEqualizeOperation] = &(vision::EqualizeOperation::from_json);
+  ops_ptr[vision::kFusedPixelOperation] = &(vision::FusedPixelOperation::from_json);
   ops_ptr[vision::kGaussianBlurOperation] = &(vision::GaussianBlurOperation::from_json);
   ops_ptr[vision::kHorizontalFlipOperation] = &(vision::HorizontalFlipOperation::from_json);
   ops_ptr[vision::kHwcToChwOperation] = &(vision::HwcToChwOperation::from_json);
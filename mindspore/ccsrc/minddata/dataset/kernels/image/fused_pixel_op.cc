@@ -0,0 +1,186 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/fused_pixel_op.h"
+
+#include <cstring>
+#include <utility>
+
+#include "minddata/dataset/kernels/image/image_utils.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int32_t kLutSize = 256;  // number of values of an 8-bit channel
+
+template <typename T>
+void ApplyPixelLut(const uint8_t *src, const T *lut, int64_t num_pixels, int32_t num_channels, bool to_chw, T *dst) {
+  if (to_chw) {
+    for (int64_t p = 0; p < num_pixels; ++p) {
+      const uint8_t *pixel = src + p * num_channels;
+      for (int32_t c = 0; c < num_channels; ++c) {
+        dst[c * num_pixels + p] = lut[c * kLutSize + pixel[c]];
+      }
+    }
+  } else {
+    for (int64_t p = 0; p < num_pixels; ++p) {
+      const uint8_t *pixel = src + p * num_channels;
+      T *out = dst + p * num_channels;
+      for (int32_t c = 0; c < num_channels; ++c) {
+        out[c] = lut[c * kLutSize + pixel[c]];
+      }
+    }
+  }
+}
+}  // namespace
+
+FusedPixelOp::FusedPixelOp(const std::vector<std::shared_ptr<TensorOp>> &ops) : ops_(ops) {}
+
+Status FusedPixelOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  std::vector<TensorShape> in_shapes = inputs;
+  for (auto &op : ops_) {
+    RETURN_IF_NOT_OK(op->OutputShape(in_shapes, outputs));
+    in_shapes = std::move(outputs);  // outputs become empty after move
+  }
+  outputs = std::move(in_shapes);
+  return Status::OK();
+}
+
+Status FusedPixelOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  std::vector<DataType> in_types = inputs;
+  for (auto &op : ops_) {
+    RETURN_IF_NOT_OK(op->OutputType(in_types, outputs));
+    in_types = std::move(outputs);  // outputs become empty after move
+  }
+  outputs = std::move(in_types);
+  return Status::OK();
+}
+
+Status FusedPixelOp::ComputeSequential(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  std::shared_ptr<Tensor> in = input;
+  for (auto &op : ops_) {
+    RETURN_IF_NOT_OK(op->Compute(in, output));
+    in = std::move(*output);
+  }
+  *output = std::move(in);
+  return Status::OK();
+}
+
+Status FusedPixelOp::GenerateKernel(int32_t num_channels, PixelKernel *kernel) {
+  RETURN_UNEXPECTED_IF_NULL(kernel);
+  kernel->valid = false;
+  // an image of one row holding every value in every channel
+  std::shared_ptr<Tensor> probe;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape({1, kLutSize, num_channels}), DataType(DataType::DE_UINT8), &probe));
+  uint8_t *probe_data = probe->GetMutableBuffer();
+  for (int32_t v = 0; v < kLutSize; ++v) {
+    (void)memset(probe_data + v * num_channels, v, num_channels);
+  }
+  std::shared_ptr<Tensor> result;
+  Status rc = ComputeSequential(probe, &result);
+  if (rc.IsError()) {
+    // leave the error to the unfused ops, which report it for the real input
+    MS_LOG(INFO) << "FusedPixelOp: can not generate the kernel for " << num_channels << " channels, " << rc;
+    return Status::OK();
+  }
+  if (result->shape() == TensorShape({1, kLutSize, num_channels})) {
+    kernel->to_chw = false;
+  } else if (result->shape() == TensorShape({num_channels, 1, kLutSize})) {
+    kernel->to_chw = true;
+  } else {
+    MS_LOG(INFO) << "FusedPixelOp: unexpected output shape of the chain: " << result->shape();
+    return Status::OK();
+  }
+  dsize_t elem_size = result->type().SizeInBytes();
+  if (result->type().IsString() ||
+      (elem_size != sizeof(uint8_t) && elem_size != sizeof(uint16_t) && elem_size != sizeof(uint32_t) &&
+       elem_size != sizeof(uint64_t))) {
+    MS_LOG(INFO) << "FusedPixelOp: unsupported output type of the chain: " << result->type();
+    return Status::OK();
+  }
+  kernel->type = result->type();
+  kernel->lut.resize(static_cast<size_t>(num_channels * kLutSize * elem_size));
+  const uint8_t *result_data = result->GetBuffer();
+  for (int32_t c = 0; c < num_channels; ++c) {
+    for (int32_t v = 0; v < kLutSize; ++v) {
+      int64_t index = kernel->to_chw ? c * kLutSize + v : v * num_channels + c;
+      (void)memcpy(kernel->lut.data() + (c * kLutSize + v) * elem_size, result_data + index * elem_size, elem_size);
+    }
+  }
+  kernel->valid = true;
+  return Status::OK();
+}
+
+Status FusedPixelOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  if (input->type() != DataType::DE_UINT8 || input->Rank() != kDefaultImageRank) {
+    return ComputeSequential(input, output);
+  }
+  auto num_channels = static_cast<int32_t>(input->shape()[kChannelIndexHWC]);
+  if (num_channels == 0) {
+    return ComputeSequential(input, output);
+  }
+  const PixelKernel *kernel = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(kernel_mutex_);
+    auto it = kernels_.find(num_channels);
+    if (it == kernels_.end()) {
+      PixelKernel generated;
+      RETURN_IF_NOT_OK(GenerateKernel(num_channels, &generated));
+      it = kernels_.emplace(num_channels, std::move(generated)).first;
+    }
+    // entries of the map are never erased, the kernel stays valid out of the lock
+    kernel = &it->second;
+  }
+  if (!kernel->valid) {
+    return ComputeSequential(input, output);
+  }
+
+  dsize_t height = input->shape()[0];
+  dsize_t width = input->shape()[1];
+  TensorShape out_shape = kernel->to_chw ? TensorShape({num_channels, height, width}) : input->shape();
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(out_shape, kernel->type, output));
+  const uint8_t *src = input->GetBuffer();
+  uint8_t *dst = (*output)->GetMutableBuffer();
+  int64_t num_pixels = height * width;
+  switch (kernel->type.SizeInBytes()) {
+    case sizeof(uint8_t):
+      ApplyPixelLut<uint8_t>(src, kernel->lut.data(), num_pixels, num_channels, kernel->to_chw, dst);
+      break;
+    case sizeof(uint16_t):
+      ApplyPixelLut<uint16_t>(src, reinterpret_cast<const uint16_t *>(kernel->lut.data()), num_pixels, num_channels,
+                              kernel->to_chw, reinterpret_cast<uint16_t *>(dst));
+      break;
+    case sizeof(uint32_t):
+      ApplyPixelLut<uint32_t>(src, reinterpret_cast<const uint32_t *>(kernel->lut.data()), num_pixels, num_channels,
+                              kernel->to_chw, reinterpret_cast<uint32_t *>(dst));
+      break;
+    default:
+      ApplyPixelLut<uint64_t>(src, reinterpret_cast<const uint64_t *>(kernel->lut.data()), num_pixels, num_channels,
+                              kernel->to_chw, reinterpret_cast<uint64_t *>(dst));
+      break;
+  }
+  return Status::OK();
+}
+
+void FusedPixelOp::Print(std::ostream &out) const {
+  out << Name() << ":";
+  for (const auto &op : ops_) {
+    out << " " << op->Name();
+  }
+  out << std::endl;
+}
+}  // namespace dataset
+}  // namespace mindspore
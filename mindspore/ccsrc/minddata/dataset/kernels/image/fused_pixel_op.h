@@ -0,0 +1,86 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_PIXEL_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_PIXEL_OP_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Applies a chain of per-pixel ops (Rescale, Normalize, TypeCast, HWC2CHW, ToTensor) in one pass.
+///     The value of an output element only depends on the value and the channel of one input element, so for 8-bit
+///     HWC images the whole chain is generated once per channel count into a lookup table holding the output of every
+///     input value. The image is then converted with a single read of the input and a single write of the output,
+///     without the intermediate tensors of the unfused ops. Any other input runs the ops one after another.
+class FusedPixelOp : public TensorOp {
+ public:
+  /// constructor
+  /// \param[in] ops the chain of per-pixel TensorOps to fuse, at most one of them changes the layout
+  explicit FusedPixelOp(const std::vector<std::shared_ptr<TensorOp>> &ops);
+
+  /// default destructor
+  ~FusedPixelOp() override = default;
+
+  /// \param[in] inputs
+  /// \param[out] outputs
+  /// \return Status code
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  /// \param[in] inputs
+  /// \param[out] outputs
+  /// \return Status code
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+  /// \param[in] input
+  /// \param[out] output
+  /// \return Status code
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  void Print(std::ostream &out) const override;
+
+  std::string Name() const override { return kFusedPixelOp; }
+
+ private:
+  // the chain generated for one number of channels
+  struct PixelKernel {
+    bool valid = false;        // false if the chain can not be expressed as a lookup table for this input
+    bool to_chw = false;       // the output is planar
+    DataType type;             // type of the output
+    std::vector<uint8_t> lut;  // [channel][input value] -> output element
+  };
+
+  /// \brief run the ops one after another
+  Status ComputeSequential(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+
+  /// \brief generate the lookup table by running the chain on an image holding every value in every channel
+  Status GenerateKernel(int32_t num_channels, PixelKernel *kernel);
+
+  std::vector<std::shared_ptr<TensorOp>> ops_;
+  std::mutex kernel_mutex_;
+  std::map<int32_t, PixelKernel> kernels_;  // number of channels -> generated kernel
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_PIXEL_OP_H_
@@ -17,6 +17,7 @@
 #include <opencv2/imgproc/types_c.h>
 #include <algorithm>
 #include <fstream>
+#include <functional>
 #include <limits>
 #include <string>
 #include <vector>
@@ -437,7 +438,11 @@ static Status JpegReadScanlines(jpeg_decompress_struct *const cinfo, int max_sca
   CHECK_FAIL_RETURN_UNEXPECTED((std::numeric_limits<int64_t>::max() / cinfo->output_components) > crop_w_aligned,
                                "JpegReadScanlines: multiplication out of bounds.");
   int64_t scanline_size = crop_w_aligned * cinfo->output_components;
-  std::vector<JSAMPLE> scanline(scanline_size);
+  // the scanline buffer is kept by the thread and reused by the following images
+  thread_local std::vector<JSAMPLE> scanline;
+  if (scanline.size() < static_cast<size_t>(scanline_size)) {
+    scanline.resize(scanline_size);
+  }
   JSAMPLE *scanline_ptr = &scanline[0];
   while (cinfo->output_scanline < static_cast<unsigned int>(max_scanlines_to_read)) {
     int num_lines_read = 0;
@@ -514,8 +519,13 @@ void JpegErrorExitCustom(j_common_ptr cinfo) {
     STATUS_ERROR(StatusCode::kMDUnexpectedError, "Error raised by libjpeg: " + std::string(jpeg_error_msg)));
 }
 
-Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x, int crop_y,
-                         int crop_w, int crop_h) {
+// Allocates the buffer which a crop of the given height and width with 3 components is decoded into
+using JpegBufferAllocator = std::function<Status(int32_t height, int32_t width, JSAMPLE **buffer)>;
+
+// Decodes the crop box of a JPEG image at the scale 1/scale_denom. The crop box is given in the coordinates of the full
+// resolution image, and is mapped to the smallest box of the scaled image which covers it.
+static Status JpegCropAndDecodeScaled(const std::shared_ptr<Tensor> &input, int crop_x, int crop_y, int crop_w,
+                                      int crop_h, int scale_denom, const JpegBufferAllocator &allocate) {
   struct jpeg_decompress_struct cinfo;
   auto DestroyDecompressAndReturnError = [&cinfo](const std::string &err) {
     jpeg_destroy_decompress(&cinfo);
@@ -529,6 +539,8 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
     JpegSetSource(&cinfo, input->GetBuffer(), input->SizeInBytes());
     (void)jpeg_read_header(&cinfo, TRUE);
     RETURN_IF_NOT_OK(JpegSetColorSpace(&cinfo));
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = static_cast<unsigned int>(scale_denom);
     jpeg_calc_output_dimensions(&cinfo);
     RETURN_IF_NOT_OK(CheckJpegExit(&cinfo));
   } catch (std::runtime_error &e) {
@@ -541,15 +553,23 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
                                "JpegCropAndDecode: addition(crop y and crop height) out of bounds, got crop y:" +
                                  std::to_string(crop_y) + ", and crop height:" + std::to_string(crop_h));
   if (crop_x == 0 && crop_y == 0 && crop_w == 0 && crop_h == 0) {
-    crop_w = cinfo.output_width;
-    crop_h = cinfo.output_height;
-  } else if (crop_w == 0 || static_cast<unsigned int>(crop_w + crop_x) > cinfo.output_width || crop_h == 0 ||
-             static_cast<unsigned int>(crop_h + crop_y) > cinfo.output_height) {
+    crop_w = cinfo.image_width;
+    crop_h = cinfo.image_height;
+  } else if (crop_w == 0 || static_cast<unsigned int>(crop_w + crop_x) > cinfo.image_width || crop_h == 0 ||
+             static_cast<unsigned int>(crop_h + crop_y) > cinfo.image_height) {
     return DestroyDecompressAndReturnError(
       "Crop: invalid crop size, corresponding crop value equal to 0 or too big, got crop width: " +
       std::to_string(crop_w) + ", crop height:" + std::to_string(crop_h) +
       ", and crop x coordinate:" + std::to_string(crop_x) + ", crop y coordinate:" + std::to_string(crop_y));
   }
+  if (scale_denom > 1) {
+    int crop_end_x = std::min(static_cast<int>(cinfo.output_width), (crop_x + crop_w + scale_denom - 1) / scale_denom);
+    int crop_end_y = std::min(static_cast<int>(cinfo.output_height), (crop_y + crop_h + scale_denom - 1) / scale_denom);
+    crop_x /= scale_denom;
+    crop_y /= scale_denom;
+    crop_w = crop_end_x - crop_x;
+    crop_h = crop_end_y - crop_y;
+  }
   const int mcu_size = cinfo.min_DCT_scaled_size;
   CHECK_FAIL_RETURN_UNEXPECTED(mcu_size != 0, "JpegCropAndDecode: divisor mcu_size is zero.");
   unsigned int crop_x_aligned = (crop_x / mcu_size) * mcu_size;
@@ -566,18 +586,22 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
   JDIMENSION skipped_scanlines = jpeg_skip_scanlines(&cinfo, crop_y);
   // three number of output components, always convert to RGB and output
   constexpr int kOutNumComponents = 3;
-  TensorShape ts = TensorShape({crop_h, crop_w, kOutNumComponents});
-  std::shared_ptr<Tensor> output_tensor;
-  RETURN_IF_NOT_OK(Tensor::CreateEmpty(ts, DataType(DataType::DE_UINT8), &output_tensor));
-  const int buffer_size = output_tensor->SizeInBytes();
-  JSAMPLE *buffer = reinterpret_cast<JSAMPLE *>(&(*output_tensor->begin<uint8_t>()));
-  CHECK_FAIL_RETURN_UNEXPECTED((std::numeric_limits<float_t>::max() - skipped_scanlines) > crop_h,
-                               "JpegCropAndDecode: addition out of bounds.");
-  const int max_scanlines_to_read = skipped_scanlines + crop_h;
-  // stride refers to output tensor, which has 3 components at most
+  JSAMPLE *buffer = nullptr;
+  Status rc = allocate(crop_h, crop_w, &buffer);
+  if (rc.IsError()) {
+    jpeg_destroy_decompress(&cinfo);
+    return rc;
+  }
   CHECK_FAIL_RETURN_UNEXPECTED((std::numeric_limits<int32_t>::max() / crop_w) > kOutNumComponents,
                                "JpegCropAndDecode: multiplication out of bounds.");
+  // stride refers to output tensor, which has 3 components at most
   const int stride = crop_w * kOutNumComponents;
+  CHECK_FAIL_RETURN_UNEXPECTED((std::numeric_limits<int32_t>::max() / stride) > crop_h,
+                               "JpegCropAndDecode: multiplication out of bounds.");
+  const int buffer_size = stride * crop_h;
+  CHECK_FAIL_RETURN_UNEXPECTED((std::numeric_limits<float_t>::max() - skipped_scanlines) > crop_h,
+                               "JpegCropAndDecode: addition out of bounds.");
+  const int max_scanlines_to_read = skipped_scanlines + crop_h;
   // offset is calculated for scanlines read from the image, therefore
   // has the same number of components as the image
   int minius_value = crop_x - crop_x_aligned;
@@ -586,11 +610,77 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
   const int offset = minius_value * cinfo.output_components;
   RETURN_IF_NOT_OK(
     JpegReadScanlines(&cinfo, max_scanlines_to_read, buffer, buffer_size, crop_w, crop_w_aligned, offset, stride));
-  *output = output_tensor;
   jpeg_destroy_decompress(&cinfo);
   return Status::OK();
 }
 
+Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x, int crop_y,
+                         int crop_w, int crop_h) {
+  std::shared_ptr<Tensor> output_tensor;
+  auto allocate = [&output_tensor](int32_t height, int32_t width, JSAMPLE **buffer) {
+    TensorShape ts = TensorShape({height, width, kDefaultImageChannel});
+    RETURN_IF_NOT_OK(Tensor::CreateEmpty(ts, DataType(DataType::DE_UINT8), &output_tensor));
+    *buffer = reinterpret_cast<JSAMPLE *>(&(*output_tensor->begin<uint8_t>()));
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(JpegCropAndDecodeScaled(input, crop_x, crop_y, crop_w, crop_h, 1, allocate));
+  *output = output_tensor;
+  return Status::OK();
+}
+
+Status JpegCropDecodeResize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x,
+                            int crop_y, int crop_w, int crop_h, int32_t target_height, int32_t target_width,
+                            InterpolationMode mode, bool scaled_decode) {
+  RETURN_UNEXPECTED_IF_NULL(output);
+  // libjpeg scales the DCT blocks down by 1/2, 1/4 or 1/8 while decoding, pick the largest scale which still leaves
+  // at least target_height x target_width pixels in the crop box, so that the resize below only shrinks the image.
+  // PILCUBIC is expected to match PIL on the full image, so it is never decoded at a reduced scale.
+  constexpr int kMaxJpegScaleDenom = 8;
+  int scale_denom = 1;
+  if (scaled_decode && mode != InterpolationMode::kCubicPil) {
+    for (int denom = kMaxJpegScaleDenom; denom > 1; denom /= DOUBLING_FACTOR) {
+      if (crop_w / denom >= target_width && crop_h / denom >= target_height) {
+        scale_denom = denom;
+        break;
+      }
+    }
+  }
+  if (scale_denom == 1) {
+    std::shared_ptr<Tensor> decoded;
+    RETURN_IF_NOT_OK(JpegCropAndDecode(input, &decoded, crop_x, crop_y, crop_w, crop_h));
+    return Resize(decoded, output, target_height, target_width, 0.0, 0.0, mode);
+  }
+
+  // the decoded crop is only used as the input of the resize, so it is kept in a buffer reused by the thread
+  thread_local std::vector<JSAMPLE> crop_buffer;
+  int32_t decoded_height = 0;
+  int32_t decoded_width = 0;
+  auto allocate = [&decoded_height, &decoded_width](int32_t height, int32_t width, JSAMPLE **buffer) {
+    size_t buffer_size = static_cast<size_t>(height) * static_cast<size_t>(width) * kDefaultImageChannel;
+    if (crop_buffer.size() < buffer_size) {
+      crop_buffer.resize(buffer_size);
+    }
+    decoded_height = height;
+    decoded_width = width;
+    *buffer = crop_buffer.data();
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(JpegCropAndDecodeScaled(input, crop_x, crop_y, crop_w, crop_h, scale_denom, allocate));
+
+  std::shared_ptr<CVTensor> output_cv;
+  RETURN_IF_NOT_OK(CVTensor::CreateEmpty(TensorShape({target_height, target_width, kDefaultImageChannel}),
+                                         DataType(DataType::DE_UINT8), &output_cv));
+  try {
+    cv::Mat decoded_image(decoded_height, decoded_width, CV_8UC3, crop_buffer.data());
+    cv::resize(decoded_image, output_cv->mat(), cv::Size(target_width, target_height), 0.0, 0.0,
+               GetCVInterpolationMode(mode));
+  } catch (const cv::Exception &e) {
+    RETURN_STATUS_UNEXPECTED("RandomCropDecodeResize: " + std::string(e.what()));
+  }
+  *output = std::static_pointer_cast<Tensor>(output_cv);
+  return Status::OK();
+}
+
 Status Rescale(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, float rescale, float shift) {
   std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
   if (!input_cv->mat().data) {
@@ -164,6 +164,20 @@ void JpegSetSource(j_decompress_ptr c_info, const void *data, int64_t data_size)
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x = 0, int y = 0,
                          int w = 0, int h = 0);
 
+/// \brief Decode the crop box of a JPEG image and resize it to the target size.
+///     With scaled_decode, the image is decoded at the largest DCT down-scale (1/2, 1/4 or 1/8) which keeps the crop
+///     box at least as large as the target, straight into a per-thread buffer, and then resized into the output tensor.
+///     Otherwise, and for PILCUBIC, the output is the same as JpegCropAndDecode followed by Resize.
+/// \param input: Tensor containing the not decoded JPEG image 1D bytes
+/// \param output: Resized image Tensor of shape <target_height,target_width,3> and type DE_UINT8
+/// \param x, y, w, h: The crop box in the coordinates of the full resolution image
+/// \param target_height, target_width: The size to resize the crop to
+/// \param mode: Interpolation mode of the resize
+/// \param scaled_decode: Whether to decode at a reduced DCT scale, which filters the image slightly differently
+Status JpegCropDecodeResize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x, int y, int w,
+                            int h, int32_t target_height, int32_t target_width, InterpolationMode mode,
+                            bool scaled_decode = false);
+
 /// \brief Returns Rescaled image
 /// \param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
 /// \param rescale: rescale parameter
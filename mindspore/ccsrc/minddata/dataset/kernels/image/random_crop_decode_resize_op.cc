@@ -17,6 +17,7 @@
 #include <random>
 #include "minddata/dataset/kernels/image/image_utils.h"
 #include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/kernels/image/decode_op.h"
 
 namespace mindspore {
@@ -52,9 +53,9 @@ Status RandomCropDecodeResizeOp::Compute(const TensorRow &input, TensorRow *outp
       if (i == 0) {
         RETURN_IF_NOT_OK(GetCropBox(h_in, w_in, &x, &y, &crop_height, &crop_width));
       }
-      std::shared_ptr<Tensor> decoded_tensor = nullptr;
-      RETURN_IF_NOT_OK(JpegCropAndDecode(input[i], &decoded_tensor, x, y, crop_width, crop_height));
-      RETURN_IF_NOT_OK(Resize(decoded_tensor, &(*output)[i], target_height_, target_width_, 0.0, 0.0, interpolation_));
+      RETURN_IF_NOT_OK(JpegCropDecodeResize(input[i], &(*output)[i], x, y, crop_width, crop_height, target_height_,
+                                            target_width_, interpolation_,
+                                            GlobalContext::config_manager()->jpeg_scaled_decode()));
     }
   }
   return Status::OK();
@@ -0,0 +1,79 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/ir/vision/fused_pixel_ir.h"
+
+#include <algorithm>
+
+#ifndef ENABLE_ANDROID
+#include "minddata/dataset/engine/serdes.h"
+#include "minddata/dataset/kernels/image/fused_pixel_op.h"
+#endif
+
+#include "minddata/dataset/kernels/ir/validators.h"
+#include "minddata/dataset/util/validators.h"
+
+namespace mindspore {
+namespace dataset {
+namespace vision {
+#ifndef ENABLE_ANDROID
+// FusedPixelOperation
+FusedPixelOperation::FusedPixelOperation(const std::vector<std::shared_ptr<TensorOperation>> &transforms)
+    : transforms_(transforms) {}
+
+FusedPixelOperation::~FusedPixelOperation() = default;
+
+std::string FusedPixelOperation::Name() const { return kFusedPixelOperation; }
+
+Status FusedPixelOperation::ValidateParams() {
+  RETURN_IF_NOT_OK(ValidateVectorTransforms("FusedPixel", transforms_));
+  return Status::OK();
+}
+
+std::shared_ptr<TensorOp> FusedPixelOperation::Build() {
+  std::vector<std::shared_ptr<TensorOp>> tensor_ops;
+  (void)std::transform(
+    transforms_.begin(), transforms_.end(), std::back_inserter(tensor_ops),
+    [](const std::shared_ptr<TensorOperation> &op) -> std::shared_ptr<TensorOp> { return op->Build(); });
+  return std::make_shared<FusedPixelOp>(tensor_ops);
+}
+
+Status FusedPixelOperation::to_json(nlohmann::json *out_json) {
+  CHECK_FAIL_RETURN_UNEXPECTED(out_json != nullptr, "parameter out_json is nullptr");
+  nlohmann::json args;
+  std::vector<nlohmann::json> transforms;
+  for (auto op : transforms_) {
+    nlohmann::json op_item, op_args;
+    RETURN_IF_NOT_OK(op->to_json(&op_args));
+    op_item["tensor_op_params"] = op_args;
+    op_item["tensor_op_name"] = op->Name();
+    transforms.push_back(op_item);
+  }
+  args["transforms"] = transforms;
+  *out_json = args;
+  return Status::OK();
+}
+
+Status FusedPixelOperation::from_json(nlohmann::json op_params, std::shared_ptr<TensorOperation> *operation) {
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "transforms", kFusedPixelOperation));
+  std::vector<std::shared_ptr<TensorOperation>> transforms;
+  RETURN_IF_NOT_OK(Serdes::ConstructTensorOps(op_params["transforms"], &transforms));
+  *operation = std::make_shared<vision::FusedPixelOperation>(transforms);
+  return Status::OK();
+}
+#endif
+}  // namespace vision
+}  // namespace dataset
+}  // namespace mindspore
@@ -236,7 +236,8 @@ class Queue {
 
 // A container of queues with [] operator accessors.  Basically this is a wrapper over of a vector of queues
 // to help abstract/simplify code that is maintaining multiple queues.
-template <typename T>
+// The queue type Q can be replaced by any queue offering the same interface as Queue, e.g. SpscQueue.
+template <typename T, typename Q = Queue<T>>
 class QueueList {
  public:
   QueueList() {}
@@ -244,7 +245,7 @@ class QueueList {
   void Init(int num_queues, int capacity) {
     (void)queue_list_.reserve(num_queues);
     for (int i = 0; i < num_queues; i++) {
-      (void)queue_list_.emplace_back(std::make_unique<Queue<T>>(capacity));
+      (void)queue_list_.emplace_back(std::make_unique<Q>(capacity));
     }
   }
 
@@ -260,14 +261,14 @@ class QueueList {
 
   auto size() const { return queue_list_.size(); }
 
-  std::unique_ptr<Queue<T>> &operator[](const int index) { return queue_list_[index]; }
+  std::unique_ptr<Q> &operator[](const int index) { return queue_list_[index]; }
 
-  const std::unique_ptr<Queue<T>> &operator[](const int index) const { return queue_list_[index]; }
+  const std::unique_ptr<Q> &operator[](const int index) const { return queue_list_[index]; }
 
   ~QueueList() = default;
 
   Status AddQueue(TaskGroup *vg) {
-    (void)queue_list_.emplace_back(std::make_unique<Queue<T>>(queue_list_[0]->capacity()));
+    (void)queue_list_.emplace_back(std::make_unique<Q>(queue_list_[0]->capacity()));
     return queue_list_[queue_list_.size() - 1]->Register(vg);
   }
   Status RemoveLastQueue() {
@@ -280,7 +281,7 @@ class QueueList {
   // Queue contains non-copyable objects, so it cannot be added to a vector due to the vector
   // requirement that objects must have copy semantics.  To resolve this, we use a vector of unique
   // pointers.  This allows us to provide dynamic creation of queues in a container.
-  std::vector<std::unique_ptr<Queue<T>>> queue_list_;
+  std::vector<std::unique_ptr<Q>> queue_list_;
 };
 }  // namespace dataset
 }  // namespace mindspore
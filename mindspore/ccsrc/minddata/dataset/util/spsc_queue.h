@@ -0,0 +1,228 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_SPSC_QUEUE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_SPSC_QUEUE_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/services.h"
+#include "minddata/dataset/util/cond_var.h"
+#include "minddata/dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+// A parking spot used by the blocked side of SpscQueue. The waiter spins on the condition first, then yields, and
+// only parks on the CondVar when the other side is really slow. Several queues may share the waiter of their common
+// consumer, so that one thread can wait for any of them.
+class SpscWaiter {
+ public:
+  SpscWaiter() = default;
+
+  ~SpscWaiter() = default;
+
+  Status Wait(const std::function<bool()> &pred) {
+    constexpr int32_t kSpinCount = 256;
+    constexpr int32_t kYieldCount = 16;
+    for (int32_t i = 0; i < kSpinCount; ++i) {
+      if (pred()) {
+        return Status::OK();
+      }
+    }
+    for (int32_t i = 0; i < kYieldCount; ++i) {
+      if (pred()) {
+        return Status::OK();
+      }
+      std::this_thread::yield();
+    }
+    std::unique_lock<std::mutex> lock(mux_);
+    // seq_cst pairs with Notify(): either the notifier sees us parked, or pred() sees its update.
+    (void)num_parked_.fetch_add(1, std::memory_order_seq_cst);
+    Status rc = cv_.Wait(&lock, pred);
+    (void)num_parked_.fetch_sub(1, std::memory_order_relaxed);
+    return rc;
+  }
+
+  // Wake up the parked side, the update it waits for must have been published with seq_cst.
+  // It is cheap when nobody is parked, which is the common case.
+  void Notify() noexcept {
+    if (num_parked_.load(std::memory_order_seq_cst) > 0) {
+      std::lock_guard<std::mutex> lock(mux_);
+      cv_.NotifyAll();
+    }
+  }
+
+  void Interrupt() { cv_.Interrupt(); }
+
+  void ResetIntrpState() { cv_.ResetIntrpState(); }
+
+  Status Register(const std::shared_ptr<IntrpService> &svc) {
+    std::lock_guard<std::mutex> lock(mux_);
+    if (registered_) {
+      return Status::OK();
+    }
+    RETURN_IF_NOT_OK(cv_.Register(svc));
+    registered_ = true;
+    return Status::OK();
+  }
+
+ private:
+  std::mutex mux_;
+  CondVar cv_;
+  std::atomic<int32_t> num_parked_{0};
+  bool registered_{false};
+};
+
+// A bounded lock-free queue for exactly one producer thread and one consumer thread, e.g. the edges between the
+// master thread of a ParallelOp and its workers. It offers the same interface as Queue, so QueueList can hold it.
+template <typename T>
+class SpscQueue {
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using reference = T &;
+  using const_reference = const T &;
+
+  explicit SpscQueue(int sz)
+      : sz_(sz > 0 ? static_cast<size_t>(sz) : 1),
+        arr_(sz_),
+        producer_waiter_(std::make_shared<SpscWaiter>()),
+        consumer_waiter_(std::make_shared<SpscWaiter>()),
+        my_name_(Services::GetUniqueID()) {
+    MS_LOG(DEBUG) << "Create SPSC Q with uuid " << my_name_ << " of size " << sz_ << ".";
+  }
+
+  virtual ~SpscQueue() = default;
+
+  size_t size() const {
+    // seq_cst since size() and empty() may serve as the wake-up condition of a shared waiter
+    size_t tail = tail_.load(std::memory_order_seq_cst);
+    size_t head = head_.load(std::memory_order_seq_cst);
+    return tail >= head ? tail - head : 0;
+  }
+
+  size_t capacity() const { return sz_; }
+
+  bool empty() const { return size() == 0; }
+
+  // Not thread safe, both sides must be quiet.
+  void Reset() {
+    size_t tail = tail_.load(std::memory_order_acquire);
+    for (size_t head = head_.load(std::memory_order_acquire); head < tail; ++head) {
+      arr_[head % sz_] = T();
+    }
+    head_.store(0, std::memory_order_release);
+    tail_.store(0, std::memory_order_release);
+    cached_head_ = 0;
+    cached_tail_ = 0;
+    producer_waiter_->ResetIntrpState();
+    consumer_waiter_->ResetIntrpState();
+  }
+
+  // Producer
+  Status Add(const_reference ele) noexcept { return EmplaceBack(ele); }
+
+  Status Add(T &&ele) noexcept { return EmplaceBack(std::forward<T>(ele)); }
+
+  template <typename... Ts>
+  Status EmplaceBack(Ts &&... args) noexcept {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cached_head_ >= sz_) {
+      // Block when full
+      Status rc = producer_waiter_->Wait([this, tail]() -> bool {
+        cached_head_ = head_.load(std::memory_order_seq_cst);
+        return tail - cached_head_ < sz_;
+      });
+      if (rc.IsError()) {
+        consumer_waiter_->Interrupt();
+        return rc;
+      }
+    }
+    arr_[tail % sz_] = T(std::forward<Ts>(args)...);
+    tail_.store(tail + 1, std::memory_order_seq_cst);
+    consumer_waiter_->Notify();
+    return Status::OK();
+  }
+
+  // Consumer
+  Status PopFront(pointer p) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == cached_tail_) {
+      // Block when empty
+      Status rc = consumer_waiter_->Wait([this, head]() -> bool {
+        cached_tail_ = tail_.load(std::memory_order_seq_cst);
+        return head != cached_tail_;
+      });
+      if (rc.IsError()) {
+        producer_waiter_->Interrupt();
+        return rc;
+      }
+    }
+    PopFrontInternal(head, p);
+    return Status::OK();
+  }
+
+  // Consumer, returns false immediately instead of blocking when the queue is empty.
+  bool TryPopFront(pointer p) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == cached_tail_) {
+      cached_tail_ = tail_.load(std::memory_order_seq_cst);
+      if (head == cached_tail_) {
+        return false;
+      }
+    }
+    PopFrontInternal(head, p);
+    return true;
+  }
+
+  // Let this queue park its consumer on the given waiter, which may be shared with other queues of the same consumer.
+  void SetConsumerWaiter(std::shared_ptr<SpscWaiter> waiter) { consumer_waiter_ = std::move(waiter); }
+
+  Status Register(TaskGroup *vg) {
+    RETURN_IF_NOT_OK(producer_waiter_->Register(vg->GetIntrpService()));
+    return consumer_waiter_->Register(vg->GetIntrpService());
+  }
+
+ private:
+  void PopFrontInternal(size_t head, pointer p) {
+    *p = std::move(arr_[head % sz_]);
+    head_.store(head + 1, std::memory_order_seq_cst);
+    producer_waiter_->Notify();
+  }
+
+  size_t sz_;
+  std::vector<T> arr_;
+  // head_ is only written by the consumer and tail_ only by the producer. Keep them on separate cache lines together
+  // with the copy of the other index that each side caches to avoid touching the shared line on every operation.
+  alignas(64) std::atomic<size_t> head_{0};
+  size_t cached_tail_{0};
+  alignas(64) std::atomic<size_t> tail_{0};
+  size_t cached_head_{0};
+  alignas(64) std::shared_ptr<SpscWaiter> producer_waiter_;
+  std::shared_ptr<SpscWaiter> consumer_waiter_;
+  std::string my_name_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_SPSC_QUEUE_H_
@@ -0,0 +1,133 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_IO_ENGINE_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_IO_ENGINE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "minddata/mindrecord/include/common/log_adapter.h"
+#include "minddata/mindrecord/include/mindrecord_macro.h"
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+const uint64_t kIoCoalesceGap = 64 * 1024;            // largest hole between two blobs read in one request
+const uint64_t kIoMaxReadSize = 4 * 1024 * 1024;      // largest single coalesced read
+const uint64_t kIoPrefetchBudget = 256 * 1024 * 1024;  // upper bound of the bytes held by prefetched extents
+
+/// \brief Reads byte ranges of the mindrecord files with a pool of I/O threads.
+///     Ranges which are known ahead of time are handed to Prefetch(), which merges the ranges that are adjacent in a
+///     file into one request and reads them asynchronously at the configured depth. Read() is then served from the
+///     prefetched extent, or issues a direct positional read when the range was not prefetched.
+class MINDRECORD_API ShardIoEngine {
+ public:
+  struct ReadRequest {
+    int shard_id;
+    uint64_t offset;
+    uint64_t length;
+  };
+
+  /// \brief constructor
+  /// \param[in] io_depth number of reads in flight at the same time
+  explicit ShardIoEngine(int32_t io_depth);
+
+  ~ShardIoEngine();
+
+  /// \brief open one read-only handle per file and start the I/O threads
+  /// \param[in] file_paths the mindrecord files, indexed by shard id
+  /// \return Status the status code
+  Status Open(const std::vector<std::string> &file_paths);
+
+  /// \brief stop the I/O threads and close the files
+  void Close();
+
+  /// \brief queue the given ranges for asynchronous reading, ranges close to each other are read together
+  /// \param[in] requests the ranges in the order they are going to be consumed
+  void Prefetch(const std::vector<ReadRequest> &requests);
+
+  /// \brief read one range, waiting for its prefetched extent when there is one
+  /// \param[in] shard_id the shard to read from
+  /// \param[in] offset the offset in the file
+  /// \param[in] length the number of bytes to read
+  /// \param[out] data the bytes read
+  /// \return Status the status code
+  Status Read(int shard_id, uint64_t offset, uint64_t length, std::vector<uint8_t> *data);
+
+  /// \brief drop all prefetched extents, used when the read order changes
+  void Clear();
+
+  /// \brief get the accumulated counters of the reads issued to the files
+  /// \param[out] bytes_read number of bytes read
+  /// \param[out] num_reads number of read requests
+  void GetCounters(uint64_t *bytes_read, uint64_t *num_reads) const;
+
+ private:
+  struct Extent {
+    int shard_id;
+    uint64_t offset;
+    uint64_t length;
+    std::vector<uint8_t> data;
+    int32_t num_users = 0;  // number of prefetched ranges which are not consumed yet
+    bool in_table = true;   // still reachable from the lookup table
+    bool done = false;
+    bool failed = false;
+  };
+
+  /// \brief loop of an I/O thread, reads the queued extents
+  void IoWorker();
+
+  /// \brief positional read of the whole range, retried on short reads
+  Status ReadAt(int shard_id, uint64_t offset, uint64_t length, uint8_t *data);
+
+  /// \brief find the extent covering the range, nullptr if not prefetched
+  std::shared_ptr<Extent> FindExtent(int shard_id, uint64_t offset, uint64_t length);
+
+  /// \brief remove an extent from the lookup table
+  void EraseExtent(const std::shared_ptr<Extent> &extent);
+
+  /// \brief drop the oldest completed extents until the new bytes fit into the budget
+  void EvictLocked(uint64_t incoming_bytes);
+
+  int32_t io_depth_;
+  std::vector<int> fds_;  // one handle per shard, positional reads are thread safe
+  std::vector<std::thread> io_threads_;
+
+  std::mutex mtx_;
+  std::condition_variable cv_submit_;
+  std::condition_variable cv_done_;
+  bool stop_ = false;
+  std::deque<std::shared_ptr<Extent>> submit_queue_;  // extents waiting for an I/O thread
+  std::deque<std::shared_ptr<Extent>> extent_fifo_;   // extents in the order of submission, used for eviction
+  std::vector<std::map<uint64_t, std::shared_ptr<Extent>>> extents_;  // per shard: start offset -> extent
+  uint64_t cached_bytes_ = 0;
+
+  std::atomic<uint64_t> bytes_read_{0};
+  std::atomic<uint64_t> num_reads_{0};
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_IO_ENGINE_H_
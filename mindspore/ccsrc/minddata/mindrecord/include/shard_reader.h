@@ -47,6 +47,7 @@
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
+#include "minddata/mindrecord/include/shard_io_engine.h"
 #include "minddata/mindrecord/include/shard_operator.h"
 #include "minddata/mindrecord/include/shard_pk_sample.h"
 #include "minddata/mindrecord/include/shard_reader.h"
@@ -58,7 +59,8 @@ namespace mindrecord {
 using ROW_GROUPS = std::pair<std::vector<std::vector<std::vector<uint64_t>>>, std::vector<std::vector<json>>>;
 using ROW_GROUP_BRIEF = std::tuple<std::string, int, uint64_t, std::vector<std::vector<uint64_t>>, std::vector<json>>;
 using TASK_CONTENT = std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>;
-const int kNumBatchInMap = 1000;  // iterator buffer size in row-reader mode
+const int kNumBatchInMap = 1000;        // iterator buffer size in row-reader mode
+const int kPrefetchRowsPerDepth = 64;  // rows prefetched ahead of the consumers for each read in flight
 
 class MINDRECORD_API ShardReader {
  public:
@@ -98,6 +100,17 @@ class MINDRECORD_API ShardReader {
   /// \return MSRStatus the status of MSRStatus
   Status ShrinkRandomFileStreams(const int n_remove_consumers);
 
+  /// \brief read the blobs through an asynchronous engine which coalesces adjacent reads and prefetches the blobs
+  ///     of the upcoming samples, must be called after Open()
+  /// \param[in] io_depth number of reads in flight at the same time
+  /// \return MSRStatus the status of MSRStatus
+  Status EnableIoEngine(int32_t io_depth);
+
+  /// \brief get the accumulated counters of the blob reads
+  /// \param[out] bytes_read number of bytes read from the files
+  /// \param[out] num_reads number of read requests issued to the files
+  void GetIoCounters(uint64_t *bytes_read, uint64_t *num_reads) const;
+
   /// \brief launch threads to get batches
   /// \param[in] is_simple_reader trigger threads if false; do nothing if true
   /// \return MSRStatus the status of MSRStatus
@@ -279,6 +292,12 @@ class MINDRECORD_API ShardReader {
   /// \brief open multiple file handle
   void FileStreamsOperator();
 
+  /// \brief hand the blobs of the samples ahead of the consumers to the read engine
+  void PrefetchBlobs();
+
+  /// \brief restart prefetching from the first sample, used when the sample order changes
+  void ResetPrefetch();
+
   /// \brief read one row by one task
   Status ConsumerOneTask(int64_t task_id, uint32_t consumer_id, std::shared_ptr<TASK_CONTENT> *task_content_pt);
 
@@ -338,6 +357,16 @@ class MINDRECORD_API ShardReader {
   std::unordered_map<int, std::shared_ptr<std::vector<std::tuple<std::vector<uint8_t>, json>>>> delivery_map_;
   // Delivery/Iterator mode end
 
+  // Asynchronous blob reading begin
+  std::unique_ptr<ShardIoEngine> io_engine_;   // read engine, nullptr when the file streams are used
+  int32_t io_depth_ = 0;                       // number of reads in flight of the read engine
+  std::mutex prefetch_mtx_;                    // locker for submitting prefetch requests
+  int64_t prefetch_position_ = 0;              // index into the sample ids vector of the next sample to prefetch
+  std::atomic<int64_t> num_consumed_{0};       // number of samples read in the current epoch
+  std::atomic<uint64_t> io_bytes_read_{0};     // number of bytes read by the file streams
+  std::atomic<uint64_t> io_num_reads_{0};      // number of reads issued by the file streams
+  // Asynchronous blob reading end
+
   // all metadata in the index is not loaded during initialization
   bool lazy_load_;
 
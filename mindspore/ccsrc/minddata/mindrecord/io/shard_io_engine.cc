@@ -0,0 +1,298 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_io_engine.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace mindspore {
+namespace mindrecord {
+ShardIoEngine::ShardIoEngine(int32_t io_depth) : io_depth_(std::max(io_depth, 1)) {}
+
+ShardIoEngine::~ShardIoEngine() { Close(); }
+
+Status ShardIoEngine::Open(const std::vector<std::string> &file_paths) {
+#if defined(_WIN32) || defined(_WIN64)
+  RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] The asynchronous read engine is not supported on Windows.");
+#else
+  for (const auto &file : file_paths) {
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+      Close();
+      RETURN_STATUS_UNEXPECTED_MR(
+        "Invalid file, failed to open files for reading mindrecord files. Please check file path, permission and "
+        "open files limit(ulimit -a): " +
+        file);
+    }
+#ifdef POSIX_FADV_RANDOM
+    // the read-ahead of the kernel is replaced by the prefetching done here
+    (void)posix_fadvise(fd, 0, 0, POSIX_FADV_RANDOM);
+#endif
+    fds_.push_back(fd);
+  }
+  extents_.resize(fds_.size());
+  stop_ = false;
+  for (int32_t i = 0; i < io_depth_; ++i) {
+    io_threads_.emplace_back(&ShardIoEngine::IoWorker, this);
+  }
+  MS_LOG(INFO) << "Succeed to start the read engine of " << fds_.size() << " files with depth " << io_depth_ << ".";
+  return Status::OK();
+#endif
+}
+
+void ShardIoEngine::Close() {
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    stop_ = true;
+  }
+  cv_submit_.notify_all();
+  cv_done_.notify_all();
+  for (auto &io_thread : io_threads_) {
+    if (io_thread.joinable()) {
+      io_thread.join();
+    }
+  }
+  io_threads_.clear();
+  Clear();
+#if !defined(_WIN32) && !defined(_WIN64)
+  for (auto fd : fds_) {
+    (void)close(fd);
+  }
+#endif
+  fds_.clear();
+}
+
+void ShardIoEngine::IoWorker() {
+  for (;;) {
+    std::shared_ptr<Extent> extent;
+    {
+      std::unique_lock<std::mutex> lck(mtx_);
+      cv_submit_.wait(lck, [this] { return stop_ || !submit_queue_.empty(); });
+      if (stop_) {
+        return;
+      }
+      extent = submit_queue_.front();
+      submit_queue_.pop_front();
+    }
+    extent->data.resize(extent->length);
+    auto rc = ReadAt(extent->shard_id, extent->offset, extent->length, extent->data.data());
+    {
+      std::lock_guard<std::mutex> lck(mtx_);
+      extent->done = true;
+      extent->failed = rc.IsError();
+    }
+    cv_done_.notify_all();
+  }
+}
+
+Status ShardIoEngine::ReadAt(int shard_id, uint64_t offset, uint64_t length, uint8_t *data) {
+#if defined(_WIN32) || defined(_WIN64)
+  RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] The asynchronous read engine is not supported on Windows.");
+#else
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(shard_id >= 0 && shard_id < static_cast<int>(fds_.size()),
+                                  "[Internal ERROR] 'shard_id': " + std::to_string(shard_id) +
+                                    " is out of bound: " + std::to_string(fds_.size()));
+  uint64_t total = 0;
+  while (total < length) {
+    auto ret = pread(fds_[shard_id], data + total, length - total, static_cast<off_t>(offset + total));
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file, offset: " + std::to_string(offset + total) +
+                                  ", error: " + (ret == 0 ? std::string("end of file") : std::strerror(errno)));
+    }
+    total += static_cast<uint64_t>(ret);
+  }
+  bytes_read_ += length;
+  ++num_reads_;
+  return Status::OK();
+#endif
+}
+
+std::shared_ptr<ShardIoEngine::Extent> ShardIoEngine::FindExtent(int shard_id, uint64_t offset, uint64_t length) {
+  if (shard_id < 0 || shard_id >= static_cast<int>(extents_.size())) {
+    return nullptr;
+  }
+  auto &table = extents_[shard_id];
+  auto it = table.upper_bound(offset);
+  if (it == table.begin()) {
+    return nullptr;
+  }
+  --it;
+  auto &extent = it->second;
+  if (offset + length > extent->offset + extent->length) {
+    return nullptr;
+  }
+  return extent;
+}
+
+void ShardIoEngine::EraseExtent(const std::shared_ptr<Extent> &extent) {
+  if (!extent->in_table) {
+    return;
+  }
+  extent->in_table = false;
+  cached_bytes_ -= extent->length;
+  auto &table = extents_[extent->shard_id];
+  auto it = table.find(extent->offset);
+  if (it != table.end() && it->second == extent) {
+    (void)table.erase(it);
+  }
+  // release the memory of the consumed extents which are at the head of the queue
+  while (!extent_fifo_.empty() && !extent_fifo_.front()->in_table) {
+    extent_fifo_.pop_front();
+  }
+}
+
+void ShardIoEngine::EvictLocked(uint64_t incoming_bytes) {
+  while (cached_bytes_ + incoming_bytes > kIoPrefetchBudget && !extent_fifo_.empty()) {
+    auto extent = extent_fifo_.front();
+    if (extent->in_table && !extent->done) {
+      // the oldest extent is still being read, nothing can be evicted
+      return;
+    }
+    extent_fifo_.pop_front();
+    if (extent->in_table) {
+      EraseExtent(extent);
+    }
+  }
+}
+
+void ShardIoEngine::Prefetch(const std::vector<ReadRequest> &requests) {
+  if (requests.empty()) {
+    return;
+  }
+  std::vector<ReadRequest> sorted(requests);
+  std::sort(sorted.begin(), sorted.end(), [](const ReadRequest &a, const ReadRequest &b) {
+    return a.shard_id != b.shard_id ? a.shard_id < b.shard_id : a.offset < b.offset;
+  });
+
+  // merge the ranges which are close to each other in the same file into one extent
+  std::vector<std::pair<std::shared_ptr<Extent>, int32_t>> merged;
+  for (const auto &request : sorted) {
+    if (!merged.empty()) {
+      auto &last = merged.back().first;
+      uint64_t last_end = last->offset + last->length;
+      uint64_t new_end = std::max(last_end, request.offset + request.length);
+      if (last->shard_id == request.shard_id && request.offset <= last_end + kIoCoalesceGap &&
+          new_end - last->offset <= kIoMaxReadSize) {
+        last->length = new_end - last->offset;
+        ++merged.back().second;
+        continue;
+      }
+    }
+    auto extent = std::make_shared<Extent>();
+    extent->shard_id = request.shard_id;
+    extent->offset = request.offset;
+    extent->length = request.length;
+    merged.emplace_back(extent, 1);
+  }
+
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    if (stop_) {
+      return;
+    }
+    for (auto &item : merged) {
+      auto &extent = item.first;
+      auto existing = FindExtent(extent->shard_id, extent->offset, extent->length);
+      if (existing != nullptr) {
+        existing->num_users += item.second;
+        continue;
+      }
+      EvictLocked(extent->length);
+      if (cached_bytes_ + extent->length > kIoPrefetchBudget ||
+          extents_[extent->shard_id].count(extent->offset) > 0) {
+        // out of budget, or overlapping an extent in flight, the range will be read directly
+        continue;
+      }
+      extent->num_users = item.second;
+      extents_[extent->shard_id][extent->offset] = extent;
+      extent_fifo_.push_back(extent);
+      submit_queue_.push_back(extent);
+      cached_bytes_ += extent->length;
+    }
+  }
+  cv_submit_.notify_all();
+}
+
+Status ShardIoEngine::Read(int shard_id, uint64_t offset, uint64_t length, std::vector<uint8_t> *data) {
+  RETURN_UNEXPECTED_IF_NULL_MR(data);
+  std::shared_ptr<Extent> extent;
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    extent = FindExtent(shard_id, offset, length);
+    if (extent != nullptr) {
+      cv_done_.wait(lck, [this, &extent] { return stop_ || extent->done; });
+      if (!extent->done || extent->failed) {
+        EraseExtent(extent);
+        extent = nullptr;
+      }
+    }
+  }
+  if (extent == nullptr) {
+    data->resize(length);
+    return ReadAt(shard_id, offset, length, data->data());
+  }
+  // the data of a completed extent is not modified any more, copy it out of the lock
+  auto begin = extent->data.begin() + static_cast<std::ptrdiff_t>(offset - extent->offset);
+  data->assign(begin, begin + static_cast<std::ptrdiff_t>(length));
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    if (--extent->num_users <= 0) {
+      EraseExtent(extent);
+    }
+  }
+  return Status::OK();
+}
+
+void ShardIoEngine::Clear() {
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    // the queued extents are never going to be read, release the readers waiting for them
+    for (auto &extent : submit_queue_) {
+      extent->done = true;
+      extent->failed = true;
+    }
+    submit_queue_.clear();
+    for (auto &table : extents_) {
+      for (auto &item : table) {
+        item.second->in_table = false;
+      }
+      table.clear();
+    }
+    extent_fifo_.clear();
+    cached_bytes_ = 0;
+  }
+  cv_done_.notify_all();
+}
+
+void ShardIoEngine::GetCounters(uint64_t *bytes_read, uint64_t *num_reads) const {
+  if (bytes_read != nullptr) {
+    *bytes_read = bytes_read_;
+  }
+  if (num_reads != nullptr) {
+    *num_reads = num_reads_;
+  }
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -334,6 +334,9 @@ void ShardReader::Close() {
     }
   }
 
+  if (io_engine_ != nullptr) {
+    io_engine_->Close();
+  }
   FileStreamsOperator();
 }
 
@@ -1104,6 +1107,88 @@ Status ShardReader::Open(const std::vector<std::string> &file_paths, bool load_d
   return Status::OK();
 }
 
+Status ShardReader::EnableIoEngine(int32_t io_depth) {
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(io_depth > 0, "[Internal ERROR] 'io_depth' should be positive, but got: " +
+                                                  std::to_string(io_depth));
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(!file_streams_random_.empty(),
+                                  "EnableIoEngine() must not be called prior to calling Open()");
+  std::vector<std::string> real_paths;
+  for (const auto &file : file_paths_) {
+    std::optional<std::string> dir = "";
+    std::optional<std::string> local_file_name = "";
+    FileUtils::SplitDirAndFileName(file, &dir, &local_file_name);
+    if (!dir.has_value()) {
+      dir = ".";
+    }
+
+    auto realpath = FileUtils::GetRealPath(dir.value().c_str());
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(
+      realpath.has_value(), "Invalid file, failed to get the realpath of mindrecord files. Please check file: " + file);
+
+    std::optional<std::string> whole_path = "";
+    FileUtils::ConcatDirAndFileName(&realpath, &local_file_name, &whole_path);
+    real_paths.push_back(whole_path.value());
+  }
+  auto io_engine = std::make_unique<ShardIoEngine>(io_depth);
+  RETURN_IF_NOT_OK_MR(io_engine->Open(real_paths));
+  io_engine_ = std::move(io_engine);
+  io_depth_ = io_depth;
+  return Status::OK();
+}
+
+void ShardReader::GetIoCounters(uint64_t *bytes_read, uint64_t *num_reads) const {
+  uint64_t engine_bytes = 0;
+  uint64_t engine_reads = 0;
+  if (io_engine_ != nullptr) {
+    io_engine_->GetCounters(&engine_bytes, &engine_reads);
+  }
+  if (bytes_read != nullptr) {
+    *bytes_read = io_bytes_read_ + engine_bytes;
+  }
+  if (num_reads != nullptr) {
+    *num_reads = io_num_reads_ + engine_reads;
+  }
+}
+
+void ShardReader::PrefetchBlobs() {
+  // the offsets of the blobs are only known ahead of time when all the metadata is loaded
+  if (lazy_load_) {
+    return;
+  }
+  int64_t consumed = num_consumed_++;
+  int64_t window = static_cast<int64_t>(io_depth_) * kPrefetchRowsPerDepth;
+  // another consumer is already submitting, it covers the same window
+  std::unique_lock<std::mutex> lck(prefetch_mtx_, std::try_to_lock);
+  if (!lck.owns_lock() || prefetch_position_ > consumed + window / 2) {
+    return;
+  }
+  int64_t num_samples = static_cast<int64_t>(tasks_.sample_ids_.size());
+  int64_t end = std::min(consumed + window, num_samples);
+  prefetch_position_ = std::max(prefetch_position_, consumed);
+  std::vector<ShardIoEngine::ReadRequest> requests;
+  for (; prefetch_position_ < end; ++prefetch_position_) {
+    auto task_id = tasks_.sample_ids_[prefetch_position_];
+    if (task_id < 0 || task_id >= tasks_.Size()) {
+      continue;
+    }
+    const auto &task = tasks_.GetTaskByID(task_id);
+    if (std::get<0>(task) == TaskType::kPaddedTask) {
+      continue;
+    }
+    int shard_id = std::get<0>(std::get<1>(task));
+    int group_id = std::get<1>(std::get<1>(task));
+    uint64_t blob_start = std::get<2>(task)[0];
+    uint64_t blob_end = std::get<2>(task)[1];
+    std::shared_ptr<Page> page_ptr;
+    if (blob_end <= blob_start || shard_header_->GetPageByGroupId(group_id, shard_id, &page_ptr).IsError()) {
+      continue;
+    }
+    (void)requests.push_back(
+      {shard_id, header_size_ + page_size_ * page_ptr->GetPageID() + blob_start, blob_end - blob_start});
+  }
+  io_engine_->Prefetch(requests);
+}
+
 Status ShardReader::Launch(bool is_sample_read) {
   // Get all row groups' info
   auto row_group_summary = ReadRowGroupSummary();
@@ -1354,6 +1439,10 @@ Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
     return Status::OK();
   }
 
+  if (io_engine_ != nullptr) {
+    PrefetchBlobs();
+  }
+
   shard_id = std::get<0>(std::get<1>(task));  // shard id
 
   if (lazy_load_ == false) {
@@ -1384,19 +1473,26 @@ Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
   MS_LOG(DEBUG) << "[Internal ERROR] Success to get page by group id: " << group_id;
 
   // Pack image list
-  std::vector<uint8_t> images(blob_end - blob_start);
+  std::vector<uint8_t> images;
   auto file_offset = header_size_ + page_size_ * (page_ptr->GetPageID()) + blob_start;
 
-  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    file_streams_random_[consumer_id][shard_id]->close();
-    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file.");
-  }
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), blob_end - blob_start);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
-    file_streams_random_[consumer_id][shard_id]->close();
-    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file.");
+  if (io_engine_ != nullptr) {
+    RETURN_IF_NOT_OK_MR(io_engine_->Read(shard_id, file_offset, blob_end - blob_start, &images));
+  } else {
+    images.resize(blob_end - blob_start);
+    auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
+    if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+      file_streams_random_[consumer_id][shard_id]->close();
+      RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file.");
+    }
+    auto &io_read =
+      file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), blob_end - blob_start);
+    if (!io_read.good() || io_read.fail() || io_read.bad()) {
+      file_streams_random_[consumer_id][shard_id]->close();
+      RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file.");
+    }
+    io_bytes_read_ += blob_end - blob_start;
+    ++io_num_reads_;
   }
 
   // Deliver batch data to output map
@@ -1516,6 +1612,7 @@ void ShardReader::Reset() {
     deliver_id_ = 0;
   }
   cv_delivery_.notify_all();
+  ResetPrefetch();
 }
 
 void ShardReader::ShuffleTask() {
@@ -1542,6 +1639,16 @@ void ShardReader::ShuffleTask() {
   if (tasks_.permutation_.empty()) {
     tasks_.MakePerm();
   }
+  ResetPrefetch();
+}
+
+void ShardReader::ResetPrefetch() {
+  std::lock_guard<std::mutex> lck(prefetch_mtx_);
+  prefetch_position_ = 0;
+  num_consumed_ = 0;
+  if (io_engine_ != nullptr) {
+    io_engine_->Clear();
+  }
 }
 
 const std::vector<int64_t> *ShardReader::GetSampleIds() {
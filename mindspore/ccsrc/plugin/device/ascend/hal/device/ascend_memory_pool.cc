@@ -125,10 +125,9 @@ void AscendMemoryPool::ResetIdleMemBuf() const {
     if (mem_mng->mem_block_list_.empty()) {
       return;
     }
-    for (const auto &it : mem_mng->idle_mem_buf_map_) {
-      MS_EXCEPTION_IF_NULL(it.second);
-      (void)rtMemset(it.second->device_addr_, it.first, 0, it.first);
-    }
+    ForEachIdleMemBuf(mem_mng, [](const DynamicMemBuf &mem_buf) {
+      (void)rtMemset(mem_buf.device_addr_, mem_buf.size_, 0, mem_buf.size_);
+    });
   };
   fn(persistent_mem());
   fn(common_mem());
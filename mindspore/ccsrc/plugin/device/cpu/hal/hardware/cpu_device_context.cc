@@ -83,6 +83,7 @@ void CPUDeviceContext::Initialize() {
 }
 
 void CPUDeviceContext::Destroy() {
+  kernel::ParallelTuningCache::GetInstance().Save();
   MS_EXCEPTION_IF_NULL(device_res_manager_);
   device_res_manager_->Destroy();
 }
@@ -261,6 +262,21 @@ void SetKernelInfoBeforeCreateKernel(const std::vector<CNodePtr> &nodes) {
     }
   }
 }
+
+// The kernels of the same type and data types share the block sizes of their parallel launches.
+std::string ParallelTuningKey(const CNodePtr &node, const std::string &kernel_name) {
+  std::string key = kernel_name;
+  size_t input_num = common::AnfAlgo::GetInputTensorNum(node);
+  for (size_t input_index = 0; input_index < input_num; ++input_index) {
+    key += (input_index == 0 ? "(" : ",") + TypeIdLabel(AnfAlgo::GetInputDeviceDataType(node, input_index));
+  }
+  key += input_num == 0 ? "()->" : ")->";
+  size_t output_num = AnfAlgo::GetOutputTensorNum(node);
+  for (size_t output_index = 0; output_index < output_num; ++output_index) {
+    key += (output_index == 0 ? "" : ",") + TypeIdLabel(AnfAlgo::GetOutputDeviceDataType(node, output_index));
+  }
+  return key;
+}
 }  // namespace
 
 void CPUKernelExecutor::SetOperatorInfo(const KernelGraphPtr &graph) const {
@@ -344,6 +360,7 @@ void CPUKernelExecutor::CreateKernel(const std::vector<CNodePtr> &nodes) const {
     auto inputs_tensor_map = std::map<uint32_t, tensor::TensorPtr>();
     kernel::SetInputsByConstInputs(node, &inputs_tensor_map);
     kernel::SetInputsByDependMap(inputs_tensor_map, &args.inputs, true);
+    cpu_kernel->SetParallelTuningKey(ParallelTuningKey(node, kernel_name));
     if (discard_cpu_kernel_mod != nullptr) {
       kernel::SetArgsToCNode(node, args);
       discard_cpu_kernel_mod->SetCpuRefMapToKernelInfo(node);
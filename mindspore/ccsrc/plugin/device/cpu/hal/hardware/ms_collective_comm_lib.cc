@@ -16,6 +16,7 @@
 
 #include "plugin/device/cpu/hal/hardware/ms_collective_comm_lib.h"
 
+#include "ir/dtype.h"
 #include "distributed/constants.h"
 #include "distributed/recovery/recovery_context.h"
 #include "runtime/collective/collective_communication_lib.h"
@@ -51,6 +52,16 @@ bool MsCollectiveCommLib::Initialize(uint32_t global_rank, uint32_t global_rank_
 
   cgn_ = std::dynamic_pointer_cast<distributed::cluster::topology::ComputeGraphNode>(
     ClusterContext::instance()->node_base());
+  CHECK_IF_NULL(cgn_);
+
+  topo_node_ = std::make_shared<TopologyNode>(global_rank_size, cgn_);
+  if (!topo_node_->Initialize() || !topo_node_->Initialized()) {
+    MS_LOG(EXCEPTION) << "Failed to initialize the topology node of the collective communication.";
+  }
+  ops_impl_ = std::make_unique<MSCollectiveOpsImpl>(topo_node_);
+  if (!ops_impl_->Initialize()) {
+    MS_LOG(EXCEPTION) << "Failed to initialize the collective operations.";
+  }
 
   global_rank_id_ = global_rank;
   global_rank_size_ = global_rank_size;
@@ -61,6 +72,11 @@ bool MsCollectiveCommLib::Initialize(uint32_t global_rank, uint32_t global_rank_
 }
 
 bool MsCollectiveCommLib::Finalize() {
+  ops_impl_.reset();
+  if (topo_node_ != nullptr) {
+    (void)topo_node_->Finalize();
+    topo_node_.reset();
+  }
   if (launcher_ != nullptr) {
     return launcher_->Finalize();
   }
@@ -215,15 +231,36 @@ bool MsCollectiveCommLib::AllReduce(const void *send_buff, void *recv_buff, size
                                     CollectiveOpReduceType reduce_op, const std::string &group_name, void *) {
   CHECK_IF_NULL(send_buff);
   CHECK_IF_NULL(recv_buff);
-  CHECK_IF_NULL(launcher_);
-  if (data_type != TypeId::kNumberTypeFloat32) {
-    MS_LOG(EXCEPTION) << "AllReduce only support float32.";
-  }
+  CHECK_IF_NULL(ops_impl_);
   if (reduce_op != CollectiveOpReduceType::Reduce_Sum) {
     MS_LOG(EXCEPTION) << "AllReduce only support reduce sum.";
   }
-  bool ret = launcher_->Execute(send_buff, recv_buff, send_count);
-  return ret;
+  if (groups_.count(group_name) == 0) {
+    MS_LOG(ERROR) << "The group " << group_name << " does not exist.";
+    return false;
+  }
+  auto group = groups_[group_name];
+  CHECK_IF_NULL(group);
+  const auto &group_ranks = group->group_ranks();
+
+  // The algorithm is selected by the message size and the hosts of the ranks, the ranks on the same host reduce
+  // through shared memory.
+  auto sendbuff = const_cast<void *>(send_buff);
+  switch (data_type) {
+    case TypeId::kNumberTypeInt8:
+      return ops_impl_->AllReduce<char>(group_name, sendbuff, recv_buff, send_count, group_ranks);
+    case TypeId::kNumberTypeInt32:
+    case TypeId::kNumberTypeInt:
+      return ops_impl_->AllReduce<int>(group_name, sendbuff, recv_buff, send_count, group_ranks);
+    case TypeId::kNumberTypeUInt64:
+      return ops_impl_->AllReduce<uint64_t>(group_name, sendbuff, recv_buff, send_count, group_ranks);
+    case TypeId::kNumberTypeFloat32:
+    case TypeId::kNumberTypeFloat:
+      return ops_impl_->AllReduce<float>(group_name, sendbuff, recv_buff, send_count, group_ranks);
+    default:
+      MS_LOG(ERROR) << "AllReduce does not support the data type " << TypeIdToString(data_type);
+      return false;
+  }
 }
 
 bool MsCollectiveCommLib::AllGather(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type,
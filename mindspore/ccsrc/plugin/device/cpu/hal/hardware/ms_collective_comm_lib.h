@@ -26,6 +26,8 @@
 #include "ps/core/collective_ops_impl.h"
 #include "plugin/device/cpu/hal/hardware/ms_collective_node.h"
 #include "plugin/device/cpu/hal/hardware/allreduce_impl.h"
+#include "plugin/device/cpu/hal/hardware/ms_collective_ops_impl.h"
+#include "plugin/device/cpu/hal/hardware/ms_collective_topo.h"
 #include "distributed/cluster/topology/compute_graph_node.h"
 
 namespace mindspore {
@@ -93,6 +95,10 @@ class MsCollectiveCommLib : public CollectiveCommunicationLib {
 
   std::unique_ptr<AllReduceLauncher> launcher_;
 
+  // AllReduce runs on the topology node, which connects the ranks by tcp and groups them by their hosts.
+  std::shared_ptr<TopologyNode> topo_node_;
+  std::unique_ptr<MSCollectiveOpsImpl> ops_impl_;
+
   // Indicates whether the collective node has to synchronize the addresses of all the collective nodes.
   bool synchronized_{true};
 };
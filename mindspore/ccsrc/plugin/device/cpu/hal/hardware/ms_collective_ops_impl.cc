@@ -14,7 +14,16 @@
  * limitations under the License.
  */
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <algorithm>
 #include <numeric>
+#include <random>
+#include <set>
+#include <utility>
 #include "plugin/device/cpu/hal/hardware/ms_collective_ops_impl.h"
 #include "distributed/cluster/cluster_context.h"
 #include "utils/ms_context.h"
@@ -27,14 +36,539 @@ const char kCollectivePhaseRing[] = "ring";
 const char kCollectivePhaseGather[] = "gather";
 const char kCollectivePhaseReduce[] = "reduce";
 const char kCollectivePhaseBroadcast[] = "broadcast";
+
+// The header of the shared memory holds its token, the slots of the ranks follow it. Both are aligned to cache lines.
+constexpr size_t kShmAlignment = 64;
+constexpr char kShmNamePrefix[] = "/mindspore_collective_";
+constexpr char kControlMessage = 'c';
+
+size_t AlignShm(size_t size) { return (size + kShmAlignment - 1) / kShmAlignment * kShmAlignment; }
+
+uint32_t CollectiveTimeout() {
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  // If enable recovery, set timeout 300s to prevent networking flapping.
+  return context_ptr->get_param<bool>(MS_CTX_ENABLE_RECOVERY) ? kCollectiveCommMaxTimeout : kCollectiveCommTimeout;
+}
 }  // namespace
 
+CollectiveShmSegment::~CollectiveShmSegment() {
+  Unlink();
+  if (addr_ != nullptr) {
+    (void)munmap(addr_, size_);
+    addr_ = nullptr;
+  }
+}
+
+std::string CollectiveShmSegment::Name(uint64_t token) { return kShmNamePrefix + std::to_string(token); }
+
+bool CollectiveShmSegment::Create(size_t size) {
+  if (addr_ != nullptr) {
+    MS_LOG(ERROR) << "The shared memory has been created.";
+    return false;
+  }
+  std::random_device rd;
+  constexpr size_t kShift = 32;
+  token_ = (static_cast<uint64_t>(rd()) << kShift) | rd();
+  auto name = Name(token_);
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Failed to create the shared memory " << name << ", errno: " << errno;
+    return false;
+  }
+  linked_ = true;
+  if (ftruncate(fd, SizeToLong(size)) != 0) {
+    MS_LOG(ERROR) << "Failed to resize the shared memory " << name << " to " << size << ", errno: " << errno;
+    (void)close(fd);
+    return false;
+  }
+  void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(ERROR) << "Failed to map the shared memory " << name << ", errno: " << errno;
+    return false;
+  }
+  addr_ = addr;
+  size_ = size;
+  *static_cast<uint64_t *>(addr_) = token_;
+  return true;
+}
+
+bool CollectiveShmSegment::Open(uint64_t token, size_t size) {
+  if (addr_ != nullptr) {
+    MS_LOG(ERROR) << "The shared memory has been opened.";
+    return false;
+  }
+  auto name = Name(token);
+  int fd = shm_open(name.c_str(), O_RDWR, 0);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Failed to open the shared memory " << name << ", errno: " << errno
+                  << ". The processes with the same ip may not share their shared memory.";
+    return false;
+  }
+  void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(ERROR) << "Failed to map the shared memory " << name << ", errno: " << errno;
+    return false;
+  }
+  addr_ = addr;
+  size_ = size;
+  token_ = token;
+  if (*static_cast<uint64_t *>(addr_) != token_) {
+    MS_LOG(ERROR) << "The shared memory " << name << " is not created by the first rank on this host.";
+    return false;
+  }
+  return true;
+}
+
+void CollectiveShmSegment::Unlink() {
+  if (linked_) {
+    (void)shm_unlink(Name(token_).c_str());
+    linked_ = false;
+  }
+}
+
 bool MSCollectiveOpsImpl::Initialize() {
   MS_EXCEPTION_IF_NULL(topo_node_);
   rank_id_ = SizeToUint(topo_node_->rank_id());
   return true;
 }
 
+bool MSCollectiveOpsImpl::InitHostTopology() {
+  if (!host_leaders_.empty()) {
+    return true;
+  }
+  // The ranks whose tcp servers have the same ip are on the same host.
+  std::map<std::string, std::vector<uint32_t>> host_ranks;
+  for (uint32_t rank = 0; rank < rank_size_; ++rank) {
+    auto host = topo_node_->GetRankHost(rank);
+    if (host.empty()) {
+      MS_LOG(WARNING) << "The host of rank " << rank << " is unknown, it is taken as a host of its own.";
+      host = "rank_" + std::to_string(rank);
+    }
+    auto &ranks = host_ranks[host];
+    if (ranks.empty()) {
+      host_leaders_.push_back(rank);
+    }
+    ranks.push_back(rank);
+  }
+  for (auto &[host, ranks] : host_ranks) {
+    if (std::find(ranks.begin(), ranks.end(), rank_id_) != ranks.end()) {
+      local_ranks_ = ranks;
+      MS_LOG(INFO) << "Rank " << rank_id_ << " is on host " << host << " with ranks " << ranks;
+    }
+  }
+  if (local_ranks_.empty()) {
+    MS_LOG(ERROR) << "Rank " << rank_id_ << " is not in the topology of " << rank_size_ << " ranks.";
+    host_leaders_.clear();
+    return false;
+  }
+  local_index_ = LongToSize(std::find(local_ranks_.begin(), local_ranks_.end(), rank_id_) - local_ranks_.begin());
+  leader_index_ =
+    LongToSize(std::find(host_leaders_.begin(), host_leaders_.end(), local_ranks_[0]) - host_leaders_.begin());
+  return true;
+}
+
+AllReduceAlgorithm MSCollectiveOpsImpl::SelectAllReduceAlgorithm(size_t size) const {
+  if (allreduce_algorithm_ != AllReduceAlgorithm::kAuto) {
+    return allreduce_algorithm_;
+  }
+  if (size <= kHalvingDoublingMaxSize) {
+    return AllReduceAlgorithm::kHalvingDoubling;
+  }
+  // All the ranks must select the same algorithm, the shared memory is used if any host has several ranks.
+  return host_leaders_.size() < rank_size_ ? AllReduceAlgorithm::kHierarchical : AllReduceAlgorithm::kRing;
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::AllReduce(const std::string &data_name, void *sendbuff, void *recvbuff, size_t count) {
+  MS_EXCEPTION_IF_NULL(topo_node_);
+  std::vector<uint32_t> ranks(topo_node_->rank_size());
+  std::iota(ranks.begin(), ranks.end(), 0);
+  return AllReduce<T>(data_name, sendbuff, recvbuff, count, ranks);
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::AllReduce(const std::string &data_name, void *sendbuff, void *recvbuff, size_t count,
+                                    const std::vector<uint32_t> &group_ranks) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+
+  // Initialize collective communication parameters.
+  MS_EXCEPTION_IF_NULL(topo_node_);
+  rank_id_ = SizeToUint(topo_node_->rank_id());
+  rank_size_ = SizeToUint(topo_node_->rank_size());
+  if (rank_size_ == 0) {
+    MS_LOG(ERROR) << "Rank size should not be 0.";
+    return false;
+  }
+  auto iter = std::find(group_ranks.begin(), group_ranks.end(), rank_id_);
+  bool valid_ranks =
+    std::all_of(group_ranks.begin(), group_ranks.end(), [this](uint32_t rank) { return rank < rank_size_; });
+  if (iter == group_ranks.end() || !valid_ranks) {
+    MS_LOG(ERROR) << "The group of AllReduce " << data_name << " has the ranks " << group_ranks
+                  << ", which should be among the " << rank_size_ << " ranks and have the rank " << rank_id_
+                  << " of this process.";
+    return false;
+  }
+  size_t index = LongToSize(iter - group_ranks.begin());
+  if (count == 0) {
+    return true;
+  }
+  size_t size = count * sizeof(T);
+  if (recvbuff != sendbuff) {
+    int ret = memcpy_s(recvbuff, size, sendbuff, size);
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
+                    << ", dest size is " << size << ", src size is " << size;
+      return false;
+    }
+  }
+  if (group_ranks.size() == 1) {
+    MS_LOG(INFO) << "Rank size is 1. Do nothing.";
+    return true;
+  }
+  if (!InitHostTopology()) {
+    return false;
+  }
+
+  T *buff = reinterpret_cast<T *>(recvbuff);
+  auto algorithm = SelectAllReduceAlgorithm(size);
+  if (algorithm == AllReduceAlgorithm::kHierarchical && group_ranks.size() != rank_size_) {
+    algorithm = AllReduceAlgorithm::kRing;
+  }
+  MS_LOG(DEBUG) << "AllReduce " << data_name << " count:" << count << ", group_size:" << group_ranks.size()
+                << ", rank_id_:" << rank_id_ << ", algorithm:" << static_cast<int>(algorithm);
+  if (algorithm == AllReduceAlgorithm::kHierarchical) {
+    return HierarchicalAllReduce(buff, count);
+  }
+  if (algorithm == AllReduceAlgorithm::kHalvingDoubling) {
+    return HalvingDoublingAllReduce(group_ranks, index, buff, count);
+  }
+  return RingAllReduce(group_ranks, index, buff, count);
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::RingAllReduce(const std::vector<uint32_t> &ranks, size_t index, T *buff, size_t count) {
+  size_t rank_size = ranks.size();
+  if (rank_size <= 1) {
+    return true;
+  }
+  std::vector<size_t> chunk_sizes(rank_size, count / rank_size);
+  // The rest of the data should be assigned to each chunk.
+  for (size_t i = 0; i < count % rank_size; i++) {
+    chunk_sizes[i]++;
+  }
+  std::vector<size_t> chunk_offset(rank_size, 0);
+  for (size_t i = 1; i < rank_size; i++) {
+    chunk_offset[i] = chunk_offset[i - 1] + chunk_sizes[i - 1];
+  }
+  uint32_t send_to_rank = ranks[(index + 1) % rank_size];
+  uint32_t recv_from_rank = ranks[(index + rank_size - 1) % rank_size];
+  const size_t segment_size = std::max<size_t>(kRingSegmentSize / sizeof(T), 1);
+  MS_LOG(DEBUG) << "Ring AllReduce count:" << count << ", rank_size:" << rank_size << ", index:" << index
+                << ", chunk_sizes:" << chunk_sizes << ", send_to_rank:" << send_to_rank
+                << ", recv_from_rank:" << recv_from_rank;
+
+  // Only the chunk of this rank is sent at once. Each segment of the other chunks is forwarded as soon as it is
+  // received, so that sending, reducing and receiving overlap along the ring.
+  for (size_t pos = 0; pos < chunk_sizes[index]; pos += segment_size) {
+    size_t len = std::min(segment_size, chunk_sizes[index] - pos);
+    if (!topo_node_->SendAsync(send_to_rank, buff + chunk_offset[index] + pos, len * sizeof(T))) {
+      MS_LOG(ERROR) << "Failed to send data to rank: " << send_to_rank;
+      return false;
+    }
+  }
+  // The chunk received at a step is the chunk sent at the next step. It is reduced in the first rank_size - 1 steps,
+  // which are the ReduceScatter, and copied in the others, which are the AllGather.
+  const size_t steps = 2 * (rank_size - 1);
+  for (size_t step = 0; step < steps; ++step) {
+    size_t chunk_index = (index + rank_size - (step + 1) % rank_size) % rank_size;
+    bool reduce = step < rank_size - 1;
+    bool forward = step + 1 < steps;
+    for (size_t pos = 0; pos < chunk_sizes[chunk_index]; pos += segment_size) {
+      size_t len = std::min(segment_size, chunk_sizes[chunk_index] - pos);
+      T *segment = buff + chunk_offset[chunk_index] + pos;
+      if (!ReceiveData(recv_from_rank, segment, len, reduce)) {
+        return false;
+      }
+      if (forward && !topo_node_->SendAsync(send_to_rank, segment, len * sizeof(T))) {
+        MS_LOG(ERROR) << "Failed to send data to rank: " << send_to_rank;
+        return false;
+      }
+    }
+  }
+  if (!topo_node_->WaitForSend(send_to_rank)) {
+    MS_LOG(ERROR) << "Failed to send data to rank: " << send_to_rank;
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::HalvingDoublingAllReduce(const std::vector<uint32_t> &ranks, size_t index, T *buff,
+                                                   size_t count) {
+  size_t rank_size = ranks.size();
+  if (rank_size <= 1) {
+    return true;
+  }
+  std::set<uint32_t> send_to_ranks;
+  auto exchange = [this, &send_to_ranks](uint32_t peer, const T *send_data, size_t send_count, T *recv_data,
+                                         size_t recv_count, bool reduce) {
+    if (send_count > 0) {
+      if (!topo_node_->SendAsync(peer, send_data, send_count * sizeof(T))) {
+        MS_LOG(ERROR) << "Failed to send data to rank: " << peer;
+        return false;
+      }
+      (void)send_to_ranks.insert(peer);
+    }
+    return recv_count == 0 || ReceiveData(peer, recv_data, recv_count, reduce);
+  };
+  auto wait_for_send = [this, &send_to_ranks]() {
+    for (auto rank : send_to_ranks) {
+      if (!topo_node_->WaitForSend(rank)) {
+        MS_LOG(ERROR) << "Failed to send data to rank: " << rank;
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // The halving and doubling run between a power of two ranks. Among the first 2 * extra_size ranks, the even ones
+  // give their data to the odd ones before, and get the result from them after.
+  size_t pow_size = 1;
+  while (pow_size * 2 <= rank_size) {
+    pow_size *= 2;
+  }
+  size_t extra_size = rank_size - pow_size;
+  if (index < 2 * extra_size) {
+    if (index % 2 == 0) {
+      return exchange(ranks[index + 1], buff, count, nullptr, 0, false) && wait_for_send() &&
+             ReceiveData(ranks[index + 1], buff, count, false);
+    }
+    if (!ReceiveData(ranks[index - 1], buff, count, true)) {
+      return false;
+    }
+  }
+  size_t vindex = index < 2 * extra_size ? index / 2 : index - extra_size;
+  auto peer_rank = [&ranks, extra_size](size_t peer_vindex) {
+    return ranks[peer_vindex < extra_size ? 2 * peer_vindex + 1 : peer_vindex + extra_size];
+  };
+
+  // Recursive halving ReduceScatter: at each step, the range of this rank is split with the peer, each of them keeps
+  // one half and reduces the half of the other into it.
+  std::vector<std::pair<size_t, size_t>> ranges;
+  size_t lo = 0;
+  size_t hi = count;
+  for (size_t mask = pow_size / 2; mask > 0; mask /= 2) {
+    size_t mid = lo + (hi - lo) / 2;
+    bool lower = (vindex & mask) == 0;
+    size_t keep_lo = lower ? lo : mid;
+    size_t keep_hi = lower ? mid : hi;
+    size_t give_lo = lower ? mid : lo;
+    size_t give_hi = lower ? hi : mid;
+    if (!exchange(peer_rank(vindex ^ mask), buff + give_lo, give_hi - give_lo, buff + keep_lo, keep_hi - keep_lo,
+                  true)) {
+      return false;
+    }
+    ranges.emplace_back(lo, hi);
+    lo = keep_lo;
+    hi = keep_hi;
+  }
+
+  // Recursive doubling AllGather: the steps in the reverse order, each rank gives its reduced range to the peer.
+  for (size_t mask = 1; mask < pow_size; mask *= 2) {
+    auto [parent_lo, parent_hi] = ranges.back();
+    ranges.pop_back();
+    bool lower = (vindex & mask) == 0;
+    size_t other_lo = lower ? hi : parent_lo;
+    size_t other_hi = lower ? parent_hi : lo;
+    if (!exchange(peer_rank(vindex ^ mask), buff + lo, hi - lo, buff + other_lo, other_hi - other_lo, false)) {
+      return false;
+    }
+    lo = parent_lo;
+    hi = parent_hi;
+  }
+
+  if (index < 2 * extra_size && !exchange(ranks[index - 1], buff, count, nullptr, 0, false)) {
+    return false;
+  }
+  return wait_for_send();
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::HierarchicalAllReduce(T *buff, size_t count) {
+  size_t size = count * sizeof(T);
+  auto inter_host_allreduce = [this, size](T *data, size_t data_count) {
+    if (size <= kHalvingDoublingMaxSize) {
+      return HalvingDoublingAllReduce(host_leaders_, leader_index_, data, data_count);
+    }
+    return RingAllReduce(host_leaders_, leader_index_, data, data_count);
+  };
+  size_t local_size = local_ranks_.size();
+  if (local_size == 1) {
+    return inter_host_allreduce(buff, count);
+  }
+
+  // Step 1: each rank copies its data to its slot of the shared memory of the host. The first rank creates the shared
+  // memory, or a larger one, and gives its token to the others.
+  bool is_leader = local_index_ == 0;
+  uint32_t leader = local_ranks_[0];
+  size_t slot_size = AlignShm(size);
+  bool created = false;
+  if (is_leader) {
+    size_t shm_size = kShmAlignment + slot_size * local_size;
+    if (shm_ == nullptr || shm_->size() < shm_size) {
+      shm_ = std::make_unique<CollectiveShmSegment>();
+      if (!shm_->Create(shm_size)) {
+        shm_ = nullptr;
+        return false;
+      }
+      created = true;
+    }
+    uint64_t shm_info[] = {shm_->token(), shm_->size()};
+    for (size_t i = 1; i < local_size; ++i) {
+      if (!SendControl(local_ranks_[i], shm_info, sizeof(shm_info))) {
+        return false;
+      }
+    }
+  } else {
+    std::string shm_info;
+    if (!ReceiveControl(leader, &shm_info) || shm_info.size() != 2 * sizeof(uint64_t)) {
+      MS_LOG(ERROR) << "Failed to get the shared memory from rank " << leader;
+      return false;
+    }
+    const auto *token_and_size = reinterpret_cast<const uint64_t *>(shm_info.data());
+    if (shm_ == nullptr || shm_->token() != token_and_size[0]) {
+      shm_ = std::make_unique<CollectiveShmSegment>();
+      if (!shm_->Open(token_and_size[0], token_and_size[1])) {
+        shm_ = nullptr;
+        return false;
+      }
+    }
+  }
+  auto slot = [this, slot_size](size_t local_index) {
+    return reinterpret_cast<T *>(shm_->data() + kShmAlignment + local_index * slot_size);
+  };
+  int ret = memcpy_s(slot(local_index_), slot_size, buff, size);
+  if (ret != EOK) {
+    MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
+                  << ", dest size is " << slot_size << ", src size is " << size;
+    return false;
+  }
+  if (!LocalBarrier()) {
+    return false;
+  }
+  if (created) {
+    shm_->Unlink();
+  }
+
+  // Step 2: each rank sums a slice of the slots into the first slot.
+  size_t slice_size = count / local_size;
+  size_t remainder = count % local_size;
+  size_t slice_lo = local_index_ * slice_size + std::min(local_index_, remainder);
+  size_t slice_hi = slice_lo + slice_size + (local_index_ < remainder ? 1 : 0);
+  T *sum = slot(0);
+  for (size_t i = 1; i < local_size; ++i) {
+    const T *data = slot(i);
+    for (size_t j = slice_lo; j < slice_hi; ++j) {
+      sum[j] += data[j];
+    }
+  }
+  if (!LocalBarrier()) {
+    return false;
+  }
+
+  // Step 3: the first ranks of the hosts reduce the sums of the hosts.
+  if (is_leader && !inter_host_allreduce(sum, count)) {
+    return false;
+  }
+  if (!LocalBarrier()) {
+    return false;
+  }
+
+  // Step 4: each rank copies the result. The shared memory is not reused before all of them have copied it.
+  ret = memcpy_s(buff, size, sum, size);
+  if (ret != EOK) {
+    MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
+                  << ", dest size is " << size << ", src size is " << size;
+    return false;
+  }
+  return LocalBarrier();
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::ReceiveData(uint32_t from_rank, T *buff, size_t count, bool reduce) {
+  MessageBase *message = nullptr;
+  if (!topo_node_->Receive(from_rank, &message, CollectiveTimeout())) {
+    MS_LOG(ERROR) << "Failed to receive data from rank " << from_rank;
+    return false;
+  }
+  MS_EXCEPTION_IF_NULL(message);
+  std::unique_ptr<MessageBase> message_ptr(message);
+  if (message->body.length() != count * sizeof(T)) {
+    MS_LOG(ERROR) << "The data received from rank " << from_rank << " is " << message->body.length()
+                  << " bytes, but " << (count * sizeof(T)) << " bytes are expected.";
+    return false;
+  }
+  if (reduce) {
+    const auto *data = reinterpret_cast<const T *>(message->body.data());
+    for (size_t i = 0; i < count; i++) {
+      buff[i] += data[i];
+    }
+    return true;
+  }
+  int ret = memcpy_s(buff, count * sizeof(T), message->body.data(), message->body.length());
+  if (ret != EOK) {
+    MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
+                  << ", dest size is " << (count * sizeof(T)) << ", src size is " << message->body.length();
+    return false;
+  }
+  return true;
+}
+
+bool MSCollectiveOpsImpl::SendControl(uint32_t to_rank, const void *data, size_t size) {
+  if (!topo_node_->SendAsync(to_rank, data, size) || !topo_node_->WaitForSend(to_rank)) {
+    MS_LOG(ERROR) << "Failed to send data to rank: " << to_rank;
+    return false;
+  }
+  return true;
+}
+
+bool MSCollectiveOpsImpl::ReceiveControl(uint32_t from_rank, std::string *data) {
+  MS_EXCEPTION_IF_NULL(data);
+  MessageBase *message = nullptr;
+  if (!topo_node_->Receive(from_rank, &message, CollectiveTimeout())) {
+    MS_LOG(ERROR) << "Failed to receive data from rank " << from_rank;
+    return false;
+  }
+  MS_EXCEPTION_IF_NULL(message);
+  *data = std::move(message->body);
+  delete message;
+  return true;
+}
+
+bool MSCollectiveOpsImpl::LocalBarrier() {
+  std::string data;
+  if (local_index_ != 0) {
+    return SendControl(local_ranks_[0], &kControlMessage, sizeof(kControlMessage)) &&
+           ReceiveControl(local_ranks_[0], &data);
+  }
+  for (size_t i = 1; i < local_ranks_.size(); ++i) {
+    if (!ReceiveControl(local_ranks_[i], &data)) {
+      return false;
+    }
+  }
+  for (size_t i = 1; i < local_ranks_.size(); ++i) {
+    if (!SendControl(local_ranks_[i], &kControlMessage, sizeof(kControlMessage))) {
+      return false;
+    }
+  }
+  return true;
+}
+
 template <typename T>
 bool MSCollectiveOpsImpl::RingAllGather(const void *sendbuff, void *recvbuff, size_t send_count) {
   MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
@@ -73,11 +607,7 @@ template <typename T>
 bool MSCollectiveOpsImpl::RingAllGatherImpl(uint32_t send_to_rank, uint32_t recv_from_rank, T *output_buff,
                                             const std::vector<size_t> &chunk_offset,
                                             const std::vector<size_t> &chunk_sizes) {
-  auto context_ptr = MsContext::GetInstance();
-  MS_EXCEPTION_IF_NULL(context_ptr);
-  // If enable recovery, set timeout 300s to prevent networking flapping.
-  uint32_t timeout =
-    context_ptr->get_param<bool>(MS_CTX_ENABLE_RECOVERY) ? kCollectiveCommMaxTimeout : kCollectiveCommTimeout;
+  uint32_t timeout = CollectiveTimeout();
 
   MS_EXCEPTION_IF_NULL(topo_node_);
   for (size_t i = 0; i < rank_size_ - 1; i++) {
@@ -123,7 +653,7 @@ bool MSCollectiveOpsImpl::RingAllGatherImpl(uint32_t send_to_rank, uint32_t recv
 
 template <typename T>
 bool MSCollectiveOpsImpl::Broadcast(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
-                                    const CommunicationGroupInfo &group_info) {
+                                    const std::vector<uint32_t> &group_ranks) {
   std::unique_lock<std::mutex> lock(mtx_);
   MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
   MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
@@ -204,6 +734,42 @@ bool MSCollectiveOpsImpl::AllGather(const void *sendbuff, void *recvbuff, size_t
 
   return RingAllGather<T>(sendbuff, recvbuff, send_count);
 }
+
+template bool MSCollectiveOpsImpl::AllReduce<float>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                    size_t count);
+template bool MSCollectiveOpsImpl::AllReduce<uint64_t>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                       size_t count);
+template bool MSCollectiveOpsImpl::AllReduce<int>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                  size_t count);
+template bool MSCollectiveOpsImpl::AllReduce<char>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                   size_t count);
+template bool MSCollectiveOpsImpl::AllReduce<float>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                    size_t count, const std::vector<uint32_t> &group_ranks);
+template bool MSCollectiveOpsImpl::AllReduce<uint64_t>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                       size_t count, const std::vector<uint32_t> &group_ranks);
+template bool MSCollectiveOpsImpl::AllReduce<int>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                  size_t count, const std::vector<uint32_t> &group_ranks);
+template bool MSCollectiveOpsImpl::AllReduce<char>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                   size_t count, const std::vector<uint32_t> &group_ranks);
+
+template bool MSCollectiveOpsImpl::AllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::AllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::AllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::AllGather<char>(const void *sendbuff, void *recvbuff, size_t send_count);
+
+template bool MSCollectiveOpsImpl::RingAllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::RingAllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::RingAllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::RingAllGather<char>(const void *sendbuff, void *recvbuff, size_t send_count);
+
+template bool MSCollectiveOpsImpl::Broadcast<float>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
+                                                    const CommunicationGroupInfo &group_info);
+template bool MSCollectiveOpsImpl::Broadcast<uint64_t>(const void *sendbuff, void *recvbuff, size_t count,
+                                                       uint32_t root, const CommunicationGroupInfo &group_info);
+template bool MSCollectiveOpsImpl::Broadcast<int>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
+                                                  const CommunicationGroupInfo &group_info);
+template bool MSCollectiveOpsImpl::Broadcast<char>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
+                                                   const CommunicationGroupInfo &group_info);
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_MS_COLLECTIVE_OPS_IMPL_H_
 #define MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_MS_COLLECTIVE_OPS_IMPL_H_
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -32,6 +33,56 @@ constexpr uint32_t kCollectiveCommTimeout = 30;
 // The max timeout for server collective communication, used in disaster recovery to prevent networking flapping.
 constexpr uint32_t kCollectiveCommMaxTimeout = 300;
 
+// The AllReduce messages up to this size are reduced with recursive halving and doubling by default, which takes
+// log(n) steps instead of the 2(n-1) steps of the ring.
+constexpr size_t kHalvingDoublingMaxSize = 64 * 1024;
+// The size of the segments a chunk of the ring AllReduce is sent in, so that each segment is forwarded to the next rank
+// as soon as it is reduced, while the rest of the chunk is still being received.
+constexpr size_t kRingSegmentSize = 256 * 1024;
+
+enum class AllReduceAlgorithm {
+  // Selected by the message size and the topology.
+  kAuto = 0,
+  // Ring ReduceScatter and AllGather, pipelined in segments.
+  kRing,
+  // Recursive halving ReduceScatter and recursive doubling AllGather.
+  kHalvingDoubling,
+  // Reduce through shared memory on each host, then AllReduce between the first ranks of the hosts.
+  kHierarchical
+};
+
+// A shared memory segment of the processes on the same host. It is created by the first of them and mapped by the
+// others.
+class CollectiveShmSegment {
+ public:
+  CollectiveShmSegment() = default;
+  ~CollectiveShmSegment();
+
+  // Create a segment named after a random token, which is also written in its first bytes.
+  bool Create(size_t size);
+
+  // Map the segment created by another process with the token.
+  bool Open(uint64_t token, size_t size);
+
+  // Remove the name of the segment once all the processes have mapped it, it is freed when they unmap it.
+  void Unlink();
+
+  uint8_t *data() const { return static_cast<uint8_t *>(addr_); }
+  size_t size() const { return size_; }
+  uint64_t token() const { return token_; }
+
+ private:
+  CollectiveShmSegment(const CollectiveShmSegment &) = delete;
+  CollectiveShmSegment &operator=(const CollectiveShmSegment &) = delete;
+
+  static std::string Name(uint64_t token);
+
+  void *addr_{nullptr};
+  size_t size_{0};
+  uint64_t token_{0};
+  bool linked_{false};
+};
+
 // The collective communication groups which are composed of multiple processes. Refer to MPI_Group.
 struct CommunicationGroupInfo {
   // This group's rank size.
@@ -49,8 +100,9 @@ struct CommunicationGroupInfo {
 };
 
 // MSCollectiveOpsImpl is the collective communication API of the server.
-// For now, it implements two AllReduce algorithms: RingAllReduce and BroadcastAllReduce. Elastic AllReduce is also
-// supported for the elastic scaling feature of the server.
+// AllReduce uses recursive halving and doubling for small messages. For large messages, it reduces through shared
+// memory on each host and runs a pipelined ring between the hosts, or runs the pipelined ring between all the ranks if
+// they are all on different hosts.
 class MSCollectiveOpsImpl {
  public:
   explicit MSCollectiveOpsImpl(const std::shared_ptr<TopologyNode> &topo_node)
@@ -59,9 +111,19 @@ class MSCollectiveOpsImpl {
 
   bool Initialize();
 
+  // Sum the data of all the ranks.
   template <typename T>
   bool AllReduce(const std::string &data_name, void *sendbuff, void *recvbuff, size_t count);
 
+  // Sum the data of the group whose global ranks are given in the group order. The hosts are grouped over all the
+  // ranks, so a group of part of the ranks does not reduce through shared memory, the ring is used for it instead.
+  template <typename T>
+  bool AllReduce(const std::string &data_name, void *sendbuff, void *recvbuff, size_t count,
+                 const std::vector<uint32_t> &group_ranks);
+
+  // Use the given algorithm for AllReduce instead of the one selected by the message size and the topology.
+  void set_allreduce_algorithm(AllReduceAlgorithm algorithm) { allreduce_algorithm_ = algorithm; }
+
   template <typename T>
   bool AllGather(const void *sendbuff, void *recvbuff, size_t send_count);
 
@@ -83,33 +145,52 @@ class MSCollectiveOpsImpl {
   bool RingAllGatherImpl(uint32_t send_to_rank, uint32_t recv_from_rank, T *output_buff,
                          const std::vector<size_t> &chunk_offset, const std::vector<size_t> &chunk_sizes);
 
+  // Group the ranks by their hosts.
+  bool InitHostTopology();
+
+  AllReduceAlgorithm SelectAllReduceAlgorithm(size_t size) const;
+
+  // The AllReduce algorithms between the given ranks, in place. 'index' is the index of this process in 'ranks'.
+  template <typename T>
+  bool RingAllReduce(const std::vector<uint32_t> &ranks, size_t index, T *buff, size_t count);
+
+  template <typename T>
+  bool HalvingDoublingAllReduce(const std::vector<uint32_t> &ranks, size_t index, T *buff, size_t count);
+
+  template <typename T>
+  bool HierarchicalAllReduce(T *buff, size_t count);
+
+  // Receive 'count' elements from the rank, and add them to 'buff' if 'reduce' is true, otherwise copy them.
+  template <typename T>
+  bool ReceiveData(uint32_t from_rank, T *buff, size_t count, bool reduce);
+
+  // Send and receive the small messages which synchronize the ranks on the same host.
+  bool SendControl(uint32_t to_rank, const void *data, size_t size);
+  bool ReceiveControl(uint32_t from_rank, std::string *data);
+
+  // Wait for all the ranks on the same host.
+  bool LocalBarrier();
+
   uint32_t rank_id_;
   uint32_t rank_size_;
 
+  AllReduceAlgorithm allreduce_algorithm_{AllReduceAlgorithm::kAuto};
+
+  // The ranks on the host of this process, the first of them creates the shared memory.
+  std::vector<uint32_t> local_ranks_;
+  size_t local_index_{0};
+
+  // The first rank of each host, and the index of this process in them if it is one of them.
+  std::vector<uint32_t> host_leaders_;
+  size_t leader_index_{0};
+
+  std::unique_ptr<CollectiveShmSegment> shm_{nullptr};
+
   std::shared_ptr<TopologyNode> topo_node_{nullptr};
 
   // The mutex to ensure that collective communication is threadsafe.
   std::mutex mtx_;
 };
-
-template bool MSCollectiveOpsImpl::AllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::AllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::AllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::AllGather<char>(const void *sendbuff, void *recvbuff, size_t send_count);
-
-template bool MSCollectiveOpsImpl::RingAllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::RingAllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::RingAllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::RingAllGather<char>(const void *sendbuff, void *recvbuff, size_t send_count);
-
-template bool MSCollectiveOpsImpl::Broadcast<float>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
-                                                    const CommunicationGroupInfo &group_info);
-template bool MSCollectiveOpsImpl::Broadcast<uint64_t>(const void *sendbuff, void *recvbuff, size_t count,
-                                                       uint32_t root, const CommunicationGroupInfo &group_info);
-template bool MSCollectiveOpsImpl::Broadcast<int>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
-                                                  const CommunicationGroupInfo &group_info);
-template bool MSCollectiveOpsImpl::Broadcast<char>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
-                                                   const CommunicationGroupInfo &group_info);
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
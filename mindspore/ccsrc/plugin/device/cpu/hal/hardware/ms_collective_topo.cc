@@ -29,7 +29,8 @@ bool TopologyNode::Initialize() {
 
   // Initialize the tcp server.
   tcp_server_ = std::make_unique<distributed::rpc::TCPServer>();
-  RETURN_IF_FALSE_WITH_LOG(tcp_server_->Initialize(), "Failed to initialize the tcp server.");
+  bool success = ip_.empty() ? tcp_server_->Initialize() : tcp_server_->Initialize(ip_ + ":0");
+  RETURN_IF_FALSE_WITH_LOG(success, "Failed to initialize the tcp server.");
   tcp_server_->SetMessageHandler(std::bind(&TopologyNode::HandleMessage, this, std::placeholders::_1));
 
   // Put the address of this topo node into meta server node.
@@ -50,22 +51,26 @@ bool TopologyNode::Initialize() {
   // Because all the topo node address metadata are registered into the metadata server asynchronously, a separate
   // thread is needed to fetch these metadata.
   init_thread_ = std::thread([this, next_rank_id]() {
-    size_t retry = 60;
-    while (retry-- > 0) {
-      // Lookup the address from meta server node.
-      auto next_rank_name = "RNAK_ID_" + std::to_string(next_rank_id);
-      std::string next_rank_addr = this->cgn_->GetMetadata(next_rank_name);
-      if (next_rank_addr.length() > 0) {
-        if (this->tcp_clients_[next_rank_id]->Connect(next_rank_addr)) {
-          this->node_addresses_[next_rank_id] = next_rank_addr;
-          this->initialized_ = true;
-          break;
-        }
+    std::string next_rank_addr = this->LookupAddress(next_rank_id);
+    if (next_rank_addr.empty() || !this->tcp_clients_[next_rank_id]->Connect(next_rank_addr)) {
+      MS_LOG(ERROR) << "Failed to connect to the next rank " << next_rank_id;
+      return;
+    }
+    this->node_addresses_[next_rank_id] = next_rank_addr;
+
+    // The addresses of the other ranks are used to connect to them on demand, and to find the ranks on the same host.
+    for (size_t rank_id = 0; rank_id < this->total_node_num_; ++rank_id) {
+      if (rank_id == next_rank_id) {
+        continue;
+      }
+      std::string rank_addr = this->LookupAddress(rank_id);
+      if (rank_addr.empty()) {
+        MS_LOG(ERROR) << "Failed to get the address of rank " << rank_id;
+        return;
       }
-      MS_LOG(INFO) << "Retry to get the address of next rank : " << next_rank_name;
-      static const uint32_t interval = 3;
-      (void)sleep(interval);
+      this->node_addresses_[rank_id] = rank_addr;
     }
+    this->initialized_ = true;
   });
   return true;
 }
@@ -103,7 +108,7 @@ bool TopologyNode::Finalize() {
 }
 
 bool TopologyNode::SendAsync(size_t rank_id, const void *data, size_t size) {
-  if (tcp_clients_.find(rank_id) == tcp_clients_.end()) {
+  if (!Connect(rank_id)) {
     MS_LOG(ERROR) << "Cann not find tcp client for rank id: " << rank_id << ", local rank: " << rank_id_;
     return false;
   }
@@ -162,15 +167,62 @@ size_t TopologyNode::rank_id() const { return rank_id_; }
 
 size_t TopologyNode::rank_size() const { return total_node_num_; }
 
+std::string TopologyNode::GetRankHost(size_t rank_id) const {
+  auto iter = node_addresses_.find(rank_id);
+  if (iter == node_addresses_.end()) {
+    return "";
+  }
+  auto pos = iter->second.rfind(':');
+  return pos == std::string::npos ? iter->second : iter->second.substr(0, pos);
+}
+
+std::string TopologyNode::LookupAddress(size_t rank_id) const {
+  auto rank_name = "RNAK_ID_" + std::to_string(rank_id);
+  size_t retry = 60;
+  while (retry-- > 0) {
+    // Lookup the address from meta server node.
+    std::string rank_addr = cgn_->GetMetadata(rank_name);
+    if (rank_addr.length() > 0) {
+      return rank_addr;
+    }
+    MS_LOG(INFO) << "Retry to get the address of rank : " << rank_name;
+    static const uint32_t interval = 3;
+    (void)sleep(interval);
+  }
+  return "";
+}
+
+bool TopologyNode::Connect(size_t rank_id) {
+  if (tcp_clients_.find(rank_id) != tcp_clients_.end()) {
+    return true;
+  }
+  auto iter = node_addresses_.find(rank_id);
+  if (iter == node_addresses_.end()) {
+    MS_LOG(ERROR) << "Can not find the address for rank id: " << rank_id << ", local rank: " << rank_id_;
+    return false;
+  }
+  auto tcp_client = std::make_unique<distributed::rpc::TCPClient>();
+  if (!tcp_client->Initialize() || !tcp_client->Connect(iter->second)) {
+    MS_LOG(ERROR) << "Failed to connect to rank " << rank_id << ", address: " << iter->second;
+    tcp_client->Finalize();
+    return false;
+  }
+  tcp_clients_[rank_id] = tcp_client.release();
+  return true;
+}
+
 MessageBase *const TopologyNode::HandleMessage(MessageBase *const message) {
   MS_EXCEPTION_IF_NULL(message);
   auto rank_id = std::stoi(message->name);
 
   std::lock_guard<std::mutex> lock(cond_mutex_);
   std::queue<MessageBase *> *queue = nullptr;
-  if (received_messages_.find(rank_id) == received_messages_.end()) {
+  auto iter = received_messages_.find(rank_id);
+  if (iter == received_messages_.end()) {
     queue = new std::queue<MessageBase *>();
     received_messages_[rank_id] = queue;
+  } else {
+    queue = iter->second;
   }
   MS_EXCEPTION_IF_NULL(queue);
   queue->push(message);
@@ -34,8 +34,11 @@ namespace device {
 namespace cpu {
 class TopologyNode {
  public:
-  TopologyNode(size_t total_node_num, const std::shared_ptr<distributed::cluster::topology::ComputeGraphNode> &cgn)
-      : rank_id_(-1), total_node_num_(total_node_num), cgn_(cgn), initialized_(false) {}
+  // The tcp server of this node listens on the given ip, or on the ip of the first network interface if it is empty.
+  // The ranks are grouped by the ips of their tcp servers as their hosts.
+  TopologyNode(size_t total_node_num, const std::shared_ptr<distributed::cluster::topology::ComputeGraphNode> &cgn,
+               const std::string &ip = "")
+      : rank_id_(-1), total_node_num_(total_node_num), ip_(ip), cgn_(cgn), initialized_(false) {}
   ~TopologyNode() = default;
 
   // Init this topology node includes build tcp clients and server.
@@ -47,7 +50,7 @@ class TopologyNode {
   // Destroy tcp clients and the tcp server.
   bool Finalize();
 
-  // Send data asynchronously to the specified rank node.
+  // Send data asynchronously to the specified rank node. The connection to it is created on the first sending.
   bool SendAsync(size_t rank_id, const void *data, size_t size);
 
   // Wait for all the pending sending tasks to the rank_id to be finished.
@@ -60,16 +63,28 @@ class TopologyNode {
 
   size_t rank_size() const;
 
+  // Get the host of the specified rank node, which is the ip of its tcp server. Empty if it is unknown.
+  std::string GetRankHost(size_t rank_id) const;
+
  private:
   // Handle the message received by the tcp server.
   MessageBase *const HandleMessage(MessageBase *const message);
 
+  // Lookup the address of the specified rank node from the meta server node. Empty if it is not registered in time.
+  std::string LookupAddress(size_t rank_id) const;
+
+  // Create the tcp client to the specified rank node if it does not exist.
+  bool Connect(size_t rank_id);
+
   // The rank id of this node in the collective communication topology.
   size_t rank_id_;
 
   // The total topology node number.
   size_t total_node_num_;
 
+  // The ip the tcp server listens on.
+  std::string ip_;
+
   // The received messages sent from other rank nodes.
   std::map<size_t, std::queue<MessageBase *> *> received_messages_;
 
@@ -30,6 +30,7 @@
 #include "plugin/device/cpu/kernel/nnacl/fp32/power_fp32.h"
 #include "plugin/device/cpu/kernel/nnacl/fp32/sub_fp32.h"
 #include "plugin/device/cpu/kernel/nnacl/fp32/add_fp32.h"
+#include "plugin/device/cpu/kernel/utils/broadcast_utils.h"
 
 namespace mindspore {
 namespace kernel {
@@ -53,48 +54,29 @@ constexpr auto kSquaredDifference = "SquaredDifference";
 constexpr auto kXlogy = "Xlogy";
 constexpr auto kAtan2 = "Atan2";
 
+// dividend / divisor, where x / 0 is inf, -inf or nan, or the max or min value for the types without inf
 template <typename T>
-void ElementRealDiv(const T *input1, const T *input2, T *out, size_t size, size_t delta_1, size_t delta_2) {
-  size_t idx_1 = 0;
-  size_t idx_2 = 0;
+T DivideWithZero(T dividend, T divisor) {
   auto zero = static_cast<T>(0);
-  for (size_t i = 0; i < size; ++i) {
-    auto dividend = input1[idx_1];
-    auto divisor = input2[idx_2];
-    idx_1 += delta_1;
-    idx_2 += delta_2;
-    if (divisor == zero) {
-      if (dividend == zero) {
-        out[i] = std::numeric_limits<T>::quiet_NaN();
-        continue;
-      }
-      if (std::numeric_limits<T>::has_infinity) {
-        out[i] = dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-      } else {
-        out[i] = dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
-      }
-      continue;
+  if (divisor == zero) {
+    if (dividend == zero) {
+      return std::numeric_limits<T>::quiet_NaN();
+    }
+    if (std::numeric_limits<T>::has_infinity) {
+      return dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
     }
-    out[i] = static_cast<T>(dividend / divisor);
+    return dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
   }
+  return static_cast<T>(dividend / divisor);
 }
 
 template <typename T>
-void ElementRealDivComplex(const T *input1, const T *input2, T *out, size_t size, size_t delta_1, size_t delta_2) {
-  size_t idx_1 = 0;
-  size_t idx_2 = 0;
+T DivideComplexWithZero(T dividend, T divisor) {
   auto zero = static_cast<T>(0);
-  for (size_t i = 0; i < size; ++i) {
-    auto dividend = input1[idx_1];
-    auto divisor = input2[idx_2];
-    idx_1 += delta_1;
-    idx_2 += delta_2;
-    if (divisor == zero) {
-      out[i] = std::numeric_limits<T>::quiet_NaN();
-      continue;
-    }
-    out[i] = static_cast<T>(dividend / divisor);
+  if (divisor == zero) {
+    return std::numeric_limits<T>::quiet_NaN();
   }
+  return static_cast<T>(dividend / divisor);
 }
 
 template <typename T>
@@ -132,7 +114,7 @@ class ArithmeticCpuTypeFunc : public CpuKernelFunc {
     CPUKernelUtils::GetElementNumEveryDim(input_shape2_, &input_element_num2_);
     output_element_num_.clear();
     CPUKernelUtils::GetElementNumEveryDim(output_shape_, &output_element_num_);
-    is_init_broadcast_ = false;
+    broadcast_.Init(input_shape1_, input_shape2_, output_shape_);
     return KRET_OK;
   }
 
@@ -184,20 +166,15 @@ class ArithmeticCpuTypeFunc : public CpuKernelFunc {
   }
 
  private:
-  void InitBroadCast() {
-    BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-    base_iter.SetPos(0);
-    input_index1_.clear();
-    input_index2_.clear();
-    input_index1_.resize(output_size_);
-    input_index2_.resize(output_size_);
-    for (size_t i = 0; i < output_size_; i++) {
-      input_index1_[i] = base_iter.GetInputPosA();
-      input_index2_[i] = base_iter.GetInputPosB();
-      base_iter.GenNextPos();
-    }
-    is_init_broadcast_ = true;
+  // Run an elementwise op over the output, with the broadcast of the inputs classified by Resize
+  template <typename Op>
+  void BroadcastRun(const T *input1, const T *input2, T *out, const Op &op) {
+    auto task = [this, input1, input2, out, &op](size_t start, size_t end) {
+      broadcast_.Run(input1, input2, out, start, end, op);
+    };
+    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
   }
+
   void InitComputeFunc() {
     if (kernel_name_ == kAssignAdd || kernel_name_ == kAssignSub) {
       return;
@@ -248,13 +225,11 @@ class ArithmeticCpuTypeFunc : public CpuKernelFunc {
 
   ShapeVector input_shape1_;
   ShapeVector input_shape2_;
-  std::vector<size_t> input_index1_;
-  std::vector<size_t> input_index2_;
   std::vector<size_t> input_element_num1_;
   std::vector<size_t> input_element_num2_;
   ShapeVector output_shape_;
   std::vector<size_t> output_element_num_;
-  bool is_init_broadcast_{false};
+  BroadcastPlan broadcast_;
 
   using TypeComputeFunc = std::function<void(ArithmeticCpuTypeFunc *, const T *in_x, const T *in_y, T *out)>;
   TypeComputeFunc compute_func_{nullptr};
@@ -310,28 +285,12 @@ void ArithmeticCpuTypeFunc<T>::Add(const T *input1, const T *input2, T *out) {
       return;
     }
   }
-  if (!is_init_broadcast_) {
-    InitBroadCast();
-  }
-  auto task = [&](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(input1[input_index1_[i]] + input2[input_index2_[i]]);
-    }
-  };
-  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+  BroadcastRun(input1, input2, out, [](T x, T y) { return static_cast<T>(x + y); });
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::AddV2(const T *input1, const T *input2, T *out) {
-  if (!is_init_broadcast_) {
-    InitBroadCast();
-  }
-  auto task = [&](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(input1[input_index1_[i]] + input2[input_index2_[i]]);
-    }
-  };
-  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+  BroadcastRun(input1, input2, out, [](T x, T y) { return static_cast<T>(x + y); });
 }
 
 template <typename T>
@@ -356,15 +315,7 @@ void ArithmeticCpuTypeFunc<T>::Sub(const T *input1, const T *input2, T *out) {
       return;
     }
   }
-  if (!is_init_broadcast_) {
-    InitBroadCast();
-  }
-  auto task = [&](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(input1[input_index1_[i]] - input2[input_index2_[i]]);
-    }
-  };
-  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+  BroadcastRun(input1, input2, out, [](T x, T y) { return static_cast<T>(x - y); });
 }
 
 template <typename T>
@@ -389,291 +340,110 @@ void ArithmeticCpuTypeFunc<T>::Mul(const T *input1, const T *input2, T *out) {
       return;
     }
   }
-  if (!is_init_broadcast_) {
-    InitBroadCast();
+  if constexpr (std::is_same_v<T, bool>) {
+    BroadcastRun(input1, input2, out, [](T x, T y) { return static_cast<T>(x && y); });
+  } else {
+    BroadcastRun(input1, input2, out, [](T x, T y) { return static_cast<T>(x * y); });
   }
-  auto task = [&](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      if constexpr (std::is_same_v<T, bool>) {
-        out[i] = static_cast<T>(input1[input_index1_[i]] && input2[input_index2_[i]]);
-      } else {
-        out[i] = static_cast<T>(input1[input_index1_[i]] * input2[input_index2_[i]]);
-      }
-    }
-  };
-  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::RealDiv(const T *input1, const T *input2, T *out) {
-  if (input_shape1_ == input_shape2_) {
-    auto task = [&](size_t start, size_t end) {
-      ElementRealDiv<T>(input1 + start, input2 + start, out + start, end - start, 1, 1);
-    };
-    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-    return;
-  }
-  if (op_para_.in_elements_num0_ == 1) {
-    auto task = [&](size_t start, size_t end) {
-      ElementRealDiv<T>(input1, input2 + start, out + start, end - start, 0, 1);
-    };
-    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-    return;
-  }
-  if (op_para_.in_elements_num1_ == 1) {
-    auto task = [&](size_t start, size_t end) {
-      ElementRealDiv<T>(input1 + start, input2, out + start, end - start, 1, 0);
-    };
-    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-    return;
-  }
-
-  if (!is_init_broadcast_) {
-    InitBroadCast();
-  }
-  auto task = [&](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[input_index1_[i]];
-      auto divisor = input2[input_index2_[i]];
-
-      auto zero = static_cast<T>(0);
-      if (divisor == zero) {
-        if (dividend == zero) {
-          out[i] = std::numeric_limits<T>::quiet_NaN();
-          continue;
-        }
-        if (std::numeric_limits<T>::has_infinity) {
-          out[i] = dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-        } else {
-          out[i] = dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
-        }
-        continue;
-      }
-      out[i] = static_cast<T>(dividend / divisor);
-    }
-  };
-  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+  BroadcastRun(input1, input2, out, DivideWithZero<T>);
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::RealDivComplex(const T *input1, const T *input2, T *out) {
-  if (input_shape1_ == input_shape2_) {
-    auto task = [input1, input2, out](size_t start, size_t end) {
-      ElementRealDivComplex<T>(input1 + start, input2 + start, out + start, end - start, 1, 1);
-    };
-    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-    return;
-  }
-  if (op_para_.in_elements_num0_ == 1) {
-    auto task = [input1, input2, out](size_t start, size_t end) {
-      ElementRealDivComplex<T>(input1, input2 + start, out + start, end - start, 0, 1);
-    };
-    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-    return;
-  }
-  if (op_para_.in_elements_num1_ == 1) {
-    auto task = [input1, input2, out](size_t start, size_t end) {
-      ElementRealDivComplex<T>(input1 + start, input2, out + start, end - start, 1, 0);
-    };
-    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-    return;
-  }
-
-  if (!is_init_broadcast_) {
-    InitBroadCast();
-  }
-  auto task = [&](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[input_index1_[i]];
-      auto divisor = input2[input_index2_[i]];
-
-      auto zero = static_cast<T>(0);
-      if (divisor == zero) {
-        out[i] = std::numeric_limits<T>::quiet_NaN();
-        continue;
-      }
-      out[i] = static_cast<T>(dividend / divisor);
-    }
-  };
-  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+  BroadcastRun(input1, input2, out, DivideComplexWithZero<T>);
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::Div(const T *input1, const T *input2, T *out) {
-  if (!is_init_broadcast_) {
-    InitBroadCast();
-  }
-  auto task = [&](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[input_index1_[i]];
-      auto divisor = input2[input_index2_[i]];
-
-      auto zero = static_cast<T>(0);
-      if (divisor == zero) {
-        if (dividend == zero) {
-          out[i] = std::numeric_limits<T>::quiet_NaN();
-          continue;
-        }
-        if (std::numeric_limits<T>::has_infinity) {
-          out[i] = dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-        } else {
-          out[i] = dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
-        }
-        continue;
-      }
-      out[i] = static_cast<T>(dividend / divisor);
-    }
-  };
-  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+  BroadcastRun(input1, input2, out, DivideWithZero<T>);
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::DivComplex(const T *input1, const T *input2, T *out) {
-  if (!is_init_broadcast_) {
-    InitBroadCast();
-  }
-  auto task = [&](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[input_index1_[i]];
-      auto divisor = input2[input_index2_[i]];
-
-      auto zero = static_cast<T>(0);
-      if (divisor == zero) {
-        if (dividend == zero) {
-          out[i] = std::numeric_limits<T>::quiet_NaN();
-          continue;
-        }
-        continue;
-      }
-      out[i] = static_cast<T>(dividend / divisor);
+  BroadcastRun(input1, input2, out, [](T dividend, T divisor) {
+    auto zero = static_cast<T>(0);
+    if (divisor == zero && dividend == zero) {
+      return static_cast<T>(std::numeric_limits<T>::quiet_NaN());
     }
-  };
-  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+    return static_cast<T>(dividend / divisor);
+  });
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::DivNoNan(const T *input1, const T *input2, T *out) {
-  if (!is_init_broadcast_) {
-    InitBroadCast();
-  }
-  auto task = [&](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[input_index1_[i]];
-      auto divisor = input2[input_index2_[i]];
-
-      auto zero = static_cast<T>(0);
-      if constexpr (std::is_same_v<T, double>) {
-        if (common::IsDoubleEqual(divisor, zero)) {
-          out[i] = zero;
-          continue;
+  BroadcastRun(input1, input2, out, [](T dividend, T divisor) {
+    auto zero = static_cast<T>(0);
+    if constexpr (std::is_same_v<T, double>) {
+      if (common::IsDoubleEqual(divisor, zero)) {
+        return zero;
+      }
+    } else {
+      if constexpr (std::is_same_v<T, float>) {
+        if (common::IsFloatEqual(divisor, zero)) {
+          return zero;
         }
       } else {
-        if constexpr (std::is_same_v<T, float>) {
-          if (common::IsFloatEqual(divisor, zero)) {
-            out[i] = zero;
-            continue;
-          }
-        } else {
-          if (divisor == zero) {
-            out[i] = zero;
-            continue;
-          }
+        if (divisor == zero) {
+          return zero;
         }
       }
-      out[i] = static_cast<T>(dividend / divisor);
     }
-  };
-  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+    return static_cast<T>(dividend / divisor);
+  });
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::FloorDiv(const T *input1, const T *input2, T *out) {
-  if (!is_init_broadcast_) {
-    InitBroadCast();
-  }
-  auto task = [&](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[input_index1_[i]];
-      auto divisor = input2[input_index2_[i]];
-
-      auto zero = static_cast<T>(0);
-      if (divisor == zero) {
-        if (dividend == zero) {
-          out[i] = std::numeric_limits<T>::quiet_NaN();
-          continue;
-        }
-        if (std::numeric_limits<T>::has_infinity) {
-          out[i] = dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-        } else {
-          out[i] = dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
-        }
-        continue;
-      }
-      out[i] = static_cast<T>(floor(static_cast<double>(dividend) / static_cast<double>(divisor)));
+  BroadcastRun(input1, input2, out, [](T dividend, T divisor) {
+    auto zero = static_cast<T>(0);
+    if (divisor == zero) {
+      return DivideWithZero<T>(dividend, divisor);
     }
-  };
-  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+    return static_cast<T>(floor(static_cast<double>(dividend) / static_cast<double>(divisor)));
+  });
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::FloorDivComplex(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[iter.GetInputPosA()];
-      auto divisor = input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-      auto zero = static_cast<T>(0);
-      if (divisor == zero) {
-        out[i] = std::numeric_limits<T>::quiet_NaN();
-        continue;
-      }
-      auto temp = dividend / divisor;
-      out[i] = static_cast<T>(std::complex<double>(floor(temp.real()), 0));
+  BroadcastRun(input1, input2, out, [](T dividend, T divisor) {
+    auto zero = static_cast<T>(0);
+    if (divisor == zero) {
+      return static_cast<T>(std::numeric_limits<T>::quiet_NaN());
     }
-  };
-  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+    auto temp = dividend / divisor;
+    return static_cast<T>(std::complex<double>(floor(temp.real()), 0));
+  });
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::Mod(const T *input1, const T *input2, T *out) {
-  if (!is_init_broadcast_) {
-    InitBroadCast();
-  }
-  auto task = [&](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      auto x = static_cast<double>(input1[input_index1_[i]]);
-      auto y = static_cast<double>(input2[input_index2_[i]]);
+  BroadcastRun(input1, input2, out, [](T input_x, T input_y) {
+    auto x = static_cast<double>(input_x);
+    auto y = static_cast<double>(input_y);
 
-      auto data_div = x / y;
-      auto data_div_min = data_div < 0.0 ? data_div : 0.0;
-      auto data_div_max = data_div > 0.0 ? data_div : 0.0;
-      auto data_div_max_floor = floor(data_div_max);
-      auto data_div_min_ceil = ceil(data_div_min);
-      auto data_div_res = data_div_max_floor + data_div_min_ceil;
-      out[i] = static_cast<T>(x - data_div_res * y);
-    }
-  };
-  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+    auto data_div = x / y;
+    auto data_div_min = data_div < 0.0 ? data_div : 0.0;
+    auto data_div_max = data_div > 0.0 ? data_div : 0.0;
+    auto data_div_max_floor = floor(data_div_max);
+    auto data_div_min_ceil = ceil(data_div_min);
+    auto data_div_res = data_div_max_floor + data_div_min_ceil;
+    return static_cast<T>(x - data_div_res * y);
+  });
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::FloorMod(const T *input1, const T *input2, T *out) {
-  if (!is_init_broadcast_) {
-    InitBroadCast();
-  }
-  auto task = [&](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      auto x = static_cast<double>(input1[input_index1_[i]]);
-      auto y = static_cast<double>(input2[input_index2_[i]]);
+  BroadcastRun(input1, input2, out, [](T input_x, T input_y) {
+    auto x = static_cast<double>(input_x);
+    auto y = static_cast<double>(input_y);
 
-      auto res = x - floor(x / y) * y;
-      out[i] = static_cast<T>((std::abs(res) > 1e-9) && ((res < 0.0) != (y < 0.0)) ? res + y : res);
-    }
-  };
-  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+    auto res = x - floor(x / y) * y;
+    return static_cast<T>((std::abs(res) > 1e-9) && ((res < 0.0) != (y < 0.0)) ? res + y : res);
+  });
 }
 
 template <typename T>
@@ -709,115 +479,60 @@ void ArithmeticCpuTypeFunc<T>::Pow(const T *input1, const T *input2, T *out) {
     }
   }
 
-  if (!is_init_broadcast_) {
-    InitBroadCast();
-  }
+  auto pow_func = [](T x, T y) { return static_cast<T>(std::pow(static_cast<double>(x), static_cast<double>(y))); };
   if (output_size_ > kMaxPowSerialSize) {
-    auto task = [&](size_t start, size_t end) {
-      for (size_t i = start; i < end; i++) {
-        auto x = static_cast<double>(input1[input_index1_[i]]);
-        auto y = static_cast<double>(input2[input_index2_[i]]);
-        out[i] = static_cast<T>(std::pow(x, y));
-      }
-    };
-    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+    BroadcastRun(input1, input2, out, pow_func);
   } else {
-    for (size_t i = 0; i < output_size_; i++) {
-      auto sx = static_cast<double>(input1[input_index1_[i]]);
-      auto sy = static_cast<double>(input2[input_index2_[i]]);
-      out[i] = static_cast<T>(std::pow(sx, sy));
-    }
+    broadcast_.Run(input1, input2, out, 0, output_size_, pow_func);
   }
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::PowComplex(const T *input1, const T *input2, T *out) {
-  if (!is_init_broadcast_) {
-    InitBroadCast();
-  }
+  auto pow_func = [](T x, T y) { return static_cast<T>(std::pow(x, y)); };
   if (output_size_ > kMaxPowSerialSize) {
-    auto task = [&](size_t start, size_t end) {
-      for (size_t i = start; i < end; i++) {
-        auto x = (input1[input_index1_[i]]);
-        auto y = (input2[input_index2_[i]]);
-        out[i] = static_cast<T>(std::pow(x, y));
-      }
-    };
-    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+    BroadcastRun(input1, input2, out, pow_func);
   } else {
-    for (size_t i = 0; i < output_size_; i++) {
-      auto sx = (input1[input_index1_[i]]);
-      auto sy = (input2[input_index2_[i]]);
-      out[i] = static_cast<T>(std::pow(sx, sy));
-    }
+    broadcast_.Run(input1, input2, out, 0, output_size_, pow_func);
   }
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::SquaredDifference(const T *input1, const T *input2, T *out) {
-  if (!is_init_broadcast_) {
-    InitBroadCast();
-  }
-  auto task = [&](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      T diff = input1[input_index1_[i]] - input2[input_index2_[i]];
-      if constexpr (std::is_same_v<T, bool>) {
-        out[i] = static_cast<T>(diff);
-      } else {
-        out[i] = static_cast<T>(diff * diff);
-      }
+  BroadcastRun(input1, input2, out, [](T x, T y) {
+    T diff = x - y;
+    if constexpr (std::is_same_v<T, bool>) {
+      return static_cast<T>(diff);
+    } else {
+      return static_cast<T>(diff * diff);
     }
-  };
-  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+  });
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::SquaredDifferenceComplex(const T *input1, const T *input2, T *out) {
-  if (!is_init_broadcast_) {
-    InitBroadCast();
-  }
-  auto task = [&](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      T diff = input1[input_index1_[i]] - input2[input_index2_[i]];
-      out[i] = static_cast<T>(std::conj(diff) * diff);
-    }
-  };
-  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+  BroadcastRun(input1, input2, out, [](T x, T y) {
+    T diff = x - y;
+    return static_cast<T>(std::conj(diff) * diff);
+  });
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::Xlogy(const T *input1, const T *input2, T *out) {
-  if (!is_init_broadcast_) {
-    InitBroadCast();
-  }
-  auto task = [&](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      auto x1 = input1[input_index1_[i]];
-      auto x2 = input2[input_index2_[i]];
-      auto logx2 = log(x2);
-
-      if constexpr (std::is_same_v<T, bool>) {
-        out[i] = static_cast<T>(x1 && static_cast<bool>(logx2));
-      } else {
-        out[i] = static_cast<T>(x1 * logx2);
-      }
+  BroadcastRun(input1, input2, out, [](T x1, T x2) {
+    auto logx2 = log(x2);
+    if constexpr (std::is_same_v<T, bool>) {
+      return static_cast<T>(x1 && static_cast<bool>(logx2));
+    } else {
+      return static_cast<T>(x1 * logx2);
     }
-  };
-  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+  });
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::Atan2(const T *input1, const T *input2, T *out) {
-  if (!is_init_broadcast_) {
-    InitBroadCast();
-  }
-  auto task = [&](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(
-        atan2(static_cast<double>(input1[input_index1_[i]]), static_cast<double>(input2[input_index2_[i]])));
-    }
-  };
-  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+  BroadcastRun(input1, input2, out,
+               [](T x, T y) { return static_cast<T>(atan2(static_cast<double>(x), static_cast<double>(y))); });
 }
 
 template <typename T>
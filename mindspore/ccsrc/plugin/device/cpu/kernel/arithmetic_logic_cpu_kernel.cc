@@ -26,6 +26,7 @@
 #include <complex>
 
 #include "plugin/device/cpu/hal/device/cpu_device_address.h"
+#include "plugin/device/cpu/kernel/utils/broadcast_utils.h"
 
 namespace mindspore {
 namespace kernel {
@@ -109,6 +110,7 @@ class ArithLogicCpuTypeFunc : public CpuKernelFunc {
     CPUKernelUtils::GetElementNumEveryDim(input_shape1_, &input_element_num1_);
     CPUKernelUtils::GetElementNumEveryDim(input_shape2_, &input_element_num2_);
     CPUKernelUtils::GetElementNumEveryDim(output_shape_, &output_element_num_);
+    broadcast_.Init(input_shape1_, input_shape2_, output_shape_);
     return KRET_OK;
   }
 
@@ -138,6 +140,7 @@ class ArithLogicCpuTypeFunc : public CpuKernelFunc {
   std::vector<size_t> input_element_num2_;
   ShapeVector output_shape_;
   std::vector<size_t> output_element_num_;
+  BroadcastPlan broadcast_;
 };
 
 template <typename T>
@@ -194,6 +197,7 @@ class ArithComplexLogicCpuTypeFunc : public CpuKernelFunc {
     CPUKernelUtils::GetElementNumEveryDim(input_shape1_, &input_element_num1_);
     CPUKernelUtils::GetElementNumEveryDim(input_shape2_, &input_element_num2_);
     CPUKernelUtils::GetElementNumEveryDim(output_shape_, &output_element_num_);
+    broadcast_.Init(input_shape1_, input_shape2_, output_shape_);
     return KRET_OK;
   }
 
@@ -216,102 +220,25 @@ class ArithComplexLogicCpuTypeFunc : public CpuKernelFunc {
   std::vector<size_t> input_element_num2_;
   ShapeVector output_shape_;
   std::vector<size_t> output_element_num_;
+  BroadcastPlan broadcast_;
 };
 
 template <typename T>
 template <typename Op>
 void ArithLogicCpuTypeFunc<T>::BinaryOp(const T *input1, const T *input2, bool *out, Op op) {
-  int64_t input1_size = 1;
-  int64_t input2_size = 1;
-
-  for (size_t i = 0; i < output_shape_.size(); i++) {
-    input1_size *= input_shape1_[i];
-    input2_size *= input_shape2_[i];
-  }
-
-  if (input_shape1_ == input_shape2_) {
-    auto task = [this, input1, input2, out, op](size_t start, size_t end) {
-      for (size_t i = start; i < end; i++) {
-        out[i] = op(input1[i], input2[i]);
-      }
-    };
-    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-  } else if (input1_size == 1) {
-    auto task = [this, input1, input2, out, op](size_t start, size_t end) {
-      for (size_t i = start; i < end; i++) {
-        out[i] = op(input1[0], input2[i]);
-      }
-    };
-    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-  } else if (input2_size == 1) {
-    auto task = [this, input1, input2, out, op](size_t start, size_t end) {
-      for (size_t i = start; i < end; i++) {
-        out[i] = op(input1[i], input2[0]);
-      }
-    };
-    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-  } else {
-    BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-    auto task = [this, input1, input2, out, op, &base_iter](size_t start, size_t end) {
-      auto iter = base_iter;
-      iter.SetPos(start);
-      for (size_t i = start; i < end; i++) {
-        auto x = input1[iter.GetInputPosA()];
-        auto y = input2[iter.GetInputPosB()];
-        out[i] = op(x, y);
-        iter.GenNextPos();
-      }
-    };
-    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-  }
+  auto task = [this, input1, input2, out, &op](size_t start, size_t end) {
+    broadcast_.Run(input1, input2, out, start, end, op);
+  };
+  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
 }
 
 template <typename T>
 template <typename Op>
 void ArithComplexLogicCpuTypeFunc<T>::BinaryOp(const T *input1, const T *input2, bool *out, Op op) {
-  int64_t input1_size = 1;
-  int64_t input2_size = 1;
-
-  for (size_t i = 0; i < output_shape_.size(); i++) {
-    input1_size *= input_shape1_[i];
-    input2_size *= input_shape2_[i];
-  }
-
-  if (input_shape1_ == input_shape2_) {
-    auto task = [this, input1, input2, out, op](size_t start, size_t end) {
-      for (size_t i = start; i < end; i++) {
-        out[i] = op(input1[i], input2[i]);
-      }
-    };
-    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-  } else if (input1_size == 1) {
-    auto task = [this, input1, input2, out, op](size_t start, size_t end) {
-      for (size_t i = start; i < end; i++) {
-        out[i] = op(input1[0], input2[i]);
-      }
-    };
-    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-  } else if (input2_size == 1) {
-    auto task = [this, input1, input2, out, op](size_t start, size_t end) {
-      for (size_t i = start; i < end; i++) {
-        out[i] = op(input1[i], input2[0]);
-      }
-    };
-    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-  } else {
-    BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-    auto task = [this, input1, input2, out, op, &base_iter](size_t start, size_t end) {
-      auto iter = base_iter;
-      iter.SetPos(start);
-      for (size_t i = start; i < end; i++) {
-        auto x = input1[iter.GetInputPosA()];
-        auto y = input2[iter.GetInputPosB()];
-        out[i] = op(x, y);
-        iter.GenNextPos();
-      }
-    };
-    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-  }
+  auto task = [this, input1, input2, out, &op](size_t start, size_t end) {
+    broadcast_.Run(input1, input2, out, start, end, op);
+  };
+  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
 }
 
 template <typename T>
@@ -341,28 +268,16 @@ void ArithLogicCpuTypeFunc<T>::LogicalOr(const T *input1, const T *input2, bool
 
 template <typename T>
 void ArithLogicCpuTypeFunc<T>::LogicalXor(const T *input1, const T *input2, bool *out) const {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [input1, input2, out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    if constexpr (std::is_same_v<T, float>) {
-      for (size_t i = start; i < end; i++) {
-        out[i] = !(common::IsFloatEqual(input1[iter.GetInputPosA()], input2[iter.GetInputPosB()]));
-        iter.GenNextPos();
-      }
-    } else {
-      if constexpr (std::is_same_v<T, double>) {
-        for (size_t i = start; i < end; i++) {
-          out[i] = !(common::IsDoubleEqual(input1[iter.GetInputPosA()], input2[iter.GetInputPosB()]));
-          iter.GenNextPos();
-        }
+  auto task = [this, input1, input2, out](size_t start, size_t end) {
+    broadcast_.Run(input1, input2, out, start, end, [](T x, T y) {
+      if constexpr (std::is_same_v<T, float>) {
+        return !common::IsFloatEqual(x, y);
+      } else if constexpr (std::is_same_v<T, double>) {
+        return !common::IsDoubleEqual(x, y);
       } else {
-        for (size_t i = start; i < end; i++) {
-          out[i] = input1[iter.GetInputPosA()] != input2[iter.GetInputPosB()];
-          iter.GenNextPos();
-        }
+        return x != y;
       }
-    }
+    });
   };
   CPUKernelUtils::ParallelFor(task, output_size_);
 }
@@ -26,9 +26,38 @@
 #include "utils/profile.h"
 #include "runtime/graph_scheduler/actor/actor_common.h"
 #include "kernel/common_utils.h"
+#include "plugin/device/cpu/kernel/parallel_tuning_cache.h"
 
 namespace mindspore {
 namespace kernel {
+namespace {
+// Skip the search of the kernel launched by the current thread if the tuning cache has its block size.
+bool FindTunedBlockSize(size_t count, size_t thread_num, size_t search_end, ParallelSearchInfo *parallel_search_info) {
+  auto kernel_key = ParallelTuningCache::CurrentKernel();
+  if (kernel_key == nullptr) {
+    return false;
+  }
+  float block_size = 0;
+  if (!ParallelTuningCache::GetInstance().Find(ParallelTuningCache::SearchKey(*kernel_key, count, thread_num),
+                                               &block_size)) {
+    return false;
+  }
+  parallel_search_info->best_block_size = block_size;
+  parallel_search_info->search_count = search_end;
+  return true;
+}
+
+// Record the block size found by a finished search in the tuning cache.
+void UpdateTunedBlockSize(size_t count, size_t thread_num, const ParallelSearchInfo &parallel_search_info) {
+  auto kernel_key = ParallelTuningCache::CurrentKernel();
+  if (kernel_key == nullptr) {
+    return;
+  }
+  ParallelTuningCache::GetInstance().Update(ParallelTuningCache::SearchKey(*kernel_key, count, thread_num),
+                                            parallel_search_info.best_block_size, parallel_search_info.min_cost_time);
+}
+}  // namespace
+
 std::vector<KernelAttr> NativeCpuKernelMod::GetAllSupportedList(const std::string &kernel_name) {
   auto iter = support_map_.find(kernel_name);
   if (iter == support_map_.end()) {
@@ -221,6 +250,12 @@ void CPUKernelUtils::ParallelForAutoSearch(const CTask &task, size_t count, Para
   const size_t MAX_POW = 6;
   const size_t AVG_COUNT = 5;
   MS_EXCEPTION_IF_NULL(parallel_search_info);
+  auto thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
+  if (parallel_search_info->search_count == 0 &&
+      FindTunedBlockSize(count, thread_num, AVG_COUNT * MAX_POW, parallel_search_info)) {
+    ParallelFor(task, count, parallel_search_info->best_block_size);
+    return;
+  }
   size_t current_pow = parallel_search_info->search_count / AVG_COUNT;
   if (current_pow < MAX_POW) {
     if (parallel_search_info->search_count % AVG_COUNT == 0) {
@@ -241,6 +276,9 @@ void CPUKernelUtils::ParallelForAutoSearch(const CTask &task, size_t count, Para
       } else if (current_pow - parallel_search_info->best_pow >= 2) {
         parallel_search_info->search_count = AVG_COUNT * MAX_POW;
       }
+      if (parallel_search_info->search_count >= AVG_COUNT * MAX_POW) {
+        UpdateTunedBlockSize(count, thread_num, *parallel_search_info);
+      }
     }
   } else {
     ParallelFor(task, count, parallel_search_info->best_block_size);
@@ -321,12 +359,14 @@ void ParallelLaunch(const std::vector<common::Task> &tasks, Content content, Thr
 
 void ParallelLaunchAutoSearch(const CTask &task, size_t count, Content content,
                               ParallelSearchInfo *parallel_search_info, ThreadPool *pool) {
+  MS_EXCEPTION_IF_NULL(parallel_search_info);
   if (!parallel_search_info->kernel_thread_num_set) {
     auto thread_pool = pool == nullptr ? GetActorMgrInnerThreadPool() : pool;
     size_t kernel_thread_num = thread_pool->GetKernelThreadNum();
     if (kernel_thread_num == 0) {
       MS_LOG(EXCEPTION) << "Actor inner pool has been init, but kernel thread is 0!";
     }
+    parallel_search_info->kernel_thread_num = kernel_thread_num;
     size_t max_pow_current = parallel_search_info->max_pow - 1;
     while (std::pow(2.0f, max_pow_current) <= static_cast<float>(kernel_thread_num)) {
       max_pow_current++;
@@ -335,6 +375,12 @@ void ParallelLaunchAutoSearch(const CTask &task, size_t count, Content content,
     parallel_search_info->kernel_thread_num_set = true;
   }
   const size_t AVG_COUNT = 5;
+  const size_t search_end = AVG_COUNT * parallel_search_info->max_pow;
+  if (parallel_search_info->search_count == 0 &&
+      FindTunedBlockSize(count, parallel_search_info->kernel_thread_num, search_end, parallel_search_info)) {
+    ParallelLaunch(task, count, parallel_search_info->best_block_size, content, pool);
+    return;
+  }
   size_t current_pow = parallel_search_info->search_count / AVG_COUNT;
   if (current_pow < parallel_search_info->max_pow) {
     if (parallel_search_info->search_count % AVG_COUNT == 0) {
@@ -353,7 +399,10 @@ void ParallelLaunchAutoSearch(const CTask &task, size_t count, Content content,
         parallel_search_info->best_block_size = block_size;
         parallel_search_info->best_pow = current_pow;
       } else if (current_pow - parallel_search_info->best_pow >= 2) {
-        parallel_search_info->search_count = AVG_COUNT * parallel_search_info->max_pow;
+        parallel_search_info->search_count = search_end;
+      }
+      if (parallel_search_info->search_count >= search_end) {
+        UpdateTunedBlockSize(count, parallel_search_info->kernel_thread_num, *parallel_search_info);
       }
     }
   } else {
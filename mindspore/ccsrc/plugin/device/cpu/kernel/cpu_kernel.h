@@ -36,6 +36,7 @@
 #include "actor/actormgr.h"
 #include "include/common/thread_pool.h"
 #include "include/backend/visible.h"
+#include "plugin/device/cpu/kernel/parallel_tuning_cache.h"
 
 using mindspore::kernel::Address;
 using mindspore::kernel::AddressPtr;
@@ -132,6 +133,7 @@ struct ParallelSearchInfo {
   size_t best_pow{0};
   size_t search_count{0};
   bool kernel_thread_num_set{false};
+  size_t kernel_thread_num{0};
   size_t max_pow{6};
 };
 
@@ -142,6 +144,7 @@ class BACKEND_EXPORT NativeCpuKernelMod : public CpuKernelMod {
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs, void * /*stream_ptr*/) override {
+    ParallelTuningKernelGuard guard(parallel_tuning_key_.empty() ? nullptr : &parallel_tuning_key_);
     return Launch(inputs, workspace, outputs);
   }
   virtual bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
@@ -150,6 +153,10 @@ class BACKEND_EXPORT NativeCpuKernelMod : public CpuKernelMod {
   // Must be called before Init.
   void SetThreadPool(ThreadPool *pool) { pool_ = pool; }
 
+  // The key of the kernel in ParallelTuningCache, the searches of its launches are shared with the kernels of the
+  // same key. The searches are not shared if it is empty.
+  void SetParallelTuningKey(const std::string &key) { parallel_tuning_key_ = key; }
+
   static std::vector<KernelAttr> GetCpuSupportedList(const std::string &kernel_name) {
     auto temp_mod = kernel::Factory<NativeCpuKernelMod>::Instance().Create(kernel_name);
     if (temp_mod == nullptr) {
@@ -169,6 +176,7 @@ class BACKEND_EXPORT NativeCpuKernelMod : public CpuKernelMod {
   ThreadPool *pool_{nullptr};
 
  private:
+  std::string parallel_tuning_key_;
   std::vector<KernelAttr> GetAllSupportedList(const std::string &kernel_name);
   std::vector<KernelAttr> GetSupportFromOpLib(const std::string &kernel_name) const;
   inline static mindspore::HashMap<std::string, std::vector<KernelAttr>> support_map_;
@@ -23,6 +23,7 @@ typedef struct AttentionParameter {
   int head_num_;
   int head_size_;
   bool cross_;
+  int max_cache_len_;  // the max length of the key/value cache of the incremental decoding, 0 for no cache
 } AttentionParameter;
 
 typedef struct RelativePositionAttentionParameter {
@@ -1,26 +1,28 @@
 /**
- * Copyright 2022 Huawei Technologies Co., Ltd
- *
- * Licensed under the Apache License, Version 2.0 (the "License");
- * you may not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- * http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
+* Copyright 2022 Huawei Technologies Co., Ltd
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
 #include <x86intrin.h>
 #include "nnacl/fp32/matmul_avx512_mask_fp32.h"
 // clang-format off
-// nnacl gemm in x86 avx512 asm code
-void nnacl_gemm_avx512_1x32_mask_kernel_nhwc_fp32(float *dst, const float *src, const float *weight, const float *bias,
-                                                  const size_t act_flag, const size_t row_block, const size_t col_block,
-                                                  const size_t depth, const size_t src_stride, const size_t dst_stride,
-                                                  const size_t inc_flag, const u_int16_t *mask) {
+// nnacl gemm in x86 avx512 asm code, the depth is split over 4 sets of accumulators
+void nnacl_gemm_avx512_1x32_mask_split_kernel_nhwc_fp32(float *dst, const float *src, const float *weight,
+                                                        const float *bias, const size_t act_flag,
+                                                        const size_t row_block, const size_t col_block,
+                                                        const size_t depth, const size_t src_stride,
+                                                        const size_t dst_stride, const size_t inc_flag,
+                                                        const u_int16_t *mask) {
   size_t dst_stride_t = dst_stride << 2;
   asm volatile(
     // inc in depth
@@ -44,9 +46,16 @@ void nnacl_gemm_avx512_1x32_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vxorps %%zmm1, %%zmm1, %%zmm1\n"
     ".align 16\n"
     "2:\n"
+    "vxorps %%zmm2, %%zmm2, %%zmm2\n"
+    "vxorps %%zmm3, %%zmm3, %%zmm3\n"
+    "vxorps %%zmm4, %%zmm4, %%zmm4\n"
+    "vxorps %%zmm5, %%zmm5, %%zmm5\n"
+    "vxorps %%zmm6, %%zmm6, %%zmm6\n"
+    "vxorps %%zmm7, %%zmm7, %%zmm7\n"
     :
-    : [ dst_0 ] "r"(dst), [ bias ] "r"(bias), [ dst_stride ] "r"(dst_stride_t), [ inc_flag ] "r"(inc_flag), [ mask ] "r"(mask)
-    : "%rax", "%k1", "%zmm0", "%zmm1");
+    : [ dst_0 ] "r"(dst), [ bias ] "r"(bias), [ dst_stride ] "r"(dst_stride_t), [ inc_flag ] "r"(inc_flag),
+      [ mask ] "r"(mask)
+    : "%rax", "%k1", "%zmm0", "%zmm1", "%zmm2", "%zmm3", "%zmm4", "%zmm5", "%zmm6", "%zmm7");
   size_t src_stride_t = src_stride << 2;
   asm volatile(
     "kmovw (%[mask]), %%k1\n"
@@ -64,20 +73,20 @@ void nnacl_gemm_avx512_1x32_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vmovups 128(%[weight]), %%zmm31\n"
     "vmovups 192(%[weight]), %%zmm30\n"
     "vbroadcastss 4(%[src_0]), %%zmm29\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm2\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm3 %{{%%k1}}\n"
     // block 2
     "vmovups 256(%[weight]), %%zmm31\n"
     "vmovups 320(%[weight]), %%zmm30\n"
     "vbroadcastss 8(%[src_0]), %%zmm29\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm4\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm5 %{{%%k1}}\n"
     // block 3
     "vmovups 384(%[weight]), %%zmm31\n"
     "vmovups 448(%[weight]), %%zmm30\n"
     "vbroadcastss 12(%[src_0]), %%zmm29\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm7 %{{%%k1}}\n"
     // block 4
     "vmovups 512(%[weight]), %%zmm31\n"
     "vmovups 576(%[weight]), %%zmm30\n"
@@ -88,20 +97,20 @@ void nnacl_gemm_avx512_1x32_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vmovups 640(%[weight]), %%zmm31\n"
     "vmovups 704(%[weight]), %%zmm30\n"
     "vbroadcastss 20(%[src_0]), %%zmm29\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm2\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm3 %{{%%k1}}\n"
     // block 6
     "vmovups 768(%[weight]), %%zmm31\n"
     "vmovups 832(%[weight]), %%zmm30\n"
     "vbroadcastss 24(%[src_0]), %%zmm29\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm4\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm5 %{{%%k1}}\n"
     // block 7
     "vmovups 896(%[weight]), %%zmm31\n"
     "vmovups 960(%[weight]), %%zmm30\n"
     "vbroadcastss 28(%[src_0]), %%zmm29\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm7 %{{%%k1}}\n"
     // block 8
     "vmovups 1024(%[weight]), %%zmm31\n"
     "vmovups 1088(%[weight]), %%zmm30\n"
@@ -112,20 +121,20 @@ void nnacl_gemm_avx512_1x32_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vmovups 1152(%[weight]), %%zmm31\n"
     "vmovups 1216(%[weight]), %%zmm30\n"
     "vbroadcastss 36(%[src_0]), %%zmm29\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm2\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm3 %{{%%k1}}\n"
     // block 10
     "vmovups 1280(%[weight]), %%zmm31\n"
     "vmovups 1344(%[weight]), %%zmm30\n"
     "vbroadcastss 40(%[src_0]), %%zmm29\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm4\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm5 %{{%%k1}}\n"
     // block 11
     "vmovups 1408(%[weight]), %%zmm31\n"
     "vmovups 1472(%[weight]), %%zmm30\n"
     "vbroadcastss 44(%[src_0]), %%zmm29\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm7 %{{%%k1}}\n"
     // block 12
     "vmovups 1536(%[weight]), %%zmm31\n"
     "vmovups 1600(%[weight]), %%zmm30\n"
@@ -136,20 +145,20 @@ void nnacl_gemm_avx512_1x32_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vmovups 1664(%[weight]), %%zmm31\n"
     "vmovups 1728(%[weight]), %%zmm30\n"
     "vbroadcastss 52(%[src_0]), %%zmm29\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm2\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm3 %{{%%k1}}\n"
     // block 14
     "vmovups 1792(%[weight]), %%zmm31\n"
     "vmovups 1856(%[weight]), %%zmm30\n"
     "vbroadcastss 56(%[src_0]), %%zmm29\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm4\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm5 %{{%%k1}}\n"
     // block 15
     "vmovups 1920(%[weight]), %%zmm31\n"
     "vmovups 1984(%[weight]), %%zmm30\n"
     "vbroadcastss 60(%[src_0]), %%zmm29\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm7 %{{%%k1}}\n"
     "add $2048, %[weight]\n"
     "add $64, %[src_0]\n"
     "sub $16, %[depth]\n"
@@ -171,6 +180,13 @@ void nnacl_gemm_avx512_1x32_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "jg 1b\n"
     ".align 16\n"
     "2:\n"
+    // reduce the accumulators of the split depth
+    "vaddps %%zmm0, %%zmm4, %%zmm0\n"
+    "vaddps %%zmm1, %%zmm5, %%zmm1\n"
+    "vaddps %%zmm2, %%zmm6, %%zmm2\n"
+    "vaddps %%zmm3, %%zmm7, %%zmm3\n"
+    "vaddps %%zmm0, %%zmm2, %%zmm0\n"
+    "vaddps %%zmm1, %%zmm3, %%zmm1\n"
     "and $0x2, %[inc_flag]\n"
     "je 3f\n"
     "and $0x3, %[act_flag]\n"
@@ -1,26 +1,28 @@
 /**
- * Copyright 2022 Huawei Technologies Co., Ltd
- *
- * Licensed under the Apache License, Version 2.0 (the "License");
- * you may not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- * http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
+* Copyright 2022 Huawei Technologies Co., Ltd
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
 #include <x86intrin.h>
 #include "nnacl/fp32/matmul_avx512_mask_fp32.h"
 // clang-format off
-// nnacl gemm in x86 avx512 asm code
-void nnacl_gemm_avx512_1x64_mask_kernel_nhwc_fp32(float *dst, const float *src, const float *weight, const float *bias,
-                                                  const size_t act_flag, const size_t row_block, const size_t col_block,
-                                                  const size_t depth, const size_t src_stride, const size_t dst_stride,
-                                                  const size_t inc_flag, const u_int16_t *mask) {
+// nnacl gemm in x86 avx512 asm code, the depth is split over 2 sets of accumulators
+void nnacl_gemm_avx512_1x64_mask_split_kernel_nhwc_fp32(float *dst, const float *src, const float *weight,
+                                                        const float *bias, const size_t act_flag,
+                                                        const size_t row_block, const size_t col_block,
+                                                        const size_t depth, const size_t src_stride,
+                                                        const size_t dst_stride, const size_t inc_flag,
+                                                        const u_int16_t *mask) {
   size_t dst_stride_t = dst_stride << 2;
   asm volatile(
     // inc in depth
@@ -50,9 +52,14 @@ void nnacl_gemm_avx512_1x64_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vxorps %%zmm3, %%zmm3, %%zmm3\n"
     ".align 16\n"
     "2:\n"
+    "vxorps %%zmm4, %%zmm4, %%zmm4\n"
+    "vxorps %%zmm5, %%zmm5, %%zmm5\n"
+    "vxorps %%zmm6, %%zmm6, %%zmm6\n"
+    "vxorps %%zmm7, %%zmm7, %%zmm7\n"
     :
-    : [ dst_0 ] "r"(dst), [ bias ] "r"(bias), [ dst_stride ] "r"(dst_stride_t), [ inc_flag ] "r"(inc_flag), [ mask ] "r"(mask)
-    : "%rax", "%k1", "%zmm0", "%zmm1", "%zmm2", "%zmm3");
+    : [ dst_0 ] "r"(dst), [ bias ] "r"(bias), [ dst_stride ] "r"(dst_stride_t), [ inc_flag ] "r"(inc_flag),
+      [ mask ] "r"(mask)
+    : "%rax", "%k1", "%zmm0", "%zmm1", "%zmm2", "%zmm3", "%zmm4", "%zmm5", "%zmm6", "%zmm7");
   size_t src_stride_t = src_stride << 2;
   asm volatile(
     "kmovw (%[mask]), %%k1\n"
@@ -76,10 +83,10 @@ void nnacl_gemm_avx512_1x64_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vmovups 384(%[weight]), %%zmm29\n"
     "vmovups 448(%[weight]), %%zmm28\n"
     "vbroadcastss 4(%[src_0]), %%zmm27\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm27, %%zmm1\n"
-    "vfmadd231ps %%zmm29, %%zmm27, %%zmm2\n"
-    "vfmadd231ps %%zmm28, %%zmm27, %%zmm3 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm4\n"
+    "vfmadd231ps %%zmm30, %%zmm27, %%zmm5\n"
+    "vfmadd231ps %%zmm29, %%zmm27, %%zmm6\n"
+    "vfmadd231ps %%zmm28, %%zmm27, %%zmm7 %{{%%k1}}\n"
     // block 2
     "vmovups 512(%[weight]), %%zmm31\n"
     "vmovups 576(%[weight]), %%zmm30\n"
@@ -96,10 +103,10 @@ void nnacl_gemm_avx512_1x64_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vmovups 896(%[weight]), %%zmm29\n"
     "vmovups 960(%[weight]), %%zmm28\n"
     "vbroadcastss 12(%[src_0]), %%zmm27\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm27, %%zmm1\n"
-    "vfmadd231ps %%zmm29, %%zmm27, %%zmm2\n"
-    "vfmadd231ps %%zmm28, %%zmm27, %%zmm3 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm4\n"
+    "vfmadd231ps %%zmm30, %%zmm27, %%zmm5\n"
+    "vfmadd231ps %%zmm29, %%zmm27, %%zmm6\n"
+    "vfmadd231ps %%zmm28, %%zmm27, %%zmm7 %{{%%k1}}\n"
     // block 4
     "vmovups 1024(%[weight]), %%zmm31\n"
     "vmovups 1088(%[weight]), %%zmm30\n"
@@ -116,10 +123,10 @@ void nnacl_gemm_avx512_1x64_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vmovups 1408(%[weight]), %%zmm29\n"
     "vmovups 1472(%[weight]), %%zmm28\n"
     "vbroadcastss 20(%[src_0]), %%zmm27\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm27, %%zmm1\n"
-    "vfmadd231ps %%zmm29, %%zmm27, %%zmm2\n"
-    "vfmadd231ps %%zmm28, %%zmm27, %%zmm3 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm4\n"
+    "vfmadd231ps %%zmm30, %%zmm27, %%zmm5\n"
+    "vfmadd231ps %%zmm29, %%zmm27, %%zmm6\n"
+    "vfmadd231ps %%zmm28, %%zmm27, %%zmm7 %{{%%k1}}\n"
     // block 6
     "vmovups 1536(%[weight]), %%zmm31\n"
     "vmovups 1600(%[weight]), %%zmm30\n"
@@ -136,10 +143,10 @@ void nnacl_gemm_avx512_1x64_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vmovups 1920(%[weight]), %%zmm29\n"
     "vmovups 1984(%[weight]), %%zmm28\n"
     "vbroadcastss 28(%[src_0]), %%zmm27\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm27, %%zmm1\n"
-    "vfmadd231ps %%zmm29, %%zmm27, %%zmm2\n"
-    "vfmadd231ps %%zmm28, %%zmm27, %%zmm3 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm4\n"
+    "vfmadd231ps %%zmm30, %%zmm27, %%zmm5\n"
+    "vfmadd231ps %%zmm29, %%zmm27, %%zmm6\n"
+    "vfmadd231ps %%zmm28, %%zmm27, %%zmm7 %{{%%k1}}\n"
     // block 8
     "vmovups 2048(%[weight]), %%zmm31\n"
     "vmovups 2112(%[weight]), %%zmm30\n"
@@ -156,10 +163,10 @@ void nnacl_gemm_avx512_1x64_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vmovups 2432(%[weight]), %%zmm29\n"
     "vmovups 2496(%[weight]), %%zmm28\n"
     "vbroadcastss 36(%[src_0]), %%zmm27\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm27, %%zmm1\n"
-    "vfmadd231ps %%zmm29, %%zmm27, %%zmm2\n"
-    "vfmadd231ps %%zmm28, %%zmm27, %%zmm3 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm4\n"
+    "vfmadd231ps %%zmm30, %%zmm27, %%zmm5\n"
+    "vfmadd231ps %%zmm29, %%zmm27, %%zmm6\n"
+    "vfmadd231ps %%zmm28, %%zmm27, %%zmm7 %{{%%k1}}\n"
     // block 10
     "vmovups 2560(%[weight]), %%zmm31\n"
     "vmovups 2624(%[weight]), %%zmm30\n"
@@ -176,10 +183,10 @@ void nnacl_gemm_avx512_1x64_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vmovups 2944(%[weight]), %%zmm29\n"
     "vmovups 3008(%[weight]), %%zmm28\n"
     "vbroadcastss 44(%[src_0]), %%zmm27\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm27, %%zmm1\n"
-    "vfmadd231ps %%zmm29, %%zmm27, %%zmm2\n"
-    "vfmadd231ps %%zmm28, %%zmm27, %%zmm3 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm4\n"
+    "vfmadd231ps %%zmm30, %%zmm27, %%zmm5\n"
+    "vfmadd231ps %%zmm29, %%zmm27, %%zmm6\n"
+    "vfmadd231ps %%zmm28, %%zmm27, %%zmm7 %{{%%k1}}\n"
     // block 12
     "vmovups 3072(%[weight]), %%zmm31\n"
     "vmovups 3136(%[weight]), %%zmm30\n"
@@ -196,10 +203,10 @@ void nnacl_gemm_avx512_1x64_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vmovups 3456(%[weight]), %%zmm29\n"
     "vmovups 3520(%[weight]), %%zmm28\n"
     "vbroadcastss 52(%[src_0]), %%zmm27\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm27, %%zmm1\n"
-    "vfmadd231ps %%zmm29, %%zmm27, %%zmm2\n"
-    "vfmadd231ps %%zmm28, %%zmm27, %%zmm3 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm4\n"
+    "vfmadd231ps %%zmm30, %%zmm27, %%zmm5\n"
+    "vfmadd231ps %%zmm29, %%zmm27, %%zmm6\n"
+    "vfmadd231ps %%zmm28, %%zmm27, %%zmm7 %{{%%k1}}\n"
     // block 14
     "vmovups 3584(%[weight]), %%zmm31\n"
     "vmovups 3648(%[weight]), %%zmm30\n"
@@ -216,10 +223,10 @@ void nnacl_gemm_avx512_1x64_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vmovups 3968(%[weight]), %%zmm29\n"
     "vmovups 4032(%[weight]), %%zmm28\n"
     "vbroadcastss 60(%[src_0]), %%zmm27\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm27, %%zmm1\n"
-    "vfmadd231ps %%zmm29, %%zmm27, %%zmm2\n"
-    "vfmadd231ps %%zmm28, %%zmm27, %%zmm3 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm4\n"
+    "vfmadd231ps %%zmm30, %%zmm27, %%zmm5\n"
+    "vfmadd231ps %%zmm29, %%zmm27, %%zmm6\n"
+    "vfmadd231ps %%zmm28, %%zmm27, %%zmm7 %{{%%k1}}\n"
     "add $4096, %[weight]\n"
     "add $64, %[src_0]\n"
     "sub $16, %[depth]\n"
@@ -245,6 +252,11 @@ void nnacl_gemm_avx512_1x64_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "jg 1b\n"
     ".align 16\n"
     "2:\n"
+    // reduce the accumulators of the split depth
+    "vaddps %%zmm0, %%zmm4, %%zmm0\n"
+    "vaddps %%zmm1, %%zmm5, %%zmm1\n"
+    "vaddps %%zmm2, %%zmm6, %%zmm2\n"
+    "vaddps %%zmm3, %%zmm7, %%zmm3\n"
     "and $0x2, %[inc_flag]\n"
     "je 3f\n"
     "and $0x3, %[act_flag]\n"
@@ -1,26 +1,28 @@
 /**
- * Copyright 2022 Huawei Technologies Co., Ltd
- *
- * Licensed under the Apache License, Version 2.0 (the "License");
- * you may not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- * http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
+* Copyright 2022 Huawei Technologies Co., Ltd
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
 #include <x86intrin.h>
 #include "nnacl/fp32/matmul_avx512_mask_fp32.h"
 // clang-format off
-// nnacl gemm in x86 avx512 asm code
-void nnacl_gemm_avx512_3x32_mask_kernel_nhwc_fp32(float *dst, const float *src, const float *weight, const float *bias,
-                                                  const size_t act_flag, const size_t row_block, const size_t col_block,
-                                                  const size_t depth, const size_t src_stride, const size_t dst_stride,
-                                                  const size_t inc_flag, const u_int16_t *mask) {
+// nnacl gemm in x86 avx512 asm code, the depth is split over 2 sets of accumulators
+void nnacl_gemm_avx512_3x32_mask_split_kernel_nhwc_fp32(float *dst, const float *src, const float *weight,
+                                                        const float *bias, const size_t act_flag,
+                                                        const size_t row_block, const size_t col_block,
+                                                        const size_t depth, const size_t src_stride,
+                                                        const size_t dst_stride, const size_t inc_flag,
+                                                        const u_int16_t *mask) {
   size_t dst_stride_t = dst_stride << 2;
   asm volatile(
     // inc in depth
@@ -56,9 +58,17 @@ void nnacl_gemm_avx512_3x32_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vxorps %%zmm5, %%zmm5, %%zmm5\n"
     ".align 16\n"
     "2:\n"
+    "vxorps %%zmm6, %%zmm6, %%zmm6\n"
+    "vxorps %%zmm7, %%zmm7, %%zmm7\n"
+    "vxorps %%zmm8, %%zmm8, %%zmm8\n"
+    "vxorps %%zmm9, %%zmm9, %%zmm9\n"
+    "vxorps %%zmm10, %%zmm10, %%zmm10\n"
+    "vxorps %%zmm11, %%zmm11, %%zmm11\n"
     :
-    : [ dst_0 ] "r"(dst), [ bias ] "r"(bias), [ dst_stride ] "r"(dst_stride_t), [ inc_flag ] "r"(inc_flag), [ mask ] "r"(mask)
-    : "%rax", "%k1", "%zmm0", "%zmm1", "%zmm2", "%zmm3", "%zmm4", "%zmm5");
+    : [ dst_0 ] "r"(dst), [ bias ] "r"(bias), [ dst_stride ] "r"(dst_stride_t), [ inc_flag ] "r"(inc_flag),
+      [ mask ] "r"(mask)
+    : "%rax", "%k1", "%zmm0", "%zmm1", "%zmm2", "%zmm3", "%zmm4", "%zmm5", "%zmm6", "%zmm7", "%zmm8", "%zmm9", "%zmm10",
+      "%zmm11");
   size_t src_stride_t = src_stride << 2;
   asm volatile(
     "kmovw (%[mask]), %%k1\n"
@@ -84,12 +94,12 @@ void nnacl_gemm_avx512_3x32_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vbroadcastss 4(%[src_0]), %%zmm29\n"
     "vbroadcastss 4(%[src_0], %[src_stride], 1), %%zmm28\n"
     "vbroadcastss 4(%[src_0], %[src_stride], 2), %%zmm27\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm28, %%zmm2\n"
-    "vfmadd231ps %%zmm30, %%zmm28, %%zmm3 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm4\n"
-    "vfmadd231ps %%zmm30, %%zmm27, %%zmm5 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm7 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm28, %%zmm8\n"
+    "vfmadd231ps %%zmm30, %%zmm28, %%zmm9 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm10\n"
+    "vfmadd231ps %%zmm30, %%zmm27, %%zmm11 %{{%%k1}}\n"
     // block 2
     "vmovups 256(%[weight]), %%zmm31\n"
     "vmovups 320(%[weight]), %%zmm30\n"
@@ -108,12 +118,12 @@ void nnacl_gemm_avx512_3x32_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vbroadcastss 12(%[src_0]), %%zmm29\n"
     "vbroadcastss 12(%[src_0], %[src_stride], 1), %%zmm28\n"
     "vbroadcastss 12(%[src_0], %[src_stride], 2), %%zmm27\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm28, %%zmm2\n"
-    "vfmadd231ps %%zmm30, %%zmm28, %%zmm3 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm4\n"
-    "vfmadd231ps %%zmm30, %%zmm27, %%zmm5 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm7 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm28, %%zmm8\n"
+    "vfmadd231ps %%zmm30, %%zmm28, %%zmm9 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm10\n"
+    "vfmadd231ps %%zmm30, %%zmm27, %%zmm11 %{{%%k1}}\n"
     // block 4
     "vmovups 512(%[weight]), %%zmm31\n"
     "vmovups 576(%[weight]), %%zmm30\n"
@@ -132,12 +142,12 @@ void nnacl_gemm_avx512_3x32_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vbroadcastss 20(%[src_0]), %%zmm29\n"
     "vbroadcastss 20(%[src_0], %[src_stride], 1), %%zmm28\n"
     "vbroadcastss 20(%[src_0], %[src_stride], 2), %%zmm27\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm28, %%zmm2\n"
-    "vfmadd231ps %%zmm30, %%zmm28, %%zmm3 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm4\n"
-    "vfmadd231ps %%zmm30, %%zmm27, %%zmm5 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm7 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm28, %%zmm8\n"
+    "vfmadd231ps %%zmm30, %%zmm28, %%zmm9 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm10\n"
+    "vfmadd231ps %%zmm30, %%zmm27, %%zmm11 %{{%%k1}}\n"
     // block 6
     "vmovups 768(%[weight]), %%zmm31\n"
     "vmovups 832(%[weight]), %%zmm30\n"
@@ -156,12 +166,12 @@ void nnacl_gemm_avx512_3x32_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vbroadcastss 28(%[src_0]), %%zmm29\n"
     "vbroadcastss 28(%[src_0], %[src_stride], 1), %%zmm28\n"
     "vbroadcastss 28(%[src_0], %[src_stride], 2), %%zmm27\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm28, %%zmm2\n"
-    "vfmadd231ps %%zmm30, %%zmm28, %%zmm3 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm4\n"
-    "vfmadd231ps %%zmm30, %%zmm27, %%zmm5 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm7 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm28, %%zmm8\n"
+    "vfmadd231ps %%zmm30, %%zmm28, %%zmm9 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm10\n"
+    "vfmadd231ps %%zmm30, %%zmm27, %%zmm11 %{{%%k1}}\n"
     // block 8
     "vmovups 1024(%[weight]), %%zmm31\n"
     "vmovups 1088(%[weight]), %%zmm30\n"
@@ -180,12 +190,12 @@ void nnacl_gemm_avx512_3x32_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vbroadcastss 36(%[src_0]), %%zmm29\n"
     "vbroadcastss 36(%[src_0], %[src_stride], 1), %%zmm28\n"
     "vbroadcastss 36(%[src_0], %[src_stride], 2), %%zmm27\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm28, %%zmm2\n"
-    "vfmadd231ps %%zmm30, %%zmm28, %%zmm3 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm4\n"
-    "vfmadd231ps %%zmm30, %%zmm27, %%zmm5 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm7 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm28, %%zmm8\n"
+    "vfmadd231ps %%zmm30, %%zmm28, %%zmm9 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm10\n"
+    "vfmadd231ps %%zmm30, %%zmm27, %%zmm11 %{{%%k1}}\n"
     // block 10
     "vmovups 1280(%[weight]), %%zmm31\n"
     "vmovups 1344(%[weight]), %%zmm30\n"
@@ -204,12 +214,12 @@ void nnacl_gemm_avx512_3x32_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vbroadcastss 44(%[src_0]), %%zmm29\n"
     "vbroadcastss 44(%[src_0], %[src_stride], 1), %%zmm28\n"
     "vbroadcastss 44(%[src_0], %[src_stride], 2), %%zmm27\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm28, %%zmm2\n"
-    "vfmadd231ps %%zmm30, %%zmm28, %%zmm3 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm4\n"
-    "vfmadd231ps %%zmm30, %%zmm27, %%zmm5 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm7 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm28, %%zmm8\n"
+    "vfmadd231ps %%zmm30, %%zmm28, %%zmm9 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm10\n"
+    "vfmadd231ps %%zmm30, %%zmm27, %%zmm11 %{{%%k1}}\n"
     // block 12
     "vmovups 1536(%[weight]), %%zmm31\n"
     "vmovups 1600(%[weight]), %%zmm30\n"
@@ -228,12 +238,12 @@ void nnacl_gemm_avx512_3x32_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vbroadcastss 52(%[src_0]), %%zmm29\n"
     "vbroadcastss 52(%[src_0], %[src_stride], 1), %%zmm28\n"
     "vbroadcastss 52(%[src_0], %[src_stride], 2), %%zmm27\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm28, %%zmm2\n"
-    "vfmadd231ps %%zmm30, %%zmm28, %%zmm3 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm4\n"
-    "vfmadd231ps %%zmm30, %%zmm27, %%zmm5 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm7 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm28, %%zmm8\n"
+    "vfmadd231ps %%zmm30, %%zmm28, %%zmm9 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm10\n"
+    "vfmadd231ps %%zmm30, %%zmm27, %%zmm11 %{{%%k1}}\n"
     // block 14
     "vmovups 1792(%[weight]), %%zmm31\n"
     "vmovups 1856(%[weight]), %%zmm30\n"
@@ -252,12 +262,12 @@ void nnacl_gemm_avx512_3x32_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vbroadcastss 60(%[src_0]), %%zmm29\n"
     "vbroadcastss 60(%[src_0], %[src_stride], 1), %%zmm28\n"
     "vbroadcastss 60(%[src_0], %[src_stride], 2), %%zmm27\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm0\n"
-    "vfmadd231ps %%zmm30, %%zmm29, %%zmm1 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm28, %%zmm2\n"
-    "vfmadd231ps %%zmm30, %%zmm28, %%zmm3 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm4\n"
-    "vfmadd231ps %%zmm30, %%zmm27, %%zmm5 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6\n"
+    "vfmadd231ps %%zmm30, %%zmm29, %%zmm7 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm28, %%zmm8\n"
+    "vfmadd231ps %%zmm30, %%zmm28, %%zmm9 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm10\n"
+    "vfmadd231ps %%zmm30, %%zmm27, %%zmm11 %{{%%k1}}\n"
     "add $2048, %[weight]\n"
     "add $64, %[src_0]\n"
     "sub $16, %[depth]\n"
@@ -285,6 +295,13 @@ void nnacl_gemm_avx512_3x32_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "jg 1b\n"
     ".align 16\n"
     "2:\n"
+    // reduce the accumulators of the split depth
+    "vaddps %%zmm0, %%zmm6, %%zmm0\n"
+    "vaddps %%zmm1, %%zmm7, %%zmm1\n"
+    "vaddps %%zmm2, %%zmm8, %%zmm2\n"
+    "vaddps %%zmm3, %%zmm9, %%zmm3\n"
+    "vaddps %%zmm4, %%zmm10, %%zmm4\n"
+    "vaddps %%zmm5, %%zmm11, %%zmm5\n"
     "and $0x2, %[inc_flag]\n"
     "je 3f\n"
     "and $0x3, %[act_flag]\n"
@@ -1,26 +1,28 @@
 /**
- * Copyright 2022 Huawei Technologies Co., Ltd
- *
- * Licensed under the Apache License, Version 2.0 (the "License");
- * you may not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- * http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
+* Copyright 2022 Huawei Technologies Co., Ltd
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
 #include <x86intrin.h>
 #include "nnacl/fp32/matmul_avx512_mask_fp32.h"
 // clang-format off
-// nnacl gemm in x86 avx512 asm code
-void nnacl_gemm_avx512_5x16_mask_kernel_nhwc_fp32(float *dst, const float *src, const float *weight, const float *bias,
-                                                  const size_t act_flag, const size_t row_block, const size_t col_block,
-                                                  const size_t depth, const size_t src_stride, const size_t dst_stride,
-                                                  const size_t inc_flag, const u_int16_t *mask) {
+// nnacl gemm in x86 avx512 asm code, the depth is split over 2 sets of accumulators
+void nnacl_gemm_avx512_5x16_mask_split_kernel_nhwc_fp32(float *dst, const float *src, const float *weight,
+                                                        const float *bias, const size_t act_flag,
+                                                        const size_t row_block, const size_t col_block,
+                                                        const size_t depth, const size_t src_stride,
+                                                        const size_t dst_stride, const size_t inc_flag,
+                                                        const u_int16_t *mask) {
   const float *dst_3 = dst + 3 * dst_stride;
   size_t dst_stride_t = dst_stride << 2;
   asm volatile(
@@ -54,10 +56,15 @@ void nnacl_gemm_avx512_5x16_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vxorps %%zmm4, %%zmm4, %%zmm4\n"
     ".align 16\n"
     "2:\n"
+    "vxorps %%zmm5, %%zmm5, %%zmm5\n"
+    "vxorps %%zmm6, %%zmm6, %%zmm6\n"
+    "vxorps %%zmm7, %%zmm7, %%zmm7\n"
+    "vxorps %%zmm8, %%zmm8, %%zmm8\n"
+    "vxorps %%zmm9, %%zmm9, %%zmm9\n"
     :
-    : [ dst_0 ] "r"(dst), [ bias ] "r"(bias), [ dst_stride ] "r"(dst_stride_t), [ inc_flag ] "r"(inc_flag), [ mask ] "r"(mask),
-      [ dst_3 ] "r"(dst_3)
-    : "%rax", "%k1", "%zmm0", "%zmm1", "%zmm2", "%zmm3", "%zmm4");
+    : [ dst_0 ] "r"(dst), [ bias ] "r"(bias), [ dst_stride ] "r"(dst_stride_t), [ inc_flag ] "r"(inc_flag),
+      [ mask ] "r"(mask), [ dst_3 ] "r"(dst_3)
+    : "%rax", "%k1", "%zmm0", "%zmm1", "%zmm2", "%zmm3", "%zmm4", "%zmm5", "%zmm6", "%zmm7", "%zmm8", "%zmm9");
   const float *src_3 = src + 3 * src_stride;
   size_t src_stride_t = src_stride << 2;
   asm volatile(
@@ -85,11 +92,11 @@ void nnacl_gemm_avx512_5x16_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vbroadcastss 4(%[src_0], %[src_stride], 2), %%zmm28\n"
     "vbroadcastss 4(%[src_3]), %%zmm27\n"
     "vbroadcastss 4(%[src_3], %[src_stride], 1), %%zmm26\n"
-    "vfmadd231ps %%zmm31, %%zmm30, %%zmm0 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm1 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm28, %%zmm2 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm3 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm26, %%zmm4 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm30, %%zmm5 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm28, %%zmm7 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm8 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm26, %%zmm9 %{{%%k1}}\n"
     // block 2
     "vmovups 128(%[weight]), %%zmm31\n"
     "vbroadcastss 8(%[src_0]), %%zmm30\n"
@@ -109,11 +116,11 @@ void nnacl_gemm_avx512_5x16_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vbroadcastss 12(%[src_0], %[src_stride], 2), %%zmm28\n"
     "vbroadcastss 12(%[src_3]), %%zmm27\n"
     "vbroadcastss 12(%[src_3], %[src_stride], 1), %%zmm26\n"
-    "vfmadd231ps %%zmm31, %%zmm30, %%zmm0 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm1 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm28, %%zmm2 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm3 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm26, %%zmm4 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm30, %%zmm5 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm28, %%zmm7 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm8 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm26, %%zmm9 %{{%%k1}}\n"
     // block 4
     "vmovups 256(%[weight]), %%zmm31\n"
     "vbroadcastss 16(%[src_0]), %%zmm30\n"
@@ -133,11 +140,11 @@ void nnacl_gemm_avx512_5x16_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vbroadcastss 20(%[src_0], %[src_stride], 2), %%zmm28\n"
     "vbroadcastss 20(%[src_3]), %%zmm27\n"
     "vbroadcastss 20(%[src_3], %[src_stride], 1), %%zmm26\n"
-    "vfmadd231ps %%zmm31, %%zmm30, %%zmm0 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm1 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm28, %%zmm2 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm3 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm26, %%zmm4 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm30, %%zmm5 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm28, %%zmm7 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm8 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm26, %%zmm9 %{{%%k1}}\n"
     // block 6
     "vmovups 384(%[weight]), %%zmm31\n"
     "vbroadcastss 24(%[src_0]), %%zmm30\n"
@@ -157,11 +164,11 @@ void nnacl_gemm_avx512_5x16_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vbroadcastss 28(%[src_0], %[src_stride], 2), %%zmm28\n"
     "vbroadcastss 28(%[src_3]), %%zmm27\n"
     "vbroadcastss 28(%[src_3], %[src_stride], 1), %%zmm26\n"
-    "vfmadd231ps %%zmm31, %%zmm30, %%zmm0 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm1 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm28, %%zmm2 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm3 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm26, %%zmm4 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm30, %%zmm5 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm28, %%zmm7 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm8 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm26, %%zmm9 %{{%%k1}}\n"
     // block 8
     "vmovups 512(%[weight]), %%zmm31\n"
     "vbroadcastss 32(%[src_0]), %%zmm30\n"
@@ -181,11 +188,11 @@ void nnacl_gemm_avx512_5x16_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vbroadcastss 36(%[src_0], %[src_stride], 2), %%zmm28\n"
     "vbroadcastss 36(%[src_3]), %%zmm27\n"
     "vbroadcastss 36(%[src_3], %[src_stride], 1), %%zmm26\n"
-    "vfmadd231ps %%zmm31, %%zmm30, %%zmm0 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm1 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm28, %%zmm2 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm3 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm26, %%zmm4 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm30, %%zmm5 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm28, %%zmm7 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm8 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm26, %%zmm9 %{{%%k1}}\n"
     // block 10
     "vmovups 640(%[weight]), %%zmm31\n"
     "vbroadcastss 40(%[src_0]), %%zmm30\n"
@@ -205,11 +212,11 @@ void nnacl_gemm_avx512_5x16_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vbroadcastss 44(%[src_0], %[src_stride], 2), %%zmm28\n"
     "vbroadcastss 44(%[src_3]), %%zmm27\n"
     "vbroadcastss 44(%[src_3], %[src_stride], 1), %%zmm26\n"
-    "vfmadd231ps %%zmm31, %%zmm30, %%zmm0 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm1 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm28, %%zmm2 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm3 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm26, %%zmm4 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm30, %%zmm5 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm28, %%zmm7 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm8 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm26, %%zmm9 %{{%%k1}}\n"
     // block 12
     "vmovups 768(%[weight]), %%zmm31\n"
     "vbroadcastss 48(%[src_0]), %%zmm30\n"
@@ -229,11 +236,11 @@ void nnacl_gemm_avx512_5x16_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vbroadcastss 52(%[src_0], %[src_stride], 2), %%zmm28\n"
     "vbroadcastss 52(%[src_3]), %%zmm27\n"
     "vbroadcastss 52(%[src_3], %[src_stride], 1), %%zmm26\n"
-    "vfmadd231ps %%zmm31, %%zmm30, %%zmm0 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm1 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm28, %%zmm2 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm3 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm26, %%zmm4 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm30, %%zmm5 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm28, %%zmm7 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm8 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm26, %%zmm9 %{{%%k1}}\n"
     // block 14
     "vmovups 896(%[weight]), %%zmm31\n"
     "vbroadcastss 56(%[src_0]), %%zmm30\n"
@@ -253,11 +260,11 @@ void nnacl_gemm_avx512_5x16_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "vbroadcastss 60(%[src_0], %[src_stride], 2), %%zmm28\n"
     "vbroadcastss 60(%[src_3]), %%zmm27\n"
     "vbroadcastss 60(%[src_3], %[src_stride], 1), %%zmm26\n"
-    "vfmadd231ps %%zmm31, %%zmm30, %%zmm0 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm29, %%zmm1 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm28, %%zmm2 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm27, %%zmm3 %{{%%k1}}\n"
-    "vfmadd231ps %%zmm31, %%zmm26, %%zmm4 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm30, %%zmm5 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm29, %%zmm6 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm28, %%zmm7 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm27, %%zmm8 %{{%%k1}}\n"
+    "vfmadd231ps %%zmm31, %%zmm26, %%zmm9 %{{%%k1}}\n"
     "add $1024, %[weight]\n"
     "add $64, %[src_0]\n"
     "add $64, %[src_3]\n"
@@ -287,6 +294,12 @@ void nnacl_gemm_avx512_5x16_mask_kernel_nhwc_fp32(float *dst, const float *src,
     "jg 1b\n"
     ".align 16\n"
     "2:\n"
+    // reduce the accumulators of the split depth
+    "vaddps %%zmm0, %%zmm5, %%zmm0\n"
+    "vaddps %%zmm1, %%zmm6, %%zmm1\n"
+    "vaddps %%zmm2, %%zmm7, %%zmm2\n"
+    "vaddps %%zmm3, %%zmm8, %%zmm3\n"
+    "vaddps %%zmm4, %%zmm9, %%zmm4\n"
     "and $0x2, %[inc_flag]\n"
     "je 3f\n"
     "and $0x3, %[act_flag]\n"
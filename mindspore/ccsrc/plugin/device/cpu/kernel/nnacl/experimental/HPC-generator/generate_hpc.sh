@@ -86,3 +86,13 @@ do
     python3 $CRTDIR/generator.py -I $CRTDIR/template_file/gemm_avx512_nhwc_asm.c.in -A row_block=$row col_block=${n[index]} -O $dst_file
   done
 done
+
+# generate gemm avx512 mask asm code, the depth is split for the tiles of fewer than 8 accumulators
+n=(16 16 16 16 16 16 16 32 32 32 48 48 64)
+m=(1 2 3 4 5 6 7 1 2 3 1 2 1)
+s=(8 4 3 2 2 2 2 4 2 2 3 2 2)
+for ((index = 0; index < 13; index++))
+do
+  dst_file=$CRTDIR"/gemm_mask_split_avx512/nnacl_gemm_avx512_${m[index]}x${n[index]}_mask_split_kernel_nhwc_fp32.c"
+  python3 $CRTDIR/generator.py -I $CRTDIR/template_file/gemm_avx512_mask_split_nhwc_asm.c.in -A row_block=${m[index]} col_block=${n[index]} depth_split=${s[index]} -O $dst_file
+done
@@ -0,0 +1,113 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/fp32/flash_attention_fp32.h"
+#include <float.h>
+#include <string.h>
+#include "nnacl/flash_attention_fp32_simd.h"
+
+static void FlashAttentionRowTile(const float *q_row, const float *k, const float *v, const float *mask_row,
+                                  float *out_row, float *score, float *row_max, float *row_sum, int kv_start,
+                                  int kv_end, const FlashAttentionArgs *args) {
+  int head_size = args->head_size_;
+  int tile = kv_end - kv_start;
+  float tile_max = *row_max;
+  for (int j = 0; j < tile; ++j) {
+    const float *k_row = k + (kv_start + j) * args->kv_stride_;
+    float dot = 0.0f;
+    int index = 0;
+    SIMD_RUN_NO_SCALAR(FlashAttentionDot, index, q_row, k_row, head_size, &dot);
+    for (; index < head_size; ++index) {
+      dot += q_row[index] * k_row[index];
+    }
+    float logit = dot * args->scale_;
+    if (mask_row != NULL) {
+      logit += (1.0f - mask_row[kv_start + j]) * FLASH_ATTENTION_MASK_VALUE;
+    }
+    score[j] = logit;
+    tile_max = MSMAX(tile_max, logit);
+  }
+
+  float exp_sum = 0.0f;
+  int index = 0;
+  SIMD_RUN_NO_SCALAR(FlashAttentionExp, index, score, tile_max, tile, &exp_sum);
+  for (; index < tile; ++index) {
+    score[index] = simd_exp32_f32(score[index] - tile_max);
+    exp_sum += score[index];
+  }
+
+  // The output accumulated by the former tiles is relative to the former max.
+  if (tile_max > *row_max) {
+    float correction = simd_exp32_f32(*row_max - tile_max);
+    *row_sum *= correction;
+    index = 0;
+    SIMD_RUN_NO_SCALAR(FlashAttentionScale, index, out_row, correction, head_size);
+    for (; index < head_size; ++index) {
+      out_row[index] *= correction;
+    }
+    *row_max = tile_max;
+  }
+  *row_sum += exp_sum;
+
+  for (int j = 0; j < tile; ++j) {
+    const float *v_row = v + (kv_start + j) * args->kv_stride_;
+    float prob = score[j];
+    index = 0;
+    SIMD_RUN_NO_SCALAR(FlashAttentionAxpy, index, v_row, prob, out_row, head_size);
+    for (; index < head_size; ++index) {
+      out_row[index] += prob * v_row[index];
+    }
+  }
+}
+
+void FlashAttentionHead(const float *q, const float *k, const float *v, const float *mask, float *out, float *buffer,
+                        const FlashAttentionArgs *args) {
+  int q_len = args->q_len_;
+  int head_size = args->head_size_;
+  float *row_max = buffer;
+  float *row_sum = buffer + q_len;
+  float *score = row_sum + q_len;
+  for (int i = 0; i < q_len; ++i) {
+    row_max[i] = -FLT_MAX;
+    row_sum[i] = 0.0f;
+    memset(out + i * args->out_stride_, 0, head_size * sizeof(float));
+  }
+
+  for (int kv_start = 0; kv_start < args->kv_len_; kv_start += FLASH_ATTENTION_KV_TILE) {
+    int kv_end = MSMIN(kv_start + FLASH_ATTENTION_KV_TILE, args->kv_len_);
+    for (int i = 0; i < q_len; ++i) {
+      int end = args->causal_offset_ < 0 ? kv_end : MSMIN(kv_end, i + args->causal_offset_ + 1);
+      if (end <= kv_start) {
+        continue;
+      }
+      const float *mask_row = mask == NULL ? NULL : mask + i * args->mask_stride_;
+      FlashAttentionRowTile(q + i * args->q_stride_, k, v, mask_row, out + i * args->out_stride_, score, row_max + i,
+                            row_sum + i, kv_start, end, args);
+    }
+  }
+
+  for (int i = 0; i < q_len; ++i) {
+    if (row_sum[i] <= 0.0f) {
+      continue;
+    }
+    float *out_row = out + i * args->out_stride_;
+    float inv_sum = 1.0f / row_sum[i];
+    int index = 0;
+    SIMD_RUN_NO_SCALAR(FlashAttentionScale, index, out_row, inv_sum, head_size);
+    for (; index < head_size; ++index) {
+      out_row[index] *= inv_sum;
+    }
+  }
+}
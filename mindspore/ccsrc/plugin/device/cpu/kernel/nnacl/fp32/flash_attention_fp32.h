@@ -0,0 +1,57 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_NNACL_FP32_FLASH_ATTENTION_FP32_H_
+#define MINDSPORE_NNACL_FP32_FLASH_ATTENTION_FP32_H_
+
+#include "nnacl/op_base.h"
+
+// The number of keys and values processed at a time.
+#define FLASH_ATTENTION_KV_TILE 64
+// The logits of the keys masked out are decreased by it, as the masked softmax of the attention does.
+#define FLASH_ATTENTION_MASK_VALUE (-10000.0f)
+// The number of floats of the buffer FlashAttentionHead needs.
+#define FLASH_ATTENTION_BUFFER_SIZE(q_len) (2 * (q_len) + FLASH_ATTENTION_KV_TILE)
+
+typedef struct FlashAttentionArgs {
+  int q_len_;
+  int kv_len_;
+  int head_size_;
+  // the distance between the rows of q, k and v, out, and mask
+  int q_stride_;
+  int kv_stride_;
+  int out_stride_;
+  int mask_stride_;
+  // the query i only attends to the keys j <= i + causal_offset_, all the keys are attended if it is negative
+  int causal_offset_;
+  float scale_;
+} FlashAttentionArgs;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// The attention of one head, out = softmax(q * k^T * scale + (1 - mask) * -10000) * v. The keys and values are
+// processed tile by tile with the online softmax, the running max and sum of each query rescale its output when a tile
+// raises the max, so the q * k^T matrix is never materialized and a tile of k and v is reused by all the queries. The
+// mask is the 0/1 keep mask of [q_len, kv_len], NULL for no mask. The buffer holds FLASH_ATTENTION_BUFFER_SIZE(q_len)
+// floats.
+void FlashAttentionHead(const float *q, const float *k, const float *v, const float *mask, float *out, float *buffer,
+                        const FlashAttentionArgs *args);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_FP32_FLASH_ATTENTION_FP32_H_
@@ -0,0 +1,250 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX512
+#include "nnacl/fp32/matmul_avx512_bf16_fp32.h"
+#ifdef _MSC_VER
+#include <immintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#include "nnacl/nnacl_common.h"
+
+void RowMajor2Row64MajorBf16Parallel(const float *src_ptr, float *dst_ptr, int col, int row, int col_start,
+                                     int col_end) {
+  // as RowMajor2Row64MajorParallel, col is the deep and row is the columns of b
+  int deep_pair = UP_DIV(col, C2NUM);
+  int row_block_num = UP_DIV(row, C16NUM);
+  for (int i = 0; i < row_block_num; i += C4NUM) {
+    int width = MSMIN(C4NUM, row_block_num - i) * C16NUM;
+    int row_num = MSMIN(width, row - i * C16NUM);
+    uint16_t *dst_block = (uint16_t *)(dst_ptr + i * C16NUM * deep_pair);
+    for (int d = col_start; d < col_end; ++d) {
+      const float *src = src_ptr + d * row + i * C16NUM;
+      uint16_t *dst = dst_block + d / C2NUM * width * C2NUM + d % C2NUM;
+      // the pair of the last odd deep is padded with zero
+      bool pad = d == col - 1 && d % C2NUM == 0;
+      for (int j = 0; j < width; ++j) {
+        dst[j * C2NUM] = j < row_num ? Float32ToBFloat16(src[j]) : 0;
+        if (pad) {
+          dst[j * C2NUM + 1] = 0;
+        }
+      }
+    }
+  }
+}
+
+void RowMajor2Col64MajorBf16Parallel(const float *src_ptr, float *dst_ptr, int row, int col, int row_start,
+                                     int row_end) {
+  // as RowMajor2Col64MajorParallel, row is the columns of b and col is the deep
+  int deep_pair = UP_DIV(col, C2NUM);
+  int all_block_num = UP_DIV(row, C16NUM);
+  row_start = UP_DIV(row_start, C16NUM);
+  row_end = UP_DIV(row_end, C16NUM);
+  for (int i = UP_ROUND(row_start, C4NUM); i < row_end; i += C4NUM) {
+    int width = MSMIN(C4NUM, all_block_num - i) * C16NUM;
+    int row_num = MSMIN(width, row - i * C16NUM);
+    const float *src = src_ptr + i * C16NUM * col;
+    uint16_t *dst = (uint16_t *)(dst_ptr + i * C16NUM * deep_pair);
+    for (int r = 0; r < width; ++r) {
+      for (int d = 0; d < deep_pair * C2NUM; ++d) {
+        uint16_t value = (r < row_num && d < col) ? Float32ToBFloat16(src[r * col + d]) : 0;
+        dst[(d / C2NUM * width + r) * C2NUM + d % C2NUM] = value;
+      }
+    }
+  }
+}
+
+static inline __mmask16 MatMulBf16Mask(int num) {
+  return num >= C16NUM ? (__mmask16)0xFFFF : (__mmask16)((1u << (unsigned int)MSMAX(num, 0)) - 1);
+}
+
+// The float32 of the even and the odd deep of a packed pair of bfloat16.
+static inline __m512 MatMulBf16Even(const float *b) {
+  return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_loadu_si512(b), C16NUM));
+}
+
+static inline __m512 MatMulBf16Odd(const float *b, __m512i high_mask) {
+  return _mm512_castsi512_ps(_mm512_and_si512(_mm512_loadu_si512(b), high_mask));
+}
+
+static inline void MatMulBf16StoreRow(float *c, __m512 acc0, __m512 acc1, __m512 acc2, __m512 acc3,
+                                      const float *bias, int act_type, int col_num) {
+  __m512 value[C4NUM] = {acc0, acc1, acc2, acc3};
+  for (int j = 0; j * C16NUM < col_num; ++j) {
+    __mmask16 mask = MatMulBf16Mask(col_num - j * C16NUM);
+    if (bias != NULL) {
+      value[j] = _mm512_add_ps(value[j], _mm512_maskz_loadu_ps(mask, bias + j * C16NUM));
+    }
+    if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+      value[j] = _mm512_max_ps(value[j], _mm512_setzero_ps());
+    }
+    if (act_type == ActType_Relu6) {
+      value[j] = _mm512_min_ps(value[j], _mm512_set1_ps(6.0f));
+    }
+    _mm512_mask_storeu_ps(c + j * C16NUM, mask, value[j]);
+  }
+}
+
+// A tile of 5 rows and a block of b. The groups of 16 columns past the width are computed with the last one and are
+// not stored. The 20 accumulators, the 4 words of the pairs and their 4 widened groups stay in the registers.
+static void MatMulBf16Block5x64(const float *a, const float *b, float *c, const float *bias, int act_type, int depth,
+                                int col_num, int width, int col_align) {
+  const __m512i high_mask = _mm512_set1_epi32((int)0xFFFF0000);
+  int group_num = width / C16NUM;
+  int b1 = MSMIN(C1NUM, group_num - 1) * C16NUM;
+  int b2 = MSMIN(C2NUM, group_num - 1) * C16NUM;
+  int b3 = MSMIN(C3NUM, group_num - 1) * C16NUM;
+  const float *a1 = a + depth;
+  const float *a2 = a + C2NUM * depth;
+  const float *a3 = a + C3NUM * depth;
+  const float *a4 = a + C4NUM * depth;
+  __m512 acc00 = _mm512_setzero_ps(), acc01 = _mm512_setzero_ps(), acc02 = _mm512_setzero_ps();
+  __m512 acc03 = _mm512_setzero_ps(), acc10 = _mm512_setzero_ps(), acc11 = _mm512_setzero_ps();
+  __m512 acc12 = _mm512_setzero_ps(), acc13 = _mm512_setzero_ps(), acc20 = _mm512_setzero_ps();
+  __m512 acc21 = _mm512_setzero_ps(), acc22 = _mm512_setzero_ps(), acc23 = _mm512_setzero_ps();
+  __m512 acc30 = _mm512_setzero_ps(), acc31 = _mm512_setzero_ps(), acc32 = _mm512_setzero_ps();
+  __m512 acc33 = _mm512_setzero_ps(), acc40 = _mm512_setzero_ps(), acc41 = _mm512_setzero_ps();
+  __m512 acc42 = _mm512_setzero_ps(), acc43 = _mm512_setzero_ps();
+  const float *b_pair = b;
+  for (int d = 0; d < depth; d += C2NUM, b_pair += width) {
+    __m512 w0 = MatMulBf16Even(b_pair);
+    __m512 w1 = MatMulBf16Even(b_pair + b1);
+    __m512 w2 = MatMulBf16Even(b_pair + b2);
+    __m512 w3 = MatMulBf16Even(b_pair + b3);
+    __m512 x = _mm512_set1_ps(a[d]);
+    acc00 = _mm512_fmadd_ps(x, w0, acc00);
+    acc01 = _mm512_fmadd_ps(x, w1, acc01);
+    acc02 = _mm512_fmadd_ps(x, w2, acc02);
+    acc03 = _mm512_fmadd_ps(x, w3, acc03);
+    x = _mm512_set1_ps(a1[d]);
+    acc10 = _mm512_fmadd_ps(x, w0, acc10);
+    acc11 = _mm512_fmadd_ps(x, w1, acc11);
+    acc12 = _mm512_fmadd_ps(x, w2, acc12);
+    acc13 = _mm512_fmadd_ps(x, w3, acc13);
+    x = _mm512_set1_ps(a2[d]);
+    acc20 = _mm512_fmadd_ps(x, w0, acc20);
+    acc21 = _mm512_fmadd_ps(x, w1, acc21);
+    acc22 = _mm512_fmadd_ps(x, w2, acc22);
+    acc23 = _mm512_fmadd_ps(x, w3, acc23);
+    x = _mm512_set1_ps(a3[d]);
+    acc30 = _mm512_fmadd_ps(x, w0, acc30);
+    acc31 = _mm512_fmadd_ps(x, w1, acc31);
+    acc32 = _mm512_fmadd_ps(x, w2, acc32);
+    acc33 = _mm512_fmadd_ps(x, w3, acc33);
+    x = _mm512_set1_ps(a4[d]);
+    acc40 = _mm512_fmadd_ps(x, w0, acc40);
+    acc41 = _mm512_fmadd_ps(x, w1, acc41);
+    acc42 = _mm512_fmadd_ps(x, w2, acc42);
+    acc43 = _mm512_fmadd_ps(x, w3, acc43);
+    if (d + 1 == depth) {
+      break;  // the odd deep of the last pair is the zero padding
+    }
+
+    w0 = MatMulBf16Odd(b_pair, high_mask);
+    w1 = MatMulBf16Odd(b_pair + b1, high_mask);
+    w2 = MatMulBf16Odd(b_pair + b2, high_mask);
+    w3 = MatMulBf16Odd(b_pair + b3, high_mask);
+    x = _mm512_set1_ps(a[d + 1]);
+    acc00 = _mm512_fmadd_ps(x, w0, acc00);
+    acc01 = _mm512_fmadd_ps(x, w1, acc01);
+    acc02 = _mm512_fmadd_ps(x, w2, acc02);
+    acc03 = _mm512_fmadd_ps(x, w3, acc03);
+    x = _mm512_set1_ps(a1[d + 1]);
+    acc10 = _mm512_fmadd_ps(x, w0, acc10);
+    acc11 = _mm512_fmadd_ps(x, w1, acc11);
+    acc12 = _mm512_fmadd_ps(x, w2, acc12);
+    acc13 = _mm512_fmadd_ps(x, w3, acc13);
+    x = _mm512_set1_ps(a2[d + 1]);
+    acc20 = _mm512_fmadd_ps(x, w0, acc20);
+    acc21 = _mm512_fmadd_ps(x, w1, acc21);
+    acc22 = _mm512_fmadd_ps(x, w2, acc22);
+    acc23 = _mm512_fmadd_ps(x, w3, acc23);
+    x = _mm512_set1_ps(a3[d + 1]);
+    acc30 = _mm512_fmadd_ps(x, w0, acc30);
+    acc31 = _mm512_fmadd_ps(x, w1, acc31);
+    acc32 = _mm512_fmadd_ps(x, w2, acc32);
+    acc33 = _mm512_fmadd_ps(x, w3, acc33);
+    x = _mm512_set1_ps(a4[d + 1]);
+    acc40 = _mm512_fmadd_ps(x, w0, acc40);
+    acc41 = _mm512_fmadd_ps(x, w1, acc41);
+    acc42 = _mm512_fmadd_ps(x, w2, acc42);
+    acc43 = _mm512_fmadd_ps(x, w3, acc43);
+  }
+  MatMulBf16StoreRow(c, acc00, acc01, acc02, acc03, bias, act_type, col_num);
+  MatMulBf16StoreRow(c + col_align, acc10, acc11, acc12, acc13, bias, act_type, col_num);
+  MatMulBf16StoreRow(c + C2NUM * col_align, acc20, acc21, acc22, acc23, bias, act_type, col_num);
+  MatMulBf16StoreRow(c + C3NUM * col_align, acc30, acc31, acc32, acc33, bias, act_type, col_num);
+  MatMulBf16StoreRow(c + C4NUM * col_align, acc40, acc41, acc42, acc43, bias, act_type, col_num);
+}
+
+// A row and a block of b, for the remaining rows and the matrix-vector product, where b is read only once. The even
+// and the odd deep are accumulated apart to hide the latency of the fma.
+static void MatMulBf16Block1x64(const float *a, const float *b, float *c, const float *bias, int act_type, int depth,
+                                int col_num, int width) {
+  const __m512i high_mask = _mm512_set1_epi32((int)0xFFFF0000);
+  int group_num = width / C16NUM;
+  int b1 = MSMIN(C1NUM, group_num - 1) * C16NUM;
+  int b2 = MSMIN(C2NUM, group_num - 1) * C16NUM;
+  int b3 = MSMIN(C3NUM, group_num - 1) * C16NUM;
+  __m512 even0 = _mm512_setzero_ps(), even1 = _mm512_setzero_ps();
+  __m512 even2 = _mm512_setzero_ps(), even3 = _mm512_setzero_ps();
+  __m512 odd0 = _mm512_setzero_ps(), odd1 = _mm512_setzero_ps();
+  __m512 odd2 = _mm512_setzero_ps(), odd3 = _mm512_setzero_ps();
+  const float *b_pair = b;
+  int d = 0;
+  for (; d + 1 < depth; d += C2NUM, b_pair += width) {
+    __m512 x = _mm512_set1_ps(a[d]);
+    even0 = _mm512_fmadd_ps(x, MatMulBf16Even(b_pair), even0);
+    even1 = _mm512_fmadd_ps(x, MatMulBf16Even(b_pair + b1), even1);
+    even2 = _mm512_fmadd_ps(x, MatMulBf16Even(b_pair + b2), even2);
+    even3 = _mm512_fmadd_ps(x, MatMulBf16Even(b_pair + b3), even3);
+    x = _mm512_set1_ps(a[d + 1]);
+    odd0 = _mm512_fmadd_ps(x, MatMulBf16Odd(b_pair, high_mask), odd0);
+    odd1 = _mm512_fmadd_ps(x, MatMulBf16Odd(b_pair + b1, high_mask), odd1);
+    odd2 = _mm512_fmadd_ps(x, MatMulBf16Odd(b_pair + b2, high_mask), odd2);
+    odd3 = _mm512_fmadd_ps(x, MatMulBf16Odd(b_pair + b3, high_mask), odd3);
+  }
+  if (d < depth) {
+    __m512 x = _mm512_set1_ps(a[d]);
+    even0 = _mm512_fmadd_ps(x, MatMulBf16Even(b_pair), even0);
+    even1 = _mm512_fmadd_ps(x, MatMulBf16Even(b_pair + b1), even1);
+    even2 = _mm512_fmadd_ps(x, MatMulBf16Even(b_pair + b2), even2);
+    even3 = _mm512_fmadd_ps(x, MatMulBf16Even(b_pair + b3), even3);
+  }
+  MatMulBf16StoreRow(c, _mm512_add_ps(even0, odd0), _mm512_add_ps(even1, odd1), _mm512_add_ps(even2, odd2),
+                     _mm512_add_ps(even3, odd3), bias, act_type, col_num);
+}
+
+void MatMulAvx512Bf16Fp32(const float *a, const float *b, float *c, const float *bias, int act_type, int depth,
+                          int cur_col, int col_align, int row) {
+  int deep_pair = UP_DIV(depth, C2NUM);
+  for (int col_index = 0; col_index < cur_col; col_index += C64NUM) {
+    int col_num = MSMIN(C64NUM, cur_col - col_index);
+    int width = UP_ROUND(col_num, C16NUM);
+    const float *b_block = b + col_index * deep_pair;
+    const float *bias_block = bias == NULL ? NULL : bias + col_index;
+    int m = 0;
+    for (; m + C5NUM <= row; m += C5NUM) {
+      MatMulBf16Block5x64(a + m * depth, b_block, c + m * col_align + col_index, bias_block, act_type, depth, col_num,
+                          width, col_align);
+    }
+    for (; m < row; ++m) {
+      MatMulBf16Block1x64(a + m * depth, b_block, c + m * col_align + col_index, bias_block, act_type, depth, col_num,
+                          width);
+    }
+  }
+}
+#endif
@@ -0,0 +1,44 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_NNACL_FP32_MATMUL_AVX512_BF16_FP32_H_
+#define MINDSPORE_NNACL_FP32_MATMUL_AVX512_BF16_FP32_H_
+
+#include "nnacl/op_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#ifdef ENABLE_AVX512
+// The packing of b for MatMulAvx512Bf16Fp32. The blocks of 64 (or the remaining 48, 32, 16) columns are those of
+// RowMajor2Row64Major / RowMajor2Col64Major, but a block holds the deep in pairs of bfloat16: the 32-bit word
+// k * width + j of a block of width columns holds the deep 2k and 2k + 1 of the column j. So the packed b takes
+// UP_DIV(deep, 2) * col_align words of float, the half of the float32 packing.
+void RowMajor2Row64MajorBf16Parallel(const float *src_ptr, float *dst_ptr, int col, int row, int col_start,
+                                     int col_end);
+void RowMajor2Col64MajorBf16Parallel(const float *src_ptr, float *dst_ptr, int row, int col, int row_start,
+                                     int row_end);
+
+// c = act(a * b + bias) with the bfloat16 b widened to float32 in the registers and float32 fma, so only avx512f is
+// needed and a keeps its float32 precision. a is float32 in row-major, b is packed by the functions above, col_align
+// is the row stride of c. The weight read is halved, which is what bounds the matrix-vector product of the decoding.
+void MatMulAvx512Bf16Fp32(const float *a, const float *b, float *c, const float *bias, int act_type, int depth,
+                          int cur_col, int col_align, int row);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_FP32_MATMUL_AVX512_BF16_FP32_H_
@@ -92,6 +92,39 @@ void GemmRowxColMaskKernelFp32(float *dst, const float *src, const float *weight
   }
 }
 
+#ifndef ENABLE_DEBUG
+// The tiles of fewer than 8 accumulators can't hide the latency of the fma, so their kernels split the depth over
+// several sets of accumulators, which are added up at the end.
+static const GemmAvx512MaskKernel kGemmAvx512MaskKernel[C4NUM][C13NUM] = {
+  {NULL, nnacl_gemm_avx512_1x16_mask_split_kernel_nhwc_fp32, nnacl_gemm_avx512_2x16_mask_split_kernel_nhwc_fp32,
+   nnacl_gemm_avx512_3x16_mask_split_kernel_nhwc_fp32, nnacl_gemm_avx512_4x16_mask_split_kernel_nhwc_fp32,
+   nnacl_gemm_avx512_5x16_mask_split_kernel_nhwc_fp32, nnacl_gemm_avx512_6x16_mask_split_kernel_nhwc_fp32,
+   nnacl_gemm_avx512_7x16_mask_split_kernel_nhwc_fp32, nnacl_gemm_avx512_8x16_mask_kernel_nhwc_fp32,
+   nnacl_gemm_avx512_9x16_mask_kernel_nhwc_fp32, nnacl_gemm_avx512_10x16_mask_kernel_nhwc_fp32,
+   nnacl_gemm_avx512_11x16_mask_kernel_nhwc_fp32, nnacl_gemm_avx512_12x16_mask_kernel_nhwc_fp32},
+  {NULL, nnacl_gemm_avx512_1x32_mask_split_kernel_nhwc_fp32, nnacl_gemm_avx512_2x32_mask_split_kernel_nhwc_fp32,
+   nnacl_gemm_avx512_3x32_mask_split_kernel_nhwc_fp32, nnacl_gemm_avx512_4x32_mask_kernel_nhwc_fp32,
+   nnacl_gemm_avx512_5x32_mask_kernel_nhwc_fp32, nnacl_gemm_avx512_6x32_mask_kernel_nhwc_fp32,
+   nnacl_gemm_avx512_7x32_mask_kernel_nhwc_fp32, nnacl_gemm_avx512_8x32_mask_kernel_nhwc_fp32,
+   nnacl_gemm_avx512_9x32_mask_kernel_nhwc_fp32, nnacl_gemm_avx512_10x32_mask_kernel_nhwc_fp32,
+   nnacl_gemm_avx512_11x32_mask_kernel_nhwc_fp32, nnacl_gemm_avx512_12x32_mask_kernel_nhwc_fp32},
+  {NULL, nnacl_gemm_avx512_1x48_mask_split_kernel_nhwc_fp32, nnacl_gemm_avx512_2x48_mask_split_kernel_nhwc_fp32,
+   nnacl_gemm_avx512_3x48_mask_kernel_nhwc_fp32, nnacl_gemm_avx512_4x48_mask_kernel_nhwc_fp32,
+   nnacl_gemm_avx512_5x48_mask_kernel_nhwc_fp32, nnacl_gemm_avx512_6x48_mask_kernel_nhwc_fp32,
+   nnacl_gemm_avx512_7x48_mask_kernel_nhwc_fp32, nnacl_gemm_avx512_8x48_mask_kernel_nhwc_fp32},
+  {NULL, nnacl_gemm_avx512_1x64_mask_split_kernel_nhwc_fp32, nnacl_gemm_avx512_2x64_mask_kernel_nhwc_fp32,
+   nnacl_gemm_avx512_3x64_mask_kernel_nhwc_fp32, nnacl_gemm_avx512_4x64_mask_kernel_nhwc_fp32,
+   nnacl_gemm_avx512_5x64_mask_kernel_nhwc_fp32, nnacl_gemm_avx512_6x64_mask_kernel_nhwc_fp32}};
+#endif
+
+static GemmAvx512MaskKernel GetGemmAvx512MaskKernel(int col_block_num, int row_block) {
+#ifdef ENABLE_DEBUG
+  return GemmRowxColMaskKernelFp32;
+#else
+  return kGemmAvx512MaskKernel[col_block_num - 1][row_block];
+#endif
+}
+
 void MatMulMaskAvx512Fp32(const float *a, const float *b, float *c, const float *bias, const int act_type,
                           const int depth, const int cur_col, const int col_, const int row) {
   int k_block = C1500NUM;
@@ -102,59 +135,8 @@ void MatMulMaskAvx512Fp32(const float *a, const float *b, float *c, const float
   if (act_type == ActType_Relu || act_type == ActType_Relu6) {
     act_flag += C2NUM;
   }
-  GemmAvx512MaskKernel kernel[C4NUM][C13NUM];
   int max_shape[C4NUM] = {C12NUM, C12NUM, C8NUM, C6NUM};
 
-#ifdef ENABLE_DEBUG
-  for (int i = 0; i < C4NUM; i++) {
-    for (int j = 0; j < C13NUM; j++) {
-      kernel[i][j] = GemmRowxColMaskKernelFp32;
-    }
-  }
-#else
-  kernel[0][1] = nnacl_gemm_avx512_1x16_mask_kernel_nhwc_fp32;
-  kernel[0][2] = nnacl_gemm_avx512_2x16_mask_kernel_nhwc_fp32;
-  kernel[0][3] = nnacl_gemm_avx512_3x16_mask_kernel_nhwc_fp32;
-  kernel[0][4] = nnacl_gemm_avx512_4x16_mask_kernel_nhwc_fp32;
-  kernel[0][5] = nnacl_gemm_avx512_5x16_mask_kernel_nhwc_fp32;
-  kernel[0][6] = nnacl_gemm_avx512_6x16_mask_kernel_nhwc_fp32;
-  kernel[0][7] = nnacl_gemm_avx512_7x16_mask_kernel_nhwc_fp32;
-  kernel[0][8] = nnacl_gemm_avx512_8x16_mask_kernel_nhwc_fp32;
-  kernel[0][9] = nnacl_gemm_avx512_9x16_mask_kernel_nhwc_fp32;
-  kernel[0][10] = nnacl_gemm_avx512_10x16_mask_kernel_nhwc_fp32;
-  kernel[0][11] = nnacl_gemm_avx512_11x16_mask_kernel_nhwc_fp32;
-  kernel[0][12] = nnacl_gemm_avx512_12x16_mask_kernel_nhwc_fp32;
-
-  kernel[1][1] = nnacl_gemm_avx512_1x32_mask_kernel_nhwc_fp32;
-  kernel[1][2] = nnacl_gemm_avx512_2x32_mask_kernel_nhwc_fp32;
-  kernel[1][3] = nnacl_gemm_avx512_3x32_mask_kernel_nhwc_fp32;
-  kernel[1][4] = nnacl_gemm_avx512_4x32_mask_kernel_nhwc_fp32;
-  kernel[1][5] = nnacl_gemm_avx512_5x32_mask_kernel_nhwc_fp32;
-  kernel[1][6] = nnacl_gemm_avx512_6x32_mask_kernel_nhwc_fp32;
-  kernel[1][7] = nnacl_gemm_avx512_7x32_mask_kernel_nhwc_fp32;
-  kernel[1][8] = nnacl_gemm_avx512_8x32_mask_kernel_nhwc_fp32;
-  kernel[1][9] = nnacl_gemm_avx512_9x32_mask_kernel_nhwc_fp32;
-  kernel[1][10] = nnacl_gemm_avx512_10x32_mask_kernel_nhwc_fp32;
-  kernel[1][11] = nnacl_gemm_avx512_11x32_mask_kernel_nhwc_fp32;
-  kernel[1][12] = nnacl_gemm_avx512_12x32_mask_kernel_nhwc_fp32;
-
-  kernel[2][1] = nnacl_gemm_avx512_1x48_mask_kernel_nhwc_fp32;
-  kernel[2][2] = nnacl_gemm_avx512_2x48_mask_kernel_nhwc_fp32;
-  kernel[2][3] = nnacl_gemm_avx512_3x48_mask_kernel_nhwc_fp32;
-  kernel[2][4] = nnacl_gemm_avx512_4x48_mask_kernel_nhwc_fp32;
-  kernel[2][5] = nnacl_gemm_avx512_5x48_mask_kernel_nhwc_fp32;
-  kernel[2][6] = nnacl_gemm_avx512_6x48_mask_kernel_nhwc_fp32;
-  kernel[2][7] = nnacl_gemm_avx512_7x48_mask_kernel_nhwc_fp32;
-  kernel[2][8] = nnacl_gemm_avx512_8x48_mask_kernel_nhwc_fp32;
-
-  kernel[3][1] = nnacl_gemm_avx512_1x64_mask_kernel_nhwc_fp32;
-  kernel[3][2] = nnacl_gemm_avx512_2x64_mask_kernel_nhwc_fp32;
-  kernel[3][3] = nnacl_gemm_avx512_3x64_mask_kernel_nhwc_fp32;
-  kernel[3][4] = nnacl_gemm_avx512_4x64_mask_kernel_nhwc_fp32;
-  kernel[3][5] = nnacl_gemm_avx512_5x64_mask_kernel_nhwc_fp32;
-  kernel[3][6] = nnacl_gemm_avx512_6x64_mask_kernel_nhwc_fp32;
-#endif
-
   int inc_flag;
   for (int k = 0; k < depth; k += k_block) {
     if (depth - k <= k_block) {
@@ -177,9 +159,10 @@ void MatMulMaskAvx512Fp32(const float *a, const float *b, float *c, const float
       int row_block = max_shape[col_block_num - 1];
       for (int m = 0; m < row; m += row_block) {
         row_block = MSMIN(row_block, row - m);
-        kernel[col_block_num - 1][row_block](c + col_index + m * col_, a + m * depth + k,
-                                             b + col_index * depth + k * col_block, bias_data, act_flag, row_block,
-                                             col_block_num, k_block, depth, col_, inc_flag, &avx512_mask);
+        GetGemmAvx512MaskKernel(col_block_num, row_block)(c + col_index + m * col_, a + m * depth + k,
+                                                          b + col_index * depth + k * col_block, bias_data, act_flag,
+                                                          row_block, col_block_num, k_block, depth, col_, inc_flag,
+                                                          &avx512_mask);
       }
       if (bias_data != NULL) {
         bias_data += col_block;
@@ -199,14 +182,6 @@ void MatVecMulMaskAvx512Fp32(const float *a, const float *b, float *c, const flo
   if (act_type == ActType_Relu || act_type == ActType_Relu6) {
     act_flag += C2NUM;
   }
-#ifdef ENABLE_DEBUG
-  GemmAvx512MaskKernel kernel[C4NUM] = {GemmRowxColMaskKernelFp32, GemmRowxColMaskKernelFp32, GemmRowxColMaskKernelFp32,
-                                        GemmRowxColMaskKernelFp32};
-#else
-  GemmAvx512MaskKernel kernel[C4NUM] = {
-    nnacl_gemm_avx512_1x16_mask_kernel_nhwc_fp32, nnacl_gemm_avx512_1x32_mask_kernel_nhwc_fp32,
-    nnacl_gemm_avx512_1x48_mask_kernel_nhwc_fp32, nnacl_gemm_avx512_1x64_mask_kernel_nhwc_fp32};
-#endif
   int inc_flag;
   for (int k = 0; k < depth; k += k_block) {
     if (depth - k <= k_block) {
@@ -226,8 +201,9 @@ void MatVecMulMaskAvx512Fp32(const float *a, const float *b, float *c, const flo
       }
       int col_block_num = col_block >> C4NUM;
 
-      kernel[col_block_num - 1](c + col_index, a + k, b + col_index * depth + k * col_block, bias_data, act_flag, 1,
-                                col_block_num, k_block, depth, col_, inc_flag, &avx512_mask);
+      GetGemmAvx512MaskKernel(col_block_num, 1)(c + col_index, a + k, b + col_index * depth + k * col_block, bias_data,
+                                                act_flag, 1, col_block_num, k_block, depth, col_, inc_flag,
+                                                &avx512_mask);
       if (bias_data != NULL) {
         bias_data += col_block;
       }
@@ -0,0 +1,234 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/fp32_sparse/matmul_sparse_block_fp32.h"
+#include "nnacl/matmul_sparse_block_fp32_simd.h"
+
+static inline float SparseBlockValue(const float *b, int k, int j, int deep, int col, bool b_transpose) {
+  if (j >= col) {
+    return 0.0f;
+  }
+  return b_transpose ? b[j * deep + k] : b[k * col + j];
+}
+
+static bool IsZeroBlock4x4(const float *b, int kb, int cb, int deep, int col, bool b_transpose) {
+  for (int i = 0; i < C4NUM; ++i) {
+    for (int j = 0; j < C4NUM; ++j) {
+      if (SparseBlockValue(b, kb * C4NUM + i, cb * C4NUM + j, deep, col, b_transpose) != 0.0f) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static int CountBlock4x4(const float *b, int deep, int col, bool b_transpose) {
+  int count = 0;
+  for (int cb = 0; cb < UP_DIV(col, C4NUM); ++cb) {
+    for (int kb = 0; kb < deep / C4NUM; ++kb) {
+      count += IsZeroBlock4x4(b, kb, cb, deep, col, b_transpose) ? 0 : 1;
+    }
+  }
+  return count;
+}
+
+float SparseBlock4x4Density(const float *b, int deep, int col, bool b_transpose) {
+  int total = UP_DIV(col, C4NUM) * (deep / C4NUM);
+  if (total == 0) {
+    return 1.0f;
+  }
+  return (float)CountBlock4x4(b, deep, col, b_transpose) / total;
+}
+
+bool IsSparse2x4(const float *b, int deep, int col, bool b_transpose) {
+  if (deep % C4NUM != 0) {
+    return false;
+  }
+  for (int j = 0; j < col; ++j) {
+    for (int k = 0; k < deep; k += C4NUM) {
+      int non_zero = 0;
+      for (int i = 0; i < C4NUM; ++i) {
+        non_zero += SparseBlockValue(b, k + i, j, deep, col, b_transpose) != 0.0f ? 1 : 0;
+      }
+      if (non_zero > C2NUM) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int SparseBlockPackSize(SparseBlockFormat format, const float *b, int deep, int col, bool b_transpose) {
+  int col_block = UP_DIV(col, C4NUM);
+  if (format == SparseBlock_4x4) {
+    int block_num = CountBlock4x4(b, deep, col, b_transpose);
+    return col_block + 1 + block_num * (C16NUM + 1);
+  }
+  return UP_DIV(col, C16NUM) * (deep / C4NUM) * (C16NUM * C2NUM + C4NUM);
+}
+
+static void SparseBlockPack4x4(const float *b, float *dst, int deep, int col, bool b_transpose) {
+  int col_block = UP_DIV(col, C4NUM);
+  int *block_offset = (int *)dst;
+  int *block_index = block_offset + col_block + 1;
+  int block_num = 0;
+  block_offset[0] = 0;
+  for (int cb = 0; cb < col_block; ++cb) {
+    for (int kb = 0; kb < deep / C4NUM; ++kb) {
+      if (!IsZeroBlock4x4(b, kb, cb, deep, col, b_transpose)) {
+        block_index[block_num++] = kb;
+      }
+    }
+    block_offset[cb + 1] = block_num;
+  }
+  float *block_data = dst + col_block + 1 + block_num;
+  for (int cb = 0; cb < col_block; ++cb) {
+    for (int n = block_offset[cb]; n < block_offset[cb + 1]; ++n) {
+      for (int i = 0; i < C4NUM; ++i) {
+        for (int j = 0; j < C4NUM; ++j) {
+          block_data[i * C4NUM + j] =
+            SparseBlockValue(b, block_index[n] * C4NUM + i, cb * C4NUM + j, deep, col, b_transpose);
+        }
+      }
+      block_data += C16NUM;
+    }
+  }
+}
+
+static void SparseBlockPack2x4(const float *b, float *dst, int deep, int col, bool b_transpose) {
+  for (int p = 0; p < UP_DIV(col, C16NUM); ++p) {
+    for (int k = 0; k < deep; k += C4NUM) {
+      uint8_t *w_index = (uint8_t *)(dst + C16NUM * C2NUM);
+      for (int j = 0; j < C16NUM; ++j) {
+        // an unused value is zero, so any place of the 4 deep will do.
+        int place[C2NUM] = {0, 0};
+        float value[C2NUM] = {0.0f, 0.0f};
+        int non_zero = 0;
+        for (int i = 0; i < C4NUM && non_zero < C2NUM; ++i) {
+          float v = SparseBlockValue(b, k + i, p * C16NUM + j, deep, col, b_transpose);
+          if (v != 0.0f) {
+            place[non_zero] = i;
+            value[non_zero++] = v;
+          }
+        }
+        dst[j] = value[0];
+        dst[C16NUM + j] = value[1];
+        w_index[j] = (uint8_t)(place[0] | (place[1] << C2NUM));
+      }
+      dst += C16NUM * C2NUM + C4NUM;
+    }
+  }
+}
+
+void SparseBlockPack(SparseBlockFormat format, const float *b, float *dst, int deep, int col, bool b_transpose) {
+  if (format == SparseBlock_4x4) {
+    SparseBlockPack4x4(b, dst, deep, col, b_transpose);
+  } else {
+    SparseBlockPack2x4(b, dst, deep, col, b_transpose);
+  }
+}
+
+static inline float SparseBlockActScalar(float dst, int act_type) {
+  if (act_type != ActType_No) {
+    dst = MSMAX(dst, 0.0f);
+    if (act_type == ActType_Relu6) {
+      dst = MSMIN(dst, 6.0f);
+    }
+  }
+  return dst;
+}
+
+static void MatMulSparse4x4Row(const float *a, const float *packed_b, const float *bias, float *c, int act_type,
+                               int col, int a_stride, int col_block_start, int col_block_end) {
+  int col_block = UP_DIV(col, C4NUM);
+  const int *block_offset = (const int *)packed_b;
+  const int *block_index = block_offset + col_block + 1;
+  const float *block_data = packed_b + col_block + 1 + block_offset[col_block];
+  for (int cb = col_block_start; cb < col_block_end; ++cb) {
+    float dst[C4NUM];
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
+    MS_FLOAT32X4 dst0 = bias == NULL ? MS_MOVQ_F32(0.0f) : MS_LDQ_F32(bias + cb * C4NUM);
+    MS_FLOAT32X4 dst1 = MS_MOVQ_F32(0.0f);
+    for (int n = block_offset[cb]; n < block_offset[cb + 1]; ++n) {
+      const float *src_a = a + block_index[n] * C4NUM * a_stride;
+      const float *w = block_data + n * C16NUM;
+      dst0 = MS_MLAQ_F32(dst0, MS_MOVQ_F32(src_a[0]), MS_LDQ_F32(w));
+      dst1 = MS_MLAQ_F32(dst1, MS_MOVQ_F32(src_a[a_stride]), MS_LDQ_F32(w + C4NUM));
+      dst0 = MS_MLAQ_F32(dst0, MS_MOVQ_F32(src_a[C2NUM * a_stride]), MS_LDQ_F32(w + C8NUM));
+      dst1 = MS_MLAQ_F32(dst1, MS_MOVQ_F32(src_a[C3NUM * a_stride]), MS_LDQ_F32(w + C12NUM));
+    }
+    MS_STQ_F32(dst, MS_ADDQ_F32(dst0, dst1));
+#else
+    for (int j = 0; j < C4NUM; ++j) {
+      dst[j] = bias == NULL ? 0.0f : bias[cb * C4NUM + j];
+    }
+    for (int n = block_offset[cb]; n < block_offset[cb + 1]; ++n) {
+      const float *src_a = a + block_index[n] * C4NUM * a_stride;
+      const float *w = block_data + n * C16NUM;
+      for (int i = 0; i < C4NUM; ++i) {
+        for (int j = 0; j < C4NUM; ++j) {
+          dst[j] += src_a[i * a_stride] * w[i * C4NUM + j];
+        }
+      }
+    }
+#endif
+    for (int j = 0; j < MSMIN(C4NUM, col - cb * C4NUM); ++j) {
+      c[cb * C4NUM + j] = SparseBlockActScalar(dst[j], act_type);
+    }
+  }
+}
+
+void MatMulSparse4x4Fp32(const float *a, const float *packed_b, const float *bias, float *c, int act_type, int deep,
+                         int row, int col, int c_stride, int row_start, int row_end, int col_block_start,
+                         int col_block_end) {
+  for (int tile_start = row_start; tile_start < row_end; tile_start += C32NUM) {
+    // the tile of RowMajor2Col32Major, the last one is 8, 16 or 24 wide.
+    const float *a_tile = a + tile_start * deep;
+    int a_stride = row == 1 ? 1 : MSMIN(C32NUM, UP_ROUND(row, C8NUM) - tile_start);
+    int tile_row = MSMIN(C32NUM, row_end - tile_start);
+    float *c_tile = c + tile_start * c_stride;
+    int64_t index = 0;
+    SIMD_RUN_NO_SCALAR(MatMulSparse4x4Core, index, a_tile, packed_b, bias, c_tile, act_type, col, a_stride, c_stride,
+                       tile_row, col_block_start, col_block_end);
+    for (; index < tile_row; ++index) {
+      MatMulSparse4x4Row(a_tile + index, packed_b, bias, c_tile + index * c_stride, act_type, col, a_stride,
+                         col_block_start, col_block_end);
+    }
+  }
+}
+
+void MatMulSparse2x4Fp32(const float *a, const float *packed_b, const float *bias, float *c, int act_type, int deep,
+                         int row, int c_stride, int col_start, int col_end) {
+  int64_t index = col_start;
+  SIMD_RUN_NO_SCALAR(MatMulSparse2x4Core, index, a, packed_b, bias, c, act_type, deep, row, c_stride, col_end);
+  int group = deep / C4NUM;
+  int group_size = C16NUM * C2NUM + C4NUM;
+  for (; index < col_end; ++index) {
+    int j = index % C16NUM;
+    for (int r = 0; r < row; ++r) {
+      const float *src_a = a + r * deep;
+      const float *w = packed_b + index / C16NUM * group * group_size;
+      float dst = bias == NULL ? 0.0f : bias[index];
+      for (int g = 0; g < group; ++g) {
+        uint8_t w_index = ((const uint8_t *)(w + C16NUM * C2NUM))[j];
+        dst += src_a[w_index & 0x3] * w[j] + src_a[w_index >> C2NUM] * w[C16NUM + j];
+        src_a += C4NUM;
+        w += group_size;
+      }
+      c[r * c_stride + index] = SparseBlockActScalar(dst, act_type);
+    }
+  }
+}
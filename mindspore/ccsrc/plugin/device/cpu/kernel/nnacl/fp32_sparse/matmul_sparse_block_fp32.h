@@ -0,0 +1,65 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_NNACL_FP32_SPARSE_MATMUL_SPARSE_BLOCK_FP32_H_
+#define MINDSPORE_NNACL_FP32_SPARSE_MATMUL_SPARSE_BLOCK_FP32_H_
+
+#include <stdbool.h>
+#include "nnacl/op_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The structured sparse b of c = a * b, b is deep x col (or col x deep when transposed) and the deep must be a multiple
+// of 4. The columns past col are padded with zero.
+typedef enum SparseBlockFormat {
+  SparseBlock_None = 0,
+  SparseBlock_4x4 = 1,  // the 4x4 blocks which are not all zero
+  SparseBlock_2x4 = 2,  // at most 2 non-zero of every 4 deep of a column, as the n:m sparsity of 2:4
+} SparseBlockFormat;
+
+// The ratio of the 4x4 blocks of b which are not all zero.
+float SparseBlock4x4Density(const float *b, int deep, int col, bool b_transpose);
+bool IsSparse2x4(const float *b, int deep, int col, bool b_transpose);
+
+// The size of the encoded b, in words of float.
+// 4x4: the offsets of every block of 4 columns (UP_DIV(col, 4) + 1 int), the deep block index of every non-zero block
+//      (int) and the non-zero blocks, [deep 4][col 4] each.
+// 2x4: for every 16 columns and every 4 deep, the first and the second value of each column (2 x 16 float) and the
+//      places of them in the 4 deep, a byte of 2 x 2 bits for each column (4 words).
+int SparseBlockPackSize(SparseBlockFormat format, const float *b, int deep, int col, bool b_transpose);
+void SparseBlockPack(SparseBlockFormat format, const float *b, float *dst, int deep, int col, bool b_transpose);
+
+// c = act(a * b + bias) for the blocks of 4 columns [col_block_start, col_block_end) and the rows [row_start, row_end),
+// row_start is a multiple of 32. a is packed by RowMajor2Col32Major, but for a single row, so that the rows are the
+// vector lanes and a tile of them stays in the cache for all the blocks. c is row-major with c_stride, bias is NULL or
+// padded with zero to UP_ROUND(col, 4).
+void MatMulSparse4x4Fp32(const float *a, const float *packed_b, const float *bias, float *c, int act_type, int deep,
+                         int row, int col, int c_stride, int row_start, int row_end, int col_block_start,
+                         int col_block_end);
+
+// c = act(a * b + bias) for the columns [col_start, col_end), col_start is a multiple of 16. a is row-major, the
+// columns are the vector lanes and the values of a group are taken from the 4 of a by a permute, so there is one fma
+// per non-zero and the weight read is about the half of the dense one. Only the columns in the range are written, bias
+// is NULL or padded with zero to a multiple of 16 columns.
+void MatMulSparse2x4Fp32(const float *a, const float *packed_b, const float *bias, float *c, int act_type, int deep,
+                         int row, int c_stride, int col_start, int col_end);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // MINDSPORE_NNACL_FP32_SPARSE_MATMUL_SPARSE_BLOCK_FP32_H_
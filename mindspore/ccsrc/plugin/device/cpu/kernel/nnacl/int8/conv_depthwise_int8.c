@@ -20,7 +20,7 @@
 #include "nnacl/int8/common_func_int8.h"
 
 /*conv depthwise int8 begin*/
-#ifndef ENABLE_ARM
+#if !defined(ENABLE_ARM) && !defined(ENABLE_AVX)
 void ConvDwInt8Row(int32_t *output_ptr, const int8_t *input_ptr, const int16_t *weight_ptr, int num_pixels,
                    int output_channel, int input_step, int8_t input_zp) {
   for (int i = 0; i < num_pixels; i++) {
@@ -40,7 +40,7 @@ void ConvDwInt8Post(int8_t *dst, int32_t *buffer, int output_w, int channel, int
     // support perchannel
     for (int w = 0; w < output_w; w++) {
       int channel4 = 0;
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_AVX)
       channel4 = channel / 4 * 4;
       ConvDwInt8PostAlign4PerChannel(dst, buffer, channel4, output_zp, out_multiplier, left_shift, right_shift, acc_min,
                                      acc_max);
@@ -60,7 +60,7 @@ void ConvDwInt8Post(int8_t *dst, int32_t *buffer, int output_w, int channel, int
   } else {
     int num_pixels = output_w * channel;
     int align_num = 0;
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_AVX)
     align_num = num_pixels / 4 * 4;
     ConvDwInt8PostAlign4(dst, buffer, align_num, output_zp, out_multiplier[0], left_shift[0], right_shift[0], acc_min,
                          acc_max);
@@ -0,0 +1,185 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX512
+#include "nnacl/int8/matmul_avx512_vnni_int8.h"
+#ifdef _MSC_VER
+#include <immintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+// The avx512 MultiplyByQuantizedMultiplierAvx of nnacl/intrinsics/avx/common_utils.h.
+static inline __m512i MultiplyByQuantizedMultiplierAvx512(__m512i value, __m512i multiplier, __m512i left_shift,
+                                                          __m512i right_shift) {
+  const __m512i a = _mm512_sllv_epi32(value, left_shift);
+  const __m512i round = _mm512_set1_epi64(1LL << 30);
+  __m512i even = _mm512_mul_epi32(a, multiplier);
+  __m512i odd = _mm512_mul_epi32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(multiplier, 32));
+  even = _mm512_srli_epi64(_mm512_add_epi64(even, round), 31);
+  odd = _mm512_slli_epi64(_mm512_srli_epi64(_mm512_add_epi64(odd, round), 31), 32);
+  __m512i high = _mm512_mask_blend_epi32(0xAAAA, even, odd);
+  const __m512i int_min = _mm512_set1_epi32(INT32_MIN);
+  __mmask16 overflow = _mm512_cmpeq_epi32_mask(a, int_min) & _mm512_cmpeq_epi32_mask(multiplier, int_min);
+  high = _mm512_mask_mov_epi32(high, overflow, _mm512_set1_epi32(INT32_MAX));
+
+  const __m512i one = _mm512_set1_epi32(1);
+  const __m512i exponent = _mm512_sub_epi32(_mm512_setzero_si512(), right_shift);
+  const __m512i mask = _mm512_sub_epi32(_mm512_sllv_epi32(one, exponent), one);
+  const __m512i remainder = _mm512_and_si512(high, mask);
+  const __m512i threshold = _mm512_add_epi32(_mm512_srai_epi32(mask, 1), _mm512_srli_epi32(high, 31));
+  __m512i result = _mm512_srav_epi32(high, exponent);
+  return _mm512_mask_add_epi32(result, _mm512_cmpgt_epi32_mask(remainder, threshold), result, one);
+}
+
+// The 16 dot products of a row, the 128-bit lane j of acc_k holds the 4 partial sums of the column 4 * k + j.
+static inline __m512i MatmulInt8ReduceAvx512(__m512i acc0, __m512i acc1, __m512i acc2, __m512i acc3) {
+  __m512i sum01 = _mm512_add_epi32(_mm512_unpacklo_epi32(acc0, acc1), _mm512_unpackhi_epi32(acc0, acc1));
+  __m512i sum23 = _mm512_add_epi32(_mm512_unpacklo_epi32(acc2, acc3), _mm512_unpackhi_epi32(acc2, acc3));
+  // the int32 4 * j + k is the column 4 * k + j
+  __m512i sum = _mm512_add_epi32(_mm512_unpacklo_epi64(sum01, sum23), _mm512_unpackhi_epi64(sum01, sum23));
+  const __m512i index = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+  return _mm512_permutexvar_epi32(index, sum);
+}
+
+// 128 * the sums of the 16 columns of the 4 col4x16-major tiles of b.
+static __m512i MatmulInt8ColSumsAvx512Vnni(const int8_t *const *b, int deep16) {
+  const __m512i offset = _mm512_set1_epi8((char)0x80);
+  __m512i acc0 = _mm512_setzero_si512();
+  __m512i acc1 = _mm512_setzero_si512();
+  __m512i acc2 = _mm512_setzero_si512();
+  __m512i acc3 = _mm512_setzero_si512();
+  for (int d = 0; d < deep16 * C4NUM; d += C4NUM * C16NUM) {
+    acc0 = _mm512_dpbusd_epi32(acc0, offset, _mm512_loadu_si512(b[0] + d));
+    acc1 = _mm512_dpbusd_epi32(acc1, offset, _mm512_loadu_si512(b[1] + d));
+    acc2 = _mm512_dpbusd_epi32(acc2, offset, _mm512_loadu_si512(b[2] + d));
+    acc3 = _mm512_dpbusd_epi32(acc3, offset, _mm512_loadu_si512(b[3] + d));
+  }
+  return MatmulInt8ReduceAvx512(acc0, acc1, acc2, acc3);
+}
+
+// The dot products of the 4 rows of a row4x16-major tile, offset by 128, and the 4 col4x16-major tiles of b. The 16
+// accumulators, the 4 tiles of b and a row stay in the registers.
+static void MatmulInt8Dot4x16Avx512Vnni(const int8_t *a, const int8_t *const *b, int deep16, __m512i *dot) {
+  const __m512i offset = _mm512_set1_epi8((char)0x80);
+  const int8_t *b0 = b[0];
+  const int8_t *b1 = b[1];
+  const int8_t *b2 = b[2];
+  const int8_t *b3 = b[3];
+  __m512i acc00 = _mm512_setzero_si512();
+  __m512i acc01 = _mm512_setzero_si512();
+  __m512i acc02 = _mm512_setzero_si512();
+  __m512i acc03 = _mm512_setzero_si512();
+  __m512i acc10 = _mm512_setzero_si512();
+  __m512i acc11 = _mm512_setzero_si512();
+  __m512i acc12 = _mm512_setzero_si512();
+  __m512i acc13 = _mm512_setzero_si512();
+  __m512i acc20 = _mm512_setzero_si512();
+  __m512i acc21 = _mm512_setzero_si512();
+  __m512i acc22 = _mm512_setzero_si512();
+  __m512i acc23 = _mm512_setzero_si512();
+  __m512i acc30 = _mm512_setzero_si512();
+  __m512i acc31 = _mm512_setzero_si512();
+  __m512i acc32 = _mm512_setzero_si512();
+  __m512i acc33 = _mm512_setzero_si512();
+  for (int d = 0; d < deep16 * C4NUM; d += C4NUM * C16NUM) {
+    __m512i b_tile0 = _mm512_loadu_si512(b0 + d);
+    __m512i b_tile1 = _mm512_loadu_si512(b1 + d);
+    __m512i b_tile2 = _mm512_loadu_si512(b2 + d);
+    __m512i b_tile3 = _mm512_loadu_si512(b3 + d);
+    const int8_t *a_tile = a + d;
+
+    __m512i a_row = _mm512_xor_si512(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)a_tile)), offset);
+    acc00 = _mm512_dpbusd_epi32(acc00, a_row, b_tile0);
+    acc01 = _mm512_dpbusd_epi32(acc01, a_row, b_tile1);
+    acc02 = _mm512_dpbusd_epi32(acc02, a_row, b_tile2);
+    acc03 = _mm512_dpbusd_epi32(acc03, a_row, b_tile3);
+
+    a_row = _mm512_xor_si512(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)(a_tile + C16NUM))), offset);
+    acc10 = _mm512_dpbusd_epi32(acc10, a_row, b_tile0);
+    acc11 = _mm512_dpbusd_epi32(acc11, a_row, b_tile1);
+    acc12 = _mm512_dpbusd_epi32(acc12, a_row, b_tile2);
+    acc13 = _mm512_dpbusd_epi32(acc13, a_row, b_tile3);
+
+    a_row = _mm512_xor_si512(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)(a_tile + C32NUM))), offset);
+    acc20 = _mm512_dpbusd_epi32(acc20, a_row, b_tile0);
+    acc21 = _mm512_dpbusd_epi32(acc21, a_row, b_tile1);
+    acc22 = _mm512_dpbusd_epi32(acc22, a_row, b_tile2);
+    acc23 = _mm512_dpbusd_epi32(acc23, a_row, b_tile3);
+
+    a_row = _mm512_xor_si512(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)(a_tile + C48NUM))), offset);
+    acc30 = _mm512_dpbusd_epi32(acc30, a_row, b_tile0);
+    acc31 = _mm512_dpbusd_epi32(acc31, a_row, b_tile1);
+    acc32 = _mm512_dpbusd_epi32(acc32, a_row, b_tile2);
+    acc33 = _mm512_dpbusd_epi32(acc33, a_row, b_tile3);
+  }
+  dot[0] = MatmulInt8ReduceAvx512(acc00, acc01, acc02, acc03);
+  dot[1] = MatmulInt8ReduceAvx512(acc10, acc11, acc12, acc13);
+  dot[2] = MatmulInt8ReduceAvx512(acc20, acc21, acc22, acc23);
+  dot[3] = MatmulInt8ReduceAvx512(acc30, acc31, acc32, acc33);
+}
+
+void MatmulInt8OptAvx512Vnni(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16,
+                             const int32_t *a_sums, const int32_t *bias, int act_min, int act_max, int out_zp,
+                             const int32_t *multiplier, const int32_t *left_shift, const int32_t *right_shift,
+                             size_t stride, size_t filter_peroc, const int32_t *filter_zp) {
+  const __m512i out_zp_vec = _mm512_set1_epi32(out_zp);
+  const __m512i min_vec = _mm512_set1_epi32(act_min);
+  const __m512i max_vec = _mm512_set1_epi32(act_max);
+  int col4 = UP_DIV(col, C4NUM);
+  for (int c = 0; c < col; c += C16NUM) {
+    int cur_col = MSMIN(C16NUM, col - c);
+    __mmask16 col_mask = (__mmask16)((1u << (unsigned int)cur_col) - 1);
+    __m512i bias_vec = _mm512_maskz_loadu_epi32(col_mask, bias + c);
+    __m512i multiplier_vec;
+    __m512i left_shift_vec;
+    __m512i right_shift_vec;
+    __m512i filter_zp_vec;
+    if (filter_peroc) {
+      multiplier_vec = _mm512_maskz_loadu_epi32(col_mask, multiplier + c);
+      left_shift_vec = _mm512_maskz_loadu_epi32(col_mask, left_shift + c);
+      right_shift_vec = _mm512_maskz_loadu_epi32(col_mask, right_shift + c);
+      filter_zp_vec = _mm512_maskz_loadu_epi32(col_mask, filter_zp + c);
+    } else {
+      // a_sums already holds the input sums multiplied by the filter zp
+      multiplier_vec = _mm512_set1_epi32(multiplier[0]);
+      left_shift_vec = _mm512_set1_epi32(left_shift[0]);
+      right_shift_vec = _mm512_set1_epi32(right_shift[0]);
+      filter_zp_vec = _mm512_set1_epi32(1);
+    }
+    // the tiles past the columns are replaced by the first one, their results are not stored
+    const int8_t *b_ptr[C4NUM];
+    for (int j = 0; j < C4NUM; ++j) {
+      int c4 = c / C4NUM + j < col4 ? c / C4NUM + j : c / C4NUM;
+      b_ptr[j] = b + c4 * deep16 * C4NUM;
+    }
+    __m512i b_offset = MatmulInt8ColSumsAvx512Vnni(b_ptr, deep16);
+
+    for (int r = 0; r < row; r += C4NUM) {
+      __m512i dot[C4NUM];
+      MatmulInt8Dot4x16Avx512Vnni(a + r * deep16, b_ptr, deep16, dot);
+      for (int i = 0; i < C4NUM && r + i < row; ++i) {
+        __m512i input_sum = _mm512_mullo_epi32(_mm512_set1_epi32(a_sums[r + i]), filter_zp_vec);
+        __m512i value = _mm512_sub_epi32(dot[i], _mm512_add_epi32(b_offset, input_sum));
+        value = _mm512_add_epi32(value, bias_vec);
+        value = MultiplyByQuantizedMultiplierAvx512(value, multiplier_vec, left_shift_vec, right_shift_vec);
+        value = _mm512_add_epi32(value, out_zp_vec);
+        value = _mm512_min_epi32(_mm512_max_epi32(value, min_vec), max_vec);
+        _mm512_mask_cvtepi32_storeu_epi8(dst + (r + i) * stride + c, col_mask, value);
+      }
+    }
+  }
+}
+#endif
@@ -0,0 +1,38 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_NNACL_INT8_MATMUL_AVX512_VNNI_INT8_H_
+#define MINDSPORE_NNACL_INT8_MATMUL_AVX512_VNNI_INT8_H_
+
+#include "nnacl/op_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#ifdef ENABLE_AVX512
+// MatmulInt8Opt with the avx512 vnni vpdpbusd, the same layouts and results, only for the cpu of X86_Avx512Vnni_Support.
+// vpdpbusd multiplies uint8 by int8, so a is offset by 128 and 128 * the column sums of b are subtracted. A tile of 4
+// rows and 16 columns is computed at a time.
+void MatmulInt8OptAvx512Vnni(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16,
+                             const int32_t *a_sums, const int32_t *bias, int act_min, int act_max, int out_zp,
+                             const int32_t *multiplier, const int32_t *left_shift, const int32_t *right_shift,
+                             size_t stride, size_t filter_peroc, const int32_t *filter_zp);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_INT8_MATMUL_AVX512_VNNI_INT8_H_
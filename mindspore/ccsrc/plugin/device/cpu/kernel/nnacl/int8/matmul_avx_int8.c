@@ -0,0 +1,117 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX
+#include "nnacl/int8/matmul_avx_int8.h"
+#include "nnacl/intrinsics/avx/common_utils.h"
+
+// The dot products of a row and 4 columns, from the 8 partial sums of each column.
+static inline __m128i MatmulInt8ReduceAvx(__m256i acc0, __m256i acc1, __m256i acc2, __m256i acc3) {
+  __m256i sum = _mm256_hadd_epi32(_mm256_hadd_epi32(acc0, acc1), _mm256_hadd_epi32(acc2, acc3));
+  return _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+}
+
+// The dot products of 2 rows of a row4x16-major tile and the 4 columns of a col4x16-major tile. The 8 accumulators
+// stay in the registers, each column of b is widened once for the 2 rows.
+static void MatmulInt8Dot2x4Avx(const int8_t *a, const int8_t *b, int deep16, __m128i *dot0, __m128i *dot1) {
+  __m256i acc00 = _mm256_setzero_si256();
+  __m256i acc01 = _mm256_setzero_si256();
+  __m256i acc02 = _mm256_setzero_si256();
+  __m256i acc03 = _mm256_setzero_si256();
+  __m256i acc10 = _mm256_setzero_si256();
+  __m256i acc11 = _mm256_setzero_si256();
+  __m256i acc12 = _mm256_setzero_si256();
+  __m256i acc13 = _mm256_setzero_si256();
+  for (int d = 0; d < deep16; d += C16NUM) {
+    __m256i a0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)a));
+    __m256i a1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(a + C16NUM)));
+
+    __m256i b_col = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)b));
+    acc00 = _mm256_add_epi32(acc00, _mm256_madd_epi16(a0, b_col));
+    acc10 = _mm256_add_epi32(acc10, _mm256_madd_epi16(a1, b_col));
+
+    b_col = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b + C16NUM)));
+    acc01 = _mm256_add_epi32(acc01, _mm256_madd_epi16(a0, b_col));
+    acc11 = _mm256_add_epi32(acc11, _mm256_madd_epi16(a1, b_col));
+
+    b_col = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b + C32NUM)));
+    acc02 = _mm256_add_epi32(acc02, _mm256_madd_epi16(a0, b_col));
+    acc12 = _mm256_add_epi32(acc12, _mm256_madd_epi16(a1, b_col));
+
+    b_col = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b + C48NUM)));
+    acc03 = _mm256_add_epi32(acc03, _mm256_madd_epi16(a0, b_col));
+    acc13 = _mm256_add_epi32(acc13, _mm256_madd_epi16(a1, b_col));
+
+    a += C4NUM * C16NUM;
+    b += C4NUM * C16NUM;
+  }
+  *dot0 = MatmulInt8ReduceAvx(acc00, acc01, acc02, acc03);
+  *dot1 = MatmulInt8ReduceAvx(acc10, acc11, acc12, acc13);
+}
+
+void MatmulInt8OptAvx(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16,
+                      const int32_t *a_sums, const int32_t *bias, int act_min, int act_max, int out_zp,
+                      const int32_t *multiplier, const int32_t *left_shift, const int32_t *right_shift, size_t stride,
+                      size_t filter_peroc, const int32_t *filter_zp) {
+  const __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256i out_zp_vec = _mm256_set1_epi32(out_zp);
+  const __m256i min_vec = _mm256_set1_epi32(act_min);
+  const __m256i max_vec = _mm256_set1_epi32(act_max);
+  int col4 = UP_DIV(col, C4NUM);
+  for (int c = 0; c < col; c += C8NUM) {
+    int cur_col = MSMIN(C8NUM, col - c);
+    __m256i col_mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(cur_col), index);
+    __m256i bias_vec = _mm256_maskload_epi32(bias + c, col_mask);
+    __m256i multiplier_vec;
+    __m256i left_shift_vec;
+    __m256i right_shift_vec;
+    __m256i filter_zp_vec;
+    if (filter_peroc) {
+      multiplier_vec = _mm256_maskload_epi32(multiplier + c, col_mask);
+      left_shift_vec = _mm256_maskload_epi32(left_shift + c, col_mask);
+      right_shift_vec = _mm256_maskload_epi32(right_shift + c, col_mask);
+      filter_zp_vec = _mm256_maskload_epi32(filter_zp + c, col_mask);
+    } else {
+      // a_sums already holds the input sums multiplied by the filter zp
+      multiplier_vec = _mm256_set1_epi32(multiplier[0]);
+      left_shift_vec = _mm256_set1_epi32(left_shift[0]);
+      right_shift_vec = _mm256_set1_epi32(right_shift[0]);
+      filter_zp_vec = _mm256_set1_epi32(1);
+    }
+    const int8_t *b_ptr = b + c / C4NUM * deep16 * C4NUM;
+    bool has_next_col4 = c / C4NUM + 1 < col4;
+
+    // the rows are padded to 4 in a, an odd row is computed with the padding
+    for (int r = 0; r < row; r += C2NUM) {
+      const int8_t *a_ptr = a + r / C4NUM * deep16 * C4NUM + r % C4NUM * C16NUM;
+      __m128i dot[C2NUM][C2NUM] = {{_mm_setzero_si128(), _mm_setzero_si128()},
+                                  {_mm_setzero_si128(), _mm_setzero_si128()}};
+      MatmulInt8Dot2x4Avx(a_ptr, b_ptr, deep16, &dot[0][0], &dot[1][0]);
+      if (has_next_col4) {
+        MatmulInt8Dot2x4Avx(a_ptr, b_ptr + deep16 * C4NUM, deep16, &dot[0][1], &dot[1][1]);
+      }
+      for (int i = 0; i < C2NUM && r + i < row; ++i) {
+        __m256i value = _mm256_set_m128i(dot[i][1], dot[i][0]);
+        __m256i input_sum = _mm256_mullo_epi32(_mm256_set1_epi32(a_sums[r + i]), filter_zp_vec);
+        value = _mm256_add_epi32(_mm256_sub_epi32(value, input_sum), bias_vec);
+        value = MultiplyByQuantizedMultiplierAvx(value, multiplier_vec, left_shift_vec, right_shift_vec);
+        value = _mm256_add_epi32(value, out_zp_vec);
+        value = _mm256_min_epi32(_mm256_max_epi32(value, min_vec), max_vec);
+        StoreInt32ToInt8Avx(dst + (r + i) * stride + c, value, cur_col);
+      }
+    }
+  }
+}
+#endif
@@ -16,6 +16,13 @@
 
 #include "nnacl/int8/matmul_int8.h"
 #include "nnacl/int8/fixed_point.h"
+#ifdef ENABLE_AVX
+#include "nnacl/int8/matmul_avx_int8.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#endif
+#ifdef ENABLE_AVX512
+#include "nnacl/int8/matmul_avx512_vnni_int8.h"
+#endif
 
 void RowMajor2Row2x16MajorInt8(const int8_t *src_ptr, int8_t *dst_ptr, int row, int col) {
   int col16 = UP_ROUND(col, C16NUM);
@@ -303,6 +310,18 @@ void MatmulInt8Opt(const int8_t *a, const int8_t *b, int8_t *dst, int row, int c
    * a_sums is  perT  : input_row_sum * filter_zp
    *            perOc : input_row_sum
    * */
+#ifdef ENABLE_AVX512
+  if (X86_Avx512Vnni_Support()) {
+    MatmulInt8OptAvx512Vnni(a, b, dst, row, col, deep16, a_sums, bias, mini, maxi, out_zp, multiplier, left_shift,
+                            right_shift, stride, filter_peroc, filter_zp);
+    return;
+  }
+#endif
+#ifdef ENABLE_AVX
+  MatmulInt8OptAvx(a, b, dst, row, col, deep16, a_sums, bias, mini, maxi, out_zp, multiplier, left_shift, right_shift,
+                   stride, filter_peroc, filter_zp);
+  return;
+#endif
   for (int r = 0; r < row; r++) {
     for (int c = 0; c < col; c++) {
       int r4div = r / C4NUM, r4mod = r % C4NUM;
@@ -0,0 +1,84 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef ENABLE_AVX
+#include "nnacl/int8/common_func_int8.h"
+#include "nnacl/intrinsics/avx/common_utils.h"
+
+void ConvDwInt8Row(int32_t *output_ptr, const int8_t *input_ptr, const int16_t *weight_ptr, int num_pixels,
+                   int output_channel, int input_step, int8_t input_zp) {
+  const __m256i zp = _mm256_set1_epi32(input_zp);
+  for (int i = 0; i < num_pixels; i++) {
+    int c = 0;
+    for (; c <= output_channel - C8NUM; c += C8NUM) {
+      __m256i in = _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *)(input_ptr + c)));
+      __m256i weight = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(weight_ptr + c)));
+      __m256i out = _mm256_loadu_si256((const __m256i *)(output_ptr + c));
+      out = _mm256_add_epi32(out, _mm256_mullo_epi32(_mm256_sub_epi32(in, zp), weight));
+      _mm256_storeu_si256((__m256i *)(output_ptr + c), out);
+    }
+    for (; c < output_channel; c++) {
+      const int16_t input = input_ptr[c] - input_zp;
+      output_ptr[c] += input * weight_ptr[c];
+    }
+    output_ptr += output_channel;
+    input_ptr += input_step;
+  }
+}
+
+static inline void ConvDwInt8PostBlockAvx(int8_t *dst, const int32_t *buffer, __m256i mask, int num, __m256i output_zp,
+                                          __m256i out_multiplier, __m256i left_shift, __m256i right_shift,
+                                          __m256i acc_min, __m256i acc_max) {
+  __m256i value = _mm256_maskload_epi32(buffer, mask);
+  value = MultiplyByQuantizedMultiplierAvx(value, out_multiplier, left_shift, right_shift);
+  value = _mm256_add_epi32(value, output_zp);
+  value = _mm256_min_epi32(_mm256_max_epi32(value, acc_min), acc_max);
+  StoreInt32ToInt8Avx(dst, value, num);
+}
+
+void ConvDwInt8PostAlign4PerChannel(int8_t *dst, int32_t *buffer, int channel4, int32_t output_zp,
+                                    const int32_t *out_multiplier, const int32_t *left_shift,
+                                    const int32_t *right_shift, int32_t acc_min, int32_t acc_max) {
+  const __m256i zp_vec = _mm256_set1_epi32(output_zp);
+  const __m256i min_vec = _mm256_set1_epi32(acc_min);
+  const __m256i max_vec = _mm256_set1_epi32(acc_max);
+  const __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  for (int c = 0; c < channel4; c += C8NUM) {
+    int num = MSMIN(C8NUM, channel4 - c);
+    __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(num), index);
+    ConvDwInt8PostBlockAvx(dst + c, buffer + c, mask, num, zp_vec, _mm256_maskload_epi32(out_multiplier + c, mask),
+                           _mm256_maskload_epi32(left_shift + c, mask), _mm256_maskload_epi32(right_shift + c, mask),
+                           min_vec, max_vec);
+  }
+}
+
+void ConvDwInt8PostAlign4(int8_t *dst, int32_t *buffer, int num_pixels, int32_t output_zp, int32_t out_multiplier,
+                          int32_t left_shift, int32_t right_shift, int32_t acc_min, int32_t acc_max) {
+  const __m256i zp_vec = _mm256_set1_epi32(output_zp);
+  const __m256i multiplier_vec = _mm256_set1_epi32(out_multiplier);
+  const __m256i left_shift_vec = _mm256_set1_epi32(left_shift);
+  const __m256i right_shift_vec = _mm256_set1_epi32(right_shift);
+  const __m256i min_vec = _mm256_set1_epi32(acc_min);
+  const __m256i max_vec = _mm256_set1_epi32(acc_max);
+  const __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  for (int i = 0; i < num_pixels; i += C8NUM) {
+    int num = MSMIN(C8NUM, num_pixels - i);
+    __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(num), index);
+    ConvDwInt8PostBlockAvx(dst + i, buffer + i, mask, num, zp_vec, multiplier_vec, left_shift_vec, right_shift_vec,
+                           min_vec, max_vec);
+  }
+}
+#endif
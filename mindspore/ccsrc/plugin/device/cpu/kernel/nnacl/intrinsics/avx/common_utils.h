@@ -21,6 +21,7 @@
 #else
 #include <x86intrin.h>
 #endif
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -148,6 +149,47 @@ static inline void ActBlock12Avx(__m256 *v1, __m256 *v2, __m256 *v3, __m256 *v4,
   }
 }
 
+// The MultiplyByQuantizedMultiplier of 8 int32, bit exact with the scalar one. The rounding doubling high mul of
+// SaturatingRoundingDoublingHighMul equals (a * b + 2^30) >> 31 on the 64-bit product, and the right shift is the
+// negative exponent of RoundingDivideByPOT.
+static inline __m256i MultiplyByQuantizedMultiplierAvx(__m256i value, __m256i multiplier, __m256i left_shift,
+                                                       __m256i right_shift) {
+  const __m256i a = _mm256_sllv_epi32(value, left_shift);
+  const __m256i round = _mm256_set1_epi64x(1LL << 30);
+  __m256i even = _mm256_mul_epi32(a, multiplier);
+  __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(multiplier, 32));
+  even = _mm256_srli_epi64(_mm256_add_epi64(even, round), 31);
+  odd = _mm256_slli_epi64(_mm256_srli_epi64(_mm256_add_epi64(odd, round), 31), 32);
+  __m256i high = _mm256_blend_epi32(even, odd, 0xAA);
+  const __m256i int_min = _mm256_set1_epi32(INT32_MIN);
+  const __m256i overflow = _mm256_and_si256(_mm256_cmpeq_epi32(a, int_min), _mm256_cmpeq_epi32(multiplier, int_min));
+  high = _mm256_blendv_epi8(high, _mm256_set1_epi32(INT32_MAX), overflow);
+
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i exponent = _mm256_sub_epi32(_mm256_setzero_si256(), right_shift);
+  const __m256i mask = _mm256_sub_epi32(_mm256_sllv_epi32(one, exponent), one);
+  const __m256i remainder = _mm256_and_si256(high, mask);
+  const __m256i threshold = _mm256_add_epi32(_mm256_srai_epi32(mask, 1), _mm256_srli_epi32(high, 31));
+  // the compare is -1 where the remainder rounds up
+  return _mm256_sub_epi32(_mm256_srav_epi32(high, exponent), _mm256_cmpgt_epi32(remainder, threshold));
+}
+
+// Store the first num (at most 8) int32, which are in the range of int8, as int8.
+static inline void StoreInt32ToInt8Avx(int8_t *dst, __m256i value, int num) {
+  __m256i pack = _mm256_packs_epi32(value, value);
+  pack = _mm256_packs_epi16(pack, pack);
+  pack = _mm256_permutevar8x32_epi32(pack, _mm256_setr_epi32(0, 4, 0, 4, 0, 4, 0, 4));
+  if (num == 8) {
+    _mm_storel_epi64((__m128i *)dst, _mm256_castsi256_si128(pack));
+    return;
+  }
+  int8_t tmp[8];
+  _mm_storel_epi64((__m128i *)tmp, _mm256_castsi256_si128(pack));
+  for (int i = 0; i < num; ++i) {
+    dst[i] = tmp[i];
+  }
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -59,6 +59,9 @@ static const int FP16_EXPONENT_MAX = 30;
 static const int FP16_EXPONENT_MIN = -10;
 float ShortToFloat32(uint16_t src_value);
 uint16_t Float32ToShort(float src_value);
+// bfloat16 is the high half of float32, the conversion rounds to the nearest even.
+float BFloat16ToFloat32(uint16_t src_value);
+uint16_t Float32ToBFloat16(float src_value);
 
 #ifdef __cplusplus
 }
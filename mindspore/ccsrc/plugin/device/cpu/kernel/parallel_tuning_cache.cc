@@ -0,0 +1,161 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin/device/cpu/kernel/parallel_tuning_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr char kTuningCacheHeader[] = "# mindspore cpu kernel tuning cache v1";
+
+thread_local const std::string *current_kernel = nullptr;
+
+// Read the results of a cache file, keeping the fastest result of each key
+template <typename Map>
+bool ReadCacheFile(const std::string &path, Map *entries) {
+  std::ifstream ifs(path);
+  if (!ifs.is_open()) {
+    return false;
+  }
+  std::string line;
+  if (!std::getline(ifs, line) || line != kTuningCacheHeader) {
+    MS_LOG(WARNING) << "Ignore the cpu kernel tuning cache " << path << ", it is not a tuning cache of this version.";
+    return false;
+  }
+  while (std::getline(ifs, line)) {
+    auto first_tab = line.find('\t');
+    auto second_tab = line.find('\t', first_tab == std::string::npos ? first_tab : first_tab + 1);
+    if (first_tab == std::string::npos || second_tab == std::string::npos) {
+      continue;
+    }
+    typename Map::mapped_type entry{};
+    std::istringstream iss(line.substr(first_tab + 1));
+    if (!(iss >> entry.block_size >> entry.cost_time) || entry.block_size <= 0) {
+      continue;
+    }
+    auto key = line.substr(0, first_tab);
+    auto iter = entries->find(key);
+    if (iter == entries->end() || iter->second.cost_time > entry.cost_time) {
+      (*entries)[key] = entry;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+ParallelTuningCache &ParallelTuningCache::GetInstance() {
+  static ParallelTuningCache instance;
+  return instance;
+}
+
+ParallelTuningCache::ParallelTuningCache() {
+  auto path = common::GetEnv(kCpuKernelTuningCachePath);
+  if (!path.empty()) {
+    (void)Load(path);
+  }
+}
+
+bool ParallelTuningCache::Load(const std::string &path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  path_ = path;
+  entries_.clear();
+  dirty_ = false;
+  if (!ReadCacheFile(path, &entries_)) {
+    MS_LOG(INFO) << "No cpu kernel tuning cache is loaded from " << path << ", it will be created.";
+    return false;
+  }
+  MS_LOG(INFO) << "Load " << entries_.size() << " cpu kernel tuning results from " << path;
+  return true;
+}
+
+bool ParallelTuningCache::Find(const std::string &key, float *block_size) {
+  MS_EXCEPTION_IF_NULL(block_size);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = entries_.find(key);
+  if (iter == entries_.end()) {
+    return false;
+  }
+  *block_size = iter->second.block_size;
+  return true;
+}
+
+void ParallelTuningCache::Update(const std::string &key, float block_size, double cost_time) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = entries_.find(key);
+  if (iter != entries_.end() && iter->second.cost_time <= cost_time) {
+    return;
+  }
+  entries_[key] = Entry{block_size, cost_time};
+  dirty_ = true;
+}
+
+void ParallelTuningCache::Save() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (path_.empty() || !dirty_) {
+    return;
+  }
+  // Merge with the file first, it may have been saved by another process since it was loaded.
+  auto entries = entries_;
+  (void)ReadCacheFile(path_, &entries);
+  auto tmp_path = path_ + ".tmp";
+  {
+    std::ofstream ofs(tmp_path, std::ios::out | std::ios::trunc);
+    if (!ofs.is_open()) {
+      MS_LOG(WARNING) << "Failed to save the cpu kernel tuning cache to " << path_ << ", open " << tmp_path
+                      << " failed.";
+      return;
+    }
+    ofs.precision(std::numeric_limits<double>::max_digits10);
+    ofs << kTuningCacheHeader << '\n';
+    for (const auto &[key, entry] : entries) {
+      ofs << key << '\t' << entry.block_size << '\t' << entry.cost_time << '\n';
+    }
+    if (!ofs.good()) {
+      MS_LOG(WARNING) << "Failed to save the cpu kernel tuning cache to " << path_ << ", write " << tmp_path
+                      << " failed.";
+      return;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path_.c_str()) != 0) {
+    MS_LOG(WARNING) << "Failed to save the cpu kernel tuning cache to " << path_ << ", rename " << tmp_path
+                    << " failed.";
+    return;
+  }
+  entries_ = std::move(entries);
+  dirty_ = false;
+  MS_LOG(INFO) << "Save " << entries_.size() << " cpu kernel tuning results to " << path_;
+}
+
+size_t ParallelTuningCache::size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+const std::string *ParallelTuningCache::CurrentKernel() { return current_kernel; }
+
+void ParallelTuningCache::SetCurrentKernel(const std::string *kernel_key) { current_kernel = kernel_key; }
+
+std::string ParallelTuningCache::SearchKey(const std::string &kernel_key, size_t count, size_t thread_num) {
+  return kernel_key + "|" + std::to_string(count) + "|" + std::to_string(thread_num);
+}
+}  // namespace kernel
+}  // namespace mindspore
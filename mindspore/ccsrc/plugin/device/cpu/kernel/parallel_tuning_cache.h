@@ -0,0 +1,91 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_PARALLEL_TUNING_CACHE_H_
+#define MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_PARALLEL_TUNING_CACHE_H_
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "utils/ms_utils.h"
+#include "include/backend/visible.h"
+
+namespace mindspore {
+namespace kernel {
+// The environment variable giving the file the tuning cache is loaded from and saved to.
+constexpr char kCpuKernelTuningCachePath[] = "MS_CPU_KERNEL_TUNING_CACHE_PATH";
+
+// The block sizes found by the auto search of ParallelLaunchAutoSearch and CPUKernelUtils::ParallelForAutoSearch.
+// A result is keyed by the kernel (its type and data types), the number of items split among the threads, which is
+// what the shape of the kernel decides, and the number of threads. It is shared by all the kernels with the same key,
+// so that only the first one of them searches. If MS_CPU_KERNEL_TUNING_CACHE_PATH is set, the results are loaded from
+// this file when the cache is first used and saved to it by Save(), so that the next run does not search at all.
+class BACKEND_EXPORT ParallelTuningCache {
+ public:
+  static ParallelTuningCache &GetInstance();
+
+  // Find the block size of a key. Return false if it has not been tuned.
+  bool Find(const std::string &key, float *block_size);
+
+  // Record the block size found for a key, and its average cost time. The fastest result is kept.
+  void Update(const std::string &key, float block_size, double cost_time);
+
+  // Save the results to the cache file, if there is one and there are new results.
+  void Save();
+
+  // Load the results of a cache file, replacing the results in memory.
+  bool Load(const std::string &path);
+
+  size_t size();
+
+  // The kernel launched by the current thread, set by NativeCpuKernelMod::Launch. Null if it is not known.
+  static const std::string *CurrentKernel();
+  static void SetCurrentKernel(const std::string *kernel_key);
+
+  // The key of the search of a kernel
+  static std::string SearchKey(const std::string &kernel_key, size_t count, size_t thread_num);
+
+ private:
+  ParallelTuningCache();
+  ~ParallelTuningCache() = default;
+  DISABLE_COPY_AND_ASSIGN(ParallelTuningCache);
+
+  struct Entry {
+    float block_size;
+    double cost_time;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::string path_;
+  bool dirty_{false};
+};
+
+// Set the kernel launched by the current thread for its scope
+class ParallelTuningKernelGuard {
+ public:
+  explicit ParallelTuningKernelGuard(const std::string *kernel_key) : last_(ParallelTuningCache::CurrentKernel()) {
+    ParallelTuningCache::SetCurrentKernel(kernel_key);
+  }
+  ~ParallelTuningKernelGuard() { ParallelTuningCache::SetCurrentKernel(last_); }
+  DISABLE_COPY_AND_ASSIGN(ParallelTuningKernelGuard);
+
+ private:
+  const std::string *last_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_PARALLEL_TUNING_CACHE_H_
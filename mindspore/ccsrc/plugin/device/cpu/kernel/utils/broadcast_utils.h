@@ -0,0 +1,210 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_UTILS_BROADCAST_UTILS_H_
+#define MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_UTILS_BROADCAST_UTILS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "mindapi/base/shape_vector.h"
+
+namespace mindspore {
+namespace kernel {
+enum class BroadcastPattern {
+  kSameShape,        // both inputs have the output shape
+  kScalarA,          // the first input has one element
+  kScalarB,          // the second input has one element
+  kRowBroadcast,     // [M, N] with [1, N], in either order
+  kColumnBroadcast,  // [M, N] with [M, 1], in either order
+  kGeneral,
+};
+
+// The innermost loop of a broadcast, specialized on which inputs move along it. A broadcast input is read once, so
+// each variant is a plain unit stride loop the compiler can vectorize.
+template <bool kMoveA, bool kMoveB, typename TIn, typename TOut, typename Op>
+inline void BroadcastInnerLoop(const TIn *a, const TIn *b, TOut *out, size_t n, const Op &op) {
+  if constexpr (kMoveA && kMoveB) {
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = static_cast<TOut>(op(a[i], b[i]));
+    }
+  } else if constexpr (kMoveA) {
+    const TIn y = *b;
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = static_cast<TOut>(op(a[i], y));
+    }
+  } else if constexpr (kMoveB) {
+    const TIn x = *a;
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = static_cast<TOut>(op(x, b[i]));
+    }
+  } else {
+    std::fill(out, out + n, static_cast<TOut>(op(*a, *b)));
+  }
+}
+
+// Broadcast of a binary elementwise op. The shapes are classified once by Init(), which also collapses the adjacent
+// dims broadcast the same way, e.g. [2, 3, 4, 5] with [1, 1, 4, 5] is [6, 20] with [1, 20]. Run() then walks the output
+// along the innermost collapsed dim with the loop specialized for it, instead of computing the input positions of
+// every element like BroadcastIterator.
+class BroadcastPlan {
+ public:
+  BroadcastPlan() = default;
+  ~BroadcastPlan() = default;
+
+  // The input shapes can have a lower rank than the output shape, they are aligned to its last dims.
+  void Init(const ShapeVector &shape_a, const ShapeVector &shape_b, const ShapeVector &output_shape) {
+    dims_.clear();
+    strides_a_.clear();
+    strides_b_.clear();
+    std::vector<std::pair<bool, bool>> moves;
+    output_size_ = 1;
+    const size_t rank = output_shape.size();
+    for (size_t i = 0; i < rank; ++i) {
+      auto dim = output_shape[i];
+      output_size_ *= static_cast<size_t>(std::max<int64_t>(dim, 0));
+      if (dim == 1) {
+        continue;
+      }
+      std::pair<bool, bool> move{AlignedDim(shape_a, rank, i) == dim, AlignedDim(shape_b, rank, i) == dim};
+      if (!dims_.empty() && moves.back() == move) {
+        dims_.back() *= static_cast<size_t>(dim);
+      } else {
+        dims_.push_back(static_cast<size_t>(dim));
+        moves.push_back(move);
+      }
+    }
+    if (dims_.empty() || output_size_ == 0) {
+      pattern_ = BroadcastPattern::kSameShape;
+      dims_.assign(1, output_size_);
+      moves.assign(1, {true, true});
+    }
+    strides_a_.resize(dims_.size());
+    strides_b_.resize(dims_.size());
+    size_t stride_a = 1;
+    size_t stride_b = 1;
+    for (size_t i = dims_.size(); i > 0; --i) {
+      strides_a_[i - 1] = moves[i - 1].first ? stride_a : 0;
+      strides_b_[i - 1] = moves[i - 1].second ? stride_b : 0;
+      stride_a *= moves[i - 1].first ? dims_[i - 1] : 1;
+      stride_b *= moves[i - 1].second ? dims_[i - 1] : 1;
+    }
+    inner_ = dims_.back();
+    move_a_ = moves.back().first;
+    move_b_ = moves.back().second;
+    if (dims_.size() == 1) {
+      pattern_ = move_a_ && move_b_ ? BroadcastPattern::kSameShape
+                                    : (move_b_ ? BroadcastPattern::kScalarA : BroadcastPattern::kScalarB);
+    } else if (dims_.size() == 2 && move_a_ && move_b_) {
+      pattern_ = BroadcastPattern::kRowBroadcast;
+    } else if (dims_.size() == 2 && moves.front().first && moves.front().second) {
+      pattern_ = BroadcastPattern::kColumnBroadcast;
+    } else {
+      pattern_ = BroadcastPattern::kGeneral;
+    }
+  }
+
+  BroadcastPattern pattern() const { return pattern_; }
+  size_t output_size() const { return output_size_; }
+
+  // Compute the output elements [start, end). Op is called as op(a_value, b_value).
+  template <typename TIn, typename TOut, typename Op>
+  void Run(const TIn *a, const TIn *b, TOut *out, size_t start, size_t end, const Op &op) const {
+    if (start >= end) {
+      return;
+    }
+    switch (pattern_) {
+      case BroadcastPattern::kSameShape:
+        BroadcastInnerLoop<true, true>(a + start, b + start, out + start, end - start, op);
+        return;
+      case BroadcastPattern::kScalarA:
+        BroadcastInnerLoop<false, true>(a, b + start, out + start, end - start, op);
+        return;
+      case BroadcastPattern::kScalarB:
+        BroadcastInnerLoop<true, false>(a + start, b, out + start, end - start, op);
+        return;
+      default:
+        break;
+    }
+    if (move_a_ && move_b_) {
+      RunRows<true, true>(a, b, out, start, end, op);
+    } else if (move_a_) {
+      RunRows<true, false>(a, b, out, start, end, op);
+    } else if (move_b_) {
+      RunRows<false, true>(a, b, out, start, end, op);
+    } else {
+      RunRows<false, false>(a, b, out, start, end, op);
+    }
+  }
+
+ private:
+  static int64_t AlignedDim(const ShapeVector &shape, size_t rank, size_t i) {
+    size_t offset = rank - shape.size();
+    return i < offset ? 1 : shape[i - offset];
+  }
+
+  // Walk the output one row of the innermost collapsed dim at a time. The row offsets of the inputs are updated
+  // with an odometer over the outer dims, which only costs a division when the range starts in the middle of them.
+  template <bool kMoveA, bool kMoveB, typename TIn, typename TOut, typename Op>
+  void RunRows(const TIn *a, const TIn *b, TOut *out, size_t start, size_t end, const Op &op) const {
+    const size_t outer_rank = dims_.size() - 1;
+    std::vector<size_t> coordinates(outer_rank, 0);
+    size_t row = start / inner_;
+    size_t col = start % inner_;
+    size_t offset_a = 0;
+    size_t offset_b = 0;
+    for (size_t i = outer_rank; i > 0 && row != 0; --i) {
+      coordinates[i - 1] = row % dims_[i - 1];
+      offset_a += coordinates[i - 1] * strides_a_[i - 1];
+      offset_b += coordinates[i - 1] * strides_b_[i - 1];
+      row /= dims_[i - 1];
+    }
+    size_t pos = start;
+    while (pos < end) {
+      size_t n = std::min(inner_ - col, end - pos);
+      BroadcastInnerLoop<kMoveA, kMoveB>(a + offset_a + (kMoveA ? col : 0), b + offset_b + (kMoveB ? col : 0),
+                                         out + pos, n, op);
+      pos += n;
+      col = 0;
+      for (size_t i = outer_rank; i > 0; --i) {
+        if (++coordinates[i - 1] < dims_[i - 1]) {
+          offset_a += strides_a_[i - 1];
+          offset_b += strides_b_[i - 1];
+          break;
+        }
+        coordinates[i - 1] = 0;
+        offset_a -= (dims_[i - 1] - 1) * strides_a_[i - 1];
+        offset_b -= (dims_[i - 1] - 1) * strides_b_[i - 1];
+      }
+    }
+  }
+
+  BroadcastPattern pattern_{BroadcastPattern::kSameShape};
+  size_t output_size_{0};
+  // The collapsed output shape, and the strides of the inputs along it, 0 where they are broadcast
+  std::vector<size_t> dims_;
+  std::vector<size_t> strides_a_;
+  std::vector<size_t> strides_b_;
+  size_t inner_{1};
+  bool move_a_{true};
+  bool move_b_{true};
+};
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_UTILS_BROADCAST_UTILS_H_
@@ -34,6 +34,7 @@ void AbstractActor::RunOpData(OpData<DeviceTensor> *const input_data, OpContext<
   auto is_run = CheckRunningCondition(context);
   MS_LOG(DEBUG) << "Actor(" << GetAID().Name() << ") receive the input op data and check running condition:" << is_run
                 << ", sequential num:" << sequential_num;
+  TraceInputArrival(is_run);
   if (is_run) {
     Run(context);
   }
@@ -48,6 +49,7 @@ void AbstractActor::RunOpControl(AID *const input_control, OpContext<DeviceTenso
   MS_LOG(DEBUG) << "Actor(" << GetAID().Name()
                 << ") receive the input op control and check running condition:" << is_run
                 << ", sequential num:" << sequential_num;
+  TraceInputArrival(is_run);
   if (is_run) {
     Run(context);
   }
@@ -64,6 +66,21 @@ void AbstractActor::RunBatchOpData(std::vector<OpData<DeviceTensor> *> *const ba
   }
 }
 
+void AbstractActor::TraceInputArrival(bool is_run) {
+  if (!ActorTrace::enabled()) {
+    first_input_time_ = 0;
+    return;
+  }
+  auto now = ActorTrace::Now();
+  if (first_input_time_ == 0) {
+    first_input_time_ = now;
+  }
+  if (is_run) {
+    ActorTrace::Record(kTraceInputWait, GetAID().Name(), first_input_time_, now);
+    first_input_time_ = 0;
+  }
+}
+
 bool AbstractActor::CheckRunningCondition(const OpContext<DeviceTensor> *context) const {
   MS_EXCEPTION_IF_NULL(context);
   if (input_datas_num_ != 0) {
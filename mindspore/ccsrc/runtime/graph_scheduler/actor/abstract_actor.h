@@ -123,6 +123,9 @@ class AbstractActor : public OpActor<DeviceTensor> {
   // Fetch the sub actor in the fusion actor by the name.
   AbstractActor *FetchSubActorInFusionActor(const std::string &sub_actor_name) const;
 
+  // Trace the time from the first input of the step arrives to all the inputs arrive.
+  void TraceInputArrival(bool is_run);
+
   KernelTransformType type_;
 
   // The device interface.
@@ -168,6 +171,9 @@ class AbstractActor : public OpActor<DeviceTensor> {
   // The dependent messages number of actor running.
   int running_dependent_msg_num_;
 
+  // The time the first input of the step arrives, only recorded when the actor trace is enabled.
+  uint64_t first_input_time_{0};
+
   // Indicates whether the actor is in fusion actor.
   AbstractActor *parent_fusion_actor_;
 
@@ -16,6 +16,7 @@
 
 #include "runtime/graph_scheduler/actor/actor_common.h"
 #include <memory>
+#include <utility>
 #include "runtime/graph_scheduler/device_tensor_store.h"
 #include "utils/ms_context.h"
 #include "include/common/utils/anfalgo.h"
@@ -27,6 +28,22 @@ bool ActorDispatcher::is_multi_thread_execution_ = true;
 bool ActorDispatcher::is_memory_allocation_sync_ = true;
 bool ActorDispatcher::is_memory_free_sync_ = true;
 
+void ActorDispatcher::SendTraced(const AID &aid, std::function<void(ActorBase *)> &&handler) {
+  auto send_time = ActorTrace::Now();
+  std::function<void(ActorBase *)> traced_handler = [handler = std::move(handler), send_time](ActorBase *actor) {
+    MS_EXCEPTION_IF_NULL(actor);
+    const auto &actor_name = actor->GetAID().Name();
+    auto start_time = ActorTrace::Now();
+    ActorTrace::Record(kTraceMailboxWait, actor_name, send_time, start_time);
+    handler(actor);
+    ActorTrace::Record(kTraceActorRun, actor_name, start_time, ActorTrace::Now());
+  };
+  auto msg = std::make_unique<MessageAsync>(std::move(traced_handler));
+  auto actor_manager = ActorMgr::GetActorMgrRef();
+  MS_EXCEPTION_IF_NULL(actor_manager);
+  (void)actor_manager->Send(aid, std::move(msg));
+}
+
 constexpr char kLaunchSkippedEnv[] = "MS_KERNEL_LAUNCH_SKIP";
 
 bool IsRunningFailed(const OpContext<DeviceTensor> *context) {
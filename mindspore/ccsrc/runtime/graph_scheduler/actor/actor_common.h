@@ -27,6 +27,7 @@
 #include <memory>
 #include "utils/hash_map.h"
 #include "mindrt/include/actor/op_actor.h"
+#include "mindrt/include/async/async.h"
 #include "runtime/device/device_address.h"
 #include "backend/common/session/anf_runtime_algorithm.h"
 #include "include/common/utils/anfalgo.h"
@@ -36,6 +37,7 @@
 #include "runtime/device/ms_device_shape_transfer.h"
 #include "runtime/hardware/device_context_manager.h"
 #include "common/mem_reuse/mem_dynamic_allocator.h"
+#include "runtime/graph_scheduler/actor/actor_trace.h"
 
 namespace mindspore {
 namespace runtime {
@@ -160,6 +162,10 @@ class ActorDispatcher {
   template <typename T, typename Arg0, typename Arg1>
   static void Send(const AID &aid, void (T::*method)(Arg0), Arg1 &&arg) {
     if (is_multi_thread_execution_) {
+      if (ActorTrace::enabled()) {
+        SendTraced(aid, [method, arg](ActorBase *actor) { (static_cast<T *>(actor)->*method)(arg); });
+        return;
+      }
       Async(aid, method, arg);
     } else {
       // The single thread execution doesn't need to switch threads and calls function directly.
@@ -176,6 +182,10 @@ class ActorDispatcher {
   static void Send(const AID &aid, void (T::*method)(Args0...), Args1 &&... args) {
     if (is_multi_thread_execution_) {
       auto tuple = std::make_tuple(std::forward<Args1>(args)...);
+      if (ActorTrace::enabled()) {
+        SendTraced(aid, [method, tuple](ActorBase *actor) { Apply(static_cast<T *>(actor), method, tuple); });
+        return;
+      }
       Async(aid, method, std::move(tuple));
     } else {
       // The single thread execution doesn't need to switch threads and calls function directly.
@@ -241,6 +251,9 @@ class ActorDispatcher {
   ~ActorDispatcher() = default;
   DISABLE_COPY_AND_ASSIGN(ActorDispatcher);
 
+  // Send the message with a handler which records the time it waits in the mailbox and the time it runs.
+  static void SendTraced(const AID &aid, std::function<void(ActorBase *)> &&handler);
+
   // Decide whether use the multi thread to execute actors.
   // There are scenarios with small network and data, and the performance of multi thread execution is not as good as
   // that of single thread, so single thread execution is required at this time.
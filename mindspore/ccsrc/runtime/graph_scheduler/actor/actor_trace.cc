@@ -0,0 +1,226 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/graph_scheduler/actor/actor_trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+// The number of the events kept by each thread.
+constexpr size_t kTraceBufferSize = 16384;
+constexpr size_t kMaxTraceNameLength = 64;
+constexpr double kNanosecondsToMicroseconds = 1000.0;
+// The chrome trace processes of the events, the mailbox wait events overlap the actor run events of the same thread.
+constexpr int kActorThreadProcess = 1;
+constexpr int kMailboxWaitProcess = 2;
+
+struct TraceEvent {
+  uint64_t start_time;
+  uint64_t end_time;
+  const char *category;
+  char name[kMaxTraceNameLength];
+};
+
+// The ring buffer of a thread, only written by the thread.
+class TraceBuffer {
+ public:
+  explicit TraceBuffer(size_t thread_index) : thread_index_(thread_index), events_(kTraceBufferSize) {}
+  ~TraceBuffer() = default;
+
+  void Record(const char *category, const std::string &name, uint64_t start_time, uint64_t end_time) {
+    auto count = count_.load(std::memory_order_relaxed);
+    auto &event = events_[count % kTraceBufferSize];
+    event.start_time = start_time;
+    event.end_time = end_time;
+    event.category = category;
+    auto name_length = std::min(name.size(), kMaxTraceNameLength - 1);
+    (void)memcpy(event.name, name.data(), name_length);
+    event.name[name_length] = '\0';
+    count_.store(count + 1, std::memory_order_release);
+  }
+
+  void Clear() { count_.store(0, std::memory_order_release); }
+
+  // Copy the events in the buffer, the oldest first.
+  void Collect(std::vector<TraceEvent> *events) const {
+    auto count = count_.load(std::memory_order_acquire);
+    auto begin = count > kTraceBufferSize ? count - kTraceBufferSize : 0;
+    for (auto i = begin; i < count; ++i) {
+      events->push_back(events_[i % kTraceBufferSize]);
+    }
+  }
+
+  size_t thread_index() const { return thread_index_; }
+
+ private:
+  size_t thread_index_;
+  std::vector<TraceEvent> events_;
+  std::atomic<size_t> count_{0};
+};
+
+// The buffers of all the threads, the mutex is only taken when a thread records its first event and by the export.
+std::mutex buffers_mutex;
+std::vector<std::unique_ptr<TraceBuffer>> &Buffers() {
+  static std::vector<std::unique_ptr<TraceBuffer>> buffers;
+  return buffers;
+}
+
+thread_local TraceBuffer *thread_buffer = nullptr;
+
+TraceBuffer *GetThreadBuffer() {
+  if (thread_buffer == nullptr) {
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    auto &buffers = Buffers();
+    (void)buffers.emplace_back(std::make_unique<TraceBuffer>(buffers.size()));
+    thread_buffer = buffers.back().get();
+  }
+  return thread_buffer;
+}
+
+void WriteJsonString(std::ofstream *ofs, const char *str) {
+  (*ofs) << '"';
+  for (auto c = str; *c != '\0'; ++c) {
+    if (*c == '"' || *c == '\\') {
+      (*ofs) << '\\' << *c;
+    } else if (static_cast<unsigned char>(*c) < ' ') {
+      (*ofs) << ' ';
+    } else {
+      (*ofs) << *c;
+    }
+  }
+  (*ofs) << '"';
+}
+
+std::string &EnvTracePath() {
+  static std::string path = common::GetEnv(kActorTracePath);
+  return path;
+}
+}  // namespace
+
+void ActorTrace::Enable() {
+  {
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    for (auto &buffer : Buffers()) {
+      buffer->Clear();
+    }
+  }
+  enabled_.store(true, std::memory_order_release);
+  MS_LOG(INFO) << "The actor trace is enabled.";
+}
+
+void ActorTrace::Disable() {
+  enabled_.store(false, std::memory_order_release);
+  MS_LOG(INFO) << "The actor trace is disabled.";
+}
+
+uint64_t ActorTrace::Now() {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void ActorTrace::Record(const char *category, const std::string &name, uint64_t start_time, uint64_t end_time) {
+  if (!enabled()) {
+    return;
+  }
+  GetThreadBuffer()->Record(category, name, start_time, end_time);
+}
+
+bool ActorTrace::Export(const std::string &path) {
+  std::vector<std::pair<size_t, std::vector<TraceEvent>>> thread_events;
+  {
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    for (auto &buffer : Buffers()) {
+      std::vector<TraceEvent> events;
+      buffer->Collect(&events);
+      if (!events.empty()) {
+        (void)thread_events.emplace_back(buffer->thread_index(), std::move(events));
+      }
+    }
+  }
+
+  std::ofstream ofs(path, std::ios::out | std::ios::trunc);
+  if (!ofs.is_open()) {
+    MS_LOG(WARNING) << "Failed to export the actor trace, open " << path << " failed.";
+    return false;
+  }
+  // The timestamps start from the first event.
+  auto base_time = std::numeric_limits<uint64_t>::max();
+  size_t event_num = 0;
+  for (const auto &[thread_index, events] : thread_events) {
+    for (const auto &event : events) {
+      base_time = std::min(base_time, event.start_time);
+    }
+    event_num += events.size();
+  }
+
+  ofs << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+  ofs << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << kActorThreadProcess
+      << ",\"args\":{\"name\":\"Actor threads\"}},\n";
+  ofs << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << kMailboxWaitProcess
+      << ",\"args\":{\"name\":\"Mailbox wait\"}}";
+  ofs.precision(std::numeric_limits<double>::digits10);
+  for (const auto &[thread_index, events] : thread_events) {
+    for (auto pid : {kActorThreadProcess, kMailboxWaitProcess}) {
+      ofs << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << thread_index
+          << ",\"args\":{\"name\":\"Thread " << thread_index << "\"}}";
+    }
+    for (const auto &event : events) {
+      auto pid = (strcmp(event.category, kTraceMailboxWait) == 0) ? kMailboxWaitProcess : kActorThreadProcess;
+      auto end_time = std::max(event.start_time, event.end_time);
+      ofs << ",\n{\"name\":";
+      WriteJsonString(&ofs, event.name);
+      ofs << ",\"cat\":";
+      WriteJsonString(&ofs, event.category);
+      ofs << ",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << thread_index
+          << ",\"ts\":" << (event.start_time - base_time) / kNanosecondsToMicroseconds
+          << ",\"dur\":" << (end_time - event.start_time) / kNanosecondsToMicroseconds << "}";
+    }
+  }
+  ofs << "\n]}\n";
+  if (!ofs.good()) {
+    MS_LOG(WARNING) << "Failed to export the actor trace, write " << path << " failed.";
+    return false;
+  }
+  MS_LOG(INFO) << "Export " << event_num << " actor trace events of " << thread_events.size() << " threads to "
+               << path;
+  return true;
+}
+
+void ActorTrace::InitializeFromEnv() {
+  if (!EnvTracePath().empty() && !enabled()) {
+    Enable();
+  }
+}
+
+void ActorTrace::ExportToEnvPath() {
+  if (!EnvTracePath().empty()) {
+    (void)Export(EnvTracePath());
+  }
+}
+}  // namespace runtime
+}  // namespace mindspore
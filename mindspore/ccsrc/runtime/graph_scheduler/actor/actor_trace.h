@@ -0,0 +1,95 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_ACTOR_TRACE_H_
+#define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_ACTOR_TRACE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "include/backend/visible.h"
+
+namespace mindspore {
+namespace runtime {
+// The environment variable giving the file the actor trace is exported to, which enables the trace.
+constexpr char kActorTracePath[] = "MS_DEV_ACTOR_TRACE_PATH";
+
+// The categories of the trace events.
+constexpr char kTraceStep[] = "Step";
+// From a message is sent to an actor to the actor starts to handle it.
+constexpr char kTraceMailboxWait[] = "MailboxWait";
+// An actor handles a message.
+constexpr char kTraceActorRun[] = "ActorRun";
+// From the first input of a step arrives at an actor to all the inputs arrive.
+constexpr char kTraceInputWait[] = "InputWait";
+// From a kernel actor sends the memory allocation request to the memory manager actor to it gets the result.
+constexpr char kTraceMemoryAlloc[] = "MemoryAlloc";
+// From all the inputs of a kernel actor arrive to its kernel launches.
+constexpr char kTraceInputToLaunch[] = "InputToLaunch";
+constexpr char kTraceLaunch[] = "Launch";
+
+// The tracing of the actor runtime events, to find the bubbles of the scheduling. Each thread records its events into
+// its own ring buffer without any lock, the oldest events are overwritten when it is full. The trace is toggled at
+// runtime by Enable and Disable, and exported as the Chrome trace json, which chrome://tracing or Perfetto opens.
+class BACKEND_EXPORT ActorTrace {
+ public:
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  // Start a new trace, the events recorded before are dropped.
+  static void Enable();
+  static void Disable();
+
+  // The time of the events in nanoseconds.
+  static uint64_t Now();
+
+  // Record an event of the current thread, the category must be a string literal. The name is truncated if it is too
+  // long. It does nothing if the trace is disabled.
+  static void Record(const char *category, const std::string &name, uint64_t start_time, uint64_t end_time);
+
+  // Export the events recorded by all the threads, it should be called when the actors are not running.
+  static bool Export(const std::string &path);
+
+  // Enable the trace if MS_DEV_ACTOR_TRACE_PATH is set, and export the trace to it when the process exits.
+  static void InitializeFromEnv();
+  static void ExportToEnvPath();
+
+ private:
+  inline static std::atomic<bool> enabled_{false};
+};
+
+// Record an event from its construction to its destruction. The name is referenced, it must outlive the scope.
+class ActorTraceScope {
+ public:
+  ActorTraceScope(const char *category, const std::string &name)
+      : category_(category), name_(name), start_time_(ActorTrace::enabled() ? ActorTrace::Now() : 0) {}
+  ActorTraceScope(const char *category, std::string &&name) = delete;
+  ~ActorTraceScope() {
+    if (start_time_ != 0) {
+      ActorTrace::Record(category_, name_, start_time_, ActorTrace::Now());
+    }
+  }
+  ActorTraceScope(const ActorTraceScope &) = delete;
+  ActorTraceScope &operator=(const ActorTraceScope &) = delete;
+
+ private:
+  const char *category_;
+  const std::string &name_;
+  uint64_t start_time_;
+};
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_ACTOR_TRACE_H_
@@ -21,6 +21,7 @@
 
 namespace mindspore {
 namespace runtime {
+using distributed::HashMapSwapInfo;
 using distributed::INVALID_INDEX_VALUE;
 using kernel::Address;
 using kernel::AddressPtrList;
@@ -54,27 +55,33 @@ bool DeviceDenseEmbeddingOperation::CountCacheMissIds(int *batch_ids, const size
   RETURN_IF_FALSE_WITH_LOG(actor_->ResetEmbeddingHashMap(), "Reset embedding hash map failed.");
 
   // 2.calculate the swapping and mapping(feature id to cache index) information of the missing feature id that needs to
-  // be inserted into the cache.
+  // be inserted into the cache. The device cache is parsed for all missing ids in batch, then the local host cache is
+  // parsed for the ids swapped in and out of the device cache.
+  std::vector<int> miss_ids;
+  std::vector<size_t> miss_positions;
   for (size_t i = 0; i < batch_ids_num; i++) {
     if (in_device[i] || out_range[i]) {
       continue;
     }
-    bool need_swap_host_to_device = true;
-    bool need_swap_device_to_host = true;
-    int index = INVALID_INDEX_VALUE;
-    RETURN_IF_FALSE_WITH_LOG(ParseDeviceData(batch_ids[i], &need_swap_device_to_host, &need_swap_host_to_device, &index,
-                                             data_step, graph_running_step, device_cache_need_wait_graph),
-                             "Parse device cache data failed.");
-    hash_index[i] = index + local_device_cache_bounds_.first;
-    if (need_swap_host_to_device) {
-      RETURN_IF_FALSE_WITH_LOG(
-        ParseHostDataHostToDevice(batch_ids[i], data_step, graph_running_step, host_cache_need_wait_graph),
-        "Parse local host cache data(swap local host cache to device) failed.");
-    }
-    if (need_swap_device_to_host) {
-      RETURN_IF_FALSE_WITH_LOG(ParseHostDataDeviceToHost(data_step, graph_running_step, host_cache_need_wait_graph),
-                               "Parse local host cache data(swap device cache to local host) failed.");
-    }
+    miss_ids.push_back(batch_ids[i]);
+    miss_positions.push_back(i);
+  }
+  auto host_to_device_begin = statistics_info_->host_to_device_size_;
+  auto device_to_host_begin = statistics_info_->device_to_host_size_;
+  RETURN_IF_FALSE_WITH_LOG(ParseDeviceData(miss_ids, miss_positions, hash_index.get(), data_step, graph_running_step,
+                                           device_cache_need_wait_graph),
+                           "Parse device cache data failed.");
+  MS_ERROR_IF_NULL(embedding_device_cache_);
+  int *host_to_device_ids = embedding_device_cache_->host_to_device_ids.get();
+  MS_ERROR_IF_NULL(host_to_device_ids);
+  for (size_t i = host_to_device_begin; i < statistics_info_->host_to_device_size_; i++) {
+    RETURN_IF_FALSE_WITH_LOG(
+      ParseHostDataHostToDevice(host_to_device_ids[i], i, data_step, graph_running_step, host_cache_need_wait_graph),
+      "Parse local host cache data(swap local host cache to device) failed.");
+  }
+  for (size_t i = device_to_host_begin; i < statistics_info_->device_to_host_size_; i++) {
+    RETURN_IF_FALSE_WITH_LOG(ParseHostDataDeviceToHost(i, data_step, graph_running_step, host_cache_need_wait_graph),
+                             "Parse local host cache data(swap device cache to local host) failed.");
   }
 
   // 3. Replace the batch_ids by hash index for GetNext operator to get hash index as input.
@@ -246,7 +253,9 @@ bool DeviceDenseEmbeddingOperation::CheckCacheHitOrOutRangeFunc(const int *batch
   MS_ERROR_IF_NULL(embedding_device_cache_);
   auto &device_hash_map = embedding_device_cache_->device_hash_map_;
   MS_ERROR_IF_NULL(device_hash_map);
-  const auto &hash_id_to_index = device_hash_map->hash_id_to_index();
+  // Look up the whole batch at once, the ids out of range are not in the hash map and are handled below.
+  std::vector<int> device_index(batch_ids_num);
+  device_hash_map->hash_id_to_index().FindBatch(batch_ids, batch_ids_num, device_index.data());
 
   for (size_t i = 0; i < batch_ids_num; ++i) {
     if (batch_ids[i] < local_embedding_slice_bounds_.first) {
@@ -259,12 +268,12 @@ bool DeviceDenseEmbeddingOperation::CheckCacheHitOrOutRangeFunc(const int *batch
       out_range[i] = true;
       continue;
     }
-    auto iter = hash_id_to_index.find(batch_ids[i]);
-    if (iter != hash_id_to_index.end()) {
-      hash_index[i] = iter->second + local_device_cache_bounds_.first;
-      if (device_hash_map->hash_step(iter->second) != data_step) {
+    auto index = device_index[i];
+    if (index != INVALID_INDEX_VALUE) {
+      hash_index[i] = index + local_device_cache_bounds_.first;
+      if (device_hash_map->hash_step(index) != data_step) {
         ++(*hash_hit_count);
-        device_hash_map->set_hash_step(iter->second, data_step);
+        device_hash_map->set_hash_step(index, data_step);
       }
       in_device[i] = true;
     }
@@ -272,54 +281,41 @@ bool DeviceDenseEmbeddingOperation::CheckCacheHitOrOutRangeFunc(const int *batch
   return true;
 }
 
-bool DeviceDenseEmbeddingOperation::ParseDeviceData(int id, bool *need_swap_device_to_host,
-                                                    bool *need_swap_host_to_device, int *hash_index, size_t data_step,
-                                                    size_t graph_running_step, bool *device_cache_need_wait_graph) {
-  MS_ERROR_IF_NULL(need_swap_device_to_host);
-  MS_ERROR_IF_NULL(need_swap_host_to_device);
+bool DeviceDenseEmbeddingOperation::ParseDeviceData(const std::vector<int> &miss_ids,
+                                                    const std::vector<size_t> &miss_positions, int *hash_index,
+                                                    size_t data_step, size_t graph_running_step,
+                                                    bool *device_cache_need_wait_graph) {
   MS_ERROR_IF_NULL(hash_index);
   MS_ERROR_IF_NULL(embedding_device_cache_);
   auto &device_hash_map = embedding_device_cache_->device_hash_map_;
   MS_ERROR_IF_NULL(device_hash_map);
 
-  int index = INVALID_INDEX_VALUE;
-  const auto &hash_id_to_index = device_hash_map->hash_id_to_index();
-  const auto &iter = hash_id_to_index.find(id);
-  if (iter != hash_id_to_index.end()) {
-    *need_swap_device_to_host = false;
-    *need_swap_host_to_device = false;
-    index = iter->second;
-    if (device_hash_map->hash_step(index) != data_step) {
-      statistics_info_->hash_hit_count_++;
-      device_hash_map->set_hash_step(index, data_step);
-    }
-  } else {
-    int *device_to_host_index = embedding_device_cache_->device_to_host_index.get();
-    int *device_to_host_ids = embedding_device_cache_->device_to_host_ids.get();
-    int *host_to_device_index = embedding_device_cache_->host_to_device_index.get();
-    int *host_to_device_ids = embedding_device_cache_->host_to_device_ids.get();
-    MS_ERROR_IF_NULL(host_to_device_index);
-    MS_ERROR_IF_NULL(host_to_device_ids);
-    auto tmp_device_to_host_size = statistics_info_->device_to_host_size_;
-    while (true) {
-      // Calculate the mapping of id to index.
-      index = device_hash_map->ParseData(id, device_to_host_index, device_to_host_ids, data_step, graph_running_step,
-                                         &statistics_info_->device_to_host_size_, device_cache_need_wait_graph);
-      if (index == INVALID_INDEX_VALUE) {
-        if (!actor_->WaitGraphRun()) {
-          return false;
-        }
-        continue;
-      }
-      host_to_device_index[statistics_info_->host_to_device_size_] = index;
-      host_to_device_ids[statistics_info_->host_to_device_size_] = id;
-      statistics_info_->host_to_device_size_++;
-      *need_swap_device_to_host = statistics_info_->device_to_host_size_ > tmp_device_to_host_size;
-      break;
+  HashMapSwapInfo<int> swap_info;
+  swap_info.swap_in_index = embedding_device_cache_->host_to_device_index.get();
+  swap_info.swap_in_ids = embedding_device_cache_->host_to_device_ids.get();
+  swap_info.swap_in_size = &statistics_info_->host_to_device_size_;
+  swap_info.swap_out_index = embedding_device_cache_->device_to_host_index.get();
+  swap_info.swap_out_ids = embedding_device_cache_->device_to_host_ids.get();
+  swap_info.swap_out_size = &statistics_info_->device_to_host_size_;
+  MS_ERROR_IF_NULL(swap_info.swap_in_index);
+  MS_ERROR_IF_NULL(swap_info.swap_in_ids);
+
+  // Calculate the mapping of id to index, the ids which can not be inserted until the graph finishes the running step
+  // are parsed again after waiting.
+  size_t miss_num = miss_ids.size();
+  std::vector<int> miss_index(miss_num);
+  size_t parsed_num = 0;
+  while (parsed_num < miss_num) {
+    parsed_num += device_hash_map->ParseBatch(miss_ids.data() + parsed_num, miss_num - parsed_num, data_step,
+                                              graph_running_step, miss_index.data() + parsed_num, swap_info,
+                                              device_cache_need_wait_graph);
+    if (parsed_num < miss_num && !actor_->WaitGraphRun()) {
+      return false;
     }
   }
-
-  *hash_index = index;
+  for (size_t i = 0; i < miss_num; i++) {
+    hash_index[miss_positions[i]] = miss_index[i] + local_device_cache_bounds_.first;
+  }
   return true;
 }
 }  // namespace runtime
@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 #include "runtime/graph_scheduler/actor/embedding_cache/device_embedding_operation.h"
 
 namespace mindspore {
@@ -56,8 +57,9 @@ class DeviceDenseEmbeddingOperation : public DeviceEmbeddingOperation {
   bool CheckCacheHitOrOutRangeFunc(const int *batch_ids, const size_t batch_ids_len, int *hash_index, bool *in_device,
                                    bool *out_range, size_t *hash_hit_count, size_t data_step);
 
-  // Parse the hit and swap information of the currently preprocessed id in the device cache.
-  bool ParseDeviceData(int id, bool *need_swap_device_to_host, bool *need_swap_host_to_device, int *hash_index,
+  // Parse the swap information of the ids missing in the device cache in batch, and record their cache indices at the
+  // positions of the batch.
+  bool ParseDeviceData(const std::vector<int> &miss_ids, const std::vector<size_t> &miss_positions, int *hash_index,
                        size_t data_step, size_t graph_running_step, bool *device_cache_need_wait_graph);
 
   DISABLE_COPY_AND_ASSIGN(DeviceDenseEmbeddingOperation);
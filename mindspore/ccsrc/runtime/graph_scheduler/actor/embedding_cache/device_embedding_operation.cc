@@ -167,34 +167,32 @@ bool DeviceEmbeddingOperation::UpdateDeviceCache(void *indices, void *update_val
   return true;
 }
 
-bool DeviceEmbeddingOperation::ParseHostDataHostToDevice(int id, size_t data_step, size_t graph_running_step,
-                                                         bool *host_cache_need_wait_graph) {
+bool DeviceEmbeddingOperation::ParseHostDataHostToDevice(int id, size_t swap_pos, size_t data_step,
+                                                         size_t graph_running_step, bool *host_cache_need_wait_graph) {
   MS_ERROR_IF_NULL(embedding_host_cache_);
   int *host_to_device_index = embedding_host_cache_->host_to_device_index.get();
   MS_ERROR_IF_NULL(host_to_device_index);
   auto &host_hash_map = embedding_host_cache_->host_hash_map_;
   MS_ERROR_IF_NULL(host_hash_map);
 
-  const auto &hash_id_to_index = host_hash_map->hash_id_to_index();
-  const auto &iter = hash_id_to_index.find(id);
-  if (iter != hash_id_to_index.end()) {
-    auto index = iter->second;
+  auto index = host_hash_map->hash_id_to_index().Find(id);
+  if (index != INVALID_INDEX_VALUE) {
     if (host_hash_map->hash_step(index) != data_step) {
       host_hash_map->set_hash_step(index, data_step);
     }
-    host_to_device_index[statistics_info_->host_to_device_size_ - 1] = index;
+    host_to_device_index[swap_pos] = index;
   } else {
     int *host_to_server_index = embedding_host_cache_->host_to_server_index.get();
     int *host_to_server_ids = embedding_host_cache_->host_to_server_ids.get();
     while (true) {
       // Calculate the mapping of id to index.
-      auto index = host_hash_map->ParseData(id, host_to_server_index, host_to_server_ids, data_step, graph_running_step,
+      index = host_hash_map->ParseData(id, host_to_server_index, host_to_server_ids, data_step, graph_running_step,
                                             &(statistics_info_->host_to_server_size_), host_cache_need_wait_graph);
       if (index == INVALID_INDEX_VALUE) {
         RETURN_IF_FALSE_WITH_LOG(actor_->WaitGraphRun(), "Wait graph run failed.");
         continue;
       }
-      host_to_device_index[statistics_info_->host_to_device_size_ - 1] = index;
+      host_to_device_index[swap_pos] = index;
 
       // This feature id has never been seen before, so it's value is initialized using the local random generator.
       if (initialized_ids_.find(id) == initialized_ids_.end()) {
@@ -218,8 +216,8 @@ bool DeviceEmbeddingOperation::ParseHostDataHostToDevice(int id, size_t data_ste
   return true;
 }
 
-bool DeviceEmbeddingOperation::ParseHostDataDeviceToHost(size_t data_step, size_t graph_running_step,
-                                                         bool *host_cache_need_wait_graph) {
+bool DeviceEmbeddingOperation::ParseHostDataDeviceToHost(size_t swap_pos, size_t data_step,
+                                                         size_t graph_running_step, bool *host_cache_need_wait_graph) {
   MS_ERROR_IF_NULL(embedding_device_cache_);
   MS_ERROR_IF_NULL(embedding_host_cache_);
   int *device_to_host_ids = embedding_device_cache_->device_to_host_ids.get();
@@ -229,28 +227,26 @@ bool DeviceEmbeddingOperation::ParseHostDataDeviceToHost(size_t data_step, size_
 
   auto &host_hash_map = embedding_host_cache_->host_hash_map_;
   MS_ERROR_IF_NULL(host_hash_map);
-  int swap_device_to_host_id = device_to_host_ids[statistics_info_->device_to_host_size_ - 1];
-  const auto &hash_id_to_index = host_hash_map->hash_id_to_index();
-  const auto &iter = hash_id_to_index.find(swap_device_to_host_id);
-  if (iter != hash_id_to_index.end()) {
-    auto index = iter->second;
+  int swap_device_to_host_id = device_to_host_ids[swap_pos];
+  auto index = host_hash_map->hash_id_to_index().Find(swap_device_to_host_id);
+  if (index != INVALID_INDEX_VALUE) {
     if (host_hash_map->hash_step(index) != data_step) {
       host_hash_map->set_hash_step(index, data_step);
     }
-    device_to_host_index[statistics_info_->device_to_host_size_ - 1] = index;
+    device_to_host_index[swap_pos] = index;
   } else {
     int *host_to_server_index = embedding_host_cache_->host_to_server_index.get();
     int *host_to_server_ids = embedding_host_cache_->host_to_server_ids.get();
     while (true) {
       // Calculate the mapping of id to index.
-      auto index = host_hash_map->ParseData(swap_device_to_host_id, host_to_server_index, host_to_server_ids, data_step,
+      index = host_hash_map->ParseData(swap_device_to_host_id, host_to_server_index, host_to_server_ids, data_step,
                                             graph_running_step, &statistics_info_->host_to_server_size_,
                                             host_cache_need_wait_graph);
       if (index == INVALID_INDEX_VALUE) {
         RETURN_IF_FALSE_WITH_LOG(actor_->WaitGraphRun(), "Wait graph run");
         continue;
       }
-      device_to_host_index[statistics_info_->device_to_host_size_ - 1] = index;
+      device_to_host_index[swap_pos] = index;
       break;
     }
   }
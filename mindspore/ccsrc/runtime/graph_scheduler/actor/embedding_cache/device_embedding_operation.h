@@ -95,11 +95,15 @@ class DeviceEmbeddingOperation {
   bool UpdateDeviceCache(void *indices, void *update_value, size_t indices_num, size_t cache_size,
                          size_t embedding_size, void *embedding_cache);
 
-  // Parse the hit and swap out to device cache information of the currently preprocessed id of the local host cache.
-  bool ParseHostDataHostToDevice(int id, size_t data_step, size_t graph_running_step, bool *host_cache_need_wait_graph);
-
-  // Parse the swap in information from device cache of the currently preprocessed id of the local host cache.
-  bool ParseHostDataDeviceToHost(size_t data_step, size_t graph_running_step, bool *host_cache_need_wait_graph);
+  // Parse the hit and swap out to device cache information of the id at position 'swap_pos' of the ids swapped from
+  // the local host cache to device cache.
+  bool ParseHostDataHostToDevice(int id, size_t swap_pos, size_t data_step, size_t graph_running_step,
+                                 bool *host_cache_need_wait_graph);
+
+  // Parse the swap in information from device cache of the id at position 'swap_pos' of the ids swapped from device
+  // cache to the local host cache.
+  bool ParseHostDataDeviceToHost(size_t swap_pos, size_t data_step, size_t graph_running_step,
+                                 bool *host_cache_need_wait_graph);
 
   // Build a CNode of embedding cache look up kernel(operator name: 'Gather'), which is used to look up local device
   // embedding cache.
@@ -20,6 +20,8 @@
 
 namespace mindspore {
 namespace runtime {
+using distributed::INVALID_INDEX_VALUE;
+
 bool DeviceSparseEmbeddingOperation::CountCacheMissIds(int *batch_ids, const size_t batch_ids_num, size_t data_step,
                                                        size_t graph_running_step, bool *device_cache_need_wait_graph,
                                                        bool *host_cache_need_wait_graph) {
@@ -52,11 +54,13 @@ bool DeviceSparseEmbeddingOperation::CountCacheMissIds(int *batch_ids, const siz
 
     if (need_swap_host_to_device) {
       RETURN_IF_FALSE_WITH_LOG(
-        ParseHostDataHostToDevice(batch_ids[i], data_step, graph_running_step, host_cache_need_wait_graph),
+        ParseHostDataHostToDevice(batch_ids[i], statistics_info_->host_to_device_size_ - 1, data_step,
+                                  graph_running_step, host_cache_need_wait_graph),
         "Parse local host cache data(swap local host cache to device) failed.");
     }
     if (need_swap_device_to_host) {
-      RETURN_IF_FALSE_WITH_LOG(ParseHostDataDeviceToHost(data_step, graph_running_step, host_cache_need_wait_graph),
+      RETURN_IF_FALSE_WITH_LOG(ParseHostDataDeviceToHost(statistics_info_->device_to_host_size_ - 1, data_step,
+                                                         graph_running_step, host_cache_need_wait_graph),
                                "Parse local host cache data(swap device cache to local host) failed.");
     }
   }
@@ -172,15 +176,16 @@ bool DeviceSparseEmbeddingOperation::CheckCacheHitFunc(const int *batch_ids, con
   MS_ERROR_IF_NULL(embedding_device_cache_);
   auto &device_hash_map = embedding_device_cache_->device_hash_map_;
   MS_ERROR_IF_NULL(device_hash_map);
-  const auto &hash_id_to_index = device_hash_map->hash_id_to_index();
+  std::vector<int> device_index(batch_ids_num);
+  device_hash_map->hash_id_to_index().FindBatch(batch_ids, batch_ids_num, device_index.data());
 
   // Count how many feature ids reside in the device cache.
   for (size_t i = 0; i < batch_ids_num; ++i) {
-    auto iter = hash_id_to_index.find(batch_ids[i]);
-    if (iter != hash_id_to_index.end()) {
-      if (device_hash_map->hash_step(iter->second) != data_step) {
+    auto index = device_index[i];
+    if (index != INVALID_INDEX_VALUE) {
+      if (device_hash_map->hash_step(index) != data_step) {
         ++(*hash_hit_count);
-        device_hash_map->set_hash_step(iter->second, data_step);
+        device_hash_map->set_hash_step(index, data_step);
       }
       in_device[i] = true;
     }
@@ -196,9 +201,7 @@ bool DeviceSparseEmbeddingOperation::ParseDeviceData(int id, bool *need_swap_dev
   auto &device_hash_map = embedding_device_cache_->device_hash_map_;
   MS_ERROR_IF_NULL(device_hash_map);
 
-  const auto &hash_id_to_index = device_hash_map->hash_id_to_index();
-  const auto &iter = hash_id_to_index.find(id);
-  if (iter != hash_id_to_index.end()) {
+  if (device_hash_map->hash_id_to_index().Find(id) != INVALID_INDEX_VALUE) {
     *need_swap_device_to_host = false;
     *need_swap_host_to_device = false;
     if (device_hash_map->hash_step(id) != data_step) {
@@ -147,6 +147,8 @@ void EmbeddingCachePrefetchActor::Initialize() {
   // Get the id range of each server's embedding table slice.
   GetRemoteEmbeddingSliceBound();
 
+  BuildLocalEmbeddingStores();
+
   // Initialize CPU device context. The origin device context for embedding cache prefetch actor is GPU or NPU. But we
   // still need the CPU device context to allocate host memory.
   device::DeviceContextKey host_key = {"CPU", 0};
@@ -584,6 +586,11 @@ bool EmbeddingCachePrefetchActor::PullEembeddingsFromRemote(int32_t param_key, c
     return true;
   }
 
+  const auto &store_iter = local_embedding_stores_.find(param_key);
+  if (store_iter != local_embedding_stores_.end()) {
+    return store_iter->second->Get(ids_num, ids, outputs->data());
+  }
+
   std::vector<std::vector<int>> slice_ids_list(server_num_);
   // 1. Partition ids by remote embedding slice bound and get unique ids.
   RETURN_IF_FALSE_WITH_LOG(PartitionIds(ids, ids_num, &slice_ids_list), "Partition ids failed.");
@@ -637,6 +644,11 @@ bool EmbeddingCachePrefetchActor::PushEmbeddingsToRemote(int32_t param_key, cons
     return true;
   }
 
+  const auto &store_iter = local_embedding_stores_.find(param_key);
+  if (store_iter != local_embedding_stores_.end()) {
+    return store_iter->second->Put(ids_num, ids, embeddings);
+  }
+
   std::vector<std::vector<int>> slice_ids_list(server_num_);
   std::vector<std::vector<float>> slice_embeddings_list(server_num_);
   // 1. Partition ids end embeddings by remote embedding slice bound.
@@ -688,6 +700,33 @@ void EmbeddingCachePrefetchActor::GetRemoteEmbeddingSliceBound() {
   }
 }
 
+void EmbeddingCachePrefetchActor::BuildLocalEmbeddingStores() {
+  if (common::GetEnv(distributed::kEnvEmbeddingStoreSpill) != "1") {
+    return;
+  }
+  auto store_path = common::GetEnv(distributed::kEnvEmbeddingStorePath);
+  MS_LOG(WARNING) << "The environment variable " << distributed::kEnvEmbeddingStoreSpill
+                  << " is set, the embeddings evicted from local host cache are spilled to the local embedding stores "
+                  << "in " << (store_path.empty() ? distributed::kDefaultEmbeddingStorePath : store_path)
+                  << " instead of the remote servers.";
+  for (const auto &item : hash_tables_) {
+    const auto &hash_info = item.second;
+    if (local_embedding_stores_.count(hash_info.param_key_) > 0) {
+      continue;
+    }
+    // The local host cache is in front of the embedding store, so the hot tier of the store only needs to hold the
+    // recently evicted embeddings, use the device cache size for it.
+    std::string name = std::to_string(hash_info.param_key_);
+    auto emb_store = std::make_shared<distributed::EmbeddingStore<int32_t, float>>(name, hash_info.cache_vocab_size,
+                                                                                   hash_info.embedding_size);
+    if (!emb_store->Initialize()) {
+      MS_LOG(EXCEPTION) << "Failed to initialize local embedding store for parameter: " << item.first;
+    }
+    local_embedding_stores_[hash_info.param_key_] = emb_store;
+    MS_LOG(INFO) << "Spill embeddings of parameter " << item.first << " to local embedding store " << name;
+  }
+}
+
 bool EmbeddingCachePrefetchActor::PartitionIds(const int *ids, size_t ids_num,
                                                std::vector<std::vector<int>> *slice_ids_list) {
   MS_ERROR_IF_NULL(ids);
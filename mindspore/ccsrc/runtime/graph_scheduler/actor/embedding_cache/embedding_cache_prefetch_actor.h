@@ -135,15 +135,20 @@ class EmbeddingCachePrefetchActor : public ActorBase {
   // Initialize local cache values using the random number generator.
   bool InitLocalCacheForNewIds(const HashTableInfo &hash_info);
 
-  // Lookup embedding from Remote and get embeddings via RPC.
+  // Lookup embedding from Remote and get embeddings via RPC, or from the local embedding store if there is one.
   bool PullEembeddingsFromRemote(int32_t param_key, const int *ids, size_t ids_num, std::vector<float> *outputs);
-  // Push the local embedding cache that requires evict to the remote.
+  // Push the local embedding cache that requires evict to the remote, or to the local embedding store if there is
+  // one.
   bool PushEmbeddingsToRemote(int32_t param_key, const int *ids, size_t ids_num, const float *embeddings,
                               size_t embeddings_len);
 
   // Get the id range of each server's embedding table slice.
   void GetRemoteEmbeddingSliceBound();
 
+  // Build local embedding stores if the environment variable MS_EMBEDDING_STORE_SPILL is set to 1, then the embeddings
+  // evicted from local host cache are spilled to the local stores instead of remote.
+  void BuildLocalEmbeddingStores();
+
   // In a multi-server scenario, the embeddings need to be segmented, and each server saves the embeddings of
   // different feature id ranges. Therefore, when the local side performs the push or pull embeddings operation, the
   // embeddings and ids need to be divided, and then communicate with the corresponding remote: Partition ids by
@@ -259,6 +264,9 @@ class EmbeddingCachePrefetchActor : public ActorBase {
   // Total server number of cluster.
   size_t server_num_{0};
 
+  // The local embedding stores by parameter key, which replace the remote servers to save the evicted embeddings.
+  std::map<int32_t, std::shared_ptr<distributed::EmbeddingStore<int32_t, float>>> local_embedding_stores_;
+
   // The flag which indicates whether this actor is running to prefetch cache.
   std::atomic_bool running_{false};
 
@@ -166,6 +166,7 @@ void KernelActor::InitWorkspaceInfo() {
 void KernelActor::Run(OpContext<DeviceTensor> *const context) {
   MS_EXCEPTION_IF_NULL(context);
   MS_EXCEPTION_IF_NULL(device_contexts_[0]);
+  run_time_ = ActorTrace::enabled() ? ActorTrace::Now() : 0;
 
   FetchInputDeviceTensor(context);
   FetchOutputDeviceTensor(context);
@@ -331,6 +332,7 @@ void *KernelActor::GetSomasDevicePtr(size_t offset) const {
 
 void KernelActor::SendMemoryAllocReq(OpContext<DeviceTensor> *const context) {
   running_dependent_msg_num_ = 1;
+  memory_alloc_time_ = ActorTrace::enabled() ? ActorTrace::Now() : 0;
   if (device_contexts_.empty() || device_contexts_[0] == nullptr) {
     SET_OPCONTEXT_FAIL_RET_WITH_ERROR_BY_STRATEGY(strategy_, (*context),
                                                   "Invalid device context for kernel actor:" + GetAID().Name());
@@ -381,7 +383,15 @@ void KernelActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *const context) {
   if (IsRunningFailed(context)) {
     return;
   }
+  if (memory_alloc_time_ != 0) {
+    ActorTrace::Record(kTraceMemoryAlloc, GetAID().Name(), memory_alloc_time_, ActorTrace::Now());
+    memory_alloc_time_ = 0;
+  }
   PreLaunchKernel(context);
+  if (run_time_ != 0) {
+    ActorTrace::Record(kTraceInputToLaunch, GetAID().Name(), run_time_, ActorTrace::Now());
+    run_time_ = 0;
+  }
 
   try {
     if (RecoveryContext::GetInstance()->enable_recovery() && CollectiveManager::instance()->need_reinit()) {
@@ -390,6 +400,7 @@ void KernelActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *const context) {
       MS_LOG(WARNING) << "Collective communication need reinitialize, skip launch kernel: "
                       << kernel_->fullname_with_scope();
     } else if (!IsSkippedLaunch(kernel_, nullptr)) {
+      ActorTraceScope trace_scope(kTraceLaunch, GetAID().Name());
       auto ret = LaunchKernel(context);
       if (!ret) {
         std::string error_info = "Launch kernel failed: " + kernel_->fullname_with_scope();
@@ -179,6 +179,11 @@ class KernelActor : public DebugAwareActor {
 
   // The information used for integration of dynamic and static memory.
   SomasInfo *somas_info_;
+
+  // The time all the inputs arrive and the time the memory allocation is requested, only recorded when the actor
+  // trace is enabled.
+  uint64_t run_time_{0};
+  uint64_t memory_alloc_time_{0};
 };
 
 using KernelActorPtr = std::shared_ptr<KernelActor>;
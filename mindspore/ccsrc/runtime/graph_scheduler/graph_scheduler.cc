@@ -80,6 +80,8 @@ using distributed::recovery::RecoveryContext;
 namespace {
 constexpr char kNumaEnableEnv[] = "MS_ENABLE_NUMA";
 constexpr char kNumaEnableEnv2[] = "DATASET_ENABLE_NUMA";
+constexpr char kActorWorkStealingEnv[] = "MS_DEV_ACTOR_WORK_STEALING";
+constexpr char kActorMpscMailBoxEnv[] = "MS_DEV_ACTOR_MPSC_MAILBOX";
 
 // For the transform state synchronization.
 constexpr char kTransformFinishPrefix[] = "TRANSFORM_FINISH_";
@@ -323,6 +325,8 @@ void GraphScheduler::Clear(const ActorInfo &actor_info, const std::vector<Kernel
 }
 
 void GraphScheduler::Clear() {
+  ActorTrace::ExportToEnvPath();
+
   // Terminate all actors.
   auto actor_manager = ActorMgr::GetActorMgrRef();
   MS_EXCEPTION_IF_NULL(actor_manager);
@@ -379,6 +383,7 @@ void GraphScheduler::Initialize() {
   init_ = true;
 
   BindNumaNode();
+  ActorTrace::InitializeFromEnv();
   (void)kKernelTypeToLinkFunc.emplace(KernelTransformType::kDeviceDataSourceActor,
                                       &GraphScheduler::LinkDataArrowForBaseActor);
   (void)kKernelTypeToLinkFunc.emplace(KernelTransformType::kHostDataSourceActor,
@@ -400,6 +405,14 @@ void GraphScheduler::Initialize() {
   auto actor_manager = ActorMgr::GetActorMgrRef();
   MS_EXCEPTION_IF_NULL(actor_manager);
   size_t actor_queue_size = 81920;
+  if (common::GetEnv(kActorWorkStealingEnv) == "1") {
+    MS_LOG(INFO) << "Enable the work stealing of actor threads.";
+    ActorThreadPool::set_actor_work_stealing(true);
+  }
+  if (common::GetEnv(kActorMpscMailBoxEnv) == "1") {
+    MS_LOG(INFO) << "Enable the lock-free mpsc mailbox of actors.";
+    actor_manager->set_mailbox_type(MailBoxType::kMpsc);
+  }
   auto ret = actor_manager->Initialize(true, actor_thread_num, actor_and_kernel_thread_num, actor_queue_size);
   if (ret != MINDRT_OK) {
     MS_LOG(EXCEPTION) << "Actor manager init failed.";
@@ -609,6 +622,7 @@ void GraphScheduler::Run(ActorSet *const actor_set, const std::vector<std::vecto
   }
   ActorDispatcher::set_is_multi_thread_execution(actor_set->is_multi_thread_execution_);
   double start_time = GetTime();
+  ActorTraceScope trace_scope(kTraceStep, actor_set->name_);
   ActorDispatcher::Send(actor_set->data_prepare_actor_->GetAID(), &DataPrepareActor::PrepareData, input_tensors,
                         &op_context, GraphExecutionStrategy::kPipeline);
 
@@ -25,9 +25,21 @@
 
 namespace mindspore {
 namespace pynative {
-AsyncQueue::AsyncQueue() { worker_ = std::make_shared<std::thread>(&AsyncQueue::WorkerLoop, this); }
+AsyncQueue::AsyncQueue() {
+  tail_segment_ = new Segment();
+  head_segment_ = tail_segment_;
+  worker_ = std::make_shared<std::thread>(&AsyncQueue::WorkerLoop, this);
+}
 
-AsyncQueue::~AsyncQueue() { WorkerJoin(); }
+AsyncQueue::~AsyncQueue() {
+  WorkerJoin();
+  while (head_segment_ != nullptr) {
+    auto next = head_segment_->next;
+    delete head_segment_;
+    head_segment_ = next;
+  }
+  delete spare_segment_.exchange(nullptr);
+}
 
 void AsyncQueue::WorkerLoop() {
 #if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
@@ -37,76 +49,121 @@ void AsyncQueue::WorkerLoop() {
     (void)kill(this_pid, SIGTERM);
   });
 #endif
+  task_pool_.set_worker_id(std::this_thread::get_id());
 
   while (true) {
-    std::shared_ptr<AsyncTask> task;
-    bool task_empty = false;
-    {
-      std::unique_lock<std::mutex> lock(task_mutex_);
-      task_empty = tasks_.empty();
-      if (!task_empty) {
-        task = tasks_.front();
-      }
-    }
-    if (task_empty) {
+    auto push_count = push_count_.load(std::memory_order_acquire);
+    if (take_count_ == push_count) {
       std::this_thread::yield();
       continue;
     }
 
     MS_LOG(DEBUG) << "Get task";
+    const auto &task = HeadTask();
     MS_EXCEPTION_IF_NULL(task);
     if (task->task_type() == kExitTask) {
       MS_LOG(DEBUG) << "Thread exit";
       return;
     }
 
-    try {
-      task->Run();
-      std::unique_lock<std::mutex> lock(task_mutex_);
-      if (!tasks_.empty()) {
-        tasks_.pop();
-      }
+    // Take the consecutive op run tasks pushed so far as a batch.
+    auto max_batch_size = task->task_type() == kOpRunTask ? max_batch_size_.load(std::memory_order_relaxed) : 1;
+    auto batch_start = take_count_;
+    batch_.push_back(TakeTask());
+    while (batch_.size() < max_batch_size && take_count_ < push_count && HeadTask() != nullptr &&
+           HeadTask()->task_type() == kOpRunTask) {
+      batch_.push_back(TakeTask());
+    }
 
-      if (tasks_.empty()) {
-        MS_LOG(DEBUG) << "Task queue empty";
-        task_cond_var_.notify_all();
+    try {
+      for (size_t i = 0; i < batch_.size(); ++i) {
+        // Reset drops the tasks which have not run yet.
+        if (batch_start + i >= discard_count_.load(std::memory_order_acquire)) {
+          batch_[i]->Run();
+        }
+        batch_[i] = nullptr;
       }
+      batch_.clear();
+      FinishTasks(take_count_);
     } catch (const std::exception &e) {
       MS_LOG(ERROR) << "Run task failed, error msg:" << e.what();
-      {
-        std::unique_lock<std::mutex> lock(task_mutex_);
-        std::queue<std::shared_ptr<AsyncTask>> empty;
-        std::swap(tasks_, empty);
-        MsException::Instance().SetException();
-        task_cond_var_.notify_all();
-      }
+      batch_.clear();
+      MsException::Instance().SetException();
+      ClearTasks();
     }
   }
 }
 
+const std::shared_ptr<AsyncTask> &AsyncQueue::HeadTask() {
+  if (head_index_ == kSegmentSize) {
+    // The producer has linked the next segment before pushing the task after the last one of this segment.
+    auto segment = head_segment_;
+    head_segment_ = segment->next;
+    head_index_ = 0;
+    segment->next = nullptr;
+    delete spare_segment_.exchange(segment, std::memory_order_acq_rel);
+  }
+  return head_segment_->tasks[head_index_];
+}
+
+std::shared_ptr<AsyncTask> AsyncQueue::TakeTask() {
+  (void)HeadTask();
+  auto task = std::move(head_segment_->tasks[head_index_]);
+  ++head_index_;
+  ++take_count_;
+  return task;
+}
+
+void AsyncQueue::FinishTasks(size_t finish_count) {
+  finish_count_.store(finish_count);
+  if (waiting_count_.load() > 0 && Empty()) {
+    MS_LOG(DEBUG) << "Task queue empty";
+    std::lock_guard<std::mutex> lock(task_mutex_);
+    task_cond_var_.notify_all();
+  }
+}
+
+void AsyncQueue::ClearTasks() {
+  auto push_count = push_count_.load(std::memory_order_acquire);
+  while (take_count_ < push_count) {
+    (void)TakeTask();
+  }
+  FinishTasks(take_count_);
+}
+
 void AsyncQueue::Push(const std::shared_ptr<AsyncTask> &task) {
-  std::lock_guard<std::mutex> lock(task_mutex_);
-  tasks_.push(task);
-  task_cond_var_.notify_all();
+  if (tail_index_ == kSegmentSize) {
+    auto segment = spare_segment_.exchange(nullptr, std::memory_order_acq_rel);
+    if (segment == nullptr) {
+      segment = new Segment();
+    }
+    tail_segment_->next = segment;
+    tail_segment_ = segment;
+    tail_index_ = 0;
+  }
+  tail_segment_->tasks[tail_index_] = task;
+  ++tail_index_;
+  push_count_.store(push_count_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
 }
 
 void AsyncQueue::Wait() {
-  std::unique_lock<std::mutex> lock(task_mutex_);
-  task_cond_var_.wait(lock, [this]() { return tasks_.empty(); });
+  if (!Empty()) {
+    // The worker checks the waiting count after it publishes the finished tasks, and it is increased here before
+    // checking them under the lock, so the notification can not be missed.
+    (void)waiting_count_.fetch_add(1);
+    {
+      std::unique_lock<std::mutex> lock(task_mutex_);
+      task_cond_var_.wait(lock, [this]() { return Empty(); });
+    }
+    (void)waiting_count_.fetch_sub(1);
+  }
   MsException::Instance().CheckException();
 }
 
-bool AsyncQueue::Empty() {
-  std::lock_guard<std::mutex> lock(task_mutex_);
-  return tasks_.empty();
-}
+bool AsyncQueue::Empty() { return finish_count_.load() == push_count_.load(); }
 
 void AsyncQueue::Reset() {
-  {
-    std::lock_guard<std::mutex> lock(task_mutex_);
-    std::queue<std::shared_ptr<AsyncTask>> empty;
-    std::swap(tasks_, empty);
-  }
+  discard_count_.store(push_count_.load(std::memory_order_relaxed), std::memory_order_release);
   // There is still one task in progress
   Wait();
 }
@@ -115,13 +172,8 @@ void AsyncQueue::WorkerJoin() {
   try {
     // Avoid worker thread join itself which will cause deadlock
     if (worker_->joinable() && worker_->get_id() != std::this_thread::get_id()) {
-      {
-        std::lock_guard<std::mutex> lock(task_mutex_);
-        auto task = std::make_shared<ExitTask>();
-        tasks_.push(task);
-        task_cond_var_.notify_all();
-        MS_LOG(DEBUG) << "Push exit task and notify all";
-      }
+      Push(std::make_shared<ExitTask>());
+      MS_LOG(DEBUG) << "Push exit task";
       worker_->join();
       MS_LOG(DEBUG) << "Worker join finish";
     }
@@ -17,18 +17,24 @@
 #ifndef MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_ASYNC_ASYNC_QUEUE_H_
 #define MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_ASYNC_ASYNC_QUEUE_H_
 
-#include <queue>
+#include <array>
+#include <atomic>
 #include <memory>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <utility>
+#include <vector>
 
 #include "include/backend/visible.h"
 #include "runtime/pynative/async/task.h"
+#include "runtime/pynative/async/task_pool.h"
 
 namespace mindspore {
 namespace pynative {
 // Create a new thread to execute the tasks in the queue sequentially.
+// The tasks are kept in a lock-free queue with a single producer: Push, Reset and WorkerJoin must be called by one
+// thread at a time, which is the python thread for PyNative. The worker takes the tasks without any lock.
 class BACKEND_EXPORT AsyncQueue {
  public:
   AsyncQueue();
@@ -49,11 +55,61 @@ class BACKEND_EXPORT AsyncQueue {
   // Thread join before the process exit.
   void WorkerJoin();
 
+  // Create a task, or an object held by a task, with the memory of the task pool. The objects must be released
+  // before the queue is destroyed.
+  template <typename T, typename... Args>
+  std::shared_ptr<T> MakeTask(Args &&... args) {
+    return std::allocate_shared<T>(TaskPoolAllocator<T>(&task_pool_), std::forward<Args>(args)...);
+  }
+
+  // The worker takes at most this number of consecutive op run tasks at a time and runs them as a batch, the
+  // finish of which is published once. No batch if it is 1.
+  void set_max_batch_size(size_t max_batch_size) {
+    max_batch_size_.store(max_batch_size == 0 ? 1 : max_batch_size, std::memory_order_relaxed);
+  }
+
  private:
+  static constexpr size_t kSegmentSize = 256;
+
+  // The queue is a list of segments, the producer links a new one when the last one is full, and the worker drops
+  // the first one when it has taken all its tasks. The segment dropped last is kept for the producer to reuse.
+  struct Segment {
+    std::array<std::shared_ptr<AsyncTask>, kSegmentSize> tasks;
+    Segment *next{nullptr};
+  };
+
   void WorkerLoop();
+  // Called by the worker, take the task at the head of the queue.
+  const std::shared_ptr<AsyncTask> &HeadTask();
+  std::shared_ptr<AsyncTask> TakeTask();
+  // Called by the worker, publish the number of finished tasks and wake up the waiting threads.
+  void FinishTasks(size_t finish_count);
+  // Called by the worker after an exception, drop all the pushed tasks.
+  void ClearTasks();
 
-  std::queue<std::shared_ptr<AsyncTask>> tasks_;
+  // Declared first to be destroyed after the tasks.
+  AsyncTaskPool task_pool_;
   std::shared_ptr<std::thread> worker_;
+
+  // Written by the producer.
+  alignas(kCacheLineSize) std::atomic<size_t> push_count_{0};
+  Segment *tail_segment_{nullptr};
+  size_t tail_index_{0};
+  // The tasks before this are dropped by Reset.
+  std::atomic<size_t> discard_count_{0};
+
+  // Written by the worker.
+  alignas(kCacheLineSize) std::atomic<size_t> finish_count_{0};
+  Segment *head_segment_{nullptr};
+  size_t head_index_{0};
+  size_t take_count_{0};
+  std::vector<std::shared_ptr<AsyncTask>> batch_;
+
+  std::atomic<Segment *> spare_segment_{nullptr};
+  std::atomic<size_t> max_batch_size_{1};
+
+  // Only used to wait for the tasks to finish.
+  std::atomic<size_t> waiting_count_{0};
   std::mutex task_mutex_;
   std::condition_variable task_cond_var_;
 };
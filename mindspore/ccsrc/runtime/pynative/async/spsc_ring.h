@@ -0,0 +1,104 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_ASYNC_SPSC_RING_H_
+#define MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_ASYNC_SPSC_RING_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace mindspore {
+namespace pynative {
+// The size of a cache line, the indexes of the producer and the consumer are kept in different lines.
+constexpr size_t kCacheLineSize = 64;
+
+// A bounded lock-free ring buffer with one producer thread and one consumer thread.
+// Only the producer calls TryPush, and only the consumer calls TryPop, Front and Pop.
+template <typename T, size_t kCapacity>
+class SpscRing {
+ public:
+  static_assert(kCapacity > 0 && (kCapacity & (kCapacity - 1)) == 0, "The capacity must be a power of 2.");
+
+  SpscRing() = default;
+  ~SpscRing() = default;
+  SpscRing(const SpscRing &) = delete;
+  SpscRing &operator=(const SpscRing &) = delete;
+
+  // Return false if the ring is full.
+  template <typename U>
+  bool TryPush(U &&item) {
+    auto tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_cache_ == kCapacity) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail - head_cache_ == kCapacity) {
+        return false;
+      }
+    }
+    items_[tail & kMask] = std::forward<U>(item);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Return null if the ring is empty. The item stays in the ring until Pop.
+  T *Front() {
+    auto head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head == tail_cache_) {
+        return nullptr;
+      }
+    }
+    return &items_[head & kMask];
+  }
+
+  // Remove the front item, the ring must not be empty.
+  void Pop() {
+    auto head = head_.load(std::memory_order_relaxed);
+    items_[head & kMask] = T();
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  // Return false if the ring is empty.
+  bool TryPop(T *item) {
+    auto front = Front();
+    if (front == nullptr) {
+      return false;
+    }
+    *item = std::move(*front);
+    Pop();
+    return true;
+  }
+
+  // It can be called by any thread, the result may be out of date when it returns.
+  bool Empty() const { return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire); }
+
+ private:
+  static constexpr size_t kMask = kCapacity - 1;
+
+  std::array<T, kCapacity> items_{};
+  // Written by the consumer.
+  alignas(kCacheLineSize) std::atomic<size_t> head_{0};
+  size_t tail_cache_{0};
+  // Written by the producer.
+  alignas(kCacheLineSize) std::atomic<size_t> tail_{0};
+  size_t head_cache_{0};
+};
+}  // namespace pynative
+}  // namespace mindspore
+
+#endif  // MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_ASYNC_SPSC_RING_H_
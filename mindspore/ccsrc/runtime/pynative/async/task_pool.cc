@@ -0,0 +1,81 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/pynative/async/task_pool.h"
+
+#include <new>
+
+namespace mindspore {
+namespace pynative {
+AsyncTaskPool::AsyncTaskPool() { free_blocks_.reserve(kMaxFreeBlocks); }
+
+AsyncTaskPool::~AsyncTaskPool() {
+  for (auto block : free_blocks_) {
+    ::operator delete(block);
+  }
+  void *block = nullptr;
+  while (returned_blocks_.TryPop(&block)) {
+    ::operator delete(block);
+  }
+}
+
+void *AsyncTaskPool::Allocate(size_t size) {
+  if (size > kBlockSize) {
+    return ::operator new(size);
+  }
+  auto this_id = std::this_thread::get_id();
+  auto producer_id = producer_id_.load(std::memory_order_relaxed);
+  if (producer_id != this_id &&
+      (producer_id != std::thread::id() || !producer_id_.compare_exchange_strong(producer_id, this_id))) {
+    return ::operator new(kBlockSize);
+  }
+  if (free_blocks_.empty()) {
+    void *block = nullptr;
+    while (free_blocks_.size() < kMaxFreeBlocks && returned_blocks_.TryPop(&block)) {
+      free_blocks_.push_back(block);
+    }
+    if (free_blocks_.empty()) {
+      return ::operator new(kBlockSize);
+    }
+  }
+  auto block = free_blocks_.back();
+  free_blocks_.pop_back();
+  return block;
+}
+
+void AsyncTaskPool::Free(void *block, size_t size) {
+  if (block == nullptr) {
+    return;
+  }
+  if (size > kBlockSize) {
+    ::operator delete(block);
+    return;
+  }
+  auto this_id = std::this_thread::get_id();
+  if (this_id == producer_id_.load(std::memory_order_relaxed)) {
+    if (free_blocks_.size() < kMaxFreeBlocks) {
+      free_blocks_.push_back(block);
+      return;
+    }
+  } else if (this_id == worker_id_.load(std::memory_order_acquire)) {
+    if (returned_blocks_.TryPush(block)) {
+      return;
+    }
+  }
+  ::operator delete(block);
+}
+}  // namespace pynative
+}  // namespace mindspore
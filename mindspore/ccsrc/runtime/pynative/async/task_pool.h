@@ -0,0 +1,105 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_ASYNC_TASK_POOL_H_
+#define MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_ASYNC_TASK_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "include/backend/visible.h"
+#include "runtime/pynative/async/spsc_ring.h"
+
+namespace mindspore {
+namespace pynative {
+// A pool of the memory of the tasks pushed to an AsyncQueue, and of the objects they hold such as OpTaskContext.
+// The objects are created by the thread pushing the tasks and mostly destroyed by the worker thread after the tasks
+// run, so the blocks freed by the worker go back to the pushing thread through a ring, and neither side takes a lock.
+// The blocks freed by any other thread, and the objects which do not fit in a block, go to the heap.
+class BACKEND_EXPORT AsyncTaskPool {
+ public:
+  // Enough for a BackendOpRunTask or an OpTaskContext along with the control block of its shared pointer.
+  static constexpr size_t kBlockSize = 256;
+
+  AsyncTaskPool();
+  ~AsyncTaskPool();
+  AsyncTaskPool(const AsyncTaskPool &) = delete;
+  AsyncTaskPool &operator=(const AsyncTaskPool &) = delete;
+
+  void *Allocate(size_t size);
+  void Free(void *block, size_t size);
+
+  // Set the thread which runs the tasks, the first thread calling Allocate is the one which pushes them.
+  void set_worker_id(std::thread::id worker_id) { worker_id_.store(worker_id, std::memory_order_release); }
+
+ private:
+  static constexpr size_t kMaxFreeBlocks = 4096;
+
+  std::atomic<std::thread::id> producer_id_{};
+  std::atomic<std::thread::id> worker_id_{};
+  // Only accessed by the producer.
+  std::vector<void *> free_blocks_;
+  // The blocks freed by the worker.
+  SpscRing<void *, kMaxFreeBlocks> returned_blocks_;
+};
+
+// The allocator of std::allocate_shared taking the memory from an AsyncTaskPool, which must outlive the objects.
+template <typename T>
+class TaskPoolAllocator {
+ public:
+  using value_type = T;
+
+  explicit TaskPoolAllocator(AsyncTaskPool *pool) : pool_(pool) {}
+  template <typename U>
+  TaskPoolAllocator(const TaskPoolAllocator<U> &other) : pool_(other.pool()) {}  // NOLINT
+
+  T *allocate(size_t n) {
+    if constexpr (alignof(T) > alignof(std::max_align_t)) {
+      return std::allocator<T>().allocate(n);
+    }
+    return static_cast<T *>(pool_->Allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T *p, size_t n) {
+    if constexpr (alignof(T) > alignof(std::max_align_t)) {
+      std::allocator<T>().deallocate(p, n);
+      return;
+    }
+    pool_->Free(p, n * sizeof(T));
+  }
+
+  AsyncTaskPool *pool() const { return pool_; }
+
+  template <typename U>
+  bool operator==(const TaskPoolAllocator<U> &other) const {
+    return pool_ == other.pool();
+  }
+  template <typename U>
+  bool operator!=(const TaskPoolAllocator<U> &other) const {
+    return pool_ != other.pool();
+  }
+
+ private:
+  AsyncTaskPool *pool_;
+};
+}  // namespace pynative
+}  // namespace mindspore
+
+#endif  // MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_ASYNC_TASK_POOL_H_
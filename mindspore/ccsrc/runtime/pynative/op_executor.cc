@@ -15,14 +15,37 @@
  */
 
 #include "runtime/pynative/op_executor.h"
+#include <cstdlib>
+#include "utils/convert_utils_base.h"
+#include "utils/ms_utils.h"
 
 namespace mindspore::runtime {
+namespace {
+// The max number of consecutive op run tasks launched as a batch by the backend thread, no batch if it is not set.
+constexpr char kPyNativeOpBatchSize[] = "MS_DEV_PYNATIVE_OP_BATCH_SIZE";
+
+size_t GetOpBatchSize() {
+  auto batch_size_env = common::GetEnv(kPyNativeOpBatchSize);
+  if (batch_size_env.empty()) {
+    return 1;
+  }
+  char *end = nullptr;
+  auto batch_size = std::strtol(batch_size_env.c_str(), &end, 10);
+  if (*end != '\0' || batch_size <= 0) {
+    MS_LOG(WARNING) << "The value of " << kPyNativeOpBatchSize << " should be a positive integer, but got "
+                    << batch_size_env << ", the op run tasks are not batched.";
+    return 1;
+  }
+  return LongToSize(batch_size);
+}
+}  // namespace
+
 OpExecutor &OpExecutor::GetInstance() {
   static OpExecutor instance;
   return instance;
 }
 
-OpExecutor::OpExecutor() = default;
+OpExecutor::OpExecutor() { async_queue_.set_max_batch_size(GetOpBatchSize()); }
 
 OpExecutor::~OpExecutor() = default;
 
@@ -51,6 +51,12 @@ class BACKEND_EXPORT OpExecutor {
 
   void PushOpRunTask(const std::shared_ptr<pynative::BackendOpRunTask> &op_run_task);
 
+  // Create an op task or its context with the task pool of the queue, so that dispatching an op does not malloc.
+  template <typename T, typename... Args>
+  std::shared_ptr<T> MakeTask(Args &&... args) {
+    return async_queue_.MakeTask<T>(std::forward<Args>(args)...);
+  }
+
   const std::vector<std::shared_ptr<pynative::BackendOpBuildTask>> &GetOpBuildTasks() const { return op_build_tasks_; }
 
   bool BuildQueueEmpty();
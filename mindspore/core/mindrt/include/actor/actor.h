@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_ACTOR_H
 #define MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_ACTOR_H
 
+#include <atomic>
 #include <functional>
 #include <map>
 #include <memory>
@@ -155,6 +156,7 @@ class MS_CORE_API ActorBase {
  private:
   friend class ActorMgr;
   friend class ActorWorker;
+  friend class ActorThreadPool;
   friend class ParallelWorker;
 
   // KMSG Msg Handler
@@ -214,6 +216,8 @@ class MS_CORE_API ActorBase {
   uint32_t recordNextPoint = 0;
 
   ActorThreadPool *pool_{nullptr};
+  // the actor thread which ran this actor last time, the actor is re-enqueued to it to keep cache locality
+  std::atomic_int worker_id_{-1};
   std::shared_ptr<ActorMgr> actor_mgr_;
 };
 using ActorReference = std::shared_ptr<ActorBase>;
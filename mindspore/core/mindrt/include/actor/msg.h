@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 #define MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 
+#include <atomic>
 #include <utility>
 #include <string>
 
@@ -24,6 +25,16 @@
 
 namespace mindspore {
 class ActorBase;
+class MessageBase;
+
+// The intrusive link of the message in the lock-free mailbox, it is never copied along with the message.
+struct MailBoxLink {
+  MailBoxLink() = default;
+  MailBoxLink(const MailBoxLink &) {}
+  MailBoxLink &operator=(const MailBoxLink &) { return *this; }
+  std::atomic<MessageBase *> next{nullptr};
+};
+
 class MessageBase {
  public:
   enum class Type : char {
@@ -75,6 +86,7 @@ class MessageBase {
 
   friend class ActorBase;
   friend class TCPMgr;
+  friend class MpscMailBox;
   AID from;
   AID to;
   std::string name;
@@ -85,6 +97,9 @@ class MessageBase {
   size_t size;
 
   Type type;
+
+ private:
+  MailBoxLink link_;
 };
 }  // namespace mindspore
 
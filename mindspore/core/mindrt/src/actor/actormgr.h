@@ -33,6 +33,10 @@
 namespace mindspore {
 class ActorBase;
 class IOMgr;
+
+// the mailbox used by the actors which share the threads of the actor thread pool
+enum class MailBoxType { kNonblocking = 0, kMpsc };
+
 class MS_CORE_API ActorMgr {
  public:
   static inline ActorMgr *GetActorMgrRef() { return &actorMgr; }
@@ -71,6 +75,10 @@ class MS_CORE_API ActorMgr {
   inline void SetDelegate(const std::string &d) { delegate = d; }
   void SetActorReady(const ActorReference &actor) const;
 
+  // only take effect on the actors spawned after it is set
+  inline void set_mailbox_type(MailBoxType mailbox_type) { mailbox_type_ = mailbox_type; }
+  inline MailBoxType mailbox_type() const { return mailbox_type_; }
+
  private:
   inline bool IsLocalAddres(const AID &id) {
     if (id.Url() == "" || id.Url().empty() || urls.find(id.Url()) != urls.end()) {
@@ -87,6 +95,8 @@ class MS_CORE_API ActorMgr {
   // or running on other thread pool created independently externally
   ActorThreadPool *inner_pool_{nullptr};
 
+  MailBoxType mailbox_type_{MailBoxType::kNonblocking};
+
   // Map of all local spawned and running processes.
   std::map<std::string, ActorReference> actors;
 #ifndef MS_COMPILE_IOS
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "actor/mailbox.h"
+#include <thread>
 
 namespace mindspore {
 int BlockingMailBox::EnqueueMessage(std::unique_ptr<mindspore::MessageBase> msg) {
@@ -85,4 +86,71 @@ std::unique_ptr<MessageBase> HQueMailBox::GetMsg() {
   std::unique_ptr<MessageBase> msg(mailbox.Dequeue());
   return msg;
 }
+
+MpscMailBox::~MpscMailBox() {
+  while (auto msg = Pop()) {
+    delete msg;
+  }
+}
+
+void MpscMailBox::Push(MessageBase *msg) {
+  msg->link_.next.store(nullptr, std::memory_order_relaxed);
+  auto prev = head_.exchange(msg, std::memory_order_acq_rel);
+  prev->link_.next.store(msg, std::memory_order_release);
+}
+
+MessageBase *MpscMailBox::Pop() {
+  MessageBase *tail = tail_;
+  MessageBase *next = tail->link_.next.load(std::memory_order_acquire);
+  if (tail == &stub_) {
+    if (next == nullptr) {
+      return nullptr;
+    }
+    tail_ = next;
+    tail = next;
+    next = next->link_.next.load(std::memory_order_acquire);
+  }
+  if (next != nullptr) {
+    tail_ = next;
+    return tail;
+  }
+  // a producer has swapped the head but not linked its message yet
+  if (tail != head_.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  Push(&stub_);
+  next = tail->link_.next.load(std::memory_order_acquire);
+  if (next != nullptr) {
+    tail_ = next;
+    return tail;
+  }
+  return nullptr;
+}
+
+int MpscMailBox::EnqueueMessage(std::unique_ptr<mindspore::MessageBase> msg) {
+  Push(msg.release());
+  // only the first message after the consumer became idle wakes up the actor
+  if (pending_.fetch_add(1, std::memory_order_acq_rel) == 0 && notifyHook) {
+    (*notifyHook.get())();
+  }
+  return 0;
+}
+
+std::unique_ptr<MessageBase> MpscMailBox::GetMsg() {
+  while (true) {
+    auto msg = Pop();
+    if (msg != nullptr) {
+      ++taken_;
+      return std::unique_ptr<MessageBase>(msg);
+    }
+    // release the whole batch taken since the last drain, the mailbox is idle if nothing else is pending
+    auto taken = taken_;
+    taken_ = 0;
+    if (pending_.fetch_sub(taken, std::memory_order_acq_rel) == taken) {
+      return nullptr;
+    }
+    // some producer is still linking its message, it will be visible soon
+    std::this_thread::yield();
+  }
+}
 }  // namespace mindspore
@@ -22,6 +22,28 @@
 
 namespace mindspore {
 size_t ActorThreadPool::actor_queue_size_ = kMaxHqueueSize;
+bool ActorThreadPool::actor_work_stealing_ = false;
+
+namespace {
+// the actor pool and the id of the actor worker running on the current thread
+thread_local ActorThreadPool *current_actor_pool = nullptr;
+thread_local size_t current_actor_worker_id = 0;
+
+inline uint32_t NextStealSeed(uint32_t seed) {
+  // xorshift32, seed must not be zero
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+}  // namespace
+
+ActorWorker::ActorWorker(ThreadPool *pool, size_t index) : Worker(pool, index) {
+  if (pool_ != nullptr) {
+    actor_queue_ = reinterpret_cast<ActorThreadPool *>(pool_)->actor_local_queue(index);
+  }
+  steal_seed_ = static_cast<uint32_t>(index) + 1;
+}
 
 void ActorWorker::CreateThread() { thread_ = std::thread(&ActorWorker::RunWithSpin, this); }
 
@@ -38,6 +60,8 @@ void ActorWorker::RunWithSpin() {
   _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
   _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
 #endif
+  current_actor_pool = reinterpret_cast<ActorThreadPool *>(pool_);
+  current_actor_worker_id = worker_id_;
   while (alive_) {
     // only run either local KernelTask or PoolQueue ActorTask
     if (RunLocalKernelTask() || RunQueueActorTask()) {
@@ -52,19 +76,52 @@ void ActorWorker::RunWithSpin() {
   }
 }
 
+ActorBase *ActorWorker::PopActor() {
+  auto pool = reinterpret_cast<ActorThreadPool *>(pool_);
+  // the local queue first, then the shared queue of the pool, steal from other workers at last
+  ActorBase *actor = nullptr;
+  if (actor_queue_ != nullptr) {
+    actor = actor_queue_->Dequeue();
+    if (actor != nullptr) {
+      (void)local_hits_.fetch_add(1, std::memory_order_relaxed);
+      return actor;
+    }
+  }
+  actor = pool->PopActorFromQueue();
+  if (actor != nullptr) {
+    (void)remote_hits_.fetch_add(1, std::memory_order_relaxed);
+    return actor;
+  }
+  if (actor_queue_ != nullptr) {
+    actor = pool->StealActorFromQueues(worker_id_, &steal_seed_);
+    if (actor != nullptr) {
+      (void)steals_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  return actor;
+}
+
 bool ActorWorker::RunQueueActorTask() {
   if (pool_ == nullptr) {
     return false;
   }
-  auto actor = reinterpret_cast<ActorThreadPool *>(pool_)->PopActorFromQueue();
+  auto actor = PopActor();
   if (actor == nullptr) {
     return false;
   }
 
+  actor->worker_id_.store(static_cast<int>(worker_id_), std::memory_order_relaxed);
   actor->Run();
   return true;
 }
 
+void ActorWorker::CollectSchedStats(ActorSchedStats *stats) const {
+  THREAD_RETURN_IF_NULL(stats);
+  stats->local_hits += local_hits_.load(std::memory_order_relaxed);
+  stats->remote_hits += remote_hits_.load(std::memory_order_relaxed);
+  stats->steals += steals_.load(std::memory_order_relaxed);
+}
+
 bool ActorWorker::ActorActive() {
   if (status_ != kThreadIdle) {
     return false;
@@ -78,19 +135,26 @@ bool ActorWorker::ActorActive() {
   return true;
 }
 
+bool ActorThreadPool::ActorQueuesEmpty() {
+  for (auto &local_queue : actor_local_queues_) {
+    if (!local_queue->Empty()) {
+      return false;
+    }
+  }
+#ifdef USE_HQUEUE
+  return actor_queue_.Empty();
+#else
+  std::lock_guard<std::mutex> _l(actor_mutex_);
+  return actor_queue_.empty();
+#endif
+}
+
 ActorThreadPool::~ActorThreadPool() {
   // wait until actor queue is empty
   bool terminate = false;
   int count = 0;
   do {
-    {
-#ifdef USE_HQUEUE
-      terminate = actor_queue_.Empty();
-#else
-      std::lock_guard<std::mutex> _l(actor_mutex_);
-      terminate = actor_queue_.empty();
-#endif
-    }
+    terminate = ActorQueuesEmpty();
     if (!terminate) {
       for (auto &worker : workers_) {
         worker->Active();
@@ -98,6 +162,11 @@ ActorThreadPool::~ActorThreadPool() {
       std::this_thread::yield();
     }
   } while (!terminate && count++ < kMaxCount);
+  if (!actor_local_queues_.empty()) {
+    auto stats = GetActorSchedStats();
+    MS_LOG(INFO) << "Actor schedule stats, local hits: " << stats.local_hits << ", remote hits: " << stats.remote_hits
+                 << ", steals: " << stats.steals;
+  }
   for (auto &worker : workers_) {
     delete worker;
     worker = nullptr;
@@ -106,6 +175,10 @@ ActorThreadPool::~ActorThreadPool() {
 #ifdef USE_HQUEUE
   actor_queue_.Clean();
 #endif
+  for (auto &local_queue : actor_local_queues_) {
+    local_queue->Clean();
+  }
+  actor_local_queues_.clear();
 }
 
 ActorBase *ActorThreadPool::PopActorFromQueue() {
@@ -122,11 +195,70 @@ ActorBase *ActorThreadPool::PopActorFromQueue() {
 #endif
 }
 
+ActorBase *ActorThreadPool::StealActorFromQueues(size_t thief_id, uint32_t *seed) {
+  size_t queue_num = actor_local_queues_.size();
+  if (queue_num <= 1 || seed == nullptr) {
+    return nullptr;
+  }
+  // start from a random victim to spread the thieves over the queues
+  *seed = NextStealSeed(*seed);
+  size_t start = *seed % queue_num;
+  for (size_t i = 0; i < queue_num; ++i) {
+    size_t victim = (start + i) % queue_num;
+    if (victim == thief_id) {
+      continue;
+    }
+    auto actor = actor_local_queues_[victim]->Dequeue();
+    if (actor != nullptr) {
+      return actor;
+    }
+  }
+  return nullptr;
+}
+
+size_t ActorThreadPool::SelectActorLocalQueue(const ActorBase *actor) {
+  // prefer the worker which ran the actor last time, then the current worker, otherwise round robin
+  size_t queue_num = actor_local_queues_.size();
+  int last_worker_id = actor->worker_id_.load(std::memory_order_relaxed);
+  if (last_worker_id >= 0 && static_cast<size_t>(last_worker_id) < queue_num) {
+    return static_cast<size_t>(last_worker_id);
+  }
+  if (current_actor_pool == this && current_actor_worker_id < queue_num) {
+    return current_actor_worker_id;
+  }
+  return next_local_queue_.fetch_add(1, std::memory_order_relaxed) % queue_num;
+}
+
+ActorSchedStats ActorThreadPool::GetActorSchedStats() const {
+  ActorSchedStats stats;
+  for (size_t i = 0; i < actor_local_queues_.size() && i < workers_.size(); ++i) {
+    reinterpret_cast<ActorWorker *>(workers_[i])->CollectSchedStats(&stats);
+  }
+  return stats;
+}
+
 void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
   if (!actor) {
     return;
   }
-  {
+  if (!actor_local_queues_.empty()) {
+    size_t queue_id = SelectActorLocalQueue(actor);
+    if (!actor_local_queues_[queue_id]->Enqueue(actor)) {
+      // the local queue is full, fall back to the shared queue
+#ifdef USE_HQUEUE
+      while (!actor_queue_.Enqueue(actor)) {
+      }
+#else
+      std::lock_guard<std::mutex> _l(actor_mutex_);
+      actor_queue_.push(actor);
+#endif
+    }
+    THREAD_DEBUG("actor[%s] enqueue to worker[%zu] success", actor->GetAID().Name().c_str(), queue_id);
+    // active the owner of the local queue first, otherwise an idle actor thread to steal it
+    if (reinterpret_cast<ActorWorker *>(workers_[queue_id])->ActorActive()) {
+      return;
+    }
+  } else {
 #ifdef USE_HQUEUE
     while (!actor_queue_.Enqueue(actor)) {
     }
@@ -134,8 +266,8 @@ void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
     std::lock_guard<std::mutex> _l(actor_mutex_);
     actor_queue_.push(actor);
 #endif
+    THREAD_DEBUG("actor[%s] enqueue success", actor->GetAID().Name().c_str());
   }
-  THREAD_DEBUG("actor[%s] enqueue success", actor->GetAID().Name().c_str());
   // active one idle actor thread if exist
   for (size_t i = 0; i < actor_thread_num_; ++i) {
     auto worker = reinterpret_cast<ActorWorker *>(workers_[i]);
@@ -155,6 +287,23 @@ int ActorThreadPool::ActorQueueInit() {
   return THREAD_OK;
 }
 
+int ActorThreadPool::ActorLocalQueuesInit(size_t actor_thread_num) {
+  if (!actor_work_stealing_ || actor_thread_num <= 1) {
+    return THREAD_OK;
+  }
+  size_t local_queue_size = actor_queue_size_ < kMaxActorLocalQueueSize ? actor_queue_size_ : kMaxActorLocalQueueSize;
+  for (size_t i = 0; i < actor_thread_num; ++i) {
+    auto local_queue = std::make_unique<HQueue<ActorBase>>();
+    if (local_queue->Init(static_cast<int32_t>(local_queue_size)) != true) {
+      THREAD_ERROR("init actor local queue failed.");
+      return THREAD_ERROR;
+    }
+    (void)actor_local_queues_.emplace_back(std::move(local_queue));
+  }
+  THREAD_INFO("init actor local queues success, num: [%zu]", actor_thread_num);
+  return THREAD_OK;
+}
+
 int ActorThreadPool::CreateThreads(size_t actor_thread_num, size_t all_thread_num, const std::vector<int> &core_list) {
   if (actor_thread_num > all_thread_num) {
     THREAD_ERROR("thread num is invalid");
@@ -176,6 +325,10 @@ int ActorThreadPool::CreateThreads(size_t actor_thread_num, size_t all_thread_nu
   if (TaskQueuesInit(total_thread_num) != THREAD_OK) {
     return THREAD_ERROR;
   }
+  // the actor workers fetch their local queues at construction
+  if (ActorLocalQueuesInit(actor_thread_num_) != THREAD_OK) {
+    return THREAD_ERROR;
+  }
 
   if (ThreadPool::CreateThreads<ActorWorker>(actor_thread_num_, core_list) != THREAD_OK) {
     return THREAD_ERROR;
@@ -20,6 +20,7 @@
 #include <queue>
 #include <vector>
 #include <mutex>
+#include <memory>
 #include <atomic>
 #include <condition_variable>
 #include "thread/threadpool.h"
@@ -30,12 +31,22 @@
 #define USE_HQUEUE
 #endif
 namespace mindspore {
+constexpr size_t kMaxActorLocalQueueSize = 1024;
+
+// statistics of the work-stealing actor scheduler
+typedef struct ActorSchedStats {
+  uint64_t local_hits{0};   // actors taken from the local queue of the running worker
+  uint64_t remote_hits{0};  // actors taken from the shared queue of the pool
+  uint64_t steals{0};       // actors stolen from the local queue of another worker
+} ActorSchedStats;
+
 class ActorThreadPool;
 class ActorWorker : public Worker {
  public:
-  explicit ActorWorker(ThreadPool *pool, size_t index) : Worker(pool, index) {}
+  explicit ActorWorker(ThreadPool *pool, size_t index);
   void CreateThread() override;
   bool ActorActive();
+  void CollectSchedStats(ActorSchedStats *stats) const;
   ~ActorWorker() override {
     {
       std::lock_guard<std::mutex> _l(mutex_);
@@ -61,6 +72,14 @@ class ActorWorker : public Worker {
  private:
   void RunWithSpin();
   bool RunQueueActorTask();
+  ActorBase *PopActor();
+
+  // local actor queue of this worker, nullptr if work stealing is disabled
+  HQueue<ActorBase> *actor_queue_{nullptr};
+  uint32_t steal_seed_{0};
+  std::atomic<uint64_t> local_hits_{0};
+  std::atomic<uint64_t> remote_hits_{0};
+  std::atomic<uint64_t> steals_{0};
 };
 
 class ActorThreadPool : public ThreadPool {
@@ -78,10 +97,18 @@ class ActorThreadPool : public ThreadPool {
   ~ActorThreadPool() override;
 
   static void set_actor_queue_size(size_t actor_queue_size) { actor_queue_size_ = actor_queue_size; }
+  // Each actor thread owns a local actor queue and steals from the others when it is idle, off by default.
+  static void set_actor_work_stealing(bool work_stealing) { actor_work_stealing_ = work_stealing; }
 
   virtual int ActorQueueInit();
   virtual void PushActorToQueue(ActorBase *actor);
   virtual ActorBase *PopActorFromQueue();
+  // steal one actor from the local queues of the actor threads except the thief
+  ActorBase *StealActorFromQueues(size_t thief_id, uint32_t *seed);
+  HQueue<ActorBase> *actor_local_queue(size_t worker_id) const {
+    return worker_id < actor_local_queues_.size() ? actor_local_queues_[worker_id].get() : nullptr;
+  }
+  ActorSchedStats GetActorSchedStats() const;
 
  protected:
   ActorThreadPool() = default;
@@ -93,12 +120,18 @@ class ActorThreadPool : public ThreadPool {
 #else
   std::queue<ActorBase *> actor_queue_;
 #endif
+  std::vector<std::unique_ptr<HQueue<ActorBase>>> actor_local_queues_;
 
  private:
   int CreateThreads(size_t actor_thread_num, size_t all_thread_num, const std::vector<int> &core_list);
+  int ActorLocalQueuesInit(size_t actor_thread_num);
+  bool ActorQueuesEmpty();
+  size_t SelectActorLocalQueue(const ActorBase *actor);
 
+  std::atomic<size_t> next_local_queue_{0};
   // Support to set the size of actor queue.
   static size_t actor_queue_size_;
+  static bool actor_work_stealing_;
 };
 }  // namespace mindspore
 #endif  // MINDSPORE_CORE_MINDRT_RUNTIME_ACTOR_THREADPOOL_H_
@@ -31,6 +31,10 @@ void Attention::set_head_size(int64_t head_size) {
 
 void Attention::set_cross(bool cross) { (void)this->AddAttr(kCross, api::MakeValue(cross)); }
 
+void Attention::set_max_cache_len(int64_t max_cache_len) {
+  (void)this->AddAttr(kAttentionMaxCacheLen, api::MakeValue(max_cache_len));
+}
+
 int64_t Attention::get_head_num() const {
   auto value_ptr = this->GetAttr(kAttentionNumHeads);
   return GetValue<int64_t>(value_ptr);
@@ -46,6 +50,11 @@ bool Attention::get_cross() const {
   return GetValue<bool>(value_ptr);
 }
 
+int64_t Attention::get_max_cache_len() const {
+  auto value_ptr = this->GetAttr(kAttentionMaxCacheLen);
+  return value_ptr == nullptr ? 0 : GetValue<int64_t>(value_ptr);
+}
+
 void Attention::Init(int64_t head_num, int64_t head_size, bool cross) {
   this->set_head_num(head_num);
   this->set_head_size(head_size);
@@ -44,9 +44,12 @@ class MIND_API Attention : public BaseOperator {
   void set_head_num(int64_t head_num);
   void set_head_size(int64_t head_size);
   void set_cross(bool cross);
+  /// \brief Set the max length of the key/value cache kept for the incremental decoding, 0 for no cache.
+  void set_max_cache_len(int64_t max_cache_len);
   int64_t get_head_num() const;
   int64_t get_head_size() const;
   bool get_cross() const;
+  int64_t get_max_cache_len() const;
 };
 }  // namespace ops
 }  // namespace mindspore
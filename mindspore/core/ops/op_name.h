@@ -161,6 +161,7 @@ constexpr auto kAttentionNumHeads = "head_num";
 constexpr auto kAttentionSizePerHead = "head_size";
 constexpr auto kAttentionFromSeqLen = "from_seq_len";
 constexpr auto kAttentionToSeqLen = "to_seq_len";
+constexpr auto kAttentionMaxCacheLen = "max_cache_len";
 constexpr auto kOffset = "offset";
 constexpr auto kNmsIouThreshold = "nms_iou_threshold";
 constexpr auto kNmsScoreThreshold = "nms_score_threshold";
@@ -38,7 +38,7 @@ class MS_CORE_API Crc32c {
   Crc32c() = default;
   ~Crc32c() = default;
 
-  // Calculate the crc32c value, use the 8 table method
+  // Calculate the crc32c value, with the crc32 instructions of the cpu if it has them, otherwise the 8 table method
   static uint32 MakeCrc32c(uint32 init_crc, const char *data, size_t size);
 
   // return the crc32c value(need mask)
@@ -61,6 +61,13 @@ static const char *const kMSCacheSerializePath = "serialize_path";
 // weight path
 static const char *const kWeight = "weight";
 static const char *const kWeightPath = "weight_path";
+// load the model file by mmap
+static const char *const kModelFile = "model_file";
+static const char *const kLoadByMmap = "load_by_mmap";
+// dynamic batching of model parallel runner
+static const char *const kDynamicBatch = "dynamic_batch";
+static const char *const kMaxBatchSize = "max_batch_size";
+static const char *const kMaxQueueDelayUs = "max_queue_delay_us";
 
 // model parallel runner id
 static const char *const kInnerIDs = "inner_ids";
@@ -68,6 +75,9 @@ static const char *const kInnerRunnerID = "inner_runner_id";
 static const char *const kInnerNumaID = "inner_numa_id";
 
 static const char *const kIsOptimized = "isOptimized";
+// cpu context
+static const char *const kCPUContext = "cpu_context";
+static const char *const kEnableBFloat16 = "enable_bfloat16";
 // gpu context
 static const char *const kGPUContext = "gpu_context";
 static const char *const kInputShape = "input_shape";
@@ -23,8 +23,10 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <dirent.h>
+#include <sys/mman.h>
 #endif
 
+#include <cerrno>
 #include <cstdlib>
 #include "securec/include/securec.h"
 
@@ -200,6 +202,57 @@ char *ReadFile(const char *file, size_t *size) {
   return buf;
 }
 
+char *ReadFileByMmap(const char *file, size_t *size) {
+  if (file == nullptr) {
+    MS_LOG(ERROR) << "File path is nullptr";
+    return nullptr;
+  }
+  MS_ASSERT(size != nullptr);
+#ifdef _WIN32
+  MS_LOG(WARNING) << "Mmap is not supported on windows, file: " << file;
+  return nullptr;
+#else
+  std::string real_path = RealPath(file);
+  if (real_path.empty()) {
+    MS_LOG(DEBUG) << "File path not regular: " << file;
+    return nullptr;
+  }
+  auto fd = open(real_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Open file " << real_path << " failed, errno: " << errno;
+    return nullptr;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    MS_LOG(ERROR) << "Get the size of file " << real_path << " failed.";
+    (void)close(fd);
+    return nullptr;
+  }
+  auto file_size = static_cast<size_t>(file_stat.st_size);
+  // The mapping is private, a page written by the runtime(for example, a weight packed in place) is copied on write,
+  // and the others are shared with all processes mapping the same file through the page cache.
+  auto buf = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  (void)close(fd);
+  if (buf == MAP_FAILED) {
+    MS_LOG(ERROR) << "Mmap file " << real_path << " failed, errno: " << errno;
+    return nullptr;
+  }
+  *size = file_size;
+  return reinterpret_cast<char *>(buf);
+#endif
+}
+
+void UnmapFileBuffer(char *buf, size_t size) {
+  if (buf == nullptr) {
+    return;
+  }
+#ifndef _WIN32
+  if (munmap(buf, size) != 0) {
+    MS_LOG(ERROR) << "Munmap buffer failed, errno: " << errno;
+  }
+#endif
+}
+
 std::string RealPath(const char *path) {
   if (path == nullptr) {
     MS_LOG(ERROR) << "path is nullptr";
@@ -51,6 +51,11 @@ char *ReadFileSegment(const std::string &file, int64_t offset, int64_t len);
 
 char *ReadFile(const char *file, size_t *size);
 
+// Map the whole file into memory instead of reading it, the buffer returned must be released by UnmapFileBuffer.
+char *ReadFileByMmap(const char *file, size_t *size);
+
+void UnmapFileBuffer(char *buf, size_t size);
+
 std::string RealPath(const char *path);
 
 int CreateOutputDir(std::string *file_path);
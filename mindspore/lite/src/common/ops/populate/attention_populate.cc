@@ -35,6 +35,7 @@ OpParameter *PopulateAttentionParameter(const void *prim) {
   param->head_num_ = value->head_num();
   param->head_size_ = value->head_size();
   param->cross_ = value->cross();
+  param->max_cache_len_ = static_cast<int>(value->max_cache_len());
   return reinterpret_cast<OpParameter *>(param);
 }
 
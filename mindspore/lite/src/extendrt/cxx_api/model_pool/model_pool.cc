@@ -16,6 +16,7 @@
 #include "src/extendrt/cxx_api/model_pool/model_pool.h"
 #include <unistd.h>
 #include <future>
+#include <chrono>
 #include <algorithm>
 #include "mindspore/ccsrc/plugin/device/cpu/kernel/nnacl/op_base.h"
 #include "src/extendrt/cxx_api/model_pool/resource_manager.h"
@@ -26,6 +27,7 @@
 #include "src/litert/pack_weight_manager.h"
 #include "src/extendrt/numa_adapter.h"
 #include "src/common/common.h"
+#include "src/common/utils.h"
 namespace mindspore {
 namespace {
 constexpr int kNumDeviceInfo = 2;
@@ -38,6 +40,7 @@ constexpr int kDefaultThreadsNum = 8;
 constexpr int kInvalidNumaId = -1;
 constexpr int kNumDefaultInterOpParallel = 4;
 constexpr int kNumCoreNumTimes = 5;
+constexpr int kNumDefaultMaxQueueDelayUs = 1000;
 }  // namespace
 
 int ModelPool::GetDefaultThreadNum(int worker_num) {
@@ -847,6 +850,42 @@ Status ModelPool::Init(const char *model_buf, size_t size, const std::shared_ptr
   for (size_t i = 0; i < kNumMaxTaskQueueSize; i++) {
     free_tasks_id_.push(i);
   }
+  return InitPredictBatcher(runner_config);
+}
+
+Status ModelPool::InitPredictBatcher(const std::shared_ptr<RunnerConfig> &runner_config) {
+  if (runner_config == nullptr) {
+    return kSuccess;
+  }
+  auto config_info = runner_config->GetConfigInfo();
+  auto section = config_info.find(lite::kDynamicBatch);
+  if (section == config_info.end()) {
+    return kSuccess;
+  }
+  int max_batch_size = 1;
+  int max_queue_delay_us = kNumDefaultMaxQueueDelayUs;
+  auto &batch_config = section->second;
+  if (batch_config.find(lite::kMaxBatchSize) != batch_config.end() &&
+      (!lite::ConvertStrToInt(batch_config.at(lite::kMaxBatchSize), &max_batch_size) || max_batch_size < 1)) {
+    MS_LOG(ERROR) << "invalid " << lite::kMaxBatchSize << ": " << batch_config.at(lite::kMaxBatchSize);
+    return kLiteParamInvalid;
+  }
+  if (batch_config.find(lite::kMaxQueueDelayUs) != batch_config.end() &&
+      (!lite::ConvertStrToInt(batch_config.at(lite::kMaxQueueDelayUs), &max_queue_delay_us) ||
+       max_queue_delay_us < 0)) {
+    MS_LOG(ERROR) << "invalid " << lite::kMaxQueueDelayUs << ": " << batch_config.at(lite::kMaxQueueDelayUs);
+    return kLiteParamInvalid;
+  }
+  if (max_batch_size <= 1) {
+    return kSuccess;
+  }
+  predict_batcher_ = std::make_shared<PredictBatcher>(
+    max_batch_size, max_queue_delay_us,
+    [this](const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs) {
+      return DispatchPredict(inputs, outputs, nullptr, nullptr);
+    });
+  MS_LOG(INFO) << "dynamic batching enabled, max batch size: " << max_batch_size
+               << ", max queue delay: " << max_queue_delay_us << "us";
   return kSuccess;
 }
 
@@ -955,6 +994,20 @@ Status ModelPool::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTen
       return kSuccess;
     }
   }
+  auto start = std::chrono::steady_clock::now();
+  Status status;
+  if (predict_batcher_ != nullptr && before == nullptr && after == nullptr) {
+    status = predict_batcher_->Predict(inputs, outputs);
+  } else {
+    status = DispatchPredict(inputs, outputs, before, after);
+  }
+  latency_histogram_.Record(
+    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+  return status;
+}
+
+Status ModelPool::DispatchPredict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
+                                  const MSKernelCallBack &before, const MSKernelCallBack &after) {
   int max_wait_worker_node_id = 0;
   int max_wait_worker_num = 0;
   auto available_worker = GetMaxWaitWorkerNum(&max_wait_worker_node_id, &max_wait_worker_num);
@@ -984,6 +1037,13 @@ Status ModelPool::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTen
 
 ModelPool::~ModelPool() {
   MS_LOG(INFO) << "free model pool.";
+  if (latency_histogram_.GetTotalCount() > 0) {
+    MS_LOG(INFO) << "predict latency: " << latency_histogram_.ToString();
+  }
+  if (predict_batcher_ != nullptr) {
+    MS_LOG(INFO) << "dynamic batching ran " << predict_batcher_->GetBatchNum() << " batches for "
+                 << predict_batcher_->GetBatchedRequestNum() << " requests.";
+  }
   if (predict_task_queue_ != nullptr) {
     predict_task_queue_->SetPredictTaskDone();
   }
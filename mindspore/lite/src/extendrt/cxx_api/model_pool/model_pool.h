@@ -30,6 +30,7 @@
 #include "include/api/model_parallel_runner.h"
 #include "src/extendrt/cxx_api/model_pool/model_worker.h"
 #include "src/extendrt/cxx_api/model_pool/predict_task_queue.h"
+#include "src/extendrt/cxx_api/model_pool/predict_batcher.h"
 namespace mindspore {
 using ModelPoolConfig = std::vector<std::shared_ptr<WorkerConfig>>;
 
@@ -62,7 +63,17 @@ class ModelPool {
   Status Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
                  const MSKernelCallBack &before = nullptr, const MSKernelCallBack &after = nullptr);
 
+  const LatencyHistogram &GetLatencyHistogram() const { return latency_histogram_; }
+
+  // The number of batches merged by dynamic batching, 0 if it is disabled.
+  uint64_t GetBatchNum() const { return predict_batcher_ == nullptr ? 0 : predict_batcher_->GetBatchNum(); }
+
  private:
+  Status DispatchPredict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
+                         const MSKernelCallBack &before, const MSKernelCallBack &after);
+
+  Status InitPredictBatcher(const std::shared_ptr<RunnerConfig> &runner_config);
+
   ModelPoolConfig CreateModelPoolConfig(const std::shared_ptr<RunnerConfig> &runner_config);
   std::shared_ptr<Context> GetInitContext(const std::shared_ptr<RunnerConfig> &runner_config);
 
@@ -134,6 +145,10 @@ class ModelPool {
   std::mutex task_id_mutex_;
   std::queue<size_t> free_tasks_id_;
 
+  // dynamic batching, only created when max batch size is configured greater than 1
+  std::shared_ptr<PredictBatcher> predict_batcher_ = nullptr;
+  LatencyHistogram latency_histogram_;
+
   // bind core
   bool is_user_core_list_ = false;
 
@@ -0,0 +1,330 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/extendrt/cxx_api/model_pool/predict_batcher.h"
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <utility>
+#include "src/common/log_adapter.h"
+#include "securec/include/securec.h"
+
+namespace mindspore {
+namespace {
+const std::vector<int64_t> kLatencyBucketBounds = {50,    100,    250,    500,    1000,    2500,    5000,    10000,
+                                                   25000, 50000,  100000, 250000, 500000, 1000000, 5000000, -1};
+
+void DestroyTensors(std::vector<MSTensor *> *tensors) {
+  for (auto &tensor : *tensors) {
+    MSTensor::DestroyTensorPtr(tensor);
+  }
+  tensors->clear();
+}
+}  // namespace
+
+LatencyHistogram::LatencyHistogram() : counts_(kLatencyBucketBounds.size()) {
+  for (auto &count : counts_) {
+    count = 0;
+  }
+}
+
+void LatencyHistogram::Record(int64_t latency_us) {
+  size_t index = 0;
+  for (; index + 1 < kLatencyBucketBounds.size(); index++) {
+    if (latency_us <= kLatencyBucketBounds[index]) {
+      break;
+    }
+  }
+  counts_[index]++;
+  total_count_++;
+}
+
+const std::vector<int64_t> &LatencyHistogram::BucketBounds() { return kLatencyBucketBounds; }
+
+std::vector<uint64_t> LatencyHistogram::GetCounts() const {
+  std::vector<uint64_t> counts;
+  counts.reserve(counts_.size());
+  for (auto &count : counts_) {
+    counts.push_back(count);
+  }
+  return counts;
+}
+
+std::string LatencyHistogram::ToString() const {
+  std::ostringstream oss;
+  oss << "total: " << total_count_;
+  for (size_t i = 0; i < counts_.size(); i++) {
+    if (counts_[i] == 0) {
+      continue;
+    }
+    if (kLatencyBucketBounds[i] < 0) {
+      oss << ", >" << kLatencyBucketBounds[i - 1] << "us: " << counts_[i];
+    } else {
+      oss << ", <=" << kLatencyBucketBounds[i] << "us: " << counts_[i];
+    }
+  }
+  return oss.str();
+}
+
+bool PredictBatcher::CanBatch(const std::vector<MSTensor> &inputs, const std::vector<MSTensor> &outputs) const {
+  if (max_batch_size_ <= 1 || batch_disabled_ || inputs.empty()) {
+    return false;
+  }
+  for (auto &input : inputs) {
+    auto shape = input.Shape();
+    if (shape.empty() || shape.front() <= 0 || shape.front() >= max_batch_size_ ||
+        input.DataType() == DataType::kObjectTypeString || input.GetDeviceData() != nullptr ||
+        input.Data() == nullptr) {
+      return false;
+    }
+  }
+  // user-allocated output buffers are filled by the worker in place, keep them on the direct path.
+  return std::all_of(outputs.begin(), outputs.end(), [](const MSTensor &output) {
+    return output.Data() == nullptr && output.GetDeviceData() == nullptr;
+  });
+}
+
+bool PredictBatcher::IsCompatible(const BatchRequest &lhs, const BatchRequest &rhs) const {
+  auto &lhs_inputs = *lhs.inputs;
+  auto &rhs_inputs = *rhs.inputs;
+  if (lhs_inputs.size() != rhs_inputs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs_inputs.size(); i++) {
+    if (lhs_inputs[i].DataType() != rhs_inputs[i].DataType() || lhs_inputs[i].format() != rhs_inputs[i].format()) {
+      return false;
+    }
+    auto lhs_shape = lhs_inputs[i].Shape();
+    auto rhs_shape = rhs_inputs[i].Shape();
+    if (lhs_shape.size() != rhs_shape.size() || lhs_shape.front() != lhs.batch_size ||
+        rhs_shape.front() != rhs.batch_size || !std::equal(lhs_shape.begin() + 1, lhs_shape.end(), rhs_shape.begin() + 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int64_t PredictBatcher::CompatibleBatchSize(const BatchRequest &leader) const {
+  int64_t batch_size = 0;
+  for (auto request : pending_) {
+    if (request == &leader || IsCompatible(leader, *request)) {
+      batch_size += request->batch_size;
+      if (batch_size >= max_batch_size_) {
+        break;
+      }
+    }
+  }
+  return batch_size;
+}
+
+std::vector<BatchRequest *> PredictBatcher::TakeBatch(BatchRequest *leader) {
+  std::vector<BatchRequest *> batch = {leader};
+  int64_t batch_size = leader->batch_size;
+  auto iter = pending_.begin();
+  while (iter != pending_.end()) {
+    auto request = *iter;
+    if (request == leader) {
+      iter = pending_.erase(iter);
+      continue;
+    }
+    if (batch_size + request->batch_size <= max_batch_size_ && IsCompatible(*leader, *request)) {
+      batch_size += request->batch_size;
+      batch.push_back(request);
+      iter = pending_.erase(iter);
+      continue;
+    }
+    ++iter;
+  }
+  return batch;
+}
+
+void PredictBatcher::PromoteNextLeader() {
+  if (pending_.empty()) {
+    has_leader_ = false;
+    return;
+  }
+  auto next_leader = pending_.front();
+  next_leader->is_leader = true;
+  next_leader->cond.notify_one();
+}
+
+Status PredictBatcher::MergeInputs(const std::vector<BatchRequest *> &batch, std::vector<MSTensor *> *merged_inputs,
+                                   std::vector<std::vector<uint8_t>> *buffers) {
+  auto &first_inputs = *batch.front()->inputs;
+  buffers->resize(first_inputs.size());
+  int64_t batch_size = 0;
+  for (auto request : batch) {
+    batch_size += request->batch_size;
+  }
+  for (size_t i = 0; i < first_inputs.size(); i++) {
+    size_t data_size = 0;
+    for (auto request : batch) {
+      data_size += request->inputs->at(i).DataSize();
+    }
+    auto &buffer = buffers->at(i);
+    buffer.resize(data_size);
+    size_t offset = 0;
+    for (auto request : batch) {
+      auto &input = request->inputs->at(i);
+      auto input_size = input.DataSize();
+      if (input_size == 0) {
+        continue;
+      }
+      if (memcpy_s(buffer.data() + offset, data_size - offset, input.Data().get(), input_size) != EOK) {
+        MS_LOG(ERROR) << "copy input " << input.Name() << " to batch buffer failed.";
+        return kLiteMemoryFailed;
+      }
+      offset += input_size;
+    }
+    auto shape = first_inputs[i].Shape();
+    shape[0] = batch_size;
+    auto tensor = MSTensor::CreateRefTensor(first_inputs[i].Name(), first_inputs[i].DataType(), shape, buffer.data(),
+                                            data_size, false);
+    if (tensor == nullptr) {
+      MS_LOG(ERROR) << "create batch input tensor failed.";
+      return kLiteNullptr;
+    }
+    tensor->SetFormat(first_inputs[i].format());
+    merged_inputs->push_back(tensor);
+  }
+  return kSuccess;
+}
+
+Status PredictBatcher::SplitOutputs(const std::vector<MSTensor> &merged_outputs,
+                                    const std::vector<BatchRequest *> &batch) {
+  int64_t batch_size = 0;
+  for (auto request : batch) {
+    batch_size += request->batch_size;
+  }
+  for (auto &output : merged_outputs) {
+    auto shape = output.Shape();
+    if (shape.empty() || shape.front() != batch_size || output.Data() == nullptr) {
+      MS_LOG(WARNING) << "output " << output.Name() << " is not batched along the first dimension, shape: " << shape;
+      return kLiteNotSupport;
+    }
+  }
+  for (auto request : batch) {
+    request->outputs->clear();
+  }
+  for (auto &output : merged_outputs) {
+    auto shape = output.Shape();
+    auto row_size = output.DataSize() / static_cast<size_t>(batch_size);
+    auto data = static_cast<const uint8_t *>(output.Data().get());
+    size_t offset = 0;
+    for (auto request : batch) {
+      shape[0] = request->batch_size;
+      auto size = row_size * static_cast<size_t>(request->batch_size);
+      auto tensor = MSTensor::CreateTensor(output.Name(), output.DataType(), shape, data + offset, size);
+      if (tensor == nullptr) {
+        MS_LOG(ERROR) << "create output tensor for batched request failed.";
+        return kLiteNullptr;
+      }
+      tensor->SetFormat(output.format());
+      request->outputs->push_back(*tensor);
+      MSTensor::DestroyTensorPtr(tensor);
+      offset += size;
+    }
+  }
+  return kSuccess;
+}
+
+Status PredictBatcher::RunBatch(const std::vector<BatchRequest *> &batch) {
+  std::vector<MSTensor *> merged_input_ptrs;
+  std::vector<std::vector<uint8_t>> buffers;
+  auto status = MergeInputs(batch, &merged_input_ptrs, &buffers);
+  if (status != kSuccess) {
+    DestroyTensors(&merged_input_ptrs);
+    return status;
+  }
+  std::vector<MSTensor> merged_inputs;
+  (void)std::transform(merged_input_ptrs.begin(), merged_input_ptrs.end(), std::back_inserter(merged_inputs),
+                       [](const MSTensor *tensor) { return *tensor; });
+  std::vector<MSTensor> merged_outputs;
+  status = predict_func_(merged_inputs, &merged_outputs);
+  merged_inputs.clear();
+  DestroyTensors(&merged_input_ptrs);
+  if (status != kSuccess) {
+    MS_LOG(ERROR) << "batched predict failed, request num: " << batch.size();
+    return status;
+  }
+  status = SplitOutputs(merged_outputs, batch);
+  if (status == kLiteNotSupport) {
+    // the model does not keep the batch dimension, fall back to one inference per request from now on.
+    MS_LOG(WARNING) << "model outputs can not be split by batch, dynamic batching is disabled.";
+    batch_disabled_ = true;
+    for (auto request : batch) {
+      request->outputs->clear();
+      auto ret = predict_func_(*request->inputs, request->outputs);
+      if (ret != kSuccess) {
+        return ret;
+      }
+    }
+    return kSuccess;
+  }
+  batch_num_++;
+  batched_request_num_ += batch.size();
+  return status;
+}
+
+Status PredictBatcher::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs) {
+  if (!CanBatch(inputs, *outputs)) {
+    return predict_func_(inputs, outputs);
+  }
+  BatchRequest request;
+  request.inputs = &inputs;
+  request.outputs = outputs;
+  request.batch_size = inputs.front().Shape().front();
+  request.enqueue_time = std::chrono::steady_clock::now();
+
+  std::unique_lock<std::mutex> pending_lock(mtx_pending_);
+  pending_.push_back(&request);
+  if (!has_leader_) {
+    has_leader_ = true;
+    request.is_leader = true;
+  } else {
+    leader_cond_.notify_one();
+    request.cond.wait(pending_lock, [&request] { return request.done || request.is_leader; });
+    if (request.done) {
+      return request.status;
+    }
+  }
+  // the leader waits until the batch is full or the oldest request has waited long enough.
+  auto deadline = request.enqueue_time + max_queue_delay_;
+  (void)leader_cond_.wait_until(pending_lock, deadline,
+                                [this, &request] { return CompatibleBatchSize(request) >= max_batch_size_; });
+  auto batch = TakeBatch(&request);
+  PromoteNextLeader();
+  pending_lock.unlock();
+
+  Status status = kSuccess;
+  if (batch.size() == 1) {
+    status = predict_func_(inputs, outputs);
+  } else {
+    status = RunBatch(batch);
+  }
+
+  pending_lock.lock();
+  for (auto item : batch) {
+    if (item == &request) {
+      continue;
+    }
+    item->status = status;
+    item->done = true;
+    item->cond.notify_one();
+  }
+  return status;
+}
+}  // namespace mindspore
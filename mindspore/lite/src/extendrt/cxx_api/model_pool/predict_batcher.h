@@ -0,0 +1,104 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_LITE_SRC_EXTENDRT_CXX_API_MODEL_POOL_PREDICT_BATCHER_H_
+#define MINDSPORE_LITE_SRC_EXTENDRT_CXX_API_MODEL_POOL_PREDICT_BATCHER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "include/api/types.h"
+#include "include/api/status.h"
+
+namespace mindspore {
+// Per-request latency histogram with fixed log-scale buckets, recording is lock free.
+class LatencyHistogram {
+ public:
+  LatencyHistogram();
+  ~LatencyHistogram() = default;
+
+  void Record(int64_t latency_us);
+  // upper bound (in microseconds) of every bucket, the last bucket is unbounded and reported as -1.
+  static const std::vector<int64_t> &BucketBounds();
+  std::vector<uint64_t> GetCounts() const;
+  uint64_t GetTotalCount() const { return total_count_; }
+  std::string ToString() const;
+
+ private:
+  std::vector<std::atomic<uint64_t>> counts_;
+  std::atomic<uint64_t> total_count_ = 0;
+};
+
+struct BatchRequest {
+  const std::vector<MSTensor> *inputs = nullptr;
+  std::vector<MSTensor> *outputs = nullptr;
+  int64_t batch_size = 0;
+  std::chrono::steady_clock::time_point enqueue_time;
+  bool is_leader = false;
+  bool done = false;
+  Status status = kSuccess;
+  std::condition_variable cond;
+};
+
+// Coalesces concurrent requests along the first dimension of inputs and runs them as one inference.
+// There is no dispatcher thread: the oldest pending request acts as the leader, waits until the batch is full
+// or the queueing delay expires, runs the merged inference and scatters the outputs back to the other requests.
+class PredictBatcher {
+ public:
+  using PredictFunc = std::function<Status(const std::vector<MSTensor> &, std::vector<MSTensor> *)>;
+
+  PredictBatcher(int64_t max_batch_size, int64_t max_queue_delay_us, PredictFunc predict_func)
+      : max_batch_size_(max_batch_size),
+        max_queue_delay_(max_queue_delay_us),
+        predict_func_(std::move(predict_func)) {}
+  ~PredictBatcher() = default;
+
+  Status Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs);
+
+  uint64_t GetBatchNum() const { return batch_num_; }
+  uint64_t GetBatchedRequestNum() const { return batched_request_num_; }
+
+ private:
+  bool CanBatch(const std::vector<MSTensor> &inputs, const std::vector<MSTensor> &outputs) const;
+  bool IsCompatible(const BatchRequest &lhs, const BatchRequest &rhs) const;
+  int64_t CompatibleBatchSize(const BatchRequest &leader) const;
+  std::vector<BatchRequest *> TakeBatch(BatchRequest *leader);
+  void PromoteNextLeader();
+  Status RunBatch(const std::vector<BatchRequest *> &batch);
+  Status MergeInputs(const std::vector<BatchRequest *> &batch, std::vector<MSTensor *> *merged_inputs,
+                     std::vector<std::vector<uint8_t>> *buffers);
+  Status SplitOutputs(const std::vector<MSTensor> &merged_outputs, const std::vector<BatchRequest *> &batch);
+
+  int64_t max_batch_size_ = 1;
+  std::chrono::microseconds max_queue_delay_;
+  PredictFunc predict_func_ = nullptr;
+
+  std::mutex mtx_pending_;
+  std::condition_variable leader_cond_;
+  std::deque<BatchRequest *> pending_;
+  bool has_leader_ = false;
+  std::atomic_bool batch_disabled_ = false;
+
+  std::atomic<uint64_t> batch_num_ = 0;
+  std::atomic<uint64_t> batched_request_num_ = 0;
+};
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_SRC_EXTENDRT_CXX_API_MODEL_POOL_PREDICT_BATCHER_H_
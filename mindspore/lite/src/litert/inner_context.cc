@@ -190,6 +190,14 @@ bool InnerContext::IsCpuFloat16Enabled() const {
   return GetDeviceInfo(DT_CPU).cpu_device_info_.enable_float16_;
 }
 
+bool InnerContext::IsCpuBFloat16Enabled() const {
+#ifdef ENABLE_AVX512
+  return enable_bfloat16_ && IsDeviceTypeEnabled(DT_CPU);
+#else
+  return false;
+#endif
+}
+
 bool InnerContext::IsGpuFloat16Enabled() const {
 #ifdef GPU_OPENCL
   if (!IsDeviceTypeEnabled(DT_GPU)) {
@@ -84,6 +84,8 @@ struct InnerContext {
   virtual ~InnerContext();
   int Init();
   bool IsCpuFloat16Enabled() const;
+  // Whether the float32 kernels of the avx512 take the constant weights packed to bfloat16, see enable_bfloat16_.
+  bool IsCpuBFloat16Enabled() const;
   bool IsGpuFloat16Enabled() const;
   bool IsNpuFloat16Enabled() const;
   bool IsGLTextureEnabled() const;
@@ -109,6 +111,7 @@ struct InnerContext {
   int delegate_mode_ = 0;
   DelegatePtr delegate = nullptr;
   bool float_mode = false; /**< convert full quant model to float model */
+  bool enable_bfloat16_ = false; /**< pack the constant weights of the float32 kernels to bfloat16, set by the config */
 
   bool device_and_pkg_support_fp16_ = false;
   ThreadPool *thread_pool_ = nullptr;
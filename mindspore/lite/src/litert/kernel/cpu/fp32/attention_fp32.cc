@@ -0,0 +1,462 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/litert/kernel/cpu/fp32/attention_fp32.h"
+#include <cmath>
+#include <cstring>
+#include "schema/model_generated.h"
+#include "src/litert/kernel_registry.h"
+#include "include/errorcode.h"
+#include "nnacl/fp32/flash_attention_fp32.h"
+#include "nnacl/fp32/matmul_fp32.h"
+
+using mindspore::kernel::KERNEL_ARCH;
+using mindspore::lite::KernelRegistrar;
+using mindspore::lite::RET_ERROR;
+using mindspore::lite::RET_MEMORY_FAILED;
+using mindspore::lite::RET_NOT_SUPPORT;
+using mindspore::lite::RET_OK;
+using mindspore::schema::PrimitiveType_Attention;
+
+namespace mindspore::kernel {
+namespace {
+constexpr size_t kAttentionInputSize = 8;
+constexpr size_t kCrossAttentionInputSize = 9;
+constexpr size_t kAttentionWithKeyValueOutputSize = 3;
+constexpr size_t kWeightQKVIndex = 3;
+constexpr size_t kBiasQKVIndex = 5;
+constexpr size_t kCrossBiasQKVIndex = 6;
+constexpr size_t kKeyOutputIndex = 1;
+constexpr size_t kValueOutputIndex = 2;
+constexpr int kQKVNum = 3;
+constexpr int kKVNum = 2;
+
+// Get the batch, sequence length and hidden size of the input of [batch, seq, hidden] or [seq, hidden].
+int GetSeqShape(const lite::Tensor *tensor, int *batch, int *seq, int *hidden) {
+  const auto &shape = tensor->shape();
+  if (shape.size() == C3NUM) {
+    *batch = shape[0];
+    *seq = shape[1];
+  } else if (shape.size() == C2NUM) {
+    *batch = 1;
+    *seq = shape[0];
+  } else {
+    MS_LOG(ERROR) << "The input of Attention should be 2D or 3D, but got " << shape.size() << "D.";
+    return RET_ERROR;
+  }
+  *hidden = shape.back();
+  return RET_OK;
+}
+
+bool CheckMatrixShape(const lite::Tensor *tensor, int row, int col) {
+  const auto &shape = tensor->shape();
+  return shape.size() == C2NUM && shape[0] == row && shape[1] == col;
+}
+
+bool CheckVectorShape(const lite::Tensor *tensor, int len) {
+  const auto &shape = tensor->shape();
+  return shape.size() == 1 && shape[0] == len;
+}
+
+int AttentionProjectRun(void *cdata, int task_id, float, float) {
+  auto kernel = reinterpret_cast<const AttentionCPUKernel *>(cdata);
+  return kernel->Project(task_id);
+}
+
+int AttentionAttendRun(void *cdata, int task_id, float, float) {
+  auto kernel = reinterpret_cast<const AttentionCPUKernel *>(cdata);
+  return kernel->Attend(task_id);
+}
+
+int AttentionProjectOutputRun(void *cdata, int task_id, float, float) {
+  auto kernel = reinterpret_cast<const AttentionCPUKernel *>(cdata);
+  return kernel->ProjectOutput(task_id);
+}
+}  // namespace
+
+AttentionCPUKernel::~AttentionCPUKernel() {
+  FreeRunBuffers();
+  FreeCache();
+}
+
+int AttentionCPUKernel::Prepare() {
+  CHECK_LESS_RETURN(in_tensors_.size(), kAttentionInputSize - 1);
+  CHECK_LESS_RETURN(out_tensors_.size(), 1);
+  auto input_size = param_->cross_ ? kCrossAttentionInputSize : kAttentionInputSize;
+  if (in_tensors_.size() != input_size && in_tensors_.size() != input_size - 1) {
+    MS_LOG(ERROR) << "Attention with " << in_tensors_.size() << " inputs is not supported, cross: " << param_->cross_;
+    return RET_NOT_SUPPORT;
+  }
+  has_mask_ = in_tensors_.size() == input_size;
+  if (param_->max_cache_len_ < 0 || (param_->max_cache_len_ > 0 && (param_->cross_ || !has_mask_))) {
+    MS_LOG(ERROR) << "The key/value cache only supports the self attention with the mask, max_cache_len: "
+                  << param_->max_cache_len_ << ", cross: " << param_->cross_ << ", mask: " << has_mask_;
+    return RET_NOT_SUPPORT;
+  }
+  for (auto tensor : in_tensors_) {
+    CHECK_NULL_RETURN(tensor);
+    if (tensor->data_type() != kNumberTypeFloat32) {
+      MS_LOG(ERROR) << "The inputs of Attention should be float32, but got " << tensor->data_type();
+      return RET_NOT_SUPPORT;
+    }
+  }
+  // The T5 attention has the 4D position bias and mask where the biases are, the same number of inputs as the
+  // attention without the mask, so the layouts are told apart by the rank of the biases.
+  size_t bias_index = param_->cross_ ? kCrossBiasQKVIndex : kBiasQKVIndex;
+  for (size_t i = bias_index; i < bias_index + C2NUM; ++i) {
+    if (in_tensors_[i]->shape().size() == C4NUM) {
+      MS_LOG(ERROR) << "The T5 attention with the position bias is not supported, input " << i << " is 4D.";
+      return RET_NOT_SUPPORT;
+    }
+  }
+  if (!InferShapeDone()) {
+    return RET_OK;
+  }
+  return ReSize();
+}
+
+int AttentionCPUKernel::CheckInputs() {
+  head_num_ = param_->head_num_;
+  head_size_ = param_->head_size_;
+  MS_CHECK_TRUE_MSG(head_num_ > 0 && head_size_ > 0, RET_ERROR, "The head num and head size should be positive.");
+  MS_CHECK_INT_MUL_NOT_OVERFLOW(head_num_, head_size_, RET_ERROR);
+  int attention_hidden = head_num_ * head_size_;
+  int kv_batch = 0;
+  int kv_hidden = 0;
+  auto ret = GetSeqShape(in_tensors_[FIRST_INPUT], &batch_, &q_seq_, &hidden_);
+  MS_CHECK_TRUE_RET(ret == RET_OK, ret);
+  ret = GetSeqShape(in_tensors_[SECOND_INPUT], &kv_batch, &kv_seq_, &kv_hidden);
+  MS_CHECK_TRUE_RET(ret == RET_OK, ret);
+  MS_CHECK_TRUE_MSG(kv_batch == batch_ && in_tensors_[SECOND_INPUT]->shape() == in_tensors_[THIRD_INPUT]->shape(),
+                    RET_ERROR, "The batch of q, k and v of Attention should be the same, and k and v the same shape.");
+  if (param_->max_cache_len_ > 0) {
+    MS_CHECK_TRUE_MSG(kv_seq_ == q_seq_, RET_ERROR, "The self attention with cache should have the same q and k.");
+  }
+  MS_CHECK_TRUE_MSG(kv_hidden == hidden_, RET_ERROR, "The hidden size of q, k and v of Attention should be same.");
+
+  size_t index = kWeightQKVIndex;
+  if (param_->cross_) {
+    auto weight_q = in_tensors_[index++];
+    auto weight_kv = in_tensors_[index++];
+    MS_CHECK_TRUE_MSG(CheckMatrixShape(weight_q, hidden_, attention_hidden) &&
+                        CheckMatrixShape(weight_kv, hidden_, kKVNum * attention_hidden),
+                      RET_ERROR, "The shape of the weights of q, k and v of Attention is invalid.");
+    weight_q_col_ = attention_hidden;
+    weight_kv_col_ = kKVNum * attention_hidden;
+  } else {
+    auto weight_qkv = in_tensors_[index++];
+    MS_CHECK_TRUE_MSG(CheckMatrixShape(weight_qkv, hidden_, kQKVNum * attention_hidden), RET_ERROR,
+                      "The shape of the weight of q, k and v of Attention is invalid.");
+    weight_q_col_ = kQKVNum * attention_hidden;
+    weight_kv_col_ = kQKVNum * attention_hidden;
+  }
+  auto weight_o = in_tensors_[index++];
+  auto bias_qkv = in_tensors_[index++];
+  auto bias_o = in_tensors_[index++];
+  MS_CHECK_TRUE_MSG(weight_o->shape().size() == C2NUM && weight_o->shape()[0] == attention_hidden, RET_ERROR,
+                    "The shape of the weight of the output of Attention is invalid.");
+  out_hidden_ = weight_o->shape()[1];
+  MS_CHECK_TRUE_MSG(CheckVectorShape(bias_qkv, kQKVNum * attention_hidden) && CheckVectorShape(bias_o, out_hidden_),
+                    RET_ERROR, "The shape of the biases of Attention is invalid.");
+  MS_CHECK_TRUE_MSG(out_tensors_[FIRST_INPUT]->ElementsNum() == batch_ * q_seq_ * out_hidden_, RET_ERROR,
+                    "The shape of the output of Attention is invalid.");
+  return RET_OK;
+}
+
+int AttentionCPUKernel::InitDataPointers() {
+  for (auto tensor : in_tensors_) {
+    CHECK_NULL_RETURN(tensor->data());
+  }
+  for (auto tensor : out_tensors_) {
+    CHECK_NULL_RETURN(tensor->data());
+  }
+  int attention_hidden = head_num_ * head_size_;
+  size_t index = kWeightQKVIndex;
+  weight_q_ = reinterpret_cast<const float *>(in_tensors_[index++]->data());
+  if (param_->cross_) {
+    weight_k_ = reinterpret_cast<const float *>(in_tensors_[index++]->data());
+  } else {
+    weight_k_ = weight_q_ + attention_hidden;
+  }
+  weight_v_ = weight_k_ + attention_hidden;
+  weight_o_ = reinterpret_cast<const float *>(in_tensors_[index++]->data());
+  bias_qkv_ = reinterpret_cast<const float *>(in_tensors_[index++]->data());
+  bias_o_ = reinterpret_cast<const float *>(in_tensors_[index++]->data());
+  mask_ = has_mask_ ? reinterpret_cast<const float *>(in_tensors_[index]->data()) : nullptr;
+  return RET_OK;
+}
+
+int AttentionCPUKernel::ReSize() {
+  auto ret = CheckInputs();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Check the inputs of Attention failed.";
+    return ret;
+  }
+  task_num_ = MSMAX(1, MSMIN(op_parameter_->thread_num_, batch_ * head_num_));
+  if (param_->max_cache_len_ > 0 && batch_ != cache_batch_) {
+    FreeCache();
+    ret = MallocCache();
+    if (ret != RET_OK) {
+      return ret;
+    }
+  }
+  return RET_OK;
+}
+
+int AttentionCPUKernel::MallocCache() {
+  auto cache_size = static_cast<size_t>(batch_) * head_num_ * param_->max_cache_len_ * head_size_ * sizeof(float);
+  key_cache_ = reinterpret_cast<float *>(ms_context_->allocator->Malloc(cache_size));
+  value_cache_ = reinterpret_cast<float *>(ms_context_->allocator->Malloc(cache_size));
+  if (key_cache_ == nullptr || value_cache_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc the key/value cache of Attention failed, size: " << cache_size;
+    FreeCache();
+    return RET_MEMORY_FAILED;
+  }
+  cache_batch_ = batch_;
+  cache_len_ = 0;
+  return RET_OK;
+}
+
+void AttentionCPUKernel::FreeCache() {
+  if (key_cache_ != nullptr) {
+    ms_context_->allocator->Free(key_cache_);
+    key_cache_ = nullptr;
+  }
+  if (value_cache_ != nullptr) {
+    ms_context_->allocator->Free(value_cache_);
+    value_cache_ = nullptr;
+  }
+  cache_batch_ = 0;
+  cache_len_ = 0;
+}
+
+int AttentionCPUKernel::MallocRunBuffers() {
+  auto attention_hidden = static_cast<size_t>(head_num_) * head_size_;
+  q_heads_ = reinterpret_cast<float *>(
+    ms_context_->allocator->Malloc(static_cast<size_t>(batch_) * q_seq_ * attention_hidden * sizeof(float)));
+  context_ = reinterpret_cast<float *>(
+    ms_context_->allocator->Malloc(static_cast<size_t>(batch_) * q_seq_ * attention_hidden * sizeof(float)));
+  auto buffer_size = static_cast<size_t>(task_num_) * FLASH_ATTENTION_BUFFER_SIZE(q_seq_) * sizeof(float);
+  attention_buffer_ = reinterpret_cast<float *>(ms_context_->allocator->Malloc(buffer_size));
+  if (q_heads_ == nullptr || context_ == nullptr || attention_buffer_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc the run buffers of Attention failed.";
+    return RET_MEMORY_FAILED;
+  }
+  if (param_->max_cache_len_ > 0) {
+    k_heads_ = key_cache_;
+    v_heads_ = value_cache_;
+    kv_head_stride_ = param_->max_cache_len_;
+    return RET_OK;
+  }
+  auto kv_size = static_cast<size_t>(batch_) * kv_seq_ * attention_hidden * sizeof(float);
+  k_heads_ = reinterpret_cast<float *>(ms_context_->allocator->Malloc(kv_size));
+  v_heads_ = reinterpret_cast<float *>(ms_context_->allocator->Malloc(kv_size));
+  if (k_heads_ == nullptr || v_heads_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc the run buffers of Attention failed.";
+    return RET_MEMORY_FAILED;
+  }
+  kv_head_stride_ = kv_seq_;
+  return RET_OK;
+}
+
+void AttentionCPUKernel::FreeRunBuffers() {
+  for (auto buffer : {&q_heads_, &context_, &attention_buffer_}) {
+    if (*buffer != nullptr) {
+      ms_context_->allocator->Free(*buffer);
+      *buffer = nullptr;
+    }
+  }
+  // The cache is kept between the runs.
+  for (auto buffer : {&k_heads_, &v_heads_}) {
+    if (*buffer != nullptr && *buffer != key_cache_ && *buffer != value_cache_) {
+      ms_context_->allocator->Free(*buffer);
+    }
+    *buffer = nullptr;
+  }
+}
+
+// Project a row of the input to all the heads, heads is [batch, head_num, seq, head_size] and row is the index of
+// the row in it.
+void AttentionCPUKernel::ProjectRow(const float *input, const float *weight, const float *bias, int weight_col,
+                                    float *heads, int row, int seq) const {
+  int batch_index = row / seq;
+  int seq_index = row % seq;
+  for (int h = 0; h < head_num_; ++h) {
+    auto head_row = heads + (static_cast<int64_t>(batch_index * head_num_ + h) * seq + seq_index) * head_size_;
+    MatVecMulNoPackFp32(input, weight + h * head_size_, head_row, bias + h * head_size_, ActType_No, hidden_,
+                        head_size_, weight_col);
+  }
+}
+
+int AttentionCPUKernel::Project(int task_id) const {
+  int q_rows = batch_ * q_seq_;
+  int total_rows = q_rows + batch_ * kv_seq_;
+  int stride = UP_DIV(total_rows, task_num_);
+  int start = task_id * stride;
+  int end = MSMIN(start + stride, total_rows);
+  auto q_input = reinterpret_cast<const float *>(in_tensors_[FIRST_INPUT]->data());
+  auto k_input = reinterpret_cast<const float *>(in_tensors_[SECOND_INPUT]->data());
+  auto v_input = reinterpret_cast<const float *>(in_tensors_[THIRD_INPUT]->data());
+  int attention_hidden = head_num_ * head_size_;
+  for (int row = start; row < end; ++row) {
+    if (row < q_rows) {
+      ProjectRow(q_input + static_cast<int64_t>(row) * hidden_, weight_q_, bias_qkv_, weight_q_col_, q_heads_, row,
+                 q_seq_);
+      continue;
+    }
+    // The new keys and values are written after the cached ones, whose rows of each head are kv_head_stride_.
+    int kv_row = row - q_rows;
+    int batch_index = kv_row / kv_seq_;
+    int head_row = batch_index * kv_head_stride_ + cache_len_ + kv_row % kv_seq_;
+    ProjectRow(k_input + static_cast<int64_t>(kv_row) * hidden_, weight_k_, bias_qkv_ + attention_hidden,
+               weight_kv_col_, k_heads_, head_row, kv_head_stride_);
+    ProjectRow(v_input + static_cast<int64_t>(kv_row) * hidden_, weight_v_, bias_qkv_ + kKVNum * attention_hidden,
+               weight_kv_col_, v_heads_, head_row, kv_head_stride_);
+  }
+  return RET_OK;
+}
+
+int AttentionCPUKernel::Attend(int task_id) const {
+  int units = batch_ * head_num_;
+  int stride = UP_DIV(units, task_num_);
+  int start = task_id * stride;
+  int end = MSMIN(start + stride, units);
+  int attention_hidden = head_num_ * head_size_;
+  FlashAttentionArgs args;
+  args.q_len_ = q_seq_;
+  args.kv_len_ = total_kv_seq_;
+  args.head_size_ = head_size_;
+  args.q_stride_ = head_size_;
+  args.kv_stride_ = head_size_;
+  args.out_stride_ = attention_hidden;
+  args.mask_stride_ = total_kv_seq_;
+  args.causal_offset_ = param_->max_cache_len_ > 0 ? cache_len_ : -1;
+  args.scale_ = 1.0f / std::sqrt(static_cast<float>(head_size_));
+  auto buffer = attention_buffer_ + static_cast<int64_t>(task_id) * FLASH_ATTENTION_BUFFER_SIZE(q_seq_);
+  for (int unit = start; unit < end; ++unit) {
+    int batch_index = unit / head_num_;
+    int head_index = unit % head_num_;
+    auto q = q_heads_ + static_cast<int64_t>(unit) * q_seq_ * head_size_;
+    auto k = k_heads_ + static_cast<int64_t>(unit) * kv_head_stride_ * head_size_;
+    auto v = v_heads_ + static_cast<int64_t>(unit) * kv_head_stride_ * head_size_;
+    auto mask = mask_ == nullptr ? nullptr : mask_ + static_cast<int64_t>(batch_index) * q_seq_ * total_kv_seq_;
+    auto out = context_ + static_cast<int64_t>(batch_index) * q_seq_ * attention_hidden + head_index * head_size_;
+    FlashAttentionHead(q, k, v, mask, out, buffer, &args);
+  }
+  return RET_OK;
+}
+
+int AttentionCPUKernel::ProjectOutput(int task_id) const {
+  int rows = batch_ * q_seq_;
+  int stride = UP_DIV(rows, task_num_);
+  int start = task_id * stride;
+  int end = MSMIN(start + stride, rows);
+  int attention_hidden = head_num_ * head_size_;
+  auto output = reinterpret_cast<float *>(out_tensors_[FIRST_INPUT]->data());
+  for (int row = start; row < end; ++row) {
+    MatVecMulNoPackFp32(context_ + static_cast<int64_t>(row) * attention_hidden, weight_o_,
+                        output + static_cast<int64_t>(row) * out_hidden_, bias_o_, ActType_No, attention_hidden,
+                        out_hidden_, out_hidden_);
+  }
+  return RET_OK;
+}
+
+// Write the projected keys and values of this run to the outputs, the key is transposed to [head_size, kv_seq].
+void AttentionCPUKernel::WriteKeyValueOutputs() const {
+  auto key_output = reinterpret_cast<float *>(out_tensors_[kKeyOutputIndex]->data());
+  auto value_output = reinterpret_cast<float *>(out_tensors_[kValueOutputIndex]->data());
+  for (int unit = 0; unit < batch_ * head_num_; ++unit) {
+    auto k = k_heads_ + (static_cast<int64_t>(unit) * kv_head_stride_ + cache_len_) * head_size_;
+    auto v = v_heads_ + (static_cast<int64_t>(unit) * kv_head_stride_ + cache_len_) * head_size_;
+    auto key = key_output + static_cast<int64_t>(unit) * head_size_ * kv_seq_;
+    auto value = value_output + static_cast<int64_t>(unit) * kv_seq_ * head_size_;
+    for (int s = 0; s < kv_seq_; ++s) {
+      for (int d = 0; d < head_size_; ++d) {
+        key[d * kv_seq_ + s] = k[s * head_size_ + d];
+      }
+    }
+    (void)memcpy(value, v, static_cast<size_t>(kv_seq_) * head_size_ * sizeof(float));
+  }
+}
+
+// The keys and values attended are the cached ones kept and the new ones, as many as the mask covers.
+int AttentionCPUKernel::UpdateCacheLen() {
+  if (!has_mask_) {
+    total_kv_seq_ = kv_seq_;
+    return RET_OK;
+  }
+  MS_CHECK_TRUE_MSG(batch_ > 0 && q_seq_ > 0, RET_ERROR, "The batch and sequence length should be positive.");
+  auto mask_size = in_tensors_.back()->ElementsNum();
+  auto mask_len = mask_size / (batch_ * q_seq_);
+  if (mask_size != batch_ * q_seq_ * mask_len || mask_len < kv_seq_) {
+    MS_LOG(ERROR) << "The mask of Attention should be [" << batch_ << ", " << q_seq_ << ", cached_len + " << kv_seq_
+                  << "], but got " << mask_size << " elements.";
+    return RET_ERROR;
+  }
+  int cached_len = mask_len - kv_seq_;
+  if (param_->max_cache_len_ == 0 ? cached_len != 0 : cached_len > cache_len_) {
+    MS_LOG(ERROR) << "The mask of Attention covers " << cached_len << " cached keys, but " << cache_len_
+                  << " are cached.";
+    return RET_ERROR;
+  }
+  if (param_->max_cache_len_ > 0 && mask_len > param_->max_cache_len_) {
+    MS_LOG(ERROR) << "The key/value cache of Attention is full, cached: " << cached_len << ", new: " << kv_seq_
+                  << ", max: " << param_->max_cache_len_;
+    return RET_ERROR;
+  }
+  cache_len_ = cached_len;
+  total_kv_seq_ = mask_len;
+  return RET_OK;
+}
+
+int AttentionCPUKernel::Run() {
+  auto ret = UpdateCacheLen();
+  if (ret != RET_OK) {
+    return ret;
+  }
+  ret = InitDataPointers();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "The data of the inputs or output of Attention is nullptr.";
+    return ret;
+  }
+  ret = MallocRunBuffers();
+  if (ret != RET_OK) {
+    FreeRunBuffers();
+    return ret;
+  }
+  ret = ParallelLaunch(this->ms_context_, AttentionProjectRun, this, task_num_);
+  if (ret == RET_OK) {
+    if (out_tensors_.size() >= kAttentionWithKeyValueOutputSize) {
+      WriteKeyValueOutputs();
+    }
+    ret = ParallelLaunch(this->ms_context_, AttentionAttendRun, this, task_num_);
+  }
+  if (ret == RET_OK) {
+    ret = ParallelLaunch(this->ms_context_, AttentionProjectOutputRun, this, task_num_);
+  }
+  FreeRunBuffers();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Attention run error, error_code[" << ret << "]";
+    return ret;
+  }
+  if (param_->max_cache_len_ > 0) {
+    cache_len_ = total_kv_seq_;
+  }
+  return RET_OK;
+}
+
+REG_KERNEL(kCPU, kNumberTypeFloat32, PrimitiveType_Attention, LiteKernelCreator<AttentionCPUKernel>)
+}  // namespace mindspore::kernel
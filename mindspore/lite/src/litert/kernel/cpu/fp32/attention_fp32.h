@@ -0,0 +1,108 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_ATTENTION_FP32_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_ATTENTION_FP32_H_
+
+#include <vector>
+#include "src/litert/lite_kernel.h"
+#include "nnacl/attention_parameter.h"
+
+namespace mindspore::kernel {
+// The multi-head attention fused by the converter.
+// inputs: 0:Q 1:K 2:V 3:WQKV 4:WO 5:BQKV 6:BO 7:MASK
+// inputs if cross: 0:Q 1:K 2:V 3:WQ 4:WKV 5:WO 6:BQKV 7:BO 8:MASK
+// outputs: 0:output, and the projected 1:key [batch, head_num, head_size, kv_seq] 2:value [batch, head_num, kv_seq,
+// head_size] if there are 3 outputs.
+// The weights are [in, out], the mask is the 0/1 keep mask of [batch, q_seq, kv_seq], it is left out if all the keys
+// are kept. If max_cache_len_ is set, the projected keys and values of the self attention are appended to the cache
+// kept by the kernel, the queries attend to the cached keys causally and the mask, which is needed then, covers them,
+// [batch, q_seq, cached_len + q_seq]. The cached length is taken from the mask, a mask of [batch, q_seq, q_seq] starts
+// a new sequence and a shorter cached length drops the keys and values after it.
+class AttentionCPUKernel : public LiteKernel {
+ public:
+  AttentionCPUKernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
+                     const std::vector<lite::Tensor *> &outputs, const lite::InnerContext *ctx)
+      : LiteKernel(parameter, inputs, outputs, ctx) {
+    param_ = reinterpret_cast<AttentionParameter *>(op_parameter_);
+  }
+  ~AttentionCPUKernel() override;
+
+  int Prepare() override;
+  int ReSize() override;
+  int Run() override;
+
+  // Drop the cached keys and values, to start decoding a new sequence.
+  void ResetCache() { cache_len_ = 0; }
+  int cache_len() const { return cache_len_; }
+
+  int Project(int task_id) const;
+  int Attend(int task_id) const;
+  int ProjectOutput(int task_id) const;
+
+ private:
+  int CheckInputs();
+  int UpdateCacheLen();
+  int InitDataPointers();
+  int MallocCache();
+  int MallocRunBuffers();
+  void FreeRunBuffers();
+  void FreeCache();
+  void ProjectRow(const float *input, const float *weight, const float *bias, int weight_col, float *heads,
+                  int row, int seq) const;
+  void WriteKeyValueOutputs() const;
+
+  AttentionParameter *param_ = nullptr;
+  int batch_ = 0;
+  int q_seq_ = 0;
+  int kv_seq_ = 0;
+  int hidden_ = 0;
+  int out_hidden_ = 0;
+  int head_num_ = 0;
+  int head_size_ = 0;
+  int task_num_ = 1;
+  // the length of the keys and values attended in this run, which includes the cached ones
+  int total_kv_seq_ = 0;
+  int cache_len_ = 0;
+  int cache_batch_ = 0;
+  bool has_mask_ = true;
+
+  const float *weight_q_ = nullptr;
+  const float *weight_k_ = nullptr;
+  const float *weight_v_ = nullptr;
+  // the number of columns of the weights of q, and of k and v
+  int weight_q_col_ = 0;
+  int weight_kv_col_ = 0;
+  const float *weight_o_ = nullptr;
+  const float *bias_qkv_ = nullptr;
+  const float *bias_o_ = nullptr;
+  const float *mask_ = nullptr;
+
+  // the projected q, k and v of [batch, head_num, seq, head_size], k and v point to the cache if it is used
+  float *q_heads_ = nullptr;
+  float *k_heads_ = nullptr;
+  float *v_heads_ = nullptr;
+  // the attention of all the heads, [batch, q_seq, head_num * head_size]
+  float *context_ = nullptr;
+  float *attention_buffer_ = nullptr;
+  float *key_cache_ = nullptr;
+  float *value_cache_ = nullptr;
+  // the row stride of k_heads_ and v_heads_ per head, it is the max cache length if the cache is used
+  int kv_head_stride_ = 0;
+};
+}  // namespace mindspore::kernel
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_ATTENTION_FP32_H_
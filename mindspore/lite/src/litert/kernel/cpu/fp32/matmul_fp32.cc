@@ -22,6 +22,7 @@
 #include "nnacl/intrinsics/ms_simd_cpu_info.h"
 #if defined(ENABLE_AVX512)
 #include "src/litert/kernel/cpu/fp32/matmul_fp32_avx512.h"
+#include "src/litert/kernel/cpu/fp32/matmul_fp32_avx512_bf16.h"
 #endif
 
 #if defined(ENABLE_AVX)
@@ -40,6 +41,10 @@
 #include "src/litert/kernel/cpu/fp32/matmul_fp32_arm64.h"
 #endif
 
+#ifdef ENABLE_SPARSE_COMPUTE
+#include "src/litert/kernel/cpu/fp32_sparse/matmul_sparse_block_fp32.h"
+#endif
+
 using mindspore::lite::kCHWDimNumber;
 using mindspore::lite::KernelRegistrar;
 using mindspore::lite::kHWDimNumber;
@@ -72,8 +77,21 @@ MatmulFp32BaseCPUKernel *CreateMatmulFp32CPUKernel(OpParameter *parameter, const
                                                    const std::vector<lite::Tensor *> &outputs,
                                                    const lite::InnerContext *ctx) {
   MatmulFp32BaseCPUKernel *kernel = nullptr;
+#ifdef ENABLE_SPARSE_COMPUTE
+  kernel = CreateMatmulSparseBlockFp32CPUKernel(parameter, inputs, outputs, ctx);
+  if (kernel != nullptr) {
+    return kernel;
+  }
+#endif
+
 #if defined(ENABLE_AVX512)
   AVX512_HARDWARE_SELF_AWARENESS_BEGIN
+  if (ctx != nullptr && ctx->IsCpuBFloat16Enabled()) {
+    kernel = new (std::nothrow) MatmulFp32AVX512BF16CPUKernel(parameter, inputs, outputs, ctx);
+    if (kernel != nullptr) {
+      return kernel;
+    }
+  }
   kernel = new (std::nothrow) MatmulFp32AVX512CPUKernel(parameter, inputs, outputs, ctx);
   if (kernel != nullptr) {
     return kernel;
@@ -0,0 +1,109 @@
+#ifdef ENABLE_AVX512
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/litert/kernel/cpu/fp32/matmul_fp32_avx512_bf16.h"
+#include "nnacl/fp32/matmul_avx512_bf16_fp32.h"
+
+namespace mindspore::kernel {
+void MatmulFp32AVX512BF16CPUKernel::InitGlobalVariable() {
+  MatmulFp32AVX512CPUKernel::InitGlobalVariable();
+  if (params_->b_const_) {
+    matrix_b_pack_fun_ = params_->b_transpose_ ? RowMajor2Col64MajorBf16Parallel : RowMajor2Row64MajorBf16Parallel;
+  }
+}
+
+bool MatmulFp32AVX512BF16CPUKernel::IsBf16PackedB() const {
+  // InitParameter replaces the packing of b for the cases which don't pack b in blocks, e.g. the col is 1.
+  return matrix_b_.need_pack && (matrix_b_pack_fun_ == RowMajor2Col64MajorBf16Parallel ||
+                                 matrix_b_pack_fun_ == RowMajor2Row64MajorBf16Parallel);
+}
+
+int MatmulFp32AVX512BF16CPUKernel::PackedMatrixBDeep() const {
+  return IsBf16PackedB() ? UP_DIV(params_->deep_, C2NUM) : params_->deep_;
+}
+
+int MatmulFp32AVX512BF16CPUKernel::ParallelRunByBatch(int task_id) const {
+  if (!IsBf16PackedB()) {
+    return MatmulFp32AVX512CPUKernel::ParallelRunByBatch(task_id);
+  }
+  int start_batch = task_id * batch_stride_;
+  int end_batch = MSMIN(params_->batch, start_batch + batch_stride_);
+  int deep_pair = PackedMatrixBDeep();
+  for (int index = start_batch; index < end_batch; ++index) {
+    const float *a = matrix_a_.pack_ptr + a_offset_[index] * params_->row_align_ * params_->deep_;
+    const float *b = matrix_b_.pack_ptr + b_offset_[index] * deep_pair * params_->col_align_;
+    float *c = output_data_ + index * params_->row_ * col_step_;
+    MatMulAvx512Bf16Fp32(a, b, c, matrix_c_.pack_ptr, params_->act_type_, params_->deep_, params_->col_, col_step_,
+                         params_->row_);
+  }
+  return RET_OK;
+}
+
+int MatmulFp32AVX512BF16CPUKernel::ParallelRunByRow(int task_id) const {
+  if (!IsBf16PackedB()) {
+    return MatmulFp32AVX512CPUKernel::ParallelRunByRow(task_id);
+  }
+  if (task_id < 0 || task_id >= thread_count_) {
+    MS_LOG(ERROR) << "task_id " << task_id << " is out of range, node is " << name_;
+    return RET_ERROR;
+  }
+  int start_row = split_points_[task_id];
+  int end_row = row_num_;
+  if (task_id < (thread_count_ - 1)) {
+    end_row = split_points_[task_id + 1];
+  }
+  int row_num = end_row - start_row;
+  if (row_num <= 0) {
+    return RET_OK;
+  }
+  const float *input = matrix_a_.pack_ptr + start_row * params_->deep_;
+  float *output = output_data_ + start_row * col_step_;
+  MatMulAvx512Bf16Fp32(input, matrix_b_.pack_ptr, output, matrix_c_.pack_ptr, params_->act_type_, params_->deep_,
+                       params_->col_, col_step_, row_num);
+  return RET_OK;
+}
+
+int MatmulFp32AVX512BF16CPUKernel::ParallelRunByOC(int task_id) const {
+  if (!IsBf16PackedB()) {
+    return MatmulFp32AVX512CPUKernel::ParallelRunByOC(task_id);
+  }
+  if (task_id < 0 || task_id >= thread_count_) {
+    MS_LOG(ERROR) << "task_id " << task_id << " is out of range, node is " << name_;
+    return RET_ERROR;
+  }
+  int start_oc = split_points_[task_id];
+  int end_oc = params_->col_;
+  if (task_id < (thread_count_ - 1)) {
+    end_oc = MSMIN(split_points_[task_id + 1], params_->col_);
+  }
+  int compute_oc = end_oc - start_oc;
+  if (compute_oc <= 0) {
+    return RET_OK;
+  }
+  // the split points are the multiples of col_min_unit_, so a thread starts at a block of b.
+  int deep_pair = PackedMatrixBDeep();
+  for (int i = 0; i < params_->batch; ++i) {
+    auto a = matrix_a_.pack_ptr + a_offset_[i] * params_->row_align_ * params_->deep_;
+    auto b = matrix_b_.pack_ptr + b_offset_[i] * deep_pair * params_->col_align_ + start_oc * deep_pair;
+    auto c = output_data_ + i * params_->row_ * col_step_ + start_oc;
+    auto bias = (matrix_c_.pack_ptr == nullptr) ? nullptr : matrix_c_.pack_ptr + start_oc;
+    MatMulAvx512Bf16Fp32(a, b, c, bias, params_->act_type_, params_->deep_, compute_oc, col_step_, params_->row_);
+  }
+  return RET_OK;
+}
+}  // namespace mindspore::kernel
+#endif
@@ -277,7 +277,7 @@ int MatmulFp32BaseCPUKernel::PackMatrixBImpl() {
       pack_b_stride_ = UP_DIV(params_->deep_, op_parameter_->thread_num_);
     }
     pack_b_src_ = src_ptr + i * params_->deep_ * params_->col_;
-    pack_b_dst_ = matrix_b_.pack_ptr + i * params_->deep_ * params_->col_align_;
+    pack_b_dst_ = matrix_b_.pack_ptr + i * PackedMatrixBDeep() * params_->col_align_;
     auto ret = ParallelLaunch(this->ms_context_, PackMatrixBRun, this, op_parameter_->thread_num_);
     if (ret != RET_OK) {
       MS_LOG(ERROR) << "MatmulRun failed in split by batch";
@@ -683,7 +683,7 @@ int MatmulFp32BaseCPUKernel::InitParameter() {
   MS_CHECK_INT_MUL_NOT_OVERFLOW(a_batch_, params_->col_align_, RET_ERROR);
   MS_CHECK_INT_MUL_NOT_OVERFLOW(a_batch_ * params_->col_align_, params_->deep_, RET_ERROR);
   auto a_pack_size = a_batch_ * params_->row_align_ * params_->deep_;
-  auto b_pack_size = b_batch_ * params_->col_align_ * params_->deep_;
+  auto b_pack_size = b_batch_ * params_->col_align_ * PackedMatrixBDeep();
   if ((matrix_a_.has_packed && matrix_a_.pack_size != a_pack_size) ||
       (matrix_b_.has_packed && matrix_b_.pack_size != b_pack_size)) {
     MS_LOG(ERROR) << "matmul don't support dynamic packing if matrix is a constant.";
@@ -78,10 +78,12 @@ class MatmulFp32BaseCPUKernel : public LiteKernel {
   int PackMatrixA();
   int PackMatrixB();
   int PackMatrixAImpl();
-  int PackMatrixBImpl();
+  virtual int PackMatrixBImpl();
   virtual int PackMatrixAImplOpt();
   bool CheckRow1OptimalConditions();
   virtual bool SupportMulBatchCuttingByRow() { return false; }
+  // the deep of a packed b, in words of float, which is less than deep when b is packed to a narrower type.
+  virtual int PackedMatrixBDeep() const { return params_->deep_; }
   int PackBiasMatrix();
   void FreePackedMatrixA();
   void FreePackedMatrixB();
@@ -0,0 +1,169 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/litert/kernel/cpu/fp32_sparse/matmul_sparse_block_fp32.h"
+#include <algorithm>
+#include "src/litert/kernel_registry.h"
+#include "nnacl/fp32/pack_fp32.h"
+
+using mindspore::schema::PrimitiveType_FullConnection;
+using mindspore::schema::PrimitiveType_MatMulFusion;
+
+namespace mindspore::kernel {
+namespace {
+// The bounds are measured against the dense kernels. The 4x4 blocks take a tile of 32 rows (or a single row) in the
+// vector lanes, the other few rows are run one by one, so they need a sparser b.
+constexpr float kSparse4x4MaxDensity = 0.3f;
+constexpr float kSparse4x4FewRowMaxDensity = 0.2f;
+constexpr int kSparse4x4MinTileRow = 16;
+// The 2:4 halves the read of b but not the fma, so it only wins when the read of b bounds the run.
+constexpr int kSparse2x4MaxRow = 4;
+
+// the row of a when its shape is known when the kernel is created, otherwise -1.
+int GetRowOfMatrixA(const OpParameter *parameter, const lite::Tensor *a, int deep) {
+  auto a_shape = a->shape();
+  if (a_shape.size() < C2NUM || std::any_of(a_shape.begin(), a_shape.end(), [](int dim) { return dim <= 0; })) {
+    return -1;
+  }
+  if (parameter->type_ == PrimitiveType_FullConnection) {
+    auto element_num = a->ElementsNum();
+    return element_num % deep == 0 ? static_cast<int>(element_num / deep) : -1;
+  }
+  auto a_transpose = reinterpret_cast<const MatMulParameter *>(parameter)->a_transpose_;
+  return a_transpose ? a_shape.back() : a_shape[a_shape.size() - C2NUM];
+}
+}  // namespace
+
+void MatmulSparseBlockFp32CPUKernel::InitGlobalVariable() {
+  matrix_b_.need_pack = true;
+  matrix_b_pack_fun_ = nullptr;
+  out_need_aligned_ = false;
+  if (format_ == SparseBlock_4x4) {
+    matrix_a_.need_pack = true;
+    matrix_a_pack_fun_ = params_->a_transpose_ ? RowMajor2Row32MajorParallel : RowMajor2Col32MajorParallel;
+    row_tile_ = C8NUM;
+    col_tile_ = C4NUM;
+    col_min_unit_ = C4NUM;
+  } else {
+    matrix_a_.need_pack = params_->a_transpose_;
+    matrix_a_pack_fun_ = params_->a_transpose_ ? RowMajor2ColMajorParallel : RowMajor2RowMajorParallel;
+    row_tile_ = 1;
+    col_tile_ = C16NUM;
+    col_min_unit_ = C16NUM;
+  }
+}
+
+int MatmulSparseBlockFp32CPUKernel::PackedMatrixBDeep() const {
+  return params_->col_align_ > 0 ? UP_DIV(packed_b_size_, params_->col_align_) : params_->deep_;
+}
+
+int MatmulSparseBlockFp32CPUKernel::PackMatrixBImpl() {
+  auto src_ptr =
+    matrix_b_.has_origin ? matrix_b_.origin_ptr : reinterpret_cast<float *>(in_tensors_[SECOND_INPUT]->data());
+  MS_CHECK_TRUE_MSG(src_ptr != nullptr, RET_ERROR, "matrix-b source ptr is a nullptr.");
+  MS_CHECK_TRUE_MSG(matrix_b_.pack_ptr != nullptr, RET_ERROR, "matrix-b pack ptr is a nullptr.");
+  SparseBlockPack(format_, src_ptr, matrix_b_.pack_ptr, params_->deep_, params_->col_, params_->b_transpose_);
+  return RET_OK;
+}
+
+void MatmulSparseBlockFp32CPUKernel::RunSparse(const float *a, const float *bias, float *c, int start_oc,
+                                               int end_oc) const {
+  // bias and c are indexed by the column itself.
+  if (format_ == SparseBlock_4x4) {
+    MatMulSparse4x4Fp32(a, matrix_b_.pack_ptr, bias, c, params_->act_type_, params_->deep_, params_->row_,
+                        params_->col_, col_step_, 0, params_->row_, start_oc / C4NUM, UP_DIV(end_oc, C4NUM));
+  } else {
+    MatMulSparse2x4Fp32(a, matrix_b_.pack_ptr, bias, c, params_->act_type_, params_->deep_, params_->row_, col_step_,
+                        start_oc, end_oc);
+  }
+}
+
+int MatmulSparseBlockFp32CPUKernel::ParallelRunByBatch(int task_id) const {
+  int start_batch = task_id * batch_stride_;
+  int end_batch = MSMIN(params_->batch, start_batch + batch_stride_);
+  for (int index = start_batch; index < end_batch; ++index) {
+    const float *a = matrix_a_.pack_ptr + a_offset_[index] * params_->row_align_ * params_->deep_;
+    float *c = output_data_ + index * params_->row_ * col_step_;
+    RunSparse(a, matrix_c_.pack_ptr, c, 0, params_->col_);
+  }
+  return RET_OK;
+}
+
+int MatmulSparseBlockFp32CPUKernel::ParallelRunByOC(int task_id) const {
+  if (task_id < 0 || task_id >= thread_count_) {
+    MS_LOG(ERROR) << "task_id " << task_id << " is out of range, node is " << name_;
+    return RET_ERROR;
+  }
+  // the split points are the multiples of col_min_unit_, so a thread starts at a block of b.
+  int start_oc = split_points_[task_id];
+  int end_oc = params_->col_;
+  if (task_id < (thread_count_ - 1)) {
+    end_oc = MSMIN(split_points_[task_id + 1], params_->col_);
+  }
+  if (end_oc <= start_oc) {
+    return RET_OK;
+  }
+  for (int i = 0; i < params_->batch; ++i) {
+    const float *a = matrix_a_.pack_ptr + a_offset_[i] * params_->row_align_ * params_->deep_;
+    float *c = output_data_ + i * params_->row_ * col_step_;
+    RunSparse(a, matrix_c_.pack_ptr, c, start_oc, end_oc);
+  }
+  return RET_OK;
+}
+
+MatmulFp32BaseCPUKernel *CreateMatmulSparseBlockFp32CPUKernel(OpParameter *parameter,
+                                                              const std::vector<lite::Tensor *> &inputs,
+                                                              const std::vector<lite::Tensor *> &outputs,
+                                                              const lite::InnerContext *ctx) {
+  if (parameter == nullptr || parameter->is_train_session_ || inputs.size() < C2NUM) {
+    return nullptr;
+  }
+  if (parameter->type_ != PrimitiveType_MatMulFusion && parameter->type_ != PrimitiveType_FullConnection) {
+    return nullptr;
+  }
+  auto weight = inputs[SECOND_INPUT];
+  if (weight == nullptr || !weight->IsConst() || weight->data() == nullptr ||
+      weight->data_type() != kNumberTypeFloat32 || weight->shape().size() != C2NUM) {
+    return nullptr;
+  }
+  // the full-connection always takes b as [col, deep].
+  bool b_transpose = parameter->type_ == PrimitiveType_FullConnection ||
+                     reinterpret_cast<const MatMulParameter *>(parameter)->b_transpose_;
+  int deep = b_transpose ? weight->shape()[1] : weight->shape()[0];
+  int col = b_transpose ? weight->shape()[0] : weight->shape()[1];
+  if (deep <= 0 || deep % C4NUM != 0 || col <= 1 || inputs[FIRST_INPUT] == nullptr) {
+    return nullptr;
+  }
+  int row = GetRowOfMatrixA(parameter, inputs[FIRST_INPUT], deep);
+  if (row <= 0) {
+    return nullptr;
+  }
+  auto b = reinterpret_cast<const float *>(weight->data());
+  SparseBlockFormat format = SparseBlock_None;
+  float max_density = (row == 1 || row >= kSparse4x4MinTileRow) ? kSparse4x4MaxDensity : kSparse4x4FewRowMaxDensity;
+  if (SparseBlock4x4Density(b, deep, col, b_transpose) <= max_density) {
+    format = SparseBlock_4x4;
+  } else if (row <= kSparse2x4MaxRow && IsSparse2x4(b, deep, col, b_transpose)) {
+    format = SparseBlock_2x4;
+  } else {
+    return nullptr;
+  }
+  int packed_b_size = SparseBlockPackSize(format, b, deep, col, b_transpose);
+  MS_LOG(INFO) << "matmul runs the sparse b of format " << format << ", deep " << deep << ", col " << col;
+  return new (std::nothrow)
+    MatmulSparseBlockFp32CPUKernel(parameter, inputs, outputs, ctx, format, packed_b_size);
+}
+}  // namespace mindspore::kernel
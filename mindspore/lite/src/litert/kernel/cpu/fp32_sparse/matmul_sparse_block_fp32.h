@@ -0,0 +1,54 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_SPARSE_MATMUL_SPARSE_BLOCK_FP32_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_SPARSE_MATMUL_SPARSE_BLOCK_FP32_H_
+
+#include <vector>
+#include "src/litert/kernel/cpu/fp32/matmul_fp32_base.h"
+#include "nnacl/fp32_sparse/matmul_sparse_block_fp32.h"
+
+namespace mindspore::kernel {
+// The constant b which is 4x4 block sparse or 2:4 sparse is encoded once when it is packed, and only its non-zero
+// values are read and multiplied in every run. The format is chosen from the weight itself when the kernel is created.
+class MatmulSparseBlockFp32CPUKernel : public MatmulFp32BaseCPUKernel {
+ public:
+  MatmulSparseBlockFp32CPUKernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
+                                 const std::vector<lite::Tensor *> &outputs, const mindspore::lite::InnerContext *ctx,
+                                 SparseBlockFormat format, int packed_b_size)
+      : MatmulFp32BaseCPUKernel(parameter, inputs, outputs, ctx), format_(format), packed_b_size_(packed_b_size) {}
+  ~MatmulSparseBlockFp32CPUKernel() = default;
+
+  void InitGlobalVariable() override;
+  int ParallelRunByBatch(int task_id) const override;
+  int ParallelRunByOC(int task_id) const override;
+
+ private:
+  int PackMatrixBImpl() override;
+  int PackedMatrixBDeep() const override;
+  void RunSparse(const float *a, const float *bias, float *c, int start_oc, int end_oc) const;
+
+  SparseBlockFormat format_ = SparseBlock_None;
+  int packed_b_size_ = 0;
+};
+
+// Returns nullptr when b is not constant or not sparse enough to beat the dense kernel, so the caller keeps the dense.
+MatmulFp32BaseCPUKernel *CreateMatmulSparseBlockFp32CPUKernel(OpParameter *parameter,
+                                                              const std::vector<lite::Tensor *> &inputs,
+                                                              const std::vector<lite::Tensor *> &outputs,
+                                                              const lite::InnerContext *ctx);
+}  // namespace mindspore::kernel
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_SPARSE_MATMUL_SPARSE_BLOCK_FP32_H_
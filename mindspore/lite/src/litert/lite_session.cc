@@ -557,6 +557,7 @@ int LiteSession::CompileGraph(Model *model) {
   }
   InitGraphInputTensors(model);
   InitGraphOutputTensors(model);
+  context_->enable_bfloat16_ = IsBFloat16Enabled();
 
   // scheduler kernels
   Scheduler scheduler(context_.get(), ms_context_, model, &tensors_, &inputs_, &outputs_, is_train_session_,
@@ -1660,6 +1661,49 @@ const char *lite::LiteSession::LoadModelByPath(const std::string &file, mindspor
   return lite_buf;
 }
 
+const char *lite::LiteSession::LoadModelByMmap(const std::string &file, mindspore::ModelType model_type, size_t *size) {
+  size_t buf_size = 0;
+  auto model_buf = lite::ReadFileByMmap(file.c_str(), &buf_size);
+  if (model_buf == nullptr) {
+    return nullptr;
+  }
+  // The other kinds of models are converted into new buffers, so mapping the file does not help them.
+  if (model_type != mindspore::ModelType::kMindIR_Lite) {
+    flatbuffers::Verifier verify((const uint8_t *)model_buf, buf_size, INT32_MAX, INT32_MAX);
+    if (lite::LiteModel::VersionVerify(&verify) == SCHEMA_INVALID) {
+      MS_LOG(INFO) << "The model " << file << " is not a mslite model, which can not be loaded by mmap.";
+      lite::UnmapFileBuffer(model_buf, buf_size);
+      return nullptr;
+    }
+  }
+  *size = buf_size;
+  return model_buf;
+}
+
+bool lite::LiteSession::IsLoadModelByMmap() {
+  if (config_info_ == nullptr) {
+    return false;
+  }
+  auto model_file = config_info_->find(kModelFile);
+  if (model_file == config_info_->end()) {
+    return false;
+  }
+  auto load_by_mmap = model_file->second.find(kLoadByMmap);
+  return load_by_mmap != model_file->second.end() && load_by_mmap->second == "true";
+}
+
+bool lite::LiteSession::IsBFloat16Enabled() {
+  if (config_info_ == nullptr) {
+    return false;
+  }
+  auto cpu_context = config_info_->find(kCPUContext);
+  if (cpu_context == config_info_->end()) {
+    return false;
+  }
+  auto enable_bf16 = cpu_context->second.find(kEnableBFloat16);
+  return enable_bf16 != cpu_context->second.end() && enable_bf16->second == "true";
+}
+
 std::string lite::LiteSession::ParseWeightPath() {
   std::string weight_path = "";
   if (config_info_ != nullptr) {
@@ -1724,7 +1768,17 @@ int lite::LiteSession::LoadModelAndCompileByBuf(const char *model_buf, mindspore
 
 int lite::LiteSession::LoadModelAndCompileByPath(const std::string &model_path, mindspore::ModelType model_type) {
   size_t model_size;
-  auto model_buf = LoadModelByPath(model_path, model_type, &model_size);
+  // The mapped model is verified and used in place, the const tensors alias the mapping and the pages are shared with
+  // other processes loading the same file.
+  bool by_mmap = IsLoadModelByMmap();
+  const char *model_buf = nullptr;
+  if (by_mmap) {
+    model_buf = LoadModelByMmap(model_path, model_type, &model_size);
+    by_mmap = (model_buf != nullptr);
+  }
+  if (model_buf == nullptr) {
+    model_buf = LoadModelByPath(model_path, model_type, &model_size);
+  }
   if (model_buf == nullptr) {
     MS_LOG(ERROR) << "Read model file failed";
     return RET_ERROR;
@@ -1742,18 +1796,30 @@ int lite::LiteSession::LoadModelAndCompileByPath(const std::string &model_path,
     return RET_ERROR;
   }
   if (is_shared_weight_) {
-    delete[] model_buf;
+    if (by_mmap) {
+      lite::UnmapFileBuffer(const_cast<char *>(model_buf), model_size);
+      by_mmap = false;
+    } else {
+      delete[] model_buf;
+    }
     model_buf = nullptr;
   }
   auto *model = lite::ImportFromBuffer(new_model_buf, model_size, true, model_type, model_path);
   if (model == nullptr) {
     MS_LOG(ERROR) << "Import model failed";
+    if (by_mmap) {
+      lite::UnmapFileBuffer(const_cast<char *>(model_buf), model_size);
+    }
     return RET_ERROR;
   }
   (reinterpret_cast<lite::LiteModel *>(model))->set_keep_model_buf(true);
+  (reinterpret_cast<lite::LiteModel *>(model))->set_model_buf_by_mmap(by_mmap);
   auto ret = CompileGraph(model);
   if (ret != lite::RET_OK) {
     MS_LOG(ERROR) << "Compile model failed";
+    if (by_mmap) {
+      lite::UnmapFileBuffer(model->buf, model_size);
+    }
     model->buf = nullptr;
     delete model;
     return RET_ERROR;
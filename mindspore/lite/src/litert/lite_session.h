@@ -60,6 +60,9 @@ class LiteSession {
   mindspore::ModelType LoadModelByBuff(const char *model_buf, const size_t &buf_size, char **lite_buf, size_t *size,
                                        mindspore::ModelType model_type);
   const char *LoadModelByPath(const std::string &file, mindspore::ModelType model_type, size_t *size);
+  // Map the model file instead of reading it, return nullptr if the file can not be mapped or is not a mslite model
+  // which can be used in place. The buffer returned must be released by UnmapFileBuffer.
+  const char *LoadModelByMmap(const std::string &file, mindspore::ModelType model_type, size_t *size);
   virtual int Init(const std::shared_ptr<InnerContext> &context);
   virtual void BindThread(bool if_bind);
   virtual int CompileGraph(Model *model);
@@ -153,6 +156,8 @@ class LiteSession {
     const std::unordered_map<Tensor *, Tensor *> &isolate_input_map = std::unordered_map<Tensor *, Tensor *>());
   static void FreePackOpWeight(const std::vector<kernel::KernelExec *> &kernels);
   std::string ParseWeightPath();
+  bool IsLoadModelByMmap();
+  bool IsBFloat16Enabled();
 
  private:
   int PreCheck(Model *model);
@@ -0,0 +1,334 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/common_test.h"
+#include "src/common/utils.h"
+#include "nnacl/int8/matmul_int8.h"
+#include "nnacl/int8/fixed_point.h"
+#include "nnacl/int8/conv_depthwise_int8.h"
+#ifdef ENABLE_AVX
+#include "nnacl/int8/matmul_avx_int8.h"
+#endif
+#ifdef ENABLE_AVX512
+#include "nnacl/int8/matmul_avx512_vnni_int8.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#include "nnacl/fp32/matmul_avx512_fp32.h"
+#include "nnacl/fp32/pack_fp32.h"
+#endif
+
+namespace mindspore {
+namespace {
+constexpr int kInt8Min = -128;
+constexpr int kInt8Max = 127;
+
+using MatmulInt8OptFunc = void (*)(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16,
+                                   const int32_t *a_sums, const int32_t *bias, int act_min, int act_max, int out_zp,
+                                   const int32_t *multiplier, const int32_t *left_shift, const int32_t *right_shift,
+                                   size_t stride, size_t filter_peroc, const int32_t *filter_zp);
+}  // namespace
+
+class MatmulInt8AvxTest : public mindspore::CommonTest {
+ public:
+  MatmulInt8AvxTest() {
+#ifdef ENABLE_AVX512
+    (void)IntelX86CpuInfoInit();
+#endif
+  }
+
+  // a is [row, deep], b is [col, deep], the weights of the matmul int8 kernel are transposed as b.
+  void InitMatmul(int row, int col, int deep, bool filter_peroc) {
+    row_ = row;
+    col_ = col;
+    deep16_ = UP_ROUND(deep, C16NUM);
+    filter_peroc_ = filter_peroc;
+    std::mt19937 gen(row * col + deep);
+    std::uniform_int_distribution<int> int8_dist(kInt8Min, kInt8Max);
+    a_.resize(row * deep);
+    b_.resize(col * deep);
+    for (auto &value : a_) {
+      value = static_cast<int8_t>(int8_dist(gen));
+    }
+    for (auto &value : b_) {
+      value = static_cast<int8_t>(int8_dist(gen));
+    }
+    pack_a_.assign(UP_ROUND(row, C4NUM) * deep16_, 0);
+    pack_b_.assign(UP_ROUND(col, C4NUM) * deep16_, 0);
+    RowMajor2Row16x4MajorInt8(a_.data(), pack_a_.data(), row, deep);
+    RowMajor2Row16x4MajorInt8(b_.data(), pack_b_.data(), col, deep);
+
+    int quant_num = filter_peroc ? col : 1;
+    std::uniform_int_distribution<int> multiplier_dist(1 << 30, INT32_MAX);
+    std::uniform_int_distribution<int> shift_dist(10, 13);
+    std::uniform_int_distribution<int> zp_dist(-10, 10);
+    multiplier_.resize(quant_num);
+    left_shift_.resize(quant_num);
+    right_shift_.resize(quant_num);
+    filter_zp_.resize(quant_num);
+    for (int i = 0; i < quant_num; ++i) {
+      multiplier_[i] = multiplier_dist(gen);
+      left_shift_[i] = i % C2NUM;
+      right_shift_[i] = -shift_dist(gen);
+      filter_zp_[i] = zp_dist(gen);
+    }
+    bias_.resize(col);
+    std::uniform_int_distribution<int> bias_dist(-5000, 5000);
+    for (auto &value : bias_) {
+      value = bias_dist(gen);
+    }
+    // perT: input_row_sum * filter_zp, perOc: input_row_sum
+    a_sums_.resize(row);
+    CalcInputSums(a_.data(), row, deep, filter_peroc ? 1 : filter_zp_[0], a_sums_.data(), RowMajor);
+
+    expect_.resize(row * col);
+    for (int r = 0; r < row; ++r) {
+      for (int c = 0; c < col; ++c) {
+        int32_t value = 0;
+        for (int d = 0; d < deep; ++d) {
+          value += a_[r * deep + d] * b_[c * deep + d];
+        }
+        int q = filter_peroc ? c : 0;
+        value -= filter_peroc ? a_sums_[r] * filter_zp_[c] : a_sums_[r];
+        value += bias_[c];
+        value = MultiplyByQuantizedMultiplier(value, multiplier_[q], left_shift_[q], right_shift_[q]) + out_zp_;
+        expect_[r * col + c] = static_cast<int8_t>(MSMAX(act_min_, MSMIN(act_max_, value)));
+      }
+    }
+  }
+
+  void RunMatmul(MatmulInt8OptFunc func, std::vector<int8_t> *out) {
+    out->assign(row_ * col_, 0);
+    func(pack_a_.data(), pack_b_.data(), out->data(), row_, col_, deep16_, a_sums_.data(), bias_.data(), act_min_,
+         act_max_, out_zp_, multiplier_.data(), left_shift_.data(), right_shift_.data(), col_, filter_peroc_,
+         filter_zp_.data());
+  }
+
+  void CheckMatmul(MatmulInt8OptFunc func) {
+    std::vector<int8_t> out;
+    RunMatmul(func, &out);
+    ASSERT_EQ(0, CompareOutputData(out.data(), expect_.data(), row_ * col_, 0));
+  }
+
+  int row_ = 0;
+  int col_ = 0;
+  int deep16_ = 0;
+  bool filter_peroc_ = false;
+  int act_min_ = kInt8Min;
+  int act_max_ = kInt8Max;
+  int out_zp_ = 3;
+  std::vector<int8_t> a_;
+  std::vector<int8_t> b_;
+  std::vector<int8_t> pack_a_;
+  std::vector<int8_t> pack_b_;
+  std::vector<int32_t> a_sums_;
+  std::vector<int32_t> bias_;
+  std::vector<int32_t> multiplier_;
+  std::vector<int32_t> left_shift_;
+  std::vector<int32_t> right_shift_;
+  std::vector<int32_t> filter_zp_;
+  std::vector<int8_t> expect_;
+};
+
+/// Feature: the matmul int8 kernel of nnacl, which the int8 matmul and the 1x1 int8 convolution run.
+/// Description: the per tensor and per channel quantized matmuls of odd shapes, compared with the reference.
+/// Expectation: the outputs are the same as the reference, for the dispatched kernel and every x86 kernel.
+TEST_F(MatmulInt8AvxTest, MatmulInt8Opt) {
+  const std::vector<std::vector<int>> shapes = {{1, 1, 1},    {13, 37, 50}, {4, 16, 16},
+                                                {30, 5, 100}, {7, 64, 33},  {64, 256, 512}};
+  for (auto &shape : shapes) {
+    for (bool filter_peroc : {false, true}) {
+      InitMatmul(shape[0], shape[1], shape[2], filter_peroc);
+      CheckMatmul(MatmulInt8Opt);
+#ifdef ENABLE_AVX
+      CheckMatmul(MatmulInt8OptAvx);
+#endif
+#ifdef ENABLE_AVX512
+      if (X86_Avx512Vnni_Support()) {
+        CheckMatmul(MatmulInt8OptAvx512Vnni);
+      }
+#endif
+    }
+  }
+}
+
+/// Feature: the activation clamp of the matmul int8 kernel.
+/// Description: the relu6 range of the output.
+/// Expectation: the outputs are the same as the reference.
+TEST_F(MatmulInt8AvxTest, MatmulInt8OptActivation) {
+  act_min_ = out_zp_;
+  act_max_ = out_zp_ + 60;
+  InitMatmul(9, 21, 70, true);
+  CheckMatmul(MatmulInt8Opt);
+}
+
+/// Feature: the depthwise int8 convolution of nnacl.
+/// Description: a 3x3 depthwise convolution with padding, stride 2 and per channel quantization.
+/// Expectation: the output is the same as the reference.
+TEST_F(MatmulInt8AvxTest, ConvDwInt8) {
+  constexpr int kBatch = 2;
+  constexpr int kInH = 9;
+  constexpr int kInW = 11;
+  constexpr int kChannel = 21;
+  constexpr int kKernel = 3;
+  constexpr int kStride = 2;
+  constexpr int kPad = 1;
+  constexpr int kOutH = (kInH + 2 * kPad - kKernel) / kStride + 1;
+  constexpr int kOutW = (kInW + 2 * kPad - kKernel) / kStride + 1;
+  constexpr int kInputZp = -3;
+  constexpr int kOutputZp = 5;
+
+  std::mt19937 gen(kChannel);
+  std::uniform_int_distribution<int> int8_dist(kInt8Min, kInt8Max);
+  std::vector<int8_t> input(kBatch * kInH * kInW * kChannel);
+  for (auto &value : input) {
+    value = static_cast<int8_t>(int8_dist(gen));
+  }
+  // the weights of [kh, kw, channel] are already subtracted by the filter zp
+  std::vector<int16_t> weight(kKernel * kKernel * kChannel);
+  for (auto &value : weight) {
+    value = static_cast<int16_t>(int8_dist(gen));
+  }
+  std::vector<int32_t> bias(kChannel);
+  std::vector<int32_t> multiplier(kChannel);
+  std::vector<int32_t> left_shift(kChannel);
+  std::vector<int32_t> right_shift(kChannel);
+  std::uniform_int_distribution<int> multiplier_dist(1 << 30, INT32_MAX);
+  for (int c = 0; c < kChannel; ++c) {
+    bias[c] = c * 100 - 1000;
+    multiplier[c] = multiplier_dist(gen);
+    left_shift[c] = c % C2NUM;
+    right_shift[c] = -(8 + c % C4NUM);
+  }
+
+  QuantArg input_arg = {0.1f, kInputZp};
+  QuantArg output_arg = {0.1f, kOutputZp};
+  int32_t act_min = kInt8Min;
+  int32_t act_max = kInt8Max;
+  ConvParameter conv_param = {};
+  conv_param.input_batch_ = kBatch;
+  conv_param.input_h_ = kInH;
+  conv_param.input_w_ = kInW;
+  conv_param.input_channel_ = kChannel;
+  conv_param.output_batch_ = kBatch;
+  conv_param.output_h_ = kOutH;
+  conv_param.output_w_ = kOutW;
+  conv_param.output_channel_ = kChannel;
+  conv_param.kernel_h_ = kKernel;
+  conv_param.kernel_w_ = kKernel;
+  conv_param.stride_h_ = kStride;
+  conv_param.stride_w_ = kStride;
+  conv_param.dilation_h_ = 1;
+  conv_param.dilation_w_ = 1;
+  conv_param.pad_u_ = kPad;
+  conv_param.pad_l_ = kPad;
+  conv_param.thread_num_ = 1;
+  conv_param.conv_quant_arg_.input_quant_args_ = &input_arg;
+  conv_param.conv_quant_arg_.output_quant_args_ = &output_arg;
+  conv_param.conv_quant_arg_.quant_multiplier_ = multiplier.data();
+  conv_param.conv_quant_arg_.left_shift_ = left_shift.data();
+  conv_param.conv_quant_arg_.right_shift_ = right_shift.data();
+  conv_param.conv_quant_arg_.out_act_min_ = &act_min;
+  conv_param.conv_quant_arg_.out_act_max_ = &act_max;
+  conv_param.conv_quant_arg_.per_channel_ = FILTER_PER_CHANNEL;
+
+  std::vector<int8_t> expect(kBatch * kOutH * kOutW * kChannel);
+  for (int b = 0; b < kBatch; ++b) {
+    for (int oh = 0; oh < kOutH; ++oh) {
+      for (int ow = 0; ow < kOutW; ++ow) {
+        for (int c = 0; c < kChannel; ++c) {
+          int32_t value = bias[c];
+          for (int kh = 0; kh < kKernel; ++kh) {
+            for (int kw = 0; kw < kKernel; ++kw) {
+              int ih = oh * kStride - kPad + kh;
+              int iw = ow * kStride - kPad + kw;
+              if (ih < 0 || ih >= kInH || iw < 0 || iw >= kInW) {
+                continue;
+              }
+              int in = input[((b * kInH + ih) * kInW + iw) * kChannel + c] - kInputZp;
+              value += in * weight[(kh * kKernel + kw) * kChannel + c];
+            }
+          }
+          value = MultiplyByQuantizedMultiplier(value, multiplier[c], left_shift[c], right_shift[c]) + kOutputZp;
+          expect[((b * kOutH + oh) * kOutW + ow) * kChannel + c] =
+            static_cast<int8_t>(MSMAX(act_min, MSMIN(act_max, value)));
+        }
+      }
+    }
+  }
+
+  std::vector<int8_t> output(expect.size(), 0);
+  std::vector<int32_t> row_buffer(kOutW * kChannel);
+  ConvDwInt8(output.data(), row_buffer.data(), input.data(), weight.data(), bias.data(), &conv_param, 0);
+  ASSERT_EQ(0, CompareOutputData(output.data(), expect.data(), expect.size(), 0));
+}
+
+#ifdef ENABLE_AVX512
+/// Feature: the x86 matmul int8 kernels.
+/// Description: the cost of the matmul int8 kernels and of the fp32 avx512 kernel of the same shapes, it is a
+/// benchmark run by --gtest_also_run_disabled_tests --gtest_filter=MatmulInt8AvxTest.DISABLED_MatmulInt8Performance.
+/// Expectation: the outputs of the int8 kernels are the same as the reference, the costs are printed.
+TEST_F(MatmulInt8AvxTest, DISABLED_MatmulInt8Performance) {
+  constexpr int kLoop = 100;
+  const std::vector<std::vector<int>> shapes = {{64, 256, 512}, {16, 512, 1024}};
+  for (auto &shape : shapes) {
+    int row = shape[0];
+    int col = shape[1];
+    int deep = shape[2];
+    InitMatmul(row, col, deep, true);
+    std::vector<std::pair<std::string, MatmulInt8OptFunc>> funcs = {{"avx2", MatmulInt8OptAvx}};
+    if (X86_Avx512Vnni_Support()) {
+      funcs.emplace_back("avx512 vnni", MatmulInt8OptAvx512Vnni);
+    }
+    std::vector<int8_t> out;
+    for (auto &func : funcs) {
+      RunMatmul(func.second, &out);
+      ASSERT_EQ(0, CompareOutputData(out.data(), expect_.data(), row * col, 0));
+      auto start_time = lite::GetTimeUs();
+      for (int i = 0; i < kLoop; i++) {
+        RunMatmul(func.second, &out);
+      }
+      auto time_dur = lite::GetTimeUs() - start_time;
+      std::cout << "Matmul int8 " << func.first << " of " << row << "x" << col << "x" << deep
+                << ", cost: " << (static_cast<float>(time_dur) / kLoop) << "us" << std::endl;
+    }
+
+    // the fp32 b is [deep, col], packed to the col64 blocks of the avx512 kernel
+    std::vector<float> a_fp32(a_.begin(), a_.end());
+    std::vector<float> b_fp32(deep * col);
+    for (int d = 0; d < deep; ++d) {
+      for (int c = 0; c < col; ++c) {
+        b_fp32[d * col + c] = b_[c * deep + d];
+      }
+    }
+    std::vector<float> pack_b_fp32(deep * col);
+    RowMajor2Row64Major(b_fp32.data(), pack_b_fp32.data(), deep, col);
+    std::vector<float> bias_fp32(col, 0.0f);
+    std::vector<float> out_fp32(row * col);
+    auto start_time = lite::GetTimeUs();
+    for (int i = 0; i < kLoop; i++) {
+      MatMulAvx512Fp32(a_fp32.data(), pack_b_fp32.data(), out_fp32.data(), bias_fp32.data(), ActType_No, deep, col,
+                       col, row);
+    }
+    auto time_dur = lite::GetTimeUs() - start_time;
+    std::cout << "Matmul fp32 avx512 of " << row << "x" << col << "x" << deep
+              << ", cost: " << (static_cast<float>(time_dur) / kLoop) << "us" << std::endl;
+  }
+}
+#endif
+}  // namespace mindspore
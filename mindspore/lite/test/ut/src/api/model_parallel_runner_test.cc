@@ -15,8 +15,11 @@
  */
 #include "include/api/model_parallel_runner.h"
 #include <memory>
+#include <thread>
+#include <vector>
 #include "common/common_test.h"
 #include "src/common/file_utils.h"
+#include "src/extendrt/cxx_api/model_pool/model_pool.h"
 
 namespace mindspore {
 namespace {
@@ -240,4 +243,72 @@ TEST_F(ModelParallelRunnerTest, RunnerInitByBuf) {
     tensor.SetData(nullptr);
   }
 }
+
+TEST_F(ModelParallelRunnerTest, RunnerPredictWithDynamicBatch) {
+  // the output of one request without batching
+  ModelParallelRunner runner;
+  ASSERT_EQ(runner.Init(model_path), kSuccess);
+  auto expect_inputs = runner.GetInputs();
+  SetInputTensorData(&expect_inputs);
+  std::vector<MSTensor> expect_outputs;
+  ASSERT_EQ(runner.Predict(expect_inputs, &expect_outputs), kSuccess);
+  ASSERT_EQ(expect_outputs.size(), 1);
+  ASSERT_EQ(expect_outputs.front().DataSize(), kOutputDataSize);
+  auto expect_data = static_cast<const float *>(expect_outputs.front().Data().get());
+  ASSERT_NE(expect_data, nullptr);
+
+  auto config = std::make_shared<RunnerConfig>();
+  ASSERT_NE(nullptr, config);
+  auto context = std::make_shared<Context>();
+  ASSERT_NE(nullptr, context);
+  auto &device_list = context->MutableDeviceInfo();
+  auto device_info = std::make_shared<mindspore::CPUDeviceInfo>();
+  ASSERT_NE(nullptr, device_info);
+  device_list.push_back(device_info);
+  ASSERT_EQ(device_list.size(), 1);
+  config->SetContext(context);
+  config->SetWorkersNum(2);
+  // a long queue delay, so that the concurrent requests are merged into full batches
+  config->SetConfigInfo("dynamic_batch", {{"max_batch_size", "4"}, {"max_queue_delay_us", "100000"}});
+  ModelPool model_pool;
+  ASSERT_EQ(model_pool.InitByPath(model_path, config), kSuccess);
+
+  constexpr int kThreadNum = 8;
+  constexpr int kPredictTimes = 4;
+  constexpr float kErrorBound = 1e-4;
+  std::vector<std::thread> threads;
+  std::vector<Status> results(kThreadNum, kSuccess);
+  for (int i = 0; i < kThreadNum; i++) {
+    threads.emplace_back([&model_pool, &results, expect_data, i]() {
+      for (int j = 0; j < kPredictTimes; j++) {
+        auto inputs = model_pool.GetInputs();
+        SetInputTensorData(&inputs);
+        std::vector<MSTensor> outputs;
+        auto ret = model_pool.Predict(inputs, &outputs);
+        if (ret != kSuccess || outputs.size() != 1 || outputs.front().DataSize() != kOutputDataSize ||
+            CommonTest::CompareOutputData(static_cast<const float *>(outputs.front().Data().get()), expect_data,
+                                          kOutputDataSize / sizeof(float), kErrorBound) != 0) {
+          results[i] = kLiteError;
+        }
+        for (auto &tensor : inputs) {
+          char *data = static_cast<char *>(tensor.MutableData());
+          delete[] data;
+          tensor.SetData(nullptr);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (auto &result : results) {
+    ASSERT_EQ(result, kSuccess);
+  }
+  ASSERT_GT(model_pool.GetBatchNum(), 0);
+  for (auto &tensor : expect_inputs) {
+    char *data = static_cast<char *>(tensor.MutableData());
+    delete[] data;
+    tensor.SetData(nullptr);
+  }
+}
 }  // namespace mindspore
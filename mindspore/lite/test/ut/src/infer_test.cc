@@ -15,13 +15,19 @@
  */
 
 #include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
 #include <memory>
+#include <string>
+#include <vector>
 #include "schema/inner/model_generated.h"
 #include "common/common_test.h"
 #include "include/errorcode.h"
 #include "src/common/log_adapter.h"
 #include "src/litert/lite_session.h"
 #include "src/common/file_utils.h"
+#include "src/common/common.h"
 
 namespace mindspore {
 class InferTest : public mindspore::CommonTest {
@@ -29,6 +35,21 @@ class InferTest : public mindspore::CommonTest {
   InferTest() {}
 };
 
+namespace {
+// Whether the file is mapped into the memory of this process.
+bool IsFileMapped(const std::string &file) {
+  auto real_path = lite::RealPath(file.c_str());
+  std::ifstream maps("/proc/self/maps");
+  std::string line;
+  while (std::getline(maps, line)) {
+    if (line.find(real_path) != std::string::npos) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
 TEST_F(InferTest, TestConvNode) {
   auto meta_graph = std::make_shared<schema::MetaGraphT>();
   meta_graph->name = "graph";
@@ -248,4 +269,95 @@ TEST_F(InferTest, TestModel) {
   MS_LOG(INFO) << "Passed";
 }
 
+/// Feature: load the model file by mmap.
+/// Description: load an add model with a const weight by mmap, run it and release the session.
+/// Expectation: the output is computed with the weight in the mapped file, and the file is unmapped on release.
+TEST_F(InferTest, TestModelLoadByMmap) {
+  constexpr int kElementNum = 16;
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_AddFusion;
+  node->primitive->value.value = new schema::AddFusionT;
+  node->name = "Add";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {2};
+
+  auto input = std::make_unique<schema::TensorT>();
+  input->nodeType = lite::NodeType_Parameter;
+  input->format = schema::Format_NHWC;
+  input->dataType = TypeId::kNumberTypeFloat32;
+  input->dims = {1, kElementNum};
+  input->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(input));
+
+  auto weight = std::make_unique<schema::TensorT>();
+  weight->nodeType = lite::NodeType_ValueNode;
+  weight->format = schema::Format_NHWC;
+  weight->dataType = TypeId::kNumberTypeFloat32;
+  weight->dims = {1, kElementNum};
+  weight->offset = -1;
+  std::vector<float> weight_data(kElementNum);
+  for (int i = 0; i < kElementNum; ++i) {
+    weight_data[i] = static_cast<float>(i) * 0.5f;
+  }
+  weight->data.resize(kElementNum * sizeof(float));
+  memcpy(weight->data.data(), weight_data.data(), weight->data.size());
+  meta_graph->allTensors.emplace_back(std::move(weight));
+
+  auto output = std::make_unique<schema::TensorT>();
+  output->nodeType = lite::NodeType_Parameter;
+  output->format = schema::Format_NHWC;
+  output->dataType = TypeId::kNumberTypeFloat32;
+  output->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(output));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  schema::FinishMetaGraphBuffer(builder, offset);
+  const std::string model_file = "./test_model_load_by_mmap.ms";
+  {
+    std::ofstream ofs(model_file, std::ios::binary | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs.write(reinterpret_cast<const char *>(builder.GetBufferPointer()), builder.GetSize());
+  }
+
+  auto context = std::make_shared<lite::InnerContext>();
+  context->device_list_[0].device_info_.cpu_device_info_.cpu_bind_mode_ = lite::NO_BIND;
+  context->thread_num_ = 1;
+  ASSERT_EQ(lite::RET_OK, context->Init());
+  auto session = lite::LiteSession::CreateSession(context);
+  ASSERT_NE(nullptr, session);
+  std::map<std::string, std::map<std::string, std::string>> config_info = {
+    {lite::kModelFile, {{lite::kLoadByMmap, "true"}}}};
+  session->SetConfigInfo(&config_info);
+  ASSERT_EQ(lite::RET_OK, session->LoadModelAndCompileByPath(model_file, mindspore::ModelType::kMindIR_Lite));
+  EXPECT_TRUE(IsFileMapped(model_file));
+
+  auto inputs = session->GetInputs();
+  ASSERT_EQ(inputs.size(), 1);
+  auto in_data = reinterpret_cast<float *>(inputs.front()->MutableData());
+  ASSERT_NE(nullptr, in_data);
+  for (int i = 0; i < kElementNum; ++i) {
+    in_data[i] = 1.0f;
+  }
+  ASSERT_EQ(lite::RET_OK, session->RunGraph());
+  auto outputs = session->GetOutputs();
+  ASSERT_EQ(outputs.size(), 1);
+  auto out_tensor = outputs.begin()->second;
+  ASSERT_EQ(kElementNum, out_tensor->ElementsNum());
+  auto out_data = reinterpret_cast<float *>(out_tensor->MutableData());
+  for (int i = 0; i < kElementNum; ++i) {
+    EXPECT_EQ(out_data[i], 1.0f + weight_data[i]);
+  }
+
+  delete session;
+  EXPECT_FALSE(IsFileMapped(model_file));
+  (void)remove(model_file.c_str());
+}
+
 }  // namespace mindspore
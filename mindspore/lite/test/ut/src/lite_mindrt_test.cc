@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 // #include <sys/time.h>
+#include <atomic>
+#include <vector>
 #include "actor/actor.h"
 #include "actor/op_actor.h"
 #include "async/uuid_base.h"
@@ -158,4 +160,54 @@ TEST_F(LiteMindRtTest, ActorThreadPoolTest) {
   }
 }
 
+class CountActor : public ActorBase {
+ public:
+  CountActor(const std::string &nm, ActorThreadPool *pool, std::vector<std::atomic<int>> *counts)
+      : ActorBase(nm, pool), counts_(counts) {}
+  int Count(size_t task_id) {
+    (void)counts_->at(task_id).fetch_add(1);
+    return 0;
+  }
+
+ private:
+  std::vector<std::atomic<int>> *counts_;
+};
+
+TEST_F(LiteMindRtTest, ActorWorkStealingTest) {
+  Initialize("", "", "", "", 4);
+  ActorThreadPool::set_actor_work_stealing(true);
+  // a single actor thread has no local queue, the others steal from each other.
+  for (size_t thread_num : {1, 4}) {
+    auto pool = ActorThreadPool::CreateThreadPool(thread_num);
+    ASSERT_NE(pool, nullptr);
+    size_t actor_num = 16;
+    size_t task_num = 200;
+    std::vector<std::atomic<int>> counts(actor_num * task_num);
+    std::vector<AID> actors;
+    for (size_t i = 0; i < actor_num; i++) {
+      auto name = "steal_" + std::to_string(thread_num) + "_" + std::to_string(i);
+      actors.emplace_back(Spawn(ActorReference(new CountActor(name, pool, &counts))));
+    }
+    std::vector<Future<int>> fv;
+    for (size_t i = 0; i < task_num; i++) {
+      for (size_t a = 0; a < actor_num; a++) {
+        fv.emplace_back(Async(actors[a], &CountActor::Count, a * task_num + i));
+      }
+    }
+    for (auto &f : fv) {
+      ASSERT_EQ(f.Get(), 0);
+    }
+    for (auto &count : counts) {
+      ASSERT_EQ(count.load(), 1);
+    }
+    for (auto &aid : actors) {
+      Terminate(aid);
+      Await(aid);
+    }
+    delete pool;
+  }
+  ActorThreadPool::set_actor_work_stealing(false);
+  Finalize();
+}
+
 }  // namespace mindspore
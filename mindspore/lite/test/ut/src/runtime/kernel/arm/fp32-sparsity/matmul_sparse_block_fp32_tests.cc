@@ -0,0 +1,105 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/fp32/pack_fp32.h"
+#include "nnacl/fp32_sparse/matmul_sparse_block_fp32.h"
+
+namespace mindspore {
+class TestSparseBlockFp32 : public mindspore::CommonTest {
+ public:
+  TestSparseBlockFp32() = default;
+
+ protected:
+  void GenerateData(SparseBlockFormat format) {
+    input_.resize(row_ * deep_);
+    filter_.assign(deep_ * col_, 0.0f);
+    bias_.assign(UP_ROUND(col_, C16NUM), 0.0f);
+    for (int i = 0; i < row_ * deep_; ++i) {
+      input_[i] = static_cast<float>(i % 7) - 3.0f;
+    }
+    for (int j = 0; j < col_; ++j) {
+      bias_[j] = static_cast<float>(j % 5);
+    }
+    for (int k = 0; k < deep_; ++k) {
+      for (int j = 0; j < col_; ++j) {
+        bool keep = format == SparseBlock_4x4 ? (k / C4NUM + j / C4NUM) % 3 == 0 : (k + j) % C4NUM < C2NUM;
+        filter_[k * col_ + j] = keep ? static_cast<float>((k * col_ + j) % 9) - 4.0f : 0.0f;
+      }
+    }
+    correct_.resize(row_ * col_);
+    for (int r = 0; r < row_; ++r) {
+      for (int j = 0; j < col_; ++j) {
+        float value = bias_[j];
+        for (int k = 0; k < deep_; ++k) {
+          value += input_[r * deep_ + k] * filter_[k * col_ + j];
+        }
+        correct_[r * col_ + j] = MSMAX(value, 0.0f);
+      }
+    }
+  }
+
+  std::vector<float> PackFilter(SparseBlockFormat format) {
+    std::vector<float> packed(SparseBlockPackSize(format, filter_.data(), deep_, col_, false));
+    SparseBlockPack(format, filter_.data(), packed.data(), deep_, col_, false);
+    return packed;
+  }
+
+  int row_ = 37;
+  int col_ = 45;
+  int deep_ = 24;
+  std::vector<float> input_;
+  std::vector<float> filter_;
+  std::vector<float> bias_;
+  std::vector<float> correct_;
+};
+
+TEST_F(TestSparseBlockFp32, Block4x4) {
+  GenerateData(SparseBlock_4x4);
+  ASSERT_LE(SparseBlock4x4Density(filter_.data(), deep_, col_, false), 0.4f);
+  auto packed = PackFilter(SparseBlock_4x4);
+  std::vector<float> input_pack(UP_ROUND(row_, C8NUM) * deep_);
+  RowMajor2Col32Major(input_.data(), input_pack.data(), row_, deep_);
+  std::vector<float> output(row_ * col_);
+  int col_block = UP_DIV(col_, C4NUM);
+  // the rows are split at a tile of 32, the columns at a block of 4, as the threads do.
+  MatMulSparse4x4Fp32(input_pack.data(), packed.data(), bias_.data(), output.data(), ActType_Relu, deep_, row_, col_,
+                      col_, 0, C32NUM, 0, C4NUM);
+  MatMulSparse4x4Fp32(input_pack.data(), packed.data(), bias_.data(), output.data(), ActType_Relu, deep_, row_, col_,
+                      col_, 0, C32NUM, C4NUM, col_block);
+  MatMulSparse4x4Fp32(input_pack.data(), packed.data(), bias_.data(), output.data(), ActType_Relu, deep_, row_, col_,
+                      col_, C32NUM, row_, 0, col_block);
+  ASSERT_EQ(0, CompareOutputData(output.data(), correct_.data(), row_ * col_, 0.0001));
+
+  // a single row is not packed.
+  MatMulSparse4x4Fp32(input_.data(), packed.data(), bias_.data(), output.data(), ActType_Relu, deep_, 1, col_, col_, 0,
+                      1, 0, col_block);
+  ASSERT_EQ(0, CompareOutputData(output.data(), correct_.data(), col_, 0.0001));
+}
+
+TEST_F(TestSparseBlockFp32, Sparse2x4) {
+  GenerateData(SparseBlock_2x4);
+  ASSERT_TRUE(IsSparse2x4(filter_.data(), deep_, col_, false));
+  auto packed = PackFilter(SparseBlock_2x4);
+  std::vector<float> output(row_ * col_);
+  MatMulSparse2x4Fp32(input_.data(), packed.data(), bias_.data(), output.data(), ActType_Relu, deep_, row_, col_, 0,
+                      C16NUM);
+  MatMulSparse2x4Fp32(input_.data(), packed.data(), bias_.data(), output.data(), ActType_Relu, deep_, row_, col_,
+                      C16NUM, col_);
+  ASSERT_EQ(0, CompareOutputData(output.data(), correct_.data(), row_ * col_, 0.0001));
+}
+}  // namespace mindspore
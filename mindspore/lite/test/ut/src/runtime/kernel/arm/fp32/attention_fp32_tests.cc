@@ -0,0 +1,335 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/attention_parameter.h"
+#include "mindspore/lite/src/litert/kernel_registry.h"
+#include "mindspore/lite/src/litert/kernel/cpu/fp32/attention_fp32.h"
+
+namespace mindspore {
+namespace {
+constexpr int kHeadNum = 2;
+constexpr int kHeadSize = 8;
+constexpr int kHidden = kHeadNum * kHeadSize;
+
+struct AttentionWeights {
+  std::vector<float> weight_qkv;
+  std::vector<float> weight_o;
+  std::vector<float> bias_qkv;
+  std::vector<float> bias_o;
+};
+
+std::vector<float> RandomData(size_t size, std::mt19937 *gen) {
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> data(size);
+  for (auto &value : data) {
+    value = dist(*gen);
+  }
+  return data;
+}
+
+// The attention computed step by step, x is [batch, seq, hidden] and mask is [batch, seq, seq].
+std::vector<float> ReferenceAttention(const std::vector<float> &x, const std::vector<float> &mask,
+                                      const AttentionWeights &w, int batch, int seq, bool causal) {
+  const int qkv_hidden = 3 * kHidden;
+  std::vector<float> qkv(batch * seq * qkv_hidden);
+  for (int r = 0; r < batch * seq; ++r) {
+    for (int c = 0; c < qkv_hidden; ++c) {
+      float sum = w.bias_qkv[c];
+      for (int k = 0; k < kHidden; ++k) {
+        sum += x[r * kHidden + k] * w.weight_qkv[k * qkv_hidden + c];
+      }
+      qkv[r * qkv_hidden + c] = sum;
+    }
+  }
+  std::vector<float> context(batch * seq * kHidden);
+  std::vector<float> logits(seq);
+  for (int b = 0; b < batch; ++b) {
+    for (int h = 0; h < kHeadNum; ++h) {
+      for (int i = 0; i < seq; ++i) {
+        const float *q = qkv.data() + (b * seq + i) * qkv_hidden + h * kHeadSize;
+        int kv_len = causal ? i + 1 : seq;
+        float max = -1e30f;
+        for (int j = 0; j < kv_len; ++j) {
+          const float *k = qkv.data() + (b * seq + j) * qkv_hidden + kHidden + h * kHeadSize;
+          float dot = 0;
+          for (int d = 0; d < kHeadSize; ++d) {
+            dot += q[d] * k[d];
+          }
+          logits[j] = dot / std::sqrt(static_cast<float>(kHeadSize)) +
+                      (1.0f - mask[(b * seq + i) * seq + j]) * -10000.0f;
+          max = std::max(max, logits[j]);
+        }
+        float sum = 0;
+        for (int j = 0; j < kv_len; ++j) {
+          logits[j] = std::exp(logits[j] - max);
+          sum += logits[j];
+        }
+        float *out = context.data() + (b * seq + i) * kHidden + h * kHeadSize;
+        for (int j = 0; j < kv_len; ++j) {
+          const float *v = qkv.data() + (b * seq + j) * qkv_hidden + 2 * kHidden + h * kHeadSize;
+          for (int d = 0; d < kHeadSize; ++d) {
+            out[d] += logits[j] / sum * v[d];
+          }
+        }
+      }
+    }
+  }
+  std::vector<float> output(batch * seq * kHidden);
+  for (int r = 0; r < batch * seq; ++r) {
+    for (int c = 0; c < kHidden; ++c) {
+      float sum = w.bias_o[c];
+      for (int k = 0; k < kHidden; ++k) {
+        sum += context[r * kHidden + k] * w.weight_o[k * kHidden + c];
+      }
+      output[r * kHidden + c] = sum;
+    }
+  }
+  return output;
+}
+}  // namespace
+
+class TestAttentionFp32 : public mindspore::CommonTest {
+ public:
+  TestAttentionFp32() = default;
+
+  void SetUp() override {
+    std::mt19937 gen(1);
+    weights_.weight_qkv = RandomData(kHidden * 3 * kHidden, &gen);
+    weights_.weight_o = RandomData(kHidden * kHidden, &gen);
+    weights_.bias_qkv = RandomData(3 * kHidden, &gen);
+    weights_.bias_o = RandomData(kHidden, &gen);
+    weight_qkv_.set_data(weights_.weight_qkv.data());
+    weight_o_.set_data(weights_.weight_o.data());
+    bias_qkv_.set_data(weights_.bias_qkv.data());
+    bias_o_.set_data(weights_.bias_o.data());
+    ctx_ = std::make_shared<lite::InnerContext>();
+    ctx_->thread_num_ = 2;
+    ASSERT_EQ(lite::RET_OK, ctx_->Init());
+  }
+
+  void TearDown() override {
+    delete kernel_;
+    for (auto tensor : {&input_, &weight_qkv_, &weight_o_, &bias_qkv_, &bias_o_, &mask_, &output_, &key_, &value_}) {
+      tensor->set_data(nullptr);
+    }
+  }
+
+  void CreateKernel(int max_cache_len, bool with_key_value, bool with_mask = true) {
+    auto param = reinterpret_cast<AttentionParameter *>(malloc(sizeof(AttentionParameter)));
+    ASSERT_NE(param, nullptr);
+    memset(param, 0, sizeof(AttentionParameter));
+    param->op_parameter_.thread_num_ = ctx_->thread_num_;
+    param->head_num_ = kHeadNum;
+    param->head_size_ = kHeadSize;
+    param->max_cache_len_ = max_cache_len;
+    std::vector<lite::Tensor *> inputs = {&input_, &input_, &input_, &weight_qkv_, &weight_o_, &bias_qkv_, &bias_o_};
+    if (with_mask) {
+      inputs.push_back(&mask_);
+    }
+    std::vector<lite::Tensor *> outputs = {&output_};
+    if (with_key_value) {
+      outputs.push_back(&key_);
+      outputs.push_back(&value_);
+    }
+    kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, NHWC, schema::PrimitiveType_Attention};
+    auto creator = lite::KernelRegistry::GetInstance()->GetCreator(desc);
+    ASSERT_NE(creator, nullptr);
+    kernel_ = creator(inputs, outputs, reinterpret_cast<OpParameter *>(param), ctx_.get(), desc);
+    ASSERT_NE(kernel_, nullptr);
+  }
+
+  // Run the self attention with the cache on the rows [start, start + q_seq) of x of [batch, total_len, hidden], the
+  // mask covers cached_len keys before them. The output is compared with the rows of expect.
+  void RunStep(const std::vector<float> &x, const std::vector<float> &expect, int batch, int total_len, int start,
+               int q_seq, int cached_len) {
+    std::vector<float> step_x(batch * q_seq * kHidden);
+    for (int b = 0; b < batch; ++b) {
+      memcpy(step_x.data() + b * q_seq * kHidden, x.data() + (b * total_len + start) * kHidden,
+             q_seq * kHidden * sizeof(float));
+    }
+    std::vector<float> mask(batch * q_seq * (cached_len + q_seq), 1.0f);
+    std::vector<float> output(batch * q_seq * kHidden);
+    input_.set_data(step_x.data());
+    mask_.set_data(mask.data());
+    output_.set_data(output.data());
+    SetShape(batch, q_seq, cached_len + q_seq);
+    ASSERT_EQ(lite::RET_OK, kernel_->ReSize());
+    ASSERT_EQ(lite::RET_OK, kernel_->Run());
+    for (int b = 0; b < batch; ++b) {
+      ASSERT_EQ(0, CompareOutputData(output.data() + b * q_seq * kHidden,
+                                     expect.data() + (b * total_len + start) * kHidden, q_seq * kHidden, 1e-4));
+    }
+  }
+
+  void SetShape(int batch, int q_seq, int kv_seq) {
+    input_.set_shape({batch, q_seq, kHidden});
+    mask_.set_shape({batch, q_seq, kv_seq});
+    output_.set_shape({batch, q_seq, kHidden});
+    key_.set_shape({batch, kHeadNum, kHeadSize, q_seq});
+    value_.set_shape({batch, kHeadNum, q_seq, kHeadSize});
+  }
+
+ protected:
+  AttentionWeights weights_;
+  lite::Tensor input_{kNumberTypeFloat32, {}};
+  lite::Tensor weight_qkv_{kNumberTypeFloat32, {kHidden, 3 * kHidden}};
+  lite::Tensor weight_o_{kNumberTypeFloat32, {kHidden, kHidden}};
+  lite::Tensor bias_qkv_{kNumberTypeFloat32, {3 * kHidden}};
+  lite::Tensor bias_o_{kNumberTypeFloat32, {kHidden}};
+  lite::Tensor mask_{kNumberTypeFloat32, {}};
+  lite::Tensor output_{kNumberTypeFloat32, {}};
+  lite::Tensor key_{kNumberTypeFloat32, {}};
+  lite::Tensor value_{kNumberTypeFloat32, {}};
+  std::shared_ptr<lite::InnerContext> ctx_;
+  kernel::LiteKernel *kernel_ = nullptr;
+};
+
+/// Feature: fused multi-head attention of lite.
+/// Description: run the self attention with a mask over a sequence longer than a key/value tile of the flash attention.
+/// Expectation: the output is the same as the attention computed step by step, and the key and value are output.
+TEST_F(TestAttentionFp32, SelfAttention) {
+  const int batch = 2;
+  const int seq = 70;
+  std::mt19937 gen(2);
+  auto x = RandomData(batch * seq * kHidden, &gen);
+  std::vector<float> mask(batch * seq * seq, 1.0f);
+  for (int i = 0; i < seq; ++i) {
+    // The last keys of the second batch are padding.
+    for (int j = seq - 10; j < seq; ++j) {
+      mask[(seq + i) * seq + j] = 0.0f;
+    }
+  }
+  std::vector<float> output(batch * seq * kHidden);
+  std::vector<float> key(batch * seq * kHidden);
+  std::vector<float> value(batch * seq * kHidden);
+  input_.set_data(x.data());
+  mask_.set_data(mask.data());
+  output_.set_data(output.data());
+  key_.set_data(key.data());
+  value_.set_data(value.data());
+  SetShape(batch, seq, seq);
+  CreateKernel(0, true);
+  ASSERT_EQ(lite::RET_OK, kernel_->Prepare());
+  ASSERT_EQ(lite::RET_OK, kernel_->Run());
+
+  auto expect = ReferenceAttention(x, mask, weights_, batch, seq, false);
+  ASSERT_EQ(0, CompareOutputData(output.data(), expect.data(), batch * seq * kHidden, 1e-4));
+  // The key of the second head of the first batch at the third position.
+  const int head = 1;
+  const int pos = 2;
+  for (int d = 0; d < kHeadSize; ++d) {
+    float expect_key = weights_.bias_qkv[kHidden + head * kHeadSize + d];
+    for (int k = 0; k < kHidden; ++k) {
+      expect_key += x[pos * kHidden + k] * weights_.weight_qkv[k * 3 * kHidden + kHidden + head * kHeadSize + d];
+    }
+    EXPECT_NEAR(key[(head * kHeadSize + d) * seq + pos], expect_key, 1e-4);
+  }
+}
+
+/// Feature: fused multi-head attention of lite.
+/// Description: run the self attention fused without a mask, which has 7 inputs.
+/// Expectation: all the keys are attended, the output is the same as the attention with a mask of all ones.
+TEST_F(TestAttentionFp32, SelfAttentionWithoutMask) {
+  const int batch = 2;
+  const int seq = 9;
+  std::mt19937 gen(4);
+  auto x = RandomData(batch * seq * kHidden, &gen);
+  std::vector<float> mask(batch * seq * seq, 1.0f);
+  std::vector<float> output(batch * seq * kHidden);
+  input_.set_data(x.data());
+  output_.set_data(output.data());
+  SetShape(batch, seq, seq);
+  CreateKernel(0, false, false);
+  ASSERT_EQ(lite::RET_OK, kernel_->Prepare());
+  ASSERT_EQ(lite::RET_OK, kernel_->Run());
+
+  auto expect = ReferenceAttention(x, mask, weights_, batch, seq, false);
+  ASSERT_EQ(0, CompareOutputData(output.data(), expect.data(), batch * seq * kHidden, 1e-4));
+}
+
+/// Feature: fused multi-head attention of lite.
+/// Description: feed the inputs of the T5 attention, which has the position bias and the mask where the biases are,
+/// the same number of inputs as the attention without the mask.
+/// Expectation: the position bias is not taken as the biases, the T5 attention is not supported.
+TEST_F(TestAttentionFp32, T5AttentionNotSupported) {
+  const int batch = 2;
+  const int seq = 9;
+  std::vector<float> x(batch * seq * kHidden, 1.0f);
+  std::vector<float> position_bias(kHeadNum * seq * seq, 0.0f);
+  std::vector<float> mask(batch * seq * seq, 1.0f);
+  std::vector<float> output(batch * seq * kHidden);
+  input_.set_data(x.data());
+  output_.set_data(output.data());
+  SetShape(batch, seq, seq);
+  bias_qkv_.set_data(position_bias.data());
+  bias_qkv_.set_shape({1, kHeadNum, seq, seq});
+  bias_o_.set_data(mask.data());
+  bias_o_.set_shape({batch, 1, seq, seq});
+  CreateKernel(0, false, false);
+  EXPECT_EQ(lite::RET_NOT_SUPPORT, kernel_->Prepare());
+}
+
+/// Feature: key/value cache of the fused multi-head attention of lite.
+/// Description: run a prompt, then decode the tokens one by one with the key/value cache, and run out of the cache.
+/// Then start a new sequence, and decode a token again after dropping the last cached one.
+/// Expectation: the output of each run is the same as the causal attention of the whole sequence, the run fails when
+/// the cache is full, and the cached length follows the mask afterwards.
+TEST_F(TestAttentionFp32, KeyValueCache) {
+  const int batch = 2;
+  const int prompt_len = 5;
+  const int decode_len = 3;
+  const int total_len = prompt_len + decode_len;
+  std::mt19937 gen(3);
+  auto x = RandomData(batch * total_len * kHidden, &gen);
+  std::vector<float> full_mask(batch * total_len * total_len, 1.0f);
+  auto expect = ReferenceAttention(x, full_mask, weights_, batch, total_len, true);
+
+  CreateKernel(total_len, false);
+  SetShape(batch, prompt_len, prompt_len);
+  ASSERT_EQ(lite::RET_OK, kernel_->Prepare());
+  auto kernel = static_cast<kernel::AttentionCPUKernel *>(kernel_);
+  RunStep(x, expect, batch, total_len, 0, prompt_len, 0);
+  for (int start = prompt_len; start < total_len; ++start) {
+    RunStep(x, expect, batch, total_len, start, 1, start);
+  }
+  EXPECT_EQ(kernel->cache_len(), total_len);
+
+  std::vector<float> step_x(batch * kHidden);
+  std::vector<float> mask(batch * (total_len + 1), 1.0f);
+  std::vector<float> output(batch * kHidden);
+  input_.set_data(step_x.data());
+  mask_.set_data(mask.data());
+  output_.set_data(output.data());
+  SetShape(batch, 1, total_len + 1);
+  ASSERT_EQ(lite::RET_OK, kernel_->ReSize());
+  EXPECT_NE(lite::RET_OK, kernel_->Run());
+
+  // The mask of the prompt alone starts a new sequence.
+  RunStep(x, expect, batch, total_len, 0, prompt_len, 0);
+  EXPECT_EQ(kernel->cache_len(), prompt_len);
+  // Decode the last token of the prompt again in place of the cached one.
+  RunStep(x, expect, batch, total_len, prompt_len - 1, 1, prompt_len - 1);
+  EXPECT_EQ(kernel->cache_len(), prompt_len);
+  RunStep(x, expect, batch, total_len, prompt_len, 1, prompt_len);
+  EXPECT_EQ(kernel->cache_len(), prompt_len + 1);
+}
+}  // namespace mindspore
@@ -19,9 +19,11 @@
 #include "mindspore/lite/src/litert/kernel/cpu/fp32/matmul_fp32.h"
 #include "nnacl/fp32/pack_fp32.h"
 #include "nnacl/fp32/matmul_fp32.h"
+#include "nnacl/fp32/matmul_avx512_mask_fp32.h"
 #include "src/litert/kernel_registry.h"
 #include "src/litert/kernel_exec.h"
 #include "src/litert/tensor_category.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
 
 namespace mindspore {
 class TestMatMulFp32 : public mindspore::CommonTest {
@@ -303,6 +305,104 @@ TEST_F(TestMatMulFp32, simple_transb) {
   for (auto t : outputs_) delete t;
 }
 
+#ifdef ENABLE_AVX512
+TEST_F(TestMatMulFp32, simple_transb_bf16) {
+  if (IntelX86CpuInfoInit() != NNACL_OK || !X86_Avx512_Support()) {
+    return;
+  }
+  std::vector<lite::Tensor *> inputs_;
+  std::vector<lite::Tensor *> outputs_;
+  auto matmul_param = new MatMulParameter();
+  matmul_param->a_transpose_ = false;
+  matmul_param->b_transpose_ = true;
+  matmul_param->has_bias_ = false;
+  float a[] = {-3.2366564, -4.7733846, -7.8329225, 16.146885, 5.060793,  -6.1471,  -1.7680453, -6.5721383,
+               17.87506,   -5.1192183, 10.742863,  1.4536934, 19.693445, 19.45783, 5.063163,   0.5234792};
+  float b[] = {-0.0024438887, 0.0006738146, -0.008169129, 0.0021510671,  -0.012470592,   -0.0053063435,
+               0.006050155,   0.008656233,  0.012911413,  -0.0028635843, -0.00034080597, -0.0010622552,
+               -0.012254699,  -0.01312836,  0.0025241964, -0.004706142,  0.002451482,    -0.009558459,
+               0.004481974,   0.0033251503, -0.011705584, -0.001720293,  -0.0039410214,  -0.0073637343};
+  std::vector<int> a_shape = {1, 2, 8};
+  std::vector<int> b_shape = {1, 3, 8};
+  std::vector<int> c_shape = {1, 2, 3};
+  int total_size = MMTestInit(&inputs_, &outputs_, a, b, a_shape, b_shape, c_shape);
+  auto ctx = new lite::InnerContext;
+  ctx->thread_num_ = 2;
+  ASSERT_EQ(lite::RET_OK, ctx->Init());
+  ASSERT_FALSE(ctx->IsCpuBFloat16Enabled());
+  // the bfloat16 weights are only taken when asked for, enable_float16_ of the cpu does not turn them on
+  ctx->device_list_[0].device_info_.cpu_device_info_.enable_float16_ = true;
+  ASSERT_FALSE(ctx->IsCpuBFloat16Enabled());
+  ctx->enable_bfloat16_ = true;
+  ASSERT_TRUE(ctx->IsCpuBFloat16Enabled());
+  auto mm = new kernel::MatmulCPUKernel(reinterpret_cast<OpParameter *>(matmul_param), inputs_, outputs_, ctx);
+  mm->Prepare();
+  mm->Run();
+  // the weight is rounded to bfloat16, 8 bits of mantissa
+  float correct[] = {0.00533547, 0.002545945, 0.062974121, -0.445441471, -0.246223617, -0.142070031};
+  ASSERT_EQ(0, CompareOutputData(reinterpret_cast<float *>(outputs_[0]->MutableData()), correct, total_size, 0.001));
+  delete mm;
+  delete ctx;
+  for (auto t : inputs_) delete t;
+  for (auto t : outputs_) delete t;
+}
+
+TEST_F(TestMatMulFp32, skinny_mask_avx512) {
+  if (IntelX86CpuInfoInit() != NNACL_OK || !X86_Avx512_Support()) {
+    return;
+  }
+  // the rows of fewer than 8 accumulators run the kernels which split the depth, the odd col takes the mask. The cols
+  // end in each of the 16, 32, 48 and 64 tiles, full or masked, and the depth above 1500 is run in several blocks.
+  std::vector<int> deeps = {37, 1531};
+  std::vector<int> cols = {13, 16, 29, 32, 45, 48, 61, 64, 77, 125};
+  std::vector<int> act_types = {ActType_Relu6, ActType_Relu, ActType_No};
+  for (int deep : deeps) {
+    for (int col : cols) {
+      std::vector<float> b(deep * col);
+      std::vector<float> bias(UP_ROUND(col, C64NUM), 0.0f);
+      for (int i = 0; i < deep * col; ++i) {
+        b[i] = static_cast<float>(i % 11) * 0.1f - 0.5f;
+      }
+      for (int j = 0; j < col; ++j) {
+        bias[j] = static_cast<float>(j % 3);
+      }
+      std::vector<float> b_pack(UP_ROUND(col, C64NUM) * deep, 0.0f);
+      RowMajor2Row64Major(b.data(), b_pack.data(), deep, col);
+      for (int act_type : act_types) {
+        // the bias is left out with no activation
+        const float *bias_data = act_type == ActType_No ? nullptr : bias.data();
+        for (int row = 1; row <= C8NUM; ++row) {
+          std::vector<float> a(row * deep);
+          for (int i = 0; i < row * deep; ++i) {
+            a[i] = (static_cast<float>(i % 7) - 3.0f) * 0.1f;
+          }
+          std::vector<float> correct(row * col);
+          for (int r = 0; r < row; ++r) {
+            for (int j = 0; j < col; ++j) {
+              float value = bias_data == nullptr ? 0.0f : bias_data[j];
+              for (int k = 0; k < deep; ++k) {
+                value += a[r * deep + k] * b[k * col + j];
+              }
+              if (act_type != ActType_No) {
+                value = MSMAX(value, 0.0f);
+              }
+              correct[r * col + j] = act_type == ActType_Relu6 ? MSMIN(value, 6.0f) : value;
+            }
+          }
+          std::vector<float> out(row * col);
+          if (row == 1) {
+            MatVecMulMaskAvx512Fp32(a.data(), b_pack.data(), out.data(), bias_data, act_type, deep, col, col);
+          } else {
+            MatMulMaskAvx512Fp32(a.data(), b_pack.data(), out.data(), bias_data, act_type, deep, col, col, row);
+          }
+          ASSERT_EQ(0, CompareOutputData(out.data(), correct.data(), row * col, 0.0001));
+        }
+      }
+    }
+  }
+}
+#endif
+
 TEST_F(TestMatMulFp32, batch) {
   std::vector<lite::Tensor *> inputs_;
   std::vector<lite::Tensor *> outputs_;
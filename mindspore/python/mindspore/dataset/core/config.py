@@ -48,6 +48,9 @@ __all__ = ['set_sending_batches', 'load', '_init_device_info',
            'set_fast_recovery', 'get_fast_recovery',
            'set_debug_mode', 'get_debug_mode',
            'set_error_samples_mode', 'get_error_samples_mode', 'ErrorSamplesMode',
+           'set_map_preserve_order', 'get_map_preserve_order',
+           'set_mindrecord_io_depth', 'get_mindrecord_io_depth',
+           'set_jpeg_scaled_decode', 'get_jpeg_scaled_decode',
            'set_multiprocessing_timeout_interval', 'get_multiprocessing_timeout_interval']
 
 INT32_MAX = 2147483647
@@ -959,3 +962,120 @@ def get_error_samples_mode():
         >>> error_samples_mode = ds.config.get_error_samples_mode()
     """
     return _CDE_TO_PYTHON_ERROR_SAMPLES_MODE.get(_config.get_error_samples_mode())
+
+
+def set_map_preserve_order(preserve_order):
+    """
+    Set whether the Map operation keeps the order of rows in a dataset pipeline.
+
+    Note:
+        - When the order is not kept, every row is sent to the least loaded worker and each result is passed
+          on as soon as it is ready, so one slow row does not stall the others. The output order can differ
+          from run to run.
+        - This is only applicable to the Map operation in a dataset pipeline.
+
+    Args:
+        preserve_order (bool): Whether the Map operation keeps the order of rows. System default: True.
+
+    Raises:
+        TypeError: If `preserve_order` is not a boolean data type.
+
+    Examples:
+        >>> ds.config.set_map_preserve_order(False)
+    """
+    if not isinstance(preserve_order, bool):
+        raise TypeError("preserve_order must be a boolean dtype.")
+    _config.set_map_preserve_order(preserve_order)
+
+
+def get_map_preserve_order():
+    """
+    Get whether the Map operation keeps the order of rows in a dataset pipeline.
+
+    Returns:
+        bool, whether the Map operation keeps the order of rows.
+
+    Examples:
+        >>> preserve_order = ds.config.get_map_preserve_order()
+    """
+    return _config.get_map_preserve_order()
+
+
+def set_mindrecord_io_depth(io_depth):
+    """
+    Set the number of reads in flight when MindRecord files are read asynchronously.
+
+    Note:
+        - When `io_depth` is positive, the blobs of MindRecord files are read by a pool of `io_depth` I/O threads.
+          Reads of blobs that are next to each other in a file are merged into one request, and the blobs of the
+          samples coming next are prefetched. This helps on network file systems and NVMe disks, where many small
+          synchronous reads keep the device underused.
+        - When `io_depth` is 0, every blob is read synchronously by the worker that needs it.
+        - This is only applicable to MindDataset, and only takes effect on Linux.
+
+    Args:
+        io_depth (int): Number of reads in flight, in range [0, 128]. System default: 0.
+
+    Raises:
+        TypeError: If `io_depth` is not of type int.
+        ValueError: If `io_depth` < 0 or `io_depth` > 128.
+
+    Examples:
+        >>> ds.config.set_mindrecord_io_depth(16)
+    """
+    if not isinstance(io_depth, int) or isinstance(io_depth, bool):
+        raise TypeError("io_depth isn't of type int.")
+    if io_depth < 0 or io_depth > 128:
+        raise ValueError("io_depth given is not within the required range [0, 128].")
+    _config.set_mindrecord_io_depth(io_depth)
+
+
+def get_mindrecord_io_depth():
+    """
+    Get the number of reads in flight when MindRecord files are read asynchronously.
+
+    Returns:
+        int, the number of reads in flight, 0 means the files are read synchronously.
+
+    Examples:
+        >>> io_depth = ds.config.get_mindrecord_io_depth()
+    """
+    return _config.get_mindrecord_io_depth()
+
+
+def set_jpeg_scaled_decode(scaled_decode):
+    """
+    Set whether RandomCropDecodeResize decodes JPEG images at a reduced DCT scale.
+
+    Note:
+        - When enabled, the crop of a JPEG image is decoded at the smallest scale of 1/2, 1/4 or 1/8 which is still
+          larger than the output size, and then resized. This saves most of the decoding time when the output is much
+          smaller than the crop.
+        - The scaled decode filters the image in the DCT domain, so the output differs slightly from decoding the
+          full image and resizing it. Interpolation mode PILCUBIC always decodes the full image.
+
+    Args:
+        scaled_decode (bool): Whether to decode JPEG images at a reduced DCT scale. System default: False.
+
+    Raises:
+        TypeError: If `scaled_decode` is not a boolean data type.
+
+    Examples:
+        >>> ds.config.set_jpeg_scaled_decode(True)
+    """
+    if not isinstance(scaled_decode, bool):
+        raise TypeError("scaled_decode must be a boolean dtype.")
+    _config.set_jpeg_scaled_decode(scaled_decode)
+
+
+def get_jpeg_scaled_decode():
+    """
+    Get whether RandomCropDecodeResize decodes JPEG images at a reduced DCT scale.
+
+    Returns:
+        bool, whether JPEG images are decoded at a reduced DCT scale.
+
+    Examples:
+        >>> scaled_decode = ds.config.get_jpeg_scaled_decode()
+    """
+    return _config.get_jpeg_scaled_decode()
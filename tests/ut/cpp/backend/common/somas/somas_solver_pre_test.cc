@@ -0,0 +1,216 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "nlohmann/json.hpp"
+#include "common/common_test.h"
+#include "include/common/debug/common.h"
+#include "backend/common/session/kernel_graph.h"
+#include "backend/common/somas/somas_solver_pre.h"
+
+namespace mindspore {
+namespace somas {
+namespace {
+constexpr size_t kGroupSize = 8;
+constexpr size_t kTensorSizeUnit = 512;
+
+// The tensors of the same group are alive at the same time, the ones of different groups may share memory.
+TensorsDescMap CreateTensors(size_t tensor_num) {
+  TensorsDescMap tensors;
+  for (size_t i = 0; i < tensor_num; ++i) {
+    tensors[i] = std::make_shared<SomasSolverTensorDesc>(i, (i % 5 + 1) * kTensorSizeUnit, 0, i == 0);
+  }
+  return tensors;
+}
+
+std::vector<DynamicBitSet> CreateConstraints(size_t tensor_num) {
+  std::vector<DynamicBitSet> constraints(tensor_num, DynamicBitSet(tensor_num));
+  for (size_t i = 0; i < tensor_num; ++i) {
+    for (size_t j = 0; j < tensor_num; ++j) {
+      if (i / kGroupSize != j / kGroupSize) {
+        constraints[i].SetBitTrue(j);
+      }
+    }
+  }
+  return constraints;
+}
+
+std::map<size_t, size_t> GetOffsets(const TensorsDescMap &tensors) {
+  std::map<size_t, size_t> offsets;
+  for (auto &tensor : tensors) {
+    offsets[tensor.first] = tensor.second->offset_;
+  }
+  return offsets;
+}
+
+bool IsValidSolution(const TensorsDescMap &tensors, const std::vector<DynamicBitSet> &constraints) {
+  for (auto &t1 : tensors) {
+    for (auto &t2 : tensors) {
+      if (t1.first == t2.first) {
+        continue;
+      }
+      bool can_reuse = !t1.second->lifelong_ && !t2.second->lifelong_ && constraints[t1.first].IsBitTrue(t2.first);
+      bool overlap = t1.second->offset_ < t2.second->offset_ + t2.second->size_ &&
+                     t2.second->offset_ < t1.second->offset_ + t1.second->size_;
+      if (overlap && !can_reuse) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+std::string GetSolverCacheFile(const SomasSolverPre &solver) {
+  return Common::GetCompilerCachePath() + "/somas_meta/somas_solver_" + solver.hash_id() + ".json";
+}
+
+nlohmann::json ReadSolverCacheFile(const std::string &filename) {
+  std::ifstream ifs(filename);
+  nlohmann::json solver_json;
+  ifs >> solver_json;
+  return solver_json;
+}
+
+void WriteSolverCacheFile(const std::string &filename, const nlohmann::json &solver_json) {
+  (void)std::remove(filename.c_str());
+  std::ofstream ofs(filename);
+  ofs << solver_json.dump();
+}
+}  // namespace
+
+class TestSomasSolverPre : public UT::Common {
+ public:
+  TestSomasSolverPre() = default;
+  void SetUp() override { SomasSolverPre::ClearSolverCache(); }
+  void TearDown() override { SomasSolverPre::ClearSolverCache(); }
+};
+
+/// Feature: solution cache of the somas solver.
+/// Description: solve a graph, then solve it again from the cache of the process and from the cache file.
+/// Expectation: the cached offsets are restored, and the cache is ignored when it is not enabled.
+TEST_F(TestSomasSolverPre, TestSolverCacheRoundTrip) {
+  constexpr size_t tensor_num = 64;
+  session::KernelGraph graph;
+  auto constraints = CreateConstraints(tensor_num);
+  std::vector<std::vector<size_t>> continuous_v = {{1, 2, 3}};
+
+  auto tensors = CreateTensors(tensor_num);
+  SomasSolverPre solver;
+  solver.EnableSolverCache(true);
+  ASSERT_EQ(solver.Solving(graph, &tensors, &constraints, continuous_v, true), SUCCESS);
+  ASSERT_TRUE(IsValidSolution(tensors, constraints));
+  auto offsets = GetOffsets(tensors);
+  auto filename = GetSolverCacheFile(solver);
+  ASSERT_TRUE(mindspore::Common::FileExists(filename));
+
+  auto cached_tensors = CreateTensors(tensor_num);
+  SomasSolverPre cached_solver;
+  cached_solver.EnableSolverCache(true);
+  ASSERT_EQ(cached_solver.Solving(graph, &cached_tensors, &constraints, continuous_v, true), SUCCESS);
+  EXPECT_EQ(GetOffsets(cached_tensors), offsets);
+  EXPECT_EQ(cached_solver.GetMaxOffset(), solver.GetMaxOffset());
+
+  // Move the whole solution up in the cache file, which is still valid, to tell it from a new solving.
+  auto solver_json = ReadSolverCacheFile(filename);
+  auto file_offsets = solver_json["offsets"].get<std::vector<std::pair<size_t, size_t>>>();
+  for (auto &offset : file_offsets) {
+    offset.second += kTensorSizeUnit;
+  }
+  solver_json["offsets"] = file_offsets;
+  solver_json["max_offset"] = solver.GetMaxOffset() + kTensorSizeUnit;
+  WriteSolverCacheFile(filename, solver_json);
+  SomasSolverPre::ClearSolverCache();
+
+  auto file_tensors = CreateTensors(tensor_num);
+  SomasSolverPre file_solver;
+  file_solver.EnableSolverCache(true);
+  ASSERT_EQ(file_solver.Solving(graph, &file_tensors, &constraints, continuous_v, true), SUCCESS);
+  EXPECT_EQ(file_solver.GetMaxOffset(), solver.GetMaxOffset() + kTensorSizeUnit);
+  for (auto &offset : GetOffsets(file_tensors)) {
+    EXPECT_EQ(offset.second, offsets[offset.first] + kTensorSizeUnit);
+  }
+
+  auto uncached_tensors = CreateTensors(tensor_num);
+  SomasSolverPre uncached_solver;
+  ASSERT_EQ(uncached_solver.Solving(graph, &uncached_tensors, &constraints, continuous_v, true), SUCCESS);
+  EXPECT_EQ(GetOffsets(uncached_tensors), offsets);
+  EXPECT_EQ(uncached_solver.GetMaxOffset(), solver.GetMaxOffset());
+  (void)std::remove(filename.c_str());
+}
+
+/// Feature: solution cache of the somas solver.
+/// Description: the cache file holds offsets which break the conflict or contiguous constraints, or miss a tensor.
+/// Expectation: the stale cache is rejected and the graph is solved again.
+TEST_F(TestSomasSolverPre, TestSolverCacheRejectStale) {
+  constexpr size_t tensor_num = 40;
+  session::KernelGraph graph;
+  auto constraints = CreateConstraints(tensor_num);
+  std::vector<std::vector<size_t>> continuous_v = {{4, 5}};
+
+  auto tensors = CreateTensors(tensor_num);
+  SomasSolverPre solver;
+  solver.EnableSolverCache(true);
+  ASSERT_EQ(solver.Solving(graph, &tensors, &constraints, continuous_v, true), SUCCESS);
+  auto offsets = GetOffsets(tensors);
+  auto filename = GetSolverCacheFile(solver);
+  auto solver_json = ReadSolverCacheFile(filename);
+  auto valid_offsets = solver_json["offsets"].get<std::vector<std::pair<size_t, size_t>>>();
+
+  auto check_rejected = [&](const std::vector<std::pair<size_t, size_t>> &stale_offsets) {
+    solver_json["offsets"] = stale_offsets;
+    solver_json["tensor_size"] = stale_offsets.size();
+    WriteSolverCacheFile(filename, solver_json);
+    SomasSolverPre::ClearSolverCache();
+    auto stale_tensors = CreateTensors(tensor_num);
+    SomasSolverPre stale_solver;
+    stale_solver.EnableSolverCache(true);
+    ASSERT_EQ(stale_solver.Solving(graph, &stale_tensors, &constraints, continuous_v, true), SUCCESS);
+    EXPECT_TRUE(IsValidSolution(stale_tensors, constraints));
+    EXPECT_EQ(GetOffsets(stale_tensors), offsets);
+    EXPECT_EQ(stale_solver.GetMaxOffset(), solver.GetMaxOffset());
+  };
+
+  // all the tensors at offset 0 conflict with each other in the same group
+  std::vector<std::pair<size_t, size_t>> overlap_offsets;
+  for (auto &offset : valid_offsets) {
+    overlap_offsets.emplace_back(offset.first, 0);
+  }
+  check_rejected(overlap_offsets);
+
+  // tensor 5 is not contiguous to tensor 4 any more
+  auto broken_continuous = valid_offsets;
+  for (auto &offset : broken_continuous) {
+    if (offset.first == 5) {
+      offset.second = solver.GetMaxOffset();
+    }
+  }
+  solver_json["max_offset"] = solver.GetMaxOffset() * 2;
+  check_rejected(broken_continuous);
+
+  // a tensor of the current graph misses its offset
+  auto missing_tensor = valid_offsets;
+  missing_tensor.pop_back();
+  solver_json["max_offset"] = solver.GetMaxOffset();
+  check_rejected(missing_tensor);
+  (void)std::remove(filename.c_str());
+}
+}  // namespace somas
+}  // namespace mindspore
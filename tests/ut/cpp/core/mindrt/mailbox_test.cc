@@ -0,0 +1,163 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "actor/mailbox.h"
+
+namespace mindspore {
+namespace {
+constexpr size_t kMsgNumPerRound = 1 << 16;
+constexpr size_t kMaxProducerNum = 64;
+constexpr size_t kMsgNumPerBenchmarkRound = 1 << 22;
+
+// Drain the mailbox in the way of ActorBase::Run, return the number of the taken messages.
+size_t DrainMailBox(MailBox *mailbox, std::vector<size_t> *last_seq) {
+  size_t count = 0;
+  auto check_order = [last_seq](const std::unique_ptr<MessageBase> &msg) {
+    if (last_seq == nullptr) {
+      return;
+    }
+    size_t producer = msg->size >> 32;
+    size_t seq = msg->size & 0xFFFFFFFF;
+    ASSERT_LT(producer, last_seq->size());
+    ASSERT_EQ(seq, (*last_seq)[producer]);
+    ++(*last_seq)[producer];
+  };
+  if (mailbox->TakeAllMsgsEachTime()) {
+    while (auto msgs = mailbox->GetMsgs()) {
+      for (auto &msg : *msgs) {
+        check_order(msg);
+        ++count;
+      }
+      msgs->clear();
+    }
+  } else {
+    while (auto msg = mailbox->GetMsg()) {
+      check_order(msg);
+      ++count;
+    }
+  }
+  return count;
+}
+
+// Return the number of the received messages, and the seconds taken to receive them if seconds is not null.
+size_t RunMailBox(MailBox *mailbox, size_t producer_num, size_t msg_num, bool check_order,
+                  double *seconds = nullptr) {
+  std::vector<size_t> last_seq(producer_num, 0);
+  std::atomic_bool start{false};
+  std::vector<std::thread> producers;
+  size_t msg_num_per_producer = msg_num / producer_num;
+  for (size_t i = 0; i < producer_num; ++i) {
+    producers.emplace_back([mailbox, i, msg_num_per_producer, &start]() {
+      while (!start) {
+        std::this_thread::yield();
+      }
+      for (size_t j = 0; j < msg_num_per_producer; ++j) {
+        auto msg = std::make_unique<MessageBase>(MessageBase::Type::KLOCAL);
+        msg->size = (i << 32) | j;
+        (void)mailbox->EnqueueMessage(std::move(msg));
+      }
+    });
+  }
+  size_t total = msg_num_per_producer * producer_num;
+  size_t received = 0;
+  auto begin = std::chrono::steady_clock::now();
+  start = true;
+  while (received < total) {
+    received += DrainMailBox(mailbox, check_order ? &last_seq : nullptr);
+  }
+  if (seconds != nullptr) {
+    *seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  return received;
+}
+}  // namespace
+
+class TestMailBox : public UT::Common {
+ public:
+  TestMailBox() = default;
+};
+
+/// Feature: lock-free mpsc mailbox.
+/// Description: several producers enqueue messages while the consumer drains the mailbox.
+/// Expectation: no message is lost and the messages of each producer keep their order.
+TEST_F(TestMailBox, TestMpscMailBoxOrder) {
+  MpscMailBox mailbox;
+  ASSERT_EQ(RunMailBox(&mailbox, 4, kMsgNumPerRound, true), kMsgNumPerRound);
+  ASSERT_EQ(mailbox.GetMsg(), nullptr);
+}
+
+/// Feature: lock-free mpsc mailbox.
+/// Description: enqueue messages into an idle mailbox and a busy one.
+/// Expectation: the notify hook is only invoked when the mailbox turns from idle to busy.
+TEST_F(TestMailBox, TestMpscMailBoxNotify) {
+  MpscMailBox mailbox;
+  size_t notify_count = 0;
+  mailbox.SetNotifyHook(std::make_unique<std::function<void()>>([&notify_count]() { ++notify_count; }));
+  (void)mailbox.EnqueueMessage(std::make_unique<MessageBase>());
+  (void)mailbox.EnqueueMessage(std::make_unique<MessageBase>());
+  ASSERT_EQ(notify_count, 1);
+  ASSERT_NE(mailbox.GetMsg(), nullptr);
+  (void)mailbox.EnqueueMessage(std::make_unique<MessageBase>());
+  ASSERT_EQ(notify_count, 1);
+  ASSERT_NE(mailbox.GetMsg(), nullptr);
+  ASSERT_NE(mailbox.GetMsg(), nullptr);
+  ASSERT_EQ(mailbox.GetMsg(), nullptr);
+  (void)mailbox.EnqueueMessage(std::make_unique<MessageBase>());
+  ASSERT_EQ(notify_count, 2);
+}
+
+/// Feature: lock-free mpsc mailbox.
+/// Description: 1 to 64 producer threads enqueue messages into the mailboxes.
+/// Expectation: all the messages are received by every mailbox.
+TEST_F(TestMailBox, TestMailBoxMultiProducer) {
+  for (size_t producer_num = 1; producer_num <= kMaxProducerNum; producer_num *= 2) {
+    NonblockingMailBox nonblocking_mailbox;
+    MpscMailBox mpsc_mailbox;
+    ASSERT_EQ(RunMailBox(&nonblocking_mailbox, producer_num, kMsgNumPerRound, false), kMsgNumPerRound);
+    ASSERT_EQ(RunMailBox(&mpsc_mailbox, producer_num, kMsgNumPerRound, false), kMsgNumPerRound);
+    ASSERT_EQ(mpsc_mailbox.GetMsg(), nullptr);
+  }
+}
+
+/// Feature: lock-free mpsc mailbox.
+/// Description: measure the messages per second of the mailboxes with 1 to 64 producer threads, it is a benchmark run
+/// by --gtest_also_run_disabled_tests --gtest_filter=TestMailBox.DISABLED_MailBoxThroughput.
+/// Expectation: all the messages are received, the throughput is logged.
+TEST_F(TestMailBox, DISABLED_MailBoxThroughput) {
+  for (size_t producer_num = 1; producer_num <= kMaxProducerNum; producer_num *= 2) {
+    NonblockingMailBox nonblocking_mailbox;
+    MpscMailBox mpsc_mailbox;
+    double nonblocking_seconds = 0;
+    double mpsc_seconds = 0;
+    ASSERT_EQ(RunMailBox(&nonblocking_mailbox, producer_num, kMsgNumPerBenchmarkRound, false, &nonblocking_seconds),
+              kMsgNumPerBenchmarkRound);
+    ASSERT_EQ(RunMailBox(&mpsc_mailbox, producer_num, kMsgNumPerBenchmarkRound, false, &mpsc_seconds),
+              kMsgNumPerBenchmarkRound);
+    MS_LOG(WARNING) << "Producers: " << producer_num
+                    << ", NonblockingMailBox: " << kMsgNumPerBenchmarkRound / nonblocking_seconds
+                    << " msg/s, MpscMailBox: " << kMsgNumPerBenchmarkRound / mpsc_seconds << " msg/s.";
+  }
+}
+}  // namespace mindspore
@@ -13,8 +13,12 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <chrono>
+#include <thread>
+
 #include "common/common.h"
 #include "include/api/types.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/core/tensor_row.h"
 #include "minddata/dataset/include/dataset/datasets.h"
 #include "minddata/dataset/include/dataset/vision.h"
@@ -89,6 +93,31 @@ class OneToThreeOp : public TensorOp {
   std::string Name() const override { return "OneToThreeOp"; };
 };
 
+class SlowLabelOp : public TensorOp {
+ public:
+  explicit SlowLabelOp(int32_t slow_label) : slow_label_(slow_label) {}
+
+  ~SlowLabelOp() override = default;
+
+  // Delay the rows of one label, so that the worker holding them finishes the epoch after the other workers.
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override {
+    int32_t label = 0;
+    RETURN_IF_NOT_OK(input->GetItemAt(&label, {}));
+    if (label == slow_label_) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    *output = input;
+    return Status::OK();
+  };
+
+  void Print(std::ostream &out) const override { out << "SlowLabelOp"; };
+
+  std::string Name() const override { return "SlowLabelOp"; }
+
+ private:
+  int32_t slow_label_;
+};
+
 class NoTransform final : public TensorTransform {
  public:
   explicit NoTransform() {}
@@ -133,6 +162,20 @@ class OneToThreeTransform final : public TensorTransform {
   struct Data;
   std::shared_ptr<Data> data_;
 };
+class SlowLabelTransform final : public TensorTransform {
+ public:
+  explicit SlowLabelTransform(int32_t slow_label) : slow_label_(slow_label) {}
+  ~SlowLabelTransform() = default;
+
+ protected:
+  std::shared_ptr<TensorOperation> Parse() override {
+    return std::make_shared<transforms::PreBuiltOperation>(
+      std::make_shared<mindspore::dataset::test::SlowLabelOp>(slow_label_));
+  }
+
+ private:
+  int32_t slow_label_;
+};
 }  // namespace test
 }  // namespace dataset
 }  // namespace mindspore
@@ -2689,6 +2732,76 @@ TEST_F(MindDataTestPipeline, TestMap) {
   iter->Stop();
 }
 
+// Feature: Test Map with several workers which do not preserve the order of rows
+// Description: Apply Map with 4 workers on ImageFolder, where the rows of the last class are slow, then Batch and
+//     Repeat, and iterate over 2 epochs
+// Expectation: Every repeat keeps its own 44 rows, 11 of each class, before its end of epoch
+TEST_F(MindDataTestPipeline, TestMapUnorderedRepeat) {
+  MS_LOG(INFO) << "Doing MindDataTestPipeline.TestMapUnorderedRepeat";
+  auto config_manager = GlobalContext::config_manager();
+  bool original_preserve_order = config_manager->map_preserve_order();
+  config_manager->set_map_preserve_order(false);
+
+  // Create an ImageFolder Dataset, the 4 classes of 11 images come in order
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>());
+  EXPECT_NE(ds, nullptr);
+  ds = ds->Project({"label"});
+  EXPECT_NE(ds, nullptr);
+
+  // Create a Map operation on ds, which delays the rows of the last class
+  std::shared_ptr<TensorTransform> slow_op = std::make_shared<mindspore::dataset::test::SlowLabelTransform>(3);
+  ds = ds->Map({slow_op}, {"label"});
+  EXPECT_NE(ds, nullptr);
+  ds = ds->SetNumWorkers(4);
+  EXPECT_NE(ds, nullptr);
+
+  // The last batch of each repeat is only full if a row of the next repeat got in before the end of epoch
+  int32_t batch_size = 5;
+  ds = ds->Batch(batch_size);
+  EXPECT_NE(ds, nullptr);
+  int32_t num_repeats = 2;
+  ds = ds->Repeat(num_repeats);
+  EXPECT_NE(ds, nullptr);
+
+  int32_t num_epochs = 2;
+  std::shared_ptr<Iterator> iter = ds->CreateIterator(num_epochs);
+  EXPECT_NE(iter, nullptr);
+
+  const int32_t num_classes = 4;
+  const int32_t rows_per_class = 11;
+  for (int32_t epoch = 0; epoch < num_epochs; epoch++) {
+    std::unordered_map<std::string, mindspore::MSTensor> row;
+    ASSERT_OK(iter->GetNextRow(&row));
+    int32_t repeat = 0;
+    std::vector<int32_t> label_count(num_classes, 0);
+    while (row.size() != 0) {
+      std::shared_ptr<Tensor> de_label;
+      ASSERT_OK(Tensor::CreateFromMSTensor(row["label"], &de_label));
+      for (auto it = de_label->begin<int32_t>(); it != de_label->end<int32_t>(); ++it) {
+        ASSERT_GE(*it, 0);
+        ASSERT_LT(*it, num_classes);
+        label_count[*it]++;
+      }
+      // A batch which is not full closes a repeat, by then all the rows of this repeat have to be in
+      if (de_label->Size() < batch_size) {
+        EXPECT_EQ(label_count, std::vector<int32_t>(num_classes, rows_per_class));
+        std::fill(label_count.begin(), label_count.end(), 0);
+        repeat++;
+      } else {
+        EXPECT_EQ(de_label->Size(), batch_size);
+      }
+      ASSERT_OK(iter->GetNextRow(&row));
+    }
+    EXPECT_EQ(repeat, num_repeats);
+    EXPECT_EQ(label_count, std::vector<int32_t>(num_classes, 0));
+  }
+
+  // Manually terminate the pipeline
+  iter->Stop();
+  config_manager->set_map_preserve_order(original_preserve_order);
+}
+
 // Feature: Test Map on TFRecord
 // Description: Apply Map with a TensorOp that swaps 3 input columns with 1 output column
 // Expectation: "Image", "A", "B" are replaced with "X"
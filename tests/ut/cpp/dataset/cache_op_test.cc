@@ -16,6 +16,7 @@
 #include <string>
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/cache/cache_client.h"
+#include "minddata/dataset/engine/cache/cache_fbb.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/datasetops/cache_op.h"
 #include "minddata/dataset/engine/datasetops/cache_lookup_op.h"
@@ -318,3 +319,46 @@ TEST_F(MindDataTestCacheOp, DISABLED_TestImageFolderCacheMerge) {
   rc = myClient->DestroyCache();
   ASSERT_TRUE(rc.IsOk());
 }
+
+/// Feature: Cache
+/// Description: Restore the tensors of a fetched row from a leased shared memory block, one of them aligned and the
+///     other not, then drop the tensors
+/// Expectation: The aligned tensor uses the block in place and pins it, the other one is copied out. The lease is
+///     released only once the last tensor using the block is gone
+TEST_F(MindDataTestCacheOp, TestSharedBlockLease) {
+  std::vector<float> data = {1.0, 2.0, 3.0, 4.0};
+  std::shared_ptr<Tensor> t;
+  ASSERT_OK(Tensor::CreateFromVector(data, TensorShape({2, 2}), &t));
+  TensorRow row = {t, t};
+  std::shared_ptr<flatbuffers::FlatBufferBuilder> fbb;
+  ASSERT_OK(SerializeTensorRowHeader(row, &fbb));
+  auto msg = GetTensorRowHeaderMsg(fbb->GetBufferPointer());
+
+  // The first tensor is at the start of the block, the second one is off by a byte.
+  constexpr int64_t kUnalignedOffset = 17;
+  auto data_sz = static_cast<int64_t>(t->SizeInBytes());
+  std::vector<int64_t> block(8, 0);
+  auto *base = reinterpret_cast<uint8_t *>(block.data());
+  ASSERT_EQ(memcpy_s(base, data_sz, data.data(), data_sz), EOK);
+  ASSERT_EQ(memcpy_s(base + kUnalignedOffset, data_sz, data.data(), data_sz), EOK);
+
+  int num_released = 0;
+  std::shared_ptr<MemoryPool> lease = std::make_shared<CacheClient::SharedBlockLease>([&num_released]() {
+    ++num_released;
+    return Status::OK();
+  });
+  std::shared_ptr<Tensor> in_place;
+  std::shared_ptr<Tensor> copied;
+  ASSERT_OK(RestoreOneTensor(msg->column()->Get(0), ReadableSlice(base, data_sz), lease, &in_place));
+  ASSERT_OK(RestoreOneTensor(msg->column()->Get(1), ReadableSlice(base + kUnalignedOffset, data_sz), lease, &copied));
+  EXPECT_EQ(in_place->GetBuffer(), base);
+  EXPECT_NE(copied->GetBuffer(), base + kUnalignedOffset);
+  EXPECT_TRUE(*in_place == *t);
+  EXPECT_TRUE(*copied == *t);
+
+  lease.reset();
+  copied.reset();
+  EXPECT_EQ(num_released, 0);
+  in_place.reset();
+  EXPECT_EQ(num_released, 1);
+}
@@ -0,0 +1,159 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "common/common.h"
+#include "minddata/dataset/engine/cache/cache_hw.h"
+#include "minddata/dataset/engine/cache/cache_numa.h"
+#include "minddata/dataset/engine/cache/cache_pool.h"
+
+using namespace mindspore::dataset;
+
+namespace {
+constexpr size_t kRowSize = 1024;
+constexpr int64_t kNumRows = 10;
+constexpr int64_t kNumHotRows = 4;
+constexpr int kMaxWaitRounds = 500;
+constexpr char kSpillPath[] = "./cache_pool_test";
+
+std::vector<uint8_t> MakeRow(int64_t key) {
+  std::vector<uint8_t> row(kRowSize);
+  for (size_t i = 0; i < kRowSize; ++i) {
+    row[i] = static_cast<uint8_t>(key * 31 + i);
+  }
+  return row;
+}
+
+Status InsertRows(CachePool *cp) {
+  for (int64_t key = 0; key < kNumRows; ++key) {
+    auto row = MakeRow(key);
+    RETURN_IF_NOT_OK(cp->Insert(key, {ReadableSlice(row.data(), row.size())}));
+  }
+  return Status::OK();
+}
+
+bool ReadRow(const CachePool &cp, int64_t key) {
+  std::vector<uint8_t> row(kRowSize);
+  WritableSlice dest(row.data(), row.size());
+  size_t bytes_read = 0;
+  return cp.Read(key, &dest, &bytes_read).IsOk() && bytes_read == kRowSize && row == MakeRow(key);
+}
+
+// The rows are promoted by a background thread, wait for it
+bool WaitForPromotions(const CachePool &cp, int64_t num_promoted) {
+  for (int i = 0; i < kMaxWaitRounds; ++i) {
+    if (cp.GetStat().num_promoted >= num_promoted) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return false;
+}
+}  // namespace
+
+class MindDataTestCachePool : public UT::Common {
+ public:
+  void SetUp() override {
+    auto hw = std::make_shared<CacheServerHW>();
+    ASSERT_OK(hw->GetNumaNodeInfo());
+    mp_ = std::make_shared<NumaMemoryPool>(hw, kDefaultMemoryCapRatio);
+    ASSERT_FALSE(mp_->GetAvailableNodes().empty());
+  }
+
+  void TearDown() override {
+    Path spill(kSpillPath);
+    (void)spill.Remove();
+  }
+
+  std::shared_ptr<NumaMemoryPool> mp_;
+};
+
+/// Feature: CachePool
+/// Description: Insert more rows than the memory tier holds, then read all of them
+/// Expectation: The rows beyond the limit are spilled to disk, and every row is read back from either tier
+TEST_F(MindDataTestCachePool, TestSpill) {
+  CachePool cp(mp_, kSpillPath, kNumHotRows * kRowSize);
+  ASSERT_OK(cp.ServiceStart());
+  ASSERT_OK(InsertRows(&cp));
+  auto stat = cp.GetStat();
+  EXPECT_EQ(stat.num_mem_cached, kNumHotRows);
+  EXPECT_EQ(stat.num_disk_cached, kNumRows - kNumHotRows);
+  EXPECT_EQ(stat.average_cache_sz, kRowSize);
+  for (int64_t key = 0; key < kNumRows; ++key) {
+    EXPECT_TRUE(ReadRow(cp, key));
+  }
+  Path spill = cp.GetSpillPath();
+  EXPECT_TRUE(spill.Exists());
+  ASSERT_OK(cp.ServiceStop());
+  EXPECT_FALSE(spill.Exists());
+}
+
+/// Feature: CachePool
+/// Description: Read a row on disk more often than the rows in memory
+/// Expectation: The row is promoted to memory, a row never read is evicted to disk in its place, and the data of every
+///     row stays the same
+TEST_F(MindDataTestCachePool, TestPromoteAndEvict) {
+  CachePool cp(mp_, kSpillPath, kNumHotRows * kRowSize);
+  ASSERT_OK(cp.ServiceStart());
+  ASSERT_OK(InsertRows(&cp));
+  constexpr int64_t kHotKey = kNumRows - 1;
+  constexpr int kNumHotReads = 3;
+  for (int i = 0; i < kNumHotReads; ++i) {
+    ASSERT_TRUE(ReadRow(cp, kHotKey));
+  }
+  ASSERT_TRUE(WaitForPromotions(cp, 1));
+  auto stat = cp.GetStat();
+  EXPECT_EQ(stat.num_promoted, 1);
+  EXPECT_EQ(stat.num_demoted, 1);
+  EXPECT_EQ(stat.num_mem_cached, kNumHotRows);
+  EXPECT_EQ(stat.num_disk_cached, kNumRows - kNumHotRows);
+  for (int64_t key = 0; key < kNumRows; ++key) {
+    EXPECT_TRUE(ReadRow(cp, key));
+  }
+  ASSERT_OK(cp.ServiceStop());
+}
+
+/// Feature: CachePool
+/// Description: Scan all the rows a few times, then read one row on disk many more times
+/// Expectation: The scans promote no row, only the row read the most is promoted
+TEST_F(MindDataTestCachePool, TestScanResistance) {
+  CachePool cp(mp_, kSpillPath, kNumHotRows * kRowSize);
+  ASSERT_OK(cp.ServiceStart());
+  ASSERT_OK(InsertRows(&cp));
+  constexpr int kNumScans = 3;
+  for (int i = 0; i < kNumScans; ++i) {
+    for (int64_t key = 0; key < kNumRows; ++key) {
+      ASSERT_TRUE(ReadRow(cp, key));
+    }
+  }
+  // The promotions are done in order, so the ones asked for by the scans are done once this row is promoted.
+  constexpr int64_t kHotKey = kNumRows - 1;
+  constexpr int kNumHotReads = 5;
+  for (int i = 0; i < kNumHotReads; ++i) {
+    ASSERT_TRUE(ReadRow(cp, kHotKey));
+  }
+  ASSERT_TRUE(WaitForPromotions(cp, 1));
+  auto stat = cp.GetStat();
+  EXPECT_EQ(stat.num_promoted, 1);
+  EXPECT_EQ(stat.num_demoted, 1);
+  EXPECT_EQ(stat.num_mem_cached, kNumHotRows);
+  for (int64_t key = 0; key < kNumRows; ++key) {
+    EXPECT_TRUE(ReadRow(cp, key));
+  }
+  ASSERT_OK(cp.ServiceStop());
+}
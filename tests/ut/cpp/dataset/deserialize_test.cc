@@ -511,6 +511,34 @@ TEST_F(MindDataTestDeserialize, TestDeserializeFill) {
   compare_dataset(ds);
 }
 
+/// Feature: Deserialize
+/// Description: Test Deserialize on ImageFolderDataset with the FusedPixel op created by TensorOpFusionPass
+/// Expectation: The FusedPixel op and the ops it fuses are deserialized successfully
+TEST_F(MindDataTestDeserialize, TestDeserializeFusedPixel) {
+  MS_LOG(INFO) << "Doing MindDataTestDeserialize-FusedPixel.";
+  std::string dataset_dir = "./data/dataset/testPK/data/";
+  std::shared_ptr<SamplerObj> sampler = std::make_shared<SequentialSamplerObj>(0, 10);
+  std::shared_ptr<DatasetNode> ds = std::make_shared<ImageFolderNode>(
+    dataset_dir, false, sampler, false, std::set<std::string>(), std::map<std::string, int32_t>(), nullptr);
+  std::vector<float> mean = {121.0, 115.0, 100.0};
+  std::vector<float> std = {70.0, 68.0, 71.0};
+  std::shared_ptr<TensorOperation> operation1 = std::make_shared<vision::DecodeOperation>(true);
+  std::shared_ptr<TensorOperation> operation2 = std::make_shared<vision::RescaleOperation>(1.0 / 255, 0.0);
+  std::shared_ptr<TensorOperation> operation3 = std::make_shared<vision::NormalizeOperation>(mean, std, true);
+  std::shared_ptr<TensorOperation> operation4 = std::make_shared<vision::HwcToChwOperation>();
+  std::vector<std::shared_ptr<TensorOperation>> pixel_ops = {operation2, operation3, operation4};
+  std::shared_ptr<TensorOperation> operation5 = std::make_shared<vision::FusedPixelOperation>(pixel_ops);
+  std::vector<std::shared_ptr<TensorOperation>> ops = {operation1, operation5};
+  ds = std::make_shared<MapNode>(ds, ops);
+  compare_dataset(ds);
+
+  nlohmann::json out_json;
+  ASSERT_OK(Serdes::SaveToJSON(ds, "", &out_json));
+  auto fused_json = out_json["operations"][1];
+  EXPECT_EQ(fused_json["tensor_op_name"].get<std::string>(), vision::kFusedPixelOperation);
+  EXPECT_EQ(fused_json["tensor_op_params"]["transforms"].size(), pixel_ops.size());
+}
+
 /// Feature: Deserialize
 /// Description: Test Deserialize on Tensor
 /// Expectation: The data is processed successfully
@@ -0,0 +1,104 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/kernels/data/data_utils.h"
+#include "minddata/dataset/kernels/data/type_cast_op.h"
+#include "minddata/dataset/kernels/image/fused_pixel_op.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/rescale_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestFusedPixelOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestFusedPixelOp() : CVOpCommon() {}
+
+  // run the ops one after another, as the MapOp does without the fusion
+  void RunSequential(const std::vector<std::shared_ptr<TensorOp>> &ops, const std::shared_ptr<Tensor> &input,
+                     std::shared_ptr<Tensor> *output) {
+    std::shared_ptr<Tensor> in = input;
+    for (auto &op : ops) {
+      ASSERT_OK(op->Compute(in, output));
+      in = *output;
+    }
+  }
+
+  template <typename T>
+  void CheckClose(const std::shared_ptr<Tensor> &expected, const std::shared_ptr<Tensor> &actual, double tolerance) {
+    ASSERT_EQ(expected->shape(), actual->shape());
+    ASSERT_EQ(expected->type(), actual->type());
+    auto expected_itr = expected->begin<T>();
+    for (auto itr = actual->begin<T>(); itr != actual->end<T>(); ++itr, ++expected_itr) {
+      ASSERT_NEAR(static_cast<float>(*expected_itr), static_cast<float>(*itr), tolerance);
+    }
+  }
+};
+
+/// Feature: FusedPixel op
+/// Description: Test FusedPixelOp with Rescale, Normalize and HWC2CHW on an 8-bit image
+/// Expectation: Output is the same as the output of the unfused ops
+TEST_F(MindDataTestFusedPixelOp, TestRescaleNormalizeHwcToChw) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedPixelOp-TestRescaleNormalizeHwcToChw.";
+  std::vector<std::shared_ptr<TensorOp>> ops = {
+    std::make_shared<RescaleOp>(1.0 / 255, 0.0),
+    std::make_shared<NormalizeOp>(std::vector<float>{0.485, 0.456, 0.406}, std::vector<float>{0.229, 0.224, 0.225},
+                                  true),
+    std::make_shared<HwcToChwOp>()};
+  std::shared_ptr<Tensor> expected, actual;
+  RunSequential(ops, input_tensor_, &expected);
+
+  FusedPixelOp op(ops);
+  // the second call runs the generated kernel again
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_OK(op.Compute(input_tensor_, &actual));
+    CheckClose<float>(expected, actual, 1e-5);
+  }
+}
+
+/// Feature: FusedPixel op
+/// Description: Test FusedPixelOp ending with a TypeCast to float16 and keeping the HWC layout
+/// Expectation: Output is the same as the output of the unfused ops
+TEST_F(MindDataTestFusedPixelOp, TestNormalizeTypeCast) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedPixelOp-TestNormalizeTypeCast.";
+  std::vector<std::shared_ptr<TensorOp>> ops = {
+    std::make_shared<NormalizeOp>(std::vector<float>{121.0, 115.0, 100.0}, std::vector<float>{70.0, 68.0, 71.0}, true),
+    std::make_shared<TypeCastOp>(DataType(DataType::DE_FLOAT16))};
+  std::shared_ptr<Tensor> expected, actual;
+  RunSequential(ops, input_tensor_, &expected);
+
+  FusedPixelOp op(ops);
+  ASSERT_OK(op.Compute(input_tensor_, &actual));
+  CheckClose<float16>(expected, actual, 1e-3);
+}
+
+/// Feature: FusedPixel op
+/// Description: Test FusedPixelOp with an input which is not an 8-bit image
+/// Expectation: The ops run one after another and the output is the same as the output of the unfused ops
+TEST_F(MindDataTestFusedPixelOp, TestFloatInput) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedPixelOp-TestFloatInput.";
+  std::shared_ptr<Tensor> float_input;
+  ASSERT_OK(TypeCast(input_tensor_, &float_input, DataType(DataType::DE_FLOAT32)));
+  std::vector<std::shared_ptr<TensorOp>> ops = {std::make_shared<RescaleOp>(2.0, 1.0), std::make_shared<HwcToChwOp>()};
+  std::shared_ptr<Tensor> expected, actual;
+  RunSequential(ops, float_input, &expected);
+
+  FusedPixelOp op(ops);
+  ASSERT_OK(op.Compute(float_input, &actual));
+  CheckClose<float>(expected, actual, 0.0);
+}
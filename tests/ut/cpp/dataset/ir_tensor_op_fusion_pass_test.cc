@@ -106,3 +106,41 @@ TEST_F(MindDataTestTensorOpFusionPass, RandomCropDecodeResizeEnabled) {
     // EXPECT_EQ(++func_it, tfuncs.end());
   }
 }
+
+/// Feature: MindData Tensor Op Fusion Pass Support
+/// Description: Test Rescale, Normalize and HWC2CHW ops after Decode with IR optimization pass
+/// Expectation: The per-pixel ops are fused into one FusedPixelOp and Decode is kept
+TEST_F(MindDataTestTensorOpFusionPass, FusedPixelEnabled) {
+  MS_LOG(INFO) << "Doing MindDataTestTensorOpFusionPass-FusedPixelEnabled";
+
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>(0, 11));
+
+  // Create objects for the tensor ops
+  auto decode = std::make_shared<vision::Decode>();
+  auto rescale = std::make_shared<vision::Rescale>(1.0 / 255, 0.0);
+  auto normalize = std::make_shared<vision::Normalize>(std::vector<float>{0.485, 0.456, 0.406},
+                                                       std::vector<float>{0.229, 0.224, 0.225});
+  auto hwc2chw = std::make_shared<vision::HWC2CHW>();
+  ds = ds->Map({decode, rescale, normalize, hwc2chw}, {"image"});
+
+  std::shared_ptr<DatasetNode> node = ds->IRNode();
+  auto ir_tree = std::make_shared<TreeAdapter>();
+  // Enable IR optimization pass
+  ir_tree->SetOptimize(true);
+  Status rc;
+  rc = ir_tree->Compile(node);
+  EXPECT_TRUE(rc);
+  auto root_op = ir_tree->GetRoot();
+
+  auto tree = std::make_shared<ExecutionTree>();
+  auto it = tree->begin(static_cast<std::shared_ptr<DatasetOp>>(root_op));
+  ++it;
+  auto *map_op = &(*it);
+  auto tfuncs = static_cast<MapOp *>(map_op)->TFuncs();
+  for (size_t i = 0; i < tfuncs.size(); i++) {
+    ASSERT_EQ(tfuncs[i].size(), 2);
+    EXPECT_EQ(tfuncs[i][0]->Name(), kDecodeOp);
+    EXPECT_EQ(tfuncs[i][1]->Name(), kFusedPixelOp);
+  }
+}
@@ -161,3 +161,61 @@ TEST_F(MindDataTestRandomCropDecodeResizeOp, TestOp1) {
   }
   MS_LOG(INFO) << "RandomCropDecodeResizeOp test 2 finished";
 }
+
+/// Feature: RandomCropDecodeResize op
+/// Description: Test JpegCropDecodeResize with a target small enough to decode at a reduced DCT scale
+/// Expectation: Output is the same as the output of Decode, Crop and Resize without the scaled decode or with PILCUBIC,
+///     and close to it with the scaled decode
+TEST_F(MindDataTestRandomCropDecodeResizeOp, TestOp3) {
+  MS_LOG(INFO) << "starting RandomCropDecodeResizeOp test 3";
+  constexpr int target_height = 64;
+  constexpr int target_width = 64;
+  const std::vector<std::vector<int>> crop_boxes = {{0, 0, 718, 884}, {100, 200, 400, 300}, {37, 11, 256, 512}};
+
+  // the mean of the differences of the green channel over the pixels which differ
+  auto get_mse = [](const std::shared_ptr<Tensor> &expected, const std::shared_ptr<Tensor> &output, long int *count) {
+    cv::Mat M1 = CVTensor::AsCVTensor(expected)->mat().clone();
+    cv::Mat M2 = CVTensor::AsCVTensor(output)->mat().clone();
+    long int mse_sum = 0;
+    *count = 0;
+    for (int i = 0; i < target_height; ++i) {
+      for (int j = 0; j < target_width; ++j) {
+        int m1 = M1.at<cv::Vec3b>(i, j)[1];
+        int m2 = M2.at<cv::Vec3b>(i, j)[1];
+        mse_sum += std::abs(m1 - m2);
+        if (m1 != m2) {
+          (*count)++;
+        }
+      }
+    }
+    return *count > 0 ? static_cast<double>(mse_sum) / *count : mse_sum;
+  };
+
+  std::shared_ptr<Tensor> decoded, decoded_and_cropped, expected, output;
+  DecodeOp op(true);
+  ASSERT_OK(op.Compute(raw_input_tensor_, &decoded));
+  for (const auto &box : crop_boxes) {
+    int x = box[0], y = box[1], crop_width = box[2], crop_height = box[3];
+    ASSERT_OK(Crop(decoded, &decoded_and_cropped, x, y, crop_width, crop_height));
+    for (auto mode : {InterpolationMode::kLinear, InterpolationMode::kCubicPil}) {
+      ASSERT_OK(Resize(decoded_and_cropped, &expected, target_height, target_width, 0, 0, mode));
+      long int count = 0;
+      ASSERT_OK(JpegCropDecodeResize(raw_input_tensor_, &output, x, y, crop_width, crop_height, target_height,
+                                     target_width, mode));
+      EXPECT_EQ(output->shape(), expected->shape());
+      EXPECT_EQ(get_mse(expected, output, &count), 0);
+
+      ASSERT_OK(JpegCropDecodeResize(raw_input_tensor_, &output, x, y, crop_width, crop_height, target_height,
+                                     target_width, mode, true));
+      EXPECT_EQ(output->shape(), expected->shape());
+      double mse = get_mse(expected, output, &count);
+      MS_LOG(INFO) << "mse: " << mse << std::endl;
+      if (mode == InterpolationMode::kCubicPil) {
+        EXPECT_EQ(count, 0);
+      } else {
+        EXPECT_LT(mse, kMseThreshold);
+      }
+    }
+  }
+  MS_LOG(INFO) << "RandomCropDecodeResizeOp test 3 finished";
+}
@@ -22,6 +22,7 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/core/cv_tensor.h"
 #include "minddata/dataset/core/data_type.h"
+#include "minddata/dataset/util/memory_pool.h"
 
 using namespace mindspore::dataset;
 
@@ -618,3 +619,57 @@ TEST_F(MindDataTestTensorDE, TensorEmpty) {
   t2->Invalidate();
   ASSERT_TRUE(!t2->HasData());
 }
+
+namespace {
+// A pool owning one block, counting the tensors handing it back
+class BlockPool : public MemoryPool {
+ public:
+  explicit BlockPool(int *released) : released_(released) {}
+  ~BlockPool() override = default;
+  Status Allocate(size_t, void **) override { return Status(StatusCode::kMDOutOfMemory); }
+  Status Reallocate(void **, size_t, size_t) override { return Status(StatusCode::kMDOutOfMemory); }
+  void Deallocate(void *) override { ++(*released_); }
+  uint64_t get_max_size() const override { return 0; }
+  int PercentFree() const override { return 0; }
+
+ private:
+  int *released_;
+};
+}  // namespace
+
+/// Feature: Tensor
+/// Description: Test creating Tensors on memory owned by a memory pool
+/// Expectation: The Tensors use the memory in place and hand it back to the pool when destroyed
+TEST_F(MindDataTestTensorDE, TensorFromPoolMemory) {
+  int released = 0;
+  std::vector<float> block = {1.0, 2.0, 3.0, 4.0};
+  std::weak_ptr<MemoryPool> weak_pool;
+  {
+    std::shared_ptr<MemoryPool> pool = std::make_shared<BlockPool>(&released);
+    weak_pool = pool;
+    auto *src = reinterpret_cast<uchar *>(block.data());
+    std::shared_ptr<Tensor> t;
+    Status rc = Tensor::CreateFromPoolMemory(TensorShape({2, 2}), DataType(DataType::DE_FLOAT32), pool, src,
+                                             block.size() * sizeof(float), &t);
+    ASSERT_TRUE(rc.IsOk());
+    ASSERT_EQ(t->GetBuffer(), src);
+    float o;
+    t->GetItemAt<float>(&o, {1, 0});
+    ASSERT_EQ(o, 3.0);
+    t->SetItemAt<float>({1, 1}, 5.0);
+    ASSERT_EQ(block[3], 5.0);
+
+    // The length has to match the shape
+    std::shared_ptr<Tensor> t2;
+    rc = Tensor::CreateFromPoolMemory(TensorShape({3}), DataType(DataType::DE_FLOAT32), pool, src,
+                                      block.size() * sizeof(float), &t2);
+    ASSERT_TRUE(rc.IsError());
+
+    pool.reset();
+    // The tensor keeps the pool alive
+    ASSERT_FALSE(weak_pool.expired());
+    ASSERT_EQ(released, 0);
+  }
+  ASSERT_TRUE(weak_pool.expired());
+  ASSERT_EQ(released, 1);
+}
@@ -19,6 +19,7 @@
 
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/data_schema.h"
+#include "minddata/dataset/engine/datasetops/source/tf_example_parser.h"
 #include "minddata/dataset/engine/jagged_connector.h"
 #include "common/common.h"
 #include "gtest/gtest.h"
@@ -30,6 +31,27 @@ using namespace mindspore::dataset;
 
 class MindDataTestTFReaderOp : public UT::DatasetOpTesting {};
 
+namespace {
+std::string EncodeVarint(uint64_t value) {
+  std::string out;
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+  return out;
+}
+
+std::string EncodeField(uint32_t field, const std::string &payload) {
+  return EncodeVarint(field << 3 | 2) + EncodeVarint(payload.size()) + payload;
+}
+
+// A map entry of Features.feature, holding a Feature of the given kind
+std::string EncodeFeature(const std::string &name, uint32_t kind, const std::string &list) {
+  return EncodeField(1, EncodeField(1, name) + EncodeField(2, EncodeField(kind, list)));
+}
+}  // namespace
+
 /// Feature: TFReader op
 /// Description: Test TFReaderOp with large rows per buffer
 /// Expectation: Runs successfully and equal row count
@@ -378,3 +400,42 @@ TEST_F(MindDataTestTFReaderOp, TestTotalRowsBasic) {
   TFReaderOp::CountTotalRows(&total_rows, filenames, 729, true);
   ASSERT_EQ(total_rows, 60);
 }
+
+/// Feature: TFExampleParser
+/// Description: Test decoding a tf.Example in place, with packed and unpacked values and an unused feature
+/// Expectation: The columns hold the values of the features, invalid records are rejected
+TEST_F(MindDataTestTFReaderOp, TestTFExampleParser) {
+  DataSchema schema;
+  ASSERT_OK(schema.AddColumn(ColDescriptor("image", DataType(DataType::DE_UINT8), TensorImpl::kFlexible, 1)));
+  ASSERT_OK(schema.AddColumn(ColDescriptor("score", DataType(DataType::DE_FLOAT32), TensorImpl::kFlexible, 1)));
+  ASSERT_OK(schema.AddColumn(ColDescriptor("label", DataType(DataType::DE_INT32), TensorImpl::kFlexible, 1)));
+  TFExampleParser parser(&schema);
+
+  std::vector<float> scores = {0.5, -2.0};
+  std::string packed_scores(reinterpret_cast<const char *>(scores.data()), scores.size() * sizeof(float));
+  // the labels are one varint field each instead of a packed field
+  std::string labels = EncodeVarint(1 << 3) + EncodeVarint(7) + EncodeVarint(1 << 3) + EncodeVarint(300);
+  std::string features = EncodeFeature("image", 1, EncodeField(1, "abc")) + EncodeFeature("unused", 3, "") +
+                         EncodeFeature("score", 2, EncodeField(1, packed_scores)) + EncodeFeature("label", 3, labels);
+  std::string example = EncodeField(1, features);
+
+  TensorRow row(3, nullptr);
+  ASSERT_OK(parser.Parse(reinterpret_cast<const unsigned char *>(example.data()), example.size(), &row));
+  std::shared_ptr<Tensor> expected;
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<uint8_t>{'a', 'b', 'c'}, &expected));
+  EXPECT_EQ(*row[0], *expected);
+  ASSERT_OK(Tensor::CreateFromVector(scores, &expected));
+  EXPECT_EQ(*row[1], *expected);
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<int32_t>{7, 300}, &expected));
+  EXPECT_EQ(*row[2], *expected);
+
+  // a column without feature
+  std::string no_label = EncodeField(1, EncodeFeature("image", 1, EncodeField(1, "abc")));
+  Status rc = parser.Parse(reinterpret_cast<const unsigned char *>(no_label.data()), no_label.size(), &row);
+  EXPECT_TRUE(rc.IsError());
+  EXPECT_NE(rc.ToString().find("column name: score does not exist"), std::string::npos);
+
+  // a truncated record
+  rc = parser.Parse(reinterpret_cast<const unsigned char *>(example.data()), example.size() - 1, &row);
+  EXPECT_TRUE(rc.IsError());
+}
@@ -0,0 +1,153 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "common/mem_reuse/mem_dynamic_allocator.h"
+
+namespace mindspore::device {
+constexpr size_t kHostMemUnitSize = 16 << 20;
+constexpr size_t kHostMemLimit = 256 << 20;
+
+// The memory pool on the host memory.
+class HostMemPoolStub : public DynamicMemPoolBestFit {
+ public:
+  explicit HostMemPoolStub(DynamicMemPoolMode pool_mode) {
+    set_pool_mode(pool_mode);
+    SetMemAllocUintSize(kHostMemUnitSize, kHostMemUnitSize);
+  }
+  ~HostMemPoolStub() override { ReleaseDeviceRes(); }
+
+  size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) override {
+    *addr = malloc(size);
+    if (*addr == nullptr) {
+      return 0;
+    }
+    allocated_size_ += size;
+    return size;
+  }
+  bool FreeDeviceMem(const DeviceMemPtr &addr) override {
+    free(addr);
+    return true;
+  }
+  size_t free_mem_size() override { return kHostMemLimit - allocated_size_; }
+
+ private:
+  size_t allocated_size_{0};
+};
+
+class TestDynamicMemPool : public UT::Common {
+ public:
+  TestDynamicMemPool() = default;
+};
+
+/// Feature: size class mode of dynamic memory pool.
+/// Description: alloc and free memory bufs of different sizes in both pool modes.
+/// Expectation: the memory bufs do not overlap and all the memory is idle after being freed.
+TEST_F(TestDynamicMemPool, TestAllocAndFree) {
+  for (auto pool_mode : {DynamicMemPoolMode::kBestFit, DynamicMemPoolMode::kSizeClass}) {
+    HostMemPoolStub mem_pool(pool_mode);
+    ASSERT_EQ(mem_pool.pool_mode(), pool_mode);
+    std::vector<std::pair<DeviceMemPtr, size_t>> addrs;
+    for (size_t i = 1; i <= 200; ++i) {
+      size_t size = (i * 7919) % (2 << 20) + 1;
+      auto addr = mem_pool.AllocTensorMem(size);
+      ASSERT_NE(addr, nullptr);
+      memset(addr, static_cast<int>(i), size);
+      addrs.emplace_back(addr, size);
+    }
+    for (size_t i = 0; i < addrs.size(); ++i) {
+      auto data = static_cast<uint8_t *>(addrs[i].first);
+      ASSERT_EQ(data[0], static_cast<uint8_t>(i + 1));
+      ASSERT_EQ(data[addrs[i].second - 1], static_cast<uint8_t>(i + 1));
+    }
+    for (size_t i = 0; i < addrs.size(); i += 2) {
+      mem_pool.FreeTensorMem(addrs[i].first);
+    }
+    for (size_t i = 1; i < addrs.size(); i += 2) {
+      mem_pool.FreeTensorMem(addrs[i].first);
+    }
+    ASSERT_EQ(mem_pool.TotalUsedMemStatistics(), mem_pool.ThreadCachedMemStatistics());
+    mem_pool.DumpDynamicMemPoolStateInfo();
+  }
+}
+
+/// Feature: size class mode of dynamic memory pool.
+/// Description: free a small memory buf and alloc the same size again.
+/// Expectation: the memory buf is reused from the thread cache.
+TEST_F(TestDynamicMemPool, TestThreadCacheReuse) {
+  HostMemPoolStub mem_pool(DynamicMemPoolMode::kSizeClass);
+  auto addr = mem_pool.AllocTensorMem(1000);
+  ASSERT_NE(addr, nullptr);
+  mem_pool.FreeTensorMem(addr);
+  ASSERT_GT(mem_pool.ThreadCachedMemStatistics(), 0);
+  auto reused_addr = mem_pool.AllocTensorMem(1000);
+  ASSERT_EQ(reused_addr, addr);
+  ASSERT_EQ(mem_pool.ThreadCachedMemStatistics(), 0);
+  mem_pool.FreeTensorMem(reused_addr);
+}
+
+/// Feature: size class mode of dynamic memory pool.
+/// Description: alloc continuous memory and the memory larger than the thread cache.
+/// Expectation: the continuous memory is adjacent and the memory cached by threads is reclaimed when memory is not
+/// enough.
+TEST_F(TestDynamicMemPool, TestContinuousAndReclaim) {
+  HostMemPoolStub mem_pool(DynamicMemPoolMode::kSizeClass);
+  auto addrs = mem_pool.AllocContinuousTensorMem({1024, 2048, 512});
+  ASSERT_EQ(addrs.size(), 3);
+  ASSERT_EQ(static_cast<uint8_t *>(addrs[1]) - static_cast<uint8_t *>(addrs[0]), 1024);
+  ASSERT_EQ(static_cast<uint8_t *>(addrs[2]) - static_cast<uint8_t *>(addrs[1]), 2048);
+  for (auto addr : addrs) {
+    mem_pool.FreeTensorMem(addr);
+  }
+  // The small memory bufs take two memory blocks, and the large one takes all the rest host memory.
+  std::vector<DeviceMemPtr> small_addrs;
+  for (size_t i = 0; i < 32; ++i) {
+    small_addrs.emplace_back(mem_pool.AllocTensorMem(1 << 20));
+  }
+  auto large_addr = mem_pool.AllocTensorMem(kHostMemLimit - kHostMemUnitSize * 2 - (4 << 20));
+  ASSERT_NE(large_addr, nullptr);
+  for (auto addr : small_addrs) {
+    mem_pool.FreeTensorMem(addr);
+  }
+  ASSERT_GT(mem_pool.ThreadCachedMemStatistics(), 0);
+  // Only the memory cached by the thread can be combined for this request.
+  auto medium_addr = mem_pool.AllocTensorMem(8 << 20);
+  ASSERT_NE(medium_addr, nullptr);
+  ASSERT_EQ(mem_pool.ThreadCachedMemStatistics(), 0);
+  mem_pool.FreeTensorMem(medium_addr);
+  mem_pool.FreeTensorMem(large_addr);
+}
+
+/// Feature: size class mode of dynamic memory pool.
+/// Description: the memory bufs are allocated in one thread and freed in another thread.
+/// Expectation: all the memory is idle after being freed.
+TEST_F(TestDynamicMemPool, TestCrossThreadFree) {
+  HostMemPoolStub mem_pool(DynamicMemPoolMode::kSizeClass);
+  std::vector<DeviceMemPtr> addrs;
+  for (size_t i = 0; i < 100; ++i) {
+    addrs.emplace_back(mem_pool.AllocTensorMem(512 * (i % 10 + 1)));
+  }
+  std::thread free_thread([&mem_pool, &addrs]() {
+    for (auto addr : addrs) {
+      mem_pool.FreeTensorMem(addr);
+    }
+  });
+  free_thread.join();
+  ASSERT_EQ(mem_pool.TotalUsedMemStatistics(), 0);
+}
+}  // namespace mindspore::device
@@ -21,9 +21,11 @@
 #include <vector>
 #include <string>
 #include <random>
+#include <set>
 
 #include "include/common/random.h"
 #include "distributed/embedding_cache/embedding_cache_utils.h"
+#include "distributed/embedding_cache/embedding_hash_map.h"
 
 namespace mindspore {
 namespace distributed {
@@ -94,6 +96,94 @@ TEST_F(TestEmbeddingCache, test_random_number_gen) {
   }
   ASSERT_TRUE(numbers.size() == count);
 }
+
+/// Feature: test the id -> index table of embedding hash map.
+/// Description: insert, erase and look up int64 ids with the table nearly full.
+/// Expectation: the indices of the ids are the same as a reference map.
+TEST_F(TestEmbeddingCache, test_id_index_map) {
+  const size_t max_size = 1000;
+  IdIndexMap<int64_t> id_index_map(max_size);
+  std::map<int64_t, int> ref;
+  std::mt19937_64 rng(0);
+  for (size_t round = 0; round < 20000; ++round) {
+    // The ids are larger than the maximum value of int32.
+    int64_t id = static_cast<int64_t>(rng() % (max_size * 2)) + (1LL << 40);
+    if (ref.count(id) != 0) {
+      id_index_map.Erase(id);
+      ref.erase(id);
+    } else if (ref.size() < max_size) {
+      int index = static_cast<int>(round % max_size);
+      id_index_map.Insert(id, index);
+      ref[id] = index;
+    }
+  }
+  ASSERT_EQ(id_index_map.size(), ref.size());
+
+  std::vector<int64_t> ids;
+  for (size_t i = 0; i < max_size * 2; ++i) {
+    ids.push_back(static_cast<int64_t>(i) + (1LL << 40));
+  }
+  std::vector<int> indices(ids.size());
+  id_index_map.FindBatch(ids.data(), ids.size(), indices.data());
+  for (size_t i = 0; i < ids.size(); ++i) {
+    auto iter = ref.find(ids[i]);
+    int expect = iter == ref.end() ? INVALID_INDEX_VALUE : iter->second;
+    EXPECT_EQ(indices[i], expect);
+    EXPECT_EQ(id_index_map.Find(ids[i]), expect);
+  }
+  size_t count = 0;
+  for (const auto &item : id_index_map) {
+    EXPECT_EQ(ref[item.first], item.second);
+    ++count;
+  }
+  EXPECT_EQ(count, ref.size());
+}
+
+/// Feature: test parsing a batch of ids with embedding hash map.
+/// Description: parse batches with duplicate ids until the hash map swaps out expired ids.
+/// Expectation: every id gets a unique index, and the ids swapped in and out are recorded.
+TEST_F(TestEmbeddingCache, test_embedding_hash_map_parse_batch) {
+  const size_t capacity = 10;
+  EmbeddingHashMap<int64_t> hash_map(0, capacity);
+  const size_t batch_size = 8;
+  std::vector<int> swap_in_index(batch_size);
+  std::vector<int64_t> swap_in_ids(batch_size);
+  std::vector<int> swap_out_index(batch_size);
+  std::vector<int64_t> swap_out_ids(batch_size);
+  size_t swap_in_size = 0;
+  size_t swap_out_size = 0;
+  HashMapSwapInfo<int64_t> swap_info{swap_in_index.data(), swap_in_ids.data(), &swap_in_size,
+                                     swap_out_index.data(), swap_out_ids.data(), &swap_out_size};
+  bool need_wait_graph = false;
+
+  // The first and last elements are reserved, so there are 8 positions for ids.
+  std::vector<int64_t> ids = {1, 2, 3, 2, 1, 4, 5, 6};
+  std::vector<int> indices(ids.size());
+  hash_map.Reset();
+  EXPECT_EQ(hash_map.ParseBatch(ids.data(), ids.size(), 1, 0, indices.data(), swap_info, &need_wait_graph),
+            ids.size());
+  EXPECT_EQ(swap_in_size, 6);
+  EXPECT_EQ(swap_out_size, 0);
+  EXPECT_EQ(indices[0], indices[4]);
+  EXPECT_EQ(indices[1], indices[3]);
+  EXPECT_EQ(hash_map.hash_id_to_index().size(), 6);
+
+  // The graph has finished step 1, so the ids of step 1 can be swapped out by the new ids of step 2 except id 1.
+  swap_in_size = 0;
+  ids = {7, 8, 9, 10, 1};
+  indices.resize(ids.size());
+  hash_map.Reset();
+  EXPECT_EQ(hash_map.ParseBatch(ids.data(), ids.size(), 2, 2, indices.data(), swap_info, &need_wait_graph),
+            ids.size());
+  EXPECT_EQ(swap_in_size, 4);
+  EXPECT_EQ(swap_out_size, 2);
+  EXPECT_EQ(hash_map.hash_id_to_index().size(), 8);
+  std::set<int> unique_indices(indices.begin(), indices.end());
+  EXPECT_EQ(unique_indices.size(), ids.size());
+  for (size_t i = 0; i < swap_out_size; ++i) {
+    EXPECT_EQ(hash_map.hash_id_to_index().Find(swap_out_ids[i]), INVALID_INDEX_VALUE);
+  }
+}
 }  // namespace persistent
 }  // namespace distributed
 }  // namespace mindspore
@@ -0,0 +1,133 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "distributed/embedding_cache/embedding_store.h"
+#include "distributed/persistent/storage/constants.h"
+
+namespace mindspore {
+namespace distributed {
+namespace {
+constexpr size_t kEmbDim = 4;
+constexpr char kStorePath[] = "./embedding_store_test";
+
+std::vector<float> MakeRows(const std::vector<int32_t> &keys, float version) {
+  std::vector<float> rows;
+  for (auto key : keys) {
+    for (size_t i = 0; i < kEmbDim; ++i) {
+      rows.push_back(static_cast<float>(key) * 10 + static_cast<float>(i) + version);
+    }
+  }
+  return rows;
+}
+
+std::vector<int32_t> MakeKeys(int32_t begin, int32_t end) {
+  std::vector<int32_t> keys;
+  for (int32_t key = begin; key < end; ++key) {
+    keys.push_back(key);
+  }
+  return keys;
+}
+
+bool FileExists(const std::string &file_name) {
+  std::ifstream ifs(file_name);
+  return ifs.good();
+}
+}  // namespace
+
+class TestEmbeddingStore : public UT::Common {
+ public:
+  TestEmbeddingStore() = default;
+  void SetUp() override { (void)setenv(kEnvEmbeddingStorePath, kStorePath, 1); }
+  void TearDown() override { (void)unsetenv(kEnvEmbeddingStorePath); }
+};
+
+/// Feature: embedding store.
+/// Description: put rows into the hot tier of an embedding store, get them and the rows never put.
+/// Expectation: the rows put are got back, the rows never put are left untouched.
+TEST_F(TestEmbeddingStore, TestGetPut) {
+  EmbeddingStore<int32_t, float> emb_store("get_put", 8, kEmbDim);
+  ASSERT_TRUE(emb_store.Initialize());
+  auto keys = MakeKeys(0, 4);
+  auto rows = MakeRows(keys, 0.5);
+  ASSERT_TRUE(emb_store.Put(keys.size(), keys.data(), rows.data()));
+  EXPECT_EQ(emb_store.size(), keys.size());
+
+  std::vector<int32_t> get_keys = {3, 100, 1};
+  std::vector<float> values(get_keys.size() * kEmbDim, -1);
+  ASSERT_TRUE(emb_store.Get(get_keys.size(), get_keys.data(), values.data()));
+  auto expect = MakeRows({3}, 0.5);
+  expect.insert(expect.end(), kEmbDim, -1);
+  auto row1 = MakeRows({1}, 0.5);
+  expect.insert(expect.end(), row1.begin(), row1.end());
+  EXPECT_EQ(values, expect);
+
+  // overwrite a row
+  std::vector<int32_t> update_key = {1};
+  auto update_row = MakeRows(update_key, 0.25);
+  ASSERT_TRUE(emb_store.Put(update_key.size(), update_key.data(), update_row.data()));
+  std::vector<float> update_value(kEmbDim);
+  ASSERT_TRUE(emb_store.Get(update_key.size(), update_key.data(), update_value.data()));
+  EXPECT_EQ(update_value, update_row);
+  EXPECT_EQ(emb_store.size(), keys.size());
+  EXPECT_TRUE(emb_store.Finalize());
+}
+
+/// Feature: embedding store.
+/// Description: put much more rows than the capacity of the hot tier, overwrite some of them, flush and compact.
+/// Expectation: the rows evicted are persisted in the disk tier and got back with their latest values, the disk files
+/// are removed when the store is finalized.
+TEST_F(TestEmbeddingStore, TestPersistence) {
+  constexpr size_t capacity = 16;
+  EmbeddingStore<int32_t, float> emb_store("persistence", capacity, kEmbDim);
+  ASSERT_TRUE(emb_store.Initialize());
+  auto segment_file = std::string(kStorePath) + "/persistence_" + std::to_string(getpid()) + "/" +
+                      storage::kBlockFilePrefix + "0";
+  ASSERT_TRUE(FileExists(segment_file));
+
+  auto keys = MakeKeys(0, 200);
+  auto rows = MakeRows(keys, 0.5);
+  constexpr size_t batch = 10;
+  for (size_t i = 0; i < keys.size(); i += batch) {
+    ASSERT_TRUE(emb_store.Put(batch, keys.data() + i, rows.data() + i * kEmbDim));
+  }
+  EXPECT_EQ(emb_store.size(), keys.size());
+
+  auto update_keys = MakeKeys(50, 150);
+  auto update_rows = MakeRows(update_keys, 0.75);
+  ASSERT_TRUE(emb_store.Put(update_keys.size(), update_keys.data(), update_rows.data()));
+  ASSERT_TRUE(emb_store.Flush());
+  ASSERT_TRUE(emb_store.Compact());
+  EXPECT_EQ(emb_store.size(), keys.size());
+
+  std::vector<float> values(keys.size() * kEmbDim);
+  ASSERT_TRUE(emb_store.Get(keys.size(), keys.data(), values.data()));
+  auto expect = MakeRows(MakeKeys(0, 50), 0.5);
+  expect.insert(expect.end(), update_rows.begin(), update_rows.end());
+  auto tail_rows = MakeRows(MakeKeys(150, 200), 0.5);
+  expect.insert(expect.end(), tail_rows.begin(), tail_rows.end());
+  EXPECT_EQ(values, expect);
+
+  EXPECT_TRUE(emb_store.Finalize());
+  EXPECT_FALSE(FileExists(segment_file));
+}
+}  // namespace distributed
+}  // namespace mindspore
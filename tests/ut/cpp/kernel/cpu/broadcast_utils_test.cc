@@ -0,0 +1,188 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "plugin/device/cpu/kernel/cpu_kernel.h"
+#include "plugin/device/cpu/kernel/utils/broadcast_utils.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr size_t kBenchmarkRounds = 20;
+
+struct BroadcastCase {
+  std::string name;
+  ShapeVector shape_a;
+  ShapeVector shape_b;
+  ShapeVector output_shape;
+};
+
+// The common broadcast shapes of the large tensors
+const std::vector<BroadcastCase> kLargeShapeCases = {{"same shape", {64, 4096}, {64, 4096}, {64, 4096}},
+                                                     {"scalar", {64, 4096}, {}, {64, 4096}},
+                                                     {"row", {64, 4096}, {4096}, {64, 4096}},
+                                                     {"column", {64, 4096}, {64, 1}, {64, 4096}},
+                                                     {"general", {32, 64, 128}, {32, 1, 128}, {32, 64, 128}},
+                                                     {"outer product", {512, 1}, {1, 512}, {512, 512}}};
+
+size_t ElementNum(const ShapeVector &shape) {
+  size_t num = 1;
+  for (auto dim : shape) {
+    num *= static_cast<size_t>(dim);
+  }
+  return num;
+}
+
+// The output computed with BroadcastIterator, which the plan must match
+void IteratorAdd(const ShapeVector &shape_a, const ShapeVector &shape_b, const ShapeVector &output_shape,
+                 const std::vector<float> &a, const std::vector<float> &b, std::vector<float> *out) {
+  out->resize(ElementNum(output_shape));
+  BroadcastIterator iter(shape_a, shape_b, output_shape);
+  iter.SetPos(0);
+  for (size_t i = 0; i < out->size(); ++i) {
+    (*out)[i] = a[iter.GetInputPosA()] + b[iter.GetInputPosB()];
+    iter.GenNextPos();
+  }
+}
+}  // namespace
+
+class TestBroadcastUtils : public UT::Common {
+ public:
+  TestBroadcastUtils() = default;
+};
+
+/// Feature: broadcast plan of the elementwise cpu kernels.
+/// Description: classify the common broadcast shapes.
+/// Expectation: the dims broadcast the same way are collapsed and the right pattern is picked.
+TEST_F(TestBroadcastUtils, TestBroadcastPattern) {
+  auto pattern = [](const ShapeVector &shape_a, const ShapeVector &shape_b, const ShapeVector &output_shape) {
+    BroadcastPlan plan;
+    plan.Init(shape_a, shape_b, output_shape);
+    return plan.pattern();
+  };
+  EXPECT_EQ(pattern({2, 3, 4}, {2, 3, 4}, {2, 3, 4}), BroadcastPattern::kSameShape);
+  EXPECT_EQ(pattern({1, 3, 4}, {3, 4}, {1, 3, 4}), BroadcastPattern::kSameShape);
+  EXPECT_EQ(pattern({}, {2, 3}, {2, 3}), BroadcastPattern::kScalarA);
+  EXPECT_EQ(pattern({2, 3}, {1, 1}, {2, 3}), BroadcastPattern::kScalarB);
+  EXPECT_EQ(pattern({2, 3, 4, 5}, {4, 5}, {2, 3, 4, 5}), BroadcastPattern::kRowBroadcast);
+  EXPECT_EQ(pattern({1, 5}, {4, 5}, {4, 5}), BroadcastPattern::kRowBroadcast);
+  EXPECT_EQ(pattern({2, 3, 4, 5}, {2, 3, 1, 1}, {2, 3, 4, 5}), BroadcastPattern::kColumnBroadcast);
+  EXPECT_EQ(pattern({2, 1, 5}, {2, 3, 5}, {2, 3, 5}), BroadcastPattern::kGeneral);
+  EXPECT_EQ(pattern({3, 1}, {1, 4}, {3, 4}), BroadcastPattern::kGeneral);
+}
+
+/// Feature: broadcast plan of the elementwise cpu kernels.
+/// Description: run random broadcasts split in random ranges, like the tasks of ParallelLaunch.
+/// Expectation: the output is the same as with BroadcastIterator.
+TEST_F(TestBroadcastUtils, TestBroadcastPlanMatchIterator) {
+  std::mt19937 gen(0);
+  for (size_t round = 0; round < 2000; ++round) {
+    ShapeVector output_shape(gen() % 5 + 1);
+    for (auto &dim : output_shape) {
+      dim = static_cast<int64_t>(gen() % 4 + 1);
+    }
+    ShapeVector shape_a(output_shape.end() - gen() % (output_shape.size() + 1), output_shape.end());
+    ShapeVector shape_b(output_shape.begin(), output_shape.end());
+    for (auto &dim : shape_a) {
+      dim = gen() % 2 == 0 ? 1 : dim;
+    }
+    for (auto &dim : shape_b) {
+      dim = gen() % 2 == 0 ? 1 : dim;
+    }
+    // keep only the dims of the output which are in an input
+    size_t offset = shape_b.size() - shape_a.size();
+    for (size_t i = 0; i < output_shape.size(); ++i) {
+      output_shape[i] = std::max(shape_b[i], i < offset ? 1 : shape_a[i - offset]);
+    }
+    std::vector<float> a(ElementNum(shape_a));
+    std::vector<float> b(ElementNum(shape_b));
+    for (size_t i = 0; i < a.size(); ++i) {
+      a[i] = static_cast<float>(i);
+    }
+    for (size_t i = 0; i < b.size(); ++i) {
+      b[i] = static_cast<float>(i * 1000);
+    }
+    BroadcastPlan plan;
+    plan.Init(shape_a, shape_b, output_shape);
+    std::vector<float> out(plan.output_size());
+    size_t split = gen() % (out.size() + 1);
+    plan.Run(a.data(), b.data(), out.data(), 0, split, [](float x, float y) { return x + y; });
+    plan.Run(a.data(), b.data(), out.data(), split, out.size(), [](float x, float y) { return x + y; });
+    std::vector<float> expect;
+    IteratorAdd(shape_a, shape_b, output_shape, a, b, &expect);
+    ASSERT_EQ(out, expect);
+  }
+}
+
+/// Feature: broadcast plan of the elementwise cpu kernels.
+/// Description: run an add with the common broadcast shapes of the large tensors.
+/// Expectation: the plan gives the same output as BroadcastIterator.
+TEST_F(TestBroadcastUtils, TestBroadcastPlanLargeShape) {
+  for (auto &c : kLargeShapeCases) {
+    std::vector<float> a(ElementNum(c.shape_a));
+    std::vector<float> b(ElementNum(c.shape_b));
+    for (size_t i = 0; i < a.size(); ++i) {
+      a[i] = static_cast<float>(i);
+    }
+    for (size_t i = 0; i < b.size(); ++i) {
+      b[i] = static_cast<float>(i % 1000) * 0.5f;
+    }
+    std::vector<float> expect;
+    IteratorAdd(c.shape_a, c.shape_b, c.output_shape, a, b, &expect);
+    BroadcastPlan plan;
+    plan.Init(c.shape_a, c.shape_b, c.output_shape);
+    std::vector<float> out(ElementNum(c.output_shape));
+    plan.Run(a.data(), b.data(), out.data(), 0, out.size(), [](float x, float y) { return x + y; });
+    ASSERT_EQ(out, expect) << c.name;
+  }
+}
+
+/// Feature: broadcast plan of the elementwise cpu kernels.
+/// Description: measure the elements per second of an add with the common broadcast shapes, it is a benchmark run by
+/// --gtest_also_run_disabled_tests --gtest_filter=TestBroadcastUtils.DISABLED_BroadcastPlanThroughput.
+/// Expectation: the plan gives the same output as BroadcastIterator, the throughput of both is logged.
+TEST_F(TestBroadcastUtils, DISABLED_BroadcastPlanThroughput) {
+  for (auto &c : kLargeShapeCases) {
+    std::vector<float> a(ElementNum(c.shape_a), 1.0);
+    std::vector<float> b(ElementNum(c.shape_b), 2.0);
+    std::vector<float> out(ElementNum(c.output_shape));
+    std::vector<float> expect;
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < kBenchmarkRounds; ++round) {
+      IteratorAdd(c.shape_a, c.shape_b, c.output_shape, a, b, &expect);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    BroadcastPlan plan;
+    plan.Init(c.shape_a, c.shape_b, c.output_shape);
+    for (size_t round = 0; round < kBenchmarkRounds; ++round) {
+      plan.Run(a.data(), b.data(), out.data(), 0, out.size(), [](float x, float y) { return x + y; });
+    }
+    auto end = std::chrono::steady_clock::now();
+    ASSERT_EQ(out, expect) << c.name;
+    double elements = static_cast<double>(out.size() * kBenchmarkRounds);
+    double iterator_seconds = std::chrono::duration<double>(middle - begin).count();
+    double plan_seconds = std::chrono::duration<double>(end - middle).count();
+    MS_LOG(WARNING) << c.name << ": BroadcastIterator " << elements / iterator_seconds << " elem/s, BroadcastPlan "
+                    << elements / plan_seconds << " elem/s.";
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
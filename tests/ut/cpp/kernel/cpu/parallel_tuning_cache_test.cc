@@ -0,0 +1,102 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "common/common_test.h"
+#include "plugin/device/cpu/kernel/parallel_tuning_cache.h"
+
+namespace mindspore {
+namespace kernel {
+class TestParallelTuningCache : public UT::Common {
+ public:
+  TestParallelTuningCache() = default;
+
+  void SetUp() override {
+    (void)std::remove(cache_path_.c_str());
+    (void)ParallelTuningCache::GetInstance().Load(cache_path_);
+  }
+
+  void TearDown() override { (void)std::remove(cache_path_.c_str()); }
+
+ protected:
+  std::string cache_path_{"./parallel_tuning_cache_test.txt"};
+};
+
+/// Feature: tuning cache of the parallel launches of the cpu kernels.
+/// Description: record several results of the same key.
+/// Expectation: the block size of the fastest result is kept.
+TEST_F(TestParallelTuningCache, TestUpdateKeepFastest) {
+  auto &cache = ParallelTuningCache::GetInstance();
+  auto key = ParallelTuningCache::SearchKey("Add(Float32,Float32)->Float32", 4096, 8);
+  float block_size = 0;
+  EXPECT_FALSE(cache.Find(key, &block_size));
+  cache.Update(key, 1024, 2.0);
+  cache.Update(key, 512, 1.0);
+  cache.Update(key, 256, 3.0);
+  ASSERT_TRUE(cache.Find(key, &block_size));
+  EXPECT_EQ(block_size, 512);
+  EXPECT_FALSE(cache.Find(ParallelTuningCache::SearchKey("Add(Float32,Float32)->Float32", 4096, 4), &block_size));
+}
+
+/// Feature: tuning cache of the parallel launches of the cpu kernels.
+/// Description: save the results to a file and load it again, then load a file of another format.
+/// Expectation: the results are the same after the round trip, and the file of another format is ignored.
+TEST_F(TestParallelTuningCache, TestSaveAndLoad) {
+  auto &cache = ParallelTuningCache::GetInstance();
+  auto add_key = ParallelTuningCache::SearchKey("Add(Float32,Float32)->Float32", 4096, 8);
+  auto relu_key = ParallelTuningCache::SearchKey("ReLU(Float16)->Float16", 100, 8);
+  cache.Update(add_key, 512, 1.0);
+  cache.Update(relu_key, 12.5, 0.5);
+  cache.Save();
+
+  ASSERT_TRUE(cache.Load(cache_path_));
+  EXPECT_EQ(cache.size(), 2);
+  float block_size = 0;
+  ASSERT_TRUE(cache.Find(add_key, &block_size));
+  EXPECT_EQ(block_size, 512);
+  ASSERT_TRUE(cache.Find(relu_key, &block_size));
+  EXPECT_EQ(block_size, 12.5);
+
+  {
+    std::ofstream ofs(cache_path_, std::ios::out | std::ios::trunc);
+    ofs << add_key << "\t512\t1.0\n";
+  }
+  EXPECT_FALSE(cache.Load(cache_path_));
+  EXPECT_EQ(cache.size(), 0);
+}
+
+/// Feature: tuning cache of the parallel launches of the cpu kernels.
+/// Description: nest the kernel guards of the current thread.
+/// Expectation: the kernel of the outer guard is restored when the inner one ends.
+TEST_F(TestParallelTuningCache, TestKernelGuard) {
+  std::string outer = "Add(Float32,Float32)->Float32";
+  std::string inner = "ReLU(Float32)->Float32";
+  EXPECT_EQ(ParallelTuningCache::CurrentKernel(), nullptr);
+  {
+    ParallelTuningKernelGuard outer_guard(&outer);
+    EXPECT_EQ(ParallelTuningCache::CurrentKernel(), &outer);
+    {
+      ParallelTuningKernelGuard inner_guard(&inner);
+      EXPECT_EQ(ParallelTuningCache::CurrentKernel(), &inner);
+    }
+    EXPECT_EQ(ParallelTuningCache::CurrentKernel(), &outer);
+  }
+  EXPECT_EQ(ParallelTuningCache::CurrentKernel(), nullptr);
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,302 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include "distributed/cluster/topology/compute_graph_node.h"
+#include "distributed/cluster/topology/meta_server_node.h"
+#include "plugin/device/cpu/hal/hardware/ms_collective_topo.h"
+#include "plugin/device/cpu/hal/hardware/ms_collective_ops_impl.h"
+#include "utils/ms_utils.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+using distributed::cluster::topology::ComputeGraphNode;
+using distributed::cluster::topology::MetaServerNode;
+using distributed::cluster::topology::TopoState;
+
+class TestMSCollectiveOpsImpl : public UT::Common {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+
+  // Start the meta server and a topology node for each of the given ips, the ranks with the same ip are taken as on
+  // the same host. An empty ip is the ip of the first network interface.
+  void StartCluster(const std::string &server_port, const std::vector<std::string> &ips) {
+    std::string server_host = "127.0.0.1";
+    common::SetEnv(distributed::cluster::topology::kEnvMetaServerHost, server_host.c_str());
+    common::SetEnv(distributed::cluster::topology::kEnvMetaServerPort, server_port.c_str());
+
+    size_t total_node_num = ips.size();
+    msn_ = std::make_unique<MetaServerNode>("meta_server_node", "scheduler", total_node_num);
+    ASSERT_TRUE(msn_->Initialize());
+    for (size_t i = 0; i < total_node_num; ++i) {
+      auto cgn = std::make_shared<ComputeGraphNode>("compute_graph_node_" + std::to_string(i + 1), "worker");
+      ASSERT_TRUE(cgn->Initialize());
+      cgns_.push_back(cgn);
+    }
+
+    size_t interval = 1;
+    size_t retry = 30;
+    while (((msn_->GetAliveNodeNum() != total_node_num) || (msn_->TopologyState() != TopoState::kInitialized)) &&
+           (retry-- > 0)) {
+      sleep(interval);
+    }
+    ASSERT_EQ(total_node_num, msn_->GetAliveNodeNum());
+
+    // The nodes are put into the rank order, the rank ids are assigned by the meta server.
+    topo_nodes_.resize(total_node_num);
+    for (size_t i = 0; i < total_node_num; ++i) {
+      auto rank_id = cgns_[i]->rank_id();
+      ASSERT_LT(rank_id, total_node_num);
+      topo_nodes_[rank_id] = std::make_shared<TopologyNode>(total_node_num, cgns_[i], ips[rank_id]);
+      ASSERT_TRUE(topo_nodes_[rank_id]->Initialize());
+    }
+    for (size_t i = 0; i < total_node_num; ++i) {
+      ASSERT_TRUE(topo_nodes_[i]->Initialized());
+      ops_.push_back(std::make_unique<MSCollectiveOpsImpl>(topo_nodes_[i]));
+      ASSERT_TRUE(ops_[i]->Initialize());
+    }
+  }
+
+  void StopCluster() {
+    ops_.clear();
+    for (auto &node : topo_nodes_) {
+      node->Finalize();
+    }
+    topo_nodes_.clear();
+    for (auto &cgn : cgns_) {
+      cgn->Finalize();
+    }
+    cgns_.clear();
+
+    size_t interval = 1;
+    size_t retry = 30;
+    while ((msn_->GetAliveNodeNum() > 0 || msn_->TopologyState() != TopoState::kFinished) && retry-- > 0) {
+      sleep(interval);
+    }
+    msn_->Finalize();
+    msn_.reset();
+  }
+
+  // Run AllReduce of the given size on the ranks of the group at the same time with the given algorithm, the group is
+  // all the ranks if it is empty.
+  void CheckAllReduce(AllReduceAlgorithm algorithm, size_t count, std::vector<uint32_t> group_ranks = {}) {
+    if (group_ranks.empty()) {
+      group_ranks.resize(ops_.size());
+      std::iota(group_ranks.begin(), group_ranks.end(), 0);
+    }
+    size_t group_size = group_ranks.size();
+    std::vector<std::vector<float>> inputs(group_size, std::vector<float>(count));
+    std::vector<std::vector<float>> outputs(group_size, std::vector<float>(count));
+    std::vector<float> expect(count, 0);
+    for (size_t i = 0; i < group_size; ++i) {
+      ops_[group_ranks[i]]->set_allreduce_algorithm(algorithm);
+      for (size_t j = 0; j < count; ++j) {
+        inputs[i][j] = static_cast<float>(group_ranks[i] + j % 7);
+        expect[j] += inputs[i][j];
+      }
+    }
+    // Run twice, the second run reuses the shared memory of the hosts.
+    const size_t rounds = 2;
+    for (size_t round = 0; round < rounds; ++round) {
+      std::vector<std::thread> threads;
+      std::vector<int> results(group_size, 0);
+      for (size_t i = 0; i < group_size; ++i) {
+        threads.emplace_back([&, i]() {
+          results[i] =
+            ops_[group_ranks[i]]->AllReduce<float>("test", inputs[i].data(), outputs[i].data(), count, group_ranks);
+        });
+      }
+      for (auto &thread : threads) {
+        thread.join();
+      }
+      for (size_t i = 0; i < group_size; ++i) {
+        ASSERT_TRUE(results[i]);
+        ASSERT_EQ(expect, outputs[i]);
+      }
+    }
+  }
+
+  std::unique_ptr<MetaServerNode> msn_;
+  std::vector<std::shared_ptr<ComputeGraphNode>> cgns_;
+  std::vector<std::shared_ptr<TopologyNode>> topo_nodes_;
+  std::vector<std::unique_ptr<MSCollectiveOpsImpl>> ops_;
+};
+
+/// Feature: AllReduce algorithms of the cpu collective communication.
+/// Description: run AllReduce between ranks on the same host connected by tcp, with each algorithm and message size.
+/// Expectation: all the ranks get the sum of the data.
+TEST_F(TestMSCollectiveOpsImpl, AllReduceAlgorithms) {
+  StartCluster("8091", std::vector<std::string>(6, ""));
+  std::vector<AllReduceAlgorithm> algorithms = {AllReduceAlgorithm::kAuto, AllReduceAlgorithm::kRing,
+                                                AllReduceAlgorithm::kHalvingDoubling,
+                                                AllReduceAlgorithm::kHierarchical};
+  std::vector<size_t> counts = {1, 1000, 100000, 1000000};
+  for (auto algorithm : algorithms) {
+    for (auto count : counts) {
+      CheckAllReduce(algorithm, count);
+    }
+  }
+  StopCluster();
+}
+
+/// Feature: hierarchical AllReduce of the cpu collective communication.
+/// Description: simulate 3 hosts by the tcp servers of the ranks listening on different loopback ips, with 3, 2 and
+/// 1 ranks on them, and the ranks of a host not next to each other. Run AllReduce with each algorithm.
+/// Expectation: the ranks are grouped by their ips, and all the ranks get the sum of the data.
+TEST_F(TestMSCollectiveOpsImpl, AllReduceMultiHost) {
+  std::vector<std::string> ips = {"127.0.0.1", "127.0.0.2", "127.0.0.1", "127.0.0.3", "127.0.0.2", "127.0.0.1"};
+  StartCluster("8092", ips);
+  for (size_t i = 0; i < ips.size(); ++i) {
+    for (size_t j = 0; j < ips.size(); ++j) {
+      ASSERT_EQ(topo_nodes_[i]->GetRankHost(j), ips[j]);
+    }
+  }
+  std::vector<AllReduceAlgorithm> algorithms = {AllReduceAlgorithm::kAuto, AllReduceAlgorithm::kRing,
+                                                AllReduceAlgorithm::kHalvingDoubling,
+                                                AllReduceAlgorithm::kHierarchical};
+  // Below and above the size reduced by halving and doubling between the hosts.
+  std::vector<size_t> counts = {1, 1000, 100000};
+  for (auto algorithm : algorithms) {
+    for (auto count : counts) {
+      CheckAllReduce(algorithm, count);
+    }
+  }
+  StopCluster();
+}
+
+/// Feature: AllReduce of a communication group of the cpu collective communication.
+/// Description: run AllReduce only on the ranks 4, 1 and 3 of 6 ranks, in this group order, with each algorithm, and
+/// with a group which does not have the rank of the process.
+/// Expectation: the ranks of the group get the sum of their data, and the group without the rank is rejected.
+TEST_F(TestMSCollectiveOpsImpl, AllReduceSubGroup) {
+  StartCluster("8093", std::vector<std::string>(6, ""));
+  std::vector<uint32_t> group_ranks = {4, 1, 3};
+  std::vector<AllReduceAlgorithm> algorithms = {AllReduceAlgorithm::kAuto, AllReduceAlgorithm::kRing,
+                                                AllReduceAlgorithm::kHalvingDoubling,
+                                                AllReduceAlgorithm::kHierarchical};
+  std::vector<size_t> counts = {1, 1000, 1000000};
+  for (auto algorithm : algorithms) {
+    for (auto count : counts) {
+      CheckAllReduce(algorithm, count, group_ranks);
+    }
+  }
+
+  std::vector<float> data(10, 1);
+  EXPECT_FALSE(ops_[0]->AllReduce<float>("test", data.data(), data.data(), data.size(), group_ranks));
+  EXPECT_FALSE(ops_[4]->AllReduce<float>("test", data.data(), data.data(), data.size(), {4, 6}));
+  StopCluster();
+}
+
+/// Feature: AllReduce algorithms of the cpu collective communication.
+/// Description: fork a process for each of 4 ranks on this host and time AllReduce of each algorithm and message size
+/// between them. It is a benchmark run by --gtest_also_run_disabled_tests
+/// --gtest_filter=TestMSCollectiveOpsImpl.DISABLED_AllReduceMultiProcess.
+/// Expectation: all the ranks get the sum of the data, the time of each algorithm is logged by rank 0.
+TEST_F(TestMSCollectiveOpsImpl, DISABLED_AllReduceMultiProcess) {
+  std::string server_host = "127.0.0.1";
+  std::string server_port = "8094";
+  common::SetEnv(distributed::cluster::topology::kEnvMetaServerHost, server_host.c_str());
+  common::SetEnv(distributed::cluster::topology::kEnvMetaServerPort, server_port.c_str());
+
+  const size_t total_node_num = 4;
+  const size_t rounds = 20;
+  std::vector<pid_t> pids;
+  for (size_t i = 0; i < total_node_num; ++i) {
+    pid_t pid = fork();
+    ASSERT_LE(0, pid);
+    if (pid > 0) {
+      pids.push_back(pid);
+      continue;
+    }
+
+    // The rank process exits with the status of the benchmark instead of returning to the test.
+    auto cgn = std::make_shared<ComputeGraphNode>("compute_graph_node_" + std::to_string(i + 1), "worker");
+    if (!cgn->Initialize()) {
+      _exit(1);
+    }
+    while (!cgn->Initialized()) {
+      sleep(1);
+    }
+    auto topo_node = std::make_shared<TopologyNode>(total_node_num, cgn);
+    if (!topo_node->Initialize() || !topo_node->Initialized()) {
+      _exit(1);
+    }
+    auto ops = std::make_unique<MSCollectiveOpsImpl>(topo_node);
+    if (!ops->Initialize()) {
+      _exit(1);
+    }
+
+    int status = 0;
+    auto rank_id = cgn->rank_id();
+    std::vector<std::pair<AllReduceAlgorithm, std::string>> algorithms = {
+      {AllReduceAlgorithm::kRing, "ring"},
+      {AllReduceAlgorithm::kHalvingDoubling, "halving doubling"},
+      {AllReduceAlgorithm::kHierarchical, "hierarchical"}};
+    std::vector<size_t> counts = {256, 16384, 262144, 4194304};
+    for (const auto &[algorithm, name] : algorithms) {
+      ops->set_allreduce_algorithm(algorithm);
+      for (auto count : counts) {
+        std::vector<float> input(count, static_cast<float>(rank_id + 1));
+        std::vector<float> output(count);
+        // The first run connects the ranks and maps the shared memory, it is not timed.
+        bool success = ops->AllReduce<float>("benchmark", input.data(), output.data(), count);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t round = 0; round < rounds; ++round) {
+          success = success && ops->AllReduce<float>("benchmark", input.data(), output.data(), count);
+        }
+        auto cost = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        float expect = static_cast<float>(total_node_num * (total_node_num + 1) / 2);
+        if (!success || output != std::vector<float>(count, expect)) {
+          status = 1;
+        }
+        if (rank_id == 0) {
+          MS_LOG(WARNING) << "AllReduce " << name << " of " << total_node_num << " processes, " << count
+                          << " floats: " << cost / rounds << " us";
+        }
+      }
+    }
+    ops.reset();
+    (void)topo_node->Finalize();
+    (void)cgn->Finalize();
+    _exit(status);
+  }
+
+  MetaServerNode msn("meta_server_node", "scheduler", total_node_num);
+  ASSERT_TRUE(msn.Initialize());
+  for (auto pid : pids) {
+    int status = -1;
+    ASSERT_EQ(pid, waitpid(pid, &status, 0));
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(0, WEXITSTATUS(status));
+  }
+  size_t interval = 1;
+  size_t retry = 30;
+  while ((msn.GetAliveNodeNum() > 0 || msn.TopologyState() != TopoState::kFinished) && retry-- > 0) {
+    sleep(interval);
+  }
+  msn.Finalize();
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,121 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "common/common_test.h"
+#include "runtime/graph_scheduler/actor/actor_trace.h"
+
+namespace mindspore {
+namespace runtime {
+class ActorTraceTest : public UT::Common {
+ public:
+  ActorTraceTest() = default;
+
+  void TearDown() override {
+    ActorTrace::Disable();
+    (void)std::remove(trace_path_.c_str());
+  }
+
+ protected:
+  nlohmann::json ExportAndLoad() {
+    EXPECT_TRUE(ActorTrace::Export(trace_path_));
+    std::ifstream ifs(trace_path_);
+    return nlohmann::json::parse(ifs);
+  }
+
+  std::vector<nlohmann::json> CompleteEvents(const nlohmann::json &trace) {
+    std::vector<nlohmann::json> events;
+    for (const auto &event : trace["traceEvents"]) {
+      if (event["ph"] == "X") {
+        events.push_back(event);
+      }
+    }
+    return events;
+  }
+
+  std::string trace_path_{"./actor_trace_test.json"};
+};
+
+/// Feature: trace of the actor runtime.
+/// Description: record events on several threads, with the trace disabled and then enabled, and export them.
+/// Expectation: only the events recorded when enabled are exported, on the lane of their thread and category.
+TEST_F(ActorTraceTest, RecordAndExport) {
+  ActorTrace::Disable();
+  ActorTrace::Record(kTraceLaunch, "disabled", 1, 2);
+  ActorTrace::Enable();
+
+  const size_t thread_num = 4;
+  const size_t event_num = 100;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < thread_num; ++i) {
+    threads.emplace_back([i]() {
+      for (size_t j = 0; j < event_num; ++j) {
+        auto start = ActorTrace::Now();
+        ActorTrace::Record(j % 2 == 0 ? kTraceMailboxWait : kTraceActorRun, "kernel_\"" + std::to_string(i), start,
+                           start + 1000);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  {
+    std::string step_name = "step";
+    ActorTraceScope scope(kTraceStep, step_name);
+  }
+
+  auto events = CompleteEvents(ExportAndLoad());
+  ASSERT_EQ(events.size(), thread_num * event_num + 1);
+  std::set<int64_t> tids;
+  for (const auto &event : events) {
+    EXPECT_NE(event["name"], "disabled");
+    EXPECT_EQ(event["pid"] == 2, event["cat"] == kTraceMailboxWait);
+    EXPECT_GE(event["ts"].get<double>(), 0);
+    if (event["cat"] == kTraceActorRun) {
+      EXPECT_DOUBLE_EQ(event["dur"].get<double>(), 1.0);
+    }
+    (void)tids.insert(event["tid"].get<int64_t>());
+  }
+  EXPECT_EQ(tids.size(), thread_num + 1);
+}
+
+/// Feature: trace of the actor runtime.
+/// Description: record more events than the ring buffer of a thread keeps, and enable the trace again.
+/// Expectation: the latest events are kept, and enabling the trace again drops the recorded events.
+TEST_F(ActorTraceTest, RingBufferOverwrite) {
+  ActorTrace::Enable();
+  const size_t event_num = 20000;
+  for (size_t i = 0; i < event_num; ++i) {
+    ActorTrace::Record(kTraceLaunch, "launch", i, i + 1);
+  }
+  auto events = CompleteEvents(ExportAndLoad());
+  ASSERT_FALSE(events.empty());
+  EXPECT_LT(events.size(), event_num);
+  // The timestamps start from the oldest event kept, and the latest event is kept.
+  EXPECT_DOUBLE_EQ(events.front()["ts"].get<double>(), 0);
+  EXPECT_DOUBLE_EQ(events.back()["ts"].get<double>(), (events.size() - 1) / 1000.0);
+
+  ActorTrace::Enable();
+  EXPECT_TRUE(CompleteEvents(ExportAndLoad()).empty());
+}
+}  // namespace runtime
+}  // namespace mindspore
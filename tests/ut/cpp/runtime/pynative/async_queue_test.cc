@@ -0,0 +1,187 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/pynative/async/async_queue.h"
+
+namespace mindspore {
+namespace pynative {
+namespace {
+constexpr size_t kTinyOpSize = 16;
+
+// A tiny element-wise add, like the ops dominated by the dispatch cost in PyNative.
+class TinyAddTask : public AsyncTask {
+ public:
+  TinyAddTask(const std::vector<float> *x, const std::vector<float> *y, std::vector<float> *out,
+              std::vector<size_t> *run_order, size_t index)
+      : AsyncTask(kOpRunTask), x_(x), y_(y), out_(out), run_order_(run_order), index_(index) {}
+  ~TinyAddTask() override = default;
+
+  void Run() override {
+    for (size_t i = 0; i < kTinyOpSize; ++i) {
+      (*out_)[i] = (*x_)[i] + (*y_)[i];
+    }
+    run_order_->push_back(index_);
+  }
+
+ private:
+  const std::vector<float> *x_;
+  const std::vector<float> *y_;
+  std::vector<float> *out_;
+  std::vector<size_t> *run_order_;
+  size_t index_;
+};
+
+class ThrowTask : public AsyncTask {
+ public:
+  ThrowTask() : AsyncTask(kOpRunTask) {}
+  ~ThrowTask() override = default;
+  void Run() override { throw std::runtime_error("Run task failed in test."); }
+};
+
+class BpropTask : public AsyncTask {
+ public:
+  explicit BpropTask(std::vector<size_t> *run_order, size_t index)
+      : AsyncTask(kBpropTask), run_order_(run_order), index_(index) {}
+  ~BpropTask() override = default;
+  void Run() override { run_order_->push_back(index_); }
+
+ private:
+  std::vector<size_t> *run_order_;
+  size_t index_;
+};
+}  // namespace
+
+class TestAsyncQueue : public UT::Common {
+ public:
+  TestAsyncQueue() = default;
+};
+
+/// Feature: lock-free task queue of PyNative.
+/// Description: push more tasks than a segment of the queue holds, mixing the op run tasks with other tasks, with and
+/// without batch.
+/// Expectation: all the tasks run once in the order they are pushed.
+TEST_F(TestAsyncQueue, TestRunInOrder) {
+  std::vector<float> x(kTinyOpSize, 1);
+  std::vector<float> y(kTinyOpSize, 2);
+  std::vector<float> out(kTinyOpSize, 0);
+  for (size_t batch_size : {1, 8}) {
+    AsyncQueue queue;
+    queue.set_max_batch_size(batch_size);
+    std::vector<size_t> run_order;
+    const size_t task_num = 1000;
+    for (size_t i = 0; i < task_num; ++i) {
+      if (i % 7 == 0) {
+        queue.Push(queue.MakeTask<BpropTask>(&run_order, i));
+      } else {
+        queue.Push(queue.MakeTask<TinyAddTask>(&x, &y, &out, &run_order, i));
+      }
+    }
+    queue.Wait();
+    EXPECT_TRUE(queue.Empty());
+    ASSERT_EQ(run_order.size(), task_num);
+    for (size_t i = 0; i < task_num; ++i) {
+      EXPECT_EQ(run_order[i], i);
+    }
+    EXPECT_EQ(out, std::vector<float>(kTinyOpSize, 3));
+  }
+}
+
+/// Feature: lock-free task queue of PyNative.
+/// Description: push a task which throws between other tasks, then push tasks again.
+/// Expectation: Wait throws the exception and the tasks after it are dropped, the tasks pushed later run.
+TEST_F(TestAsyncQueue, TestException) {
+  AsyncQueue queue;
+  queue.set_max_batch_size(4);
+  std::vector<float> x(kTinyOpSize, 1);
+  std::vector<float> y(kTinyOpSize, 2);
+  std::vector<float> out(kTinyOpSize, 0);
+  std::vector<size_t> run_order;
+  queue.Push(queue.MakeTask<TinyAddTask>(&x, &y, &out, &run_order, 0));
+  queue.Push(queue.MakeTask<ThrowTask>());
+  queue.Push(queue.MakeTask<TinyAddTask>(&x, &y, &out, &run_order, 1));
+  EXPECT_ANY_THROW(queue.Wait());
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_LE(run_order.size(), 1);
+
+  run_order.clear();
+  queue.Push(queue.MakeTask<TinyAddTask>(&x, &y, &out, &run_order, 2));
+  queue.Wait();
+  ASSERT_EQ(run_order.size(), 1);
+  EXPECT_EQ(run_order[0], 2);
+}
+
+/// Feature: lock-free task queue of PyNative.
+/// Description: dispatch tiny element-wise ops in two rounds, creating the tasks by the heap or by the task pool, with
+/// and without batch.
+/// Expectation: every op runs once and in the order it is pushed, and the tasks of the second round created by the
+/// task pool take the memory of the tasks of the first round.
+TEST_F(TestAsyncQueue, TestTinyOpDispatch) {
+  std::vector<float> x(kTinyOpSize, 1);
+  std::vector<float> y(kTinyOpSize, 2);
+  const size_t op_num = 1000;
+  for (bool use_pool : {false, true}) {
+    for (size_t batch_size : {1, 32}) {
+      AsyncQueue queue;
+      queue.set_max_batch_size(batch_size);
+      std::set<const void *> first_round_blocks;
+      // Taken between the rounds, so that the tasks of the second round do not get the blocks back from the heap.
+      std::vector<std::unique_ptr<char[]>> heap_blocks;
+      // The tasks are held until all of them run, so that each of them takes its own block of the pool.
+      std::vector<std::shared_ptr<TinyAddTask>> tasks;
+      for (size_t round = 0; round < 2; ++round) {
+        std::vector<float> out(kTinyOpSize, 0);
+        std::vector<size_t> run_order;
+        for (size_t i = 0; i < op_num; ++i) {
+          if (use_pool) {
+            tasks.push_back(queue.MakeTask<TinyAddTask>(&x, &y, &out, &run_order, i));
+          } else {
+            tasks.push_back(std::make_shared<TinyAddTask>(&x, &y, &out, &run_order, i));
+          }
+          queue.Push(tasks.back());
+        }
+        queue.Wait();
+        EXPECT_TRUE(queue.Empty());
+        EXPECT_EQ(out, std::vector<float>(kTinyOpSize, 3));
+        ASSERT_EQ(run_order.size(), op_num);
+        for (size_t i = 0; i < op_num; ++i) {
+          ASSERT_EQ(run_order[i], i);
+        }
+        if (use_pool) {
+          for (const auto &task : tasks) {
+            if (round == 0) {
+              (void)first_round_blocks.insert(task.get());
+            } else {
+              EXPECT_EQ(first_round_blocks.count(task.get()), 1);
+            }
+          }
+          EXPECT_EQ(first_round_blocks.size(), op_num);
+        }
+        tasks.clear();
+        for (size_t i = 0; i < op_num; ++i) {
+          heap_blocks.push_back(std::make_unique<char[]>(AsyncTaskPool::kBlockSize));
+        }
+      }
+    }
+  }
+}
+}  // namespace pynative
+}  // namespace mindspore